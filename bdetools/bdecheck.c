@@ -0,0 +1,386 @@
+/*
+ * Tests candidate passwords against a BitLocker Drive Encrypted (BDE) volume
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bdeoutput.h"
+#include "bdetools_libbde.h"
+#include "bdetools_libcerror.h"
+#include "bdetools_libclocale.h"
+#include "bdetools_libcnotify.h"
+#include "bdetools_libcsystem.h"
+#include "info_handle.h"
+
+info_handle_t *bdecheck_info_handle = NULL;
+int bdecheck_abort                  = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use bdecheck to test candidate passwords or recovery passwords\n"
+	                 " against a BitLocker Drive Encrypted (BDE) volume\n\n" );
+
+	fprintf( stream, "Usage: bdecheck [ -o offset ] [ -p filename ] [ -r filename ]\n"
+	                 "                [ -t threads ] [ -hvV ] source\n\n" );
+
+	fprintf( stream, "\tsource: the source file or device\n\n" );
+
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-o:     specify the volume offset in bytes\n" );
+	fprintf( stream, "\t-p:     specify the file containing the candidate passwords,\n"
+	                 "\t        one password per line\n" );
+	fprintf( stream, "\t-r:     specify the file containing the candidate recovery\n"
+	                 "\t        passwords, one recovery password per line\n" );
+	fprintf( stream, "\t-t:     specify the number of threads, 0 disables threads\n"
+	                 "\t        (default is 0)\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for bdecheck
+ */
+void bdecheck_signal_handler(
+      libcsystem_signal_t signal LIBCSYSTEM_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function   = "bdecheck_signal_handler";
+
+	LIBCSYSTEM_UNREFERENCED_PARAMETER( signal )
+
+	bdecheck_abort = 1;
+
+	if( bdecheck_info_handle != NULL )
+	{
+		if( info_handle_signal_abort(
+		     bdecheck_info_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal info handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+	if( libcsystem_file_io_close(
+	     0 ) != 0 )
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libbde_error_t *error                                  = NULL;
+	system_character_t *option_number_of_threads           = NULL;
+	system_character_t *option_passwords_filename          = NULL;
+	system_character_t *option_recovery_passwords_filename = NULL;
+	system_character_t *option_volume_offset               = NULL;
+	system_character_t *source                             = NULL;
+	char *program                                          = "bdecheck";
+	system_integer_t option                                = 0;
+	int result                                             = 0;
+	int verbose                                            = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+             "bdetools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( libcsystem_initialize(
+             _IONBF,
+             &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize system values.\n" );
+
+		goto on_error;
+	}
+	bdeoutput_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = libcsystem_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "ho:p:r:t:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'o':
+				option_volume_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 'p':
+				option_passwords_filename = optarg;
+
+				break;
+
+			case (system_integer_t) 'r':
+				option_recovery_passwords_filename = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				bdeoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file or device.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	if( ( option_passwords_filename == NULL )
+	 && ( option_recovery_passwords_filename == NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Missing passwords or recovery passwords file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libbde_notify_set_stream(
+	 stderr,
+	 NULL );
+	libbde_notify_set_verbose(
+	 verbose );
+
+	if( info_handle_initialize(
+	     &bdecheck_info_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize info handle.\n" );
+
+		goto on_error;
+	}
+	if( option_number_of_threads != NULL )
+	{
+		if( info_handle_set_number_of_threads(
+		     bdecheck_info_handle,
+		     option_number_of_threads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_volume_offset != NULL )
+	{
+		if( info_handle_set_volume_offset(
+		     bdecheck_info_handle,
+		     option_volume_offset,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set volume offset.\n" );
+
+			goto on_error;
+		}
+	}
+	result = info_handle_open_input(
+	          bdecheck_info_handle,
+	          source,
+	          &error );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	result = 0;
+
+	if( option_passwords_filename != NULL )
+	{
+		result = info_handle_test_passwords_file(
+		          bdecheck_info_handle,
+		          option_passwords_filename,
+		          0,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to test passwords.\n" );
+
+			goto on_error;
+		}
+	}
+	if( ( result == 0 )
+	 && ( option_recovery_passwords_filename != NULL ) )
+	{
+		result = info_handle_test_passwords_file(
+		          bdecheck_info_handle,
+		          option_recovery_passwords_filename,
+		          1,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to test recovery passwords.\n" );
+
+			goto on_error;
+		}
+	}
+	if( info_handle_close_input(
+	     bdecheck_info_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close info handle.\n" );
+
+		goto on_error;
+	}
+	if( info_handle_free(
+	     &bdecheck_info_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free info handle.\n" );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		return( EXIT_FAILURE );
+	}
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( bdecheck_info_handle != NULL )
+	{
+		info_handle_free(
+		 &bdecheck_info_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,665 @@
+/*
+ * Exports a BitLocker Drive Encrypted (BDE) volume to a decrypted image
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include <stdio.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bdeoutput.h"
+#include "bdetools_libbde.h"
+#include "bdetools_libcerror.h"
+#include "bdetools_libclocale.h"
+#include "bdetools_libcnotify.h"
+#include "bdetools_libcsystem.h"
+#include "export_handle.h"
+
+export_handle_t *bdeexport_export_handle = NULL;
+int bdeexport_abort                      = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use bdeexport to export a BitLocker Drive Encrypted (BDE) volume\n"
+	                 " to a decrypted (raw) image\n\n" );
+
+	fprintf( stream, "Usage: bdeexport [ -b size ] [ -d digest_types ] [ -k keys ]\n"
+	                 "                 [ -K filename ] [ -l filename ] [ -o offset ]\n"
+	                 "                 [ -p password ] [ -q depth ] [ -r password ]\n"
+	                 "                 [ -s filename ] [ -t threads ] [ -BhvVZ ]\n"
+	                 "                 source target\n\n" );
+
+	fprintf( stream, "\tsource: the source file or device\n" );
+	fprintf( stream, "\ttarget: the target file or device, an existing file\n"
+	                 "\t        is overwritten\n\n" );
+
+	fprintf( stream, "\t-b:     specify the size of the chunks that are read and decrypted\n"
+	                 "\t        as a unit in bytes, must be a multiple of 4096\n"
+	                 "\t        (default is 8388608)\n" );
+	fprintf( stream, "\t-B:     write the target with buffered IO instead of direct IO\n" );
+	fprintf( stream, "\t-d:     calculate digest (hash) types over the exported data,\n"
+	                 "\t        options: md5, sha1, sha256, multiple types are\n"
+	                 "\t        separated by a , character e.g. md5,sha256\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-k:     the full volume encryption key and tweak key\n"
+	                 "\t        formatted in base16 and separated by a : character\n"
+	                 "\t        e.g. FKEV:TWEAK\n" );
+	fprintf( stream, "\t-K:     specify the keyring file containing the keys\n"
+	                 "\t        of known volumes by volume identifier\n" );
+	fprintf( stream, "\t-l:     write the digest hashes of every chunk to the file,\n"
+	                 "\t        requires -d\n" );
+	fprintf( stream, "\t-o:     specify the volume offset in bytes\n" );
+	fprintf( stream, "\t-p:     specify the password/passphrase\n" );
+	fprintf( stream, "\t-q:     specify the queue depth, which is the maximum number\n"
+	                 "\t        of chunks in flight (default is twice the number\n"
+	                 "\t        of threads)\n" );
+	fprintf( stream, "\t-r:     specify the recovery password\n" );
+	fprintf( stream, "\t-s:     specify the file containing the startup key.\n"
+	                 "\t        typically this file has the extension .BEK\n" );
+	fprintf( stream, "\t-t:     specify the number of threads that read and decrypt\n"
+	                 "\t        chunks, 0 disables threads (default is 4)\n" );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+	fprintf( stream, "\t-Z:     write blocks of zero bytes to the target instead\n"
+	                 "\t        of leaving holes, by default a target that is\n"
+	                 "\t        a regular file is written as a sparse file\n" );
+}
+
+/* Signal handler for bdeexport
+ */
+void bdeexport_signal_handler(
+      libcsystem_signal_t signal LIBCSYSTEM_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "bdeexport_signal_handler";
+
+	LIBCSYSTEM_UNREFERENCED_PARAMETER( signal )
+
+	bdeexport_abort = 1;
+
+	if( bdeexport_export_handle != NULL )
+	{
+		if( export_handle_signal_abort(
+		     bdeexport_export_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal export handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+	if( libcsystem_file_io_close(
+	     0 ) != 0 )
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libbde_error_t *error                           = NULL;
+	system_character_t *option_chunk_hash_list      = NULL;
+	system_character_t *option_digest_types         = NULL;
+	system_character_t *option_keyring_filename     = NULL;
+	system_character_t *option_keys                 = NULL;
+	system_character_t *option_number_of_threads    = NULL;
+	system_character_t *option_password             = NULL;
+	system_character_t *option_process_buffer_size  = NULL;
+	system_character_t *option_queue_depth          = NULL;
+	system_character_t *option_recovery_password    = NULL;
+	system_character_t *option_startup_key_filename = NULL;
+	system_character_t *option_volume_offset        = NULL;
+	system_character_t *source                      = NULL;
+	system_character_t *target                      = NULL;
+	char *program                                   = "bdeexport";
+	system_integer_t option                         = 0;
+	int result                                      = 0;
+	int use_direct_io                               = 1;
+	int use_sparse                                  = 1;
+	int verbose                                     = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+             "bdetools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( libcsystem_initialize(
+             _IONBF,
+             &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize system values.\n" );
+
+		goto on_error;
+	}
+	bdeoutput_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = libcsystem_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:Bd:hk:K:l:o:p:q:r:s:t:vVZ" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_process_buffer_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'B':
+				use_direct_io = 0;
+
+				break;
+
+			case (system_integer_t) 'd':
+				option_digest_types = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'k':
+				option_keys = optarg;
+
+				break;
+
+			case (system_integer_t) 'K':
+				option_keyring_filename = optarg;
+
+				break;
+
+			case (system_integer_t) 'l':
+				option_chunk_hash_list = optarg;
+
+				break;
+
+			case (system_integer_t) 'o':
+				option_volume_offset = optarg;
+
+				break;
+
+			case (system_integer_t) 'p':
+				option_password = optarg;
+
+				break;
+
+			case (system_integer_t) 'q':
+				option_queue_depth = optarg;
+
+				break;
+
+			case (system_integer_t) 'r':
+				option_recovery_password = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_startup_key_filename = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				bdeoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'Z':
+				use_sparse = 0;
+
+				break;
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file or device.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind++ ];
+
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing target file or device.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	target = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libbde_notify_set_stream(
+	 stderr,
+	 NULL );
+	libbde_notify_set_verbose(
+	 verbose );
+
+	if( export_handle_initialize(
+	     &bdeexport_export_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize export handle.\n" );
+
+		goto on_error;
+	}
+	if( option_keys != NULL )
+	{
+		if( export_handle_set_keys(
+		     bdeexport_export_handle,
+		     option_keys,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set keys.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_password != NULL )
+	{
+		if( export_handle_set_password(
+		     bdeexport_export_handle,
+		     option_password,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set password.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_recovery_password != NULL )
+	{
+		if( export_handle_set_recovery_password(
+		     bdeexport_export_handle,
+		     option_recovery_password,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set recovery password.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_startup_key_filename != NULL )
+	{
+		if( export_handle_read_startup_key(
+		     bdeexport_export_handle,
+		     option_startup_key_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read startup key.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_keyring_filename != NULL )
+	{
+		if( export_handle_read_keyring(
+		     bdeexport_export_handle,
+		     option_keyring_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read keyring.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_volume_offset != NULL )
+	{
+		if( export_handle_set_volume_offset(
+		     bdeexport_export_handle,
+		     option_volume_offset,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set volume offset.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_process_buffer_size != NULL )
+	{
+		if( export_handle_set_process_buffer_size(
+		     bdeexport_export_handle,
+		     option_process_buffer_size,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set process buffer size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		if( export_handle_set_number_of_threads(
+		     bdeexport_export_handle,
+		     option_number_of_threads,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_queue_depth != NULL )
+	{
+		if( export_handle_set_queue_depth(
+		     bdeexport_export_handle,
+		     option_queue_depth,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set queue depth.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_digest_types != NULL )
+	{
+		if( export_handle_set_digest_types(
+		     bdeexport_export_handle,
+		     option_digest_types,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set digest types.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_chunk_hash_list != NULL )
+	{
+		if( export_handle_open_chunk_hash_list(
+		     bdeexport_export_handle,
+		     option_chunk_hash_list,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open chunk hash list: %" PRIs_SYSTEM ".\n",
+			 option_chunk_hash_list );
+
+			goto on_error;
+		}
+	}
+	if( export_handle_set_use_direct_io(
+	     bdeexport_export_handle,
+	     use_direct_io,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set use direct IO.\n" );
+
+		goto on_error;
+	}
+	if( export_handle_set_use_sparse(
+	     bdeexport_export_handle,
+	     use_sparse,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set use sparse.\n" );
+
+		goto on_error;
+	}
+	result = export_handle_open_input(
+	          bdeexport_export_handle,
+	          source,
+	          &error );
+
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 source );
+
+		goto on_error;
+	}
+	result = export_handle_input_is_locked(
+	          bdeexport_export_handle,
+	          &error );
+
+	if( result != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to unlock volume.\n" );
+
+		goto on_error;
+	}
+	if( export_handle_open_output(
+	     bdeexport_export_handle,
+	     target,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open: %" PRIs_SYSTEM ".\n",
+		 target );
+
+		goto on_error;
+	}
+	if( libcsystem_signal_attach(
+	     bdeexport_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	fprintf(
+	 stdout,
+	 "Exporting volume.\n" );
+
+	result = export_handle_export_input(
+	          bdeexport_export_handle,
+	          &error );
+
+	if( libcsystem_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( result != 1 )
+	{
+		if( bdeexport_abort != 0 )
+		{
+			fprintf(
+			 stdout,
+			 "Export: ABORTED\n" );
+		}
+		else
+		{
+			fprintf(
+			 stderr,
+			 "Unable to export volume.\n" );
+		}
+		goto on_error;
+	}
+	if( export_handle_close_output(
+	     bdeexport_export_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close output.\n" );
+
+		goto on_error;
+	}
+	if( export_handle_close_input(
+	     bdeexport_export_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close export handle.\n" );
+
+		goto on_error;
+	}
+	if( export_handle_free(
+	     &bdeexport_export_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free export handle.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Export: SUCCESS\n" );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		if( bdeexport_abort == 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+		libcerror_error_free(
+		 &error );
+	}
+	if( bdeexport_export_handle != NULL )
+	{
+		export_handle_free(
+		 &bdeexport_export_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -57,15 +57,21 @@ void usage_fprint(
 	fprintf( stream, "Use bdeinfo to determine information about a BitLocker Drive\n"
 	                 " Encrypted (BDE) volume\n\n" );
 
-	fprintf( stream, "Usage: bdeinfo [ -k keys ] [ -o offset ] [ -p password ]\n"
-	                 "               [ -r password ] [ -s filename ] [ -hvV ] source\n\n" );
+	fprintf( stream, "Usage: bdeinfo [ -d digest_types ] [ -k keys ] [ -K filename ]\n"
+	                 "               [ -o offset ] [ -p password ] [ -r password ]\n"
+	                 "               [ -s filename ] [ -hvV ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file or device\n\n" );
 
+	fprintf( stream, "\t-d:     calculate digest (hash) types over the volume data,\n"
+	                 "\t        options: md5, sha1, sha256, multiple types are\n"
+	                 "\t        separated by a , character e.g. md5,sha256\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
 	fprintf( stream, "\t-k:     the full volume encryption key and tweak key\n"
 	                 "\t        formatted in base16 and separated by a : character\n"
 	                 "\t        e.g. FKEV:TWEAK\n" );
+	fprintf( stream, "\t-K:     specify the keyring file containing the keys\n"
+	                 "\t        of known volumes by volume identifier\n" );
 	fprintf( stream, "\t-o:     specify the volume offset in bytes\n" );
 	fprintf( stream, "\t-p:     specify the password/passphrase\n" );
 	fprintf( stream, "\t-r:     specify the recovery password\n" );
@@ -123,6 +129,8 @@ int main( int argc, char * const argv[] )
 #endif
 {
 	libbde_error_t *error                           = NULL;
+	system_character_t *option_digest_types         = NULL;
+	system_character_t *option_keyring_filename     = NULL;
 	system_character_t *option_keys                 = NULL;
 	system_character_t *option_password             = NULL;
 	system_character_t *option_recovery_password    = NULL;
@@ -167,7 +175,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "hk:o:p:r:s:vV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "d:hk:K:o:p:r:s:vV" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -183,6 +191,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_FAILURE );
 
+			case (system_integer_t) 'd':
+				option_digest_types = optarg;
+
+				break;
+
 			case (system_integer_t) 'h':
 				usage_fprint(
 				 stdout );
@@ -194,6 +207,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'K':
+				option_keyring_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'o':
 				option_volume_offset = optarg;
 
@@ -313,6 +331,20 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_keyring_filename != NULL )
+	{
+		if( info_handle_read_keyring(
+		     bdeinfo_info_handle,
+		     option_keyring_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read keyring.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_volume_offset != NULL )
 	{
 		if( info_handle_set_volume_offset(
@@ -327,6 +359,20 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_digest_types != NULL )
+	{
+		if( info_handle_set_digest_types(
+		     bdeinfo_info_handle,
+		     option_digest_types,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set digest types.\n" );
+
+			goto on_error;
+		}
+	}
 	result = info_handle_open_input(
 	          bdeinfo_info_handle,
 	          source,
@@ -363,6 +409,46 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( option_digest_types != NULL )
+	{
+		if( libcsystem_signal_attach(
+		     bdeinfo_signal_handler,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to attach signal handler.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		result = info_handle_calculate_digests(
+		          bdeinfo_info_handle,
+		          &error );
+
+		if( libcsystem_signal_detach(
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to detach signal handler.\n" );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+		if( result != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to calculate digests.\n" );
+
+			goto on_error;
+		}
+	}
 	if( info_handle_close_input(
 	     bdeinfo_info_handle,
 	     &error ) != 0 )
@@ -87,9 +87,9 @@ void usage_fprint(
 	}
 	fprintf( stream, "Use bdemount to mount a BitLocker Drive Encrypted (BDE) volume\n\n" );
 
-	fprintf( stream, "Usage: bdemount [ -k keys ] [ -o offset ] [ -p password ]\n"
-	                 "                [ -r password ] [ -s filename ] [ -X extended_options ]\n"
-	                 "                [ -hvV ] source mount_point\n\n" );
+	fprintf( stream, "Usage: bdemount [ -k keys ] [ -K filename ] [ -o offset ]\n"
+	                 "                [ -p password ] [ -r password ] [ -s filename ]\n"
+	                 "                [ -X extended_options ] [ -hvV ] source mount_point\n\n" );
 
 	fprintf( stream, "\tsource:      the source file or device\n" );
 	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
@@ -98,6 +98,8 @@ void usage_fprint(
 	fprintf( stream, "\t-k:          the full volume encryption key and tweak key\n"
 	                 "\t             formatted in base16 and separated by a : character\n"
 	                 "\t             e.g. FKEV:TWEAK\n" );
+	fprintf( stream, "\t-K:          specify the keyring file containing the keys\n"
+	                 "\t             of known volumes by volume identifier\n" );
 	fprintf( stream, "\t-o:          specify the volume offset in bytes\n" );
 	fprintf( stream, "\t-p:          specify the password/passphrase\n" );
 	fprintf( stream, "\t-r:          specify the recovery password\n" );
@@ -2016,6 +2018,7 @@ int main( int argc, char * const argv[] )
 	libbde_error_t *error                           = NULL;
 	system_character_t *mount_point                 = NULL;
 	system_character_t *option_extended_options     = NULL;
+	system_character_t *option_keyring_filename     = NULL;
 	system_character_t *option_keys                 = NULL;
 	system_character_t *option_password             = NULL;
 	system_character_t *option_recovery_password    = NULL;
@@ -2072,7 +2075,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = libcsystem_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "hk:o:p:r:s:vVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "hk:K:o:p:r:s:vVX:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -2099,6 +2102,11 @@ int main( int argc, char * const argv[] )
 
 				break;
 
+			case (system_integer_t) 'K':
+				option_keyring_filename = optarg;
+
+				break;
+
 			case (system_integer_t) 'o':
 				option_volume_offset = optarg;
 
@@ -2236,6 +2244,20 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
+	if( option_keyring_filename != NULL )
+	{
+		if( mount_handle_read_keyring(
+		     bdemount_mount_handle,
+		     option_keyring_filename,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to read keyring.\n" );
+
+			goto on_error;
+		}
+	}
 	if( option_volume_offset != NULL )
 	{
 		if( mount_handle_set_volume_offset(
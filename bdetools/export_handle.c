@@ -0,0 +1,3475 @@
+/*
+ * Export handle
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if defined( __linux__ ) && !defined( _GNU_SOURCE )
+/* Required for O_DIRECT
+ */
+#define _GNU_SOURCE 1
+#endif
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_ERRNO_H ) || defined( WINAPI )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H ) || defined( WINAPI )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_SYS_STAT_H ) || defined( WINAPI )
+#include <sys/stat.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( WINAPI )
+#include <io.h>
+#endif
+
+#include "bdetools_libbde.h"
+#include "bdetools_libbfio.h"
+#include "bdetools_libcerror.h"
+#include "bdetools_libcnotify.h"
+#include "bdetools_libcsplit.h"
+#include "bdetools_libcsystem.h"
+#include "bdetools_libcthreads.h"
+#include "bdetools_libuna.h"
+#include "export_handle.h"
+#include "hash_handle.h"
+
+#if !defined( LIBBDE_HAVE_BFIO )
+extern \
+int libbde_volume_open_file_io_handle(
+     libbde_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     int access_flags,
+     libbde_error_t **error );
+#endif
+
+/* Creates an export handle
+ * Make sure the value export_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_initialize(
+     export_handle_t **export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_initialize";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*export_handle = memory_allocate_structure(
+	                 export_handle_t );
+
+	if( *export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create export handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *export_handle,
+	     0,
+	     sizeof( export_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear export handle.",
+		 function );
+
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+
+		return( -1 );
+	}
+	if( libbfio_file_range_initialize(
+	     &( ( *export_handle )->input_file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_volume_initialize(
+	     &( ( *export_handle )->input_volume ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input volume.",
+		 function );
+
+		goto on_error;
+	}
+	( *export_handle )->output_file_descriptor = -1;
+	( *export_handle )->use_direct_io          = 1;
+	( *export_handle )->use_sparse             = 1;
+	( *export_handle )->process_buffer_size    = EXPORT_HANDLE_DEFAULT_PROCESS_BUFFER_SIZE;
+	( *export_handle )->number_of_threads      = EXPORT_HANDLE_DEFAULT_NUMBER_OF_THREADS;
+	( *export_handle )->notify_stream          = stdout;
+
+	return( 1 );
+
+on_error:
+	if( *export_handle != NULL )
+	{
+		if( ( *export_handle )->input_file_io_handle != NULL )
+		{
+			libbfio_handle_free(
+			 &( ( *export_handle )->input_file_io_handle ),
+			 NULL );
+		}
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees an export handle
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_free(
+     export_handle_t **export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_free";
+	int result            = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_handle != NULL )
+	{
+		if( ( *export_handle )->output_file_descriptor != -1 )
+		{
+			if( export_handle_close_output(
+			     *export_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close output.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *export_handle )->hash_handle != NULL )
+		{
+			if( hash_handle_free(
+			     &( ( *export_handle )->hash_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free hash handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libbde_volume_free(
+		     &( ( *export_handle )->input_volume ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input volume.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( ( *export_handle )->input_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the export handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_signal_abort(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_signal_abort";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->abort = 1;
+
+	if( export_handle->input_volume != NULL )
+	{
+		if( libbde_volume_signal_abort(
+		     export_handle->input_volume,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input volume to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( export_handle->hash_handle != NULL )
+	{
+		if( hash_handle_signal_abort(
+		     export_handle->hash_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal hash handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the keys
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_keys(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	uint8_t key_data[ 64 ];
+
+	system_character_t *string_segment               = NULL;
+	static char *function                            = "export_handle_set_keys";
+	size_t full_volume_encryption_key_size           = 0;
+	size_t string_length                             = 0;
+	size_t string_segment_size                       = 0;
+	size_t tweak_key_size                            = 0;
+	uint32_t base16_variant                          = 0;
+	int number_of_segments                           = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	libcsplit_wide_split_string_t *string_elements   = NULL;
+#else
+	libcsplit_narrow_split_string_t *string_elements = NULL;
+#endif
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_string_split(
+	     string,
+	     string_length + 1,
+	     (wchar_t) ':',
+	     &string_elements,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_string_split(
+	     string,
+	     string_length + 1,
+	     (char) ':',
+	     &string_elements,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_get_number_of_segments(
+	     string_elements,
+	     &number_of_segments,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_get_number_of_segments(
+	     string_elements,
+	     &number_of_segments,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( number_of_segments == 0 )
+	 || ( number_of_segments > 2 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     key_data,
+	     0,
+	     64 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key data.",
+		 function );
+
+		goto on_error;
+	}
+	base16_variant = LIBUNA_BASE16_VARIANT_RFC4648;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( _BYTE_STREAM_HOST_IS_ENDIAN_BIG )
+	{
+		base16_variant |= LIBUNA_BASE16_VARIANT_ENCODING_UTF16_BIG_ENDIAN;
+	}
+	else
+	{
+		base16_variant |= LIBUNA_BASE16_VARIANT_ENCODING_UTF16_LITTLE_ENDIAN;
+	}
+#endif
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_get_segment_by_index(
+	     string_elements,
+	     0,
+	     &string_segment,
+	     &string_segment_size,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_get_segment_by_index(
+	     string_elements,
+	     0,
+	     &string_segment,
+	     &string_segment_size,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve string segment: 0.",
+		 function );
+
+		goto on_error;
+	}
+	if( string_segment == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing string segment: 0.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( string_segment_size != 33 )
+	 && ( string_segment_size != 65 )
+	 && ( string_segment_size != 129 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported string segment: 0 size.",
+		 function );
+
+		goto on_error;
+	}
+	if( string_segment_size == 129 )
+	{
+		/* Allow the keys to be specified as a single 512-bit stream
+		 */
+		if( number_of_segments != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported number of segments.",
+			 function );
+
+			goto on_error;
+		}
+		if( libuna_base16_stream_copy_to_byte_stream(
+		     (uint8_t *) string_segment,
+		     string_segment_size - 1,
+		     key_data,
+		     64,
+		     base16_variant,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy key data.",
+			 function );
+
+			goto on_error;
+		}
+		full_volume_encryption_key_size = 32;
+		tweak_key_size                  = 32;
+	}
+	else if( ( string_segment_size == 33 )
+	      || ( string_segment_size == 65 ) )
+	{
+		if( libuna_base16_stream_copy_to_byte_stream(
+		     (uint8_t *) string_segment,
+		     string_segment_size - 1,
+		     key_data,
+		     32,
+		     base16_variant,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy key data.",
+			 function );
+
+			goto on_error;
+		}
+		if( string_segment_size == 33 )
+		{
+			full_volume_encryption_key_size = 16;
+		}
+		else
+		{
+			full_volume_encryption_key_size = 32;
+		}
+	}
+	if( number_of_segments > 1 )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcsplit_wide_split_string_get_segment_by_index(
+		     string_elements,
+		     1,
+		     &string_segment,
+		     &string_segment_size,
+		     error ) != 1 )
+#else
+		if( libcsplit_narrow_split_string_get_segment_by_index(
+		     string_elements,
+		     1,
+		     &string_segment,
+		     &string_segment_size,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve string segment: 1.",
+			 function );
+
+			goto on_error;
+		}
+		if( string_segment == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing string segment: 1.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( string_segment_size != 33 )
+		 && ( string_segment_size != 65 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported string segment: 1 size.",
+			 function );
+
+			goto on_error;
+		}
+		if( libuna_base16_stream_copy_to_byte_stream(
+		     (uint8_t *) string_segment,
+		     string_segment_size - 1,
+		     &( key_data[ 32 ] ),
+		     32,
+		     base16_variant,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy key data.",
+			 function );
+
+			goto on_error;
+		}
+		if( string_segment_size == 33 )
+		{
+			tweak_key_size = 16;
+		}
+		else
+		{
+			tweak_key_size = 32;
+		}
+	}
+	if( libbde_volume_set_keys(
+	     export_handle->input_volume,
+	     key_data,
+	     full_volume_encryption_key_size,
+	     &( key_data[ 32 ] ),
+	     tweak_key_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set keys.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     key_data,
+	     0,
+	     64 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear key data.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split string.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( string_elements != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libcsplit_wide_split_string_free(
+		 &string_elements,
+		 NULL );
+#else
+		libcsplit_narrow_split_string_free(
+		 &string_elements,
+		 NULL );
+#endif
+	}
+	memory_set(
+	 key_data,
+	 0,
+	 64 );
+
+	return( -1 );
+}
+
+/* Sets the password
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_password(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_password";
+	size_t string_length  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbde_volume_set_utf16_password(
+	     export_handle->input_volume,
+	     (uint16_t *) string,
+	     string_length,
+	     error ) != 1 )
+#else
+	if( libbde_volume_set_utf8_password(
+	     export_handle->input_volume,
+	     (uint8_t *) string,
+	     string_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set password.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the recovery password
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_recovery_password(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_recovery_password";
+	size_t string_length  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbde_volume_set_utf16_recovery_password(
+	     export_handle->input_volume,
+	     (uint16_t *) string,
+	     string_length,
+	     error ) != 1 )
+#else
+	if( libbde_volume_set_utf8_recovery_password(
+	     export_handle->input_volume,
+	     (uint8_t *) string,
+	     string_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set recovery password.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the startup key from a .BEK file
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_read_startup_key(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_read_startup_key";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbde_volume_read_startup_key_wide(
+	     export_handle->input_volume,
+	     filename,
+	     error ) != 1 )
+#else
+	if( libbde_volume_read_startup_key(
+	     export_handle->input_volume,
+	     filename,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read startup key.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the keys from a keyring file
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_read_keyring(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_read_keyring";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbde_volume_read_keyring_wide(
+	     export_handle->input_volume,
+	     filename,
+	     error ) != 1 )
+#else
+	if( libbde_volume_read_keyring(
+	     export_handle->input_volume,
+	     filename,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read keyring.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the volume offset
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_volume_offset(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_volume_offset";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( libcsystem_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->volume_offset = (off64_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the process buffer size
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_process_buffer_size(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_process_buffer_size";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( libcsystem_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	/* The process buffer size must be a multiple of the direct IO alignment
+	 * since every chunk except the last is written at an aligned offset
+	 */
+	if( ( value_64bit < (uint64_t) EXPORT_HANDLE_MINIMUM_PROCESS_BUFFER_SIZE )
+	 || ( value_64bit > (uint64_t) EXPORT_HANDLE_MAXIMUM_PROCESS_BUFFER_SIZE )
+	 || ( ( value_64bit % EXPORT_HANDLE_DIRECT_IO_ALIGNMENT ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid process buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->process_buffer_size = (size_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_number_of_threads(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( libcsystem_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > (uint64_t) EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the queue depth
+ * A queue depth of 0 represents twice the number of threads
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_queue_depth(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_queue_depth";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( libcsystem_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > (uint64_t) EXPORT_HANDLE_MAXIMUM_QUEUE_DEPTH )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid queue depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->queue_depth = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets if direct IO should be used for the output
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_use_direct_io(
+     export_handle_t *export_handle,
+     int use_direct_io,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_use_direct_io";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - output already open.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->use_direct_io = use_direct_io;
+
+	return( 1 );
+}
+
+/* Sets if zero blocks should be left as holes in the output instead of being written
+ * This only applies to an output that is a regular file
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_use_sparse(
+     export_handle_t *export_handle,
+     int use_sparse,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_use_sparse";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - output already open.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->use_sparse = use_sparse;
+
+	return( 1 );
+}
+
+/* Sets the digest types that are calculated over the exported data
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_digest_types(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_digest_types";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->hash_handle == NULL )
+	{
+		if( hash_handle_initialize(
+		     &( export_handle->hash_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize hash handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( hash_handle_set_digest_types(
+	     export_handle->hash_handle,
+	     string,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set digest types.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the chunk hash list, which contains the digest hashes of every chunk
+ * The digest types must be set before
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_open_chunk_hash_list(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_open_chunk_hash_list";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing digest types.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle_open_chunk_hash_list(
+	     export_handle->hash_handle,
+	     filename,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open chunk hash list.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the input of the export handle
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_open_input(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "export_handle_open_input";
+	size_t filename_length = 0;
+	int result             = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_range_set_name_wide(
+	     export_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_range_set_name(
+	     export_handle->input_file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to set file name.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_range_set(
+	     export_handle->input_file_io_handle,
+	     export_handle->volume_offset,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to set volume offset.",
+		 function );
+
+		return( -1 );
+	}
+	/* The export reads the volume ahead in chunks itself
+	 */
+	if( libbde_volume_set_read_ahead_depth(
+	     export_handle->input_volume,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set read-ahead depth.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbde_volume_open_file_io_handle(
+	          export_handle->input_volume,
+	          export_handle->input_file_io_handle,
+	          LIBBDE_OPEN_READ,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the input of the export handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int export_handle_close_input(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_close_input";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_volume_close(
+	     export_handle->input_volume,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input volume.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Determine if the input is locked
+ * Returns 1 if locked, 0 if not or -1 on error
+ */
+int export_handle_input_is_locked(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_input_is_locked";
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbde_volume_is_locked(
+	          export_handle->input_volume,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if volume is locked.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+
+/* Opens the output of the export handle
+ * The output is created or truncated if it already exists
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_open_output(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_open_output";
+	int file_descriptor   = -1;
+	int flags             = 0;
+
+#if !defined( WINAPI ) && defined( S_ISREG )
+	struct stat file_statistics;
+#endif
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_file_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - output already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	flags = _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	file_descriptor = _wopen(
+	                   filename,
+	                   flags,
+	                   _S_IREAD | _S_IWRITE );
+#else
+	file_descriptor = _open(
+	                   filename,
+	                   flags,
+	                   _S_IREAD | _S_IWRITE );
+#endif
+#else
+	flags = O_WRONLY | O_CREAT | O_TRUNC;
+
+#if defined( O_DIRECT )
+	if( export_handle->use_direct_io != 0 )
+	{
+		file_descriptor = open(
+		                   filename,
+		                   flags | O_DIRECT,
+		                   0644 );
+
+		/* Not every file system supports direct IO,
+		 * if the open fails the output is opened without direct IO
+		 */
+		if( file_descriptor != -1 )
+		{
+			export_handle->output_has_direct_io = 1;
+		}
+	}
+#endif
+	if( file_descriptor == -1 )
+	{
+		file_descriptor = open(
+		                   filename,
+		                   flags,
+		                   0644 );
+	}
+#endif /* defined( WINAPI ) */
+
+	if( file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open output file: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	export_handle->output_file_descriptor = file_descriptor;
+	export_handle->sparse_size            = 0;
+
+#if !defined( WINAPI ) && defined( S_ISREG )
+	/* Only a regular file can contain holes, the zero blocks need to be
+	 * written to a device to overwrite its previous contents
+	 */
+	if( export_handle->use_sparse != 0 )
+	{
+		if( ( fstat(
+		       file_descriptor,
+		       &file_statistics ) == 0 )
+		 && ( S_ISREG( file_statistics.st_mode ) ) )
+		{
+			export_handle->output_is_sparse = 1;
+		}
+	}
+#endif
+	return( 1 );
+}
+
+/* Closes the output of the export handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int export_handle_close_output(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_close_output";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_file_descriptor == -1 )
+	{
+		return( 0 );
+	}
+	if( libcsystem_file_io_close(
+	     export_handle->output_file_descriptor ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close output file.",
+		 function );
+
+		export_handle->output_file_descriptor = -1;
+
+		return( -1 );
+	}
+	export_handle->output_file_descriptor = -1;
+	export_handle->output_has_direct_io   = 0;
+	export_handle->output_is_sparse       = 0;
+
+	return( 0 );
+}
+
+/* Writes a buffer to the output
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_write_buffer(
+     export_handle_t *export_handle,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_write_buffer";
+	size_t buffer_offset  = 0;
+	ssize_t write_count   = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing output.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < buffer_size )
+	{
+#if defined( WINAPI )
+		write_count = (ssize_t) _write(
+		                         export_handle->output_file_descriptor,
+		                         &( buffer[ buffer_offset ] ),
+		                         (unsigned int) ( buffer_size - buffer_offset ) );
+#else
+		write_count = write(
+		               export_handle->output_file_descriptor,
+		               &( buffer[ buffer_offset ] ),
+		               buffer_size - buffer_offset );
+#endif
+		if( write_count < 0 )
+		{
+#if defined( EINTR )
+			if( errno == EINTR )
+			{
+				continue;
+			}
+#endif
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write to output file.",
+			 function );
+
+			return( -1 );
+		}
+		if( write_count == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write to output file - no space left.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) write_count;
+	}
+	return( 1 );
+}
+
+/* Skips a buffer in the output without writing it
+ * Since the output was truncated when it was opened, the skipped buffer is left as a hole
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_skip_buffer(
+     export_handle_t *export_handle,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_skip_buffer";
+	off64_t offset        = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing output.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	offset = (off64_t) _lseeki64(
+	                    export_handle->output_file_descriptor,
+	                    (__int64) buffer_size,
+	                    SEEK_CUR );
+#else
+	offset = (off64_t) lseek(
+	                    export_handle->output_file_descriptor,
+	                    (off_t) buffer_size,
+	                    SEEK_CUR );
+#endif
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek in output file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the size of the output
+ * This is needed when the output ends with a hole, which does not extend the file
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_output_size(
+     export_handle_t *export_handle,
+     size64_t output_size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_output_size";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing output.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_size > (size64_t) INT64_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid output size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	if( _chsize_s(
+	     export_handle->output_file_descriptor,
+	     (__int64) output_size ) != 0 )
+#else
+	if( ftruncate(
+	     export_handle->output_file_descriptor,
+	     (off_t) output_size ) != 0 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to set size of output file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines if a buffer only contains zero bytes
+ * The buffer is checked in groups of 8 64-bit values, which allows
+ * the compiler to vectorize the check
+ * Returns 1 if the buffer only contains zero bytes, 0 if not or -1 on error
+ */
+int export_handle_buffer_is_zero(
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	const uint64_t *values  = NULL;
+	static char *function   = "export_handle_buffer_is_zero";
+	size_t buffer_offset    = 0;
+	size_t number_of_values = 0;
+	size_t value_index      = 0;
+	uint64_t value          = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* Check the bytes before the first 64-bit aligned value
+	 */
+	while( ( buffer_offset < buffer_size )
+	    && ( ( (intptr_t) &( buffer[ buffer_offset ] ) % sizeof( uint64_t ) ) != 0 ) )
+	{
+		if( buffer[ buffer_offset ] != 0 )
+		{
+			return( 0 );
+		}
+		buffer_offset++;
+	}
+	values           = (const uint64_t *) &( buffer[ buffer_offset ] );
+	number_of_values = ( buffer_size - buffer_offset ) / sizeof( uint64_t );
+
+	while( ( value_index + 8 ) <= number_of_values )
+	{
+		value = values[ value_index ]
+		      | values[ value_index + 1 ]
+		      | values[ value_index + 2 ]
+		      | values[ value_index + 3 ]
+		      | values[ value_index + 4 ]
+		      | values[ value_index + 5 ]
+		      | values[ value_index + 6 ]
+		      | values[ value_index + 7 ];
+
+		if( value != 0 )
+		{
+			return( 0 );
+		}
+		value_index += 8;
+	}
+	while( value_index < number_of_values )
+	{
+		if( values[ value_index ] != 0 )
+		{
+			return( 0 );
+		}
+		value_index++;
+	}
+	buffer_offset += number_of_values * sizeof( uint64_t );
+
+	/* Check the bytes after the last 64-bit aligned value
+	 */
+	while( buffer_offset < buffer_size )
+	{
+		if( buffer[ buffer_offset ] != 0 )
+		{
+			return( 0 );
+		}
+		buffer_offset++;
+	}
+	return( 1 );
+}
+
+/* Writes a chunk to the output
+ * If the output is sparse, runs of zero blocks are skipped instead of written
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_write_chunk(
+     export_handle_t *export_handle,
+     export_handle_chunk_t *chunk,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_write_chunk";
+	size_t block_size     = 0;
+	size_t data_offset    = 0;
+	size_t run_size       = 0;
+	int block_is_zero     = 0;
+	int run_is_zero       = 0;
+
+#if defined( O_DIRECT ) && defined( F_SETFL )
+	int flags             = 0;
+#endif
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk->has_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk at offset: %" PRIi64 " from input volume.",
+		 function,
+		 chunk->offset );
+
+		return( -1 );
+	}
+	/* Direct IO requires the size to be a multiple of the alignment,
+	 * which does not need to be the case for the last chunk
+	 */
+	if( ( export_handle->output_has_direct_io != 0 )
+	 && ( ( chunk->data_size % EXPORT_HANDLE_DIRECT_IO_ALIGNMENT ) != 0 ) )
+	{
+#if defined( O_DIRECT ) && defined( F_SETFL )
+		flags = fcntl(
+		         export_handle->output_file_descriptor,
+		         F_GETFL );
+
+		if( ( flags == -1 )
+		 || ( fcntl(
+		       export_handle->output_file_descriptor,
+		       F_SETFL,
+		       flags & ~O_DIRECT ) == -1 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 "%s: unable to disable direct IO on output file.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		export_handle->output_has_direct_io = 0;
+	}
+	if( export_handle->output_is_sparse == 0 )
+	{
+		if( export_handle_write_buffer(
+		     export_handle,
+		     chunk->data,
+		     chunk->data_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk at offset: %" PRIi64 " to output.",
+			 function,
+			 chunk->offset );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	/* The chunk is written as runs of blocks that are either all zero
+	 * or all contain data, the runs of zero blocks are skipped
+	 */
+	while( data_offset < chunk->data_size )
+	{
+		run_is_zero = -1;
+		run_size    = 0;
+
+		while( ( data_offset + run_size ) < chunk->data_size )
+		{
+			block_size = chunk->data_size - ( data_offset + run_size );
+
+			if( block_size > EXPORT_HANDLE_SPARSE_BLOCK_SIZE )
+			{
+				block_size = EXPORT_HANDLE_SPARSE_BLOCK_SIZE;
+			}
+			block_is_zero = export_handle_buffer_is_zero(
+			                 &( chunk->data[ data_offset + run_size ] ),
+			                 block_size,
+			                 error );
+
+			if( block_is_zero == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to determine if block at offset: %" PRIi64 " is zero.",
+				 function,
+				 chunk->offset + (off64_t) ( data_offset + run_size ) );
+
+				return( -1 );
+			}
+			if( run_is_zero == -1 )
+			{
+				run_is_zero = block_is_zero;
+			}
+			else if( block_is_zero != run_is_zero )
+			{
+				break;
+			}
+			run_size += block_size;
+		}
+		if( run_is_zero != 0 )
+		{
+			if( export_handle_skip_buffer(
+			     export_handle,
+			     run_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to skip zero blocks at offset: %" PRIi64 " in output.",
+				 function,
+				 chunk->offset + (off64_t) data_offset );
+
+				return( -1 );
+			}
+			export_handle->sparse_size += run_size;
+		}
+		else
+		{
+			if( export_handle_write_buffer(
+			     export_handle,
+			     &( chunk->data[ data_offset ] ),
+			     run_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write chunk data at offset: %" PRIi64 " to output.",
+				 function,
+				 chunk->offset + (off64_t) data_offset );
+
+				return( -1 );
+			}
+		}
+		data_offset += run_size;
+	}
+	return( 1 );
+}
+
+/* Allocates the chunks
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_allocate_chunks(
+     export_handle_t *export_handle,
+     int number_of_chunks,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_allocate_chunks";
+	size_t alignment_size = 0;
+	int chunk_index       = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->chunks != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - chunks value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_chunks <= 0 )
+	 || ( number_of_chunks > EXPORT_HANDLE_MAXIMUM_QUEUE_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->chunks = (export_handle_chunk_t *) memory_allocate(
+	                                                   sizeof( export_handle_chunk_t ) * number_of_chunks );
+
+	if( export_handle->chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunks.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     export_handle->chunks,
+	     0,
+	     sizeof( export_handle_chunk_t ) * number_of_chunks ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunks.",
+		 function );
+
+		goto on_error;
+	}
+	export_handle->number_of_chunks = number_of_chunks;
+
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		/* The data is over allocated so that it can be aligned for direct IO
+		 */
+		export_handle->chunks[ chunk_index ].allocated_data = (uint8_t *) memory_allocate(
+		                                                                   sizeof( uint8_t ) * ( export_handle->process_buffer_size + EXPORT_HANDLE_DIRECT_IO_ALIGNMENT ) );
+
+		if( export_handle->chunks[ chunk_index ].allocated_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create chunk: %d data.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+		alignment_size = (size_t) ( (intptr_t) export_handle->chunks[ chunk_index ].allocated_data % EXPORT_HANDLE_DIRECT_IO_ALIGNMENT );
+
+		if( alignment_size != 0 )
+		{
+			alignment_size = EXPORT_HANDLE_DIRECT_IO_ALIGNMENT - alignment_size;
+		}
+		export_handle->chunks[ chunk_index ].data = &( export_handle->chunks[ chunk_index ].allocated_data[ alignment_size ] );
+	}
+	return( 1 );
+
+on_error:
+	export_handle_free_chunks(
+	 export_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Frees the chunks
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_free_chunks(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_free_chunks";
+	int chunk_index       = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->chunks != NULL )
+	{
+		for( chunk_index = 0;
+		     chunk_index < export_handle->number_of_chunks;
+		     chunk_index++ )
+		{
+			if( export_handle->chunks[ chunk_index ].allocated_data != NULL )
+			{
+				memory_free(
+				 export_handle->chunks[ chunk_index ].allocated_data );
+			}
+		}
+		memory_free(
+		 export_handle->chunks );
+
+		export_handle->chunks = NULL;
+	}
+	export_handle->number_of_chunks = 0;
+
+	return( 1 );
+}
+
+/* Reads the regions of the input volume
+ * The regions are only available once the input volume is unlocked
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_read_regions(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_read_regions";
+	int number_of_regions = 0;
+	int region_index      = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->regions != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - regions value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_volume_get_number_of_regions(
+	     export_handle->input_volume,
+	     &number_of_regions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of regions from input volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_regions <= 0 )
+	{
+		return( 1 );
+	}
+	export_handle->regions = (export_handle_region_t *) memory_allocate(
+	                                                     sizeof( export_handle_region_t ) * number_of_regions );
+
+	if( export_handle->regions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create regions.",
+		 function );
+
+		goto on_error;
+	}
+	for( region_index = 0;
+	     region_index < number_of_regions;
+	     region_index++ )
+	{
+		if( libbde_volume_get_region_by_index(
+		     export_handle->input_volume,
+		     region_index,
+		     &( export_handle->regions[ region_index ].offset ),
+		     &( export_handle->regions[ region_index ].size ),
+		     &( export_handle->regions[ region_index ].flags ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve region: %d from input volume.",
+			 function,
+			 region_index );
+
+			goto on_error;
+		}
+	}
+	export_handle->number_of_regions = number_of_regions;
+
+	return( 1 );
+
+on_error:
+	export_handle_free_regions(
+	 export_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Frees the regions
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_free_regions(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_free_regions";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->regions != NULL )
+	{
+		memory_free(
+		 export_handle->regions );
+
+		export_handle->regions = NULL;
+	}
+	export_handle->number_of_regions = 0;
+
+	return( 1 );
+}
+
+/* Retrieves the range of consecutive regions that starts at a specific offset
+ * The range contains either only metadata regions, which are read as zero bytes,
+ * or only regions that contain data and is at most size bytes
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_get_range(
+     export_handle_t *export_handle,
+     off64_t offset,
+     size_t *size,
+     int *is_metadata,
+     libcerror_error_t **error )
+{
+	export_handle_region_t *region = NULL;
+	static char *function          = "export_handle_get_range";
+	off64_t range_end              = 0;
+	int region_index               = 0;
+	int region_is_metadata         = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_metadata == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid is metadata.",
+		 function );
+
+		return( -1 );
+	}
+	*is_metadata = 0;
+
+	/* The range ends at the first region that differs from the region that contains the offset
+	 */
+	range_end = -1;
+
+	for( region_index = 0;
+	     region_index < export_handle->number_of_regions;
+	     region_index++ )
+	{
+		region = &( export_handle->regions[ region_index ] );
+
+		if( ( region->offset + (off64_t) region->size ) <= offset )
+		{
+			continue;
+		}
+		region_is_metadata = (int) ( ( region->flags & LIBBDE_REGION_FLAG_METADATA ) != 0 );
+
+		if( range_end == -1 )
+		{
+			*is_metadata = region_is_metadata;
+		}
+		else if( region_is_metadata != *is_metadata )
+		{
+			break;
+		}
+		range_end = region->offset + (off64_t) region->size;
+
+		if( (size64_t) ( range_end - offset ) >= (size64_t) *size )
+		{
+			break;
+		}
+	}
+	if( ( range_end != -1 )
+	 && ( (size64_t) ( range_end - offset ) < (size64_t) *size ) )
+	{
+		*size = (size_t) ( range_end - offset );
+	}
+	return( 1 );
+}
+
+/* Reads a chunk from the input volume
+ * Callback function for the export thread pool
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_read_chunk(
+     export_handle_chunk_t *chunk,
+     export_handle_t *export_handle )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "export_handle_read_chunk";
+	size_t data_offset       = 0;
+	size_t range_size        = 0;
+	ssize_t read_count       = 0;
+	int is_metadata          = 0;
+	int result               = 1;
+
+	if( ( chunk == NULL )
+	 || ( export_handle == NULL ) )
+	{
+		return( -1 );
+	}
+	if( export_handle->abort != 0 )
+	{
+		result = -1;
+	}
+	while( ( result == 1 )
+	    && ( data_offset < chunk->data_size ) )
+	{
+		range_size = chunk->data_size - data_offset;
+
+		if( export_handle_get_range(
+		     export_handle,
+		     chunk->offset + (off64_t) data_offset,
+		     &range_size,
+		     &is_metadata,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve range at offset: %" PRIi64 ".",
+			 function,
+			 chunk->offset + (off64_t) data_offset );
+
+			result = -1;
+
+			break;
+		}
+		/* The BitLocker metadata is read as zero bytes, hence it does not
+		 * need to be read from the input volume
+		 */
+		if( is_metadata != 0 )
+		{
+			if( memory_set(
+			     &( chunk->data[ data_offset ] ),
+			     0,
+			     range_size ) == NULL )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear chunk data.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+			data_offset += range_size;
+
+			continue;
+		}
+		/* The volume reads the encrypted data of the chunk under its file IO lock
+		 * and decrypts it outside of the lock, hence the reads of the threads
+		 * are issued one after the other while the decryption runs concurrently
+		 */
+		read_count = libbde_volume_read_buffer_at_offset_concurrent(
+		              export_handle->input_volume,
+		              &( chunk->data[ data_offset ] ),
+		              range_size,
+		              chunk->offset + (off64_t) data_offset,
+		              &error );
+
+		if( read_count != (ssize_t) range_size )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read chunk at offset: %" PRIi64 ".",
+			 function,
+			 chunk->offset + (off64_t) data_offset );
+
+			result = -1;
+
+			break;
+		}
+		data_offset += range_size;
+	}
+	if( error != NULL )
+	{
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+		libcerror_error_free(
+		 &error );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->chunks_mutex != NULL )
+	{
+		libcthreads_mutex_grab(
+		 export_handle->chunks_mutex,
+		 NULL );
+	}
+#endif
+	if( result != 1 )
+	{
+		chunk->has_failed = 1;
+	}
+	chunk->is_pending = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->chunks_mutex != NULL )
+	{
+		libcthreads_condition_signal(
+		 export_handle->chunks_condition,
+		 NULL );
+
+		libcthreads_mutex_release(
+		 export_handle->chunks_mutex,
+		 NULL );
+	}
+#endif
+	return( result );
+}
+
+/* Waits until a chunk is no longer pending
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_wait_for_chunk(
+     export_handle_t *export_handle,
+     export_handle_chunk_t *chunk,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_wait_for_chunk";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->chunks_mutex == NULL )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     export_handle->chunks_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab chunks mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( chunk->is_pending != 0 )
+	{
+		if( libcthreads_condition_wait(
+		     export_handle->chunks_condition,
+		     export_handle->chunks_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for chunks condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 export_handle->chunks_mutex,
+			 NULL );
+
+			return( -1 );
+		}
+	}
+	if( libcthreads_mutex_release(
+	     export_handle->chunks_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release chunks mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Prints the export status if the percentage changed and at least a second has passed
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_update_status(
+     export_handle_t *export_handle,
+     size64_t exported_size,
+     size64_t volume_size,
+     libcerror_error_t **error )
+{
+	static char *function      = "export_handle_update_status";
+	time_t current_time        = 0;
+	uint64_t bytes_per_second  = 0;
+	uint64_t number_of_seconds = 0;
+	int percentage             = 100;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->notify_stream == NULL )
+	{
+		return( 1 );
+	}
+	if( volume_size > 0 )
+	{
+		percentage = (int) ( ( exported_size * 100 ) / volume_size );
+	}
+	current_time = time(
+	                NULL );
+
+	if( ( percentage <= export_handle->last_status_percentage )
+	 || ( current_time <= export_handle->last_status_time ) )
+	{
+		return( 1 );
+	}
+	number_of_seconds = (uint64_t) ( current_time - export_handle->start_time );
+
+	if( number_of_seconds > 0 )
+	{
+		bytes_per_second = exported_size / number_of_seconds;
+	}
+	fprintf(
+	 export_handle->notify_stream,
+	 "Status: at %d%%.\n",
+	 percentage );
+
+	fprintf(
+	 export_handle->notify_stream,
+	 "        exported %" PRIu64 " of %" PRIu64 " bytes at %" PRIu64 " MiB/s.\n",
+	 exported_size,
+	 volume_size,
+	 bytes_per_second / ( 1024 * 1024 ) );
+
+	export_handle->last_status_time       = current_time;
+	export_handle->last_status_percentage = percentage;
+
+	return( 1 );
+}
+
+/* Prints the export summary
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_print_summary(
+     export_handle_t *export_handle,
+     size64_t exported_size,
+     libcerror_error_t **error )
+{
+	static char *function      = "export_handle_print_summary";
+	uint64_t number_of_seconds = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->notify_stream == NULL )
+	{
+		return( 1 );
+	}
+	number_of_seconds = (uint64_t) ( time( NULL ) - export_handle->start_time );
+
+	/* Round up to a second to prevent a division by zero
+	 */
+	if( number_of_seconds == 0 )
+	{
+		number_of_seconds = 1;
+	}
+	fprintf(
+	 export_handle->notify_stream,
+	 "Exported %" PRIu64 " bytes in %" PRIu64 " second(s) at %" PRIu64 " MiB/s.\n",
+	 exported_size,
+	 number_of_seconds,
+	 ( exported_size / number_of_seconds ) / ( 1024 * 1024 ) );
+
+	if( export_handle->sparse_size > 0 )
+	{
+		fprintf(
+		 export_handle->notify_stream,
+		 "Skipped %" PRIu64 " bytes of zero blocks, which were left as holes in the target.\n",
+		 export_handle->sparse_size );
+	}
+	return( 1 );
+}
+
+/* Exports the input volume to the output
+ * The volume is read and decrypted in chunks by the threads of a thread pool,
+ * at most queue depth chunks are in flight. The chunks are written to the output
+ * in order by the calling thread and then passed to the hash handle, which
+ * calculates the digests on its own threads
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_export_input(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	export_handle_chunk_t *chunk                   = NULL;
+	static char *function                          = "export_handle_export_input";
+	size64_t exported_size                         = 0;
+	size64_t volume_size                           = 0;
+	uint64_t number_of_volume_chunks               = 0;
+	uint64_t read_chunk_number                     = 0;
+	uint64_t write_chunk_number                    = 0;
+	int chunk_index                                = 0;
+	int queue_depth                                = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool         = NULL;
+#endif
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_file_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing output.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->process_buffer_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing process buffer size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_volume_get_size(
+	     export_handle->input_volume,
+	     &volume_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size from input volume.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->number_of_threads > 0 )
+	{
+		queue_depth = export_handle->queue_depth;
+
+		if( queue_depth == 0 )
+		{
+			queue_depth = export_handle->number_of_threads * 2;
+		}
+		if( queue_depth > EXPORT_HANDLE_MAXIMUM_QUEUE_DEPTH )
+		{
+			queue_depth = EXPORT_HANDLE_MAXIMUM_QUEUE_DEPTH;
+		}
+	}
+#endif
+	/* The regions are used to represent the BitLocker metadata as zero bytes
+	 * without reading it from the input volume
+	 */
+	if( export_handle_read_regions(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to read regions.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle_allocate_chunks(
+	     export_handle,
+	     queue_depth,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to allocate chunks.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( export_handle->number_of_threads > 0 )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( export_handle->chunks_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunks mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_condition_initialize(
+		     &( export_handle->chunks_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunks condition.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     export_handle->number_of_threads,
+		     queue_depth,
+		     (int (*)(intptr_t *, void *)) &export_handle_read_chunk,
+		     (void *) export_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( export_handle->hash_handle != NULL )
+	{
+		if( hash_handle_start(
+		     export_handle->hash_handle,
+		     queue_depth,
+		     (uint8_t) ( export_handle->number_of_threads > 0 ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start hash handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	number_of_volume_chunks = volume_size / export_handle->process_buffer_size;
+
+	if( ( volume_size % export_handle->process_buffer_size ) != 0 )
+	{
+		number_of_volume_chunks += 1;
+	}
+	export_handle->start_time             = time( NULL );
+	export_handle->last_status_time       = export_handle->start_time;
+	export_handle->last_status_percentage = 0;
+
+	while( write_chunk_number < number_of_volume_chunks )
+	{
+		if( export_handle->abort != 0 )
+		{
+			break;
+		}
+		/* Keep queue depth chunks in flight, a chunk can be reused
+		 * after the chunk that was read into it has been written and hashed
+		 */
+		while( ( read_chunk_number < number_of_volume_chunks )
+		    && ( ( read_chunk_number - write_chunk_number ) < (uint64_t) queue_depth ) )
+		{
+			if( ( export_handle->hash_handle != NULL )
+			 && ( read_chunk_number >= (uint64_t) queue_depth ) )
+			{
+				if( hash_handle_wait_for_buffers(
+				     export_handle->hash_handle,
+				     read_chunk_number - queue_depth + 1,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to wait for chunk: %" PRIu64 " to be hashed.",
+					 function,
+					 read_chunk_number - queue_depth );
+
+					goto on_error;
+				}
+			}
+			chunk_index = (int) ( read_chunk_number % queue_depth );
+			chunk       = &( export_handle->chunks[ chunk_index ] );
+
+			chunk->offset     = (off64_t) ( read_chunk_number * export_handle->process_buffer_size );
+			chunk->data_size  = export_handle->process_buffer_size;
+			chunk->has_failed = 0;
+
+			if( (size64_t) chunk->offset + chunk->data_size > volume_size )
+			{
+				chunk->data_size = (size_t) ( volume_size - chunk->offset );
+			}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+			if( thread_pool != NULL )
+			{
+				chunk->is_pending = 1;
+
+				if( libcthreads_thread_pool_push(
+				     thread_pool,
+				     (intptr_t *) chunk,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to push chunk: %" PRIu64 " onto thread pool queue.",
+					 function,
+					 read_chunk_number );
+
+					chunk->is_pending = 0;
+
+					goto on_error;
+				}
+			}
+			else
+#endif
+			{
+				export_handle_read_chunk(
+				 chunk,
+				 export_handle );
+			}
+			read_chunk_number++;
+		}
+		chunk_index = (int) ( write_chunk_number % queue_depth );
+		chunk       = &( export_handle->chunks[ chunk_index ] );
+
+		if( export_handle_wait_for_chunk(
+		     export_handle,
+		     chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for chunk: %" PRIu64 ".",
+			 function,
+			 write_chunk_number );
+
+			goto on_error;
+		}
+		if( export_handle->abort != 0 )
+		{
+			break;
+		}
+		if( export_handle_write_chunk(
+		     export_handle,
+		     chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write chunk: %" PRIu64 ".",
+			 function,
+			 write_chunk_number );
+
+			goto on_error;
+		}
+		if( export_handle->hash_handle != NULL )
+		{
+			if( hash_handle_append_buffer(
+			     export_handle->hash_handle,
+			     chunk->offset,
+			     chunk->data,
+			     chunk->data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append chunk: %" PRIu64 " to hash handle.",
+				 function,
+				 write_chunk_number );
+
+				goto on_error;
+			}
+		}
+		exported_size += chunk->data_size;
+
+		write_chunk_number++;
+
+		if( export_handle_update_status(
+		     export_handle,
+		     exported_size,
+		     volume_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print status.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->abort != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+		 "%s: export aborted.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->chunks_condition != NULL )
+	{
+		if( libcthreads_condition_free(
+		     &( export_handle->chunks_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunks condition.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->chunks_mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( export_handle->chunks_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free chunks mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	if( export_handle->output_is_sparse != 0 )
+	{
+		if( export_handle_set_output_size(
+		     export_handle,
+		     exported_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to set size of output.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle->hash_handle != NULL )
+	{
+		if( hash_handle_finalize(
+		     export_handle->hash_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize hash handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( export_handle_free_chunks(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunks.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle_free_regions(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free regions.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle_print_summary(
+	     export_handle,
+	     exported_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print summary.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( export_handle->hash_handle != NULL )
+	 && ( export_handle->notify_stream != NULL ) )
+	{
+		if( hash_handle_fprint(
+		     export_handle->hash_handle,
+		     export_handle->notify_stream,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+			 "%s: unable to print digest hashes.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The chunks that are still pending are referenced by the threads
+	 * and need to be read before they can be freed
+	 */
+	export_handle->abort = 1;
+
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( export_handle->chunks_condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &( export_handle->chunks_condition ),
+		 NULL );
+	}
+	if( export_handle->chunks_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( export_handle->chunks_mutex ),
+		 NULL );
+	}
+#endif
+	/* The digest threads reference the chunks and need to be stopped
+	 * before the chunks can be freed
+	 */
+	if( export_handle->hash_handle != NULL )
+	{
+		hash_handle_signal_abort(
+		 export_handle->hash_handle,
+		 NULL );
+
+		hash_handle_stop(
+		 export_handle->hash_handle,
+		 NULL );
+	}
+	export_handle_free_chunks(
+	 export_handle,
+	 NULL );
+
+	export_handle_free_regions(
+	 export_handle,
+	 NULL );
+
+	return( -1 );
+}
@@ -0,0 +1,406 @@
+/*
+ * Export handle
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EXPORT_HANDLE_H )
+#define _EXPORT_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "bdetools_libbde.h"
+#include "bdetools_libbfio.h"
+#include "bdetools_libcerror.h"
+#include "bdetools_libcthreads.h"
+#include "hash_handle.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default process buffer size, which is the size of a chunk
+ */
+#define EXPORT_HANDLE_DEFAULT_PROCESS_BUFFER_SIZE	8388608
+
+/* The minimum and maximum process buffer size
+ */
+#define EXPORT_HANDLE_MINIMUM_PROCESS_BUFFER_SIZE	65536
+#define EXPORT_HANDLE_MAXIMUM_PROCESS_BUFFER_SIZE	268435456
+
+/* The default number of threads
+ */
+#define EXPORT_HANDLE_DEFAULT_NUMBER_OF_THREADS		4
+
+/* The maximum number of threads
+ */
+#define EXPORT_HANDLE_MAXIMUM_NUMBER_OF_THREADS		64
+
+/* The maximum queue depth
+ */
+#define EXPORT_HANDLE_MAXIMUM_QUEUE_DEPTH		256
+
+/* The alignment of the chunk data and output offsets required by direct IO
+ */
+#define EXPORT_HANDLE_DIRECT_IO_ALIGNMENT		4096
+
+/* The size of the blocks that are checked for zero bytes when the output
+ * is written sparse, which matches the allocation unit of most file systems
+ */
+#define EXPORT_HANDLE_SPARSE_BLOCK_SIZE			4096
+
+typedef struct export_handle_chunk export_handle_chunk_t;
+
+struct export_handle_chunk
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The data, aligned for direct IO
+	 */
+	uint8_t *data;
+
+	/* The allocated data
+	 */
+	uint8_t *allocated_data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* Value to indicate the chunk was pushed onto the thread pool
+	 * and is not yet read
+	 */
+	int is_pending;
+
+	/* Value to indicate the chunk failed to read
+	 */
+	int has_failed;
+};
+
+typedef struct export_handle_region export_handle_region_t;
+
+struct export_handle_region
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The flags
+	 */
+	uint32_t flags;
+};
+
+typedef struct export_handle export_handle_t;
+
+struct export_handle
+{
+	/* The volume offset
+	 */
+	off64_t volume_offset;
+
+	/* The libbfio input file IO handle
+	 */
+	libbfio_handle_t *input_file_io_handle;
+
+	/* The libbde input volume
+	 */
+	libbde_volume_t *input_volume;
+
+	/* The output file descriptor
+	 */
+	int output_file_descriptor;
+
+	/* Value to indicate direct IO should be used for the output
+	 */
+	int use_direct_io;
+
+	/* Value to indicate the output was opened with direct IO
+	 */
+	int output_has_direct_io;
+
+	/* Value to indicate zero blocks should not be written to the output
+	 */
+	int use_sparse;
+
+	/* Value to indicate the output is written sparse
+	 */
+	int output_is_sparse;
+
+	/* The size of the zero blocks that were not written to the output
+	 */
+	size64_t sparse_size;
+
+	/* The process buffer size
+	 */
+	size_t process_buffer_size;
+
+	/* The number of threads that read and decrypt chunks
+	 */
+	int number_of_threads;
+
+	/* The queue depth, which is the maximum number of chunks in flight
+	 */
+	int queue_depth;
+
+	/* The chunks
+	 */
+	export_handle_chunk_t *chunks;
+
+	/* The number of chunks
+	 */
+	int number_of_chunks;
+
+	/* The regions of the input volume
+	 */
+	export_handle_region_t *regions;
+
+	/* The number of regions
+	 */
+	int number_of_regions;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex that guards the chunks
+	 */
+	libcthreads_mutex_t *chunks_mutex;
+
+	/* The condition that is signalled when a chunk was read
+	 */
+	libcthreads_condition_t *chunks_condition;
+#endif
+
+	/* The hash handle, which calculates the digests of the exported data
+	 */
+	hash_handle_t *hash_handle;
+
+	/* The time the export was started
+	 */
+	time_t start_time;
+
+	/* The time the last status was printed
+	 */
+	time_t last_status_time;
+
+	/* The last percentage that was printed
+	 */
+	int last_status_percentage;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int export_handle_initialize(
+     export_handle_t **export_handle,
+     libcerror_error_t **error );
+
+int export_handle_free(
+     export_handle_t **export_handle,
+     libcerror_error_t **error );
+
+int export_handle_signal_abort(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_set_keys(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_password(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_recovery_password(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_read_startup_key(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int export_handle_read_keyring(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int export_handle_set_volume_offset(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_process_buffer_size(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_number_of_threads(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_queue_depth(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_set_use_direct_io(
+     export_handle_t *export_handle,
+     int use_direct_io,
+     libcerror_error_t **error );
+
+int export_handle_set_use_sparse(
+     export_handle_t *export_handle,
+     int use_sparse,
+     libcerror_error_t **error );
+
+int export_handle_set_digest_types(
+     export_handle_t *export_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int export_handle_open_chunk_hash_list(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int export_handle_open_input(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int export_handle_close_input(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_input_is_locked(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_open_output(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int export_handle_close_output(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_write_buffer(
+     export_handle_t *export_handle,
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int export_handle_skip_buffer(
+     export_handle_t *export_handle,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int export_handle_set_output_size(
+     export_handle_t *export_handle,
+     size64_t output_size,
+     libcerror_error_t **error );
+
+int export_handle_buffer_is_zero(
+     const uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int export_handle_write_chunk(
+     export_handle_t *export_handle,
+     export_handle_chunk_t *chunk,
+     libcerror_error_t **error );
+
+int export_handle_allocate_chunks(
+     export_handle_t *export_handle,
+     int number_of_chunks,
+     libcerror_error_t **error );
+
+int export_handle_free_chunks(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_read_regions(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_free_regions(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_get_range(
+     export_handle_t *export_handle,
+     off64_t offset,
+     size_t *size,
+     int *is_metadata,
+     libcerror_error_t **error );
+
+int export_handle_read_chunk(
+     export_handle_chunk_t *chunk,
+     export_handle_t *export_handle );
+
+int export_handle_wait_for_chunk(
+     export_handle_t *export_handle,
+     export_handle_chunk_t *chunk,
+     libcerror_error_t **error );
+
+int export_handle_update_status(
+     export_handle_t *export_handle,
+     size64_t exported_size,
+     size64_t volume_size,
+     libcerror_error_t **error );
+
+int export_handle_print_summary(
+     export_handle_t *export_handle,
+     size64_t exported_size,
+     libcerror_error_t **error );
+
+int export_handle_export_input(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EXPORT_HANDLE_H ) */
+
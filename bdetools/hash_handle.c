@@ -0,0 +1,2035 @@
+/*
+ * Hash handle
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#include "bdetools_libcerror.h"
+#include "bdetools_libcnotify.h"
+#include "bdetools_libcsplit.h"
+#include "bdetools_libcthreads.h"
+#include "bdetools_libhmac.h"
+#include "digest_hash.h"
+#include "hash_handle.h"
+
+/* Creates a hash handle
+ * Make sure the value hash_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_initialize(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_initialize";
+	int digest_type       = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*hash_handle = memory_allocate_structure(
+	                hash_handle_t );
+
+	if( *hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *hash_handle,
+	     0,
+	     sizeof( hash_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash handle.",
+		 function );
+
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+
+		return( -1 );
+	}
+	for( digest_type = 0;
+	     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		( *hash_handle )->digests[ digest_type ].hash_handle = *hash_handle;
+		( *hash_handle )->digests[ digest_type ].digest_type = digest_type;
+	}
+	( *hash_handle )->digests[ HASH_HANDLE_DIGEST_TYPE_MD5 ].digest_hash_size    = LIBHMAC_MD5_HASH_SIZE;
+	( *hash_handle )->digests[ HASH_HANDLE_DIGEST_TYPE_SHA1 ].digest_hash_size   = LIBHMAC_SHA1_HASH_SIZE;
+	( *hash_handle )->digests[ HASH_HANDLE_DIGEST_TYPE_SHA256 ].digest_hash_size = LIBHMAC_SHA256_HASH_SIZE;
+
+	return( 1 );
+
+on_error:
+	if( *hash_handle != NULL )
+	{
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a hash handle
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_free(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	hash_handle_digest_t *digest = NULL;
+	static char *function        = "hash_handle_free";
+	int digest_type              = 0;
+	int result                   = 1;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		/* The threads reference the buffers and need to be stopped before they can be freed
+		 */
+		if( ( *hash_handle )->is_started != 0 )
+		{
+			( *hash_handle )->abort = 1;
+
+			if( hash_handle_stop(
+			     *hash_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to stop hash handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		for( digest_type = 0;
+		     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+		     digest_type++ )
+		{
+			digest = &( ( *hash_handle )->digests[ digest_type ] );
+
+			if( digest->md5_context != NULL )
+			{
+				if( libhmac_md5_free(
+				     &( digest->md5_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free MD5 context.",
+					 function );
+
+					result = -1;
+				}
+			}
+			if( digest->sha1_context != NULL )
+			{
+				if( libhmac_sha1_free(
+				     &( digest->sha1_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free SHA1 context.",
+					 function );
+
+					result = -1;
+				}
+			}
+			if( digest->sha256_context != NULL )
+			{
+				if( libhmac_sha256_free(
+				     &( digest->sha256_context ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free SHA256 context.",
+					 function );
+
+					result = -1;
+				}
+			}
+		}
+		if( ( *hash_handle )->chunk_hash_list_stream != NULL )
+		{
+			if( hash_handle_close_chunk_hash_list(
+			     *hash_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close chunk hash list.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *hash_handle )->buffers != NULL )
+		{
+			memory_free(
+			 ( *hash_handle )->buffers );
+		}
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the hash handle to abort
+ * The digests of the buffers that are appended after the abort are no longer calculated
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_signal_abort(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_signal_abort";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->abort = 1;
+
+	return( 1 );
+}
+
+/* Sets the digest types
+ * The string contains the digest types separated by a , character e.g. md5,sha1,sha256
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_digest_types(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	system_character_t *string_segment               = NULL;
+	static char *function                            = "hash_handle_set_digest_types";
+	size_t string_length                             = 0;
+	size_t string_segment_size                       = 0;
+	int digest_type                                  = 0;
+	int number_of_segments                           = 0;
+	int segment_index                                = 0;
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	libcsplit_wide_split_string_t *string_elements   = NULL;
+#else
+	libcsplit_narrow_split_string_t *string_elements = NULL;
+#endif
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->is_started != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle - already started.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_string_split(
+	     string,
+	     string_length + 1,
+	     (wchar_t) ',',
+	     &string_elements,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_string_split(
+	     string,
+	     string_length + 1,
+	     (char) ',',
+	     &string_elements,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to split string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_get_number_of_segments(
+	     string_elements,
+	     &number_of_segments,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_get_number_of_segments(
+	     string_elements,
+	     &number_of_segments,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of segments.",
+		 function );
+
+		goto on_error;
+	}
+	for( segment_index = 0;
+	     segment_index < number_of_segments;
+	     segment_index++ )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcsplit_wide_split_string_get_segment_by_index(
+		     string_elements,
+		     segment_index,
+		     &string_segment,
+		     &string_segment_size,
+		     error ) != 1 )
+#else
+		if( libcsplit_narrow_split_string_get_segment_by_index(
+		     string_elements,
+		     segment_index,
+		     &string_segment,
+		     &string_segment_size,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve string segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		if( string_segment == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing string segment: %d.",
+			 function,
+			 segment_index );
+
+			goto on_error;
+		}
+		digest_type = -1;
+
+		if( string_segment_size == 4 )
+		{
+			if( system_string_compare_no_case(
+			     string_segment,
+			     _SYSTEM_STRING( "md5" ),
+			     3 ) == 0 )
+			{
+				digest_type = HASH_HANDLE_DIGEST_TYPE_MD5;
+			}
+		}
+		else if( string_segment_size == 5 )
+		{
+			if( system_string_compare_no_case(
+			     string_segment,
+			     _SYSTEM_STRING( "sha1" ),
+			     4 ) == 0 )
+			{
+				digest_type = HASH_HANDLE_DIGEST_TYPE_SHA1;
+			}
+		}
+		else if( string_segment_size == 6 )
+		{
+			if( system_string_compare_no_case(
+			     string_segment,
+			     _SYSTEM_STRING( "sha-1" ),
+			     5 ) == 0 )
+			{
+				digest_type = HASH_HANDLE_DIGEST_TYPE_SHA1;
+			}
+		}
+		else if( string_segment_size == 7 )
+		{
+			if( system_string_compare_no_case(
+			     string_segment,
+			     _SYSTEM_STRING( "sha256" ),
+			     6 ) == 0 )
+			{
+				digest_type = HASH_HANDLE_DIGEST_TYPE_SHA256;
+			}
+		}
+		else if( string_segment_size == 8 )
+		{
+			if( system_string_compare_no_case(
+			     string_segment,
+			     _SYSTEM_STRING( "sha-256" ),
+			     7 ) == 0 )
+			{
+				digest_type = HASH_HANDLE_DIGEST_TYPE_SHA256;
+			}
+		}
+		if( digest_type == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported digest type: %" PRIs_SYSTEM ".",
+			 function,
+			 string_segment );
+
+			goto on_error;
+		}
+		hash_handle->calculate_digest[ digest_type ] = 1;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libcsplit_wide_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#else
+	if( libcsplit_narrow_split_string_free(
+	     &string_elements,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free split string.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( string_elements != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		libcsplit_wide_split_string_free(
+		 &string_elements,
+		 NULL );
+#else
+		libcsplit_narrow_split_string_free(
+		 &string_elements,
+		 NULL );
+#endif
+	}
+	return( -1 );
+}
+
+/* Opens the chunk hash list
+ * The chunk hash list contains the digest hashes of every buffer
+ * that is appended, which allows to verify parts of the data
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_open_chunk_hash_list(
+     hash_handle_t *hash_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_open_chunk_hash_list";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->chunk_hash_list_stream != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle - chunk hash list stream value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->is_started != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle - already started.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	hash_handle->chunk_hash_list_stream = file_stream_open_wide(
+	                                       filename,
+	                                       _WIDE_STRING( FILE_STREAM_OPEN_WRITE ) );
+#else
+	hash_handle->chunk_hash_list_stream = file_stream_open(
+	                                       filename,
+	                                       FILE_STREAM_OPEN_WRITE );
+#endif
+	if( hash_handle->chunk_hash_list_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open chunk hash list.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the chunk hash list
+ * Returns the 0 if succesful or -1 on error
+ */
+int hash_handle_close_chunk_hash_list(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_close_chunk_hash_list";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->chunk_hash_list_stream != NULL )
+	{
+		if( file_stream_close(
+		     hash_handle->chunk_hash_list_stream ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close chunk hash list stream.",
+			 function );
+
+			hash_handle->chunk_hash_list_stream = NULL;
+
+			return( -1 );
+		}
+		hash_handle->chunk_hash_list_stream = NULL;
+	}
+	return( 0 );
+}
+
+/* Starts calculating the digests
+ * The number of buffers is the maximum number of buffers that can be appended
+ * before their digests have been calculated. If use threads is set every digest
+ * is calculated by its own thread
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_start(
+     hash_handle_t *hash_handle,
+     int number_of_buffers,
+     uint8_t use_threads,
+     libcerror_error_t **error )
+{
+	hash_handle_digest_t *digest = NULL;
+	static char *function        = "hash_handle_start";
+	int digest_type              = 0;
+	int result                   = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->is_started != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle - already started.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_buffers <= 0 )
+	 || ( number_of_buffers > HASH_HANDLE_MAXIMUM_NUMBER_OF_BUFFERS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->buffers = (hash_handle_buffer_t *) memory_allocate(
+	                                                 sizeof( hash_handle_buffer_t ) * number_of_buffers );
+
+	if( hash_handle->buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     hash_handle->buffers,
+	     0,
+	     sizeof( hash_handle_buffer_t ) * number_of_buffers ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear buffers.",
+		 function );
+
+		goto on_error;
+	}
+	hash_handle->number_of_buffers          = number_of_buffers;
+	hash_handle->number_of_appended_buffers = 0;
+	hash_handle->number_of_listed_buffers   = 0;
+	hash_handle->is_stopping                = 0;
+
+	for( digest_type = 0;
+	     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		if( hash_handle->calculate_digest[ digest_type ] == 0 )
+		{
+			continue;
+		}
+		digest = &( hash_handle->digests[ digest_type ] );
+
+		digest->number_of_processed_buffers = 0;
+		digest->has_failed                  = 0;
+
+		switch( digest_type )
+		{
+			case HASH_HANDLE_DIGEST_TYPE_MD5:
+				result = libhmac_md5_initialize(
+				          &( digest->md5_context ),
+				          error );
+				break;
+
+			case HASH_HANDLE_DIGEST_TYPE_SHA1:
+				result = libhmac_sha1_initialize(
+				          &( digest->sha1_context ),
+				          error );
+				break;
+
+			case HASH_HANDLE_DIGEST_TYPE_SHA256:
+				result = libhmac_sha256_initialize(
+				          &( digest->sha256_context ),
+				          error );
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize digest: %d context.",
+			 function,
+			 digest_type );
+
+			goto on_error;
+		}
+	}
+	if( hash_handle->chunk_hash_list_stream != NULL )
+	{
+		fprintf(
+		 hash_handle->chunk_hash_list_stream,
+		 "# Offset\tSize" );
+
+		if( hash_handle->calculate_digest[ HASH_HANDLE_DIGEST_TYPE_MD5 ] != 0 )
+		{
+			fprintf(
+			 hash_handle->chunk_hash_list_stream,
+			 "\tMD5" );
+		}
+		if( hash_handle->calculate_digest[ HASH_HANDLE_DIGEST_TYPE_SHA1 ] != 0 )
+		{
+			fprintf(
+			 hash_handle->chunk_hash_list_stream,
+			 "\tSHA1" );
+		}
+		if( hash_handle->calculate_digest[ HASH_HANDLE_DIGEST_TYPE_SHA256 ] != 0 )
+		{
+			fprintf(
+			 hash_handle->chunk_hash_list_stream,
+			 "\tSHA256" );
+		}
+		fprintf(
+		 hash_handle->chunk_hash_list_stream,
+		 "\n" );
+	}
+	/* Set is started here so that the threads are stopped on error
+	 */
+	hash_handle->is_started = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( use_threads != 0 )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( hash_handle->buffers_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create buffers mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_condition_initialize(
+		     &( hash_handle->append_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create append condition.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_condition_initialize(
+		     &( hash_handle->process_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create process condition.",
+			 function );
+
+			goto on_error;
+		}
+		for( digest_type = 0;
+		     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+		     digest_type++ )
+		{
+			if( hash_handle->calculate_digest[ digest_type ] == 0 )
+			{
+				continue;
+			}
+			if( libcthreads_thread_create(
+			     &( hash_handle->digests[ digest_type ].thread ),
+			     NULL,
+			     (int (*)(void *)) &hash_handle_digest_thread_function,
+			     (void *) &( hash_handle->digests[ digest_type ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create digest: %d thread.",
+				 function,
+				 digest_type );
+
+				goto on_error;
+			}
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( hash_handle->is_started != 0 )
+	{
+		hash_handle->abort = 1;
+
+		hash_handle_stop(
+		 hash_handle,
+		 NULL );
+
+		hash_handle->is_started = 0;
+	}
+	if( hash_handle->buffers != NULL )
+	{
+		memory_free(
+		 hash_handle->buffers );
+
+		hash_handle->buffers = NULL;
+	}
+	hash_handle->number_of_buffers = 0;
+
+	return( -1 );
+}
+
+/* Stops calculating the digests
+ * The buffers that were appended before are processed before the threads are joined
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_stop(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_stop";
+	int result            = 1;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int digest_type       = 0;
+#endif
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( hash_handle->buffers_mutex != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     hash_handle->buffers_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab buffers mutex.",
+			 function );
+
+			return( -1 );
+		}
+		hash_handle->is_stopping = 1;
+
+		if( hash_handle->append_condition != NULL )
+		{
+			if( libcthreads_condition_broadcast(
+			     hash_handle->append_condition,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to broadcast append condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_release(
+		     hash_handle->buffers_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release buffers mutex.",
+			 function );
+
+			return( -1 );
+		}
+		for( digest_type = 0;
+		     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+		     digest_type++ )
+		{
+			if( hash_handle->digests[ digest_type ].thread == NULL )
+			{
+				continue;
+			}
+			if( libcthreads_thread_join(
+			     &( hash_handle->digests[ digest_type ].thread ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join digest: %d thread.",
+				 function,
+				 digest_type );
+
+				result = -1;
+			}
+		}
+	}
+	if( hash_handle->process_condition != NULL )
+	{
+		if( libcthreads_condition_free(
+		     &( hash_handle->process_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free process condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( hash_handle->append_condition != NULL )
+	{
+		if( libcthreads_condition_free(
+		     &( hash_handle->append_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free append condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( hash_handle->buffers_mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( hash_handle->buffers_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free buffers mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	hash_handle->is_stopping = 1;
+
+	return( result );
+}
+
+/* Calculates the digest of a buffer
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_digest_process_buffer(
+     hash_handle_digest_t *digest,
+     hash_handle_buffer_t *buffer,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer_digest_hash = NULL;
+	static char *function       = "hash_handle_digest_process_buffer";
+	int result                  = 0;
+
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest->hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid digest - missing hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* The digest hash of the buffer itself is calculated separately
+	 * since the digest context cannot be finalized in between
+	 */
+	if( digest->hash_handle->chunk_hash_list_stream != NULL )
+	{
+		buffer_digest_hash = buffer->digest_hashes[ digest->digest_type ];
+	}
+	switch( digest->digest_type )
+	{
+		case HASH_HANDLE_DIGEST_TYPE_MD5:
+			result = libhmac_md5_update(
+			          digest->md5_context,
+			          buffer->data,
+			          buffer->data_size,
+			          error );
+
+			if( ( result == 1 )
+			 && ( buffer_digest_hash != NULL ) )
+			{
+				result = libhmac_md5_calculate(
+				          buffer->data,
+				          buffer->data_size,
+				          buffer_digest_hash,
+				          digest->digest_hash_size,
+				          error );
+			}
+			break;
+
+		case HASH_HANDLE_DIGEST_TYPE_SHA1:
+			result = libhmac_sha1_update(
+			          digest->sha1_context,
+			          buffer->data,
+			          buffer->data_size,
+			          error );
+
+			if( ( result == 1 )
+			 && ( buffer_digest_hash != NULL ) )
+			{
+				result = libhmac_sha1_calculate(
+				          buffer->data,
+				          buffer->data_size,
+				          buffer_digest_hash,
+				          digest->digest_hash_size,
+				          error );
+			}
+			break;
+
+		case HASH_HANDLE_DIGEST_TYPE_SHA256:
+			result = libhmac_sha256_update(
+			          digest->sha256_context,
+			          buffer->data,
+			          buffer->data_size,
+			          error );
+
+			if( ( result == 1 )
+			 && ( buffer_digest_hash != NULL ) )
+			{
+				result = libhmac_sha256_calculate(
+				          buffer->data,
+				          buffer->data_size,
+				          buffer_digest_hash,
+				          digest->digest_hash_size,
+				          error );
+			}
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported digest type.",
+			 function );
+
+			return( -1 );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to calculate digest: %d of buffer at offset: %" PRIi64 ".",
+		 function,
+		 digest->digest_type,
+		 buffer->offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* Processes the appended buffers in order until the hash handle is stopped
+ * Start function of the digest threads
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_digest_thread_function(
+     hash_handle_digest_t *digest )
+{
+	hash_handle_buffer_t *buffer = NULL;
+	hash_handle_t *hash_handle   = NULL;
+	libcerror_error_t *error     = NULL;
+	static char *function        = "hash_handle_digest_thread_function";
+	int process_failed           = 0;
+	int result                   = 1;
+
+	if( digest == NULL )
+	{
+		return( -1 );
+	}
+	hash_handle = digest->hash_handle;
+
+	if( hash_handle == NULL )
+	{
+		return( -1 );
+	}
+	while( result == 1 )
+	{
+		if( libcthreads_mutex_grab(
+		     hash_handle->buffers_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab buffers mutex.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		while( ( digest->number_of_processed_buffers == hash_handle->number_of_appended_buffers )
+		    && ( hash_handle->is_stopping == 0 ) )
+		{
+			if( libcthreads_condition_wait(
+			     hash_handle->append_condition,
+			     hash_handle->buffers_mutex,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to wait for append condition.",
+				 function );
+
+				result = -1;
+
+				break;
+			}
+		}
+		if( result != 1 )
+		{
+			libcthreads_mutex_release(
+			 hash_handle->buffers_mutex,
+			 NULL );
+
+			break;
+		}
+		/* All buffers have been processed and no more buffers will be appended
+		 */
+		if( digest->number_of_processed_buffers == hash_handle->number_of_appended_buffers )
+		{
+			libcthreads_mutex_release(
+			 hash_handle->buffers_mutex,
+			 NULL );
+
+			break;
+		}
+		buffer = &( hash_handle->buffers[ digest->number_of_processed_buffers % hash_handle->number_of_buffers ] );
+
+		if( libcthreads_mutex_release(
+		     hash_handle->buffers_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release buffers mutex.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		/* The buffer is not changed until it was processed by every digest,
+		 * hence the digest is calculated outside of the lock. After a failure
+		 * or abort the buffers are still consumed so that the caller does not block
+		 */
+		process_failed = 0;
+
+		if( ( digest->has_failed == 0 )
+		 && ( hash_handle->abort == 0 ) )
+		{
+			if( hash_handle_digest_process_buffer(
+			     digest,
+			     buffer,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to process buffer.",
+				 function );
+
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_print_error_backtrace(
+					 error );
+				}
+				libcerror_error_free(
+				 &error );
+
+				process_failed = 1;
+			}
+		}
+		if( libcthreads_mutex_grab(
+		     hash_handle->buffers_mutex,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab buffers mutex.",
+			 function );
+
+			result = -1;
+
+			break;
+		}
+		/* The failed state is changed while holding the lock since
+		 * it is read when determining the number of processed buffers
+		 */
+		if( process_failed != 0 )
+		{
+			digest->has_failed = 1;
+		}
+		digest->number_of_processed_buffers += 1;
+
+		libcthreads_condition_broadcast(
+		 hash_handle->process_condition,
+		 NULL );
+
+		libcthreads_mutex_release(
+		 hash_handle->buffers_mutex,
+		 NULL );
+	}
+	if( result != 1 )
+	{
+		/* The digest no longer consumes buffers, hence it is marked as failed
+		 * and the threads that wait for the buffers to be processed are woken
+		 * so that they no longer wait for this digest
+		 */
+		if( libcthreads_mutex_grab(
+		     hash_handle->buffers_mutex,
+		     NULL ) == 1 )
+		{
+			digest->has_failed = 1;
+
+			libcthreads_condition_broadcast(
+			 hash_handle->process_condition,
+			 NULL );
+
+			libcthreads_mutex_release(
+			 hash_handle->buffers_mutex,
+			 NULL );
+		}
+		else
+		{
+			digest->has_failed = 1;
+
+			libcthreads_condition_broadcast(
+			 hash_handle->process_condition,
+			 NULL );
+		}
+	}
+	if( error != NULL )
+	{
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Retrieves the number of buffers that were processed by every digest
+ * A digest that failed no longer reads the data of the buffers and is considered
+ * to have processed all the appended buffers
+ * The caller must hold the buffers mutex when threads are used
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_get_number_of_processed_buffers(
+     hash_handle_t *hash_handle,
+     uint64_t *number_of_processed_buffers,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_get_number_of_processed_buffers";
+	int digest_type       = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_processed_buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of processed buffers.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_processed_buffers = hash_handle->number_of_appended_buffers;
+
+	for( digest_type = 0;
+	     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		if( ( hash_handle->calculate_digest[ digest_type ] == 0 )
+		 || ( hash_handle->digests[ digest_type ].has_failed != 0 ) )
+		{
+			continue;
+		}
+		if( hash_handle->digests[ digest_type ].number_of_processed_buffers < *number_of_processed_buffers )
+		{
+			*number_of_processed_buffers = hash_handle->digests[ digest_type ].number_of_processed_buffers;
+		}
+	}
+	return( 1 );
+}
+
+/* Waits until a number of buffers was processed by every digest
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_wait_for_buffers(
+     hash_handle_t *hash_handle,
+     uint64_t number_of_buffers,
+     libcerror_error_t **error )
+{
+	static char *function                = "hash_handle_wait_for_buffers";
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	uint64_t number_of_processed_buffers = 0;
+	int result                           = 1;
+#endif
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buffers > hash_handle->number_of_appended_buffers )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buffers value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( hash_handle->buffers_mutex == NULL )
+	{
+		return( 1 );
+	}
+	if( libcthreads_mutex_grab(
+	     hash_handle->buffers_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab buffers mutex.",
+		 function );
+
+		return( -1 );
+	}
+	while( result == 1 )
+	{
+		if( hash_handle_get_number_of_processed_buffers(
+		     hash_handle,
+		     &number_of_processed_buffers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of processed buffers.",
+			 function );
+
+			result = -1;
+		}
+		else if( number_of_processed_buffers >= number_of_buffers )
+		{
+			break;
+		}
+		else if( libcthreads_condition_wait(
+		          hash_handle->process_condition,
+		          hash_handle->buffers_mutex,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for process condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     hash_handle->buffers_mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release buffers mutex.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+#else
+	return( 1 );
+#endif
+}
+
+/* Writes the digest hashes of the processed buffers to the chunk hash list
+ * Only buffers that were processed by every digest can be listed
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_list_buffers(
+     hash_handle_t *hash_handle,
+     uint64_t number_of_buffers,
+     libcerror_error_t **error )
+{
+	system_character_t digest_hash_string[ ( 2 * HASH_HANDLE_MAXIMUM_DIGEST_HASH_SIZE ) + 1 ];
+
+	hash_handle_buffer_t *buffer = NULL;
+	static char *function        = "hash_handle_list_buffers";
+	int digest_type              = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->chunk_hash_list_stream == NULL )
+	{
+		return( 1 );
+	}
+	while( hash_handle->number_of_listed_buffers < number_of_buffers )
+	{
+		buffer = &( hash_handle->buffers[ hash_handle->number_of_listed_buffers % hash_handle->number_of_buffers ] );
+
+		fprintf(
+		 hash_handle->chunk_hash_list_stream,
+		 "%" PRIi64 "\t%" PRIu64 "",
+		 buffer->offset,
+		 (uint64_t) buffer->data_size );
+
+		for( digest_type = 0;
+		     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+		     digest_type++ )
+		{
+			if( hash_handle->calculate_digest[ digest_type ] == 0 )
+			{
+				continue;
+			}
+			if( digest_hash_copy_to_string(
+			     buffer->digest_hashes[ digest_type ],
+			     hash_handle->digests[ digest_type ].digest_hash_size,
+			     digest_hash_string,
+			     ( 2 * HASH_HANDLE_MAXIMUM_DIGEST_HASH_SIZE ) + 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to copy digest: %d hash to string.",
+				 function,
+				 digest_type );
+
+				return( -1 );
+			}
+			fprintf(
+			 hash_handle->chunk_hash_list_stream,
+			 "\t%" PRIs_SYSTEM "",
+			 digest_hash_string );
+		}
+		fprintf(
+		 hash_handle->chunk_hash_list_stream,
+		 "\n" );
+
+		hash_handle->number_of_listed_buffers += 1;
+	}
+	return( 1 );
+}
+
+/* Appends a buffer of which the digests are calculated
+ * The data is referenced and must not be changed until the buffer
+ * was processed, refer to hash_handle_wait_for_buffers
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_append_buffer(
+     hash_handle_t *hash_handle,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	hash_handle_buffer_t *buffer   = NULL;
+	static char *function          = "hash_handle_append_buffer";
+	uint64_t number_of_buffers     = 0;
+	int digest_type                = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( hash_handle->is_started == 0 )
+	 || ( hash_handle->is_stopping != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid hash handle - not started or stopped.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* The buffer that is reused must be processed and listed first
+	 */
+	if( hash_handle->number_of_appended_buffers >= (uint64_t) hash_handle->number_of_buffers )
+	{
+		number_of_buffers = hash_handle->number_of_appended_buffers - hash_handle->number_of_buffers + 1;
+
+		if( hash_handle_wait_for_buffers(
+		     hash_handle,
+		     number_of_buffers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to wait for buffers.",
+			 function );
+
+			return( -1 );
+		}
+		if( hash_handle_list_buffers(
+		     hash_handle,
+		     number_of_buffers,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to list buffers.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	buffer = &( hash_handle->buffers[ hash_handle->number_of_appended_buffers % hash_handle->number_of_buffers ] );
+
+	buffer->offset    = offset;
+	buffer->data      = data;
+	buffer->data_size = data_size;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	if( hash_handle->buffers_mutex != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     hash_handle->buffers_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab buffers mutex.",
+			 function );
+
+			return( -1 );
+		}
+		hash_handle->number_of_appended_buffers += 1;
+
+		if( libcthreads_condition_broadcast(
+		     hash_handle->append_condition,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to broadcast append condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 hash_handle->buffers_mutex,
+			 NULL );
+
+			return( -1 );
+		}
+		if( libcthreads_mutex_release(
+		     hash_handle->buffers_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release buffers mutex.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+#endif
+	for( digest_type = 0;
+	     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		if( hash_handle->calculate_digest[ digest_type ] == 0 )
+		{
+			continue;
+		}
+		if( hash_handle->abort == 0 )
+		{
+			if( hash_handle_digest_process_buffer(
+			     &( hash_handle->digests[ digest_type ] ),
+			     buffer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to process buffer.",
+				 function );
+
+				hash_handle->digests[ digest_type ].has_failed = 1;
+
+				return( -1 );
+			}
+		}
+		hash_handle->digests[ digest_type ].number_of_processed_buffers += 1;
+	}
+	hash_handle->number_of_appended_buffers += 1;
+
+	return( 1 );
+}
+
+/* Finalizes the digests
+ * Stops the hash handle and determines the digest hash strings
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_finalize(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	hash_handle_digest_t *digest = NULL;
+	static char *function        = "hash_handle_finalize";
+	int digest_type              = 0;
+	int result                   = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->is_started == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid hash handle - not started.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle_stop(
+	     hash_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->is_started = 0;
+
+	if( hash_handle->abort != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+		 "%s: digest calculation aborted.",
+		 function );
+
+		return( -1 );
+	}
+	for( digest_type = 0;
+	     digest_type < HASH_HANDLE_NUMBER_OF_DIGEST_TYPES;
+	     digest_type++ )
+	{
+		if( hash_handle->calculate_digest[ digest_type ] == 0 )
+		{
+			continue;
+		}
+		digest = &( hash_handle->digests[ digest_type ] );
+
+		if( digest->has_failed != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to calculate digest: %d.",
+			 function,
+			 digest_type );
+
+			return( -1 );
+		}
+		switch( digest_type )
+		{
+			case HASH_HANDLE_DIGEST_TYPE_MD5:
+				result = libhmac_md5_finalize(
+				          digest->md5_context,
+				          digest->digest_hash,
+				          digest->digest_hash_size,
+				          error );
+				break;
+
+			case HASH_HANDLE_DIGEST_TYPE_SHA1:
+				result = libhmac_sha1_finalize(
+				          digest->sha1_context,
+				          digest->digest_hash,
+				          digest->digest_hash_size,
+				          error );
+				break;
+
+			case HASH_HANDLE_DIGEST_TYPE_SHA256:
+				result = libhmac_sha256_finalize(
+				          digest->sha256_context,
+				          digest->digest_hash,
+				          digest->digest_hash_size,
+				          error );
+				break;
+		}
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to finalize digest: %d context.",
+			 function,
+			 digest_type );
+
+			return( -1 );
+		}
+		if( digest_hash_copy_to_string(
+		     digest->digest_hash,
+		     digest->digest_hash_size,
+		     digest->digest_hash_string,
+		     ( 2 * HASH_HANDLE_MAXIMUM_DIGEST_HASH_SIZE ) + 1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to copy digest: %d hash to string.",
+			 function,
+			 digest_type );
+
+			return( -1 );
+		}
+	}
+	if( hash_handle_list_buffers(
+	     hash_handle,
+	     hash_handle->number_of_appended_buffers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to list buffers.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Prints the digest hashes
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_fprint(
+     hash_handle_t *hash_handle,
+     FILE *stream,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_fprint";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->calculate_digest[ HASH_HANDLE_DIGEST_TYPE_MD5 ] != 0 )
+	{
+		fprintf(
+		 stream,
+		 "MD5 hash calculated over data:\t\t%" PRIs_SYSTEM "\n",
+		 hash_handle->digests[ HASH_HANDLE_DIGEST_TYPE_MD5 ].digest_hash_string );
+	}
+	if( hash_handle->calculate_digest[ HASH_HANDLE_DIGEST_TYPE_SHA1 ] != 0 )
+	{
+		fprintf(
+		 stream,
+		 "SHA1 hash calculated over data:\t\t%" PRIs_SYSTEM "\n",
+		 hash_handle->digests[ HASH_HANDLE_DIGEST_TYPE_SHA1 ].digest_hash_string );
+	}
+	if( hash_handle->calculate_digest[ HASH_HANDLE_DIGEST_TYPE_SHA256 ] != 0 )
+	{
+		fprintf(
+		 stream,
+		 "SHA256 hash calculated over data:\t%" PRIs_SYSTEM "\n",
+		 hash_handle->digests[ HASH_HANDLE_DIGEST_TYPE_SHA256 ].digest_hash_string );
+	}
+	return( 1 );
+}
+
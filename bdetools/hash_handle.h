@@ -0,0 +1,271 @@
+/*
+ * Hash handle
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _HASH_HANDLE_H )
+#define _HASH_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "bdetools_libcerror.h"
+#include "bdetools_libcthreads.h"
+#include "bdetools_libhmac.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+enum HASH_HANDLE_DIGEST_TYPES
+{
+	HASH_HANDLE_DIGEST_TYPE_MD5		= 0,
+	HASH_HANDLE_DIGEST_TYPE_SHA1		= 1,
+	HASH_HANDLE_DIGEST_TYPE_SHA256		= 2
+};
+
+/* The number of supported digest types
+ */
+#define HASH_HANDLE_NUMBER_OF_DIGEST_TYPES	3
+
+/* The maximum size of a digest hash of the supported digest types
+ */
+#define HASH_HANDLE_MAXIMUM_DIGEST_HASH_SIZE	32
+
+/* The maximum number of buffers
+ */
+#define HASH_HANDLE_MAXIMUM_NUMBER_OF_BUFFERS	256
+
+typedef struct hash_handle hash_handle_t;
+
+typedef struct hash_handle_buffer hash_handle_buffer_t;
+
+struct hash_handle_buffer
+{
+	/* The offset of the data
+	 */
+	off64_t offset;
+
+	/* The data, which is owned by the caller
+	 */
+	const uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The digest hashes of the data of the buffer, used for the chunk hash list
+	 */
+	uint8_t digest_hashes[ HASH_HANDLE_NUMBER_OF_DIGEST_TYPES ][ HASH_HANDLE_MAXIMUM_DIGEST_HASH_SIZE ];
+};
+
+typedef struct hash_handle_digest hash_handle_digest_t;
+
+struct hash_handle_digest
+{
+	/* The hash handle
+	 */
+	hash_handle_t *hash_handle;
+
+	/* The digest type
+	 */
+	int digest_type;
+
+	/* The digest hash size
+	 */
+	size_t digest_hash_size;
+
+	/* The MD5 context
+	 */
+	libhmac_md5_context_t *md5_context;
+
+	/* The SHA1 context
+	 */
+	libhmac_sha1_context_t *sha1_context;
+
+	/* The SHA256 context
+	 */
+	libhmac_sha256_context_t *sha256_context;
+
+	/* The digest hash
+	 */
+	uint8_t digest_hash[ HASH_HANDLE_MAXIMUM_DIGEST_HASH_SIZE ];
+
+	/* The digest hash string
+	 */
+	system_character_t digest_hash_string[ ( 2 * HASH_HANDLE_MAXIMUM_DIGEST_HASH_SIZE ) + 1 ];
+
+	/* The number of buffers processed by the digest
+	 */
+	uint64_t number_of_processed_buffers;
+
+	/* Value to indicate the digest failed to process a buffer
+	 */
+	int has_failed;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The thread that processes the buffers
+	 */
+	libcthreads_thread_t *thread;
+#endif
+};
+
+struct hash_handle
+{
+	/* Value to indicate which digest types should be calculated
+	 */
+	uint8_t calculate_digest[ HASH_HANDLE_NUMBER_OF_DIGEST_TYPES ];
+
+	/* The digests
+	 */
+	hash_handle_digest_t digests[ HASH_HANDLE_NUMBER_OF_DIGEST_TYPES ];
+
+	/* The buffers, which are used as a ring
+	 */
+	hash_handle_buffer_t *buffers;
+
+	/* The number of buffers
+	 */
+	int number_of_buffers;
+
+	/* The number of buffers appended
+	 */
+	uint64_t number_of_appended_buffers;
+
+	/* The number of buffers written to the chunk hash list
+	 */
+	uint64_t number_of_listed_buffers;
+
+	/* The chunk hash list stream
+	 */
+	FILE *chunk_hash_list_stream;
+
+	/* Value to indicate the hash handle was started
+	 */
+	int is_started;
+
+	/* Value to indicate no more buffers will be appended
+	 */
+	int is_stopping;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	/* The mutex that guards the buffers
+	 */
+	libcthreads_mutex_t *buffers_mutex;
+
+	/* The condition that is signalled when a buffer was appended
+	 */
+	libcthreads_condition_t *append_condition;
+
+	/* The condition that is signalled when a buffer was processed
+	 */
+	libcthreads_condition_t *process_condition;
+#endif
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int hash_handle_initialize(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_free(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_signal_abort(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_set_digest_types(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_open_chunk_hash_list(
+     hash_handle_t *hash_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int hash_handle_close_chunk_hash_list(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_start(
+     hash_handle_t *hash_handle,
+     int number_of_buffers,
+     uint8_t use_threads,
+     libcerror_error_t **error );
+
+int hash_handle_stop(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_digest_process_buffer(
+     hash_handle_digest_t *digest,
+     hash_handle_buffer_t *buffer,
+     libcerror_error_t **error );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+int hash_handle_digest_thread_function(
+     hash_handle_digest_t *digest );
+
+#endif
+
+int hash_handle_get_number_of_processed_buffers(
+     hash_handle_t *hash_handle,
+     uint64_t *number_of_processed_buffers,
+     libcerror_error_t **error );
+
+int hash_handle_wait_for_buffers(
+     hash_handle_t *hash_handle,
+     uint64_t number_of_buffers,
+     libcerror_error_t **error );
+
+int hash_handle_list_buffers(
+     hash_handle_t *hash_handle,
+     uint64_t number_of_buffers,
+     libcerror_error_t **error );
+
+int hash_handle_append_buffer(
+     hash_handle_t *hash_handle,
+     off64_t offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int hash_handle_finalize(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_fprint(
+     hash_handle_t *hash_handle,
+     FILE *stream,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _HASH_HANDLE_H ) */
+
@@ -36,6 +36,7 @@
 #include "bdetools_libfdatetime.h"
 #include "bdetools_libfguid.h"
 #include "bdetools_libuna.h"
+#include "hash_handle.h"
 #include "info_handle.h"
 
 #if !defined( LIBBDE_HAVE_BFIO )
@@ -51,6 +52,23 @@ int libbde_volume_open_file_io_handle(
 
 #define INFO_HANDLE_NOTIFY_STREAM		stdout
 
+/* The number of passwords tested per batch, a multiple of the number of SIMD lanes
+ */
+#define INFO_HANDLE_PASSWORDS_BATCH_SIZE	256
+
+/* The maximum size of a password line including the end-of-string character
+ */
+#define INFO_HANDLE_MAXIMUM_PASSWORD_SIZE	256
+
+/* The size of the buffers in which the volume data is read to calculate the digests
+ */
+#define INFO_HANDLE_DIGEST_BUFFER_SIZE		4194304
+
+/* The number of buffers in which the volume data is read to calculate the digests,
+ * which allows the digests to be calculated while the next buffers are read
+ */
+#define INFO_HANDLE_DIGEST_NUMBER_OF_BUFFERS	4
+
 /* Creates an info handle
  * Make sure the value info_handle is referencing, is set to NULL
  * Returns 1 if successful or -1 on error
@@ -186,6 +204,22 @@ int info_handle_free(
 	}
 	if( *info_handle != NULL )
 	{
+		if( ( *info_handle )->hash_handle != NULL )
+		{
+			if( hash_handle_free(
+			     &( ( *info_handle )->hash_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free hash handle.",
+				 function );
+
+				result = -1;
+			}
+		}
 		if( libbde_volume_free(
 		     &( ( *info_handle )->input_volume ),
 		     error ) != 1 )
@@ -240,6 +274,8 @@ int info_handle_signal_abort(
 
 		return( -1 );
 	}
+	info_handle->abort = 1;
+
 	if( info_handle->input_volume != NULL )
 	{
 		if( libbde_volume_signal_abort(
@@ -256,6 +292,22 @@ int info_handle_signal_abort(
 			return( -1 );
 		}
 	}
+	if( info_handle->hash_handle != NULL )
+	{
+		if( hash_handle_signal_abort(
+		     info_handle->hash_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal hash handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
 	return( 1 );
 }
 
@@ -794,6 +846,51 @@ int info_handle_read_startup_key(
 	return( 1 );
 }
 
+/* Reads the keys from a keyring file
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_read_keyring(
+     info_handle_t *info_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_read_keyring";
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbde_volume_read_keyring_wide(
+	     info_handle->input_volume,
+	     filename,
+	     error ) != 1 )
+#else
+	if( libbde_volume_read_keyring(
+	     info_handle->input_volume,
+	     filename,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read keyring.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Sets the volume offset
  * Returns 1 if successful or -1 on error
  */
@@ -840,6 +937,129 @@ int info_handle_set_volume_offset(
 	return( 1 );
 }
 
+/* Sets the number of threads
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_set_number_of_threads(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( libcsystem_string_decimal_copy_to_64_bit(
+	     string,
+	     string_length + 1,
+	     &value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to 64-bit decimal.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > (uint64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_volume_set_number_of_decryption_threads(
+	     info_handle->input_volume,
+	     (int) value_64bit,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set number of threads.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Sets the digest types that are calculated over the volume data
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_set_digest_types(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_set_digest_types";
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->hash_handle == NULL )
+	{
+		if( hash_handle_initialize(
+		     &( info_handle->hash_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize hash handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( hash_handle_set_digest_types(
+	     info_handle->hash_handle,
+	     string,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set digest types.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Opens the info handle
  * Returns 1 if successful or -1 on error
  */
@@ -999,6 +1219,460 @@ int info_handle_input_is_locked(
 	return( result );
 }
 
+/* Tests the passwords or recovery passwords in a file against the input volume
+ * The file contains one UTF-8 formatted password per line, empty lines are ignored
+ * The passwords are tested in batches of INFO_HANDLE_PASSWORDS_BATCH_SIZE
+ * Returns 1 if a password unlocks the volume, 0 if not or -1 on error
+ */
+int info_handle_test_passwords_file(
+     info_handle_t *info_handle,
+     const system_character_t *filename,
+     uint8_t is_recovery_password,
+     libcerror_error_t **error )
+{
+	const uint8_t *strings[ INFO_HANDLE_PASSWORDS_BATCH_SIZE ];
+	size_t string_lengths[ INFO_HANDLE_PASSWORDS_BATCH_SIZE ];
+	int line_numbers[ INFO_HANDLE_PASSWORDS_BATCH_SIZE ];
+
+	FILE *file_stream      = NULL;
+	uint8_t *strings_data  = NULL;
+	uint8_t *string        = NULL;
+	static char *function  = "info_handle_test_passwords_file";
+	size_t string_length   = 0;
+	int at_end             = 0;
+	int line_number        = 0;
+	int number_of_strings  = 0;
+	int password_index     = 0;
+	int result             = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	strings_data = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * INFO_HANDLE_PASSWORDS_BATCH_SIZE * INFO_HANDLE_MAXIMUM_PASSWORD_SIZE );
+
+	if( strings_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create strings data.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	file_stream = file_stream_open_wide(
+	               filename,
+	               _WIDE_STRING( FILE_STREAM_OPEN_READ ) );
+#else
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_OPEN_READ );
+#endif
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open passwords file.",
+		 function );
+
+		goto on_error;
+	}
+	while( ( at_end == 0 )
+	    && ( result == 0 ) )
+	{
+		if( info_handle->abort != 0 )
+		{
+			break;
+		}
+		number_of_strings = 0;
+
+		while( number_of_strings < INFO_HANDLE_PASSWORDS_BATCH_SIZE )
+		{
+			string = &( strings_data[ number_of_strings * INFO_HANDLE_MAXIMUM_PASSWORD_SIZE ] );
+
+			if( file_stream_get_string(
+			     file_stream,
+			     (char *) string,
+			     INFO_HANDLE_MAXIMUM_PASSWORD_SIZE ) == NULL )
+			{
+				at_end = 1;
+
+				break;
+			}
+			line_number++;
+
+			string_length = narrow_string_length(
+			                 (char *) string );
+
+			while( ( string_length > 0 )
+			    && ( ( string[ string_length - 1 ] == (uint8_t) '\n' )
+			     ||  ( string[ string_length - 1 ] == (uint8_t) '\r' ) ) )
+			{
+				string_length--;
+			}
+			if( string_length == 0 )
+			{
+				continue;
+			}
+			strings[ number_of_strings ]        = string;
+			string_lengths[ number_of_strings ] = string_length;
+			line_numbers[ number_of_strings ]   = line_number;
+
+			number_of_strings++;
+		}
+		if( number_of_strings == 0 )
+		{
+			continue;
+		}
+		if( is_recovery_password == 0 )
+		{
+			result = libbde_volume_test_utf8_passwords(
+			          info_handle->input_volume,
+			          strings,
+			          string_lengths,
+			          number_of_strings,
+			          &password_index,
+			          error );
+		}
+		else
+		{
+			result = libbde_volume_test_utf8_recovery_passwords(
+			          info_handle->input_volume,
+			          strings,
+			          string_lengths,
+			          number_of_strings,
+			          &password_index,
+			          error );
+		}
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to test passwords of lines: %d to %d.",
+			 function,
+			 line_numbers[ 0 ],
+			 line_numbers[ number_of_strings - 1 ] );
+
+			goto on_error;
+		}
+	}
+	if( result == 1 )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "%s found on line: %d\n",
+		 ( is_recovery_password == 0 ) ? "Password" : "Recovery password",
+		 line_numbers[ password_index ] );
+	}
+	else if( info_handle->abort == 0 )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "No matching %s found in %d lines\n",
+		 ( is_recovery_password == 0 ) ? "password" : "recovery password",
+		 line_number );
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close passwords file.",
+		 function );
+
+		file_stream = NULL;
+
+		goto on_error;
+	}
+	memory_set(
+	 strings_data,
+	 0,
+	 sizeof( uint8_t ) * INFO_HANDLE_PASSWORDS_BATCH_SIZE * INFO_HANDLE_MAXIMUM_PASSWORD_SIZE );
+
+	memory_free(
+	 strings_data );
+
+	return( result );
+
+on_error:
+	if( file_stream != NULL )
+	{
+		file_stream_close(
+		 file_stream );
+	}
+	if( strings_data != NULL )
+	{
+		memory_set(
+		 strings_data,
+		 0,
+		 sizeof( uint8_t ) * INFO_HANDLE_PASSWORDS_BATCH_SIZE * INFO_HANDLE_MAXIMUM_PASSWORD_SIZE );
+
+		memory_free(
+		 strings_data );
+	}
+	return( -1 );
+}
+
+/* Calculates the digests of the volume data
+ * The volume data is read in order into a number of buffers, while the digests
+ * of the buffers that were read before are calculated by the hash handle threads
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_calculate_digests(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer        = NULL;
+	uint8_t *buffers_data  = NULL;
+	static char *function  = "info_handle_calculate_digests";
+	size64_t volume_size   = 0;
+	size_t read_size       = 0;
+	ssize_t read_count     = 0;
+	uint64_t buffer_number = 0;
+	off64_t volume_offset  = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid info handle - missing digest types.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_volume_get_size(
+	     info_handle->input_volume,
+	     &volume_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve size from input volume.",
+		 function );
+
+		return( -1 );
+	}
+	buffers_data = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * INFO_HANDLE_DIGEST_NUMBER_OF_BUFFERS * INFO_HANDLE_DIGEST_BUFFER_SIZE );
+
+	if( buffers_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers data.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle_start(
+	     info_handle->hash_handle,
+	     INFO_HANDLE_DIGEST_NUMBER_OF_BUFFERS,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to start hash handle.",
+		 function );
+
+		memory_free(
+		 buffers_data );
+
+		return( -1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "Calculating digests of volume data.\n" );
+
+	while( (size64_t) volume_offset < volume_size )
+	{
+		if( info_handle->abort != 0 )
+		{
+			break;
+		}
+		/* A buffer can be reused after its digests have been calculated
+		 */
+		if( buffer_number >= INFO_HANDLE_DIGEST_NUMBER_OF_BUFFERS )
+		{
+			if( hash_handle_wait_for_buffers(
+			     info_handle->hash_handle,
+			     buffer_number - INFO_HANDLE_DIGEST_NUMBER_OF_BUFFERS + 1,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for buffers.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		buffer = &( buffers_data[ ( buffer_number % INFO_HANDLE_DIGEST_NUMBER_OF_BUFFERS ) * INFO_HANDLE_DIGEST_BUFFER_SIZE ] );
+
+		read_size = INFO_HANDLE_DIGEST_BUFFER_SIZE;
+
+		if( (size64_t) read_size > ( volume_size - volume_offset ) )
+		{
+			read_size = (size_t) ( volume_size - volume_offset );
+		}
+		read_count = libbde_volume_read_buffer_at_offset(
+		              info_handle->input_volume,
+		              buffer,
+		              read_size,
+		              volume_offset,
+		              error );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer at offset: %" PRIi64 " from input volume.",
+			 function,
+			 volume_offset );
+
+			goto on_error;
+		}
+		if( hash_handle_append_buffer(
+		     info_handle->hash_handle,
+		     volume_offset,
+		     buffer,
+		     read_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append buffer at offset: %" PRIi64 " to hash handle.",
+			 function,
+			 volume_offset );
+
+			goto on_error;
+		}
+		volume_offset += read_size;
+
+		buffer_number++;
+	}
+	if( info_handle->abort != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+		 "%s: digest calculation aborted.",
+		 function );
+
+		goto on_error;
+	}
+	if( hash_handle_finalize(
+	     info_handle->hash_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize hash handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 buffers_data );
+
+	buffers_data = NULL;
+
+	if( hash_handle_fprint(
+	     info_handle->hash_handle,
+	     info_handle->notify_stream,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_PRINT_FAILED,
+		 "%s: unable to print digest hashes.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+
+on_error:
+	/* The digest threads reference the buffers and need to be stopped
+	 * before the buffers can be freed
+	 */
+	hash_handle_signal_abort(
+	 info_handle->hash_handle,
+	 NULL );
+
+	hash_handle_stop(
+	 info_handle->hash_handle,
+	 NULL );
+
+	if( buffers_data != NULL )
+	{
+		memory_free(
+		 buffers_data );
+	}
+	return( -1 );
+}
+
 /* Prints the volume information to a stream
  * Returns 1 if successful or -1 on error
  */
@@ -29,6 +29,7 @@
 #include "bdetools_libbde.h"
 #include "bdetools_libbfio.h"
 #include "bdetools_libcerror.h"
+#include "hash_handle.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -50,6 +51,10 @@ struct info_handle
 	 */
 	libbde_volume_t *input_volume;
 
+	/* The hash handle, which calculates the digests of the volume data
+	 */
+	hash_handle_t *hash_handle;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -91,11 +96,26 @@ int info_handle_read_startup_key(
      const system_character_t *filename,
      libcerror_error_t **error );
 
+int info_handle_read_keyring(
+     info_handle_t *info_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
 int info_handle_set_volume_offset(
      info_handle_t *info_handle,
      const system_character_t *string,
      libcerror_error_t **error );
 
+int info_handle_set_number_of_threads(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int info_handle_set_digest_types(
+     info_handle_t *info_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
 int info_handle_open_input(
      info_handle_t *info_handle,
      const system_character_t *filename,
@@ -109,6 +129,16 @@ int info_handle_input_is_locked(
      info_handle_t *info_handle,
      libcerror_error_t **error );
 
+int info_handle_test_passwords_file(
+     info_handle_t *info_handle,
+     const system_character_t *filename,
+     uint8_t is_recovery_password,
+     libcerror_error_t **error );
+
+int info_handle_calculate_digests(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
 int info_handle_volume_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
@@ -806,6 +806,51 @@ int mount_handle_read_startup_key(
 	return( 1 );
 }
 
+/* Reads the keys from a keyring file
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_read_keyring(
+     mount_handle_t *mount_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_read_keyring";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbde_volume_read_keyring_wide(
+	     mount_handle->input_volume,
+	     filename,
+	     error ) != 1 )
+#else
+	if( libbde_volume_read_keyring(
+	     mount_handle->input_volume,
+	     filename,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read keyring.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Sets the volume offset
  * Returns 1 if successful or -1 on error
  */
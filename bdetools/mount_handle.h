@@ -91,6 +91,11 @@ int mount_handle_read_startup_key(
      const system_character_t *filename,
      libcerror_error_t **error );
 
+int mount_handle_read_keyring(
+     mount_handle_t *mount_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
 int mount_handle_set_volume_offset(
      mount_handle_t *mount_handle,
      const system_character_t *string,
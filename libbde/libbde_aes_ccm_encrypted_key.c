@@ -27,6 +27,7 @@
 
 #include "libbde_aes_ccm_encrypted_key.h"
 #include "libbde_definitions.h"
+#include "libbde_libcaes.h"
 #include "libbde_libcerror.h"
 #include "libbde_libcnotify.h"
 #include "libbde_libfdatetime.h"
@@ -386,3 +387,252 @@ on_error:
 	return( -1 );
 }
 
+/* Decrypts the volume master key from the AES-CCM encrypted key
+ * Returns 1 if successful, 0 if the key does not decrypt the volume master key or -1 on error
+ */
+int libbde_aes_ccm_encrypted_key_decrypt_volume_master_key(
+     libbde_aes_ccm_encrypted_key_t *aes_ccm_encrypted_key,
+     const uint8_t *key,
+     size_t key_size,
+     uint8_t *volume_master_key,
+     size_t volume_master_key_size,
+     libcerror_error_t **error )
+{
+	libcaes_context_t *aes_context = NULL;
+	uint8_t *unencrypted_data      = NULL;
+	static char *function          = "libbde_aes_ccm_encrypted_key_decrypt_volume_master_key";
+	size_t unencrypted_data_size   = 0;
+	uint32_t data_size             = 0;
+	uint32_t version               = 0;
+	int result                     = 0;
+
+	if( aes_ccm_encrypted_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid AES-CCM encrypted key.",
+		 function );
+
+		return( -1 );
+	}
+	if( aes_ccm_encrypted_key->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid AES-CCM encrypted key - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( aes_ccm_encrypted_key->data_size < 28 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid AES-CCM encrypted key - data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_size != 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_master_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume master key.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_master_key_size < 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid volume master key value too small.",
+		 function );
+
+		return( -1 );
+	}
+	unencrypted_data_size = aes_ccm_encrypted_key->data_size;
+
+	unencrypted_data = (uint8_t *) memory_allocate(
+	                                unencrypted_data_size );
+
+	if( unencrypted_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create unencrypted data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     unencrypted_data,
+	     0,
+	     unencrypted_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear unencrypted data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcaes_context_initialize(
+	     &aes_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable initialize AES context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcaes_context_set_key(
+	     aes_context,
+	     LIBCAES_CRYPT_MODE_ENCRYPT,
+	     key,
+	     256,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set encryption key in AES context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcaes_crypt_ccm(
+	     aes_context,
+	     LIBCAES_CRYPT_MODE_DECRYPT,
+	     aes_ccm_encrypted_key->nonce,
+	     12,
+	     aes_ccm_encrypted_key->data,
+	     aes_ccm_encrypted_key->data_size,
+	     unencrypted_data,
+	     unencrypted_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_ENCRYPT_FAILED,
+		 "%s: unable to decrypt data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcaes_context_free(
+	     &aes_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable free context.",
+		 function );
+
+		goto on_error;
+	}
+	/* A key that does not match results in data that does not contain
+	 * a version 1 volume master key of 0x2c bytes
+	 */
+	byte_stream_copy_to_uint16_little_endian(
+	 &( unencrypted_data[ 16 ] ),
+	 data_size );
+
+	byte_stream_copy_to_uint16_little_endian(
+	 &( unencrypted_data[ 20 ] ),
+	 version );
+
+	if( ( version == 1 )
+	 && ( data_size == 0x2c )
+	 && ( unencrypted_data_size >= 60 ) )
+	{
+		if( memory_copy(
+		     volume_master_key,
+		     &( unencrypted_data[ 28 ] ),
+		     32 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy unencrypted volume master key.",
+			 function );
+
+			goto on_error;
+		}
+		result = 1;
+	}
+	memory_set(
+	 unencrypted_data,
+	 0,
+	 unencrypted_data_size );
+
+	memory_free(
+	 unencrypted_data );
+
+	return( result );
+
+on_error:
+	if( aes_context != NULL )
+	{
+		libcaes_context_free(
+		 &aes_context,
+		 NULL );
+	}
+	if( unencrypted_data != NULL )
+	{
+		memory_set(
+		 unencrypted_data,
+		 0,
+		 unencrypted_data_size );
+
+		memory_free(
+		 unencrypted_data );
+	}
+	return( -1 );
+}
+
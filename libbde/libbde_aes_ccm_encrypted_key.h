@@ -62,6 +62,14 @@ int libbde_aes_ccm_encrypted_key_read(
      libbde_metadata_entry_t *metadata_entry,
      libcerror_error_t **error );
 
+int libbde_aes_ccm_encrypted_key_decrypt_volume_master_key(
+     libbde_aes_ccm_encrypted_key_t *aes_ccm_encrypted_key,
+     const uint8_t *key,
+     size_t key_size,
+     uint8_t *volume_master_key,
+     size_t volume_master_key_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
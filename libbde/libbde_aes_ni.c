@@ -0,0 +1,1499 @@
+/*
+ * AES-NI functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_aes_ni.h"
+#include "libbde_definitions.h"
+#include "libbde_libcerror.h"
+
+#if defined( HAVE_LIBBDE_AES_NI )
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+/* The functions that use the AES-NI intrinsics are compiled for the AES-NI
+ * instruction set, they are only called after libbde_aes_ni_is_supported
+ */
+#if defined( __GNUC__ )
+#define LIBBDE_AES_NI_TARGET \
+	__attribute__((target("aes,sse2")))
+#else
+#define LIBBDE_AES_NI_TARGET
+#endif
+
+/* The number of blocks that are de- or encrypted in parallel
+ */
+#define LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS	8
+
+#define libbde_aes_ni_expand_128bit_key( round_keys, round_key_index, round_constant ) \
+	round_keys[ round_key_index ] = libbde_aes_ni_expand_key( \
+	 round_keys[ round_key_index - 1 ], \
+	 _mm_shuffle_epi32( \
+	  _mm_aeskeygenassist_si128( \
+	   round_keys[ round_key_index - 1 ], \
+	   round_constant ), \
+	  0xff ) )
+
+#define libbde_aes_ni_expand_256bit_key( round_keys, round_key_index, round_constant ) \
+	round_keys[ round_key_index ] = libbde_aes_ni_expand_key( \
+	 round_keys[ round_key_index - 2 ], \
+	 _mm_shuffle_epi32( \
+	  _mm_aeskeygenassist_si128( \
+	   round_keys[ round_key_index - 1 ], \
+	   round_constant ), \
+	  0xff ) ); \
+	if( round_key_index < 14 ) \
+	{ \
+		round_keys[ round_key_index + 1 ] = libbde_aes_ni_expand_key( \
+		 round_keys[ round_key_index - 1 ], \
+		 _mm_shuffle_epi32( \
+		  _mm_aeskeygenassist_si128( \
+		   round_keys[ round_key_index ], \
+		   0x00 ), \
+		  0xaa ) ); \
+	}
+
+/* Determines if the CPU supports the AES-NI instructions
+ * Returns 1 if supported or 0 if not
+ */
+int libbde_aes_ni_is_supported(
+     void )
+{
+#if defined( _MSC_VER )
+	int cpu_info[ 4 ];
+
+	__cpuid(
+	 cpu_info,
+	 1 );
+
+	if( ( ( cpu_info[ 2 ] & 0x02000000UL ) != 0 )
+	 && ( ( cpu_info[ 3 ] & 0x04000000UL ) != 0 ) )
+	{
+		return( 1 );
+	}
+#else
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+
+	if( __get_cpuid(
+	     1,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		return( 0 );
+	}
+	/* ECX bit 25 indicates AES-NI and EDX bit 26 indicates SSE2
+	 */
+	if( ( ( ecx & 0x02000000UL ) != 0 )
+	 && ( ( edx & 0x04000000UL ) != 0 ) )
+	{
+		return( 1 );
+	}
+#endif
+	return( 0 );
+}
+
+/* Expands the previous round key
+ */
+LIBBDE_AES_NI_TARGET
+static __m128i libbde_aes_ni_expand_key(
+                __m128i round_key,
+                __m128i key_generation_value )
+{
+	round_key = _mm_xor_si128(
+	             round_key,
+	             _mm_slli_si128(
+	              round_key,
+	              4 ) );
+	round_key = _mm_xor_si128(
+	             round_key,
+	             _mm_slli_si128(
+	              round_key,
+	              4 ) );
+	round_key = _mm_xor_si128(
+	             round_key,
+	             _mm_slli_si128(
+	              round_key,
+	              4 ) );
+
+	return( _mm_xor_si128(
+	         round_key,
+	         key_generation_value ) );
+}
+
+/* Encrypts a number of blocks
+ */
+LIBBDE_AES_NI_TARGET
+static void libbde_aes_ni_encrypt_blocks(
+             const uint8_t *round_keys,
+             int number_of_rounds,
+             __m128i *blocks,
+             int number_of_blocks )
+{
+	__m128i round_key = _mm_loadu_si128(
+	                     (const __m128i *) round_keys );
+	int block_index   = 0;
+	int round_index   = 0;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		blocks[ block_index ] = _mm_xor_si128(
+		                         blocks[ block_index ],
+		                         round_key );
+	}
+	for( round_index = 1;
+	     round_index < number_of_rounds;
+	     round_index++ )
+	{
+		round_key = _mm_loadu_si128(
+		             (const __m128i *) &( round_keys[ round_index * 16 ] ) );
+
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			blocks[ block_index ] = _mm_aesenc_si128(
+			                         blocks[ block_index ],
+			                         round_key );
+		}
+	}
+	round_key = _mm_loadu_si128(
+	             (const __m128i *) &( round_keys[ number_of_rounds * 16 ] ) );
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		blocks[ block_index ] = _mm_aesenclast_si128(
+		                         blocks[ block_index ],
+		                         round_key );
+	}
+}
+
+/* Decrypts a number of blocks
+ */
+LIBBDE_AES_NI_TARGET
+static void libbde_aes_ni_decrypt_blocks(
+             const uint8_t *round_keys,
+             int number_of_rounds,
+             __m128i *blocks,
+             int number_of_blocks )
+{
+	__m128i round_key = _mm_loadu_si128(
+	                     (const __m128i *) round_keys );
+	int block_index   = 0;
+	int round_index   = 0;
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		blocks[ block_index ] = _mm_xor_si128(
+		                         blocks[ block_index ],
+		                         round_key );
+	}
+	for( round_index = 1;
+	     round_index < number_of_rounds;
+	     round_index++ )
+	{
+		round_key = _mm_loadu_si128(
+		             (const __m128i *) &( round_keys[ round_index * 16 ] ) );
+
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			blocks[ block_index ] = _mm_aesdec_si128(
+			                         blocks[ block_index ],
+			                         round_key );
+		}
+	}
+	round_key = _mm_loadu_si128(
+	             (const __m128i *) &( round_keys[ number_of_rounds * 16 ] ) );
+
+	for( block_index = 0;
+	     block_index < number_of_blocks;
+	     block_index++ )
+	{
+		blocks[ block_index ] = _mm_aesdeclast_si128(
+		                         blocks[ block_index ],
+		                         round_key );
+	}
+}
+
+/* Multiplies a XTS tweak value by the primitive element (x) of GF(2^128)
+ */
+LIBBDE_AES_NI_TARGET
+static __m128i libbde_aes_ni_multiply_tweak(
+                __m128i tweak )
+{
+	/* Determine the carry of bits 63 and 127, where the carry of bit 127
+	 * wraps around as the reduction polynomial x^7 + x^2 + x + 1 (0x87)
+	 */
+	__m128i carry = _mm_srai_epi32(
+	                 _mm_shuffle_epi32(
+	                  tweak,
+	                  0x13 ),
+	                 31 );
+
+	carry = _mm_and_si128(
+	         carry,
+	         _mm_set_epi32(
+	          0,
+	          1,
+	          0,
+	          0x87 ) );
+
+	return( _mm_xor_si128(
+	         _mm_add_epi64(
+	          tweak,
+	          tweak ),
+	         carry ) );
+}
+
+/* De- or encrypts a data unit using AES-XTS with an encrypted tweak value
+ * The size must be a multitude of the AES block size (16 byte)
+ */
+LIBBDE_AES_NI_TARGET
+static void libbde_aes_ni_crypt_xts_data_unit(
+             libbde_aes_ni_context_t *context,
+             int mode,
+             __m128i tweak,
+             const uint8_t *input_data,
+             size_t input_data_size,
+             uint8_t *output_data )
+{
+	__m128i blocks[ LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS ];
+	__m128i tweaks[ LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS ];
+
+	size_t data_offset   = 0;
+	int block_index      = 0;
+	int number_of_blocks = 0;
+
+	while( data_offset < input_data_size )
+	{
+		number_of_blocks = (int) ( ( input_data_size - data_offset ) / 16 );
+
+		if( number_of_blocks > LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS )
+		{
+			number_of_blocks = LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+		}
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			tweaks[ block_index ] = tweak;
+
+			blocks[ block_index ] = _mm_xor_si128(
+			                         _mm_loadu_si128(
+			                          (const __m128i *) &( input_data[ data_offset + ( block_index * 16 ) ] ) ),
+			                         tweak );
+
+			tweak = libbde_aes_ni_multiply_tweak(
+			         tweak );
+		}
+		if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+		{
+			libbde_aes_ni_encrypt_blocks(
+			 context->encryption_round_keys,
+			 context->number_of_rounds,
+			 blocks,
+			 number_of_blocks );
+		}
+		else
+		{
+			libbde_aes_ni_decrypt_blocks(
+			 context->decryption_round_keys,
+			 context->number_of_rounds,
+			 blocks,
+			 number_of_blocks );
+		}
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			_mm_storeu_si128(
+			 (__m128i *) &( output_data[ data_offset + ( block_index * 16 ) ] ),
+			 _mm_xor_si128(
+			  blocks[ block_index ],
+			  tweaks[ block_index ] ) );
+		}
+		data_offset += number_of_blocks * 16;
+	}
+}
+
+/* Sets the key
+ * Returns 1 if successful or -1 on error
+ */
+LIBBDE_AES_NI_TARGET
+int libbde_aes_ni_context_set_key(
+     libbde_aes_ni_context_t *context,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error )
+{
+	__m128i round_keys[ 15 ];
+
+	static char *function = "libbde_aes_ni_context_set_key";
+	int number_of_rounds  = 0;
+	int round_index       = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_bit_size == 128 )
+	{
+		number_of_rounds = 10;
+
+		round_keys[ 0 ] = _mm_loadu_si128(
+		                   (const __m128i *) key );
+
+		libbde_aes_ni_expand_128bit_key( round_keys, 1, 0x01 );
+		libbde_aes_ni_expand_128bit_key( round_keys, 2, 0x02 );
+		libbde_aes_ni_expand_128bit_key( round_keys, 3, 0x04 );
+		libbde_aes_ni_expand_128bit_key( round_keys, 4, 0x08 );
+		libbde_aes_ni_expand_128bit_key( round_keys, 5, 0x10 );
+		libbde_aes_ni_expand_128bit_key( round_keys, 6, 0x20 );
+		libbde_aes_ni_expand_128bit_key( round_keys, 7, 0x40 );
+		libbde_aes_ni_expand_128bit_key( round_keys, 8, 0x80 );
+		libbde_aes_ni_expand_128bit_key( round_keys, 9, 0x1b );
+		libbde_aes_ni_expand_128bit_key( round_keys, 10, 0x36 );
+	}
+	else if( key_bit_size == 256 )
+	{
+		number_of_rounds = 14;
+
+		round_keys[ 0 ] = _mm_loadu_si128(
+		                   (const __m128i *) key );
+		round_keys[ 1 ] = _mm_loadu_si128(
+		                   (const __m128i *) &( key[ 16 ] ) );
+
+		libbde_aes_ni_expand_256bit_key( round_keys, 2, 0x01 );
+		libbde_aes_ni_expand_256bit_key( round_keys, 4, 0x02 );
+		libbde_aes_ni_expand_256bit_key( round_keys, 6, 0x04 );
+		libbde_aes_ni_expand_256bit_key( round_keys, 8, 0x08 );
+		libbde_aes_ni_expand_256bit_key( round_keys, 10, 0x10 );
+		libbde_aes_ni_expand_256bit_key( round_keys, 12, 0x20 );
+		libbde_aes_ni_expand_256bit_key( round_keys, 14, 0x40 );
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported key bit size.",
+		 function );
+
+		return( -1 );
+	}
+	context->number_of_rounds = number_of_rounds;
+
+	for( round_index = 0;
+	     round_index <= number_of_rounds;
+	     round_index++ )
+	{
+		_mm_storeu_si128(
+		 (__m128i *) &( context->encryption_round_keys[ round_index * 16 ] ),
+		 round_keys[ round_index ] );
+	}
+	/* The decryption round keys are the encryption round keys in reverse order
+	 * with the inverse mix columns transformation applied to the inner round keys
+	 */
+	_mm_storeu_si128(
+	 (__m128i *) context->decryption_round_keys,
+	 round_keys[ number_of_rounds ] );
+
+	for( round_index = 1;
+	     round_index < number_of_rounds;
+	     round_index++ )
+	{
+		_mm_storeu_si128(
+		 (__m128i *) &( context->decryption_round_keys[ round_index * 16 ] ),
+		 _mm_aesimc_si128(
+		  round_keys[ number_of_rounds - round_index ] ) );
+	}
+	_mm_storeu_si128(
+	 (__m128i *) &( context->decryption_round_keys[ number_of_rounds * 16 ] ),
+	 round_keys[ 0 ] );
+
+	if( memory_set(
+	     round_keys,
+	     0,
+	     sizeof( __m128i ) * 15 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear round keys.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Clears the key
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_aes_ni_context_clear(
+     libbde_aes_ni_context_t *context,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_aes_ni_context_clear";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     context,
+	     0,
+	     sizeof( libbde_aes_ni_context_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* De- or encrypts a block of data using AES-ECB (Electronic CodeBook)
+ * The size must be a multitude of the AES block size (16 byte)
+ * Returns 1 if successful or -1 on error
+ */
+LIBBDE_AES_NI_TARGET
+int libbde_aes_ni_crypt_ecb(
+     libbde_aes_ni_context_t *context,
+     int mode,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	__m128i blocks[ LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS ];
+
+	static char *function = "libbde_aes_ni_crypt_ecb";
+	size_t data_offset    = 0;
+	int block_index       = 0;
+	int number_of_blocks  = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < input_data_size )
+	{
+		number_of_blocks = (int) ( ( input_data_size - data_offset ) / 16 );
+
+		if( number_of_blocks > LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS )
+		{
+			number_of_blocks = LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+		}
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			blocks[ block_index ] = _mm_loadu_si128(
+			                         (const __m128i *) &( input_data[ data_offset + ( block_index * 16 ) ] ) );
+		}
+		if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+		{
+			libbde_aes_ni_encrypt_blocks(
+			 context->encryption_round_keys,
+			 context->number_of_rounds,
+			 blocks,
+			 number_of_blocks );
+		}
+		else
+		{
+			libbde_aes_ni_decrypt_blocks(
+			 context->decryption_round_keys,
+			 context->number_of_rounds,
+			 blocks,
+			 number_of_blocks );
+		}
+		for( block_index = 0;
+		     block_index < number_of_blocks;
+		     block_index++ )
+		{
+			_mm_storeu_si128(
+			 (__m128i *) &( output_data[ data_offset + ( block_index * 16 ) ] ),
+			 blocks[ block_index ] );
+		}
+		data_offset += number_of_blocks * 16;
+	}
+	return( 1 );
+}
+
+/* De- or encrypts a block of data using AES-CBC (Cipher Block Chaining)
+ * The size must be a multitude of the AES block size (16 byte)
+ * The input and output data can overlap if they start at the same offset
+ * Returns 1 if successful or -1 on error
+ */
+LIBBDE_AES_NI_TARGET
+int libbde_aes_ni_crypt_cbc(
+     libbde_aes_ni_context_t *context,
+     int mode,
+     const uint8_t *initialization_vector,
+     size_t initialization_vector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	__m128i blocks[ LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS ];
+	__m128i encrypted_blocks[ LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS ];
+
+	static char *function         = "libbde_aes_ni_crypt_cbc";
+	__m128i previous_block        = _mm_setzero_si128();
+	size_t data_offset            = 0;
+	int block_index               = 0;
+	int number_of_blocks          = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vector_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid initialization vector size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	previous_block = _mm_loadu_si128(
+	                  (const __m128i *) initialization_vector );
+
+	if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		/* CBC encryption is sequential by definition
+		 */
+		while( data_offset < input_data_size )
+		{
+			blocks[ 0 ] = _mm_xor_si128(
+			               _mm_loadu_si128(
+			                (const __m128i *) &( input_data[ data_offset ] ) ),
+			               previous_block );
+
+			libbde_aes_ni_encrypt_blocks(
+			 context->encryption_round_keys,
+			 context->number_of_rounds,
+			 blocks,
+			 1 );
+
+			_mm_storeu_si128(
+			 (__m128i *) &( output_data[ data_offset ] ),
+			 blocks[ 0 ] );
+
+			previous_block = blocks[ 0 ];
+			data_offset   += 16;
+		}
+	}
+	else
+	{
+		/* CBC decryption of a block only depends on the preceding encrypted block
+		 * hence multiple blocks are decrypted in parallel
+		 */
+		while( data_offset < input_data_size )
+		{
+			number_of_blocks = (int) ( ( input_data_size - data_offset ) / 16 );
+
+			if( number_of_blocks > LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS )
+			{
+				number_of_blocks = LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+			}
+			for( block_index = 0;
+			     block_index < number_of_blocks;
+			     block_index++ )
+			{
+				encrypted_blocks[ block_index ] = _mm_loadu_si128(
+				                                   (const __m128i *) &( input_data[ data_offset + ( block_index * 16 ) ] ) );
+
+				blocks[ block_index ] = encrypted_blocks[ block_index ];
+			}
+			libbde_aes_ni_decrypt_blocks(
+			 context->decryption_round_keys,
+			 context->number_of_rounds,
+			 blocks,
+			 number_of_blocks );
+
+			for( block_index = 0;
+			     block_index < number_of_blocks;
+			     block_index++ )
+			{
+				_mm_storeu_si128(
+				 (__m128i *) &( output_data[ data_offset + ( block_index * 16 ) ] ),
+				 _mm_xor_si128(
+				  blocks[ block_index ],
+				  previous_block ) );
+
+				previous_block = encrypted_blocks[ block_index ];
+			}
+			data_offset += number_of_blocks * 16;
+		}
+	}
+	return( 1 );
+}
+
+/* De- or encrypts a block of data using AES-XTS (XEX-based tweaked-codebook mode with ciphertext stealing)
+ * The size must be a multitude of the AES block size (16 byte), ciphertext stealing is not supported
+ * The input and output data can overlap if they start at the same offset
+ * Returns 1 if successful or -1 on error
+ */
+LIBBDE_AES_NI_TARGET
+int libbde_aes_ni_crypt_xts(
+     libbde_aes_ni_context_t *context,
+     libbde_aes_ni_context_t *tweak_context,
+     int mode,
+     const uint8_t *tweak_value,
+     size_t tweak_value_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	__m128i tweaks[ 1 ];
+
+	static char *function = "libbde_aes_ni_crypt_xts";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak value.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_value_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid tweak value size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The tweak value is always encrypted with the tweak key
+	 */
+	tweaks[ 0 ] = _mm_loadu_si128(
+	               (const __m128i *) tweak_value );
+
+	libbde_aes_ni_encrypt_blocks(
+	 tweak_context->encryption_round_keys,
+	 tweak_context->number_of_rounds,
+	 tweaks,
+	 1 );
+
+	libbde_aes_ni_crypt_xts_data_unit(
+	 context,
+	 mode,
+	 tweaks[ 0 ],
+	 input_data,
+	 input_data_size,
+	 output_data );
+
+	return( 1 );
+}
+
+/* De- or encrypts consecutive sectors using AES-XTS, where every sector is a data unit
+ * The tweak value of a sector is its sector number stored as a 64-bit little-endian value,
+ * the tweak values of up to 8 sectors are encrypted at once
+ * The sector size must be a multitude of the AES block size (16 byte)
+ * The input and output data can overlap if they start at the same offset
+ * Returns 1 if successful or -1 on error
+ */
+LIBBDE_AES_NI_TARGET
+int libbde_aes_ni_crypt_xts_sectors(
+     libbde_aes_ni_context_t *context,
+     libbde_aes_ni_context_t *tweak_context,
+     int mode,
+     uint64_t sector_number,
+     size_t sector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	__m128i tweaks[ LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS ];
+
+	static char *function = "libbde_aes_ni_crypt_xts_sectors";
+	size_t data_offset    = 0;
+	int number_of_sectors = 0;
+	int sector_index      = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( tweak_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid tweak context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	 && ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sector_size == 0 )
+	 || ( ( sector_size % 16 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported sector size.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % sector_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	while( data_offset < input_data_size )
+	{
+		number_of_sectors = (int) ( ( input_data_size - data_offset ) / sector_size );
+
+		if( number_of_sectors > LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS )
+		{
+			number_of_sectors = LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS;
+		}
+		for( sector_index = 0;
+		     sector_index < number_of_sectors;
+		     sector_index++ )
+		{
+			tweaks[ sector_index ] = _mm_set_epi64x(
+			                          0,
+			                          (long long) sector_number );
+
+			sector_number++;
+		}
+		libbde_aes_ni_encrypt_blocks(
+		 tweak_context->encryption_round_keys,
+		 tweak_context->number_of_rounds,
+		 tweaks,
+		 number_of_sectors );
+
+		for( sector_index = 0;
+		     sector_index < number_of_sectors;
+		     sector_index++ )
+		{
+			libbde_aes_ni_crypt_xts_data_unit(
+			 context,
+			 mode,
+			 tweaks[ sector_index ],
+			 &( input_data[ data_offset ] ),
+			 sector_size,
+			 &( output_data[ data_offset ] ) );
+
+			data_offset += sector_size;
+		}
+	}
+	memory_set(
+	 tweaks,
+	 0,
+	 sizeof( __m128i ) * LIBBDE_AES_NI_NUMBER_OF_PARALLEL_BLOCKS );
+
+	return( 1 );
+}
+
+/* Runs the known-answer tests of the AES-NI kernels
+ * Returns 1 if the results match or 0 if not
+ */
+int libbde_aes_ni_self_test(
+     void )
+{
+	/* FIPS-197 appendix C.1 and C.3
+	 */
+	static const uint8_t ecb_key[ 32 ] = {
+		0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+		0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f };
+
+	static const uint8_t ecb_plaintext[ 16 ] = {
+		0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+
+	static const uint8_t ecb_128bit_ciphertext[ 16 ] = {
+		0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a };
+
+	static const uint8_t ecb_256bit_ciphertext[ 16 ] = {
+		0x8e, 0xa2, 0xb7, 0xca, 0x51, 0x67, 0x45, 0xbf, 0xea, 0xfc, 0x49, 0x90, 0x4b, 0x49, 0x60, 0x89 };
+
+	/* NIST SP 800-38A F.2.1
+	 */
+	static const uint8_t cbc_key[ 16 ] = {
+		0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c };
+
+	static const uint8_t cbc_initialization_vector[ 16 ] = {
+		0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+
+	static const uint8_t cbc_plaintext[ 64 ] = {
+		0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a,
+		0xae, 0x2d, 0x8a, 0x57, 0x1e, 0x03, 0xac, 0x9c, 0x9e, 0xb7, 0x6f, 0xac, 0x45, 0xaf, 0x8e, 0x51,
+		0x30, 0xc8, 0x1c, 0x46, 0xa3, 0x5c, 0xe4, 0x11, 0xe5, 0xfb, 0xc1, 0x19, 0x1a, 0x0a, 0x52, 0xef,
+		0xf6, 0x9f, 0x24, 0x45, 0xdf, 0x4f, 0x9b, 0x17, 0xad, 0x2b, 0x41, 0x7b, 0xe6, 0x6c, 0x37, 0x10 };
+
+	static const uint8_t cbc_ciphertext[ 64 ] = {
+		0x76, 0x49, 0xab, 0xac, 0x81, 0x19, 0xb2, 0x46, 0xce, 0xe9, 0x8e, 0x9b, 0x12, 0xe9, 0x19, 0x7d,
+		0x50, 0x86, 0xcb, 0x9b, 0x50, 0x72, 0x19, 0xee, 0x95, 0xdb, 0x11, 0x3a, 0x91, 0x76, 0x78, 0xb2,
+		0x73, 0xbe, 0xd6, 0xb8, 0xe3, 0xc1, 0x74, 0x3b, 0x71, 0x16, 0xe6, 0x9e, 0x22, 0x22, 0x95, 0x16,
+		0x3f, 0xf1, 0xca, 0xa1, 0x68, 0x1f, 0xac, 0x09, 0x12, 0x0e, 0xca, 0x30, 0x75, 0x86, 0xe1, 0xa7 };
+
+	/* IEEE 1619-2007 XTS-AES-128 vector 2
+	 */
+	static const uint8_t xts_key[ 16 ] = {
+		0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11 };
+
+	static const uint8_t xts_tweak_key[ 16 ] = {
+		0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22, 0x22 };
+
+	static const uint8_t xts_tweak_value[ 16 ] = {
+		0x33, 0x33, 0x33, 0x33, 0x33, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+	static const uint8_t xts_ciphertext[ 32 ] = {
+		0xc4, 0x54, 0x18, 0x5e, 0x6a, 0x16, 0x93, 0x6e, 0x39, 0x33, 0x40, 0x38, 0xac, 0xef, 0x83, 0x8b,
+		0xfb, 0x18, 0x6f, 0xff, 0x74, 0x80, 0xad, 0xc4, 0x28, 0x93, 0x82, 0xec, 0xd6, 0xd3, 0x94, 0xf0 };
+
+	uint8_t data[ 256 ];
+	uint8_t test_data[ 256 ];
+
+	libbde_aes_ni_context_t context;
+	libbde_aes_ni_context_t tweak_context;
+
+	size_t data_index = 0;
+	int result        = 0;
+
+	if( libbde_aes_ni_context_set_key(
+	     &context,
+	     ecb_key,
+	     128,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbde_aes_ni_crypt_ecb(
+	     &context,
+	     LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	     ecb_plaintext,
+	     16,
+	     data,
+	     16,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( memory_compare(
+	     data,
+	     ecb_128bit_ciphertext,
+	     16 ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libbde_aes_ni_crypt_ecb(
+	     &context,
+	     LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	     data,
+	     16,
+	     data,
+	     16,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( memory_compare(
+	     data,
+	     ecb_plaintext,
+	     16 ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libbde_aes_ni_context_set_key(
+	     &context,
+	     ecb_key,
+	     256,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbde_aes_ni_crypt_ecb(
+	     &context,
+	     LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	     ecb_plaintext,
+	     16,
+	     data,
+	     16,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( memory_compare(
+	     data,
+	     ecb_256bit_ciphertext,
+	     16 ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libbde_aes_ni_crypt_ecb(
+	     &context,
+	     LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	     data,
+	     16,
+	     data,
+	     16,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( memory_compare(
+	     data,
+	     ecb_plaintext,
+	     16 ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libbde_aes_ni_context_set_key(
+	     &context,
+	     cbc_key,
+	     128,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbde_aes_ni_crypt_cbc(
+	     &context,
+	     LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	     cbc_initialization_vector,
+	     16,
+	     cbc_plaintext,
+	     64,
+	     data,
+	     64,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( memory_compare(
+	     data,
+	     cbc_ciphertext,
+	     64 ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libbde_aes_ni_crypt_cbc(
+	     &context,
+	     LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	     cbc_initialization_vector,
+	     16,
+	     data,
+	     64,
+	     data,
+	     64,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( memory_compare(
+	     data,
+	     cbc_plaintext,
+	     64 ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libbde_aes_ni_context_set_key(
+	     &context,
+	     xts_key,
+	     128,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbde_aes_ni_context_set_key(
+	     &tweak_context,
+	     xts_tweak_key,
+	     128,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( memory_set(
+	     data,
+	     0x44,
+	     32 ) == NULL )
+	{
+		goto on_error;
+	}
+	if( libbde_aes_ni_crypt_xts(
+	     &context,
+	     &tweak_context,
+	     LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	     xts_tweak_value,
+	     16,
+	     data,
+	     32,
+	     data,
+	     32,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( memory_compare(
+	     data,
+	     xts_ciphertext,
+	     32 ) != 0 )
+	{
+		goto on_error;
+	}
+	/* Test the parallel code paths with a size that is not a multitude
+	 * of the number of parallel blocks
+	 */
+	for( data_index = 0;
+	     data_index < 256;
+	     data_index++ )
+	{
+		test_data[ data_index ] = (uint8_t) data_index;
+	}
+	if( libbde_aes_ni_crypt_cbc(
+	     &context,
+	     LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	     cbc_initialization_vector,
+	     16,
+	     test_data,
+	     240,
+	     data,
+	     240,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbde_aes_ni_crypt_cbc(
+	     &context,
+	     LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	     cbc_initialization_vector,
+	     16,
+	     data,
+	     240,
+	     data,
+	     240,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( memory_compare(
+	     data,
+	     test_data,
+	     240 ) != 0 )
+	{
+		goto on_error;
+	}
+	if( libbde_aes_ni_crypt_xts(
+	     &context,
+	     &tweak_context,
+	     LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	     xts_tweak_value,
+	     16,
+	     test_data,
+	     240,
+	     data,
+	     240,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbde_aes_ni_crypt_xts(
+	     &context,
+	     &tweak_context,
+	     LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	     xts_tweak_value,
+	     16,
+	     data,
+	     240,
+	     data,
+	     240,
+	     NULL ) != 1 )
+	{
+		goto on_error;
+	}
+	if( memory_compare(
+	     data,
+	     test_data,
+	     240 ) != 0 )
+	{
+		goto on_error;
+	}
+	result = 1;
+
+on_error:
+	libbde_aes_ni_context_clear(
+	 &context,
+	 NULL );
+	libbde_aes_ni_context_clear(
+	 &tweak_context,
+	 NULL );
+
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBBDE_AES_NI ) */
+
@@ -0,0 +1,127 @@
+/*
+ * AES-NI functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_AES_NI_H )
+#define _LIBBDE_AES_NI_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The AES-NI kernels are only available on x86 and x86-64
+ */
+#if ( defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) ) \
+ || ( defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) ) )
+#define HAVE_LIBBDE_AES_NI	1
+#endif
+
+#if defined( HAVE_LIBBDE_AES_NI )
+
+typedef struct libbde_aes_ni_context libbde_aes_ni_context_t;
+
+struct libbde_aes_ni_context
+{
+	/* The number of rounds
+	 */
+	int number_of_rounds;
+
+	/* The encryption round keys
+	 */
+	uint8_t encryption_round_keys[ 15 * 16 ];
+
+	/* The decryption round keys
+	 */
+	uint8_t decryption_round_keys[ 15 * 16 ];
+};
+
+int libbde_aes_ni_is_supported(
+     void );
+
+int libbde_aes_ni_self_test(
+     void );
+
+int libbde_aes_ni_context_set_key(
+     libbde_aes_ni_context_t *context,
+     const uint8_t *key,
+     size_t key_bit_size,
+     libcerror_error_t **error );
+
+int libbde_aes_ni_context_clear(
+     libbde_aes_ni_context_t *context,
+     libcerror_error_t **error );
+
+int libbde_aes_ni_crypt_ecb(
+     libbde_aes_ni_context_t *context,
+     int mode,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_aes_ni_crypt_cbc(
+     libbde_aes_ni_context_t *context,
+     int mode,
+     const uint8_t *initialization_vector,
+     size_t initialization_vector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_aes_ni_crypt_xts(
+     libbde_aes_ni_context_t *context,
+     libbde_aes_ni_context_t *tweak_context,
+     int mode,
+     const uint8_t *tweak_value,
+     size_t tweak_value_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_aes_ni_crypt_xts_sectors(
+     libbde_aes_ni_context_t *context,
+     libbde_aes_ni_context_t *tweak_context,
+     int mode,
+     uint64_t sector_number,
+     size_t sector_size,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBBDE_AES_NI ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_AES_NI_H ) */
+
@@ -24,22 +24,33 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libbde_definitions.h"
 #include "libbde_diffuser.h"
 #include "libbde_libcerror.h"
 
 /* Decrypts the data using Diffuser-A and B
+ * On little-endian hosts 32-bit aligned data is decrypted in-place,
+ * otherwise the values are converted in a buffer on the stack if the data is
+ * small enough, such as a sector, and on the heap if not
+ * If sector key data is provided it is applied after the diffuser decryption
  * Returns 1 if successful or -1 on error
  */
 int libbde_diffuser_decrypt(
      uint8_t *data,
      size_t data_size,
+     const uint8_t *sector_key_data,
+     size_t sector_key_data_size,
      libcerror_error_t **error )
 {
+	uint32_t values_32bit_buffer[ LIBBDE_DIFFUSER_MAXIMUM_NUMBER_OF_BUFFERED_VALUES ];
+	uint32_t sector_key_32bit[ 8 ];
+
 	uint32_t *values_32bit   = NULL;
 	static char *function    = "libbde_diffuser_decrypt";
 	size_t data_index        = 0;
 	size_t number_of_values  = 0;
 	size_t value_32bit_index = 0;
+	uint8_t is_in_place      = 0;
 
 	if( data == NULL )
 	{
@@ -74,33 +85,76 @@ int libbde_diffuser_decrypt(
 
 		return( -1 );
 	}
-	number_of_values = data_size / 4;
-
-	values_32bit = (uint32_t *) memory_allocate(
-	                             data_size );
-
-	if( values_32bit == NULL )
+	if( ( sector_key_data != NULL )
+	 && ( sector_key_data_size != 32 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create values 32-bit.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported sector key data size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	data_index = 0;
-
 	for( value_32bit_index = 0;
-	     value_32bit_index < number_of_values;
+	     value_32bit_index < 8;
 	     value_32bit_index++ )
 	{
-		byte_stream_copy_to_uint32_little_endian(
-		 &( data[ data_index ] ),
-		 values_32bit[ value_32bit_index ] );
+		if( sector_key_data == NULL )
+		{
+			sector_key_32bit[ value_32bit_index ] = 0;
+		}
+		else
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( sector_key_data[ value_32bit_index * 4 ] ),
+			 sector_key_32bit[ value_32bit_index ] );
+		}
+	}
+	number_of_values = data_size / 4;
+
+	if( ( _BYTE_STREAM_HOST_IS_ENDIAN_LITTLE )
+	 && ( ( (intptr_t) data % sizeof( uint32_t ) ) == 0 ) )
+	{
+		values_32bit = (uint32_t *) data;
+		is_in_place  = 1;
+	}
+	else if( number_of_values <= LIBBDE_DIFFUSER_MAXIMUM_NUMBER_OF_BUFFERED_VALUES )
+	{
+		values_32bit = values_32bit_buffer;
+	}
+	else
+	{
+		values_32bit = (uint32_t *) memory_allocate(
+		                             data_size );
+
+		if( values_32bit == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create values 32-bit.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( is_in_place == 0 )
+	{
+		data_index = 0;
+
+		for( value_32bit_index = 0;
+		     value_32bit_index < number_of_values;
+		     value_32bit_index++ )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( data[ data_index ] ),
+			 values_32bit[ value_32bit_index ] );
 
-		data_index += sizeof( uint32_t );
+			data_index += sizeof( uint32_t );
+		}
 	}
 	if( libbde_diffuser_b_decrypt(
 	     values_32bit,
@@ -130,48 +184,70 @@ int libbde_diffuser_decrypt(
 
 		goto on_error;
 	}
-	data_index = 0;
-
-	for( value_32bit_index = 0;
-	     value_32bit_index < number_of_values;
-	     value_32bit_index++ )
+	/* The sector key is applied as 32-bit values, in a separate pass over
+	 * in-place data and while storing the values otherwise
+	 */
+	if( is_in_place != 0 )
 	{
-		byte_stream_copy_from_uint32_little_endian(
-		 &( data[ data_index ] ),
-		 values_32bit[ value_32bit_index ] );
-
-		data_index += sizeof( uint32_t );
+		for( value_32bit_index = 0;
+		     value_32bit_index < number_of_values;
+		     value_32bit_index++ )
+		{
+			values_32bit[ value_32bit_index ] ^= sector_key_32bit[ value_32bit_index % 8 ];
+		}
 	}
-	if( memory_set(
-	     values_32bit,
-	     0,
-	     data_size ) == NULL )
+	else
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear values 32-bit.",
-		 function );
+		data_index = 0;
 
-		goto on_error;
+		for( value_32bit_index = 0;
+		     value_32bit_index < number_of_values;
+		     value_32bit_index++ )
+		{
+			byte_stream_copy_from_uint32_little_endian(
+			 &( data[ data_index ] ),
+			 values_32bit[ value_32bit_index ] ^ sector_key_32bit[ value_32bit_index % 8 ] );
+
+			data_index += sizeof( uint32_t );
+		}
+		memory_set(
+		 values_32bit,
+		 0,
+		 data_size );
+
+		if( values_32bit != values_32bit_buffer )
+		{
+			memory_free(
+			 values_32bit );
+		}
 	}
-	memory_free(
-	 values_32bit );
+	memory_set(
+	 sector_key_32bit,
+	 0,
+	 sizeof( uint32_t ) * 8 );
 
 	return( 1 );
 
 on_error:
-	if( values_32bit != NULL )
+	if( ( is_in_place == 0 )
+	 && ( values_32bit != NULL ) )
 	{
 		memory_set(
 		 values_32bit,
 		 0,
 		 data_size );
 
-		memory_free(
-		 values_32bit );
+		if( values_32bit != values_32bit_buffer )
+		{
+			memory_free(
+			 values_32bit );
+		}
 	}
+	memory_set(
+	 sector_key_32bit,
+	 0,
+	 sizeof( uint32_t ) * 8 );
+
 	return( -1 );
 }
 
@@ -378,18 +454,28 @@ int libbde_diffuser_b_decrypt(
 }
 
 /* Encrypts the data using Diffuser-A and B
+ * On little-endian hosts 32-bit aligned data is encrypted in-place,
+ * otherwise the values are converted in a buffer on the stack if the data is
+ * small enough, such as a sector, and on the heap if not
+ * If sector key data is provided it is applied before the diffuser encryption
  * Returns 1 if successful or -1 on error
  */
 int libbde_diffuser_encrypt(
      uint8_t *data,
      size_t data_size,
+     const uint8_t *sector_key_data,
+     size_t sector_key_data_size,
      libcerror_error_t **error )
 {
+	uint32_t values_32bit_buffer[ LIBBDE_DIFFUSER_MAXIMUM_NUMBER_OF_BUFFERED_VALUES ];
+	uint32_t sector_key_32bit[ 8 ];
+
 	uint32_t *values_32bit   = NULL;
 	static char *function    = "libbde_diffuser_encrypt";
 	size_t data_index        = 0;
 	size_t number_of_values  = 0;
 	size_t value_32bit_index = 0;
+	uint8_t is_in_place      = 0;
 
 	if( data == NULL )
 	{
@@ -424,33 +510,90 @@ int libbde_diffuser_encrypt(
 
 		return( -1 );
 	}
-	number_of_values = data_size / 4;
-
-	values_32bit = (uint32_t *) memory_allocate(
-	                             data_size );
-
-	if( values_32bit == NULL )
+	if( ( sector_key_data != NULL )
+	 && ( sector_key_data_size != 32 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create values 32-bit.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported sector key data size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	data_index = 0;
-
 	for( value_32bit_index = 0;
-	     value_32bit_index < number_of_values;
+	     value_32bit_index < 8;
 	     value_32bit_index++ )
 	{
-		byte_stream_copy_to_uint32_little_endian(
-		 &( data[ data_index ] ),
-		 values_32bit[ value_32bit_index ] );
+		if( sector_key_data == NULL )
+		{
+			sector_key_32bit[ value_32bit_index ] = 0;
+		}
+		else
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( sector_key_data[ value_32bit_index * 4 ] ),
+			 sector_key_32bit[ value_32bit_index ] );
+		}
+	}
+	number_of_values = data_size / 4;
+
+	if( ( _BYTE_STREAM_HOST_IS_ENDIAN_LITTLE )
+	 && ( ( (intptr_t) data % sizeof( uint32_t ) ) == 0 ) )
+	{
+		values_32bit = (uint32_t *) data;
+		is_in_place  = 1;
+	}
+	else if( number_of_values <= LIBBDE_DIFFUSER_MAXIMUM_NUMBER_OF_BUFFERED_VALUES )
+	{
+		values_32bit = values_32bit_buffer;
+	}
+	else
+	{
+		values_32bit = (uint32_t *) memory_allocate(
+		                             data_size );
+
+		if( values_32bit == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create values 32-bit.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The sector key is applied as 32-bit values, in a separate pass over
+	 * in-place data and while loading the values otherwise
+	 */
+	if( is_in_place != 0 )
+	{
+		for( value_32bit_index = 0;
+		     value_32bit_index < number_of_values;
+		     value_32bit_index++ )
+		{
+			values_32bit[ value_32bit_index ] ^= sector_key_32bit[ value_32bit_index % 8 ];
+		}
+	}
+	else
+	{
+		data_index = 0;
 
-		data_index += sizeof( uint32_t );
+		for( value_32bit_index = 0;
+		     value_32bit_index < number_of_values;
+		     value_32bit_index++ )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( data[ data_index ] ),
+			 values_32bit[ value_32bit_index ] );
+
+			values_32bit[ value_32bit_index ] ^= sector_key_32bit[ value_32bit_index % 8 ];
+
+			data_index += sizeof( uint32_t );
+		}
 	}
 	if( libbde_diffuser_a_encrypt(
 	     values_32bit,
@@ -480,48 +623,58 @@ int libbde_diffuser_encrypt(
 
 		goto on_error;
 	}
-	data_index = 0;
-
-	for( value_32bit_index = 0;
-	     value_32bit_index < number_of_values;
-	     value_32bit_index++ )
+	if( is_in_place == 0 )
 	{
-		byte_stream_copy_from_uint32_little_endian(
-		 &( data[ data_index ] ),
-		 values_32bit[ value_32bit_index ] );
+		data_index = 0;
 
-		data_index += sizeof( uint32_t );
-	}
-	if( memory_set(
-	     values_32bit,
-	     0,
-	     data_size ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear values 32-bit.",
-		 function );
+		for( value_32bit_index = 0;
+		     value_32bit_index < number_of_values;
+		     value_32bit_index++ )
+		{
+			byte_stream_copy_from_uint32_little_endian(
+			 &( data[ data_index ] ),
+			 values_32bit[ value_32bit_index ] );
 
-		goto on_error;
+			data_index += sizeof( uint32_t );
+		}
+		memory_set(
+		 values_32bit,
+		 0,
+		 data_size );
+
+		if( values_32bit != values_32bit_buffer )
+		{
+			memory_free(
+			 values_32bit );
+		}
 	}
-	memory_free(
-	 values_32bit );
+	memory_set(
+	 sector_key_32bit,
+	 0,
+	 sizeof( uint32_t ) * 8 );
 
 	return( 1 );
 
 on_error:
-	if( values_32bit != NULL )
+	if( ( is_in_place == 0 )
+	 && ( values_32bit != NULL ) )
 	{
 		memory_set(
 		 values_32bit,
 		 0,
 		 data_size );
 
-		memory_free(
-		 values_32bit );
+		if( values_32bit != values_32bit_buffer )
+		{
+			memory_free(
+			 values_32bit );
+		}
 	}
+	memory_set(
+	 sector_key_32bit,
+	 0,
+	 sizeof( uint32_t ) * 8 );
+
 	return( -1 );
 }
 
@@ -538,6 +691,7 @@ int libbde_diffuser_a_encrypt(
 	size_t value_32bit_index1   = 0;
 	size_t value_32bit_index2   = 0;
 	size_t value_32bit_index3   = 0;
+	uint32_t value_32bit        = 0;
 
 	if( values_32bit == NULL )
 	{
@@ -572,63 +726,37 @@ int libbde_diffuser_a_encrypt(
 
 		return( -1 );
 	}
-/* TODO reverse loop
-	number_of_iterations = number_of_values * 5;
-
-	value_32bit_index1 = 0;
-	value_32bit_index2 = number_of_values - 2;
-	value_32bit_index3 = number_of_values - 5;
-*/
-
+	/* The encryption reverses the decryption by undoing the decryption steps
+	 * in reverse order
+	 */
 	for( number_of_iterations = 5;
 	     number_of_iterations > 0;
 	     number_of_iterations-- )
 	{
-		value_32bit_index1 = 0;
-		value_32bit_index2 = number_of_values - 2;
-		value_32bit_index3 = number_of_values - 5;
+		value_32bit_index1 = number_of_values;
 
-		while( value_32bit_index1 < ( number_of_values - 1 ) )
+		while( value_32bit_index1 > 0 )
 		{
-			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
-			                                    ^ byte_stream_bit_rotate_left_32bit(
-			                                       values_32bit[ value_32bit_index3 ],
-			                                       9 );
+			value_32bit_index1--;
 
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
+			value_32bit_index2 = ( value_32bit_index1 + number_of_values - 2 ) % number_of_values;
+			value_32bit_index3 = ( value_32bit_index1 + number_of_values - 5 ) % number_of_values;
 
-			if( value_32bit_index3 >= number_of_values )
+			value_32bit = values_32bit[ value_32bit_index3 ];
+
+			if( ( value_32bit_index1 % 4 ) == 0 )
 			{
-				value_32bit_index3 -= number_of_values;
+				value_32bit = byte_stream_bit_rotate_left_32bit(
+				               value_32bit,
+				               9 );
 			}
-			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
-			                                    ^ values_32bit[ value_32bit_index3 ];
-
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
-
-			if( value_32bit_index2 >= number_of_values )
+			else if( ( value_32bit_index1 % 4 ) == 2 )
 			{
-				value_32bit_index2 -= number_of_values;
+				value_32bit = byte_stream_bit_rotate_left_32bit(
+				               value_32bit,
+				               13 );
 			}
-			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
-			                                    ^ byte_stream_bit_rotate_left_32bit(
-			                                       values_32bit[ value_32bit_index3 ],
-			                                       13 );
-
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
-
-			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
-			                                    ^ values_32bit[ value_32bit_index3 ];
-
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
+			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ] ^ value_32bit;
 		}
 	}
 	return( 1 );
@@ -647,6 +775,7 @@ int libbde_diffuser_b_encrypt(
 	size_t value_32bit_index1   = 0;
 	size_t value_32bit_index2   = 0;
 	size_t value_32bit_index3   = 0;
+	uint32_t value_32bit        = 0;
 
 	if( values_32bit == NULL )
 	{
@@ -681,63 +810,37 @@ int libbde_diffuser_b_encrypt(
 
 		return( -1 );
 	}
-/* TODO reverse loop
-	number_of_iterations = number_of_values * 3;
-
-	value_32bit_index1 = 0;
-	value_32bit_index2 = 2;
-	value_32bit_index3 = 5;
-*/
-
+	/* The encryption reverses the decryption by undoing the decryption steps
+	 * in reverse order
+	 */
 	for( number_of_iterations = 3;
 	     number_of_iterations > 0;
 	     number_of_iterations-- )
 	{
-		value_32bit_index1 = 0;
-		value_32bit_index2 = 2;
-		value_32bit_index3 = 5;
+		value_32bit_index1 = number_of_values;
 
-		while( value_32bit_index1 < ( number_of_values - 1 ) )
+		while( value_32bit_index1 > 0 )
 		{
-			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
-			                                    ^ values_32bit[ value_32bit_index3 ];
+			value_32bit_index1--;
 
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
+			value_32bit_index2 = ( value_32bit_index1 + 2 ) % number_of_values;
+			value_32bit_index3 = ( value_32bit_index1 + 5 ) % number_of_values;
 
-			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
-			                                    ^ byte_stream_bit_rotate_left_32bit(
-			                                       values_32bit[ value_32bit_index3 ],
-			                                       10 );
-
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
+			value_32bit = values_32bit[ value_32bit_index3 ];
 
-			if( value_32bit_index2 >= number_of_values )
+			if( ( value_32bit_index1 % 4 ) == 1 )
 			{
-				value_32bit_index2 -= number_of_values;
+				value_32bit = byte_stream_bit_rotate_left_32bit(
+				               value_32bit,
+				               10 );
 			}
-			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
-			                                    ^ values_32bit[ value_32bit_index3 ];
-
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
-
-			if( value_32bit_index3 >= number_of_values )
+			else if( ( value_32bit_index1 % 4 ) == 3 )
 			{
-				value_32bit_index3 -= number_of_values;
+				value_32bit = byte_stream_bit_rotate_left_32bit(
+				               value_32bit,
+				               25 );
 			}
-			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ]
-			                                    ^ byte_stream_bit_rotate_left_32bit(
-			                                       values_32bit[ value_32bit_index3 ],
-			                                       25 );
-
-			value_32bit_index1++;
-			value_32bit_index2++;
-			value_32bit_index3++;
+			values_32bit[ value_32bit_index1 ] -= values_32bit[ value_32bit_index2 ] ^ value_32bit;
 		}
 	}
 	return( 1 );
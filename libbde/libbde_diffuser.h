@@ -34,6 +34,8 @@ extern "C" {
 int libbde_diffuser_decrypt(
      uint8_t *data,
      size_t data_size,
+     const uint8_t *sector_key_data,
+     size_t sector_key_data_size,
      libcerror_error_t **error );
 
 int libbde_diffuser_a_decrypt(
@@ -49,6 +51,8 @@ int libbde_diffuser_b_decrypt(
 int libbde_diffuser_encrypt(
      uint8_t *data,
      size_t data_size,
+     const uint8_t *sector_key_data,
+     size_t sector_key_data_size,
      libcerror_error_t **error );
 
 int libbde_diffuser_a_encrypt(
@@ -0,0 +1,727 @@
+/*
+ * Elephant diffuser AVX2 functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_definitions.h"
+#include "libbde_diffuser_avx2.h"
+#include "libbde_libcerror.h"
+
+#if defined( HAVE_LIBBDE_DIFFUSER_AVX2 )
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+#include <immintrin.h>
+
+/* The functions that use the AVX2 intrinsics are compiled for the AVX2
+ * instruction set, they are only called after libbde_diffuser_avx2_is_supported
+ */
+#if defined( __GNUC__ )
+#define LIBBDE_DIFFUSER_AVX2_TARGET \
+	__attribute__((target("avx2")))
+#else
+#define LIBBDE_DIFFUSER_AVX2_TARGET
+#endif
+
+#define libbde_diffuser_avx2_rotate_left( value, number_of_bits ) \
+	_mm256_or_si256( \
+	 _mm256_slli_epi32( \
+	  value, \
+	  number_of_bits ), \
+	 _mm256_srli_epi32( \
+	  value, \
+	  32 - number_of_bits ) )
+
+/* Determines if the CPU and operating system support the AVX2 instructions
+ * Returns 1 if supported or 0 if not
+ */
+int libbde_diffuser_avx2_is_supported(
+     void )
+{
+#if defined( _MSC_VER )
+	int cpu_info[ 4 ];
+
+	__cpuid(
+	 cpu_info,
+	 0 );
+
+	if( cpu_info[ 0 ] < 7 )
+	{
+		return( 0 );
+	}
+	__cpuid(
+	 cpu_info,
+	 1 );
+
+	if( ( ( cpu_info[ 2 ] & 0x08000000UL ) == 0 )
+	 || ( ( cpu_info[ 2 ] & 0x10000000UL ) == 0 ) )
+	{
+		return( 0 );
+	}
+	if( ( _xgetbv( 0 ) & 0x06 ) != 0x06 )
+	{
+		return( 0 );
+	}
+	__cpuidex(
+	 cpu_info,
+	 7,
+	 0 );
+
+	if( ( cpu_info[ 1 ] & 0x00000020UL ) != 0 )
+	{
+		return( 1 );
+	}
+#else
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+
+	if( __get_cpuid_max(
+	     0,
+	     NULL ) < 7 )
+	{
+		return( 0 );
+	}
+	if( __get_cpuid(
+	     1,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		return( 0 );
+	}
+	/* ECX bit 27 indicates OSXSAVE and ECX bit 28 indicates AVX
+	 */
+	if( ( ( ecx & 0x08000000UL ) == 0 )
+	 || ( ( ecx & 0x10000000UL ) == 0 ) )
+	{
+		return( 0 );
+	}
+	/* The operating system must preserve the XMM and YMM registers
+	 */
+	__asm__ __volatile__ (
+	 "xgetbv"
+	 : "=a" ( eax ), "=d" ( edx )
+	 : "c" ( 0 ) );
+
+	if( ( eax & 0x06 ) != 0x06 )
+	{
+		return( 0 );
+	}
+	__cpuid_count(
+	 7,
+	 0,
+	 eax,
+	 ebx,
+	 ecx,
+	 edx );
+
+	/* EBX bit 5 indicates AVX2
+	 */
+	if( ( ebx & 0x00000020UL ) != 0 )
+	{
+		return( 1 );
+	}
+#endif
+	return( 0 );
+}
+
+/* Transposes 8 rows of 8 32-bit values
+ */
+LIBBDE_DIFFUSER_AVX2_TARGET
+static void libbde_diffuser_avx2_transpose(
+             __m256i *rows )
+{
+	__m256i values_32bit[ 8 ];
+	__m256i values_64bit[ 8 ];
+
+	values_32bit[ 0 ] = _mm256_unpacklo_epi32( rows[ 0 ], rows[ 1 ] );
+	values_32bit[ 1 ] = _mm256_unpackhi_epi32( rows[ 0 ], rows[ 1 ] );
+	values_32bit[ 2 ] = _mm256_unpacklo_epi32( rows[ 2 ], rows[ 3 ] );
+	values_32bit[ 3 ] = _mm256_unpackhi_epi32( rows[ 2 ], rows[ 3 ] );
+	values_32bit[ 4 ] = _mm256_unpacklo_epi32( rows[ 4 ], rows[ 5 ] );
+	values_32bit[ 5 ] = _mm256_unpackhi_epi32( rows[ 4 ], rows[ 5 ] );
+	values_32bit[ 6 ] = _mm256_unpacklo_epi32( rows[ 6 ], rows[ 7 ] );
+	values_32bit[ 7 ] = _mm256_unpackhi_epi32( rows[ 6 ], rows[ 7 ] );
+
+	values_64bit[ 0 ] = _mm256_unpacklo_epi64( values_32bit[ 0 ], values_32bit[ 2 ] );
+	values_64bit[ 1 ] = _mm256_unpackhi_epi64( values_32bit[ 0 ], values_32bit[ 2 ] );
+	values_64bit[ 2 ] = _mm256_unpacklo_epi64( values_32bit[ 1 ], values_32bit[ 3 ] );
+	values_64bit[ 3 ] = _mm256_unpackhi_epi64( values_32bit[ 1 ], values_32bit[ 3 ] );
+	values_64bit[ 4 ] = _mm256_unpacklo_epi64( values_32bit[ 4 ], values_32bit[ 6 ] );
+	values_64bit[ 5 ] = _mm256_unpackhi_epi64( values_32bit[ 4 ], values_32bit[ 6 ] );
+	values_64bit[ 6 ] = _mm256_unpacklo_epi64( values_32bit[ 5 ], values_32bit[ 7 ] );
+	values_64bit[ 7 ] = _mm256_unpackhi_epi64( values_32bit[ 5 ], values_32bit[ 7 ] );
+
+	rows[ 0 ] = _mm256_permute2x128_si256( values_64bit[ 0 ], values_64bit[ 4 ], 0x20 );
+	rows[ 1 ] = _mm256_permute2x128_si256( values_64bit[ 1 ], values_64bit[ 5 ], 0x20 );
+	rows[ 2 ] = _mm256_permute2x128_si256( values_64bit[ 2 ], values_64bit[ 6 ], 0x20 );
+	rows[ 3 ] = _mm256_permute2x128_si256( values_64bit[ 3 ], values_64bit[ 7 ], 0x20 );
+	rows[ 4 ] = _mm256_permute2x128_si256( values_64bit[ 0 ], values_64bit[ 4 ], 0x31 );
+	rows[ 5 ] = _mm256_permute2x128_si256( values_64bit[ 1 ], values_64bit[ 5 ], 0x31 );
+	rows[ 6 ] = _mm256_permute2x128_si256( values_64bit[ 2 ], values_64bit[ 6 ], 0x31 );
+	rows[ 7 ] = _mm256_permute2x128_si256( values_64bit[ 3 ], values_64bit[ 7 ], 0x31 );
+}
+
+/* Loads the values of the sectors, one sector per lane
+ * If sector keys are provided they are applied to the values while loading
+ */
+LIBBDE_DIFFUSER_AVX2_TARGET
+static void libbde_diffuser_avx2_load(
+             const uint8_t *data,
+             size_t sector_size,
+             const __m256i *sector_keys,
+             __m256i *values,
+             size_t number_of_values )
+{
+	size_t sector_index = 0;
+	size_t value_index  = 0;
+
+	for( value_index = 0;
+	     value_index < number_of_values;
+	     value_index += 8 )
+	{
+		for( sector_index = 0;
+		     sector_index < LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS;
+		     sector_index++ )
+		{
+			values[ value_index + sector_index ] = _mm256_loadu_si256(
+			                                        (__m256i *) &( data[ ( sector_index * sector_size ) + ( value_index * 4 ) ] ) );
+
+			if( sector_keys != NULL )
+			{
+				values[ value_index + sector_index ] = _mm256_xor_si256(
+				                                        values[ value_index + sector_index ],
+				                                        sector_keys[ sector_index ] );
+			}
+		}
+		libbde_diffuser_avx2_transpose(
+		 &( values[ value_index ] ) );
+	}
+}
+
+/* Stores the values of the sectors, one sector per lane
+ * If sector keys are provided they are applied to the values while storing
+ */
+LIBBDE_DIFFUSER_AVX2_TARGET
+static void libbde_diffuser_avx2_store(
+             __m256i *values,
+             size_t number_of_values,
+             const __m256i *sector_keys,
+             uint8_t *data,
+             size_t sector_size )
+{
+	size_t sector_index = 0;
+	size_t value_index  = 0;
+
+	for( value_index = 0;
+	     value_index < number_of_values;
+	     value_index += 8 )
+	{
+		libbde_diffuser_avx2_transpose(
+		 &( values[ value_index ] ) );
+
+		for( sector_index = 0;
+		     sector_index < LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS;
+		     sector_index++ )
+		{
+			if( sector_keys != NULL )
+			{
+				values[ value_index + sector_index ] = _mm256_xor_si256(
+				                                        values[ value_index + sector_index ],
+				                                        sector_keys[ sector_index ] );
+			}
+			_mm256_storeu_si256(
+			 (__m256i *) &( data[ ( sector_index * sector_size ) + ( value_index * 4 ) ] ),
+			 values[ value_index + sector_index ] );
+		}
+	}
+}
+
+/* Decrypts the values using Diffuser-B and Diffuser-A
+ */
+LIBBDE_DIFFUSER_AVX2_TARGET
+static void libbde_diffuser_avx2_decrypt_values(
+             __m256i *values,
+             size_t number_of_values )
+{
+	__m256i value               = _mm256_setzero_si256();
+	size_t number_of_iterations = 0;
+	size_t value_index1         = 0;
+	size_t value_index2         = 0;
+	size_t value_index3         = 0;
+
+	for( number_of_iterations = 3;
+	     number_of_iterations > 0;
+	     number_of_iterations-- )
+	{
+		value_index2 = 2;
+		value_index3 = 5;
+
+		for( value_index1 = 0;
+		     value_index1 < number_of_values;
+		     value_index1++ )
+		{
+			value = values[ value_index3 ];
+
+			if( ( value_index1 % 4 ) == 1 )
+			{
+				value = libbde_diffuser_avx2_rotate_left(
+				         value,
+				         10 );
+			}
+			else if( ( value_index1 % 4 ) == 3 )
+			{
+				value = libbde_diffuser_avx2_rotate_left(
+				         value,
+				         25 );
+			}
+			values[ value_index1 ] = _mm256_add_epi32(
+			                          values[ value_index1 ],
+			                          _mm256_xor_si256(
+			                           values[ value_index2 ],
+			                           value ) );
+
+			if( ++value_index2 >= number_of_values )
+			{
+				value_index2 = 0;
+			}
+			if( ++value_index3 >= number_of_values )
+			{
+				value_index3 = 0;
+			}
+		}
+	}
+	for( number_of_iterations = 5;
+	     number_of_iterations > 0;
+	     number_of_iterations-- )
+	{
+		value_index2 = number_of_values - 2;
+		value_index3 = number_of_values - 5;
+
+		for( value_index1 = 0;
+		     value_index1 < number_of_values;
+		     value_index1++ )
+		{
+			value = values[ value_index3 ];
+
+			if( ( value_index1 % 4 ) == 0 )
+			{
+				value = libbde_diffuser_avx2_rotate_left(
+				         value,
+				         9 );
+			}
+			else if( ( value_index1 % 4 ) == 2 )
+			{
+				value = libbde_diffuser_avx2_rotate_left(
+				         value,
+				         13 );
+			}
+			values[ value_index1 ] = _mm256_add_epi32(
+			                          values[ value_index1 ],
+			                          _mm256_xor_si256(
+			                           values[ value_index2 ],
+			                           value ) );
+
+			if( ++value_index2 >= number_of_values )
+			{
+				value_index2 = 0;
+			}
+			if( ++value_index3 >= number_of_values )
+			{
+				value_index3 = 0;
+			}
+		}
+	}
+}
+
+/* Encrypts the values using Diffuser-A and Diffuser-B
+ * The encryption undoes the decryption steps in reverse order
+ */
+LIBBDE_DIFFUSER_AVX2_TARGET
+static void libbde_diffuser_avx2_encrypt_values(
+             __m256i *values,
+             size_t number_of_values )
+{
+	__m256i value               = _mm256_setzero_si256();
+	size_t number_of_iterations = 0;
+	size_t value_index1         = 0;
+	size_t value_index2         = 0;
+	size_t value_index3         = 0;
+
+	for( number_of_iterations = 5;
+	     number_of_iterations > 0;
+	     number_of_iterations-- )
+	{
+		value_index2 = number_of_values - 3;
+		value_index3 = number_of_values - 6;
+
+		for( value_index1 = number_of_values;
+		     value_index1 > 0;
+		     value_index1-- )
+		{
+			value = values[ value_index3 ];
+
+			if( ( ( value_index1 - 1 ) % 4 ) == 0 )
+			{
+				value = libbde_diffuser_avx2_rotate_left(
+				         value,
+				         9 );
+			}
+			else if( ( ( value_index1 - 1 ) % 4 ) == 2 )
+			{
+				value = libbde_diffuser_avx2_rotate_left(
+				         value,
+				         13 );
+			}
+			values[ value_index1 - 1 ] = _mm256_sub_epi32(
+			                              values[ value_index1 - 1 ],
+			                              _mm256_xor_si256(
+			                               values[ value_index2 ],
+			                               value ) );
+
+			if( value_index2 == 0 )
+			{
+				value_index2 = number_of_values;
+			}
+			value_index2--;
+
+			if( value_index3 == 0 )
+			{
+				value_index3 = number_of_values;
+			}
+			value_index3--;
+		}
+	}
+	for( number_of_iterations = 3;
+	     number_of_iterations > 0;
+	     number_of_iterations-- )
+	{
+		value_index2 = 1;
+		value_index3 = 4;
+
+		for( value_index1 = number_of_values;
+		     value_index1 > 0;
+		     value_index1-- )
+		{
+			value = values[ value_index3 ];
+
+			if( ( ( value_index1 - 1 ) % 4 ) == 1 )
+			{
+				value = libbde_diffuser_avx2_rotate_left(
+				         value,
+				         10 );
+			}
+			else if( ( ( value_index1 - 1 ) % 4 ) == 3 )
+			{
+				value = libbde_diffuser_avx2_rotate_left(
+				         value,
+				         25 );
+			}
+			values[ value_index1 - 1 ] = _mm256_sub_epi32(
+			                              values[ value_index1 - 1 ],
+			                              _mm256_xor_si256(
+			                               values[ value_index2 ],
+			                               value ) );
+
+			if( value_index2 == 0 )
+			{
+				value_index2 = number_of_values;
+			}
+			value_index2--;
+
+			if( value_index3 == 0 )
+			{
+				value_index3 = number_of_values;
+			}
+			value_index3--;
+		}
+	}
+}
+
+/* Checks the arguments of the sector functions
+ * Returns 1 if successful or -1 on error
+ */
+static int libbde_diffuser_avx2_check_arguments(
+            uint8_t *data,
+            size_t data_size,
+            size_t sector_size,
+            const uint8_t *sector_keys,
+            size_t sector_keys_size,
+            uint8_t *values_buffer,
+            size_t values_buffer_size,
+            const char *function,
+            libcerror_error_t **error )
+{
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( sector_size < 32 )
+	 || ( ( sector_size % 32 ) != 0 )
+	 || ( ( sector_size / 4 ) > LIBBDE_DIFFUSER_MAXIMUM_NUMBER_OF_BUFFERED_VALUES ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported sector size.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size != ( sector_size * LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_keys == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector keys.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_keys_size < ( 32 * LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid sector keys size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( values_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( values_buffer_size < LIBBDE_DIFFUSER_AVX2_VALUES_BUFFER_SIZE( sector_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid values buffer size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Decrypts 8 consecutive sectors using Diffuser-A and B
+ * Every sector is decrypted in its own 32-bit lane of the AVX2 registers
+ * The 32-byte sector key of each sector is applied while storing the sector
+ * The values buffer holds the values of the sectors while they are decrypted
+ * and must be at least LIBBDE_DIFFUSER_AVX2_VALUES_BUFFER_SIZE( sector_size ) in size
+ * Returns 1 if successful or -1 on error
+ */
+LIBBDE_DIFFUSER_AVX2_TARGET
+int libbde_diffuser_avx2_decrypt_sectors(
+     uint8_t *data,
+     size_t data_size,
+     size_t sector_size,
+     const uint8_t *sector_keys,
+     size_t sector_keys_size,
+     uint8_t *values_buffer,
+     size_t values_buffer_size,
+     libcerror_error_t **error )
+{
+	__m256i sector_keys_256bit[ LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS ];
+
+	__m256i *values         = NULL;
+	static char *function   = "libbde_diffuser_avx2_decrypt_sectors";
+	size_t number_of_values = 0;
+	int sector_index        = 0;
+
+	if( libbde_diffuser_avx2_check_arguments(
+	     data,
+	     data_size,
+	     sector_size,
+	     sector_keys,
+	     sector_keys_size,
+	     values_buffer,
+	     values_buffer_size,
+	     function,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	number_of_values = sector_size / 4;
+
+	values = (__m256i *) &( values_buffer[ ( 32 - ( (intptr_t) values_buffer % 32 ) ) % 32 ] );
+
+	for( sector_index = 0;
+	     sector_index < LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS;
+	     sector_index++ )
+	{
+		sector_keys_256bit[ sector_index ] = _mm256_loadu_si256(
+		                                      (__m256i *) &( sector_keys[ sector_index * 32 ] ) );
+	}
+
+	libbde_diffuser_avx2_load(
+	 data,
+	 sector_size,
+	 NULL,
+	 values,
+	 number_of_values );
+
+	libbde_diffuser_avx2_decrypt_values(
+	 values,
+	 number_of_values );
+
+	libbde_diffuser_avx2_store(
+	 values,
+	 number_of_values,
+	 sector_keys_256bit,
+	 data,
+	 sector_size );
+
+	memory_set(
+	 values,
+	 0,
+	 sizeof( __m256i ) * number_of_values );
+
+	memory_set(
+	 sector_keys_256bit,
+	 0,
+	 sizeof( __m256i ) * LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS );
+
+	return( 1 );
+}
+
+/* Encrypts 8 consecutive sectors using Diffuser-A and B
+ * Every sector is encrypted in its own 32-bit lane of the AVX2 registers
+ * The 32-byte sector key of each sector is applied while loading the sector
+ * The values buffer holds the values of the sectors while they are encrypted
+ * and must be at least LIBBDE_DIFFUSER_AVX2_VALUES_BUFFER_SIZE( sector_size ) in size
+ * Returns 1 if successful or -1 on error
+ */
+LIBBDE_DIFFUSER_AVX2_TARGET
+int libbde_diffuser_avx2_encrypt_sectors(
+     uint8_t *data,
+     size_t data_size,
+     size_t sector_size,
+     const uint8_t *sector_keys,
+     size_t sector_keys_size,
+     uint8_t *values_buffer,
+     size_t values_buffer_size,
+     libcerror_error_t **error )
+{
+	__m256i sector_keys_256bit[ LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS ];
+
+	__m256i *values         = NULL;
+	static char *function   = "libbde_diffuser_avx2_encrypt_sectors";
+	size_t number_of_values = 0;
+	int sector_index        = 0;
+
+	if( libbde_diffuser_avx2_check_arguments(
+	     data,
+	     data_size,
+	     sector_size,
+	     sector_keys,
+	     sector_keys_size,
+	     values_buffer,
+	     values_buffer_size,
+	     function,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	number_of_values = sector_size / 4;
+
+	values = (__m256i *) &( values_buffer[ ( 32 - ( (intptr_t) values_buffer % 32 ) ) % 32 ] );
+
+	for( sector_index = 0;
+	     sector_index < LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS;
+	     sector_index++ )
+	{
+		sector_keys_256bit[ sector_index ] = _mm256_loadu_si256(
+		                                      (__m256i *) &( sector_keys[ sector_index * 32 ] ) );
+	}
+
+	libbde_diffuser_avx2_load(
+	 data,
+	 sector_size,
+	 sector_keys_256bit,
+	 values,
+	 number_of_values );
+
+	libbde_diffuser_avx2_encrypt_values(
+	 values,
+	 number_of_values );
+
+	libbde_diffuser_avx2_store(
+	 values,
+	 number_of_values,
+	 NULL,
+	 data,
+	 sector_size );
+
+	memory_set(
+	 values,
+	 0,
+	 sizeof( __m256i ) * number_of_values );
+
+	memory_set(
+	 sector_keys_256bit,
+	 0,
+	 sizeof( __m256i ) * LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS );
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBBDE_DIFFUSER_AVX2 ) */
+
@@ -0,0 +1,83 @@
+/*
+ * Elephant diffuser AVX2 functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_DIFFUSER_AVX2_H )
+#define _LIBBDE_DIFFUSER_AVX2_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The AVX2 diffuser is only available on x86 and x86-64
+ */
+#if ( defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) ) \
+ || ( defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) ) )
+#define HAVE_LIBBDE_DIFFUSER_AVX2	1
+#endif
+
+#if defined( HAVE_LIBBDE_DIFFUSER_AVX2 )
+
+/* The number of sectors that are processed in parallel, one per 32-bit lane
+ */
+#define LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS	8
+
+/* The size of the buffer that holds the values of the sectors while they
+ * are diffused, including the space needed to align the values to 32 bytes
+ */
+#define LIBBDE_DIFFUSER_AVX2_VALUES_BUFFER_SIZE( sector_size ) \
+	( ( (size_t) ( sector_size ) * LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS ) + 32 )
+
+int libbde_diffuser_avx2_is_supported(
+     void );
+
+int libbde_diffuser_avx2_decrypt_sectors(
+     uint8_t *data,
+     size_t data_size,
+     size_t sector_size,
+     const uint8_t *sector_keys,
+     size_t sector_keys_size,
+     uint8_t *values_buffer,
+     size_t values_buffer_size,
+     libcerror_error_t **error );
+
+int libbde_diffuser_avx2_encrypt_sectors(
+     uint8_t *data,
+     size_t data_size,
+     size_t sector_size,
+     const uint8_t *sector_keys,
+     size_t sector_keys_size,
+     uint8_t *values_buffer,
+     size_t values_buffer_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBBDE_DIFFUSER_AVX2 ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_DIFFUSER_AVX2_H ) */
+
@@ -24,12 +24,15 @@
 #include <memory.h>
 #include <types.h>
 
+#include "libbde_aes_ni.h"
 #include "libbde_definitions.h"
 #include "libbde_diffuser.h"
+#include "libbde_diffuser_avx2.h"
 #include "libbde_encryption.h"
 #include "libbde_libcaes.h"
 #include "libbde_libcerror.h"
 #include "libbde_libcnotify.h"
+#include "libbde_unused.h"
 
 /* Creates an encryption context
  * Make sure the value encryption context is referencing, is set to NULL
@@ -207,6 +210,22 @@ int libbde_encryption_initialize(
 	}
 	( *context )->method = method;
 
+#if defined( HAVE_LIBBDE_AES_NI )
+	/* The AES-NI kernels are only used if they produce the known answers
+	 */
+	if( libbde_aes_ni_is_supported() != 0 )
+	{
+		( *context )->use_aes_ni = libbde_aes_ni_self_test();
+	}
+#endif
+#if defined( HAVE_LIBBDE_DIFFUSER_AVX2 )
+	if( ( ( method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
+	  || ( method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+	 && ( libbde_diffuser_avx2_is_supported() != 0 ) )
+	{
+		( *context )->use_diffuser_avx2 = 1;
+	}
+#endif
 	return( 1 );
 
 on_error:
@@ -375,6 +394,44 @@ int libbde_encryption_free(
 				result = -1;
 			}
 		}
+#if defined( HAVE_LIBBDE_AES_NI )
+		if( libbde_aes_ni_context_clear(
+		     &( ( *context )->fvek_aes_ni_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable clear FVEK AES-NI context.",
+			 function );
+
+			result = -1;
+		}
+		if( libbde_aes_ni_context_clear(
+		     &( ( *context )->tweak_aes_ni_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable clear TWEAK key AES-NI context.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *context )->sector_buffer != NULL )
+		{
+			memory_set(
+			 ( *context )->sector_buffer,
+			 0,
+			 ( *context )->sector_buffer_size );
+
+			memory_free(
+			 ( *context )->sector_buffer );
+		}
 		memory_free(
 		 *context );
 
@@ -482,7 +539,11 @@ int libbde_encryption_set_keys(
 
 		return( -1 );
 	}
-	if( tweak_key_size < key_byte_size )
+	/* Only the diffuser methods use the tweak key
+	 */
+	if( ( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
+	  || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+	 && ( tweak_key_size < key_byte_size ) )
 	{
 		libcerror_error_set(
 		 error,
@@ -532,6 +593,26 @@ int libbde_encryption_set_keys(
 
 			return( -1 );
 		}
+#if defined( HAVE_LIBBDE_AES_NI )
+		if( context->use_aes_ni != 0 )
+		{
+			if( libbde_aes_ni_context_set_key(
+			     &( context->fvek_aes_ni_context ),
+			     full_volume_encryption_key,
+			     key_bit_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set full volume encryption key in AES-NI context.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif
 		/* The TWEAK key is only used with diffuser
 		 */
 		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
@@ -569,6 +650,26 @@ int libbde_encryption_set_keys(
 
 				return( -1 );
 			}
+#if defined( HAVE_LIBBDE_AES_NI )
+			if( context->use_aes_ni != 0 )
+			{
+				if( libbde_aes_ni_context_set_key(
+				     &( context->tweak_aes_ni_context ),
+				     tweak_key,
+				     key_bit_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set tweak key in AES-NI context.",
+					 function );
+
+					return( -1 );
+				}
+			}
+#endif
 		}
 	}
 	else if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
@@ -613,30 +714,77 @@ int libbde_encryption_set_keys(
 
 			return( -1 );
 		}
+#if defined( HAVE_LIBBDE_AES_NI )
+		if( context->use_aes_ni != 0 )
+		{
+			if( libbde_aes_ni_context_set_key(
+			     &( context->fvek_aes_ni_context ),
+			     full_volume_encryption_key,
+			     key_bit_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set full volume encryption key in AES-NI context.",
+				 function );
+
+				return( -1 );
+			}
+			if( libbde_aes_ni_context_set_key(
+			     &( context->tweak_aes_ni_context ),
+			     &( full_volume_encryption_key[ key_byte_size ] ),
+			     key_bit_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set full volume encryption tweak key in AES-NI context.",
+				 function );
+
+				return( -1 );
+			}
+		}
+#endif
+	}
+	if( libbde_encryption_set_crypt_functions(
+	     context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set crypt functions.",
+		 function );
+
+		return( -1 );
 	}
 	return( 1 );
 }
 
-/* De- or encrypts a block of data
+/* Generates the initialization vectors and sector keys of consecutive sectors
+ * The block key of each sector is the block key of the previous sector plus the block key increment
+ * The sector keys are only generated for methods that use the diffuser and are 0 otherwise
+ * With XTS the initialization vector is the block key, which is the sector number, as a 64-bit little-endian value
+ * The sector keys are generated by the function that was selected for the method when the keys were set
  * Returns 1 if successful or -1 on error
  */
-int libbde_encryption_crypt(
+int libbde_encryption_generate_sector_keys(
      libbde_encryption_context_t *context,
-     int mode,
-     const uint8_t *input_data,
-     size_t input_data_size,
-     uint8_t *output_data,
-     size_t output_data_size,
      uint64_t block_key,
+     uint64_t block_key_increment,
+     int number_of_sectors,
+     uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     uint8_t *sector_keys,
+     size_t sector_keys_size,
      libcerror_error_t **error )
 {
-	uint8_t block_key_data[ 16 ];
-	uint8_t initialization_vector[ 16 ];
-	uint8_t sector_key_data[ 32 ];
-
-	static char *function        = "libbde_encryption_crypt";
-	size_t data_index            = 0;
-	size_t sector_key_data_index = 0;
+	static char *function = "libbde_encryption_generate_sector_keys";
 
 	if( context == NULL )
 	{
@@ -649,331 +797,1817 @@ int libbde_encryption_crypt(
 
 		return( -1 );
 	}
-	if( ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
-	 && ( mode != LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT ) )
+	if( context->generate_sector_keys == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid context - missing generate sector keys function, keys not set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_sectors <= 0 )
+	 || ( number_of_sectors > LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported mode.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sectors value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( memory_set(
-	     initialization_vector,
-	     0,
-	     16 ) == NULL )
+	if( initialization_vectors == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear initialization vector.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vectors.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vectors_size < ( (size_t) number_of_sectors * 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid initialization vectors size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_keys == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector keys.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_keys_size < ( (size_t) number_of_sectors * 32 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid sector keys size value too small.",
 		 function );
 
 		return( -1 );
 	}
 	if( memory_set(
-	     block_key_data,
+	     sector_keys,
 	     0,
-	     16 ) == NULL )
+	     (size_t) number_of_sectors * 32 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
 		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear block key data.",
+		 "%s: unable to clear sector keys.",
 		 function );
 
 		return( -1 );
 	}
+	if( context->generate_sector_keys(
+	     context,
+	     block_key,
+	     block_key_increment,
+	     number_of_sectors,
+	     initialization_vectors,
+	     sector_keys,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to generate initialization vectors and sector keys.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Generates the initialization vectors of consecutive sectors that use the sector number as tweak value
+ * The initialization vector is the block key, which is the sector number, as a 64-bit little-endian value
+ * The initialization vectors buffer must be able to contain 16 bytes per sector
+ * The sector keys are not used
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_generate_sector_numbers(
+     libbde_encryption_context_t *context LIBBDE_ATTRIBUTE_UNUSED,
+     uint64_t block_key,
+     uint64_t block_key_increment,
+     int number_of_sectors,
+     uint8_t *initialization_vectors,
+     uint8_t *sector_keys LIBBDE_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_encryption_generate_sector_numbers";
+	int sector_index      = 0;
+
+	LIBBDE_UNREFERENCED_PARAMETER( context )
+	LIBBDE_UNREFERENCED_PARAMETER( sector_keys )
+
 	if( memory_set(
-	     sector_key_data,
+	     initialization_vectors,
 	     0,
-	     32 ) == NULL )
+	     (size_t) number_of_sectors * 16 ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_MEMORY,
 		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear sector key data.",
+		 "%s: unable to clear initialization vectors.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC )
-	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
-	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC )
-	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+	for( sector_index = 0;
+	     sector_index < number_of_sectors;
+	     sector_index++ )
 	{
 		byte_stream_copy_from_uint64_little_endian(
-		 block_key_data,
+		 &( initialization_vectors[ sector_index * 16 ] ),
 		 block_key );
 
-		/* The block key for the initialization vector is encrypted
-		 * with the FVEK
-		 */
-		if( libcaes_crypt_ecb(
-		     context->fvek_encryption_context,
-		     LIBCAES_CRYPT_MODE_ENCRYPT,
-		     block_key_data,
-		     16,
-		     initialization_vector,
-		     16,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-			 "%s: unable to encrypt initialization vector.",
-			 function );
+		block_key += block_key_increment;
+	}
+	return( 1 );
+}
 
-			return( -1 );
-		}
-		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
-		{
-			/* The block key for the sector key data is encrypted
-			 * with the TWEAK key
-			 */
-			if( libcaes_crypt_ecb(
-			     context->tweak_encryption_context,
-			     LIBCAES_CRYPT_MODE_ENCRYPT,
-			     block_key_data,
-			     16,
-			     sector_key_data,
-			     16,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-				 "%s: unable to encrypt sector key data.",
-				 function );
+/* Generates the initialization vectors of consecutive AES-CBC sectors
+ * The initialization vector is the block key, as a 64-bit little-endian value
+ * padded to 16 bytes, encrypted with the FVEK. The initialization vectors of
+ * all sectors are encrypted in a single ECB pass
+ * The initialization vectors buffer must be able to contain 16 bytes per sector
+ * The sector keys are not used
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_generate_initialization_vectors(
+     libbde_encryption_context_t *context,
+     uint64_t block_key,
+     uint64_t block_key_increment,
+     int number_of_sectors,
+     uint8_t *initialization_vectors,
+     uint8_t *sector_keys LIBBDE_ATTRIBUTE_UNUSED,
+     libcerror_error_t **error )
+{
+	uint8_t block_keys_data[ LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 16 ];
 
-				return( -1 );
-			}
-			/* Set the last byte to contain 0x80 (128)
-			 */
-			block_key_data[ 15 ] = 0x80;
+	static char *function = "libbde_encryption_generate_initialization_vectors";
+	size_t data_offset    = 0;
+	int result            = 0;
+	int sector_index      = 0;
 
-			if( libcaes_crypt_ecb(
-			     context->tweak_encryption_context,
-			     LIBCAES_CRYPT_MODE_ENCRYPT,
-			     block_key_data,
-			     16,
-			     &( sector_key_data[ 16 ] ),
-			     16,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-				 "%s: unable to encrypt sector key data.",
-				 function );
+	LIBBDE_UNREFERENCED_PARAMETER( sector_keys )
 
-				return( -1 );
-			}
-		}
+	if( memory_set(
+	     block_keys_data,
+	     0,
+	     (size_t) number_of_sectors * 16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block keys data.",
+		 function );
+
+		return( -1 );
 	}
-	else if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
-	      || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
+	for( sector_index = 0;
+	     sector_index < number_of_sectors;
+	     sector_index++ )
 	{
+		data_offset = (size_t) sector_index * 16;
+
 		byte_stream_copy_from_uint64_little_endian(
-		 initialization_vector,
+		 &( block_keys_data[ data_offset ] ),
 		 block_key );
 
-/* TODO: implement */
+		block_key += block_key_increment;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+#if defined( HAVE_LIBBDE_AES_NI )
+	if( context->use_aes_ni != 0 )
 	{
-		libcnotify_printf(
-		 "%s: initialization vector:\n",
-		 function );
-		libcnotify_print_data(
-		 initialization_vector,
-		 16,
-		 0 );
+		result = libbde_aes_ni_crypt_ecb(
+		          &( context->fvek_aes_ni_context ),
+		          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		          block_keys_data,
+		          (size_t) number_of_sectors * 16,
+		          initialization_vectors,
+		          (size_t) number_of_sectors * 16,
+		          error );
 	}
+	else
 #endif
-	if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
 	{
-/* TODO safe guard input data ? */
-		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
-		{
-			sector_key_data_index = 0;
-
-			for( data_index = 0;
-			     data_index < input_data_size;
-			     data_index++ )
-			{
-				output_data[ data_index ] ^= sector_key_data[ sector_key_data_index ];
+		result = libcaes_crypt_ecb(
+		          context->fvek_encryption_context,
+		          LIBCAES_CRYPT_MODE_ENCRYPT,
+		          block_keys_data,
+		          (size_t) number_of_sectors * 16,
+		          initialization_vectors,
+		          (size_t) number_of_sectors * 16,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to encrypt initialization vectors.",
+		 function );
 
-				sector_key_data_index++;
+		return( -1 );
+	}
+	return( 1 );
+}
 
-				if( sector_key_data_index >= 32 )
-				{
-					sector_key_data_index -= 32;
-				}
-			}
-			if( libbde_diffuser_encrypt(
-			     output_data,
-			     output_data_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_ENCRYPT_FAILED,
-				 "%s: unable to encrypt data using Diffuser.",
-				 function );
+/* Generates the initialization vectors and sector keys of consecutive AES-CBC sectors with the Elephant diffuser
+ * The initialization vectors are generated as with AES-CBC. The sector key data
+ * is a pair of block keys, where the last byte of the second block key is set
+ * to 0x80 (128), encrypted with the TWEAK key. The sector keys of all sectors
+ * are encrypted in a single ECB pass
+ * The initialization vectors buffer must be able to contain 16 bytes per sector
+ * and the sector keys buffer 32 bytes per sector
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_generate_diffuser_sector_keys(
+     libbde_encryption_context_t *context,
+     uint64_t block_key,
+     uint64_t block_key_increment,
+     int number_of_sectors,
+     uint8_t *initialization_vectors,
+     uint8_t *sector_keys,
+     libcerror_error_t **error )
+{
+	uint8_t block_keys_data[ LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 32 ];
+
+	static char *function = "libbde_encryption_generate_diffuser_sector_keys";
+	size_t data_offset    = 0;
+	int result            = 0;
+	int sector_index      = 0;
+
+	if( libbde_encryption_generate_initialization_vectors(
+	     context,
+	     block_key,
+	     block_key_increment,
+	     number_of_sectors,
+	     initialization_vectors,
+	     sector_keys,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to generate initialization vectors.",
+		 function );
 
-				return( -1 );
-			}
+		return( -1 );
+	}
+	if( memory_set(
+	     block_keys_data,
+	     0,
+	     (size_t) number_of_sectors * 32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block keys data.",
+		 function );
+
+		return( -1 );
+	}
+	for( sector_index = 0;
+	     sector_index < number_of_sectors;
+	     sector_index++ )
+	{
+		data_offset = (size_t) sector_index * 32;
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( block_keys_data[ data_offset ] ),
+		 block_key );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( block_keys_data[ data_offset + 16 ] ),
+		 block_key );
+
+		block_keys_data[ data_offset + 31 ] = 0x80;
+
+		block_key += block_key_increment;
+	}
+#if defined( HAVE_LIBBDE_AES_NI )
+	if( context->use_aes_ni != 0 )
+	{
+		result = libbde_aes_ni_crypt_ecb(
+		          &( context->tweak_aes_ni_context ),
+		          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		          block_keys_data,
+		          (size_t) number_of_sectors * 32,
+		          sector_keys,
+		          (size_t) number_of_sectors * 32,
+		          error );
+	}
+	else
+#endif
+	{
+		result = libcaes_crypt_ecb(
+		          context->tweak_encryption_context,
+		          LIBCAES_CRYPT_MODE_ENCRYPT,
+		          block_keys_data,
+		          (size_t) number_of_sectors * 32,
+		          sector_keys,
+		          (size_t) number_of_sectors * 32,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to encrypt sector keys.",
+		 function );
+
+		memory_set(
+		 sector_keys,
+		 0,
+		 (size_t) number_of_sectors * 32 );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* De- or encrypts consecutive sectors
+ * The block key is the block key of the first sector, the block key of each
+ * next sector is increased by the number of bytes per sector
+ * With XTS the block key is converted into the sector number, which is used as the tweak value
+ * The sectors are de- or encrypted by the functions that were selected for the method when the keys were set
+ * The input and output data can be the same buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_crypt_sectors(
+     libbde_encryption_context_t *context,
+     int mode,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     uint64_t block_key,
+     uint16_t bytes_per_sector,
+     libcerror_error_t **error )
+{
+	int (*crypt_sectors)(
+	       libbde_encryption_context_t *context,
+	       const uint8_t *input_data,
+	       uint8_t *output_data,
+	       size_t data_size,
+	       uint64_t block_key,
+	       uint16_t bytes_per_sector,
+	       uint8_t *sector_buffer,
+	       libcerror_error_t **error ) = NULL;
+
+	uint8_t *sector_buffer    = NULL;
+	static char *function     = "libbde_encryption_crypt_sectors";
+	size_t sector_buffer_size = 0;
+	int result                = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	{
+		crypt_sectors = context->decrypt_sectors;
+	}
+	else if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		crypt_sectors = context->encrypt_sectors;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( crypt_sectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid context - missing crypt sectors function, keys not set.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bytes per sector value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( input_data_size > (size_t) SSIZE_MAX )
+	 || ( ( input_data_size % bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid input data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* The sectors are de- or encrypted in-place by using a copy of each sector,
+	 * which is small enough to remain in the CPU cache
+	 */
+	if( input_data == output_data )
+	{
+		sector_buffer_size = (size_t) bytes_per_sector;
+	}
+#if defined( HAVE_LIBBDE_DIFFUSER_AVX2 )
+	/* The AVX2 diffuser keeps the values of a group of sectors after the copy
+	 * of the sector, so that these are not kept on the stack
+	 */
+	if( ( ( crypt_sectors == &libbde_encryption_decrypt_sectors_aes_cbc_diffuser_avx2 )
+	  ||  ( crypt_sectors == &libbde_encryption_encrypt_sectors_aes_cbc_diffuser_avx2 ) )
+	 && ( ( bytes_per_sector % 32 ) == 0 )
+	 && ( ( bytes_per_sector / 4 ) <= LIBBDE_DIFFUSER_MAXIMUM_NUMBER_OF_BUFFERED_VALUES ) )
+	{
+		sector_buffer_size = (size_t) bytes_per_sector
+		                   + LIBBDE_DIFFUSER_AVX2_VALUES_BUFFER_SIZE( bytes_per_sector );
+	}
+#endif
+	/* The sector buffer is kept in the context and only reallocated
+	 * when a larger sector size is used
+	 */
+	if( sector_buffer_size > context->sector_buffer_size )
+	{
+		if( context->sector_buffer != NULL )
+		{
+			memory_set(
+			 context->sector_buffer,
+			 0,
+			 context->sector_buffer_size );
+
+			memory_free(
+			 context->sector_buffer );
+
+			context->sector_buffer      = NULL;
+			context->sector_buffer_size = 0;
+		}
+		context->sector_buffer = (uint8_t *) memory_allocate(
+		                                      sizeof( uint8_t ) * sector_buffer_size );
+
+		if( context->sector_buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create sector buffer.",
+			 function );
+
+			return( -1 );
+		}
+		context->sector_buffer_size = sector_buffer_size;
+	}
+	if( sector_buffer_size > 0 )
+	{
+		sector_buffer = context->sector_buffer;
+	}
+	result = crypt_sectors(
+	          context,
+	          input_data,
+	          output_data,
+	          input_data_size,
+	          block_key,
+	          bytes_per_sector,
+	          sector_buffer,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to crypt sectors data.",
+		 function );
+
+		result = -1;
+	}
+	return( result );
+}
+
+/* De- or encrypts a single sector using a previously generated initialization vector and sector key
+ * The initialization vector is 16 bytes in size and the sector key 32 bytes
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_crypt_sector(
+     libbde_encryption_context_t *context,
+     int mode,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	int (*crypt_sector)(
+	       libbde_encryption_context_t *context,
+	       const uint8_t *initialization_vector,
+	       const uint8_t *sector_key_data,
+	       const uint8_t *input_data,
+	       uint8_t *output_data,
+	       size_t data_size,
+	       libcerror_error_t **error ) = NULL;
+
+	static char *function = "libbde_encryption_crypt_sector";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT )
+	{
+		crypt_sector = context->decrypt_sector;
+	}
+	else if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		crypt_sector = context->encrypt_sector;
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode.",
+		 function );
+
+		return( -1 );
+	}
+	if( crypt_sector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid context - missing crypt sector function, keys not set.",
+		 function );
+
+		return( -1 );
+	}
+	if( initialization_vector == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid initialization vector.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_key_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector key data.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input data.",
+		 function );
+
+		return( -1 );
+	}
+	if( output_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid output data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( output_data_size > (size_t) SSIZE_MAX )
+	 || ( output_data_size < input_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid output data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: initialization vector:\n",
+		 function );
+		libcnotify_print_data(
+		 initialization_vector,
+		 16,
+		 0 );
+	}
+#endif
+	if( crypt_sector(
+	     context,
+	     initialization_vector,
+	     sector_key_data,
+	     input_data,
+	     output_data,
+	     input_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to crypt sector data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* De- or encrypts data using AES-CBC with the FVEK
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_crypt_cbc(
+     libbde_encryption_context_t *context,
+     int mode,
+     const uint8_t *initialization_vector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_encryption_crypt_cbc";
+	int result            = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_NI )
+	if( context->use_aes_ni != 0 )
+	{
+		result = libbde_aes_ni_crypt_cbc(
+		          &( context->fvek_aes_ni_context ),
+		          mode,
+		          initialization_vector,
+		          16,
+		          input_data,
+		          input_data_size,
+		          output_data,
+		          output_data_size,
+		          error );
+	}
+	else
+#endif
+	if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		result = libcaes_crypt_cbc(
+		          context->fvek_encryption_context,
+		          LIBCAES_CRYPT_MODE_ENCRYPT,
+		          initialization_vector,
+		          16,
+		          input_data,
+		          input_data_size,
+		          output_data,
+		          output_data_size,
+		          error );
+	}
+	else
+	{
+		result = libcaes_crypt_cbc(
+		          context->fvek_decryption_context,
+		          LIBCAES_CRYPT_MODE_DECRYPT,
+		          initialization_vector,
+		          16,
+		          input_data,
+		          input_data_size,
+		          output_data,
+		          output_data_size,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to AES-CBC crypt data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* De- or encrypts a data unit using AES-XTS with the FVEK
+ * The tweak value is 16 bytes in size
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_crypt_xts(
+     libbde_encryption_context_t *context,
+     int mode,
+     const uint8_t *tweak_value,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_encryption_crypt_xts";
+	int result            = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_AES_NI )
+	if( ( context->use_aes_ni != 0 )
+	 && ( ( input_data_size % 16 ) == 0 ) )
+	{
+		result = libbde_aes_ni_crypt_xts(
+		          &( context->fvek_aes_ni_context ),
+		          &( context->tweak_aes_ni_context ),
+		          mode,
+		          tweak_value,
+		          16,
+		          input_data,
+		          input_data_size,
+		          output_data,
+		          output_data_size,
+		          error );
+	}
+	else
+#endif
+	if( mode == LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT )
+	{
+		result = libcaes_crypt_xts(
+		          context->fvek_encryption_tweaked_context,
+		          LIBCAES_CRYPT_MODE_ENCRYPT,
+		          tweak_value,
+		          16,
+		          input_data,
+		          input_data_size,
+		          output_data,
+		          output_data_size,
+		          error );
+	}
+	else
+	{
+		result = libcaes_crypt_xts(
+		          context->fvek_decryption_tweaked_context,
+		          LIBCAES_CRYPT_MODE_DECRYPT,
+		          tweak_value,
+		          16,
+		          input_data,
+		          input_data_size,
+		          output_data,
+		          output_data_size,
+		          error );
+	}
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+		 "%s: unable to AES-XTS crypt data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Decrypts a sector using AES-CBC
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_decrypt_sector_aes_cbc(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data LIBBDE_ATTRIBUTE_UNUSED,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	LIBBDE_UNREFERENCED_PARAMETER( sector_key_data )
+
+	return( libbde_encryption_crypt_cbc(
+	         context,
+	         LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	         initialization_vector,
+	         input_data,
+	         data_size,
+	         output_data,
+	         data_size,
+	         error ) );
+}
+
+/* Encrypts a sector using AES-CBC
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_encrypt_sector_aes_cbc(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data LIBBDE_ATTRIBUTE_UNUSED,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	LIBBDE_UNREFERENCED_PARAMETER( sector_key_data )
+
+	return( libbde_encryption_crypt_cbc(
+	         context,
+	         LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	         initialization_vector,
+	         input_data,
+	         data_size,
+	         output_data,
+	         data_size,
+	         error ) );
+}
+
+/* Decrypts a sector using AES-CBC with the Elephant diffuser
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_decrypt_sector_aes_cbc_diffuser(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_encryption_decrypt_sector_aes_cbc_diffuser";
+
+	if( libbde_encryption_crypt_cbc(
+	     context,
+	     LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	     initialization_vector,
+	     input_data,
+	     data_size,
+	     output_data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+		 "%s: unable to AES-CBC decrypt data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_diffuser_decrypt(
+	     output_data,
+	     data_size,
+	     sector_key_data,
+	     32,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+		 "%s: unable to decrypt data using Diffuser.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Encrypts a sector using AES-CBC with the Elephant diffuser
+ * The diffuser is applied to a copy of the input data in the output data,
+ * which is then AES-CBC encrypted in-place
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_encrypt_sector_aes_cbc_diffuser(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_encryption_encrypt_sector_aes_cbc_diffuser";
+
+	if( output_data != input_data )
+	{
+		if( memory_copy(
+		     output_data,
+		     input_data,
+		     data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy input data to output data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( libbde_diffuser_encrypt(
+	     output_data,
+	     data_size,
+	     sector_key_data,
+	     32,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_ENCRYPT_FAILED,
+		 "%s: unable to encrypt data using Diffuser.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_encryption_crypt_cbc(
+	     context,
+	     LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	     initialization_vector,
+	     output_data,
+	     data_size,
+	     output_data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_ENCRYPT_FAILED,
+		 "%s: unable to AES-CBC encrypt data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Decrypts a sector using AES-XTS
+ * The initialization vector contains the tweak value
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_decrypt_sector_aes_xts(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data LIBBDE_ATTRIBUTE_UNUSED,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	LIBBDE_UNREFERENCED_PARAMETER( sector_key_data )
+
+	return( libbde_encryption_crypt_xts(
+	         context,
+	         LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	         initialization_vector,
+	         input_data,
+	         data_size,
+	         output_data,
+	         data_size,
+	         error ) );
+}
+
+/* Encrypts a sector using AES-XTS
+ * The initialization vector contains the tweak value
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_encrypt_sector_aes_xts(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data LIBBDE_ATTRIBUTE_UNUSED,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	LIBBDE_UNREFERENCED_PARAMETER( sector_key_data )
+
+	return( libbde_encryption_crypt_xts(
+	         context,
+	         LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	         initialization_vector,
+	         input_data,
+	         data_size,
+	         output_data,
+	         data_size,
+	         error ) );
+}
+
+/* De- or encrypts consecutive sectors in batches
+ * The initialization vectors and sector keys are generated per batch by the generate
+ * function of the method, after which
+ * groups of sectors are de- or encrypted by the group function, if supported,
+ * and the remaining sectors by the sector function
+ * If the sector numbers are used as block keys, such as with XTS, the block key
+ * is converted into the sector number
+ * The sector buffer is used when the input and output data are the same buffer
+ * and by the AVX2 diffuser group functions
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_crypt_sectors_in_batches(
+     libbde_encryption_context_t *context,
+     int (*sector_function)(
+            libbde_encryption_context_t *context,
+            const uint8_t *initialization_vector,
+            const uint8_t *sector_key_data,
+            const uint8_t *input_data,
+            uint8_t *output_data,
+            size_t data_size,
+            libcerror_error_t **error ),
+     int (*group_function)(
+            libbde_encryption_context_t *context,
+            const uint8_t *initialization_vectors,
+            const uint8_t *sector_keys,
+            const uint8_t *input_data,
+            uint8_t *output_data,
+            uint16_t bytes_per_sector,
+            uint8_t *sector_buffer,
+            libcerror_error_t **error ),
+     int number_of_sectors_per_group,
+     int (*generate_function)(
+            libbde_encryption_context_t *context,
+            uint64_t block_key,
+            uint64_t block_key_increment,
+            int number_of_sectors,
+            uint8_t *initialization_vectors,
+            uint8_t *sector_keys,
+            libcerror_error_t **error ),
+     uint8_t use_sector_numbers,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t block_key,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error )
+{
+	uint8_t initialization_vectors[ LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 16 ];
+	uint8_t sector_keys[ LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 32 ];
+
+	const uint8_t *input_sector_data = NULL;
+	static char *function            = "libbde_encryption_crypt_sectors_in_batches";
+	size_t data_offset               = 0;
+	uint64_t block_key_increment     = 0;
+	int number_of_sectors            = 0;
+	int result                       = 0;
+	int sector_index                 = 0;
+
+	if( use_sector_numbers != 0 )
+	{
+		block_key          /= bytes_per_sector;
+		block_key_increment = 1;
+	}
+	else
+	{
+		block_key_increment = (uint64_t) bytes_per_sector;
+	}
+	while( data_offset < data_size )
+	{
+		number_of_sectors = (int) ( ( data_size - data_offset ) / bytes_per_sector );
+
+		if( number_of_sectors > LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS )
+		{
+			number_of_sectors = LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS;
 		}
-		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+		if( generate_function(
+		     context,
+		     block_key,
+		     block_key_increment,
+		     number_of_sectors,
+		     initialization_vectors,
+		     sector_keys,
+		     error ) != 1 )
 		{
-			if( libcaes_crypt_cbc(
-			     context->fvek_encryption_context,
-			     LIBCAES_CRYPT_MODE_ENCRYPT,
-			     initialization_vector,
-			     16,
-			     input_data,
-			     input_data_size,
-			     output_data,
-			     output_data_size,
-			     error ) != 1 )
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+			 "%s: unable to generate initialization vectors and sector keys.",
+			 function );
+
+			goto on_error;
+		}
+		sector_index = 0;
+
+		if( group_function != NULL )
+		{
+			while( ( number_of_sectors - sector_index ) >= number_of_sectors_per_group )
 			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-				 "%s: unable to AES-CBC encrypt output data.",
-				 function );
+				result = group_function(
+				          context,
+				          &( initialization_vectors[ sector_index * 16 ] ),
+				          &( sector_keys[ sector_index * 32 ] ),
+				          &( input_data[ data_offset ] ),
+				          &( output_data[ data_offset ] ),
+				          bytes_per_sector,
+				          sector_buffer,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+					 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+					 "%s: unable to crypt group of sectors data.",
+					 function );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					/* The group function does not support the sector size
+					 */
+					group_function = NULL;
 
-				return( -1 );
+					break;
+				}
+				data_offset  += (size_t) number_of_sectors_per_group * bytes_per_sector;
+				sector_index += number_of_sectors_per_group;
 			}
 		}
-		else if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
-		      || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
+		while( sector_index < number_of_sectors )
 		{
-			if( libcaes_crypt_xts(
-			     context->fvek_decryption_tweaked_context,
-			     LIBCAES_CRYPT_MODE_ENCRYPT,
-			     initialization_vector,
-			     16,
-			     input_data,
-			     input_data_size,
-			     output_data,
-			     output_data_size,
+			input_sector_data = &( input_data[ data_offset ] );
+
+			if( input_data == output_data )
+			{
+				if( memory_copy(
+				     sector_buffer,
+				     input_sector_data,
+				     bytes_per_sector ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy sector data.",
+					 function );
+
+					goto on_error;
+				}
+				input_sector_data = sector_buffer;
+			}
+			if( sector_function(
+			     context,
+			     &( initialization_vectors[ sector_index * 16 ] ),
+			     &( sector_keys[ sector_index * 32 ] ),
+			     input_sector_data,
+			     &( output_data[ data_offset ] ),
+			     (size_t) bytes_per_sector,
 			     error ) != 1 )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
 				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-				 "%s: unable to AES-XTS decrypt output data.",
+				 "%s: unable to crypt sector data.",
 				 function );
 
-				return( -1 );
+				goto on_error;
 			}
+			data_offset += bytes_per_sector;
+
+			sector_index++;
 		}
+		block_key += (uint64_t) number_of_sectors * block_key_increment;
 	}
-	else
+	memory_set(
+	 sector_keys,
+	 0,
+	 LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 32 );
+
+	return( 1 );
+
+on_error:
+	memory_set(
+	 sector_keys,
+	 0,
+	 LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 32 );
+
+	return( -1 );
+}
+
+/* Defines a function that de- or encrypts consecutive sectors of a specific method
+ * The sector, group and sector key generation functions are fixed per defined
+ * function, so the method is not tested again for every batch or sector
+ */
+#define LIBBDE_ENCRYPTION_CRYPT_SECTORS_FUNCTION( function_name, sector_function, group_function, number_of_sectors_per_group, generate_function, use_sector_numbers ) \
+int function_name( \
+     libbde_encryption_context_t *context, \
+     const uint8_t *input_data, \
+     uint8_t *output_data, \
+     size_t data_size, \
+     uint64_t block_key, \
+     uint16_t bytes_per_sector, \
+     uint8_t *sector_buffer, \
+     libcerror_error_t **error ) \
+{ \
+	return( libbde_encryption_crypt_sectors_in_batches( \
+	         context, \
+	         sector_function, \
+	         group_function, \
+	         number_of_sectors_per_group, \
+	         generate_function, \
+	         use_sector_numbers, \
+	         input_data, \
+	         output_data, \
+	         data_size, \
+	         block_key, \
+	         bytes_per_sector, \
+	         sector_buffer, \
+	         error ) ); \
+}
+
+LIBBDE_ENCRYPTION_CRYPT_SECTORS_FUNCTION(
+ libbde_encryption_decrypt_sectors_aes_cbc,
+ libbde_encryption_decrypt_sector_aes_cbc,
+ NULL,
+ 0,
+ libbde_encryption_generate_initialization_vectors,
+ 0 )
+
+LIBBDE_ENCRYPTION_CRYPT_SECTORS_FUNCTION(
+ libbde_encryption_encrypt_sectors_aes_cbc,
+ libbde_encryption_encrypt_sector_aes_cbc,
+ NULL,
+ 0,
+ libbde_encryption_generate_initialization_vectors,
+ 0 )
+
+LIBBDE_ENCRYPTION_CRYPT_SECTORS_FUNCTION(
+ libbde_encryption_decrypt_sectors_aes_cbc_diffuser,
+ libbde_encryption_decrypt_sector_aes_cbc_diffuser,
+ NULL,
+ 0,
+ libbde_encryption_generate_diffuser_sector_keys,
+ 0 )
+
+LIBBDE_ENCRYPTION_CRYPT_SECTORS_FUNCTION(
+ libbde_encryption_encrypt_sectors_aes_cbc_diffuser,
+ libbde_encryption_encrypt_sector_aes_cbc_diffuser,
+ NULL,
+ 0,
+ libbde_encryption_generate_diffuser_sector_keys,
+ 0 )
+
+LIBBDE_ENCRYPTION_CRYPT_SECTORS_FUNCTION(
+ libbde_encryption_decrypt_sectors_aes_xts,
+ libbde_encryption_decrypt_sector_aes_xts,
+ NULL,
+ 0,
+ libbde_encryption_generate_sector_numbers,
+ 1 )
+
+LIBBDE_ENCRYPTION_CRYPT_SECTORS_FUNCTION(
+ libbde_encryption_encrypt_sectors_aes_xts,
+ libbde_encryption_encrypt_sector_aes_xts,
+ NULL,
+ 0,
+ libbde_encryption_generate_sector_numbers,
+ 1 )
+
+#if defined( HAVE_LIBBDE_DIFFUSER_AVX2 )
+
+LIBBDE_ENCRYPTION_CRYPT_SECTORS_FUNCTION(
+ libbde_encryption_decrypt_sectors_aes_cbc_diffuser_avx2,
+ libbde_encryption_decrypt_sector_aes_cbc_diffuser,
+ libbde_encryption_decrypt_diffuser_sectors_avx2,
+ LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS,
+ libbde_encryption_generate_diffuser_sector_keys,
+ 0 )
+
+LIBBDE_ENCRYPTION_CRYPT_SECTORS_FUNCTION(
+ libbde_encryption_encrypt_sectors_aes_cbc_diffuser_avx2,
+ libbde_encryption_encrypt_sector_aes_cbc_diffuser,
+ libbde_encryption_encrypt_diffuser_sectors_avx2,
+ LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS,
+ libbde_encryption_generate_diffuser_sector_keys,
+ 0 )
+
+#endif /* defined( HAVE_LIBBDE_DIFFUSER_AVX2 ) */
+
+#if defined( HAVE_LIBBDE_DIFFUSER_AVX2 )
+
+/* Decrypts 8 consecutive sectors that use AES-CBC with the Elephant diffuser
+ * The AES-CBC decryption is done per sector, the diffuser decryption and
+ * the sector keys are applied to all 8 sectors at once using AVX2
+ * The sector buffer contains a copy of the sector, which is used when the input
+ * and output data are the same buffer, followed by the diffuser values buffer
+ * Returns 1 if successful, 0 if the sector size is not supported or -1 on error
+ */
+int libbde_encryption_decrypt_diffuser_sectors_avx2(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vectors,
+     const uint8_t *sector_keys,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error )
+{
+	const uint8_t *input_sector_data = NULL;
+	static char *function            = "libbde_encryption_decrypt_diffuser_sectors_avx2";
+	size_t data_offset               = 0;
+	int sector_index                 = 0;
+
+	if( context == NULL )
 	{
-		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( bytes_per_sector % 32 ) != 0 )
+	 || ( ( bytes_per_sector / 4 ) > LIBBDE_DIFFUSER_MAXIMUM_NUMBER_OF_BUFFERED_VALUES ) )
+	{
+		return( 0 );
+	}
+	if( sector_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector buffer.",
+		 function );
+
+		return( -1 );
+	}
+	for( sector_index = 0;
+	     sector_index < LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS;
+	     sector_index++ )
+	{
+		input_sector_data = &( input_data[ data_offset ] );
+
+		if( input_data == output_data )
 		{
-			if( libcaes_crypt_cbc(
-			     context->fvek_decryption_context,
-			     LIBCAES_CRYPT_MODE_DECRYPT,
-			     initialization_vector,
-			     16,
-			     input_data,
-			     input_data_size,
-			     output_data,
-			     output_data_size,
-			     error ) != 1 )
+			if( memory_copy(
+			     sector_buffer,
+			     input_sector_data,
+			     bytes_per_sector ) == NULL )
 			{
 				libcerror_error_set(
 				 error,
-				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-				 "%s: unable to AES-CBC decrypt output data.",
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy sector data.",
 				 function );
 
 				return( -1 );
 			}
+			input_sector_data = sector_buffer;
 		}
-		else if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
-		      || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
+		if( libbde_encryption_crypt_cbc(
+		     context,
+		     LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+		     &( initialization_vectors[ sector_index * 16 ] ),
+		     input_sector_data,
+		     bytes_per_sector,
+		     &( output_data[ data_offset ] ),
+		     bytes_per_sector,
+		     error ) != 1 )
 		{
-			if( libcaes_crypt_xts(
-			     context->fvek_decryption_tweaked_context,
-			     LIBCAES_CRYPT_MODE_DECRYPT,
-			     initialization_vector,
-			     16,
-			     input_data,
-			     input_data_size,
-			     output_data,
-			     output_data_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-				 "%s: unable to AES-XTS decrypt output data.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+			 "%s: unable to AES-CBC decrypt sector: %d data.",
+			 function,
+			 sector_index );
 
-				return( -1 );
-			}
+			return( -1 );
 		}
-		if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
-		 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+		data_offset += bytes_per_sector;
+	}
+	if( libbde_diffuser_avx2_decrypt_sectors(
+	     output_data,
+	     data_offset,
+	     (size_t) bytes_per_sector,
+	     sector_keys,
+	     32 * LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS,
+	     &( sector_buffer[ bytes_per_sector ] ),
+	     LIBBDE_DIFFUSER_AVX2_VALUES_BUFFER_SIZE( bytes_per_sector ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
+		 "%s: unable to decrypt data using Diffuser.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Encrypts 8 consecutive sectors that use AES-CBC with the Elephant diffuser
+ * The sector keys and the diffuser encryption are applied to all 8 sectors
+ * at once using AVX2, the AES-CBC encryption is done per sector in-place
+ * The sector buffer contains space for a copy of the sector, which is not
+ * used, followed by the diffuser values buffer
+ * Returns 1 if successful, 0 if the sector size is not supported or -1 on error
+ */
+int libbde_encryption_encrypt_diffuser_sectors_avx2(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vectors,
+     const uint8_t *sector_keys,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_encryption_encrypt_diffuser_sectors_avx2";
+	size_t data_offset    = 0;
+	size_t data_size      = 0;
+	int sector_index      = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( ( bytes_per_sector % 32 ) != 0 )
+	 || ( ( bytes_per_sector / 4 ) > LIBBDE_DIFFUSER_MAXIMUM_NUMBER_OF_BUFFERED_VALUES ) )
+	{
+		return( 0 );
+	}
+	if( sector_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector buffer.",
+		 function );
+
+		return( -1 );
+	}
+	data_size = (size_t) LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS * bytes_per_sector;
+
+	if( output_data != input_data )
+	{
+		if( memory_copy(
+		     output_data,
+		     input_data,
+		     data_size ) == NULL )
 		{
-			if( libbde_diffuser_decrypt(
-			     output_data,
-			     output_data_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-				 LIBCERROR_ENCRYPTION_ERROR_DECRYPT_FAILED,
-				 "%s: unable to decrypt data using Diffuser.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy input data to output data.",
+			 function );
 
-				return( -1 );
-			}
-			sector_key_data_index = 0;
+			return( -1 );
+		}
+	}
+	if( libbde_diffuser_avx2_encrypt_sectors(
+	     output_data,
+	     data_size,
+	     (size_t) bytes_per_sector,
+	     sector_keys,
+	     32 * LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS,
+	     &( sector_buffer[ bytes_per_sector ] ),
+	     LIBBDE_DIFFUSER_AVX2_VALUES_BUFFER_SIZE( bytes_per_sector ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+		 LIBCERROR_ENCRYPTION_ERROR_ENCRYPT_FAILED,
+		 "%s: unable to encrypt data using Diffuser.",
+		 function );
 
-			for( data_index = 0;
-			     data_index < input_data_size;
-			     data_index++ )
-			{
-				output_data[ data_index ] ^= sector_key_data[ sector_key_data_index ];
+		return( -1 );
+	}
+	for( sector_index = 0;
+	     sector_index < LIBBDE_DIFFUSER_AVX2_NUMBER_OF_SECTORS;
+	     sector_index++ )
+	{
+		if( libbde_encryption_crypt_cbc(
+		     context,
+		     LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		     &( initialization_vectors[ sector_index * 16 ] ),
+		     &( output_data[ data_offset ] ),
+		     bytes_per_sector,
+		     &( output_data[ data_offset ] ),
+		     bytes_per_sector,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+			 LIBCERROR_ENCRYPTION_ERROR_ENCRYPT_FAILED,
+			 "%s: unable to AES-CBC encrypt sector: %d data.",
+			 function,
+			 sector_index );
+
+			return( -1 );
+		}
+		data_offset += bytes_per_sector;
+	}
+	return( 1 );
+}
 
-				sector_key_data_index++;
+#endif /* defined( HAVE_LIBBDE_DIFFUSER_AVX2 ) */
 
-				if( sector_key_data_index >= 32 )
-				{
-					sector_key_data_index -= 32;
-				}
-			}
+
+#if defined( HAVE_LIBBDE_AES_NI )
+
+/* Decrypts consecutive sectors using AES-XTS with the AES-NI kernels
+ * The sector number of each sector is used as its tweak value
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_decrypt_sectors_aes_xts_aes_ni(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t block_key,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error )
+{
+	if( ( bytes_per_sector % 16 ) != 0 )
+	{
+		return( libbde_encryption_decrypt_sectors_aes_xts(
+		         context,
+		         input_data,
+		         output_data,
+		         data_size,
+		         block_key,
+		         bytes_per_sector,
+		         sector_buffer,
+		         error ) );
+	}
+	return( libbde_aes_ni_crypt_xts_sectors(
+	         &( context->fvek_aes_ni_context ),
+	         &( context->tweak_aes_ni_context ),
+	         LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	         block_key / bytes_per_sector,
+	         (size_t) bytes_per_sector,
+	         input_data,
+	         data_size,
+	         output_data,
+	         data_size,
+	         error ) );
+}
+
+/* Encrypts consecutive sectors using AES-XTS with the AES-NI kernels
+ * The sector number of each sector is used as its tweak value
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_encrypt_sectors_aes_xts_aes_ni(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t block_key,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error )
+{
+	if( ( bytes_per_sector % 16 ) != 0 )
+	{
+		return( libbde_encryption_encrypt_sectors_aes_xts(
+		         context,
+		         input_data,
+		         output_data,
+		         data_size,
+		         block_key,
+		         bytes_per_sector,
+		         sector_buffer,
+		         error ) );
+	}
+	return( libbde_aes_ni_crypt_xts_sectors(
+	         &( context->fvek_aes_ni_context ),
+	         &( context->tweak_aes_ni_context ),
+	         LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	         block_key / bytes_per_sector,
+	         (size_t) bytes_per_sector,
+	         input_data,
+	         data_size,
+	         output_data,
+	         data_size,
+	         error ) );
+}
+
+#endif /* defined( HAVE_LIBBDE_AES_NI ) */
+
+/* Sets the functions that de- and encrypt the sectors of the method
+ * The functions are selected once, after the keys are set, instead of testing
+ * the method for every sector
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_encryption_set_crypt_functions(
+     libbde_encryption_context_t *context,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_encryption_set_crypt_functions";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC )
+	 || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC ) )
+	{
+		context->generate_sector_keys = &libbde_encryption_generate_initialization_vectors;
+		context->decrypt_sector       = &libbde_encryption_decrypt_sector_aes_cbc;
+		context->encrypt_sector       = &libbde_encryption_encrypt_sector_aes_cbc;
+		context->decrypt_sectors      = &libbde_encryption_decrypt_sectors_aes_cbc;
+		context->encrypt_sectors      = &libbde_encryption_encrypt_sectors_aes_cbc;
+	}
+	else if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
+	      || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER ) )
+	{
+		context->generate_sector_keys = &libbde_encryption_generate_diffuser_sector_keys;
+		context->decrypt_sector       = &libbde_encryption_decrypt_sector_aes_cbc_diffuser;
+		context->encrypt_sector       = &libbde_encryption_encrypt_sector_aes_cbc_diffuser;
+		context->decrypt_sectors      = &libbde_encryption_decrypt_sectors_aes_cbc_diffuser;
+		context->encrypt_sectors      = &libbde_encryption_encrypt_sectors_aes_cbc_diffuser;
+
+#if defined( HAVE_LIBBDE_DIFFUSER_AVX2 )
+		if( context->use_diffuser_avx2 != 0 )
+		{
+			context->decrypt_sectors = &libbde_encryption_decrypt_sectors_aes_cbc_diffuser_avx2;
+			context->encrypt_sectors = &libbde_encryption_encrypt_sectors_aes_cbc_diffuser_avx2;
+		}
+#endif
+	}
+	else if( ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
+	      || ( context->method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
+	{
+		context->generate_sector_keys = &libbde_encryption_generate_sector_numbers;
+		context->decrypt_sector       = &libbde_encryption_decrypt_sector_aes_xts;
+		context->encrypt_sector       = &libbde_encryption_encrypt_sector_aes_xts;
+		context->decrypt_sectors      = &libbde_encryption_decrypt_sectors_aes_xts;
+		context->encrypt_sectors      = &libbde_encryption_encrypt_sectors_aes_xts;
+
+#if defined( HAVE_LIBBDE_AES_NI )
+		if( context->use_aes_ni != 0 )
+		{
+			context->decrypt_sectors = &libbde_encryption_decrypt_sectors_aes_xts_aes_ni;
+			context->encrypt_sectors = &libbde_encryption_encrypt_sectors_aes_xts_aes_ni;
 		}
+#endif
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported method.",
+		 function );
+
+		return( -1 );
 	}
 	return( 1 );
 }
@@ -25,6 +25,8 @@
 #include <common.h>
 #include <types.h>
 
+#include "libbde_aes_ni.h"
+#include "libbde_diffuser_avx2.h"
 #include "libbde_libcaes.h"
 #include "libbde_libcerror.h"
 
@@ -63,6 +65,93 @@ struct libbde_encryption_context
 	/* The FVEK (AES) encryption tweaked context
 	 */
 	libcaes_tweaked_context_t *fvek_encryption_tweaked_context;
+
+#if defined( HAVE_LIBBDE_AES_NI )
+	/* Value to indicate the AES-NI kernels are used
+	 */
+	int use_aes_ni;
+
+	/* The FVEK AES-NI context
+	 * with XTS this contains the first half of the FVEK
+	 */
+	libbde_aes_ni_context_t fvek_aes_ni_context;
+
+	/* The TWEAK key AES-NI context
+	 * with XTS this contains the second half of the FVEK
+	 */
+	libbde_aes_ni_context_t tweak_aes_ni_context;
+#endif
+
+#if defined( HAVE_LIBBDE_DIFFUSER_AVX2 )
+	/* Value to indicate the AVX2 diffuser is used
+	 */
+	int use_diffuser_avx2;
+#endif
+
+	/* The sector buffer used to de- or encrypt consecutive sectors
+	 */
+	uint8_t *sector_buffer;
+
+	/* The sector buffer size
+	 */
+	size_t sector_buffer_size;
+
+	/* The function to generate the initialization vectors and sector keys of consecutive sectors
+	 */
+	int (*generate_sector_keys)(
+	       libbde_encryption_context_t *context,
+	       uint64_t block_key,
+	       uint64_t block_key_increment,
+	       int number_of_sectors,
+	       uint8_t *initialization_vectors,
+	       uint8_t *sector_keys,
+	       libcerror_error_t **error );
+
+	/* The function to decrypt a single sector
+	 */
+	int (*decrypt_sector)(
+	       libbde_encryption_context_t *context,
+	       const uint8_t *initialization_vector,
+	       const uint8_t *sector_key_data,
+	       const uint8_t *input_data,
+	       uint8_t *output_data,
+	       size_t data_size,
+	       libcerror_error_t **error );
+
+	/* The function to encrypt a single sector
+	 */
+	int (*encrypt_sector)(
+	       libbde_encryption_context_t *context,
+	       const uint8_t *initialization_vector,
+	       const uint8_t *sector_key_data,
+	       const uint8_t *input_data,
+	       uint8_t *output_data,
+	       size_t data_size,
+	       libcerror_error_t **error );
+
+	/* The function to decrypt consecutive sectors
+	 */
+	int (*decrypt_sectors)(
+	       libbde_encryption_context_t *context,
+	       const uint8_t *input_data,
+	       uint8_t *output_data,
+	       size_t data_size,
+	       uint64_t block_key,
+	       uint16_t bytes_per_sector,
+	       uint8_t *sector_buffer,
+	       libcerror_error_t **error );
+
+	/* The function to encrypt consecutive sectors
+	 */
+	int (*encrypt_sectors)(
+	       libbde_encryption_context_t *context,
+	       const uint8_t *input_data,
+	       uint8_t *output_data,
+	       size_t data_size,
+	       uint64_t block_key,
+	       uint16_t bytes_per_sector,
+	       uint8_t *sector_buffer,
+	       libcerror_error_t **error );
 };
 
 int libbde_encryption_initialize(
@@ -82,7 +171,45 @@ int libbde_encryption_set_keys(
      size_t tweak_key_size,
      libcerror_error_t **error );
 
-int libbde_encryption_crypt(
+int libbde_encryption_generate_sector_keys(
+     libbde_encryption_context_t *context,
+     uint64_t block_key,
+     uint64_t block_key_increment,
+     int number_of_sectors,
+     uint8_t *initialization_vectors,
+     size_t initialization_vectors_size,
+     uint8_t *sector_keys,
+     size_t sector_keys_size,
+     libcerror_error_t **error );
+
+int libbde_encryption_generate_sector_numbers(
+     libbde_encryption_context_t *context,
+     uint64_t block_key,
+     uint64_t block_key_increment,
+     int number_of_sectors,
+     uint8_t *initialization_vectors,
+     uint8_t *sector_keys,
+     libcerror_error_t **error );
+
+int libbde_encryption_generate_initialization_vectors(
+     libbde_encryption_context_t *context,
+     uint64_t block_key,
+     uint64_t block_key_increment,
+     int number_of_sectors,
+     uint8_t *initialization_vectors,
+     uint8_t *sector_keys,
+     libcerror_error_t **error );
+
+int libbde_encryption_generate_diffuser_sector_keys(
+     libbde_encryption_context_t *context,
+     uint64_t block_key,
+     uint64_t block_key_increment,
+     int number_of_sectors,
+     uint8_t *initialization_vectors,
+     uint8_t *sector_keys,
+     libcerror_error_t **error );
+
+int libbde_encryption_crypt_sectors(
      libbde_encryption_context_t *context,
      int mode,
      const uint8_t *input_data,
@@ -90,6 +217,261 @@ int libbde_encryption_crypt(
      uint8_t *output_data,
      size_t output_data_size,
      uint64_t block_key,
+     uint16_t bytes_per_sector,
+     libcerror_error_t **error );
+
+int libbde_encryption_crypt_sector(
+     libbde_encryption_context_t *context,
+     int mode,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_encryption_crypt_cbc(
+     libbde_encryption_context_t *context,
+     int mode,
+     const uint8_t *initialization_vector,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_encryption_crypt_xts(
+     libbde_encryption_context_t *context,
+     int mode,
+     const uint8_t *tweak_value,
+     const uint8_t *input_data,
+     size_t input_data_size,
+     uint8_t *output_data,
+     size_t output_data_size,
+     libcerror_error_t **error );
+
+int libbde_encryption_decrypt_sector_aes_cbc(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libbde_encryption_encrypt_sector_aes_cbc(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libbde_encryption_decrypt_sector_aes_cbc_diffuser(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libbde_encryption_encrypt_sector_aes_cbc_diffuser(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libbde_encryption_decrypt_sector_aes_xts(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libbde_encryption_encrypt_sector_aes_xts(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vector,
+     const uint8_t *sector_key_data,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libbde_encryption_crypt_sectors_in_batches(
+     libbde_encryption_context_t *context,
+     int (*sector_function)(
+            libbde_encryption_context_t *context,
+            const uint8_t *initialization_vector,
+            const uint8_t *sector_key_data,
+            const uint8_t *input_data,
+            uint8_t *output_data,
+            size_t data_size,
+            libcerror_error_t **error ),
+     int (*group_function)(
+            libbde_encryption_context_t *context,
+            const uint8_t *initialization_vectors,
+            const uint8_t *sector_keys,
+            const uint8_t *input_data,
+            uint8_t *output_data,
+            uint16_t bytes_per_sector,
+            uint8_t *sector_buffer,
+            libcerror_error_t **error ),
+     int number_of_sectors_per_group,
+     int (*generate_function)(
+            libbde_encryption_context_t *context,
+            uint64_t block_key,
+            uint64_t block_key_increment,
+            int number_of_sectors,
+            uint8_t *initialization_vectors,
+            uint8_t *sector_keys,
+            libcerror_error_t **error ),
+     uint8_t use_sector_numbers,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t block_key,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error );
+
+int libbde_encryption_decrypt_sectors_aes_cbc(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t block_key,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error );
+
+int libbde_encryption_encrypt_sectors_aes_cbc(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t block_key,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error );
+
+int libbde_encryption_decrypt_sectors_aes_cbc_diffuser(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t block_key,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error );
+
+int libbde_encryption_encrypt_sectors_aes_cbc_diffuser(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t block_key,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error );
+
+int libbde_encryption_decrypt_sectors_aes_xts(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t block_key,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error );
+
+int libbde_encryption_encrypt_sectors_aes_xts(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t block_key,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBBDE_DIFFUSER_AVX2 )
+
+int libbde_encryption_decrypt_sectors_aes_cbc_diffuser_avx2(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t block_key,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error );
+
+int libbde_encryption_encrypt_sectors_aes_cbc_diffuser_avx2(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t block_key,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error );
+
+int libbde_encryption_decrypt_diffuser_sectors_avx2(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vectors,
+     const uint8_t *sector_keys,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error );
+
+int libbde_encryption_encrypt_diffuser_sectors_avx2(
+     libbde_encryption_context_t *context,
+     const uint8_t *initialization_vectors,
+     const uint8_t *sector_keys,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBBDE_DIFFUSER_AVX2 ) */
+
+#if defined( HAVE_LIBBDE_AES_NI )
+
+int libbde_encryption_decrypt_sectors_aes_xts_aes_ni(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t block_key,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error );
+
+int libbde_encryption_encrypt_sectors_aes_xts_aes_ni(
+     libbde_encryption_context_t *context,
+     const uint8_t *input_data,
+     uint8_t *output_data,
+     size_t data_size,
+     uint64_t block_key,
+     uint16_t bytes_per_sector,
+     uint8_t *sector_buffer,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_LIBBDE_AES_NI ) */
+
+int libbde_encryption_set_crypt_functions(
+     libbde_encryption_context_t *context,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
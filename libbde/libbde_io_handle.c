@@ -31,11 +31,10 @@
 #include "libbde_libbfio.h"
 #include "libbde_libcerror.h"
 #include "libbde_libcnotify.h"
-#include "libbde_libfcache.h"
-#include "libbde_libfdata.h"
+#include "libbde_libcthreads.h"
 #include "libbde_libfguid.h"
+#include "libbde_region_table.h"
 #include "libbde_sector_data.h"
-#include "libbde_unused.h"
 
 #include "bde_volume.h"
 
@@ -56,6 +55,10 @@ int libbde_io_handle_initialize(
 {
 	static char *function = "libbde_io_handle_initialize";
 
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	int context_index     = 0;
+#endif
+
 	if( io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -92,27 +95,82 @@ int libbde_io_handle_initialize(
 
 		goto on_error;
 	}
-	if( memory_set(
+	if( libbde_io_handle_initialize_header_values(
 	     *io_handle,
-	     0,
-	     sizeof( libbde_io_handle_t ) ) == NULL )
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize IO handle header values.",
+		 function );
+
+		memory_free(
+		 *io_handle );
+
+		*io_handle = NULL;
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *io_handle )->file_io_mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO mutex.",
 		 function );
 
 		goto on_error;
 	}
-	( *io_handle )->bytes_per_sector = 512;
+	for( context_index = 0;
+	     context_index < LIBBDE_NUMBER_OF_CONCURRENT_ENCRYPTION_CONTEXTS;
+	     context_index++ )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( ( *io_handle )->concurrent_encryption_context_mutexes[ context_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize encryption context: %d mutex.",
+			 function,
+			 context_index );
 
+			goto on_error;
+		}
+	}
+#endif
 	return( 1 );
 
 on_error:
 	if( *io_handle != NULL )
 	{
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		for( context_index = 0;
+		     context_index < LIBBDE_NUMBER_OF_CONCURRENT_ENCRYPTION_CONTEXTS;
+		     context_index++ )
+		{
+			if( ( *io_handle )->concurrent_encryption_context_mutexes[ context_index ] != NULL )
+			{
+				libcthreads_mutex_free(
+				 &( ( *io_handle )->concurrent_encryption_context_mutexes[ context_index ] ),
+				 NULL );
+			}
+		}
+		if( ( *io_handle )->file_io_mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *io_handle )->file_io_mutex ),
+			 NULL );
+		}
+#endif
 		memory_free(
 		 *io_handle );
 
@@ -121,6 +179,49 @@ on_error:
 	return( -1 );
 }
 
+/* Initializes the header values of an IO handle that is not created by
+ * libbde_io_handle_initialize, such as an IO handle on the stack
+ * Such an IO handle only contains the values read from the volume header and
+ * the metadata, it has no mutexes or encryption contexts and is not freed
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_io_handle_initialize_header_values(
+     libbde_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_io_handle_initialize_header_values";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     io_handle,
+	     0,
+	     sizeof( libbde_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	io_handle->bytes_per_sector = 512;
+	io_handle->block_size       = LIBBDE_DEFAULT_BLOCK_SIZE;
+
+	return( 1 );
+}
+
 /* Frees an IO handle
  * Returns 1 if successful or -1 on error
  */
@@ -131,6 +232,10 @@ int libbde_io_handle_free(
 	static char *function = "libbde_io_handle_free";
 	int result            = 1;
 
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	int context_index     = 0;
+#endif
+
 	if( io_handle == NULL )
 	{
 		libcerror_error_set(
@@ -157,6 +262,40 @@ int libbde_io_handle_free(
 
 			result = -1;
 		}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		for( context_index = 0;
+		     context_index < LIBBDE_NUMBER_OF_CONCURRENT_ENCRYPTION_CONTEXTS;
+		     context_index++ )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *io_handle )->concurrent_encryption_context_mutexes[ context_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free encryption context: %d mutex.",
+				 function,
+				 context_index );
+
+				result = -1;
+			}
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *io_handle )->file_io_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
 		memory_free(
 		 *io_handle );
 
@@ -175,64 +314,409 @@ int libbde_io_handle_clear(
 	static char *function = "libbde_io_handle_clear";
 	int result            = 1;
 
-	if( io_handle == NULL )
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	int context_index     = 0;
+#endif
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->encryption_context != NULL )
+	{
+		if( libbde_encryption_free(
+		     &( io_handle->encryption_context ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free encryption context.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	for( context_index = 0;
+	     context_index < LIBBDE_NUMBER_OF_CONCURRENT_ENCRYPTION_CONTEXTS;
+	     context_index++ )
+	{
+		if( io_handle->concurrent_encryption_contexts[ context_index ] != NULL )
+		{
+			if( libbde_encryption_free(
+			     &( io_handle->concurrent_encryption_contexts[ context_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free encryption context: %d.",
+				 function,
+				 context_index );
+
+				result = -1;
+			}
+		}
+	}
+#endif
+	if( memory_set(
+	     io_handle->full_volume_encryption_key,
+	     0,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear full volume encryption key.",
+		 function );
+
+		result = -1;
+	}
+	if( memory_set(
+	     io_handle->tweak_key,
+	     0,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear tweak key.",
+		 function );
+
+		result = -1;
+	}
+	if( libbde_region_table_clear(
+	     &( io_handle->region_table ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear region table.",
+		 function );
+
+		result = -1;
+	}
+	io_handle->bytes_per_sector = 512;
+
+	return( result );
+}
+
+/* Sets the encryption keys
+ * This creates the encryption context and the encryption contexts used by concurrent readers
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_io_handle_set_encryption_keys(
+     libbde_io_handle_t *io_handle,
+     uint16_t encryption_method,
+     const uint8_t *full_volume_encryption_key,
+     size_t full_volume_encryption_key_size,
+     const uint8_t *tweak_key,
+     size_t tweak_key_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_io_handle_set_encryption_keys";
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	int context_index     = 0;
+#endif
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->encryption_context != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid IO handle - encryption context value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_encryption_initialize(
+	     &( io_handle->encryption_context ),
+	     encryption_method,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_encryption_set_keys(
+	     io_handle->encryption_context,
+	     full_volume_encryption_key,
+	     full_volume_encryption_key_size,
+	     tweak_key,
+	     tweak_key_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set keys in encryption context.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	/* The AES contexts cannot be shared between threads, hence every
+	 * concurrent reader uses an encryption context of its own
+	 */
+	for( context_index = 0;
+	     context_index < LIBBDE_NUMBER_OF_CONCURRENT_ENCRYPTION_CONTEXTS;
+	     context_index++ )
+	{
+		if( libbde_encryption_initialize(
+		     &( io_handle->concurrent_encryption_contexts[ context_index ] ),
+		     encryption_method,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create encryption context: %d.",
+			 function,
+			 context_index );
+
+			goto on_error;
+		}
+		if( libbde_encryption_set_keys(
+		     io_handle->concurrent_encryption_contexts[ context_index ],
+		     full_volume_encryption_key,
+		     full_volume_encryption_key_size,
+		     tweak_key,
+		     tweak_key_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set keys in encryption context: %d.",
+			 function,
+			 context_index );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	for( context_index = 0;
+	     context_index < LIBBDE_NUMBER_OF_CONCURRENT_ENCRYPTION_CONTEXTS;
+	     context_index++ )
+	{
+		if( io_handle->concurrent_encryption_contexts[ context_index ] != NULL )
+		{
+			libbde_encryption_free(
+			 &( io_handle->concurrent_encryption_contexts[ context_index ] ),
+			 NULL );
+		}
+	}
+#endif
+	if( io_handle->encryption_context != NULL )
+	{
+		libbde_encryption_free(
+		 &( io_handle->encryption_context ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Grabs an encryption context for a concurrent reader
+ * The encryption context must be released with libbde_io_handle_release_encryption_context
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_io_handle_grab_encryption_context(
+     libbde_io_handle_t *io_handle,
+     int *context_index,
+     libbde_encryption_context_t **encryption_context,
+     libcerror_error_t **error )
+{
+	static char *function        = "libbde_io_handle_grab_encryption_context";
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	int concurrent_context_index = 0;
+	int result                   = 0;
+#endif
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( context_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context index.",
+		 function );
+
+		return( -1 );
+	}
+	if( encryption_context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encryption context.",
+		 function );
+
+		return( -1 );
+	}
+	*context_index      = -1;
+	*encryption_context = io_handle->encryption_context;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( io_handle->concurrent_encryption_contexts[ 0 ] == NULL )
+	{
+		return( 1 );
+	}
+	for( concurrent_context_index = 0;
+	     concurrent_context_index < LIBBDE_NUMBER_OF_CONCURRENT_ENCRYPTION_CONTEXTS;
+	     concurrent_context_index++ )
+	{
+		result = libcthreads_mutex_try_grab(
+		          io_handle->concurrent_encryption_context_mutexes[ concurrent_context_index ],
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to try to grab encryption context: %d mutex.",
+			 function,
+			 concurrent_context_index );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			break;
+		}
+	}
+	/* If all encryption contexts are in use wait for the first one
+	 */
+	if( concurrent_context_index >= LIBBDE_NUMBER_OF_CONCURRENT_ENCRYPTION_CONTEXTS )
+	{
+		concurrent_context_index = 0;
+
+		if( libcthreads_mutex_grab(
+		     io_handle->concurrent_encryption_context_mutexes[ concurrent_context_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab encryption context: %d mutex.",
+			 function,
+			 concurrent_context_index );
+
+			return( -1 );
+		}
+	}
+	*context_index      = concurrent_context_index;
+	*encryption_context = io_handle->concurrent_encryption_contexts[ concurrent_context_index ];
+#endif
+	return( 1 );
+}
+
+/* Releases an encryption context grabbed by a concurrent reader
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_io_handle_release_encryption_context(
+     libbde_io_handle_t *io_handle,
+     int context_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_io_handle_release_encryption_context";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( context_index >= LIBBDE_NUMBER_OF_CONCURRENT_ENCRYPTION_CONTEXTS )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid context index value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( io_handle->encryption_context != NULL )
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( context_index >= 0 )
 	{
-		if( libbde_encryption_free(
-		     &( io_handle->encryption_context ),
+		if( libcthreads_mutex_release(
+		     io_handle->concurrent_encryption_context_mutexes[ context_index ],
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free encryption context.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release encryption context: %d mutex.",
+			 function,
+			 context_index );
 
-			result = -1;
+			return( -1 );
 		}
 	}
-	if( memory_set(
-	     io_handle->full_volume_encryption_key,
-	     0,
-	     32 ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear full volume encryption key.",
-		 function );
-
-		result = -1;
-	}
-	if( memory_set(
-	     io_handle->tweak_key,
-	     0,
-	     32 ) == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear tweak key.",
-		 function );
-
-		result = -1;
-	}
-	io_handle->bytes_per_sector = 512;
-
-	return( result );
+#endif
+	return( 1 );
 }
 
 /* Reads the volume header
@@ -935,106 +1419,6 @@ on_error:
 	return( -1 );
 }
 
-/* Reads a sector
- * Callback function for the volume vector
- * Returns 1 if successful or -1 on error
- */
-int libbde_io_handle_read_sector(
-     libbde_io_handle_t *io_handle,
-     libbfio_handle_t *file_io_handle,
-     libfdata_vector_t *vector,
-     libfcache_cache_t *cache,
-     int element_index,
-     int element_data_file_index LIBBDE_ATTRIBUTE_UNUSED,
-     off64_t element_data_offset,
-     size64_t element_data_size LIBBDE_ATTRIBUTE_UNUSED,
-     uint32_t element_data_flags LIBBDE_ATTRIBUTE_UNUSED,
-     uint8_t read_flags LIBBDE_ATTRIBUTE_UNUSED,
-     libcerror_error_t **error )
-{
-	libbde_sector_data_t *sector_data = NULL;
-	static char *function             = "libbde_io_handle_read_sector";
-
-	LIBBDE_UNREFERENCED_PARAMETER( element_data_file_index );
-	LIBBDE_UNREFERENCED_PARAMETER( element_data_size );
-	LIBBDE_UNREFERENCED_PARAMETER( element_data_flags );
-	LIBBDE_UNREFERENCED_PARAMETER( read_flags );
-
-	if( io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
-		 function );
-
-		return( -1 );
-	}
-/* TODO handle virtual sectors, what about different sector sizes? */
-	if( libbde_sector_data_initialize(
-	     &sector_data,
-	     (size_t) io_handle->bytes_per_sector,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create sector data.",
-		 function );
-
-		goto on_error;
-	}
-	if( libbde_sector_data_read(
-	     sector_data,
-	     io_handle,
-	     file_io_handle,
-	     element_data_offset,
-	     io_handle->encryption_context,
-	     1,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read sector data.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfdata_vector_set_element_value_by_index(
-	     vector,
-	     (intptr_t *) file_io_handle,
-	     cache,
-	     element_index,
-	     (intptr_t *) sector_data,
-	     (int (*)(intptr_t **, libcerror_error_t **)) &libbde_sector_data_free,
-	     LIBFDATA_LIST_ELEMENT_VALUE_FLAG_MANAGED,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set sector data as element value.",
-		 function );
-
-		return( -1 );
-	}
-	return( 1 );
-
-on_error:
-	if( sector_data != NULL )
-	{
-		libbde_sector_data_free(
-		 &sector_data,
-		 NULL );
-	}
-	return( -1 );
-}
-
 /* Reads the unencrypted volume header
  * Returns 1 if successful or -1 on error
  */
@@ -1185,3 +1569,243 @@ on_error:
 	return( -1 );
 }
 
+/* Determines the regions of a range of the volume
+ * A region is a run of sectors of the same sector type of which the data is stored consecutively
+ * The sector type only changes at the start or end of the metadata areas, the stored volume header,
+ * the unencrypted part of the volume and the sectors that are stored at another offset,
+ * hence the sectors only need to be classified once for every range between these boundaries
+ * The boundaries are rounded up to a multiple of the bytes per sector relative to the range offset
+ * since a sector is classified by its offset
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_io_handle_get_region_table(
+     libbde_io_handle_t *io_handle,
+     off64_t range_offset,
+     size64_t range_size,
+     uint8_t zero_metadata,
+     libbde_region_table_t *region_table,
+     libcerror_error_t **error )
+{
+	off64_t boundaries[ 12 ];
+
+	static char *function    = "libbde_io_handle_get_region_table";
+	off64_t boundary         = 0;
+	off64_t data_offset      = 0;
+	off64_t next_offset      = 0;
+	off64_t offset           = 0;
+	off64_t range_end        = 0;
+	uint8_t sector_type      = 0;
+	int boundary_index       = 0;
+	int number_of_boundaries = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size > (size64_t) ( INT64_MAX - range_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid range size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_region_table_clear(
+	     region_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear region table.",
+		 function );
+
+		return( -1 );
+	}
+	if( zero_metadata != 0 )
+	{
+		boundaries[ number_of_boundaries++ ] = io_handle->first_metadata_offset;
+		boundaries[ number_of_boundaries++ ] = io_handle->first_metadata_offset + (off64_t) io_handle->metadata_size;
+		boundaries[ number_of_boundaries++ ] = io_handle->second_metadata_offset;
+		boundaries[ number_of_boundaries++ ] = io_handle->second_metadata_offset + (off64_t) io_handle->metadata_size;
+		boundaries[ number_of_boundaries++ ] = io_handle->third_metadata_offset;
+		boundaries[ number_of_boundaries++ ] = io_handle->third_metadata_offset + (off64_t) io_handle->metadata_size;
+	}
+	if( ( io_handle->version == LIBBDE_VERSION_WINDOWS_7 )
+	 || ( io_handle->version == LIBBDE_VERSION_TO_GO ) )
+	{
+		if( zero_metadata != 0 )
+		{
+			boundaries[ number_of_boundaries++ ] = io_handle->volume_header_offset;
+			boundaries[ number_of_boundaries++ ] = io_handle->volume_header_offset + (off64_t) io_handle->volume_header_size;
+		}
+		/* The first sectors are stored at the volume header offset
+		 * and can cross the end of the encrypted part of the volume
+		 */
+		boundaries[ number_of_boundaries++ ] = (off64_t) io_handle->volume_header_size;
+		boundaries[ number_of_boundaries++ ] = (off64_t) io_handle->encrypted_volume_size - io_handle->volume_header_offset;
+	}
+	else if( io_handle->version == LIBBDE_VERSION_WINDOWS_VISTA )
+	{
+		boundaries[ number_of_boundaries++ ] = 8192;
+	}
+	boundaries[ number_of_boundaries++ ] = (off64_t) io_handle->encrypted_volume_size;
+
+	offset    = range_offset;
+	range_end = range_offset + (off64_t) range_size;
+
+	while( offset < range_end )
+	{
+		if( libbde_sector_data_get_sector_type(
+		     io_handle,
+		     offset,
+		     zero_metadata,
+		     &data_offset,
+		     &sector_type,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine sector type at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		next_offset = range_end;
+
+		for( boundary_index = 0;
+		     boundary_index < number_of_boundaries;
+		     boundary_index++ )
+		{
+			boundary = boundaries[ boundary_index ];
+
+			if( ( boundary <= offset )
+			 || ( boundary >= next_offset ) )
+			{
+				continue;
+			}
+			boundary -= range_offset;
+
+			if( ( boundary % io_handle->bytes_per_sector ) != 0 )
+			{
+				boundary = ( ( boundary / io_handle->bytes_per_sector ) + 1 ) * io_handle->bytes_per_sector;
+			}
+			boundary += range_offset;
+
+			if( boundary < next_offset )
+			{
+				next_offset = boundary;
+			}
+		}
+		if( libbde_region_table_append_region(
+		     region_table,
+		     offset,
+		     (size64_t) ( next_offset - offset ),
+		     data_offset,
+		     sector_type,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append region at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		offset = next_offset;
+	}
+	return( 1 );
+}
+
+/* Initializes the region table of the volume
+ * This requires the layout of the volume to be known, which is after the volume was unlocked
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_io_handle_initialize_region_table(
+     libbde_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_io_handle_initialize_region_table";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_io_handle_get_region_table(
+	     io_handle,
+	     0,
+	     io_handle->volume_size,
+	     1,
+	     &( io_handle->region_table ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine region table.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: number of regions\t\t\t\t: %d\n",
+		 function,
+		 io_handle->region_table.number_of_regions );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	return( 1 );
+}
+
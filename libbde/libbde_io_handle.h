@@ -25,11 +25,12 @@
 #include <common.h>
 #include <types.h>
 
+#include "libbde_definitions.h"
 #include "libbde_encryption.h"
 #include "libbde_libbfio.h"
 #include "libbde_libcerror.h"
-#include "libbde_libfcache.h"
-#include "libbde_libfdata.h"
+#include "libbde_libcthreads.h"
+#include "libbde_region_table.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -57,6 +58,11 @@ struct libbde_io_handle
 	 */
 	uint8_t sectors_per_cluster_block;
 
+	/* The block size
+	 * The number of bytes that are read and decrypted as a single unit
+	 */
+	size_t block_size;
+
 	/* The first metadata offset
 	 */
 	off64_t first_metadata_offset;
@@ -99,10 +105,29 @@ struct libbde_io_handle
 	 */
 	size64_t volume_header_size;
 
+	/* The region table, which contains the layout of the volume
+	 * The region table is empty until the volume is unlocked
+	 */
+	libbde_region_table_t region_table;
+
 	/* The encryption context
 	 */
 	libbde_encryption_context_t *encryption_context;
 
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	/* The encryption contexts used by concurrent readers
+	 */
+	libbde_encryption_context_t *concurrent_encryption_contexts[ LIBBDE_NUMBER_OF_CONCURRENT_ENCRYPTION_CONTEXTS ];
+
+	/* The mutexes that guard the encryption contexts used by concurrent readers
+	 */
+	libcthreads_mutex_t *concurrent_encryption_context_mutexes[ LIBBDE_NUMBER_OF_CONCURRENT_ENCRYPTION_CONTEXTS ];
+
+	/* The mutex that guards seeking and reading the file IO handle
+	 */
+	libcthreads_mutex_t *file_io_mutex;
+#endif
+
 	/* External provided full volume encryption key
 	 */
 	uint8_t full_volume_encryption_key[ 32 ];
@@ -132,6 +157,10 @@ int libbde_io_handle_initialize(
      libbde_io_handle_t **io_handle,
      libcerror_error_t **error );
 
+int libbde_io_handle_initialize_header_values(
+     libbde_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
 int libbde_io_handle_free(
      libbde_io_handle_t **io_handle,
      libcerror_error_t **error );
@@ -140,28 +169,47 @@ int libbde_io_handle_clear(
      libbde_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+int libbde_io_handle_set_encryption_keys(
+     libbde_io_handle_t *io_handle,
+     uint16_t encryption_method,
+     const uint8_t *full_volume_encryption_key,
+     size_t full_volume_encryption_key_size,
+     const uint8_t *tweak_key,
+     size_t tweak_key_size,
+     libcerror_error_t **error );
+
+int libbde_io_handle_grab_encryption_context(
+     libbde_io_handle_t *io_handle,
+     int *context_index,
+     libbde_encryption_context_t **encryption_context,
+     libcerror_error_t **error );
+
+int libbde_io_handle_release_encryption_context(
+     libbde_io_handle_t *io_handle,
+     int context_index,
+     libcerror_error_t **error );
+
 int libbde_io_handle_read_volume_header(
      libbde_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t file_offset,
      libcerror_error_t **error );
 
-int libbde_io_handle_read_sector(
+int libbde_io_handle_read_unencrypted_volume_header(
      libbde_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
-     libfdata_vector_t *vector,
-     libfcache_cache_t *cache,
-     int element_index,
-     int element_data_file_index,
-     off64_t element_data_offset,
-     size64_t element_data_size,
-     uint32_t element_data_flags,
-     uint8_t read_flags,
      libcerror_error_t **error );
 
-int libbde_io_handle_read_unencrypted_volume_header(
+int libbde_io_handle_get_region_table(
+     libbde_io_handle_t *io_handle,
+     off64_t range_offset,
+     size64_t range_size,
+     uint8_t zero_metadata,
+     libbde_region_table_t *region_table,
+     libcerror_error_t **error );
+
+int libbde_io_handle_initialize_region_table(
      libbde_io_handle_t *io_handle,
-     libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
 #if defined( __cplusplus )
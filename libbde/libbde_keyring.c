@@ -0,0 +1,811 @@
+/*
+ * Keyring functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_definitions.h"
+#include "libbde_keyring.h"
+#include "libbde_keyring_entry.h"
+#include "libbde_libbfio.h"
+#include "libbde_libcdata.h"
+#include "libbde_libcerror.h"
+
+/* Creates a keyring
+ * Make sure the value keyring is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_keyring_initialize(
+     libbde_keyring_t **keyring,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_keyring_initialize";
+
+	if( keyring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *keyring != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid keyring value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*keyring = memory_allocate_structure(
+	            libbde_keyring_t );
+
+	if( *keyring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create keyring.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *keyring,
+	     0,
+	     sizeof( libbde_keyring_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear keyring.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *keyring )->entries_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create entries array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *keyring != NULL )
+	{
+		memory_free(
+		 *keyring );
+
+		*keyring = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a keyring
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_keyring_free(
+     libbde_keyring_t **keyring,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_keyring_free";
+	int result            = 1;
+
+	if( keyring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyring.",
+		 function );
+
+		return( -1 );
+	}
+	if( *keyring != NULL )
+	{
+		if( libcdata_array_free(
+		     &( ( *keyring )->entries_array ),
+		     (int(*)(intptr_t **, libcerror_error_t **)) &libbde_keyring_entry_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free entries array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *keyring );
+
+		*keyring = NULL;
+	}
+	return( result );
+}
+
+/* Reads the keyring entries from UTF-8 encoded text data
+ * Every line contains one entry, empty lines and lines starting with # are ignored
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_keyring_read_data(
+     libbde_keyring_t *keyring,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libbde_keyring_entry_t *keyring_entry = NULL;
+	static char *function                 = "libbde_keyring_read_data";
+	size_t data_offset                    = 0;
+	size_t line_length                    = 0;
+	size_t line_offset                    = 0;
+	int entry_index                       = 0;
+	int line_number                       = 0;
+
+	if( keyring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyring.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* Skip the UTF-8 byte order mark
+	 */
+	if( ( data_size >= 3 )
+	 && ( data[ 0 ] == 0xef )
+	 && ( data[ 1 ] == 0xbb )
+	 && ( data[ 2 ] == 0xbf ) )
+	{
+		data_offset = 3;
+	}
+	while( data_offset < data_size )
+	{
+		line_offset = data_offset;
+
+		while( ( data_offset < data_size )
+		    && ( data[ data_offset ] != (uint8_t) '\n' ) )
+		{
+			data_offset++;
+		}
+		line_length = data_offset - line_offset;
+
+		/* Skip the end-of-line character
+		 */
+		data_offset++;
+
+		line_number++;
+
+		if( ( line_length > 0 )
+		 && ( data[ line_offset + line_length - 1 ] == (uint8_t) '\r' ) )
+		{
+			line_length--;
+		}
+		while( ( line_length > 0 )
+		    && ( ( data[ line_offset ] == (uint8_t) ' ' )
+		     ||  ( data[ line_offset ] == (uint8_t) '\t' ) ) )
+		{
+			line_offset++;
+			line_length--;
+		}
+		if( ( line_length == 0 )
+		 || ( data[ line_offset ] == (uint8_t) '#' ) )
+		{
+			continue;
+		}
+		if( libbde_keyring_entry_initialize(
+		     &keyring_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create keyring entry.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbde_keyring_entry_read_utf8_string(
+		     keyring_entry,
+		     &( data[ line_offset ] ),
+		     line_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read keyring entry on line: %d.",
+			 function,
+			 line_number );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     keyring->entries_array,
+		     &entry_index,
+		     (intptr_t *) keyring_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append keyring entry to array.",
+			 function );
+
+			goto on_error;
+		}
+		keyring_entry = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( keyring_entry != NULL )
+	{
+		libbde_keyring_entry_free(
+		 &keyring_entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the keyring entries from a keyring file using a Basic File IO (bfio) handle
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_keyring_read_file_io_handle(
+     libbde_keyring_t *keyring,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *data              = NULL;
+	static char *function      = "libbde_keyring_read_file_io_handle";
+	size64_t file_size         = 0;
+	ssize_t read_count         = 0;
+	int file_io_handle_is_open = 0;
+
+	if( keyring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyring.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_size > (size64_t) LIBBDE_MAXIMUM_KEYRING_FILE_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_size > 0 )
+	{
+		data = (uint8_t *) memory_allocate(
+		                    sizeof( uint8_t ) * (size_t) file_size );
+
+		if( data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbfio_handle_seek_offset(
+		     file_io_handle,
+		     0,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: 0.",
+			 function );
+
+			goto on_error;
+		}
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              data,
+		              (size_t) file_size,
+		              error );
+
+		if( read_count != (ssize_t) file_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbde_keyring_read_data(
+		     keyring,
+		     data,
+		     (size_t) file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read keyring data.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     data,
+		     0,
+		     (size_t) file_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear data.",
+			 function );
+
+			goto on_error;
+		}
+		memory_free(
+		 data );
+
+		data = NULL;
+	}
+	if( file_io_handle_is_open == 0 )
+	{
+		file_io_handle_is_open = 1;
+
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( data != NULL )
+	{
+		memory_set(
+		 data,
+		 0,
+		 (size_t) file_size );
+		memory_free(
+		 data );
+	}
+	if( file_io_handle_is_open == 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Moves the entries of the source keyring to the end of the keyring
+ * The source keyring is left without entries
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_keyring_move_entries(
+     libbde_keyring_t *keyring,
+     libbde_keyring_t *source_keyring,
+     libcerror_error_t **error )
+{
+	libbde_keyring_entry_t *keyring_entry = NULL;
+	static char *function                 = "libbde_keyring_move_entries";
+	int entry_index                       = 0;
+	int number_of_entries                 = 0;
+	int source_entry_index                = 0;
+
+	if( keyring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyring.",
+		 function );
+
+		return( -1 );
+	}
+	if( source_keyring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source keyring.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     source_keyring->entries_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of source entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( source_entry_index = 0;
+	     source_entry_index < number_of_entries;
+	     source_entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     source_keyring->entries_array,
+		     source_entry_index,
+		     (intptr_t **) &keyring_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve source entry: %d.",
+			 function,
+			 source_entry_index );
+
+			return( -1 );
+		}
+		if( libcdata_array_append_entry(
+		     keyring->entries_array,
+		     &entry_index,
+		     (intptr_t *) keyring_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append entry to array.",
+			 function );
+
+			return( -1 );
+		}
+		/* The entry is now owned by the keyring
+		 */
+		if( libcdata_array_set_entry_by_index(
+		     source_keyring->entries_array,
+		     source_entry_index,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set source entry: %d.",
+			 function,
+			 source_entry_index );
+
+			return( -1 );
+		}
+	}
+	if( libcdata_array_resize(
+	     source_keyring->entries_array,
+	     0,
+	     NULL,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+		 "%s: unable to resize source entries array.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of keyring entries
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_keyring_get_number_of_entries(
+     libbde_keyring_t *keyring,
+     int *number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_keyring_get_number_of_entries";
+
+	if( keyring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyring.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     keyring->entries_array,
+	     number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the keyring entry of a specific volume identifier
+ * If the keyring contains multiple entries for the volume the first one is returned
+ * Returns 1 if successful, 0 if no such entry or -1 on error
+ */
+int libbde_keyring_get_entry_by_volume_identifier(
+     libbde_keyring_t *keyring,
+     const uint8_t *volume_identifier,
+     size_t volume_identifier_size,
+     libbde_keyring_entry_t **keyring_entry,
+     libcerror_error_t **error )
+{
+	libbde_keyring_entry_t *safe_keyring_entry = NULL;
+	static char *function                      = "libbde_keyring_get_entry_by_volume_identifier";
+	int entry_index                            = 0;
+	int number_of_entries                      = 0;
+
+	if( keyring == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyring.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume identifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_identifier_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume identifier size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( keyring_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyring entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     keyring->entries_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     keyring->entries_array,
+		     entry_index,
+		     (intptr_t **) &safe_keyring_entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( safe_keyring_entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing entry: %d.",
+			 function,
+			 entry_index );
+
+			return( -1 );
+		}
+		if( memory_compare(
+		     safe_keyring_entry->volume_identifier,
+		     volume_identifier,
+		     16 ) == 0 )
+		{
+			*keyring_entry = safe_keyring_entry;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
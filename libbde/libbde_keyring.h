@@ -0,0 +1,87 @@
+/*
+ * Keyring functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_KEYRING_H )
+#define _LIBBDE_KEYRING_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_keyring_entry.h"
+#include "libbde_libbfio.h"
+#include "libbde_libcdata.h"
+#include "libbde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbde_keyring libbde_keyring_t;
+
+struct libbde_keyring
+{
+	/* The entries array
+	 */
+	libcdata_array_t *entries_array;
+};
+
+int libbde_keyring_initialize(
+     libbde_keyring_t **keyring,
+     libcerror_error_t **error );
+
+int libbde_keyring_free(
+     libbde_keyring_t **keyring,
+     libcerror_error_t **error );
+
+int libbde_keyring_read_data(
+     libbde_keyring_t *keyring,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libbde_keyring_read_file_io_handle(
+     libbde_keyring_t *keyring,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libbde_keyring_move_entries(
+     libbde_keyring_t *keyring,
+     libbde_keyring_t *source_keyring,
+     libcerror_error_t **error );
+
+int libbde_keyring_get_number_of_entries(
+     libbde_keyring_t *keyring,
+     int *number_of_entries,
+     libcerror_error_t **error );
+
+int libbde_keyring_get_entry_by_volume_identifier(
+     libbde_keyring_t *keyring,
+     const uint8_t *volume_identifier,
+     size_t volume_identifier_size,
+     libbde_keyring_entry_t **keyring_entry,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_KEYRING_H ) */
+
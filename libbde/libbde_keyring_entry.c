@@ -0,0 +1,652 @@
+/*
+ * Keyring entry functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_definitions.h"
+#include "libbde_keyring_entry.h"
+#include "libbde_libcerror.h"
+#include "libbde_libuna.h"
+
+/* Creates a keyring entry
+ * Make sure the value keyring_entry is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_keyring_entry_initialize(
+     libbde_keyring_entry_t **keyring_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_keyring_entry_initialize";
+
+	if( keyring_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyring entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *keyring_entry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid keyring entry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*keyring_entry = memory_allocate_structure(
+	                  libbde_keyring_entry_t );
+
+	if( *keyring_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create keyring entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *keyring_entry,
+	     0,
+	     sizeof( libbde_keyring_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear keyring entry.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *keyring_entry != NULL )
+	{
+		memory_free(
+		 *keyring_entry );
+
+		*keyring_entry = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a keyring entry
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_keyring_entry_free(
+     libbde_keyring_entry_t **keyring_entry,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_keyring_entry_free";
+	int result            = 1;
+
+	if( keyring_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyring entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *keyring_entry != NULL )
+	{
+		if( memory_set(
+		     *keyring_entry,
+		     0,
+		     sizeof( libbde_keyring_entry_t ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear keyring entry.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *keyring_entry );
+
+		*keyring_entry = NULL;
+	}
+	return( result );
+}
+
+/* Copies the volume identifier from an UTF-8 encoded GUID string
+ * The string is formatted as: xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx
+ * and can be surrounded by braces
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_keyring_entry_copy_volume_identifier_from_utf8_string(
+     libbde_keyring_entry_t *keyring_entry,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error )
+{
+	uint8_t guid_data[ 16 ];
+
+	static char *function   = "libbde_keyring_entry_copy_volume_identifier_from_utf8_string";
+	size_t guid_data_index  = 0;
+	size_t string_index     = 0;
+	uint8_t character_value = 0;
+	uint8_t nibble_value    = 0;
+	int number_of_nibbles   = 0;
+
+	if( keyring_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyring entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf8_string_length == 38 )
+	 && ( utf8_string[ 0 ] == (uint8_t) '{' )
+	 && ( utf8_string[ 37 ] == (uint8_t) '}' ) )
+	{
+		utf8_string        += 1;
+		utf8_string_length -= 2;
+	}
+	if( utf8_string_length != 36 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid UTF-8 string length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( string_index = 0;
+	     string_index < utf8_string_length;
+	     string_index++ )
+	{
+		character_value = utf8_string[ string_index ];
+
+		if( ( string_index == 8 )
+		 || ( string_index == 13 )
+		 || ( string_index == 18 )
+		 || ( string_index == 23 ) )
+		{
+			if( character_value != (uint8_t) '-' )
+			{
+				break;
+			}
+			continue;
+		}
+		if( ( character_value >= (uint8_t) '0' )
+		 && ( character_value <= (uint8_t) '9' ) )
+		{
+			character_value -= (uint8_t) '0';
+		}
+		else if( ( character_value >= (uint8_t) 'A' )
+		      && ( character_value <= (uint8_t) 'F' ) )
+		{
+			character_value -= (uint8_t) 'A' - 10;
+		}
+		else if( ( character_value >= (uint8_t) 'a' )
+		      && ( character_value <= (uint8_t) 'f' ) )
+		{
+			character_value -= (uint8_t) 'a' - 10;
+		}
+		else
+		{
+			break;
+		}
+		nibble_value = ( nibble_value << 4 ) | character_value;
+
+		number_of_nibbles++;
+
+		if( number_of_nibbles == 2 )
+		{
+			guid_data[ guid_data_index++ ] = nibble_value;
+
+			nibble_value      = 0;
+			number_of_nibbles = 0;
+		}
+	}
+	if( string_index < utf8_string_length )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported character in GUID string at index: %" PRIzd ".",
+		 function,
+		 string_index );
+
+		return( -1 );
+	}
+	/* The volume identifier is stored as a little-endian GUID
+	 */
+	keyring_entry->volume_identifier[ 0 ] = guid_data[ 3 ];
+	keyring_entry->volume_identifier[ 1 ] = guid_data[ 2 ];
+	keyring_entry->volume_identifier[ 2 ] = guid_data[ 1 ];
+	keyring_entry->volume_identifier[ 3 ] = guid_data[ 0 ];
+	keyring_entry->volume_identifier[ 4 ] = guid_data[ 5 ];
+	keyring_entry->volume_identifier[ 5 ] = guid_data[ 4 ];
+	keyring_entry->volume_identifier[ 6 ] = guid_data[ 7 ];
+	keyring_entry->volume_identifier[ 7 ] = guid_data[ 6 ];
+
+	if( memory_copy(
+	     &( keyring_entry->volume_identifier[ 8 ] ),
+	     &( guid_data[ 8 ] ),
+	     8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy volume identifier.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads a keyring entry from an UTF-8 encoded line
+ * The line consists of whitespace separated fields:
+ *   <volume identifier> fvek <FVEK>[:<TWEAK>]
+ *   <volume identifier> vmk <VMK>
+ * where the keys are base16 encoded
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_keyring_entry_read_utf8_string(
+     libbde_keyring_entry_t *keyring_entry,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error )
+{
+	const uint8_t *field_start[ 3 ];
+	size_t field_length[ 3 ];
+
+	static char *function    = "libbde_keyring_entry_read_utf8_string";
+	size_t key_string_length = 0;
+	size_t string_index      = 0;
+	int number_of_fields     = 0;
+
+	if( keyring_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyring entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	while( string_index < utf8_string_length )
+	{
+		if( ( utf8_string[ string_index ] == (uint8_t) ' ' )
+		 || ( utf8_string[ string_index ] == (uint8_t) '\t' ) )
+		{
+			string_index++;
+
+			continue;
+		}
+		if( number_of_fields >= 3 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported number of fields.",
+			 function );
+
+			goto on_error;
+		}
+		field_start[ number_of_fields ]  = &( utf8_string[ string_index ] );
+		field_length[ number_of_fields ] = 0;
+
+		while( ( string_index < utf8_string_length )
+		    && ( utf8_string[ string_index ] != (uint8_t) ' ' )
+		    && ( utf8_string[ string_index ] != (uint8_t) '\t' ) )
+		{
+			field_length[ number_of_fields ] += 1;
+
+			string_index++;
+		}
+		number_of_fields++;
+	}
+	if( number_of_fields != 3 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of fields.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_keyring_entry_copy_volume_identifier_from_utf8_string(
+	     keyring_entry,
+	     field_start[ 0 ],
+	     field_length[ 0 ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy volume identifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( field_length[ 1 ] == 4 )
+	 && ( memory_compare(
+	       field_start[ 1 ],
+	       "fvek",
+	       4 ) == 0 ) )
+	{
+		keyring_entry->type = LIBBDE_KEYRING_ENTRY_TYPE_FULL_VOLUME_ENCRYPTION_KEY;
+
+		for( key_string_length = 0;
+		     key_string_length < field_length[ 2 ];
+		     key_string_length++ )
+		{
+			if( field_start[ 2 ][ key_string_length ] == (uint8_t) ':' )
+			{
+				break;
+			}
+		}
+		if( ( key_string_length != 32 )
+		 && ( key_string_length != 64 )
+		 && ( key_string_length != 128 ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported full volume encryption key string length.",
+			 function );
+
+			goto on_error;
+		}
+		keyring_entry->full_volume_encryption_key_size = key_string_length / 2;
+
+		if( libuna_base16_stream_copy_to_byte_stream(
+		     field_start[ 2 ],
+		     key_string_length,
+		     keyring_entry->full_volume_encryption_key,
+		     keyring_entry->full_volume_encryption_key_size,
+		     LIBUNA_BASE16_VARIANT_RFC4648,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy full volume encryption key.",
+			 function );
+
+			goto on_error;
+		}
+		if( key_string_length < field_length[ 2 ] )
+		{
+			field_start[ 2 ]  += key_string_length + 1;
+			field_length[ 2 ] -= key_string_length + 1;
+
+			if( ( field_length[ 2 ] != 32 )
+			 && ( field_length[ 2 ] != 64 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported tweak key string length.",
+				 function );
+
+				goto on_error;
+			}
+			keyring_entry->tweak_key_size = field_length[ 2 ] / 2;
+
+			if( libuna_base16_stream_copy_to_byte_stream(
+			     field_start[ 2 ],
+			     field_length[ 2 ],
+			     keyring_entry->tweak_key,
+			     keyring_entry->tweak_key_size,
+			     LIBUNA_BASE16_VARIANT_RFC4648,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+				 "%s: unable to copy tweak key.",
+				 function );
+
+				goto on_error;
+			}
+		}
+	}
+	else if( ( field_length[ 1 ] == 3 )
+	      && ( memory_compare(
+	            field_start[ 1 ],
+	            "vmk",
+	            3 ) == 0 ) )
+	{
+		keyring_entry->type = LIBBDE_KEYRING_ENTRY_TYPE_VOLUME_MASTER_KEY;
+
+		if( field_length[ 2 ] != 64 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported volume master key string length.",
+			 function );
+
+			goto on_error;
+		}
+		if( libuna_base16_stream_copy_to_byte_stream(
+		     field_start[ 2 ],
+		     field_length[ 2 ],
+		     keyring_entry->volume_master_key,
+		     32,
+		     LIBUNA_BASE16_VARIANT_RFC4648,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy volume master key.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported key type.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	memory_set(
+	 keyring_entry->full_volume_encryption_key,
+	 0,
+	 64 );
+
+	memory_set(
+	 keyring_entry->tweak_key,
+	 0,
+	 32 );
+
+	memory_set(
+	 keyring_entry->volume_master_key,
+	 0,
+	 32 );
+
+	keyring_entry->type                            = 0;
+	keyring_entry->full_volume_encryption_key_size = 0;
+	keyring_entry->tweak_key_size                  = 0;
+
+	return( -1 );
+}
+
+/* Checks if the key sizes of a full volume encryption key entry match the encryption method
+ * The diffuser methods require a tweak key of the same size as the key,
+ * the other methods do not use a tweak key
+ * Returns 1 if the key sizes match, 0 if not or -1 on error
+ */
+int libbde_keyring_entry_check_encryption_method(
+     libbde_keyring_entry_t *keyring_entry,
+     uint16_t encryption_method,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_keyring_entry_check_encryption_method";
+	size_t key_size       = 0;
+	size_t tweak_key_size = 0;
+
+	if( keyring_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keyring entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( keyring_entry->type != LIBBDE_KEYRING_ENTRY_TYPE_FULL_VOLUME_ENCRYPTION_KEY )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported keyring entry type.",
+		 function );
+
+		return( -1 );
+	}
+	switch( encryption_method )
+	{
+		case LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER:
+			key_size       = 16;
+			tweak_key_size = 16;
+			break;
+
+		case LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER:
+			key_size       = 32;
+			tweak_key_size = 32;
+			break;
+
+		case LIBBDE_ENCRYPTION_METHOD_AES_128_CBC:
+			key_size = 16;
+			break;
+
+		case LIBBDE_ENCRYPTION_METHOD_AES_256_CBC:
+		case LIBBDE_ENCRYPTION_METHOD_AES_128_XTS:
+			key_size = 32;
+			break;
+
+		case LIBBDE_ENCRYPTION_METHOD_AES_256_XTS:
+			key_size = 64;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported encryption method.",
+			 function );
+
+			return( -1 );
+	}
+	if( ( keyring_entry->full_volume_encryption_key_size != key_size )
+	 || ( keyring_entry->tweak_key_size != tweak_key_size ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,99 @@
+/*
+ * Keyring entry functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_KEYRING_ENTRY_H )
+#define _LIBBDE_KEYRING_ENTRY_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbde_keyring_entry libbde_keyring_entry_t;
+
+struct libbde_keyring_entry
+{
+	/* The volume identifier
+	 * Contains a GUID
+	 */
+	uint8_t volume_identifier[ 16 ];
+
+	/* The type
+	 */
+	int type;
+
+	/* The full volume encryption key
+	 * AES-XTS uses a 2 x 256-bit key
+	 */
+	uint8_t full_volume_encryption_key[ 64 ];
+
+	/* The full volume encryption key size
+	 */
+	size_t full_volume_encryption_key_size;
+
+	/* The tweak key
+	 */
+	uint8_t tweak_key[ 32 ];
+
+	/* The tweak key size
+	 */
+	size_t tweak_key_size;
+
+	/* The volume master key
+	 */
+	uint8_t volume_master_key[ 32 ];
+};
+
+int libbde_keyring_entry_initialize(
+     libbde_keyring_entry_t **keyring_entry,
+     libcerror_error_t **error );
+
+int libbde_keyring_entry_free(
+     libbde_keyring_entry_t **keyring_entry,
+     libcerror_error_t **error );
+
+int libbde_keyring_entry_copy_volume_identifier_from_utf8_string(
+     libbde_keyring_entry_t *keyring_entry,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error );
+
+int libbde_keyring_entry_read_utf8_string(
+     libbde_keyring_entry_t *keyring_entry,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error );
+
+int libbde_keyring_entry_check_encryption_method(
+     libbde_keyring_entry_t *keyring_entry,
+     uint16_t encryption_method,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_KEYRING_ENTRY_H ) */
+
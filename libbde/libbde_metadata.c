@@ -41,7 +41,6 @@
 #include "libbde_libuna.h"
 #include "libbde_metadata.h"
 #include "libbde_metadata_entry.h"
-#include "libbde_password.h"
 #include "libbde_password_keep.h"
 #include "libbde_volume_master_key.h"
 
@@ -2114,6 +2113,34 @@ int libbde_metadata_read_volume_master_key(
 			unencrypted_data = NULL;
 		}
 	}
+	if( ( result == 0 )
+	 && ( password_keep->password_is_set != 0 )
+	 && ( password_keep->recovery_password_is_set != 0 )
+	 && ( metadata->password_volume_master_key != NULL )
+	 && ( metadata->password_volume_master_key->stretch_key != NULL )
+	 && ( metadata->recovery_password_volume_master_key != NULL )
+	 && ( metadata->recovery_password_volume_master_key->stretch_key != NULL ) )
+	{
+		/* Stretch the recovery password key, on a separate thread where supported,
+		 * while the password key is stretched and tried below. The recovery password
+		 * key stretching is aborted if the password decrypts the volume master key
+		 */
+		if( libbde_password_keep_start_recovery_password_key(
+		     password_keep,
+		     metadata->recovery_password_volume_master_key->stretch_key->salt,
+		     16,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to start recovery password key calculation.",
+			 function );
+
+			goto on_error;
+		}
+	}
 	if( result == 0 )
 	{
 		if( password_keep->password_is_set != 0 )
@@ -2127,7 +2154,7 @@ int libbde_metadata_read_volume_master_key(
 				 "%s: invalid metadata - missing password volume master key.",
 				 function );
 
-				return( -1 );
+				goto on_error;
 			}
 			if( metadata->password_volume_master_key->stretch_key == NULL )
 			{
@@ -2138,7 +2165,7 @@ int libbde_metadata_read_volume_master_key(
 				 "%s: invalid metadata - invalid password volume master key - missing stretch key.",
 				 function );
 
-				return( -1 );
+				goto on_error;
 			}
 			if( metadata->password_volume_master_key->aes_ccm_encrypted_key == NULL )
 			{
@@ -2149,7 +2176,7 @@ int libbde_metadata_read_volume_master_key(
 				 "%s: invalid metadata - invalid password volume master key - missing AES-CCM encrypted key.",
 				 function );
 
-				return( -1 );
+				goto on_error;
 			}
 			if( memory_set(
 			     aes_ccm_key,
@@ -2165,9 +2192,8 @@ int libbde_metadata_read_volume_master_key(
 
 				goto on_error;
 			}
-			if( libbde_password_calculate_key(
-			     password_keep->password_hash,
-			     32,
+			if( libbde_password_keep_get_password_key(
+			     password_keep,
 			     metadata->password_volume_master_key->stretch_key->salt,
 			     16,
 			     aes_ccm_key,
@@ -2360,6 +2386,23 @@ int libbde_metadata_read_volume_master_key(
 			unencrypted_data = NULL;
 		}
 	}
+	/* The recovery password key is only needed if the password did not
+	 * decrypt the volume master key
+	 */
+	if( libbde_password_keep_stop_recovery_password_key(
+	     password_keep,
+	     result,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to stop recovery password key calculation.",
+		 function );
+
+		goto on_error;
+	}
 	if( result == 0 )
 	{
 		if( password_keep->recovery_password_is_set != 0 )
@@ -2411,9 +2454,8 @@ int libbde_metadata_read_volume_master_key(
 
 				goto on_error;
 			}
-			if( libbde_password_calculate_key(
-			     password_keep->recovery_password_hash,
-			     32,
+			if( libbde_password_keep_get_recovery_password_key(
+			     password_keep,
 			     metadata->recovery_password_volume_master_key->stretch_key->salt,
 			     16,
 			     aes_ccm_key,
@@ -2618,6 +2660,13 @@ int libbde_metadata_read_volume_master_key(
 	return( result );
 
 on_error:
+	if( password_keep != NULL )
+	{
+		libbde_password_keep_stop_recovery_password_key(
+		 password_keep,
+		 1,
+		 NULL );
+	}
 	if( unencrypted_data != NULL )
 	{
 		memory_set(
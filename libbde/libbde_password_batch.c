@@ -0,0 +1,710 @@
+/*
+ * Password batch functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_aes_ccm_encrypted_key.h"
+#include "libbde_libcerror.h"
+#include "libbde_libcnotify.h"
+#include "libbde_libcthreads.h"
+#include "libbde_password_batch.h"
+#include "libbde_sha256_stretch.h"
+#include "libbde_volume_master_key.h"
+
+/* Creates a password batch
+ * Make sure the value password_batch is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_password_batch_initialize(
+     libbde_password_batch_t **password_batch,
+     int maximum_number_of_password_hashes,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_password_batch_initialize";
+
+	if( password_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *password_batch != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid password batch value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( maximum_number_of_password_hashes <= 0 )
+	 || ( (size_t) maximum_number_of_password_hashes > ( (size_t) SSIZE_MAX / 32 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid maximum number of password hashes value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*password_batch = memory_allocate_structure(
+	                   libbde_password_batch_t );
+
+	if( *password_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create password batch.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *password_batch,
+	     0,
+	     sizeof( libbde_password_batch_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear password batch.",
+		 function );
+
+		memory_free(
+		 *password_batch );
+
+		*password_batch = NULL;
+
+		return( -1 );
+	}
+	( *password_batch )->password_hashes = (uint8_t *) memory_allocate(
+	                                                    sizeof( uint8_t ) * 32 * maximum_number_of_password_hashes );
+
+	if( ( *password_batch )->password_hashes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create password hashes.",
+		 function );
+
+		goto on_error;
+	}
+	( *password_batch )->password_indexes = (int *) memory_allocate(
+	                                                 sizeof( int ) * maximum_number_of_password_hashes );
+
+	if( ( *password_batch )->password_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create password indexes.",
+		 function );
+
+		goto on_error;
+	}
+	( *password_batch )->maximum_number_of_password_hashes = maximum_number_of_password_hashes;
+	( *password_batch )->result_position                   = -1;
+
+	return( 1 );
+
+on_error:
+	if( *password_batch != NULL )
+	{
+		if( ( *password_batch )->password_hashes != NULL )
+		{
+			memory_free(
+			 ( *password_batch )->password_hashes );
+		}
+		memory_free(
+		 *password_batch );
+
+		*password_batch = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a password batch
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_password_batch_free(
+     libbde_password_batch_t **password_batch,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_password_batch_free";
+
+	if( password_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( *password_batch != NULL )
+	{
+		/* The password hashes are sensitive hence they are cleared before they are freed
+		 */
+		memory_set(
+		 ( *password_batch )->password_hashes,
+		 0,
+		 sizeof( uint8_t ) * 32 * ( *password_batch )->maximum_number_of_password_hashes );
+
+		memory_free(
+		 ( *password_batch )->password_hashes );
+
+		memory_free(
+		 ( *password_batch )->password_indexes );
+
+		memory_free(
+		 *password_batch );
+
+		*password_batch = NULL;
+	}
+	return( 1 );
+}
+
+/* Appends a password hash to the password batch
+ * The password index is the index of the password as provided by the caller
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_password_batch_append_password_hash(
+     libbde_password_batch_t *password_batch,
+     int password_index,
+     const uint8_t *password_hash,
+     size_t password_hash_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_password_batch_append_password_hash";
+
+	if( password_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_batch->number_of_password_hashes >= password_batch->maximum_number_of_password_hashes )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid password batch - number of password hashes value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_hash_size != 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: password hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     &( password_batch->password_hashes[ password_batch->number_of_password_hashes * 32 ] ),
+	     password_hash,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy password hash.",
+		 function );
+
+		return( -1 );
+	}
+	password_batch->password_indexes[ password_batch->number_of_password_hashes ] = password_index;
+
+	password_batch->number_of_password_hashes += 1;
+
+	return( 1 );
+}
+
+/* Tests the password hashes of the password batch against a password or recovery password volume master key
+ * The password hashes are stretched in groups, the groups are tested concurrently
+ * by the number of threads, or sequentially if the number of threads is 0
+ * Returns 1 if a password decrypts the volume master key, 0 if not or -1 on error
+ */
+int libbde_password_batch_test(
+     libbde_password_batch_t *password_batch,
+     libbde_volume_master_key_t *volume_master_key,
+     int number_of_threads,
+     int *password_index,
+     libcerror_error_t **error )
+{
+	libbde_password_batch_group_t *groups          = NULL;
+	static char *function                          = "libbde_password_batch_test";
+	int group_index                                = 0;
+	int number_of_groups                           = 0;
+	int result                                     = 0;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_pool_t *thread_pool         = NULL;
+#endif
+
+	if( password_batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password batch.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_master_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume master key.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_master_key->stretch_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume master key - missing stretch key.",
+		 function );
+
+		return( -1 );
+	}
+	if( volume_master_key->aes_ccm_encrypted_key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume master key - missing AES-CCM encrypted key.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_threads < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password index.",
+		 function );
+
+		return( -1 );
+	}
+	password_batch->volume_master_key = volume_master_key;
+	password_batch->result_position   = -1;
+	password_batch->has_failed        = 0;
+
+	if( password_batch->number_of_password_hashes == 0 )
+	{
+		return( 0 );
+	}
+	number_of_groups = password_batch->number_of_password_hashes / LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES;
+
+	if( ( password_batch->number_of_password_hashes % LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES ) != 0 )
+	{
+		number_of_groups += 1;
+	}
+	groups = (libbde_password_batch_group_t *) memory_allocate(
+	                                            sizeof( libbde_password_batch_group_t ) * number_of_groups );
+
+	if( groups == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create groups.",
+		 function );
+
+		goto on_error;
+	}
+	for( group_index = 0;
+	     group_index < number_of_groups;
+	     group_index++ )
+	{
+		groups[ group_index ].first_position            = group_index * LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES;
+		groups[ group_index ].number_of_password_hashes = password_batch->number_of_password_hashes - groups[ group_index ].first_position;
+
+		if( groups[ group_index ].number_of_password_hashes > LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES )
+		{
+			groups[ group_index ].number_of_password_hashes = LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES;
+		}
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( ( number_of_threads > 0 )
+	 && ( number_of_groups > 1 ) )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( password_batch->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_thread_pool_create(
+		     &thread_pool,
+		     NULL,
+		     number_of_threads,
+		     number_of_groups,
+		     (int (*)(intptr_t *, void *)) &libbde_password_batch_test_group,
+		     (void *) password_batch,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		for( group_index = 0;
+		     group_index < number_of_groups;
+		     group_index++ )
+		{
+			if( libcthreads_thread_pool_push(
+			     thread_pool,
+			     (intptr_t *) &( groups[ group_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to push group: %d onto thread pool queue.",
+				 function,
+				 group_index );
+
+				goto on_error;
+			}
+		}
+		/* Joining the thread pool waits for the queued groups to be tested
+		 */
+		if( libcthreads_thread_pool_join(
+		     &thread_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_mutex_free(
+		     &( password_batch->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+#endif
+	{
+		for( group_index = 0;
+		     group_index < number_of_groups;
+		     group_index++ )
+		{
+			libbde_password_batch_test_group(
+			 &( groups[ group_index ] ),
+			 password_batch );
+
+			if( ( password_batch->has_failed != 0 )
+			 || ( password_batch->result_position != -1 ) )
+			{
+				break;
+			}
+		}
+	}
+	memory_free(
+	 groups );
+
+	groups = NULL;
+
+	if( password_batch->has_failed != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to test password hashes.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_batch->result_position != -1 )
+	{
+		*password_index = password_batch->password_indexes[ password_batch->result_position ];
+
+		result = 1;
+	}
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( thread_pool != NULL )
+	{
+		libcthreads_thread_pool_join(
+		 &thread_pool,
+		 NULL );
+	}
+	if( password_batch->mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( password_batch->mutex ),
+		 NULL );
+	}
+#endif
+	if( groups != NULL )
+	{
+		memory_free(
+		 groups );
+	}
+	return( -1 );
+}
+
+/* Stretches and tests a group of password hashes
+ * Callback function for the worker threads
+ * The group is skipped if a password hash in a preceding position already decrypted
+ * the volume master key or another group failed
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_password_batch_test_group(
+     libbde_password_batch_group_t *group,
+     libbde_password_batch_t *password_batch )
+{
+	uint8_t keys[ LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES * 32 ];
+	uint8_t volume_master_key[ 32 ];
+
+	libcerror_error_t *error = NULL;
+	static char *function    = "libbde_password_batch_test_group";
+	int key_index            = 0;
+	int result               = 0;
+	int result_position      = -1;
+	int skip_group           = 0;
+
+	if( ( group == NULL )
+	 || ( password_batch == NULL ) )
+	{
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( password_batch->mutex != NULL )
+	{
+		libcthreads_mutex_grab(
+		 password_batch->mutex,
+		 NULL );
+	}
+#endif
+	if( ( password_batch->has_failed != 0 )
+	 || ( ( password_batch->result_position != -1 )
+	  &&  ( password_batch->result_position < group->first_position ) ) )
+	{
+		skip_group = 1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( password_batch->mutex != NULL )
+	{
+		libcthreads_mutex_release(
+		 password_batch->mutex,
+		 NULL );
+	}
+#endif
+	if( skip_group != 0 )
+	{
+		return( 1 );
+	}
+	if( libbde_sha256_stretch_calculate_multiple(
+	     &( password_batch->password_hashes[ group->first_position * 32 ] ),
+	     group->number_of_password_hashes * 32,
+	     password_batch->volume_master_key->stretch_key->salt,
+	     16,
+	     LIBBDE_SHA256_STRETCH_NUMBER_OF_ITERATIONS,
+	     keys,
+	     LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES * 32,
+	     group->number_of_password_hashes,
+	     &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate keys.",
+		 function );
+
+		result = -1;
+	}
+	for( key_index = 0;
+	     ( result == 0 ) && ( key_index < group->number_of_password_hashes );
+	     key_index++ )
+	{
+		result = libbde_aes_ccm_encrypted_key_decrypt_volume_master_key(
+		          password_batch->volume_master_key->aes_ccm_encrypted_key,
+		          &( keys[ key_index * 32 ] ),
+		          32,
+		          volume_master_key,
+		          32,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to decrypt volume master key.",
+			 function );
+		}
+		else if( result == 1 )
+		{
+			result_position = group->first_position + key_index;
+		}
+	}
+	memory_set(
+	 keys,
+	 0,
+	 LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES * 32 );
+
+	memory_set(
+	 volume_master_key,
+	 0,
+	 32 );
+
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( password_batch->mutex != NULL )
+	{
+		libcthreads_mutex_grab(
+		 password_batch->mutex,
+		 NULL );
+	}
+#endif
+	if( result == -1 )
+	{
+		password_batch->has_failed = 1;
+	}
+	else if( ( result_position != -1 )
+	      && ( ( password_batch->result_position == -1 )
+	       ||  ( result_position < password_batch->result_position ) ) )
+	{
+		password_batch->result_position = result_position;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( password_batch->mutex != NULL )
+	{
+		libcthreads_mutex_release(
+		 password_batch->mutex,
+		 NULL );
+	}
+#endif
+	if( result == -1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
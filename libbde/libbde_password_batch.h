@@ -0,0 +1,121 @@
+/*
+ * Password batch functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_PASSWORD_BATCH_H )
+#define _LIBBDE_PASSWORD_BATCH_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+#include "libbde_libcthreads.h"
+#include "libbde_volume_master_key.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbde_password_batch libbde_password_batch_t;
+
+struct libbde_password_batch
+{
+	/* The password hashes, 32 bytes per password
+	 */
+	uint8_t *password_hashes;
+
+	/* The indexes of the passwords as provided by the caller
+	 */
+	int *password_indexes;
+
+	/* The number of password hashes
+	 */
+	int number_of_password_hashes;
+
+	/* The maximum number of password hashes
+	 */
+	int maximum_number_of_password_hashes;
+
+	/* The volume master key the passwords are tested against
+	 */
+	libbde_volume_master_key_t *volume_master_key;
+
+	/* The position of the first password hash that decrypts the volume master key
+	 * or -1 if not found
+	 */
+	int result_position;
+
+	/* Value to indicate a group of password hashes failed to be tested
+	 */
+	int has_failed;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	/* The mutex that guards the result
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+typedef struct libbde_password_batch_group libbde_password_batch_group_t;
+
+struct libbde_password_batch_group
+{
+	/* The position of the first password hash of the group
+	 */
+	int first_position;
+
+	/* The number of password hashes of the group
+	 */
+	int number_of_password_hashes;
+};
+
+int libbde_password_batch_initialize(
+     libbde_password_batch_t **password_batch,
+     int maximum_number_of_password_hashes,
+     libcerror_error_t **error );
+
+int libbde_password_batch_free(
+     libbde_password_batch_t **password_batch,
+     libcerror_error_t **error );
+
+int libbde_password_batch_append_password_hash(
+     libbde_password_batch_t *password_batch,
+     int password_index,
+     const uint8_t *password_hash,
+     size_t password_hash_size,
+     libcerror_error_t **error );
+
+int libbde_password_batch_test(
+     libbde_password_batch_t *password_batch,
+     libbde_volume_master_key_t *volume_master_key,
+     int number_of_threads,
+     int *password_index,
+     libcerror_error_t **error );
+
+int libbde_password_batch_test_group(
+     libbde_password_batch_group_t *group,
+     libbde_password_batch_t *password_batch );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_PASSWORD_BATCH_H ) */
+
@@ -25,7 +25,10 @@
 #include <types.h>
 
 #include "libbde_libcerror.h"
+#include "libbde_libcthreads.h"
+#include "libbde_password.h"
 #include "libbde_password_keep.h"
+#include "libbde_sha256_stretch.h"
 
 /* Creates a password keep
  * Make sure the value password_keep is referencing, is set to NULL
@@ -128,6 +131,20 @@ int libbde_password_keep_free(
 	}
 	if( *password_keep != NULL )
 	{
+		if( libbde_password_keep_stop_recovery_password_key(
+		     *password_keep,
+		     1,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to stop recovery password key calculation.",
+			 function );
+
+			result = -1;
+		}
 		if( memory_set(
 		     *password_keep,
 		     0,
@@ -150,3 +167,517 @@ int libbde_password_keep_free(
 	return( result );
 }
 
+/* Retrieves the stretched password key for a specific salt
+ * The key is only calculated if no key was previously calculated for the salt,
+ * so that metadata copies with the same salt and reopening the volume do not
+ * repeat the key stretching
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_password_keep_get_password_key(
+     libbde_password_keep_t *password_keep,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_password_keep_get_password_key";
+
+	if( password_keep == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password keep.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_keep->password_is_set == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid password keep - password value not set.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: salt size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_size != 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( password_keep->password_key_is_set == 0 )
+	 || ( memory_compare(
+	       password_keep->password_key_salt,
+	       salt,
+	       16 ) != 0 ) )
+	{
+		password_keep->password_key_is_set = 0;
+
+		if( libbde_password_calculate_key(
+		     password_keep->password_hash,
+		     32,
+		     salt,
+		     16,
+		     password_keep->password_key,
+		     32,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate password key.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     password_keep->password_key_salt,
+		     salt,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy salt.",
+			 function );
+
+			goto on_error;
+		}
+		password_keep->password_key_is_set = 1;
+	}
+	if( memory_copy(
+	     key,
+	     password_keep->password_key,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy key.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	memory_set(
+	 password_keep->password_key,
+	 0,
+	 32 );
+
+	password_keep->password_key_is_set = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the stretched recovery password key for a specific salt
+ * The key is only calculated if no key was previously calculated for the salt,
+ * so that metadata copies with the same salt and reopening the volume do not
+ * repeat the key stretching
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_password_keep_get_recovery_password_key(
+     libbde_password_keep_t *password_keep,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_password_keep_get_recovery_password_key";
+
+	if( password_keep == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password keep.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_keep->recovery_password_is_set == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid password keep - recovery password value not set.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: salt size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_size != 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( password_keep->recovery_password_key_is_set == 0 )
+	 || ( memory_compare(
+	       password_keep->recovery_password_key_salt,
+	       salt,
+	       16 ) != 0 ) )
+	{
+		password_keep->recovery_password_key_is_set = 0;
+
+		if( libbde_password_calculate_key(
+		     password_keep->recovery_password_hash,
+		     32,
+		     salt,
+		     16,
+		     password_keep->recovery_password_key,
+		     32,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate recovery password key.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     password_keep->recovery_password_key_salt,
+		     salt,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy salt.",
+			 function );
+
+			goto on_error;
+		}
+		password_keep->recovery_password_key_is_set = 1;
+	}
+	if( memory_copy(
+	     key,
+	     password_keep->recovery_password_key,
+	     32 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy key.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	memory_set(
+	 password_keep->recovery_password_key,
+	 0,
+	 32 );
+
+	password_keep->recovery_password_key_is_set = 0;
+
+	return( -1 );
+}
+
+/* Starts calculating the stretched recovery password key for a specific salt
+ * When built with multi-threading support the recovery password key is stretched
+ * on a separate thread, so that it can be stretched while the password key is
+ * stretched and the volume master key is decrypted on the current thread
+ * The calculation must be finished with libbde_password_keep_stop_recovery_password_key
+ * before the recovery password key values are accessed
+ * Otherwise, or if the thread cannot be created, the recovery password key is
+ * calculated when it is retrieved
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_password_keep_start_recovery_password_key(
+     libbde_password_keep_t *password_keep,
+     const uint8_t *salt,
+     size_t salt_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_password_keep_start_recovery_password_key";
+
+	if( password_keep == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password keep.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_keep->recovery_password_is_set == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid password keep - recovery password value not set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( password_keep->recovery_password_key_thread != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid password keep - recovery password key thread value already set.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: salt size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( password_keep->recovery_password_key_is_set != 0 )
+	 && ( memory_compare(
+	       password_keep->recovery_password_key_salt,
+	       salt,
+	       16 ) == 0 ) )
+	{
+		return( 1 );
+	}
+	password_keep->recovery_password_key_is_set = 0;
+
+	if( memory_copy(
+	     password_keep->recovery_password_key_salt,
+	     salt,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy salt.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	password_keep->abort_recovery_password_key = 0;
+
+	if( libcthreads_thread_create(
+	     &( password_keep->recovery_password_key_thread ),
+	     NULL,
+	     (int (*)(void *)) &libbde_password_keep_calculate_recovery_password_key_callback,
+	     (void *) password_keep,
+	     NULL ) != 1 )
+	{
+		password_keep->recovery_password_key_thread = NULL;
+	}
+#endif
+	return( 1 );
+}
+
+/* Stops calculating the stretched recovery password key
+ * If abort calculation is set the key stretching is aborted and the recovery password key
+ * remains unset, otherwise this waits for the key stretching to finish
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_password_keep_stop_recovery_password_key(
+     libbde_password_keep_t *password_keep,
+     int abort_calculation,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_password_keep_stop_recovery_password_key";
+
+	if( password_keep == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password keep.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( password_keep->recovery_password_key_thread != NULL )
+	{
+		if( abort_calculation != 0 )
+		{
+			password_keep->abort_recovery_password_key = 1;
+		}
+		if( libcthreads_thread_join(
+		     &( password_keep->recovery_password_key_thread ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread.",
+			 function );
+
+			return( -1 );
+		}
+		password_keep->abort_recovery_password_key = 0;
+	}
+#endif
+	return( 1 );
+}
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+
+/* Calculates the stretched recovery password key for the salt stored in the password keep
+ * Callback function for the key calculation thread
+ * The key stretching stops when the abort recovery password key value is set
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_password_keep_calculate_recovery_password_key_callback(
+     libbde_password_keep_t *password_keep )
+{
+	int result = 0;
+
+	if( password_keep == NULL )
+	{
+		return( -1 );
+	}
+	/* The password key is the SHA256 digest hash after 0x100000 key iterations
+	 */
+	result = libbde_sha256_stretch_calculate(
+	          password_keep->recovery_password_hash,
+	          32,
+	          password_keep->recovery_password_key_salt,
+	          16,
+	          LIBBDE_SHA256_STRETCH_NUMBER_OF_ITERATIONS,
+	          password_keep->recovery_password_key,
+	          32,
+	          &( password_keep->abort_recovery_password_key ),
+	          NULL );
+
+	if( result != 1 )
+	{
+		memory_set(
+		 password_keep->recovery_password_key,
+		 0,
+		 32 );
+
+		if( result == 0 )
+		{
+			return( 1 );
+		}
+		return( -1 );
+	}
+	password_keep->recovery_password_key_is_set = 1;
+
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT ) */
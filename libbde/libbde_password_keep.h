@@ -26,6 +26,7 @@
 #include <types.h>
 
 #include "libbde_libcerror.h"
+#include "libbde_libcthreads.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -43,6 +44,18 @@ struct libbde_password_keep
 	 */
 	uint8_t password_is_set;
 
+	/* The stretched password key
+	 */
+	uint8_t password_key[ 32 ];
+
+	/* The salt of the stretched password key
+	 */
+	uint8_t password_key_salt[ 16 ];
+
+	/* Value to indicate the stretched password key is set
+	 */
+	uint8_t password_key_is_set;
+
 	/* The SHA-256 hash of the (binary) recovery password
 	 */
 	uint8_t recovery_password_hash[ 32 ];
@@ -50,6 +63,28 @@ struct libbde_password_keep
 	/* Value to indicate the recovery password is set
 	 */
 	uint8_t recovery_password_is_set;
+
+	/* The stretched recovery password key
+	 */
+	uint8_t recovery_password_key[ 32 ];
+
+	/* The salt of the stretched recovery password key
+	 */
+	uint8_t recovery_password_key_salt[ 16 ];
+
+	/* Value to indicate the stretched recovery password key is set
+	 */
+	uint8_t recovery_password_key_is_set;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	/* The thread that stretches the recovery password key
+	 */
+	libcthreads_thread_t *recovery_password_key_thread;
+
+	/* Value to indicate the recovery password key stretching should be aborted
+	 */
+	volatile int abort_recovery_password_key;
+#endif
 };
 
 int libbde_password_keep_initialize(
@@ -60,6 +95,40 @@ int libbde_password_keep_free(
      libbde_password_keep_t **password_keep,
      libcerror_error_t **error );
 
+int libbde_password_keep_get_password_key(
+     libbde_password_keep_t *password_keep,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error );
+
+int libbde_password_keep_get_recovery_password_key(
+     libbde_password_keep_t *password_keep,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint8_t *key,
+     size_t key_size,
+     libcerror_error_t **error );
+
+int libbde_password_keep_start_recovery_password_key(
+     libbde_password_keep_t *password_keep,
+     const uint8_t *salt,
+     size_t salt_size,
+     libcerror_error_t **error );
+
+int libbde_password_keep_stop_recovery_password_key(
+     libbde_password_keep_t *password_keep,
+     int abort_calculation,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+
+int libbde_password_keep_calculate_recovery_password_key_callback(
+     libbde_password_keep_t *password_keep );
+
+#endif /* defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT ) */
+
 #if defined( __cplusplus )
 }
 #endif
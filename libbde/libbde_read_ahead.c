@@ -0,0 +1,825 @@
+/*
+ * Read-ahead functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_definitions.h"
+#include "libbde_encryption.h"
+#include "libbde_io_handle.h"
+#include "libbde_libbfio.h"
+#include "libbde_libcerror.h"
+#include "libbde_libcnotify.h"
+#include "libbde_libcthreads.h"
+#include "libbde_read_ahead.h"
+#include "libbde_sector_cache.h"
+#include "libbde_sector_data.h"
+
+/* Creates a read-ahead
+ * The blocks that are read ahead are decrypted by worker threads and stored in the sector cache
+ * Without multi-threading support no blocks are read ahead
+ * Make sure the value read_ahead is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_read_ahead_initialize(
+     libbde_read_ahead_t **read_ahead,
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libbde_sector_cache_t *sector_cache,
+     int depth,
+     libcerror_error_t **error )
+{
+	static char *function     = "libbde_read_ahead_initialize";
+	size_t number_of_blocks   = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read-ahead value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( io_handle->block_size == 0 )
+	 || ( io_handle->block_size > (size_t) LIBBDE_MAXIMUM_BLOCK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid IO handle - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( depth <= 0 )
+	 || ( depth > LIBBDE_MAXIMUM_READ_AHEAD_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*read_ahead = memory_allocate_structure(
+	               libbde_read_ahead_t );
+
+	if( *read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_ahead,
+	     0,
+	     sizeof( libbde_read_ahead_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read-ahead.",
+		 function );
+
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+
+		return( -1 );
+	}
+	( *read_ahead )->io_handle              = io_handle;
+	( *read_ahead )->file_io_handle         = file_io_handle;
+	( *read_ahead )->sector_cache           = sector_cache;
+	( *read_ahead )->depth                  = depth;
+	( *read_ahead )->last_offset            = -1;
+	( *read_ahead )->scheduled_block_offset = -1;
+	( *read_ahead )->scheduled_read_offset  = -1;
+
+	/* Allow enough pending runs to cover the depth
+	 */
+	number_of_blocks = LIBBDE_READ_AHEAD_RUN_SIZE / io_handle->block_size;
+
+	if( number_of_blocks == 0 )
+	{
+		number_of_blocks = 1;
+	}
+	( *read_ahead )->maximum_number_of_pending_runs = (int) ( ( (size_t) depth + number_of_blocks - 1 ) / number_of_blocks );
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_initialize(
+	     &( ( *read_ahead )->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_thread_pool_create(
+	     &( ( *read_ahead )->thread_pool ),
+	     NULL,
+	     LIBBDE_READ_AHEAD_NUMBER_OF_THREADS,
+	     ( *read_ahead )->maximum_number_of_pending_runs,
+	     (int (*)(intptr_t *, void *)) &libbde_read_ahead_read_run,
+	     (void *) *read_ahead,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *read_ahead != NULL )
+	{
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( ( *read_ahead )->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( ( *read_ahead )->mutex ),
+			 NULL );
+		}
+#endif
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read-ahead
+ * Waits for the worker threads to finish, runs that are still pending are skipped
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_read_ahead_free(
+     libbde_read_ahead_t **read_ahead,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_read_ahead_free";
+	int result            = 1;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_ahead != NULL )
+	{
+		( *read_ahead )->is_stopping = 1;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_thread_pool_join(
+		     &( ( *read_ahead )->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+		if( libcthreads_mutex_free(
+		     &( ( *read_ahead )->mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free mutex.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *read_ahead );
+
+		*read_ahead = NULL;
+	}
+	return( result );
+}
+
+/* Schedules a run of blocks to be read by a worker thread
+ * This function is not multi-thread safe acquire the mutex before call
+ * Returns 1 if successful, 0 if the maximum number of pending runs was reached or -1 on error
+ */
+int libbde_read_ahead_schedule_run(
+     libbde_read_ahead_t *read_ahead,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libbde_read_ahead_run_t *run = NULL;
+	static char *function        = "libbde_read_ahead_schedule_run";
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->number_of_pending_runs >= read_ahead->maximum_number_of_pending_runs )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	run = memory_allocate_structure(
+	       libbde_read_ahead_run_t );
+
+	if( run == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create run.",
+		 function );
+
+		return( -1 );
+	}
+	run->offset = offset;
+	run->size   = size;
+
+	/* The number of pending runs never exceeds the size of the queue
+	 * of the thread pool, hence pushing the run does not block
+	 */
+	if( libcthreads_thread_pool_push(
+	     read_ahead->thread_pool,
+	     (intptr_t *) run,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push run onto thread pool queue.",
+		 function );
+
+		memory_free(
+		 run );
+
+		return( -1 );
+	}
+	read_ahead->number_of_pending_runs += 1;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif
+}
+
+/* Notifies the read-ahead of a read by the reader
+ * Detects sequential and strided access and schedules the blocks
+ * the reader is expected to read next, up to the depth
+ * Returns 1 if blocks are read ahead, 0 if not or -1 on error
+ */
+int libbde_read_ahead_notify_read(
+     libbde_read_ahead_t *read_ahead,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function     = "libbde_read_ahead_notify_read";
+	size64_t maximum_run_size = 0;
+	size64_t run_size         = 0;
+	off64_t run_end_offset    = 0;
+	off64_t run_offset        = 0;
+	off64_t stride            = 0;
+	off64_t target_offset     = 0;
+	off64_t window_end_offset = 0;
+	int is_sequential         = 0;
+	int number_of_blocks      = 0;
+	int read_index            = 0;
+	int result                = 0;
+
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_ahead->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read-ahead - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( read_ahead->last_offset != -1 )
+	{
+		stride = offset - read_ahead->last_offset;
+
+		if( offset == ( read_ahead->last_offset + (off64_t) read_ahead->last_size ) )
+		{
+			is_sequential = 1;
+
+			read_ahead->number_of_matches += 1;
+		}
+		else if( ( stride != 0 )
+		      && ( stride == read_ahead->last_stride ) )
+		{
+			read_ahead->number_of_matches += 1;
+		}
+		else
+		{
+			read_ahead->number_of_matches      = 0;
+			read_ahead->scheduled_block_offset = -1;
+			read_ahead->scheduled_read_offset  = -1;
+		}
+	}
+	read_ahead->last_offset = offset;
+	read_ahead->last_size   = size;
+	read_ahead->last_stride = stride;
+
+	if( read_ahead->number_of_matches >= LIBBDE_READ_AHEAD_MINIMUM_NUMBER_OF_MATCHES )
+	{
+		maximum_run_size = LIBBDE_READ_AHEAD_RUN_SIZE - ( LIBBDE_READ_AHEAD_RUN_SIZE % read_ahead->io_handle->block_size );
+
+		if( maximum_run_size == 0 )
+		{
+			maximum_run_size = read_ahead->io_handle->block_size;
+		}
+		if( is_sequential != 0 )
+		{
+			/* The block that contains the end of the read is read by the reader itself
+			 */
+			read_ahead->scheduled_read_offset = -1;
+
+			run_offset = offset + (off64_t) size;
+
+			if( ( run_offset % read_ahead->io_handle->block_size ) != 0 )
+			{
+				run_offset += read_ahead->io_handle->block_size - ( run_offset % read_ahead->io_handle->block_size );
+			}
+			window_end_offset = run_offset + ( (off64_t) read_ahead->depth * read_ahead->io_handle->block_size );
+
+			if( window_end_offset > (off64_t) read_ahead->io_handle->volume_size )
+			{
+				window_end_offset = (off64_t) read_ahead->io_handle->volume_size;
+			}
+			if( read_ahead->scheduled_block_offset > run_offset )
+			{
+				run_offset = read_ahead->scheduled_block_offset;
+			}
+			while( run_offset < window_end_offset )
+			{
+				run_size = (size64_t) ( window_end_offset - run_offset );
+
+				if( run_size > maximum_run_size )
+				{
+					run_size = maximum_run_size;
+				}
+				result = libbde_read_ahead_schedule_run(
+				          read_ahead,
+				          run_offset,
+				          run_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to schedule run at offset: %" PRIi64 ".",
+					 function,
+					 run_offset );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					break;
+				}
+				run_offset += (off64_t) run_size;
+
+				read_ahead->scheduled_block_offset = run_offset;
+			}
+		}
+		else
+		{
+			read_ahead->scheduled_block_offset = -1;
+
+			/* Both the reads that were scheduled before and the new ones count towards the depth
+			 */
+			for( read_index = 1;
+			     number_of_blocks < read_ahead->depth;
+			     read_index++ )
+			{
+				target_offset = offset + ( (off64_t) read_index * stride );
+
+				if( ( target_offset < 0 )
+				 || ( target_offset >= (off64_t) read_ahead->io_handle->volume_size ) )
+				{
+					break;
+				}
+				run_offset     = target_offset - ( target_offset % read_ahead->io_handle->block_size );
+				run_end_offset = target_offset + (off64_t) size;
+
+				if( ( run_end_offset % read_ahead->io_handle->block_size ) != 0 )
+				{
+					run_end_offset += read_ahead->io_handle->block_size - ( run_end_offset % read_ahead->io_handle->block_size );
+				}
+				if( run_end_offset > (off64_t) read_ahead->io_handle->volume_size )
+				{
+					run_end_offset = (off64_t) read_ahead->io_handle->volume_size;
+				}
+				run_size = (size64_t) ( run_end_offset - run_offset );
+
+				if( run_size > maximum_run_size )
+				{
+					run_size = maximum_run_size;
+				}
+				number_of_blocks += (int) ( ( run_size + read_ahead->io_handle->block_size - 1 ) / read_ahead->io_handle->block_size );
+
+				if( read_ahead->scheduled_read_offset != -1 )
+				{
+					if( ( ( stride > 0 )
+					  && ( target_offset <= read_ahead->scheduled_read_offset ) )
+					 || ( ( stride < 0 )
+					  && ( target_offset >= read_ahead->scheduled_read_offset ) ) )
+					{
+						continue;
+					}
+				}
+				result = libbde_read_ahead_schedule_run(
+				          read_ahead,
+				          run_offset,
+				          run_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to schedule run at offset: %" PRIi64 ".",
+					 function,
+					 run_offset );
+
+					goto on_error;
+				}
+				else if( result == 0 )
+				{
+					break;
+				}
+				read_ahead->scheduled_read_offset = target_offset;
+			}
+		}
+		result = 1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_release(
+	     read_ahead->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release mutex.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 read_ahead->mutex,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads a run of blocks into the sector cache
+ * Callback function for the worker threads, which takes ownership of the run
+ * A run that fails to read is not cached, the reader reports the error when it reads the blocks itself
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_read_ahead_read_run(
+     libbde_read_ahead_run_t *run,
+     libbde_read_ahead_t *read_ahead )
+{
+	libbde_encryption_context_t *encryption_context = NULL;
+	libbde_sector_data_t *sector_data               = NULL;
+	libcerror_error_t *error                        = NULL;
+	static char *function                           = "libbde_read_ahead_read_run";
+	size_t block_data_size                          = 0;
+	size_t data_offset                              = 0;
+	int context_index                               = -1;
+	int result                                      = 1;
+
+	if( run == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid run.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_ahead == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read-ahead.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( read_ahead->is_stopping == 0 )
+	 && ( read_ahead->io_handle->abort == 0 ) )
+	{
+		if( libbde_io_handle_grab_encryption_context(
+		     read_ahead->io_handle,
+		     &context_index,
+		     &encryption_context,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab encryption context.",
+			 function );
+
+			goto on_error;
+		}
+		if( libbde_sector_data_read_block(
+		     &sector_data,
+		     read_ahead->io_handle,
+		     read_ahead->file_io_handle,
+		     run->offset,
+		     run->size,
+		     encryption_context,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sector data at offset: %" PRIi64 ".",
+			 function,
+			 run->offset );
+
+			goto on_error;
+		}
+		if( libbde_io_handle_release_encryption_context(
+		     read_ahead->io_handle,
+		     context_index,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release encryption context.",
+			 function );
+
+			context_index = -1;
+
+			goto on_error;
+		}
+		context_index = -1;
+
+		for( data_offset = 0;
+		     data_offset < sector_data->data_size;
+		     data_offset += block_data_size )
+		{
+			block_data_size = sector_data->data_size - data_offset;
+
+			if( block_data_size > read_ahead->io_handle->block_size )
+			{
+				block_data_size = read_ahead->io_handle->block_size;
+			}
+			if( libbde_sector_cache_set_data(
+			     read_ahead->sector_cache,
+			     run->offset + (off64_t) data_offset,
+			     &( ( sector_data->data )[ data_offset ] ),
+			     block_data_size,
+			     &error ) != 1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set sector data at offset: %" PRIi64 " in cache.",
+				 function,
+				 run->offset + (off64_t) data_offset );
+
+				goto on_error;
+			}
+		}
+		if( libbde_sector_data_free(
+		     &sector_data,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sector data.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	goto on_exit;
+
+on_error:
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+	}
+#endif
+	libcerror_error_free(
+	 &error );
+
+	if( sector_data != NULL )
+	{
+		libbde_sector_data_free(
+		 &sector_data,
+		 NULL );
+	}
+	if( context_index != -1 )
+	{
+		libbde_io_handle_release_encryption_context(
+		 read_ahead->io_handle,
+		 context_index,
+		 NULL );
+	}
+	result = -1;
+
+on_exit:
+	if( run != NULL )
+	{
+		memory_free(
+		 run );
+
+		if( read_ahead != NULL )
+		{
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+			libcthreads_mutex_grab(
+			 read_ahead->mutex,
+			 NULL );
+#endif
+			read_ahead->number_of_pending_runs -= 1;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+			libcthreads_mutex_release(
+			 read_ahead->mutex,
+			 NULL );
+#endif
+		}
+	}
+	return( result );
+}
+
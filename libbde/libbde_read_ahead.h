@@ -0,0 +1,151 @@
+/*
+ * Read-ahead functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_READ_AHEAD_H )
+#define _LIBBDE_READ_AHEAD_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_io_handle.h"
+#include "libbde_libbfio.h"
+#include "libbde_libcerror.h"
+#include "libbde_libcthreads.h"
+#include "libbde_sector_cache.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbde_read_ahead_run libbde_read_ahead_run_t;
+
+struct libbde_read_ahead_run
+{
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size64_t size;
+};
+
+typedef struct libbde_read_ahead libbde_read_ahead_t;
+
+struct libbde_read_ahead
+{
+	/* The IO handle
+	 */
+	libbde_io_handle_t *io_handle;
+
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The sector cache the blocks are read into
+	 */
+	libbde_sector_cache_t *sector_cache;
+
+	/* The depth, which is the number of blocks read ahead of the reader
+	 */
+	int depth;
+
+	/* The offset of the previous read
+	 */
+	off64_t last_offset;
+
+	/* The size of the previous read
+	 */
+	size_t last_size;
+
+	/* The distance between the offsets of the previous two reads
+	 */
+	off64_t last_stride;
+
+	/* The number of consecutive reads that matched the access pattern
+	 */
+	int number_of_matches;
+
+	/* The offset up to which blocks were scheduled for a sequential access pattern
+	 */
+	off64_t scheduled_block_offset;
+
+	/* The offset of the last read scheduled for a strided access pattern
+	 */
+	off64_t scheduled_read_offset;
+
+	/* The number of runs that are scheduled but not yet read
+	 */
+	int number_of_pending_runs;
+
+	/* The maximum number of runs that can be pending
+	 */
+	int maximum_number_of_pending_runs;
+
+	/* Value to indicate the pending runs should be skipped
+	 */
+	int is_stopping;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	/* The thread pool of the workers
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+
+	/* The mutex that guards the access pattern and pending runs
+	 */
+	libcthreads_mutex_t *mutex;
+#endif
+};
+
+int libbde_read_ahead_initialize(
+     libbde_read_ahead_t **read_ahead,
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libbde_sector_cache_t *sector_cache,
+     int depth,
+     libcerror_error_t **error );
+
+int libbde_read_ahead_free(
+     libbde_read_ahead_t **read_ahead,
+     libcerror_error_t **error );
+
+int libbde_read_ahead_schedule_run(
+     libbde_read_ahead_t *read_ahead,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int libbde_read_ahead_notify_read(
+     libbde_read_ahead_t *read_ahead,
+     off64_t offset,
+     size_t size,
+     libcerror_error_t **error );
+
+int libbde_read_ahead_read_run(
+     libbde_read_ahead_run_t *run,
+     libbde_read_ahead_t *read_ahead );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_READ_AHEAD_H ) */
+
@@ -0,0 +1,731 @@
+/*
+ * Read pool functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_definitions.h"
+#include "libbde_encryption.h"
+#include "libbde_io_handle.h"
+#include "libbde_libbfio.h"
+#include "libbde_libcerror.h"
+#include "libbde_libcnotify.h"
+#include "libbde_libcthreads.h"
+#include "libbde_read_pool.h"
+#include "libbde_sector_data.h"
+
+/* Creates a read pool
+ * The read pool splits large reads into chunks that are read and decrypted by worker threads
+ * Make sure the value read_pool is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_read_pool_initialize(
+     libbde_read_pool_t **read_pool,
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_read_pool_initialize";
+
+	if( read_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid read pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads <= 0 )
+	 || ( number_of_threads > LIBBDE_MAXIMUM_NUMBER_OF_DECRYPTION_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*read_pool = memory_allocate_structure(
+	              libbde_read_pool_t );
+
+	if( *read_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *read_pool,
+	     0,
+	     sizeof( libbde_read_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear read pool.",
+		 function );
+
+		memory_free(
+		 *read_pool );
+
+		*read_pool = NULL;
+
+		return( -1 );
+	}
+	( *read_pool )->io_handle         = io_handle;
+	( *read_pool )->file_io_handle    = file_io_handle;
+	( *read_pool )->number_of_threads = number_of_threads;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_thread_pool_create(
+	     &( ( *read_pool )->thread_pool ),
+	     NULL,
+	     number_of_threads,
+	     number_of_threads * 4,
+	     (int (*)(intptr_t *, void *)) &libbde_read_pool_read_chunk,
+	     (void *) *read_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create thread pool.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *read_pool != NULL )
+	{
+		memory_free(
+		 *read_pool );
+
+		*read_pool = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a read pool
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_read_pool_free(
+     libbde_read_pool_t **read_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_read_pool_free";
+	int result            = 1;
+
+	if( read_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *read_pool != NULL )
+	{
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_thread_pool_join(
+		     &( ( *read_pool )->thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join thread pool.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		memory_free(
+		 *read_pool );
+
+		*read_pool = NULL;
+	}
+	return( result );
+}
+
+/* Reads and decrypts sector aligned data into a buffer
+ * The buffer is split into chunks that are read and decrypted concurrently,
+ * this function returns after all chunks have been read
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_read_pool_read_buffer(
+     libbde_read_pool_t *read_pool,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	static char *function                           = "libbde_read_pool_read_buffer";
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libbde_read_pool_batch_t *batch                 = NULL;
+	libbde_read_pool_chunk_t *chunks                = NULL;
+	size_t buffer_offset                            = 0;
+	int chunk_index                                 = 0;
+	int number_of_chunks                            = 0;
+	int result                                      = 1;
+#else
+	libbde_encryption_context_t *encryption_context = NULL;
+	int context_index                               = -1;
+#endif
+
+	if( read_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_pool->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read pool - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( read_pool->io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid read pool - invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( ( offset % read_pool->io_handle->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( buffer_size == 0 )
+	 || ( buffer_size > (size_t) SSIZE_MAX )
+	 || ( ( buffer_size % read_pool->io_handle->bytes_per_sector ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	number_of_chunks = (int) ( buffer_size / LIBBDE_READ_POOL_CHUNK_SIZE );
+
+	if( ( buffer_size % LIBBDE_READ_POOL_CHUNK_SIZE ) != 0 )
+	{
+		number_of_chunks += 1;
+	}
+	batch = memory_allocate_structure(
+	         libbde_read_pool_batch_t );
+
+	if( batch == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create batch.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     batch,
+	     0,
+	     sizeof( libbde_read_pool_batch_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear batch.",
+		 function );
+
+		memory_free(
+		 batch );
+
+		return( -1 );
+	}
+	chunks = (libbde_read_pool_chunk_t *) memory_allocate(
+	                                       sizeof( libbde_read_pool_chunk_t ) * number_of_chunks );
+
+	if( chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunks.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_mutex_initialize(
+	     &( batch->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create batch mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_condition_initialize(
+	     &( batch->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create batch condition.",
+		 function );
+
+		goto on_error;
+	}
+	batch->number_of_pending_chunks = number_of_chunks;
+
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		chunks[ chunk_index ].batch     = batch;
+		chunks[ chunk_index ].offset    = offset + (off64_t) buffer_offset;
+		chunks[ chunk_index ].data      = &( buffer[ buffer_offset ] );
+		chunks[ chunk_index ].data_size = buffer_size - buffer_offset;
+
+		if( chunks[ chunk_index ].data_size > LIBBDE_READ_POOL_CHUNK_SIZE )
+		{
+			chunks[ chunk_index ].data_size = LIBBDE_READ_POOL_CHUNK_SIZE;
+		}
+		buffer_offset += chunks[ chunk_index ].data_size;
+
+		/* The push waits while the queue is full, which limits the number of chunks in flight
+		 */
+		if( libcthreads_thread_pool_push(
+		     read_pool->thread_pool,
+		     (intptr_t *) &( chunks[ chunk_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk: %d onto thread pool queue.",
+			 function,
+			 chunk_index );
+
+			result = -1;
+
+			break;
+		}
+	}
+	/* Wait for the chunks that were pushed before the chunks can be freed
+	 */
+	if( libcthreads_mutex_grab(
+	     batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab batch mutex.",
+		 function );
+
+		goto on_error;
+	}
+	batch->number_of_pending_chunks -= number_of_chunks - chunk_index;
+
+	while( batch->number_of_pending_chunks > 0 )
+	{
+		if( libcthreads_condition_wait(
+		     batch->condition,
+		     batch->mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to wait for batch condition.",
+			 function );
+
+			libcthreads_mutex_release(
+			 batch->mutex,
+			 NULL );
+
+			goto on_error;
+		}
+	}
+	if( libcthreads_mutex_release(
+	     batch->mutex,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release batch mutex.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( result == 1 )
+	 && ( batch->has_failed != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read chunk(s) at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		result = -1;
+	}
+	if( libcthreads_condition_free(
+	     &( batch->condition ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free batch condition.",
+		 function );
+
+		result = -1;
+	}
+	if( libcthreads_mutex_free(
+	     &( batch->mutex ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free batch mutex.",
+		 function );
+
+		result = -1;
+	}
+	memory_free(
+	 chunks );
+
+	memory_free(
+	 batch );
+
+	return( result );
+
+on_error:
+	/* Chunks that are still pending reference the batch and chunks,
+	 * hence these cannot be freed
+	 */
+	if( ( batch != NULL )
+	 && ( batch->number_of_pending_chunks == 0 ) )
+	{
+		if( batch->condition != NULL )
+		{
+			libcthreads_condition_free(
+			 &( batch->condition ),
+			 NULL );
+		}
+		if( batch->mutex != NULL )
+		{
+			libcthreads_mutex_free(
+			 &( batch->mutex ),
+			 NULL );
+		}
+		if( chunks != NULL )
+		{
+			memory_free(
+			 chunks );
+		}
+		memory_free(
+		 batch );
+	}
+	return( -1 );
+#else
+	if( libbde_io_handle_grab_encryption_context(
+	     read_pool->io_handle,
+	     &context_index,
+	     &encryption_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab encryption context.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_sector_data_read_buffer(
+	     read_pool->io_handle,
+	     read_pool->file_io_handle,
+	     offset,
+	     buffer,
+	     buffer,
+	     buffer_size,
+	     encryption_context,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sector data at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		libbde_io_handle_release_encryption_context(
+		 read_pool->io_handle,
+		 context_index,
+		 NULL );
+
+		return( -1 );
+	}
+	if( libbde_io_handle_release_encryption_context(
+	     read_pool->io_handle,
+	     context_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release encryption context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+#endif
+}
+
+/* Reads and decrypts a chunk
+ * Callback function for the worker threads
+ * The chunk is skipped if another chunk of the same batch failed or abort was signalled
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_read_pool_read_chunk(
+     libbde_read_pool_chunk_t *chunk,
+     libbde_read_pool_t *read_pool )
+{
+	libbde_encryption_context_t *encryption_context = NULL;
+	libcerror_error_t *error                        = NULL;
+	static char *function                           = "libbde_read_pool_read_chunk";
+	int context_index                               = -1;
+	int result                                      = 1;
+
+	if( chunk == NULL )
+	{
+		return( -1 );
+	}
+	if( read_pool == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid read pool.",
+		 function );
+
+		result = -1;
+	}
+	else if( ( chunk->batch->has_failed != 0 )
+	      || ( read_pool->io_handle->abort != 0 ) )
+	{
+		result = -1;
+	}
+	else if( libbde_io_handle_grab_encryption_context(
+	          read_pool->io_handle,
+	          &context_index,
+	          &encryption_context,
+	          &error ) != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab encryption context.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		if( libbde_sector_data_read_buffer(
+		     read_pool->io_handle,
+		     read_pool->file_io_handle,
+		     chunk->offset,
+		     chunk->data,
+		     chunk->data,
+		     chunk->data_size,
+		     encryption_context,
+		     1,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sector data at offset: %" PRIi64 ".",
+			 function,
+			 chunk->offset );
+
+			result = -1;
+		}
+		if( libbde_io_handle_release_encryption_context(
+		     read_pool->io_handle,
+		     context_index,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release encryption context.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( error != NULL )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_grab(
+	 chunk->batch->mutex,
+	 NULL );
+#endif
+	if( result != 1 )
+	{
+		chunk->batch->has_failed = 1;
+	}
+	chunk->batch->number_of_pending_chunks -= 1;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( chunk->batch->number_of_pending_chunks == 0 )
+	{
+		libcthreads_condition_signal(
+		 chunk->batch->condition,
+		 NULL );
+	}
+	libcthreads_mutex_release(
+	 chunk->batch->mutex,
+	 NULL );
+#endif
+	return( result );
+}
+
@@ -0,0 +1,131 @@
+/*
+ * Read pool functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_READ_POOL_H )
+#define _LIBBDE_READ_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_io_handle.h"
+#include "libbde_libbfio.h"
+#include "libbde_libcerror.h"
+#include "libbde_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbde_read_pool_batch libbde_read_pool_batch_t;
+
+struct libbde_read_pool_batch
+{
+	/* The number of chunks that are not yet read
+	 */
+	int number_of_pending_chunks;
+
+	/* Value to indicate a chunk failed to read
+	 */
+	int has_failed;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	/* The mutex that guards the batch
+	 */
+	libcthreads_mutex_t *mutex;
+
+	/* The condition that is signalled when all chunks are read
+	 */
+	libcthreads_condition_t *condition;
+#endif
+};
+
+typedef struct libbde_read_pool_chunk libbde_read_pool_chunk_t;
+
+struct libbde_read_pool_chunk
+{
+	/* The batch the chunk is part of
+	 */
+	libbde_read_pool_batch_t *batch;
+
+	/* The offset
+	 */
+	off64_t offset;
+
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+};
+
+typedef struct libbde_read_pool libbde_read_pool_t;
+
+struct libbde_read_pool
+{
+	/* The IO handle
+	 */
+	libbde_io_handle_t *io_handle;
+
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* The number of worker threads
+	 */
+	int number_of_threads;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	/* The thread pool of the workers
+	 */
+	libcthreads_thread_pool_t *thread_pool;
+#endif
+};
+
+int libbde_read_pool_initialize(
+     libbde_read_pool_t **read_pool,
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libbde_read_pool_free(
+     libbde_read_pool_t **read_pool,
+     libcerror_error_t **error );
+
+int libbde_read_pool_read_buffer(
+     libbde_read_pool_t *read_pool,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libbde_read_pool_read_chunk(
+     libbde_read_pool_chunk_t *chunk,
+     libbde_read_pool_t *read_pool );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_READ_POOL_H ) */
+
@@ -26,164 +26,315 @@
 
 #include "libbde_libcerror.h"
 #include "libbde_libcnotify.h"
-#include "libbde_libfvalue.h"
 #include "libbde_libhmac.h"
 #include "libbde_recovery.h"
 
-/* Calculates the SHA256 hash of an UTF-8 formatted recovery password
+/* Copies a recovery password from a string
+ * The string consists of 8 groups of 6 decimal digits separated by a - character
+ * Each group must be divisible by 11 and the result of the division must fit in 16 bits
+ * The string is parsed in a single pass without allocating memory
+ * The character size is 1 for an UTF-8 string or 2 for an UTF-16 string
  * Returns 1 if successful, 0 if recovery password is invalid or -1 on error
  */
-int libbde_utf8_recovery_password_calculate_hash(
-     const uint8_t *utf8_string,
-     size_t utf8_string_length,
-     uint8_t *recovery_password_hash,
-     size_t recovery_password_hash_size,
+int libbde_recovery_password_copy_from_string(
+     const uint8_t *string,
+     size_t string_length,
+     size_t character_size,
+     uint8_t *binary_recovery_password,
+     size_t binary_recovery_password_size,
      libcerror_error_t **error )
 {
-	uint8_t binary_recovery_password[ 16 ];
-
-	libfvalue_split_utf8_string_t *split_string = NULL;
-	uint8_t *string_segment                     = NULL;
-	static char *function                       = "libbde_utf8_recovery_password_calculate_hash";
-	size_t string_segment_index                 = 0;
-	size_t string_segment_size                  = 0;
-	uint64_t value_64bit                        = 0;
-	int number_of_segments                      = 0;
-	int result                                  = 0;
-	int segment_index                           = 0;
-
-	if( recovery_password_hash == NULL )
+	static char *function    = "libbde_recovery_password_copy_from_string";
+	size_t string_index      = 0;
+	uint32_t character_value = 0;
+	uint32_t segment_value   = 0;
+	int number_of_digits     = 0;
+	int segment_index        = 0;
+
+	if( string == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid recovery password hash.",
+		 "%s: invalid string.",
 		 function );
 
 		return( -1 );
 	}
-	if( recovery_password_hash_size != 32 )
+	if( string_length > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: recovery password hash size value out of bounds.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid string length value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( libfvalue_utf8_string_split(
-	     utf8_string,
-	     utf8_string_length + 1,
-	     (uint8_t) '-',
- 	     &split_string,
- 	     error ) != 1 )
+	if( ( character_size != 1 )
+	 && ( character_size != 2 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to split string.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported character size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_get_number_of_segments(
-	     split_string,
-	     &number_of_segments,
-	     error ) != 1 )
+	if( binary_recovery_password == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments in split string.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid binary recovery password.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	/* The recovery password consists of 8 segments
+	if( binary_recovery_password_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: binary recovery password size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Ignore the end-of-string character
 	 */
-	if( number_of_segments == 8 )
+	if( string_length == 56 )
 	{
-		for( segment_index = 0;
-		     segment_index < number_of_segments;
-		     segment_index++ )
+		if( character_size == 1 )
 		{
-			if( libfvalue_split_utf8_string_get_segment_by_index(
-			     split_string,
-			     segment_index,
-			     &string_segment,
-			     &string_segment_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve segment: %d from split string.",
-				 function,
-				 segment_index );
-
-				goto on_error;
-			}
-			string_segment_index = 0;
-
-			if( libfvalue_utf8_string_with_index_copy_to_integer(
-			     string_segment,
-			     string_segment_size,
-			     &string_segment_index,
-			     &value_64bit,
-			     16,
-			     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine binary value for segment: %d from split string.",
-				 function,
-				 segment_index );
-
-				goto on_error;
-			}
-			/* A recovery password segment should be dividable by 11
-			 */
-			if( ( value_64bit % 11 ) != 0 )
+			character_value = string[ 55 ];
+		}
+		else
+		{
+			character_value = ( (const uint16_t *) string )[ 55 ];
+		}
+		if( character_value == 0 )
+		{
+			string_length--;
+		}
+	}
+	/* The recovery password consists of 8 groups of 6 digits and 7 separators
+	 */
+	if( string_length != 55 )
+	{
+		return( 0 );
+	}
+	for( string_index = 0;
+	     string_index <= string_length;
+	     string_index++ )
+	{
+		if( string_index == string_length )
+		{
+			character_value = (uint32_t) '-';
+		}
+		else if( character_size == 1 )
+		{
+			character_value = string[ string_index ];
+		}
+		else
+		{
+			character_value = ( (const uint16_t *) string )[ string_index ];
+		}
+		if( ( character_value >= (uint32_t) '0' )
+		 && ( character_value <= (uint32_t) '9' ) )
+		{
+			if( number_of_digits >= 6 )
 			{
 				break;
 			}
-			value_64bit /= 11;
+			segment_value *= 10;
+			segment_value += character_value - (uint32_t) '0';
 
-			/* A recovery password segment / 11 should be <= 65535 (0xffff)
-			 */
-			if( value_64bit > (uint64_t) UINT16_MAX )
-			{
-				break;
-			}
-			byte_stream_copy_from_uint16_little_endian(
-			 &( binary_recovery_password[ segment_index * 2 ] ),
-			 value_64bit );
+			number_of_digits++;
+
+			continue;
+		}
+		if( ( character_value != (uint32_t) '-' )
+		 || ( number_of_digits != 6 ) )
+		{
+			break;
 		}
-		result = 1;
+		/* A recovery password segment should be dividable by 11
+		 */
+		if( ( segment_value % 11 ) != 0 )
+		{
+			break;
+		}
+		segment_value /= 11;
+
+		/* A recovery password segment / 11 should be <= 65535 (0xffff)
+		 */
+		if( segment_value > (uint32_t) UINT16_MAX )
+		{
+			break;
+		}
+		byte_stream_copy_from_uint16_little_endian(
+		 &( binary_recovery_password[ segment_index * 2 ] ),
+		 segment_value );
+
+		segment_index++;
+
+		segment_value    = 0;
+		number_of_digits = 0;
+	}
+	if( string_index <= string_length )
+	{
+		if( memory_set(
+		     binary_recovery_password,
+		     0,
+		     16 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear binary recovery password.",
+			 function );
+
+			return( -1 );
+		}
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Copies a recovery password from an UTF-8 string
+ * Returns 1 if successful, 0 if recovery password is invalid or -1 on error
+ */
+int libbde_recovery_password_copy_from_utf8_string(
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint8_t *binary_recovery_password,
+     size_t binary_recovery_password_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_recovery_password_copy_from_utf8_string";
+	int result            = 0;
+
+	result = libbde_recovery_password_copy_from_string(
+	          utf8_string,
+	          utf8_string_length,
+	          1,
+	          binary_recovery_password,
+	          binary_recovery_password_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy recovery password from string.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Copies a recovery password from an UTF-16 string
+ * Returns 1 if successful, 0 if recovery password is invalid or -1 on error
+ */
+int libbde_recovery_password_copy_from_utf16_string(
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     uint8_t *binary_recovery_password,
+     size_t binary_recovery_password_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_recovery_password_copy_from_utf16_string";
+	int result            = 0;
+
+	result = libbde_recovery_password_copy_from_string(
+	          (const uint8_t *) utf16_string,
+	          utf16_string_length,
+	          2,
+	          binary_recovery_password,
+	          binary_recovery_password_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy recovery password from string.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Calculates the SHA256 hash of an UTF-8 formatted recovery password
+ * Returns 1 if successful, 0 if recovery password is invalid or -1 on error
+ */
+int libbde_utf8_recovery_password_calculate_hash(
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint8_t *recovery_password_hash,
+     size_t recovery_password_hash_size,
+     libcerror_error_t **error )
+{
+	uint8_t binary_recovery_password[ 16 ];
+
+	static char *function = "libbde_utf8_recovery_password_calculate_hash";
+	int result            = 0;
+
+	if( recovery_password_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid recovery password hash.",
+		 function );
+
+		return( -1 );
 	}
-	if( libfvalue_split_utf8_string_free(
-	     &split_string,
-	     error ) != 1 )
+	if( recovery_password_hash_size != 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: recovery password hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbde_recovery_password_copy_from_utf8_string(
+	          utf8_string,
+	          utf8_string_length,
+	          binary_recovery_password,
+	          16,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split string.",
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy binary recovery password.",
 		 function );
 
 		goto on_error;
 	}
-	if( result == 1 )
+	else if( result != 0 )
 	{
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
@@ -231,12 +382,6 @@ int libbde_utf8_recovery_password_calculate_hash(
 	return( result );
 
 on_error:
-	if( split_string != NULL )
-	{
-		libfvalue_split_utf8_string_free(
-		 &split_string,
-		 NULL );
-	}
 	memory_set(
 	 binary_recovery_password,
 	 0,
@@ -257,15 +402,8 @@ int libbde_utf16_recovery_password_calculate_hash(
 {
 	uint8_t binary_recovery_password[ 16 ];
 
-	libfvalue_split_utf16_string_t *split_string = NULL;
-	uint16_t *string_segment                     = NULL;
-	static char *function                        = "libbde_utf16_recovery_password_calculate_hash";
-	size_t string_segment_index                  = 0;
-	size_t string_segment_size                   = 0;
-	uint64_t value_64bit                         = 0;
-	int number_of_segments                       = 0;
-	int result                                   = 0;
-	int segment_index                            = 0;
+	static char *function = "libbde_utf16_recovery_password_calculate_hash";
+	int result            = 0;
 
 	if( recovery_password_hash == NULL )
 	{
@@ -289,116 +427,25 @@ int libbde_utf16_recovery_password_calculate_hash(
 
 		return( -1 );
 	}
-	if( libfvalue_utf16_string_split(
-	     utf16_string,
-	     utf16_string_length + 1,
-	     (uint16_t) '-',
- 	     &split_string,
- 	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to split string.",
-		 function );
-
-		goto on_error;
-	}
-	if( libfvalue_split_utf16_string_get_number_of_segments(
-	     split_string,
-	     &number_of_segments,
-	     error ) != 1 )
+	result = libbde_recovery_password_copy_from_utf16_string(
+	          utf16_string,
+	          utf16_string_length,
+	          binary_recovery_password,
+	          16,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of segments in split string.",
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy binary recovery password.",
 		 function );
 
 		goto on_error;
 	}
-	/* The recovery password consists of 8 segments
-	 */
-	if( number_of_segments == 8 )
-	{
-		for( segment_index = 0;
-		     segment_index < number_of_segments;
-		     segment_index++ )
-		{
-			if( libfvalue_split_utf16_string_get_segment_by_index(
-			     split_string,
-			     segment_index,
-			     &string_segment,
-			     &string_segment_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to retrieve segment: %d from split string.",
-				 function,
-				 segment_index );
-
-				goto on_error;
-			}
-			string_segment_index = 0;
-
-			if( libfvalue_utf16_string_with_index_copy_to_integer(
-			     string_segment,
-			     string_segment_size,
-			     &string_segment_index,
-			     &value_64bit,
-			     16,
-			     LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine binary value for segment: %d from split string.",
-				 function,
-				 segment_index );
-
-				goto on_error;
-			}
-			/* A recovery password segment should be dividable by 11
-			 */
-			if( ( value_64bit % 11 ) != 0 )
-			{
-				break;
-			}
-			value_64bit /= 11;
-
-			/* A recovery password segment / 11 should be <= 65535 (0xffff)
-			 */
-			if( value_64bit > (uint64_t) UINT16_MAX )
-			{
-				break;
-			}
-			byte_stream_copy_from_uint16_little_endian(
-			 &( binary_recovery_password[ segment_index * 2 ] ),
-			 value_64bit );
-		}
-		result = 1;
-	}
-	if( libfvalue_split_utf16_string_free(
-	     &split_string,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free split string.",
-		 function );
-
-		goto on_error;
-	}
-	if( result == 1 )
+	else if( result != 0 )
 	{
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
@@ -446,12 +493,6 @@ int libbde_utf16_recovery_password_calculate_hash(
 	return( result );
 
 on_error:
-	if( split_string != NULL )
-	{
-		libfvalue_split_utf16_string_free(
-		 &split_string,
-		 NULL );
-	}
 	memory_set(
 	 binary_recovery_password,
 	 0,
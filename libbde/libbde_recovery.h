@@ -32,6 +32,28 @@
 extern "C" {
 #endif
 
+int libbde_recovery_password_copy_from_string(
+     const uint8_t *string,
+     size_t string_length,
+     size_t character_size,
+     uint8_t *binary_recovery_password,
+     size_t binary_recovery_password_size,
+     libcerror_error_t **error );
+
+int libbde_recovery_password_copy_from_utf8_string(
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint8_t *binary_recovery_password,
+     size_t binary_recovery_password_size,
+     libcerror_error_t **error );
+
+int libbde_recovery_password_copy_from_utf16_string(
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     uint8_t *binary_recovery_password,
+     size_t binary_recovery_password_size,
+     libcerror_error_t **error );
+
 int libbde_utf8_recovery_password_calculate_hash(
      const uint8_t *utf8_string,
      size_t utf8_string_length,
@@ -0,0 +1,450 @@
+/*
+ * Region table functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_definitions.h"
+#include "libbde_libcerror.h"
+#include "libbde_region_table.h"
+
+/* Clears a region table
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_region_table_clear(
+     libbde_region_table_t *region_table,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_region_table_clear";
+
+	if( region_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid region table.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     region_table,
+	     0,
+	     sizeof( libbde_region_table_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear region table.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Appends a region to the region table
+ * The region must directly follow the last region, if it has the same sector type
+ * and its data directly follows the data of the last region the last region is extended
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_region_table_append_region(
+     libbde_region_table_t *region_table,
+     off64_t offset,
+     size64_t size,
+     off64_t data_offset,
+     uint8_t sector_type,
+     libcerror_error_t **error )
+{
+	libbde_region_t *region = NULL;
+	static char *function   = "libbde_region_table_append_region";
+
+	if( region_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid region table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size == 0 )
+	 || ( size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( region_table->number_of_regions == 0 )
+	{
+		region_table->offset = offset;
+	}
+	else if( offset != ( region_table->offset + (off64_t) region_table->size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported offset value does not follow last region.",
+		 function );
+
+		return( -1 );
+	}
+	if( region_table->number_of_regions > 0 )
+	{
+		region = &( region_table->regions[ region_table->number_of_regions - 1 ] );
+
+		if( ( region->sector_type == sector_type )
+		 && ( ( region->data_offset + (off64_t) region->size ) == data_offset ) )
+		{
+			region->size       += size;
+			region_table->size += size;
+
+			return( 1 );
+		}
+	}
+	if( region_table->number_of_regions >= LIBBDE_REGION_TABLE_MAXIMUM_NUMBER_OF_REGIONS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid region table - number of regions value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	region = &( region_table->regions[ region_table->number_of_regions ] );
+
+	region->offset      = offset;
+	region->size        = size;
+	region->data_offset = data_offset;
+	region->sector_type = sector_type;
+
+	region_table->number_of_regions += 1;
+	region_table->size              += size;
+
+	return( 1 );
+}
+
+/* Retrieves the number of regions
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_region_table_get_number_of_regions(
+     libbde_region_table_t *region_table,
+     int *number_of_regions,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_region_table_get_number_of_regions";
+
+	if( region_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid region table.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_regions == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of regions.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_regions = region_table->number_of_regions;
+
+	return( 1 );
+}
+
+/* Retrieves a specific region
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_region_table_get_region_by_index(
+     libbde_region_table_t *region_table,
+     int region_index,
+     libbde_region_t **region,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_region_table_get_region_by_index";
+
+	if( region_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid region table.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( region_index < 0 )
+	 || ( region_index >= region_table->number_of_regions ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid region index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( region == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid region.",
+		 function );
+
+		return( -1 );
+	}
+	*region = &( region_table->regions[ region_index ] );
+
+	return( 1 );
+}
+
+/* Finds the index of the region that contains a specific offset
+ * The regions are sorted by offset and are searched with a binary search
+ * Returns 1 if successful, 0 if no such region or -1 on error
+ */
+int libbde_region_table_find_region_index(
+     libbde_region_table_t *region_table,
+     off64_t offset,
+     int *region_index,
+     libcerror_error_t **error )
+{
+	libbde_region_t *region = NULL;
+	static char *function   = "libbde_region_table_find_region_index";
+	int first_index         = 0;
+	int last_index          = 0;
+	int middle_index        = 0;
+
+	if( region_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid region table.",
+		 function );
+
+		return( -1 );
+	}
+	if( region_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid region index.",
+		 function );
+
+		return( -1 );
+	}
+	first_index = 0;
+	last_index  = region_table->number_of_regions - 1;
+
+	while( first_index <= last_index )
+	{
+		middle_index = first_index + ( ( last_index - first_index ) / 2 );
+		region       = &( region_table->regions[ middle_index ] );
+
+		if( offset < region->offset )
+		{
+			last_index = middle_index - 1;
+		}
+		else if( offset >= ( region->offset + (off64_t) region->size ) )
+		{
+			first_index = middle_index + 1;
+		}
+		else
+		{
+			*region_index = middle_index;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Determines if a range overlaps a region of a specific sector type
+ * Returns 1 if the range overlaps such a region, 0 if not or -1 on error
+ */
+int libbde_region_table_range_has_sector_type(
+     libbde_region_table_t *region_table,
+     off64_t offset,
+     size64_t size,
+     uint8_t sector_type,
+     libcerror_error_t **error )
+{
+	libbde_region_t *region = NULL;
+	static char *function   = "libbde_region_table_range_has_sector_type";
+	int region_index        = 0;
+
+	if( region_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid region table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size64_t) ( INT64_MAX - offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( region_index = 0;
+	     region_index < region_table->number_of_regions;
+	     region_index++ )
+	{
+		region = &( region_table->regions[ region_index ] );
+
+		if( region->sector_type != sector_type )
+		{
+			continue;
+		}
+		if( ( region->offset < ( offset + (off64_t) size ) )
+		 && ( offset < ( region->offset + (off64_t) region->size ) ) )
+		{
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Retrieves the flags of a region
+ * The flags are a combination of LIBBDE_REGION_FLAGS
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_region_get_flags(
+     libbde_region_t *region,
+     uint32_t *flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_region_get_flags";
+
+	if( region == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid region.",
+		 function );
+
+		return( -1 );
+	}
+	if( flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid flags.",
+		 function );
+
+		return( -1 );
+	}
+	switch( region->sector_type )
+	{
+		case LIBBDE_SECTOR_DATA_TYPE_ZERO:
+			*flags = LIBBDE_REGION_FLAG_METADATA;
+			break;
+
+		case LIBBDE_SECTOR_DATA_TYPE_UNENCRYPTED:
+			*flags = LIBBDE_REGION_FLAG_UNENCRYPTED;
+			break;
+
+		case LIBBDE_SECTOR_DATA_TYPE_ENCRYPTED:
+			*flags = LIBBDE_REGION_FLAG_ENCRYPTED;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported sector type: %" PRIu8 ".",
+			 function,
+			 region->sector_type );
+
+			return( -1 );
+	}
+	if( region->data_offset != region->offset )
+	{
+		*flags |= LIBBDE_REGION_FLAG_RELOCATED;
+	}
+	return( 1 );
+}
+
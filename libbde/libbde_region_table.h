@@ -0,0 +1,128 @@
+/*
+ * Region table functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_REGION_TABLE_H )
+#define _LIBBDE_REGION_TABLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of regions
+ * A volume has at most 12 boundaries at which the sector type
+ * or the location of the data changes
+ */
+#define LIBBDE_REGION_TABLE_MAXIMUM_NUMBER_OF_REGIONS	16
+
+typedef struct libbde_region libbde_region_t;
+
+struct libbde_region
+{
+	/* The (volume) offset
+	 */
+	off64_t offset;
+
+	/* The size
+	 */
+	size64_t size;
+
+	/* The data offset, which is the offset of the data in the file
+	 */
+	off64_t data_offset;
+
+	/* The sector type
+	 */
+	uint8_t sector_type;
+};
+
+typedef struct libbde_region_table libbde_region_table_t;
+
+struct libbde_region_table
+{
+	/* The regions, sorted by offset
+	 */
+	libbde_region_t regions[ LIBBDE_REGION_TABLE_MAXIMUM_NUMBER_OF_REGIONS ];
+
+	/* The number of regions
+	 */
+	int number_of_regions;
+
+	/* The offset of the first region
+	 */
+	off64_t offset;
+
+	/* The combined size of the regions
+	 */
+	size64_t size;
+};
+
+int libbde_region_table_clear(
+     libbde_region_table_t *region_table,
+     libcerror_error_t **error );
+
+int libbde_region_table_append_region(
+     libbde_region_table_t *region_table,
+     off64_t offset,
+     size64_t size,
+     off64_t data_offset,
+     uint8_t sector_type,
+     libcerror_error_t **error );
+
+int libbde_region_table_get_number_of_regions(
+     libbde_region_table_t *region_table,
+     int *number_of_regions,
+     libcerror_error_t **error );
+
+int libbde_region_table_get_region_by_index(
+     libbde_region_table_t *region_table,
+     int region_index,
+     libbde_region_t **region,
+     libcerror_error_t **error );
+
+int libbde_region_table_find_region_index(
+     libbde_region_table_t *region_table,
+     off64_t offset,
+     int *region_index,
+     libcerror_error_t **error );
+
+int libbde_region_table_range_has_sector_type(
+     libbde_region_table_t *region_table,
+     off64_t offset,
+     size64_t size,
+     uint8_t sector_type,
+     libcerror_error_t **error );
+
+int libbde_region_get_flags(
+     libbde_region_t *region,
+     uint32_t *flags,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_REGION_TABLE_H ) */
+
@@ -0,0 +1,904 @@
+/*
+ * Sector cache functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_definitions.h"
+#include "libbde_libcerror.h"
+#include "libbde_libcthreads.h"
+#include "libbde_sector_cache.h"
+
+/* Creates a sector cache
+ * The cache holds as many blocks as fit in the cache size, divided over a number of shards
+ * Make sure the value sector_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sector_cache_initialize(
+     libbde_sector_cache_t **sector_cache,
+     size_t block_size,
+     size64_t cache_size,
+     libcerror_error_t **error )
+{
+	libbde_sector_cache_shard_t *shard = NULL;
+	static char *function              = "libbde_sector_cache_initialize";
+	size64_t number_of_blocks          = 0;
+	int bucket_index                   = 0;
+	int entry_index                    = 0;
+	int number_of_buckets              = 0;
+	int number_of_entries              = 0;
+	int number_of_shards               = 0;
+	int shard_index                    = 0;
+
+	if( sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sector cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size == 0 )
+	 || ( block_size > (size_t) LIBBDE_MAXIMUM_BLOCK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_blocks = cache_size / block_size;
+
+	if( number_of_blocks == 0 )
+	{
+		number_of_blocks = 1;
+	}
+	if( number_of_blocks > (size64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid cache size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_shards = 1;
+
+	while( ( ( number_of_shards * 2 ) <= LIBBDE_SECTOR_CACHE_NUMBER_OF_SHARDS )
+	    && ( (size64_t) ( number_of_shards * 2 ) <= number_of_blocks ) )
+	{
+		number_of_shards *= 2;
+	}
+	number_of_entries = (int) ( number_of_blocks / number_of_shards );
+	number_of_buckets = 1;
+
+	while( number_of_buckets < number_of_entries )
+	{
+		number_of_buckets *= 2;
+	}
+	*sector_cache = memory_allocate_structure(
+	                 libbde_sector_cache_t );
+
+	if( *sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create sector cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *sector_cache,
+	     0,
+	     sizeof( libbde_sector_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear sector cache.",
+		 function );
+
+		memory_free(
+		 *sector_cache );
+
+		*sector_cache = NULL;
+
+		return( -1 );
+	}
+	( *sector_cache )->shards = (libbde_sector_cache_shard_t *) memory_allocate(
+	                                                             sizeof( libbde_sector_cache_shard_t ) * number_of_shards );
+
+	if( ( *sector_cache )->shards == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create shards.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *sector_cache )->shards,
+	     0,
+	     sizeof( libbde_sector_cache_shard_t ) * number_of_shards ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear shards.",
+		 function );
+
+		memory_free(
+		 ( *sector_cache )->shards );
+
+		( *sector_cache )->shards = NULL;
+
+		goto on_error;
+	}
+	( *sector_cache )->block_size       = block_size;
+	( *sector_cache )->number_of_shards = number_of_shards;
+
+	for( shard_index = 0;
+	     shard_index < number_of_shards;
+	     shard_index++ )
+	{
+		shard = &( ( ( *sector_cache )->shards )[ shard_index ] );
+
+		shard->entries = (libbde_sector_cache_entry_t *) memory_allocate(
+		                                                  sizeof( libbde_sector_cache_entry_t ) * number_of_entries );
+
+		if( shard->entries == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d entries.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     shard->entries,
+		     0,
+		     sizeof( libbde_sector_cache_entry_t ) * number_of_entries ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear shard: %d entries.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		shard->number_of_entries = number_of_entries;
+
+		for( entry_index = 0;
+		     entry_index < number_of_entries;
+		     entry_index++ )
+		{
+			shard->entries[ entry_index ].block_offset     = -1;
+			shard->entries[ entry_index ].next_entry_index = -1;
+		}
+		shard->buckets = (int *) memory_allocate(
+		                          sizeof( int ) * number_of_buckets );
+
+		if( shard->buckets == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create shard: %d buckets.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		shard->number_of_buckets = number_of_buckets;
+
+		for( bucket_index = 0;
+		     bucket_index < number_of_buckets;
+		     bucket_index++ )
+		{
+			shard->buckets[ bucket_index ] = -1;
+		}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_initialize(
+		     &( shard->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to intialize shard: %d read/write lock.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+		if( libcthreads_mutex_initialize(
+		     &( shard->reference_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to intialize shard: %d reference mutex.",
+			 function,
+			 shard_index );
+
+			goto on_error;
+		}
+#endif
+	}
+	return( 1 );
+
+on_error:
+	if( *sector_cache != NULL )
+	{
+		libbde_sector_cache_free(
+		 sector_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a sector cache
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sector_cache_free(
+     libbde_sector_cache_t **sector_cache,
+     libcerror_error_t **error )
+{
+	libbde_sector_cache_shard_t *shard = NULL;
+	static char *function              = "libbde_sector_cache_free";
+	int entry_index                    = 0;
+	int result                         = 1;
+	int shard_index                    = 0;
+
+	if( sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_cache != NULL )
+	{
+		if( ( *sector_cache )->shards != NULL )
+		{
+			for( shard_index = 0;
+			     shard_index < ( *sector_cache )->number_of_shards;
+			     shard_index++ )
+			{
+				shard = &( ( ( *sector_cache )->shards )[ shard_index ] );
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+				if( shard->read_write_lock != NULL )
+				{
+					if( libcthreads_read_write_lock_free(
+					     &( shard->read_write_lock ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free shard: %d read/write lock.",
+						 function,
+						 shard_index );
+
+						result = -1;
+					}
+				}
+				if( shard->reference_mutex != NULL )
+				{
+					if( libcthreads_mutex_free(
+					     &( shard->reference_mutex ),
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+						 "%s: unable to free shard: %d reference mutex.",
+						 function,
+						 shard_index );
+
+						result = -1;
+					}
+				}
+#endif
+				if( shard->buckets != NULL )
+				{
+					memory_free(
+					 shard->buckets );
+				}
+				if( shard->entries != NULL )
+				{
+					for( entry_index = 0;
+					     entry_index < shard->number_of_entries;
+					     entry_index++ )
+					{
+						if( shard->entries[ entry_index ].data != NULL )
+						{
+							memory_free(
+							 shard->entries[ entry_index ].data );
+						}
+					}
+					memory_free(
+					 shard->entries );
+				}
+			}
+			memory_free(
+			 ( *sector_cache )->shards );
+		}
+		memory_free(
+		 *sector_cache );
+
+		*sector_cache = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the shard and hash bucket index of a specific block
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sector_cache_get_shard(
+     libbde_sector_cache_t *sector_cache,
+     off64_t block_offset,
+     libbde_sector_cache_shard_t **shard,
+     int *bucket_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_sector_cache_get_shard";
+	uint64_t hash         = 0;
+	int shard_index       = 0;
+
+	if( sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_cache->shards == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid sector cache - missing shards.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_offset < 0 )
+	 || ( ( block_offset % sector_cache->block_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( shard == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid shard.",
+		 function );
+
+		return( -1 );
+	}
+	if( bucket_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bucket index.",
+		 function );
+
+		return( -1 );
+	}
+	/* Fibonacci hashing of the block number, the upper bits select the shard
+	 * and the lower bits the hash bucket within the shard
+	 */
+	hash = ( (uint64_t) block_offset / sector_cache->block_size ) * (uint64_t) 0x9e3779b97f4a7c15ULL;
+
+	shard_index = (int) ( ( hash >> 58 ) & (uint64_t) ( sector_cache->number_of_shards - 1 ) );
+
+	*shard        = &( ( sector_cache->shards )[ shard_index ] );
+	*bucket_index = (int) ( ( hash >> 16 ) & (uint64_t) ( ( *shard )->number_of_buckets - 1 ) );
+
+	return( 1 );
+}
+
+/* Copies the data of a specific block from the cache into a buffer
+ * Lookups only acquire the read lock of the shard, so readers of the same shard do not block each other
+ * Returns 1 if successful, 0 if the block is not cached or -1 on error
+ */
+int libbde_sector_cache_get_data(
+     libbde_sector_cache_t *sector_cache,
+     off64_t block_offset,
+     size_t block_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	libbde_sector_cache_entry_t *entry = NULL;
+	libbde_sector_cache_shard_t *shard = NULL;
+	static char *function              = "libbde_sector_cache_get_data";
+	int bucket_index                   = 0;
+	int entry_index                    = 0;
+	int result                         = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_sector_cache_get_shard(
+	     sector_cache,
+	     block_offset,
+	     &shard,
+	     &bucket_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve shard.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry_index = shard->buckets[ bucket_index ];
+
+	while( entry_index != -1 )
+	{
+		entry = &( shard->entries[ entry_index ] );
+
+		if( entry->block_offset == block_offset )
+		{
+			break;
+		}
+		entry_index = entry->next_entry_index;
+	}
+	if( entry_index != -1 )
+	{
+		if( ( block_data_offset > entry->data_size )
+		 || ( buffer_size > ( entry->data_size - block_data_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid block data offset value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_copy(
+		     buffer,
+		     &( ( entry->data )[ block_data_offset ] ),
+		     buffer_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy data to buffer.",
+			 function );
+
+			goto on_error;
+		}
+		/* Concurrent readers of the shard only hold the read lock,
+		 * hence the reference flag is set under the reference mutex
+		 */
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     shard->reference_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab reference mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+		entry->is_referenced = 1;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     shard->reference_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release reference mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+
+		result = 1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 shard->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Copies the data of a specific block into the cache
+ * If the shard is full an entry is evicted using the CLOCK algorithm
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sector_cache_set_data(
+     libbde_sector_cache_t *sector_cache,
+     off64_t block_offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libbde_sector_cache_entry_t *entry        = NULL;
+	libbde_sector_cache_shard_t *shard        = NULL;
+	libbde_sector_cache_shard_t *victim_shard = NULL;
+	static char *function                     = "libbde_sector_cache_set_data";
+	int bucket_index                          = 0;
+	int entry_index                           = 0;
+	int previous_entry_index                  = 0;
+	int victim_bucket_index                   = 0;
+
+	if( sector_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size == 0 )
+	 || ( data_size > sector_cache->block_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_sector_cache_get_shard(
+	     sector_cache,
+	     block_offset,
+	     &shard,
+	     &bucket_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve shard.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	entry_index = shard->buckets[ bucket_index ];
+
+	while( entry_index != -1 )
+	{
+		entry = &( shard->entries[ entry_index ] );
+
+		if( entry->block_offset == block_offset )
+		{
+			break;
+		}
+		entry_index = entry->next_entry_index;
+	}
+	if( entry_index != -1 )
+	{
+		/* The block was cached by another reader in the meantime
+		 */
+		entry->is_referenced = 1;
+	}
+	else
+	{
+		if( shard->number_of_used_entries < shard->number_of_entries )
+		{
+			entry_index = shard->number_of_used_entries;
+			entry       = &( shard->entries[ entry_index ] );
+		}
+		else
+		{
+			/* Advance the clock hand until it points to an entry that was not
+			 * referenced since the previous pass, giving referenced entries a second chance
+			 * The write lock excludes the readers, hence the reference mutex is not needed
+			 */
+			do
+			{
+				entry_index = shard->clock_hand;
+				entry       = &( shard->entries[ entry_index ] );
+
+				shard->clock_hand += 1;
+
+				if( shard->clock_hand >= shard->number_of_entries )
+				{
+					shard->clock_hand = 0;
+				}
+				if( entry->is_referenced == 0 )
+				{
+					break;
+				}
+				entry->is_referenced = 0;
+			}
+			while( 1 );
+		}
+		if( entry->data == NULL )
+		{
+			entry->data = (uint8_t *) memory_allocate(
+			                           sizeof( uint8_t ) * sector_cache->block_size );
+
+			if( entry->data == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create entry: %d data.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+		}
+		if( entry_index == shard->number_of_used_entries )
+		{
+			shard->number_of_used_entries += 1;
+		}
+		/* Remove the evicted block from its hash bucket
+		 */
+		if( entry->block_offset != -1 )
+		{
+			if( libbde_sector_cache_get_shard(
+			     sector_cache,
+			     entry->block_offset,
+			     &victim_shard,
+			     &victim_bucket_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve shard of entry: %d.",
+				 function,
+				 entry_index );
+
+				goto on_error;
+			}
+			if( shard->buckets[ victim_bucket_index ] == entry_index )
+			{
+				shard->buckets[ victim_bucket_index ] = entry->next_entry_index;
+			}
+			else
+			{
+				previous_entry_index = shard->buckets[ victim_bucket_index ];
+
+				while( previous_entry_index != -1 )
+				{
+					if( shard->entries[ previous_entry_index ].next_entry_index == entry_index )
+					{
+						shard->entries[ previous_entry_index ].next_entry_index = entry->next_entry_index;
+
+						break;
+					}
+					previous_entry_index = shard->entries[ previous_entry_index ].next_entry_index;
+				}
+			}
+		}
+		entry->block_offset     = block_offset;
+		entry->next_entry_index = shard->buckets[ bucket_index ];
+		entry->is_referenced    = 0;
+
+		shard->buckets[ bucket_index ] = entry_index;
+	}
+	if( memory_copy(
+	     entry->data,
+	     data,
+	     data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy data to entry: %d.",
+		 function,
+		 entry_index );
+
+		goto on_error;
+	}
+	entry->data_size = data_size;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     shard->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 shard->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
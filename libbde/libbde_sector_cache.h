@@ -0,0 +1,156 @@
+/*
+ * Sector cache functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_SECTOR_CACHE_H )
+#define _LIBBDE_SECTOR_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+#include "libbde_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbde_sector_cache_entry libbde_sector_cache_entry_t;
+
+struct libbde_sector_cache_entry
+{
+	/* The block offset
+	 * Contains -1 if the entry is not used
+	 */
+	off64_t block_offset;
+
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The index of the next entry in the same hash bucket
+	 * Contains -1 if there is no next entry
+	 */
+	int next_entry_index;
+
+	/* Value to indicate the entry was referenced since the clock hand last passed it
+	 */
+	uint8_t is_referenced;
+};
+
+typedef struct libbde_sector_cache_shard libbde_sector_cache_shard_t;
+
+struct libbde_sector_cache_shard
+{
+	/* The entries
+	 */
+	libbde_sector_cache_entry_t *entries;
+
+	/* The number of entries
+	 */
+	int number_of_entries;
+
+	/* The number of used entries
+	 */
+	int number_of_used_entries;
+
+	/* The index of the first entry per hash bucket
+	 */
+	int *buckets;
+
+	/* The number of hash buckets, which is a power of 2
+	 */
+	int number_of_buckets;
+
+	/* The index of the entry the clock hand points to
+	 */
+	int clock_hand;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+
+	/* The mutex of the reference flags of the entries,
+	 * since readers set these while only holding the read lock
+	 */
+	libcthreads_mutex_t *reference_mutex;
+#endif
+};
+
+typedef struct libbde_sector_cache libbde_sector_cache_t;
+
+struct libbde_sector_cache
+{
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The shards
+	 */
+	libbde_sector_cache_shard_t *shards;
+
+	/* The number of shards, which is a power of 2
+	 */
+	int number_of_shards;
+};
+
+int libbde_sector_cache_initialize(
+     libbde_sector_cache_t **sector_cache,
+     size_t block_size,
+     size64_t cache_size,
+     libcerror_error_t **error );
+
+int libbde_sector_cache_free(
+     libbde_sector_cache_t **sector_cache,
+     libcerror_error_t **error );
+
+int libbde_sector_cache_get_shard(
+     libbde_sector_cache_t *sector_cache,
+     off64_t block_offset,
+     libbde_sector_cache_shard_t **shard,
+     int *bucket_index,
+     libcerror_error_t **error );
+
+int libbde_sector_cache_get_data(
+     libbde_sector_cache_t *sector_cache,
+     off64_t block_offset,
+     size_t block_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libbde_sector_cache_set_data(
+     libbde_sector_cache_t *sector_cache,
+     off64_t block_offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_SECTOR_CACHE_H ) */
+
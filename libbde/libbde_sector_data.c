@@ -30,6 +30,8 @@
 #include "libbde_libbfio.h"
 #include "libbde_libcerror.h"
 #include "libbde_libcnotify.h"
+#include "libbde_libcthreads.h"
+#include "libbde_region_table.h"
 #include "libbde_sector_data.h"
 
 /* Creates sector data
@@ -212,61 +214,917 @@ int libbde_sector_data_free(
 	return( result );
 }
 
+/* Determines the type of a sector
+ * The data offset is set to the offset of the sector data in the file
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sector_data_get_sector_type(
+     libbde_io_handle_t *io_handle,
+     off64_t sector_offset,
+     uint8_t zero_metadata,
+     off64_t *data_offset,
+     uint8_t *sector_type,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_sector_data_get_sector_type";
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector type.",
+		 function );
+
+		return( -1 );
+	}
+	if( zero_metadata != 0 )
+	{
+		/* The BitLocker metadata areas are represented as zero byte blocks
+		 */
+		if( ( ( sector_offset >= io_handle->first_metadata_offset )
+		  &&  ( sector_offset < ( io_handle->first_metadata_offset + (off64_t) io_handle->metadata_size ) ) )
+		 || ( ( sector_offset >= io_handle->second_metadata_offset )
+		  &&  ( sector_offset < ( io_handle->second_metadata_offset + (off64_t) io_handle->metadata_size ) ) )
+		 || ( ( sector_offset >= io_handle->third_metadata_offset )
+		  &&  ( sector_offset < ( io_handle->third_metadata_offset + (off64_t) io_handle->metadata_size ) ) ) )
+		{
+			*data_offset = sector_offset;
+			*sector_type = LIBBDE_SECTOR_DATA_TYPE_ZERO;
+
+			return( 1 );
+		}
+	}
+	if( ( io_handle->version == LIBBDE_VERSION_WINDOWS_7 )
+	 || ( io_handle->version == LIBBDE_VERSION_TO_GO ) )
+	{
+		if( zero_metadata != 0 )
+		{
+			if( ( sector_offset >= io_handle->volume_header_offset )
+			 && ( sector_offset < ( io_handle->volume_header_offset + (off64_t) io_handle->volume_header_size ) ) )
+			{
+				*data_offset = sector_offset;
+				*sector_type = LIBBDE_SECTOR_DATA_TYPE_ZERO;
+
+				return( 1 );
+			}
+		}
+		/* Normally the first 8192 bytes are stored in another location on the volume
+		 */
+		if( (size64_t) sector_offset < io_handle->volume_header_size )
+		{
+			sector_offset += io_handle->volume_header_offset;
+		}
+	}
+	*data_offset = sector_offset;
+
+	/* In Windows Vista the first 16 sectors are unencrypted
+	 */
+	if( ( io_handle->version == LIBBDE_VERSION_WINDOWS_VISTA )
+	 && ( (size64_t) sector_offset < 8192 ) )
+	{
+		*sector_type = LIBBDE_SECTOR_DATA_TYPE_UNENCRYPTED;
+	}
+	/* Check if the offset is outside the encrypted part of the volume
+	 */
+	else if( ( io_handle->encrypted_volume_size != 0 )
+	      && ( sector_offset >= (off64_t) io_handle->encrypted_volume_size ) )
+	{
+		*sector_type = LIBBDE_SECTOR_DATA_TYPE_UNENCRYPTED;
+	}
+	else
+	{
+		*sector_type = LIBBDE_SECTOR_DATA_TYPE_ENCRYPTED;
+	}
+	return( 1 );
+}
+
 /* Reads sector data
  * Returns 1 if successful or -1 on error
  */
-int libbde_sector_data_read(
-     libbde_sector_data_t *sector_data,
+int libbde_sector_data_read(
+     libbde_sector_data_t *sector_data,
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t sector_data_offset,
+     libbde_encryption_context_t *encryption_context,
+     uint8_t zero_metadata,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_sector_data_read";
+
+	if( sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_data->encrypted_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid sector data - missing encrypted data.",
+		 function );
+
+		return( -1 );
+	}
+	if( sector_data->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid sector data - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_sector_data_read_buffer(
+	     io_handle,
+	     file_io_handle,
+	     sector_data_offset,
+	     sector_data->encrypted_data,
+	     sector_data->data,
+	     sector_data->data_size,
+	     encryption_context,
+	     zero_metadata,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sector data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Creates sector data and reads a block of sectors
+ * The last block of the volume can be smaller than the block size
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sector_data_read_block(
+     libbde_sector_data_t **sector_data,
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t block_offset,
+     size64_t block_size,
+     libbde_encryption_context_t *encryption_context,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_sector_data_read_block";
+	size_t data_size      = 0;
+
+	if( sector_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sector data.",
+		 function );
+
+		return( -1 );
+	}
+	if( *sector_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid sector data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_offset < 0 )
+	 || ( (size64_t) block_offset >= io_handle->volume_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size == 0 )
+	 || ( block_size > (size64_t) LIBBDE_MAXIMUM_BLOCK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_size > ( io_handle->volume_size - block_offset ) )
+	{
+		block_size = io_handle->volume_size - block_offset;
+	}
+	data_size = (size_t) block_size;
+
+	if( ( data_size % io_handle->bytes_per_sector ) != 0 )
+	{
+		data_size = ( ( data_size / io_handle->bytes_per_sector ) + 1 ) * io_handle->bytes_per_sector;
+	}
+	if( libbde_sector_data_initialize(
+	     sector_data,
+	     data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create sector data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_sector_data_read(
+	     *sector_data,
+	     io_handle,
+	     file_io_handle,
+	     block_offset,
+	     encryption_context,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read sector data.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *sector_data != NULL )
+	{
+		libbde_sector_data_free(
+		 sector_data,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the region table of a range of sectors
+ * The region table of the volume is used if the range is stored within it,
+ * otherwise the regions of the range are determined into range region table
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sector_data_get_region_table(
+     libbde_io_handle_t *io_handle,
+     off64_t sector_data_offset,
+     size_t data_size,
+     uint8_t zero_metadata,
+     libbde_region_table_t *range_region_table,
+     libbde_region_table_t **region_table,
+     libcerror_error_t **error )
+{
+	libbde_region_table_t *volume_region_table = NULL;
+	static char *function                      = "libbde_sector_data_get_region_table";
+	size64_t relative_offset                   = 0;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( region_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid region table.",
+		 function );
+
+		return( -1 );
+	}
+	volume_region_table = &( io_handle->region_table );
+
+	/* The region table of the volume represents the metadata areas as zero byte blocks
+	 * and its boundaries are relative to the start of the volume
+	 */
+	if( ( zero_metadata != 0 )
+	 && ( volume_region_table->number_of_regions > 0 )
+	 && ( ( sector_data_offset % io_handle->bytes_per_sector ) == 0 )
+	 && ( sector_data_offset >= volume_region_table->offset ) )
+	{
+		relative_offset = (size64_t) ( sector_data_offset - volume_region_table->offset );
+
+		if( ( relative_offset <= volume_region_table->size )
+		 && ( (size64_t) data_size <= ( volume_region_table->size - relative_offset ) ) )
+		{
+			*region_table = volume_region_table;
+
+			return( 1 );
+		}
+	}
+	if( libbde_io_handle_get_region_table(
+	     io_handle,
+	     sector_data_offset,
+	     (size64_t) data_size,
+	     zero_metadata,
+	     range_region_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine region table.",
+		 function );
+
+		return( -1 );
+	}
+	*region_table = range_region_table;
+
+	return( 1 );
+}
+
+/* Reads the data of consecutive sectors into a buffer
+ * The sectors are split into ranges by the regions of the volume
+ * Each range is read with a single read and decrypted in a single pass
+ * The encrypted data and data can refer to the same buffer in which case the sectors are decrypted in-place
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sector_data_read_buffer(
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t sector_data_offset,
+     uint8_t *encrypted_data,
+     uint8_t *data,
+     size_t data_size,
+     libbde_encryption_context_t *encryption_context,
+     uint8_t zero_metadata,
+     libcerror_error_t **error )
+{
+	libbde_region_table_t range_region_table;
+
+	libbde_region_t *region             = NULL;
+	libbde_region_table_t *region_table = NULL;
+	static char *function               = "libbde_sector_data_read_buffer";
+	size_t data_offset                  = 0;
+	size_t range_size                   = 0;
+	ssize_t read_count                  = 0;
+	off64_t range_file_offset           = 0;
+	off64_t range_offset                = 0;
+	uint8_t range_sector_type           = 0;
+	int region_index                    = 0;
+	int result                          = 0;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	uint8_t file_io_mutex_grabbed       = 0;
+#endif
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle->bytes_per_sector == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid IO handle - missing bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+	if( encrypted_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encrypted data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size % io_handle->bytes_per_sector ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported data size value not a multiple of bytes per sector.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: reading sector data at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIzd "\n",
+		 function,
+		 sector_data_offset,
+		 sector_data_offset,
+		 data_size );
+	}
+#endif
+	if( data_size == 0 )
+	{
+		return( 1 );
+	}
+	if( libbde_sector_data_get_region_table(
+	     io_handle,
+	     sector_data_offset,
+	     data_size,
+	     zero_metadata,
+	     &range_region_table,
+	     &region_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve region table.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbde_region_table_find_region_index(
+	          region_table,
+	          sector_data_offset,
+	          &region_index,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find region for offset: %" PRIi64 ".",
+		 function,
+		 sector_data_offset );
+
+		goto on_error;
+	}
+	while( data_offset < data_size )
+	{
+		if( libbde_region_table_get_region_by_index(
+		     region_table,
+		     region_index,
+		     &region,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve region: %d.",
+			 function,
+			 region_index );
+
+			goto on_error;
+		}
+		/* The range is the part of the region that overlaps with the data
+		 */
+		range_offset      = sector_data_offset + (off64_t) data_offset;
+		range_file_offset = region->data_offset + ( range_offset - region->offset );
+		range_sector_type = region->sector_type;
+		range_size        = data_size - data_offset;
+
+		if( (size64_t) range_size > (size64_t) ( region->offset + (off64_t) region->size - range_offset ) )
+		{
+			range_size = (size_t) ( region->offset + (off64_t) region->size - range_offset );
+		}
+		region_index++;
+
+		if( range_sector_type == LIBBDE_SECTOR_DATA_TYPE_ZERO )
+		{
+			if( memory_set(
+			     &( data[ data_offset ] ),
+			     0,
+			     range_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+				 "%s: unable to clear data.",
+				 function );
+
+				goto on_error;
+			}
+			data_offset += range_size;
+
+			continue;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: reading %" PRIzd " bytes of sector data at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 range_size,
+			 range_file_offset,
+			 range_file_offset );
+		}
+#endif
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     io_handle->file_io_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab file IO mutex.",
+			 function );
+
+			goto on_error;
+		}
+		file_io_mutex_grabbed = 1;
+#endif
+		if( libbfio_handle_seek_offset(
+		     file_io_handle,
+		     range_file_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek sector data offset: %" PRIi64 ".",
+			 function,
+			 range_file_offset );
+
+			goto on_error;
+		}
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              &( encrypted_data[ data_offset ] ),
+		              range_size,
+		              error );
+
+		if( read_count != (ssize_t) range_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read sector data.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		file_io_mutex_grabbed = 0;
+
+		if( libcthreads_mutex_release(
+		     io_handle->file_io_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file IO mutex.",
+			 function );
+
+			goto on_error;
+		}
+#endif
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: encrypted sector data:\n",
+			 function );
+			libcnotify_print_data(
+			 &( encrypted_data[ data_offset ] ),
+			 range_size,
+			 0 );
+		}
+#endif
+		if( range_sector_type == LIBBDE_SECTOR_DATA_TYPE_UNENCRYPTED )
+		{
+			if( ( encrypted_data != data )
+			 && ( memory_copy(
+			       &( data[ data_offset ] ),
+			       &( encrypted_data[ data_offset ] ),
+			       range_size ) == NULL ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy encrypted data.",
+				 function );
+
+				goto on_error;
+			}
+			/* In Windows Vista the first sector is altered
+			 */
+			if( ( io_handle->version == LIBBDE_VERSION_WINDOWS_VISTA )
+			 && ( range_file_offset == 0 ) )
+			{
+				/* Change the volume header signature "-FVE-FS-"
+				 * into "NTFS    "
+				 */
+				if( memory_copy(
+				     &( data[ data_offset + 3 ] ),
+				     "NTFS    ",
+				     8 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy encrypted data.",
+					 function );
+
+					goto on_error;
+				}
+				/* Change the FVE metadatsa block 1 cluster block number
+				 * into the MFT mirror cluster block number
+				 */
+				byte_stream_copy_from_uint64_little_endian(
+				 &( data[ data_offset + 56 ] ),
+				 io_handle->mft_mirror_cluster_block_number );
+			}
+		}
+		else
+		{
+			/* Each sector is decrypted with its own initialization vector,
+			 * which are generated for multiple sectors at once
+			 */
+			if( libbde_encryption_crypt_sectors(
+			     encryption_context,
+			     LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+			     &( encrypted_data[ data_offset ] ),
+			     range_size,
+			     &( data[ data_offset ] ),
+			     range_size,
+			     (uint64_t) range_file_offset,
+			     io_handle->bytes_per_sector,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to decrypt sector data.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		data_offset += range_size;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: sector data:\n",
+		 function );
+		libcnotify_print_data(
+		 data,
+		 data_size,
+		 0 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( file_io_mutex_grabbed != 0 )
+	{
+		libcthreads_mutex_release(
+		 io_handle->file_io_mutex,
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
+/* Writes the data of consecutive sectors from a buffer
+ * The sectors are split into ranges by the regions of the volume
+ * Each range is encrypted in a single pass and written with a single write
+ * The encrypted data buffer is used to store the encrypted sectors and must be at least the data size
+ * Sectors that map onto a BitLocker metadata area or onto the stored volume header are not written
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sector_data_write_buffer(
      libbde_io_handle_t *io_handle,
      libbfio_handle_t *file_io_handle,
      off64_t sector_data_offset,
+     const uint8_t *data,
+     uint8_t *encrypted_data,
+     size_t data_size,
      libbde_encryption_context_t *encryption_context,
-     uint8_t zero_metadata,
      libcerror_error_t **error )
 {
-	static char *function = "libbde_sector_data_read";
-	ssize_t read_count    = 0;
+	libbde_region_table_t range_region_table;
 
-	if( sector_data == NULL )
+	libbde_region_t *region             = NULL;
+	libbde_region_table_t *region_table = NULL;
+	static char *function               = "libbde_sector_data_write_buffer";
+	size_t data_offset                  = 0;
+	size_t range_size                   = 0;
+	ssize_t write_count                 = 0;
+	off64_t range_file_offset           = 0;
+	off64_t range_offset                = 0;
+	uint64_t cluster_block_size         = 0;
+	uint8_t range_sector_type           = 0;
+	int region_index                    = 0;
+	int result                          = 0;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	uint8_t file_io_mutex_grabbed       = 0;
+#endif
+
+	if( io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid sector data.",
+		 "%s: invalid IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( sector_data->encrypted_data == NULL )
+	if( io_handle->bytes_per_sector == 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid sector data - missing encrypted data.",
+		 "%s: invalid IO handle - missing bytes per sector.",
 		 function );
 
 		return( -1 );
 	}
-	if( sector_data->data == NULL )
+	if( data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid sector data - missing data.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
 		 function );
 
 		return( -1 );
 	}
-	if( io_handle == NULL )
+	if( encrypted_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid IO handle.",
+		 "%s: invalid encrypted data.",
+		 function );
+
+		return( -1 );
+	}
+	if( encrypted_data == data )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encrypted data value same as data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( data_size % io_handle->bytes_per_sector ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported data size value not a multiple of bytes per sector.",
 		 function );
 
 		return( -1 );
@@ -275,229 +1133,267 @@ int libbde_sector_data_read(
 	if( libcnotify_verbose != 0 )
 	{
 		libcnotify_printf(
-		 "%s: reading sector data at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 "%s: writing sector data at offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIzd "\n",
 		 function,
 		 sector_data_offset,
-		 sector_data_offset );
+		 sector_data_offset,
+		 data_size );
 	}
 #endif
-	if( zero_metadata != 0 )
+	if( data_size == 0 )
 	{
-		/* The BitLocker metadata areas are represented as zero byte blocks
+		return( 1 );
+	}
+	if( libbde_sector_data_get_region_table(
+	     io_handle,
+	     sector_data_offset,
+	     data_size,
+	     1,
+	     &range_region_table,
+	     &region_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve region table.",
+		 function );
+
+		goto on_error;
+	}
+	result = libbde_region_table_find_region_index(
+	          region_table,
+	          sector_data_offset,
+	          &region_index,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find region for offset: %" PRIi64 ".",
+		 function,
+		 sector_data_offset );
+
+		goto on_error;
+	}
+	while( data_offset < data_size )
+	{
+		if( libbde_region_table_get_region_by_index(
+		     region_table,
+		     region_index,
+		     &region,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve region: %d.",
+			 function,
+			 region_index );
+
+			goto on_error;
+		}
+		/* The range is the part of the region that overlaps with the data
 		 */
-		if( ( ( sector_data_offset >= io_handle->first_metadata_offset )
-		  &&  ( sector_data_offset < ( io_handle->first_metadata_offset + (off64_t) io_handle->metadata_size ) ) )
-		 || ( ( sector_data_offset >= io_handle->second_metadata_offset )
-		  &&  ( sector_data_offset < ( io_handle->second_metadata_offset + (off64_t) io_handle->metadata_size ) ) )
-		 || ( ( sector_data_offset >= io_handle->third_metadata_offset )
-		  &&  ( sector_data_offset < ( io_handle->third_metadata_offset + (off64_t) io_handle->metadata_size ) ) ) )
+		range_offset      = sector_data_offset + (off64_t) data_offset;
+		range_file_offset = region->data_offset + ( range_offset - region->offset );
+		range_sector_type = region->sector_type;
+		range_size        = data_size - data_offset;
+
+		if( (size64_t) range_size > (size64_t) ( region->offset + (off64_t) region->size - range_offset ) )
 		{
-			if( memory_set(
-			     sector_data->data,
-			     0,
-			     sector_data->data_size ) == NULL )
+			range_size = (size_t) ( region->offset + (off64_t) region->size - range_offset );
+		}
+		region_index++;
+
+		/* The BitLocker metadata areas and the stored volume header
+		 * are represented as zero byte blocks and are never overwritten
+		 */
+		if( range_sector_type == LIBBDE_SECTOR_DATA_TYPE_ZERO )
+		{
+			data_offset += range_size;
+
+			continue;
+		}
+		if( range_sector_type == LIBBDE_SECTOR_DATA_TYPE_UNENCRYPTED )
+		{
+			if( memory_copy(
+			     &( encrypted_data[ data_offset ] ),
+			     &( data[ data_offset ] ),
+			     range_size ) == NULL )
 			{
 				libcerror_error_set(
 				 error,
 				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-				 "%s: unable to clear data.",
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy data.",
 				 function );
 
-				return( -1 );
+				goto on_error;
 			}
-			return( 1 );
-		}
-	}
-	if( ( io_handle->version == LIBBDE_VERSION_WINDOWS_7 )
-	 || ( io_handle->version == LIBBDE_VERSION_TO_GO ) )
-	{
-		if( zero_metadata != 0 )
-		{
-			if( ( sector_data_offset >= io_handle->volume_header_offset )
-			 && ( sector_data_offset < ( io_handle->volume_header_offset + (off64_t) io_handle->volume_header_size ) ) )
+			/* In Windows Vista the first sector is altered
+			 */
+			if( ( io_handle->version == LIBBDE_VERSION_WINDOWS_VISTA )
+			 && ( range_file_offset == 0 ) )
 			{
-				if( memory_set(
-				     sector_data->data,
-				     0,
-				     sector_data->data_size ) == NULL )
+				cluster_block_size = (uint64_t) io_handle->sectors_per_cluster_block * io_handle->bytes_per_sector;
+
+				if( cluster_block_size == 0 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: invalid IO handle - missing sectors per cluster block.",
+					 function );
+
+					goto on_error;
+				}
+				/* Change the volume header signature "NTFS    "
+				 * back into "-FVE-FS-"
+				 */
+				if( memory_copy(
+				     &( encrypted_data[ data_offset + 3 ] ),
+				     "-FVE-FS-",
+				     8 ) == NULL )
 				{
 					libcerror_error_set(
 					 error,
 					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-					 "%s: unable to clear data.",
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy data.",
 					 function );
 
-					return( -1 );
+					goto on_error;
 				}
-				return( 1 );
+				/* Change the MFT mirror cluster block number
+				 * back into the FVE metadata block 1 cluster block number
+				 */
+				byte_stream_copy_from_uint64_little_endian(
+				 &( encrypted_data[ data_offset + 56 ] ),
+				 (uint64_t) io_handle->first_metadata_offset / cluster_block_size );
 			}
 		}
-		/* Normally the first 8192 bytes are stored in another location on the volume
-		 */
-		if( (size64_t) sector_data_offset < io_handle->volume_header_size )
+		else
 		{
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
+			/* Each sector is encrypted with its own initialization vector,
+			 * which are generated for multiple sectors at once
+			 */
+			if( libbde_encryption_crypt_sectors(
+			     encryption_context,
+			     LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+			     &( data[ data_offset ] ),
+			     range_size,
+			     &( encrypted_data[ data_offset ] ),
+			     range_size,
+			     (uint64_t) range_file_offset,
+			     io_handle->bytes_per_sector,
+			     error ) != 1 )
 			{
-				libcnotify_printf(
-				 "%s: reading volume header data at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
-				 function,
-				 io_handle->volume_header_offset,
-				 io_handle->volume_header_offset );
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
+				 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
+				 "%s: unable to encrypt sector data.",
+				 function );
+
+				goto on_error;
 			}
-#endif
-			sector_data_offset += io_handle->volume_header_offset;
 		}
-	}
-	if( libbfio_handle_seek_offset(
-	     file_io_handle,
-	     sector_data_offset,
-	     SEEK_SET,
-	     error ) == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek sector data offset: %" PRIi64 ".",
-		 function,
-		 sector_data_offset );
-
-		return( -1 );
-	}
-	read_count = libbfio_handle_read_buffer(
-	              file_io_handle,
-	              sector_data->encrypted_data,
-	              sector_data->data_size,
-	              error );
-
-	if( read_count != (ssize_t) sector_data->data_size )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read sector data.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: encrypted sector data:\n",
-		 function );
-		libcnotify_print_data(
-		 sector_data->encrypted_data,
-		 sector_data->data_size,
-		 0 );
-	}
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: writing %" PRIzd " bytes of sector data at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 range_size,
+			 range_file_offset,
+			 range_file_offset );
+		}
 #endif
-	/* In Windows Vista the first 16 sectors are unencrypted
-	 */
-	if( ( io_handle->version == LIBBDE_VERSION_WINDOWS_VISTA )
-	 && ( (size64_t) sector_data_offset < 8192 ) )
-	{
-		if( memory_copy(
-		     sector_data->data,
-		     sector_data->encrypted_data,
-		     sector_data->data_size ) == NULL )
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     io_handle->file_io_mutex,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy encrypted data.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab file IO mutex.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		/* In Windows Vista the first sector is altered
-		 */
-		if( sector_data_offset < 512 )
+		file_io_mutex_grabbed = 1;
+#endif
+		if( libbfio_handle_seek_offset(
+		     file_io_handle,
+		     range_file_offset,
+		     SEEK_SET,
+		     error ) == -1 )
 		{
-			/* Change the volume header signature "-FVE-FS-"
-			 * into "NTFS    "
-			 */
-			if( memory_copy(
-			     &( sector_data->data[ 3 ] ),
-			     "NTFS    ",
-			     8 ) == NULL )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_MEMORY,
-				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-				 "%s: unable to copy encrypted data.",
-				 function );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek sector data offset: %" PRIi64 ".",
+			 function,
+			 range_file_offset );
 
-				return( -1 );
-			}
-			/* Change the FVE metadatsa block 1 cluster block number
-			 * into the MFT mirror cluster block number
-			 */
-			byte_stream_copy_from_uint64_little_endian(
-			 &( sector_data->data[ 56 ] ),
-			 io_handle->mft_mirror_cluster_block_number );
+			goto on_error;
 		}
-	}
-	/* Check if the offset is outside the encrypted part of the volume
-	 */
-	else if( ( io_handle->encrypted_volume_size != 0 )
-	      && ( sector_data_offset >= (off64_t) io_handle->encrypted_volume_size ) )
-	{
-		if( memory_copy(
-		     sector_data->data,
-		     sector_data->encrypted_data,
-		     sector_data->data_size ) == NULL )
+		write_count = libbfio_handle_write_buffer(
+		               file_io_handle,
+		               &( encrypted_data[ data_offset ] ),
+		               range_size,
+		               error );
+
+		if( write_count != (ssize_t) range_size )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy encrypted data.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sector data.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-	}
-	else
-	{
-		if( libbde_encryption_crypt(
-		     encryption_context,
-		     LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
-		     sector_data->encrypted_data,
-		     sector_data->data_size,
-		     sector_data->data,
-		     sector_data->data_size,
-		     (uint64_t) sector_data_offset,
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		file_io_mutex_grabbed = 0;
+
+		if( libcthreads_mutex_release(
+		     io_handle->file_io_mutex,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_ENCRYPTION,
-			 LIBCERROR_ENCRYPTION_ERROR_GENERIC,
-			 "%s: unable to decrypt sector data.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release file IO mutex.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
+#endif
+		data_offset += range_size;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( file_io_mutex_grabbed != 0 )
 	{
-		libcnotify_printf(
-		 "%s: sector data:\n",
-		 function );
-		libcnotify_print_data(
-		 sector_data->data,
-		 sector_data->data_size,
-		 0 );
+		libcthreads_mutex_release(
+		 io_handle->file_io_mutex,
+		 NULL );
 	}
 #endif
-	return( 1 );
+	return( -1 );
 }
-
@@ -29,6 +29,7 @@
 #include "libbde_io_handle.h"
 #include "libbde_libbfio.h"
 #include "libbde_libcerror.h"
+#include "libbde_region_table.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -60,6 +61,14 @@ int libbde_sector_data_free(
      libbde_sector_data_t **sector_data,
      libcerror_error_t **error );
 
+int libbde_sector_data_get_sector_type(
+     libbde_io_handle_t *io_handle,
+     off64_t sector_offset,
+     uint8_t zero_metadata,
+     off64_t *data_offset,
+     uint8_t *sector_type,
+     libcerror_error_t **error );
+
 int libbde_sector_data_read(
      libbde_sector_data_t *sector_data,
      libbde_io_handle_t *io_handle,
@@ -69,6 +78,45 @@ int libbde_sector_data_read(
      uint8_t zero_metadata,
      libcerror_error_t **error );
 
+int libbde_sector_data_read_block(
+     libbde_sector_data_t **sector_data,
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t block_offset,
+     size64_t block_size,
+     libbde_encryption_context_t *encryption_context,
+     libcerror_error_t **error );
+
+int libbde_sector_data_get_region_table(
+     libbde_io_handle_t *io_handle,
+     off64_t sector_data_offset,
+     size_t data_size,
+     uint8_t zero_metadata,
+     libbde_region_table_t *range_region_table,
+     libbde_region_table_t **region_table,
+     libcerror_error_t **error );
+
+int libbde_sector_data_read_buffer(
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t sector_offset,
+     uint8_t *encrypted_data,
+     uint8_t *data,
+     size_t data_size,
+     libbde_encryption_context_t *encryption_context,
+     uint8_t zero_metadata,
+     libcerror_error_t **error );
+
+int libbde_sector_data_write_buffer(
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     off64_t sector_data_offset,
+     const uint8_t *data,
+     uint8_t *encrypted_data,
+     size_t data_size,
+     libbde_encryption_context_t *encryption_context,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,1346 @@
+/*
+ * SHA-256 key stretching functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+#include "libbde_sha256_stretch.h"
+
+#if defined( HAVE_LIBBDE_SHA256_STRETCH_SHA_NI ) || defined( HAVE_LIBBDE_SHA256_STRETCH_AVX2 )
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+#include <immintrin.h>
+
+#endif
+
+#if defined( HAVE_LIBBDE_SHA256_STRETCH_SHA_NI )
+
+/* The functions that use the SHA-NI intrinsics are compiled for the SHA and
+ * SSE4.1 instruction sets, they are only called after libbde_sha256_stretch_sha_ni_is_supported
+ */
+#if defined( __GNUC__ )
+#define LIBBDE_SHA256_STRETCH_SHA_NI_TARGET \
+	__attribute__((target("sha,sse4.1")))
+#else
+#define LIBBDE_SHA256_STRETCH_SHA_NI_TARGET
+#endif
+
+#endif /* defined( HAVE_LIBBDE_SHA256_STRETCH_SHA_NI ) */
+
+#if defined( HAVE_LIBBDE_SHA256_STRETCH_AVX2 )
+
+/* The functions that use the AVX2 intrinsics are compiled for the AVX2
+ * instruction set, they are only called after libbde_sha256_stretch_avx2_is_supported
+ */
+#if defined( __GNUC__ )
+#define LIBBDE_SHA256_STRETCH_AVX2_TARGET \
+	__attribute__((target("avx2")))
+#else
+#define LIBBDE_SHA256_STRETCH_AVX2_TARGET
+#endif
+
+#define libbde_sha256_stretch_avx2_rotate_right( value, number_of_bits ) \
+	_mm256_or_si256( \
+	 _mm256_srli_epi32( \
+	  value, \
+	  number_of_bits ), \
+	 _mm256_slli_epi32( \
+	  value, \
+	  32 - number_of_bits ) )
+
+#endif /* defined( HAVE_LIBBDE_SHA256_STRETCH_AVX2 ) */
+
+/* The hashed data of every iteration consists of:
+ * the hash of the previous iteration (32 bytes)
+ * the password hash (32 bytes)
+ * the salt (16 bytes)
+ * the iteration count as a 64-bit little-endian value (8 bytes)
+ *
+ * The 88 bytes of data are padded to 2 SHA-256 blocks. The second half of the
+ * first block and all of the second block, except for the iteration count,
+ * are the same for every iteration.
+ */
+#define LIBBDE_SHA256_STRETCH_DATA_BIT_SIZE	( 88 * 8 )
+
+#define libbde_sha256_stretch_rotate_right( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 32 - ( number_of_bits ) ) ) )
+
+#define libbde_sha256_stretch_swap_bytes( value ) \
+	( ( ( value ) >> 24 ) \
+	| ( ( ( value ) >> 8 ) & 0x0000ff00UL ) \
+	| ( ( ( value ) << 8 ) & 0x00ff0000UL ) \
+	| ( ( value ) << 24 ) )
+
+static const uint32_t libbde_sha256_stretch_initial_hash_values[ 8 ] = {
+	0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+	0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL };
+
+static const uint32_t libbde_sha256_stretch_round_constants[ 64 ] = {
+	0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+	0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+	0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+	0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+	0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+	0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+	0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+	0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL };
+
+#if defined( HAVE_LIBBDE_SHA256_STRETCH_SHA_NI )
+
+/* Determines if the CPU supports the SHA-NI instructions
+ * Returns 1 if supported or 0 if not
+ */
+int libbde_sha256_stretch_sha_ni_is_supported(
+     void )
+{
+#if defined( _MSC_VER )
+	int cpu_info[ 4 ];
+
+	__cpuid(
+	 cpu_info,
+	 0 );
+
+	if( cpu_info[ 0 ] < 7 )
+	{
+		return( 0 );
+	}
+	__cpuid(
+	 cpu_info,
+	 1 );
+
+	if( ( cpu_info[ 2 ] & 0x00080000UL ) == 0 )
+	{
+		return( 0 );
+	}
+	__cpuidex(
+	 cpu_info,
+	 7,
+	 0 );
+
+	if( ( cpu_info[ 1 ] & 0x20000000UL ) != 0 )
+	{
+		return( 1 );
+	}
+#else
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+
+	if( __get_cpuid_max(
+	     0,
+	     NULL ) < 7 )
+	{
+		return( 0 );
+	}
+	if( __get_cpuid(
+	     1,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		return( 0 );
+	}
+	/* ECX bit 19 indicates SSE4.1
+	 */
+	if( ( ecx & 0x00080000UL ) == 0 )
+	{
+		return( 0 );
+	}
+	__cpuid_count(
+	 7,
+	 0,
+	 eax,
+	 ebx,
+	 ecx,
+	 edx );
+
+	/* EBX bit 29 indicates SHA
+	 */
+	if( ( ebx & 0x20000000UL ) != 0 )
+	{
+		return( 1 );
+	}
+#endif
+	return( 0 );
+}
+
+/* Transforms a single block using the SHA-NI instructions
+ * The hash values are stored as ABEF and CDGH, the message words are overwritten
+ * by the message schedule
+ */
+LIBBDE_SHA256_STRETCH_SHA_NI_TARGET
+static void libbde_sha256_stretch_sha_ni_transform(
+             __m128i *abef_hash_values,
+             __m128i *cdgh_hash_values,
+             __m128i *message_words )
+{
+	__m128i abef_initial_hash_values = *abef_hash_values;
+	__m128i cdgh_initial_hash_values = *cdgh_hash_values;
+	__m128i round_values;
+	int group_index                  = 0;
+
+	/* Every group consists of 4 rounds, the message schedule of a next group
+	 * is calculated while the rounds of the current group are processed
+	 */
+	for( group_index = 0;
+	     group_index < 16;
+	     group_index++ )
+	{
+		round_values = _mm_add_epi32(
+		                message_words[ group_index & 3 ],
+		                _mm_loadu_si128(
+		                 (const __m128i *) &( libbde_sha256_stretch_round_constants[ group_index * 4 ] ) ) );
+
+		*cdgh_hash_values = _mm_sha256rnds2_epu32(
+		                     *cdgh_hash_values,
+		                     *abef_hash_values,
+		                     round_values );
+
+		if( ( group_index >= 3 )
+		 && ( group_index < 15 ) )
+		{
+			message_words[ ( group_index + 1 ) & 3 ] = _mm_sha256msg2_epu32(
+			                                            _mm_add_epi32(
+			                                             message_words[ ( group_index + 1 ) & 3 ],
+			                                             _mm_alignr_epi8(
+			                                              message_words[ group_index & 3 ],
+			                                              message_words[ ( group_index - 1 ) & 3 ],
+			                                              4 ) ),
+			                                            message_words[ group_index & 3 ] );
+		}
+		round_values = _mm_shuffle_epi32(
+		                round_values,
+		                0x0e );
+
+		*abef_hash_values = _mm_sha256rnds2_epu32(
+		                     *abef_hash_values,
+		                     *cdgh_hash_values,
+		                     round_values );
+
+		if( ( group_index >= 1 )
+		 && ( group_index < 13 ) )
+		{
+			message_words[ ( group_index - 1 ) & 3 ] = _mm_sha256msg1_epu32(
+			                                            message_words[ ( group_index - 1 ) & 3 ],
+			                                            message_words[ group_index & 3 ] );
+		}
+	}
+	*abef_hash_values = _mm_add_epi32(
+	                     *abef_hash_values,
+	                     abef_initial_hash_values );
+
+	*cdgh_hash_values = _mm_add_epi32(
+	                     *cdgh_hash_values,
+	                     cdgh_initial_hash_values );
+}
+
+/* Stretches the password hash using the SHA-NI instructions
+ * Returns 1 if all iterations were calculated or 0 if aborted
+ */
+LIBBDE_SHA256_STRETCH_SHA_NI_TARGET
+static int libbde_sha256_stretch_sha_ni_calculate(
+             const uint32_t *password_hash_words,
+             const uint32_t *salt_words,
+             uint32_t number_of_iterations,
+             uint32_t *hash_values,
+             volatile int *abort_signal )
+{
+	__m128i first_block_message_words[ 4 ];
+	__m128i second_block_message_words[ 4 ];
+	__m128i abef_initial_hash_values;
+	__m128i cdgh_initial_hash_values;
+	__m128i abef_hash_values;
+	__m128i cdgh_hash_values;
+	__m128i hash_values_high;
+	__m128i hash_values_low;
+	__m128i password_hash_words_high;
+	__m128i password_hash_words_low;
+	__m128i salt_words_vector;
+	__m128i padding_words;
+
+	uint32_t iteration_count = 0;
+
+	abef_initial_hash_values = _mm_set_epi32(
+	                            (int) libbde_sha256_stretch_initial_hash_values[ 0 ],
+	                            (int) libbde_sha256_stretch_initial_hash_values[ 1 ],
+	                            (int) libbde_sha256_stretch_initial_hash_values[ 4 ],
+	                            (int) libbde_sha256_stretch_initial_hash_values[ 5 ] );
+
+	cdgh_initial_hash_values = _mm_set_epi32(
+	                            (int) libbde_sha256_stretch_initial_hash_values[ 2 ],
+	                            (int) libbde_sha256_stretch_initial_hash_values[ 3 ],
+	                            (int) libbde_sha256_stretch_initial_hash_values[ 6 ],
+	                            (int) libbde_sha256_stretch_initial_hash_values[ 7 ] );
+
+	password_hash_words_high = _mm_loadu_si128(
+	                            (const __m128i *) &( password_hash_words[ 0 ] ) );
+
+	password_hash_words_low = _mm_loadu_si128(
+	                           (const __m128i *) &( password_hash_words[ 4 ] ) );
+
+	salt_words_vector = _mm_loadu_si128(
+	                     (const __m128i *) salt_words );
+
+	padding_words = _mm_set_epi32(
+	                 LIBBDE_SHA256_STRETCH_DATA_BIT_SIZE,
+	                 0,
+	                 0,
+	                 0 );
+
+	/* The hash of the previous iteration is 0 for the first iteration
+	 */
+	hash_values_high = _mm_setzero_si128();
+	hash_values_low  = _mm_setzero_si128();
+
+	for( iteration_count = 0;
+	     iteration_count < number_of_iterations;
+	     iteration_count++ )
+	{
+		if( ( abort_signal != NULL )
+		 && ( ( iteration_count % LIBBDE_SHA256_STRETCH_ABORT_CHECK_INTERVAL ) == 0 )
+		 && ( *abort_signal != 0 ) )
+		{
+			break;
+		}
+		first_block_message_words[ 0 ] = hash_values_high;
+		first_block_message_words[ 1 ] = hash_values_low;
+		first_block_message_words[ 2 ] = password_hash_words_high;
+		first_block_message_words[ 3 ] = password_hash_words_low;
+
+		second_block_message_words[ 0 ] = salt_words_vector;
+		second_block_message_words[ 1 ] = _mm_set_epi32(
+		                                   0,
+		                                   (int) 0x80000000UL,
+		                                   0,
+		                                   (int) libbde_sha256_stretch_swap_bytes( iteration_count ) );
+		second_block_message_words[ 2 ] = _mm_setzero_si128();
+		second_block_message_words[ 3 ] = padding_words;
+
+		abef_hash_values = abef_initial_hash_values;
+		cdgh_hash_values = cdgh_initial_hash_values;
+
+		libbde_sha256_stretch_sha_ni_transform(
+		 &abef_hash_values,
+		 &cdgh_hash_values,
+		 first_block_message_words );
+
+		libbde_sha256_stretch_sha_ni_transform(
+		 &abef_hash_values,
+		 &cdgh_hash_values,
+		 second_block_message_words );
+
+		/* Convert ABEF and CDGH into ABCD and EFGH
+		 */
+		hash_values_high = _mm_shuffle_epi32(
+		                    _mm_unpackhi_epi64(
+		                     abef_hash_values,
+		                     cdgh_hash_values ),
+		                    0xb1 );
+
+		hash_values_low = _mm_shuffle_epi32(
+		                   _mm_unpacklo_epi64(
+		                    abef_hash_values,
+		                    cdgh_hash_values ),
+		                   0xb1 );
+	}
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 0 ] ),
+	 hash_values_high );
+
+	_mm_storeu_si128(
+	 (__m128i *) &( hash_values[ 4 ] ),
+	 hash_values_low );
+
+	if( iteration_count < number_of_iterations )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBBDE_SHA256_STRETCH_SHA_NI ) */
+
+#if defined( HAVE_LIBBDE_SHA256_STRETCH_AVX2 )
+
+/* Determines if the CPU and operating system support the AVX2 instructions
+ * Returns 1 if supported or 0 if not
+ */
+int libbde_sha256_stretch_avx2_is_supported(
+     void )
+{
+#if defined( _MSC_VER )
+	int cpu_info[ 4 ];
+
+	__cpuid(
+	 cpu_info,
+	 0 );
+
+	if( cpu_info[ 0 ] < 7 )
+	{
+		return( 0 );
+	}
+	__cpuid(
+	 cpu_info,
+	 1 );
+
+	if( ( ( cpu_info[ 2 ] & 0x08000000UL ) == 0 )
+	 || ( ( cpu_info[ 2 ] & 0x10000000UL ) == 0 ) )
+	{
+		return( 0 );
+	}
+	if( ( _xgetbv( 0 ) & 0x06 ) != 0x06 )
+	{
+		return( 0 );
+	}
+	__cpuidex(
+	 cpu_info,
+	 7,
+	 0 );
+
+	if( ( cpu_info[ 1 ] & 0x00000020UL ) != 0 )
+	{
+		return( 1 );
+	}
+#else
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+
+	if( __get_cpuid_max(
+	     0,
+	     NULL ) < 7 )
+	{
+		return( 0 );
+	}
+	if( __get_cpuid(
+	     1,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) == 0 )
+	{
+		return( 0 );
+	}
+	/* ECX bit 27 indicates OSXSAVE and ECX bit 28 indicates AVX
+	 */
+	if( ( ( ecx & 0x08000000UL ) == 0 )
+	 || ( ( ecx & 0x10000000UL ) == 0 ) )
+	{
+		return( 0 );
+	}
+	/* The operating system must preserve the XMM and YMM registers
+	 */
+	__asm__ __volatile__ (
+	 "xgetbv"
+	 : "=a" ( eax ), "=d" ( edx )
+	 : "c" ( 0 ) );
+
+	if( ( eax & 0x06 ) != 0x06 )
+	{
+		return( 0 );
+	}
+	__cpuid_count(
+	 7,
+	 0,
+	 eax,
+	 ebx,
+	 ecx,
+	 edx );
+
+	/* EBX bit 5 indicates AVX2
+	 */
+	if( ( ebx & 0x00000020UL ) != 0 )
+	{
+		return( 1 );
+	}
+#endif
+	return( 0 );
+}
+
+/* Calculates the message schedule words of 8 blocks from the schedule index up to the end index
+ */
+LIBBDE_SHA256_STRETCH_AVX2_TARGET
+static void libbde_sha256_stretch_avx2_calculate_schedule(
+             __m256i *schedule_words,
+             int schedule_index,
+             int end_index )
+{
+	__m256i sigma0;
+	__m256i sigma1;
+
+	while( schedule_index < end_index )
+	{
+		sigma0 = _mm256_xor_si256(
+		          _mm256_xor_si256(
+		           libbde_sha256_stretch_avx2_rotate_right( schedule_words[ schedule_index - 15 ], 7 ),
+		           libbde_sha256_stretch_avx2_rotate_right( schedule_words[ schedule_index - 15 ], 18 ) ),
+		          _mm256_srli_epi32(
+		           schedule_words[ schedule_index - 15 ],
+		           3 ) );
+
+		sigma1 = _mm256_xor_si256(
+		          _mm256_xor_si256(
+		           libbde_sha256_stretch_avx2_rotate_right( schedule_words[ schedule_index - 2 ], 17 ),
+		           libbde_sha256_stretch_avx2_rotate_right( schedule_words[ schedule_index - 2 ], 19 ) ),
+		          _mm256_srli_epi32(
+		           schedule_words[ schedule_index - 2 ],
+		           10 ) );
+
+		schedule_words[ schedule_index ] = _mm256_add_epi32(
+		                                    _mm256_add_epi32(
+		                                     schedule_words[ schedule_index - 16 ],
+		                                     sigma0 ),
+		                                    _mm256_add_epi32(
+		                                     schedule_words[ schedule_index - 7 ],
+		                                     sigma1 ) );
+
+		schedule_index++;
+	}
+}
+
+/* Transforms 8 blocks, one per 32-bit lane, using their message schedules
+ */
+LIBBDE_SHA256_STRETCH_AVX2_TARGET
+static void libbde_sha256_stretch_avx2_transform(
+             __m256i *hash_values,
+             const __m256i *schedule_words )
+{
+	__m256i a = hash_values[ 0 ];
+	__m256i b = hash_values[ 1 ];
+	__m256i c = hash_values[ 2 ];
+	__m256i d = hash_values[ 3 ];
+	__m256i e = hash_values[ 4 ];
+	__m256i f = hash_values[ 5 ];
+	__m256i g = hash_values[ 6 ];
+	__m256i h = hash_values[ 7 ];
+	__m256i temporary1;
+	__m256i temporary2;
+	int round_index = 0;
+
+	for( round_index = 0;
+	     round_index < 64;
+	     round_index++ )
+	{
+		temporary1 = _mm256_add_epi32(
+		              _mm256_add_epi32(
+		               h,
+		               _mm256_xor_si256(
+		                _mm256_xor_si256(
+		                 libbde_sha256_stretch_avx2_rotate_right( e, 6 ),
+		                 libbde_sha256_stretch_avx2_rotate_right( e, 11 ) ),
+		                libbde_sha256_stretch_avx2_rotate_right( e, 25 ) ) ),
+		              _mm256_add_epi32(
+		               _mm256_xor_si256(
+		                _mm256_and_si256(
+		                 e,
+		                 f ),
+		                _mm256_andnot_si256(
+		                 e,
+		                 g ) ),
+		               _mm256_add_epi32(
+		                _mm256_set1_epi32(
+		                 (int) libbde_sha256_stretch_round_constants[ round_index ] ),
+		                schedule_words[ round_index ] ) ) );
+
+		temporary2 = _mm256_add_epi32(
+		              _mm256_xor_si256(
+		               _mm256_xor_si256(
+		                libbde_sha256_stretch_avx2_rotate_right( a, 2 ),
+		                libbde_sha256_stretch_avx2_rotate_right( a, 13 ) ),
+		               libbde_sha256_stretch_avx2_rotate_right( a, 22 ) ),
+		              _mm256_or_si256(
+		               _mm256_and_si256(
+		                a,
+		                _mm256_or_si256(
+		                 b,
+		                 c ) ),
+		               _mm256_and_si256(
+		                b,
+		                c ) ) );
+
+		h = g;
+		g = f;
+		f = e;
+		e = _mm256_add_epi32(
+		     d,
+		     temporary1 );
+		d = c;
+		c = b;
+		b = a;
+		a = _mm256_add_epi32(
+		     temporary1,
+		     temporary2 );
+	}
+	hash_values[ 0 ] = _mm256_add_epi32( hash_values[ 0 ], a );
+	hash_values[ 1 ] = _mm256_add_epi32( hash_values[ 1 ], b );
+	hash_values[ 2 ] = _mm256_add_epi32( hash_values[ 2 ], c );
+	hash_values[ 3 ] = _mm256_add_epi32( hash_values[ 3 ], d );
+	hash_values[ 4 ] = _mm256_add_epi32( hash_values[ 4 ], e );
+	hash_values[ 5 ] = _mm256_add_epi32( hash_values[ 5 ], f );
+	hash_values[ 6 ] = _mm256_add_epi32( hash_values[ 6 ], g );
+	hash_values[ 7 ] = _mm256_add_epi32( hash_values[ 7 ], h );
+}
+
+/* Stretches 8 password hashes with the same salt, one per 32-bit lane
+ * The password hash words and hash values are stored per password hash
+ * Returns 1 if all iterations were calculated or 0 if aborted
+ */
+LIBBDE_SHA256_STRETCH_AVX2_TARGET
+static int libbde_sha256_stretch_avx2_calculate(
+             const uint32_t *password_hash_words,
+             const uint32_t *salt_words,
+             uint32_t number_of_iterations,
+             uint32_t *hash_values,
+             volatile int *abort_signal )
+{
+	__m256i first_block_schedule_words[ 64 ];
+	__m256i second_block_schedule_words[ 64 ];
+	__m256i lane_hash_values[ 8 ];
+
+	uint32_t lane_values[ LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES ];
+
+	uint32_t iteration_count = 0;
+	int lane_index           = 0;
+	int word_index           = 0;
+
+	/* The password hash words are transposed so that every lane contains
+	 * the words of a single password hash
+	 */
+	for( word_index = 0;
+	     word_index < 8;
+	     word_index++ )
+	{
+		for( lane_index = 0;
+		     lane_index < LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES;
+		     lane_index++ )
+		{
+			lane_values[ lane_index ] = password_hash_words[ ( lane_index * 8 ) + word_index ];
+		}
+		first_block_schedule_words[ word_index + 8 ] = _mm256_loadu_si256(
+		                                                (const __m256i *) lane_values );
+
+		/* The hash of the previous iteration is 0 for the first iteration
+		 */
+		lane_hash_values[ word_index ] = _mm256_setzero_si256();
+	}
+	for( word_index = 0;
+	     word_index < 4;
+	     word_index++ )
+	{
+		second_block_schedule_words[ word_index ] = _mm256_set1_epi32(
+		                                             (int) salt_words[ word_index ] );
+	}
+	second_block_schedule_words[ 4 ] = _mm256_setzero_si256();
+	second_block_schedule_words[ 5 ] = _mm256_setzero_si256();
+	second_block_schedule_words[ 6 ] = _mm256_set1_epi32(
+	                                    (int) 0x80000000UL );
+
+	for( word_index = 7;
+	     word_index < 15;
+	     word_index++ )
+	{
+		second_block_schedule_words[ word_index ] = _mm256_setzero_si256();
+	}
+	second_block_schedule_words[ 15 ] = _mm256_set1_epi32(
+	                                     LIBBDE_SHA256_STRETCH_DATA_BIT_SIZE );
+
+	/* Schedule words 16 to 18 do not depend on the iteration count
+	 */
+	libbde_sha256_stretch_avx2_calculate_schedule(
+	 second_block_schedule_words,
+	 16,
+	 19 );
+
+	for( iteration_count = 0;
+	     iteration_count < number_of_iterations;
+	     iteration_count++ )
+	{
+		if( ( abort_signal != NULL )
+		 && ( ( iteration_count % LIBBDE_SHA256_STRETCH_ABORT_CHECK_INTERVAL ) == 0 )
+		 && ( *abort_signal != 0 ) )
+		{
+			break;
+		}
+		for( word_index = 0;
+		     word_index < 8;
+		     word_index++ )
+		{
+			first_block_schedule_words[ word_index ] = lane_hash_values[ word_index ];
+			lane_hash_values[ word_index ]           = _mm256_set1_epi32(
+			                                            (int) libbde_sha256_stretch_initial_hash_values[ word_index ] );
+		}
+		libbde_sha256_stretch_avx2_calculate_schedule(
+		 first_block_schedule_words,
+		 16,
+		 64 );
+
+		libbde_sha256_stretch_avx2_transform(
+		 lane_hash_values,
+		 first_block_schedule_words );
+
+		second_block_schedule_words[ 4 ] = _mm256_set1_epi32(
+		                                    (int) libbde_sha256_stretch_swap_bytes( iteration_count ) );
+
+		libbde_sha256_stretch_avx2_calculate_schedule(
+		 second_block_schedule_words,
+		 19,
+		 64 );
+
+		libbde_sha256_stretch_avx2_transform(
+		 lane_hash_values,
+		 second_block_schedule_words );
+	}
+	for( word_index = 0;
+	     word_index < 8;
+	     word_index++ )
+	{
+		_mm256_storeu_si256(
+		 (__m256i *) lane_values,
+		 lane_hash_values[ word_index ] );
+
+		for( lane_index = 0;
+		     lane_index < LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES;
+		     lane_index++ )
+		{
+			hash_values[ ( lane_index * 8 ) + word_index ] = lane_values[ lane_index ];
+		}
+	}
+	memory_set(
+	 first_block_schedule_words,
+	 0,
+	 sizeof( __m256i ) * 64 );
+
+	memory_set(
+	 lane_hash_values,
+	 0,
+	 sizeof( __m256i ) * 8 );
+
+	memory_set(
+	 lane_values,
+	 0,
+	 sizeof( uint32_t ) * LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES );
+
+	if( iteration_count < number_of_iterations )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_LIBBDE_SHA256_STRETCH_AVX2 ) */
+
+/* Calculates the message schedule words from the schedule index up to the end index
+ */
+static void libbde_sha256_stretch_calculate_schedule(
+             uint32_t *schedule_words,
+             int schedule_index,
+             int end_index )
+{
+	uint32_t sigma0 = 0;
+	uint32_t sigma1 = 0;
+
+	while( schedule_index < end_index )
+	{
+		sigma0 = libbde_sha256_stretch_rotate_right( schedule_words[ schedule_index - 15 ], 7 )
+		       ^ libbde_sha256_stretch_rotate_right( schedule_words[ schedule_index - 15 ], 18 )
+		       ^ ( schedule_words[ schedule_index - 15 ] >> 3 );
+
+		sigma1 = libbde_sha256_stretch_rotate_right( schedule_words[ schedule_index - 2 ], 17 )
+		       ^ libbde_sha256_stretch_rotate_right( schedule_words[ schedule_index - 2 ], 19 )
+		       ^ ( schedule_words[ schedule_index - 2 ] >> 10 );
+
+		schedule_words[ schedule_index ] = schedule_words[ schedule_index - 16 ]
+		                                 + sigma0
+		                                 + schedule_words[ schedule_index - 7 ]
+		                                 + sigma1;
+
+		schedule_index++;
+	}
+}
+
+/* Transforms a single block using its message schedule
+ */
+static void libbde_sha256_stretch_transform(
+             uint32_t *hash_values,
+             const uint32_t *schedule_words )
+{
+	uint32_t a           = hash_values[ 0 ];
+	uint32_t b           = hash_values[ 1 ];
+	uint32_t c           = hash_values[ 2 ];
+	uint32_t d           = hash_values[ 3 ];
+	uint32_t e           = hash_values[ 4 ];
+	uint32_t f           = hash_values[ 5 ];
+	uint32_t g           = hash_values[ 6 ];
+	uint32_t h           = hash_values[ 7 ];
+	uint32_t temporary1  = 0;
+	uint32_t temporary2  = 0;
+	int round_index      = 0;
+
+	for( round_index = 0;
+	     round_index < 64;
+	     round_index++ )
+	{
+		temporary1 = h
+		           + ( libbde_sha256_stretch_rotate_right( e, 6 )
+		             ^ libbde_sha256_stretch_rotate_right( e, 11 )
+		             ^ libbde_sha256_stretch_rotate_right( e, 25 ) )
+		           + ( ( e & f ) ^ ( ~e & g ) )
+		           + libbde_sha256_stretch_round_constants[ round_index ]
+		           + schedule_words[ round_index ];
+
+		temporary2 = ( libbde_sha256_stretch_rotate_right( a, 2 )
+		             ^ libbde_sha256_stretch_rotate_right( a, 13 )
+		             ^ libbde_sha256_stretch_rotate_right( a, 22 ) )
+		           + ( ( a & b ) ^ ( a & c ) ^ ( b & c ) );
+
+		h = g;
+		g = f;
+		f = e;
+		e = d + temporary1;
+		d = c;
+		c = b;
+		b = a;
+		a = temporary1 + temporary2;
+	}
+	hash_values[ 0 ] += a;
+	hash_values[ 1 ] += b;
+	hash_values[ 2 ] += c;
+	hash_values[ 3 ] += d;
+	hash_values[ 4 ] += e;
+	hash_values[ 5 ] += f;
+	hash_values[ 6 ] += g;
+	hash_values[ 7 ] += h;
+}
+
+/* Stretches the password hash
+ * The constant message words and the schedule words that only depend on them
+ * are calculated once instead of for every iteration
+ * Returns 1 if all iterations were calculated or 0 if aborted
+ */
+static int libbde_sha256_stretch_generic_calculate(
+             const uint32_t *password_hash_words,
+             const uint32_t *salt_words,
+             uint32_t number_of_iterations,
+             uint32_t *hash_values,
+             volatile int *abort_signal )
+{
+	uint32_t first_block_schedule_words[ 64 ];
+	uint32_t second_block_schedule_words[ 64 ];
+
+	uint32_t iteration_count = 0;
+	int word_index           = 0;
+
+	/* The hash of the previous iteration is 0 for the first iteration
+	 */
+	for( word_index = 0;
+	     word_index < 8;
+	     word_index++ )
+	{
+		hash_values[ word_index ]                    = 0;
+		first_block_schedule_words[ word_index + 8 ] = password_hash_words[ word_index ];
+	}
+	for( word_index = 0;
+	     word_index < 4;
+	     word_index++ )
+	{
+		second_block_schedule_words[ word_index ] = salt_words[ word_index ];
+	}
+	/* Words 4 and 5 contain the iteration count, word 5 is always 0
+	 * since the number of iterations is a 32-bit value
+	 */
+	second_block_schedule_words[ 4 ] = 0;
+	second_block_schedule_words[ 5 ] = 0;
+	second_block_schedule_words[ 6 ] = 0x80000000UL;
+
+	for( word_index = 7;
+	     word_index < 15;
+	     word_index++ )
+	{
+		second_block_schedule_words[ word_index ] = 0;
+	}
+	second_block_schedule_words[ 15 ] = LIBBDE_SHA256_STRETCH_DATA_BIT_SIZE;
+
+	/* Schedule words 16 to 18 do not depend on the iteration count
+	 */
+	libbde_sha256_stretch_calculate_schedule(
+	 second_block_schedule_words,
+	 16,
+	 19 );
+
+	for( iteration_count = 0;
+	     iteration_count < number_of_iterations;
+	     iteration_count++ )
+	{
+		if( ( abort_signal != NULL )
+		 && ( ( iteration_count % LIBBDE_SHA256_STRETCH_ABORT_CHECK_INTERVAL ) == 0 )
+		 && ( *abort_signal != 0 ) )
+		{
+			break;
+		}
+		for( word_index = 0;
+		     word_index < 8;
+		     word_index++ )
+		{
+			first_block_schedule_words[ word_index ] = hash_values[ word_index ];
+			hash_values[ word_index ]                = libbde_sha256_stretch_initial_hash_values[ word_index ];
+		}
+		libbde_sha256_stretch_calculate_schedule(
+		 first_block_schedule_words,
+		 16,
+		 64 );
+
+		libbde_sha256_stretch_transform(
+		 hash_values,
+		 first_block_schedule_words );
+
+		second_block_schedule_words[ 4 ] = libbde_sha256_stretch_swap_bytes( iteration_count );
+
+		libbde_sha256_stretch_calculate_schedule(
+		 second_block_schedule_words,
+		 19,
+		 64 );
+
+		libbde_sha256_stretch_transform(
+		 hash_values,
+		 second_block_schedule_words );
+	}
+	memory_set(
+	 first_block_schedule_words,
+	 0,
+	 sizeof( uint32_t ) * 64 );
+
+	memory_set(
+	 second_block_schedule_words,
+	 0,
+	 sizeof( uint32_t ) * 64 );
+
+	if( iteration_count < number_of_iterations )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Calculates the key of a password hash and salt by repeated SHA-256 hashing
+ * This is equivalent to hashing the libbde_password_key_data_t structure
+ * with an increasing iteration count for the number of iterations
+ * If abort_signal is set the calculation stops when the value it references becomes non-zero,
+ * which is checked every LIBBDE_SHA256_STRETCH_ABORT_CHECK_INTERVAL iterations
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int libbde_sha256_stretch_calculate(
+     const uint8_t *password_hash,
+     size_t password_hash_size,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint32_t number_of_iterations,
+     uint8_t *key,
+     size_t key_size,
+     volatile int *abort_signal,
+     libcerror_error_t **error )
+{
+	uint32_t hash_values[ 8 ];
+	uint32_t password_hash_words[ 8 ];
+	uint32_t salt_words[ 4 ];
+
+	static char *function = "libbde_sha256_stretch_calculate";
+	int result            = 0;
+	int word_index        = 0;
+
+	if( password_hash == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password hash.",
+		 function );
+
+		return( -1 );
+	}
+	if( password_hash_size != 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: password hash size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: salt size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( key == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid key.",
+		 function );
+
+		return( -1 );
+	}
+	if( key_size != 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: key size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	for( word_index = 0;
+	     word_index < 8;
+	     word_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( password_hash[ word_index * 4 ] ),
+		 password_hash_words[ word_index ] );
+	}
+	for( word_index = 0;
+	     word_index < 4;
+	     word_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( salt[ word_index * 4 ] ),
+		 salt_words[ word_index ] );
+	}
+#if defined( HAVE_LIBBDE_SHA256_STRETCH_SHA_NI )
+	if( libbde_sha256_stretch_sha_ni_is_supported() != 0 )
+	{
+		result = libbde_sha256_stretch_sha_ni_calculate(
+		          password_hash_words,
+		          salt_words,
+		          number_of_iterations,
+		          hash_values,
+		          abort_signal );
+	}
+	else
+#endif
+	{
+		result = libbde_sha256_stretch_generic_calculate(
+		          password_hash_words,
+		          salt_words,
+		          number_of_iterations,
+		          hash_values,
+		          abort_signal );
+	}
+	if( result != 0 )
+	{
+		for( word_index = 0;
+		     word_index < 8;
+		     word_index++ )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( key[ word_index * 4 ] ),
+			 hash_values[ word_index ] );
+		}
+	}
+	memory_set(
+	 hash_values,
+	 0,
+	 sizeof( uint32_t ) * 8 );
+
+	memory_set(
+	 password_hash_words,
+	 0,
+	 sizeof( uint32_t ) * 8 );
+
+	return( result );
+}
+
+/* Calculates the keys of multiple password hashes with the same salt by repeated SHA-256 hashing
+ * The password hashes and keys are stored consecutively, 32 bytes per key
+ * When supported the keys are stretched in parallel in the lanes of the AVX2 registers.
+ * A group of 8 lanes takes about 4 times as long as a single key with SHA-NI,
+ * hence with SHA-NI smaller groups are stretched one key at a time
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_sha256_stretch_calculate_multiple(
+     const uint8_t *password_hashes,
+     size_t password_hashes_size,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint32_t number_of_iterations,
+     uint8_t *keys,
+     size_t keys_size,
+     int number_of_keys,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBBDE_SHA256_STRETCH_AVX2 )
+	uint32_t hash_values[ LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES * 8 ];
+	uint32_t password_hash_words[ LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES * 8 ];
+	uint32_t salt_words[ 4 ];
+
+	int lane_index              = 0;
+	int minimum_number_of_lanes = 2;
+	int number_of_lanes         = 0;
+	int use_avx2                = 0;
+	int word_index              = 0;
+#endif
+	static char *function       = "libbde_sha256_stretch_calculate_multiple";
+	int key_index               = 0;
+
+	if( password_hashes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid password hashes.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_keys < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of keys value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( password_hashes_size > (size_t) SSIZE_MAX )
+	 || ( password_hashes_size < ( (size_t) number_of_keys * 32 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: password hashes size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid salt.",
+		 function );
+
+		return( -1 );
+	}
+	if( salt_size != 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: salt size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( keys == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid keys.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( keys_size > (size_t) SSIZE_MAX )
+	 || ( keys_size < ( (size_t) number_of_keys * 32 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: keys size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_SHA256_STRETCH_AVX2 )
+	use_avx2 = libbde_sha256_stretch_avx2_is_supported();
+
+#if defined( HAVE_LIBBDE_SHA256_STRETCH_SHA_NI )
+	if( libbde_sha256_stretch_sha_ni_is_supported() != 0 )
+	{
+		minimum_number_of_lanes = 5;
+	}
+#endif
+	if( use_avx2 != 0 )
+	{
+		for( word_index = 0;
+		     word_index < 4;
+		     word_index++ )
+		{
+			byte_stream_copy_to_uint32_big_endian(
+			 &( salt[ word_index * 4 ] ),
+			 salt_words[ word_index ] );
+		}
+	}
+#endif
+	while( key_index < number_of_keys )
+	{
+#if defined( HAVE_LIBBDE_SHA256_STRETCH_AVX2 )
+		number_of_lanes = number_of_keys - key_index;
+
+		if( number_of_lanes > LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES )
+		{
+			number_of_lanes = LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES;
+		}
+		if( ( use_avx2 != 0 )
+		 && ( number_of_lanes >= minimum_number_of_lanes ) )
+		{
+			/* Unused lanes stretch the first password hash of the group
+			 */
+			for( lane_index = 0;
+			     lane_index < LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES;
+			     lane_index++ )
+			{
+				for( word_index = 0;
+				     word_index < 8;
+				     word_index++ )
+				{
+					if( lane_index < number_of_lanes )
+					{
+						byte_stream_copy_to_uint32_big_endian(
+						 &( password_hashes[ ( ( key_index + lane_index ) * 32 ) + ( word_index * 4 ) ] ),
+						 password_hash_words[ ( lane_index * 8 ) + word_index ] );
+					}
+					else
+					{
+						password_hash_words[ ( lane_index * 8 ) + word_index ] = password_hash_words[ word_index ];
+					}
+				}
+			}
+			libbde_sha256_stretch_avx2_calculate(
+			 password_hash_words,
+			 salt_words,
+			 number_of_iterations,
+			 hash_values,
+			 NULL );
+
+			for( lane_index = 0;
+			     lane_index < number_of_lanes;
+			     lane_index++ )
+			{
+				for( word_index = 0;
+				     word_index < 8;
+				     word_index++ )
+				{
+					byte_stream_copy_from_uint32_big_endian(
+					 &( keys[ ( ( key_index + lane_index ) * 32 ) + ( word_index * 4 ) ] ),
+					 hash_values[ ( lane_index * 8 ) + word_index ] );
+				}
+			}
+			key_index += number_of_lanes;
+
+			continue;
+		}
+#endif
+		if( libbde_sha256_stretch_calculate(
+		     &( password_hashes[ key_index * 32 ] ),
+		     32,
+		     salt,
+		     salt_size,
+		     number_of_iterations,
+		     &( keys[ key_index * 32 ] ),
+		     32,
+		     NULL,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate key: %d.",
+			 function,
+			 key_index );
+
+			goto on_error;
+		}
+		key_index++;
+	}
+#if defined( HAVE_LIBBDE_SHA256_STRETCH_AVX2 )
+	memory_set(
+	 hash_values,
+	 0,
+	 sizeof( uint32_t ) * LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES * 8 );
+
+	memory_set(
+	 password_hash_words,
+	 0,
+	 sizeof( uint32_t ) * LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES * 8 );
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBBDE_SHA256_STRETCH_AVX2 )
+	memory_set(
+	 hash_values,
+	 0,
+	 sizeof( uint32_t ) * LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES * 8 );
+
+	memory_set(
+	 password_hash_words,
+	 0,
+	 sizeof( uint32_t ) * LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES * 8 );
+#endif
+	return( -1 );
+}
+
@@ -0,0 +1,95 @@
+/*
+ * SHA-256 key stretching functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_SHA256_STRETCH_H )
+#define _LIBBDE_SHA256_STRETCH_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The SHA-NI and AVX2 kernels are only available on x86 and x86-64
+ */
+#if ( defined( __GNUC__ ) && ( defined( __x86_64__ ) || defined( __i386__ ) ) ) \
+ || ( defined( _MSC_VER ) && ( defined( _M_X64 ) || defined( _M_IX86 ) ) )
+#define HAVE_LIBBDE_SHA256_STRETCH_SHA_NI	1
+#define HAVE_LIBBDE_SHA256_STRETCH_AVX2		1
+#endif
+
+/* The number of SHA-256 iterations used to stretch a password or recovery password
+ */
+#define LIBBDE_SHA256_STRETCH_NUMBER_OF_ITERATIONS	0x00100000UL
+
+/* The number of iterations after which an abort signal is checked
+ */
+#define LIBBDE_SHA256_STRETCH_ABORT_CHECK_INTERVAL	0x00001000UL
+
+/* The number of keys that are stretched in parallel, one per 32-bit AVX2 lane
+ */
+#define LIBBDE_SHA256_STRETCH_NUMBER_OF_LANES		8
+
+#if defined( HAVE_LIBBDE_SHA256_STRETCH_SHA_NI )
+
+int libbde_sha256_stretch_sha_ni_is_supported(
+     void );
+
+#endif /* defined( HAVE_LIBBDE_SHA256_STRETCH_SHA_NI ) */
+
+#if defined( HAVE_LIBBDE_SHA256_STRETCH_AVX2 )
+
+int libbde_sha256_stretch_avx2_is_supported(
+     void );
+
+#endif /* defined( HAVE_LIBBDE_SHA256_STRETCH_AVX2 ) */
+
+int libbde_sha256_stretch_calculate(
+     const uint8_t *password_hash,
+     size_t password_hash_size,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint32_t number_of_iterations,
+     uint8_t *key,
+     size_t key_size,
+     volatile int *abort_signal,
+     libcerror_error_t **error );
+
+int libbde_sha256_stretch_calculate_multiple(
+     const uint8_t *password_hashes,
+     size_t password_hashes_size,
+     const uint8_t *salt,
+     size_t salt_size,
+     uint32_t number_of_iterations,
+     uint8_t *keys,
+     size_t keys_size,
+     int number_of_keys,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_SHA256_STRETCH_H ) */
+
@@ -29,7 +29,9 @@
 #include "libbde_io_handle.h"
 #include "libbde_libcerror.h"
 #include "libbde_libclocale.h"
+#include "libbde_recovery.h"
 #include "libbde_support.h"
+#include "libbde_volume_summary.h"
 
 #if !defined( HAVE_LOCAL_LIBBDE )
 
@@ -476,3 +478,417 @@ on_error:
 	return( -1 );
 }
 
+/* Probes a volume and retrieves a summary of its metadata
+ * Only the volume header and a single metadata block are read, no keys are derived
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_probe_volume(
+     const char *filename,
+     libbde_volume_summary_t **volume_summary,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libbde_probe_volume";
+	size_t filename_length           = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_probe_volume_file_io_handle(
+	     file_io_handle,
+	     volume_summary,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to probe volume using a file handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Probes a volume and retrieves a summary of its metadata
+ * Only the volume header and a single metadata block are read, no keys are derived
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_probe_volume_wide(
+     const wchar_t *filename,
+     libbde_volume_summary_t **volume_summary,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libbde_probe_volume_wide";
+	size_t filename_length           = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = wide_string_length(
+	                   filename );
+
+	if( filename_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_probe_volume_file_io_handle(
+	     file_io_handle,
+	     volume_summary,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to probe volume using a file handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Probes a volume and retrieves a summary of its metadata using a Basic File IO (bfio) handle
+ * Only the volume header and a single metadata block are read, no keys are derived
+ * Different file IO handles can be probed concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_probe_volume_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     libbde_volume_summary_t **volume_summary,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_probe_volume_file_io_handle";
+
+	if( volume_summary == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume summary.",
+		 function );
+
+		return( -1 );
+	}
+	if( *volume_summary != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume summary value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_volume_summary_initialize(
+	     volume_summary,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create volume summary.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_volume_summary_read_file_io_handle(
+	     *volume_summary,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume summary.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *volume_summary != NULL )
+	{
+		libbde_volume_summary_free(
+		 volume_summary,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Probes a volume and retrieves a summary of its metadata using a Basic File IO (bfio) pool
+ * The volume is read from a specific pool entry, different entries can be probed concurrently
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_probe_volume_file_io_pool(
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libbde_volume_summary_t **volume_summary,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libbde_probe_volume_file_io_pool";
+
+	if( libbfio_pool_get_handle(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file IO handle: %d from pool.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	if( libbde_probe_volume_file_io_handle(
+	     file_io_handle,
+	     volume_summary,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to probe volume using file IO handle: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Determines if an UTF-8 string contains a valid recovery password
+ * The recovery password is validated without accessing a volume
+ * Returns 1 if true, 0 if not or -1 on error
+ */
+int libbde_check_utf8_recovery_password(
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error )
+{
+	uint8_t binary_recovery_password[ 16 ];
+
+	static char *function = "libbde_check_utf8_recovery_password";
+	int result            = 0;
+
+	result = libbde_recovery_password_copy_from_utf8_string(
+	          utf8_string,
+	          utf8_string_length,
+	          binary_recovery_password,
+	          16,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy binary recovery password.",
+		 function );
+
+		return( -1 );
+	}
+	memory_set(
+	 binary_recovery_password,
+	 0,
+	 16 );
+
+	return( result );
+}
+
+/* Determines if an UTF-16 string contains a valid recovery password
+ * The recovery password is validated without accessing a volume
+ * Returns 1 if true, 0 if not or -1 on error
+ */
+int libbde_check_utf16_recovery_password(
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcerror_error_t **error )
+{
+	uint8_t binary_recovery_password[ 16 ];
+
+	static char *function = "libbde_check_utf16_recovery_password";
+	int result            = 0;
+
+	result = libbde_recovery_password_copy_from_utf16_string(
+	          utf16_string,
+	          utf16_string_length,
+	          binary_recovery_password,
+	          16,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy binary recovery password.",
+		 function );
+
+		return( -1 );
+	}
+	memory_set(
+	 binary_recovery_password,
+	 0,
+	 16 );
+
+	return( result );
+}
+
@@ -28,6 +28,7 @@
 #include "libbde_extern.h"
 #include "libbde_libcerror.h"
 #include "libbde_libbfio.h"
+#include "libbde_types.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -74,6 +75,47 @@ int libbde_check_volume_signature_file_io_handle(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+LIBBDE_EXTERN \
+int libbde_probe_volume(
+     const char *filename,
+     libbde_volume_summary_t **volume_summary,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBBDE_EXTERN \
+int libbde_probe_volume_wide(
+     const wchar_t *filename,
+     libbde_volume_summary_t **volume_summary,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBBDE_EXTERN \
+int libbde_probe_volume_file_io_handle(
+     libbfio_handle_t *file_io_handle,
+     libbde_volume_summary_t **volume_summary,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_probe_volume_file_io_pool(
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     libbde_volume_summary_t **volume_summary,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_check_utf8_recovery_password(
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_check_utf16_recovery_password(
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
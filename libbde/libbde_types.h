@@ -36,10 +36,12 @@
 #if defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI )
 typedef struct libbde_key_protector {}	libbde_key_protector_t;
 typedef struct libbde_volume {}		libbde_volume_t;
+typedef struct libbde_volume_summary {}	libbde_volume_summary_t;
 
 #else
 typedef intptr_t libbde_key_protector_t;
 typedef intptr_t libbde_volume_t;
+typedef intptr_t libbde_volume_summary_t;
 
 #endif /* defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI ) */
 
@@ -28,18 +28,24 @@
 #include "libbde_debug.h"
 #include "libbde_definitions.h"
 #include "libbde_io_handle.h"
+#include "libbde_keyring.h"
+#include "libbde_keyring_entry.h"
 #include "libbde_libbfio.h"
 #include "libbde_libcerror.h"
 #include "libbde_libcnotify.h"
 #include "libbde_libcthreads.h"
-#include "libbde_libfcache.h"
-#include "libbde_libfdata.h"
 #include "libbde_metadata.h"
 #include "libbde_key_protector.h"
 #include "libbde_password.h"
+#include "libbde_password_batch.h"
+#include "libbde_read_ahead.h"
+#include "libbde_read_pool.h"
 #include "libbde_recovery.h"
+#include "libbde_region_table.h"
+#include "libbde_sector_cache.h"
 #include "libbde_sector_data.h"
 #include "libbde_volume.h"
+#include "libbde_write_cache.h"
 
 #include "bde_metadata.h"
 
@@ -148,7 +154,9 @@ int libbde_volume_initialize(
 		goto on_error;
 	}
 #endif
-	internal_volume->is_locked = 1;
+	internal_volume->cache_size       = LIBBDE_DEFAULT_CACHE_SIZE;
+	internal_volume->read_ahead_depth = LIBBDE_DEFAULT_READ_AHEAD_DEPTH;
+	internal_volume->is_locked        = 1;
 
 	*volume = (libbde_volume_t *) internal_volume;
 
@@ -260,6 +268,22 @@ int libbde_volume_free(
 
 			result = -1;
 		}
+		if( internal_volume->keyring != NULL )
+		{
+			if( libbde_keyring_free(
+			     &( internal_volume->keyring ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free keyring.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 internal_volume );
 	}
@@ -356,13 +380,16 @@ int libbde_volume_open(
 
 		return( -1 );
 	}
-	if( ( access_flags & LIBBDE_ACCESS_FLAG_WRITE ) != 0 )
+	/* Writing requires read access to read-modify-write partial blocks
+	 */
+	if( ( ( access_flags & LIBBDE_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( access_flags & LIBBDE_ACCESS_FLAG_READ ) == 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported.",
+		 "%s: write-only access not supported.",
 		 function );
 
 		return( -1 );
@@ -559,13 +586,16 @@ int libbde_volume_open_wide(
 
 		return( -1 );
 	}
-	if( ( access_flags & LIBBDE_ACCESS_FLAG_WRITE ) != 0 )
+	/* Writing requires read access to read-modify-write partial blocks
+	 */
+	if( ( ( access_flags & LIBBDE_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( access_flags & LIBBDE_ACCESS_FLAG_READ ) == 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported.",
+		 "%s: write-only access not supported.",
 		 function );
 
 		return( -1 );
@@ -774,13 +804,16 @@ int libbde_volume_open_file_io_handle(
 
 		return( -1 );
 	}
-	if( ( access_flags & LIBBDE_ACCESS_FLAG_WRITE ) != 0 )
+	/* Writing requires read access to read-modify-write partial blocks
+	 */
+	if( ( ( access_flags & LIBBDE_ACCESS_FLAG_WRITE ) != 0 )
+	 && ( ( access_flags & LIBBDE_ACCESS_FLAG_READ ) == 0 ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported.",
+		 "%s: write-only access not supported.",
 		 function );
 
 		return( -1 );
@@ -789,6 +822,10 @@ int libbde_volume_open_file_io_handle(
 	{
 		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
 	}
+	if( ( access_flags & LIBBDE_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		bfio_access_flags |= LIBBFIO_ACCESS_FLAG_WRITE;
+	}
 	file_io_handle_is_open = libbfio_handle_is_open(
 	                          file_io_handle,
 	                          error );
@@ -822,6 +859,8 @@ int libbde_volume_open_file_io_handle(
 		}
 		file_io_handle_opened_in_library = 1;
 	}
+	internal_volume->access_flags = access_flags;
+
 	result = libbde_volume_open_read(
 	          internal_volume,
 	          file_io_handle,
@@ -976,6 +1015,71 @@ int libbde_volume_close(
 		}
 	}
 #endif
+	/* The read-ahead and read pool threads use the file IO handle and
+	 * the encryption contexts, hence they are stopped first
+	 */
+	if( internal_volume->read_ahead != NULL )
+	{
+		if( libbde_read_ahead_free(
+		     &( internal_volume->read_ahead ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->read_pool != NULL )
+	{
+		if( libbde_read_pool_free(
+		     &( internal_volume->read_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_volume->write_cache != NULL )
+	{
+		if( libbde_internal_volume_flush_write_cache(
+		     internal_volume,
+		     internal_volume->file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write cache.",
+			 function );
+
+			result = -1;
+		}
+		if( libbde_write_cache_free(
+		     &( internal_volume->write_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write cache.",
+			 function );
+
+			result = -1;
+		}
+	}
 	if( internal_volume->file_io_handle_opened_in_library != 0 )
 	{
 		if( libbfio_handle_close(
@@ -1011,6 +1115,7 @@ int libbde_volume_close(
 		internal_volume->file_io_handle_created_in_library = 0;
 	}
 	internal_volume->file_io_handle = NULL;
+	internal_volume->access_flags   = 0;
 	internal_volume->current_offset = 0;
 	internal_volume->is_locked      = 1;
 
@@ -1027,31 +1132,21 @@ int libbde_volume_close(
 
 		result = -1;
 	}
-	if( libfdata_vector_free(
-	     &( internal_volume->sectors_vector ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free sectors vector.",
-		 function );
-
-		result = -1;
-	}
-	if( libfcache_cache_free(
-	     &( internal_volume->sectors_cache ),
-	     error ) != 1 )
+	if( internal_volume->sector_cache != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to free sectors cache.",
-		 function );
+		if( libbde_sector_cache_free(
+		     &( internal_volume->sector_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sector cache.",
+			 function );
 
-		result = -1;
+			result = -1;
+		}
 	}
 	if( internal_volume->primary_metadata != NULL )
 	{
@@ -1101,6 +1196,8 @@ int libbde_volume_close(
 			result = -1;
 		}
 	}
+	internal_volume->number_of_metadata_blocks_read = 0;
+
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -1127,12 +1224,12 @@ int libbde_volume_open_read(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
-	uint8_t *startup_key_identifier    = NULL;
-	static char *function              = "libbde_volume_open_read";
-	size64_t file_size                 = 0;
-	size_t startup_key_identifier_size = 0;
-	int element_index                  = 0;
-	int result                         = 0;
+	libbde_metadata_t *metadata = NULL;
+	static char *function       = "libbde_volume_open_read";
+	size64_t file_size          = 0;
+	int metadata_index          = 0;
+	int read_result             = 0;
+	int result                  = 0;
 
 	if( internal_volume == NULL )
 	{
@@ -1189,24 +1286,24 @@ int libbde_volume_open_read(
 
 		return( -1 );
 	}
-	if( internal_volume->sectors_vector != NULL )
+	if( internal_volume->sector_cache != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - sectors vector already set.",
+		 "%s: invalid file - sector cache already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->sectors_cache != NULL )
+	if( internal_volume->write_cache != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid file - sectors cache already set.",
+		 "%s: invalid file - write cache already set.",
 		 function );
 
 		return( -1 );
@@ -1226,51 +1323,6 @@ int libbde_volume_open_read(
 		return( -1 );
 	}
 #endif
-	if( libbde_metadata_initialize(
-	     &( internal_volume->primary_metadata ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create primary metadata.",
-		 function );
-
-		goto on_error;
-	}
-	if( libbde_metadata_initialize(
-	     &( internal_volume->secondary_metadata ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create secondary metadata.",
-		 function );
-
-		goto on_error;
-	}
-	if( libbde_metadata_initialize(
-	     &( internal_volume->tertiary_metadata ),
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create tertiary metadata.",
-		 function );
-
-		goto on_error;
-	}
-	if( ( internal_volume->external_key_metadata != NULL )
-	 && ( internal_volume->external_key_metadata->startup_key_external_key != NULL ) )
-	{
-		startup_key_identifier      = internal_volume->external_key_metadata->startup_key_external_key->identifier;
-		startup_key_identifier_size = 16;
-	}
 #if defined( HAVE_DEBUG_OUTPUT )
 	if( libcnotify_verbose != 0 )
 	{
@@ -1293,122 +1345,41 @@ int libbde_volume_open_read(
 
 		goto on_error;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "Reading BitLocker primary metadata block:\n" );
-	}
-#endif
-	if( libbde_metadata_read_block(
-	     internal_volume->primary_metadata,
-	     internal_volume->io_handle,
-	     file_io_handle,
-	     internal_volume->io_handle->first_metadata_offset,
-	     startup_key_identifier,
-	     startup_key_identifier_size,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read primary metadata block.",
-		 function );
-
-		goto on_error;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "Reading BitLocker secondary metadata block:\n" );
-	}
-#endif
-	if( libbde_metadata_read_block(
-	     internal_volume->secondary_metadata,
-	     internal_volume->io_handle,
-	     file_io_handle,
-	     internal_volume->io_handle->second_metadata_offset,
-	     startup_key_identifier,
-	     startup_key_identifier_size,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read secondary metadata block.",
-		 function );
-
-		goto on_error;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "Reading BitLocker tertiary metadata block:\n" );
-	}
-#endif
-	if( libbde_metadata_read_block(
-	     internal_volume->tertiary_metadata,
-	     internal_volume->io_handle,
-	     file_io_handle,
-	     internal_volume->io_handle->third_metadata_offset,
-	     startup_key_identifier,
-	     startup_key_identifier_size,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read tertiary metadata block.",
-		 function );
-
-		goto on_error;
-	}
-	result = libbde_volume_open_read_keys_from_metadata(
-	          internal_volume,
-	          internal_volume->primary_metadata,
-	          error );
-
-	if( result == -1 )
+	/* The secondary and tertiary metadata blocks are only read when
+	 * the preceding metadata blocks are invalid or do not yield the keys
+	 */
+	while( ( result == 0 )
+	    && ( internal_volume->number_of_metadata_blocks_read < 3 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read keys from primary metadata.",
-		 function );
+		metadata_index = internal_volume->number_of_metadata_blocks_read;
 
-		goto on_error;
-	}
-	if( result == 0 )
-	{
-		result = libbde_volume_open_read_keys_from_metadata(
-			  internal_volume,
-			  internal_volume->secondary_metadata,
-			  error );
+		read_result = libbde_internal_volume_read_metadata_block(
+		               internal_volume,
+		               file_io_handle,
+		               metadata_index,
+		               &metadata,
+		               error );
 
-		if( result == -1 )
+		if( read_result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read keys from secondary metadata.",
-			 function );
+			 "%s: unable to read metadata block: %d.",
+			 function,
+			 metadata_index );
 
 			goto on_error;
 		}
-	}
-	if( result == 0 )
-	{
+		else if( read_result == 0 )
+		{
+			continue;
+		}
 		result = libbde_volume_open_read_keys_from_metadata(
-			  internal_volume,
-			  internal_volume->tertiary_metadata,
-			  error );
+		          internal_volume,
+		          metadata,
+		          error );
 
 		if( result == -1 )
 		{
@@ -1416,12 +1387,26 @@ int libbde_volume_open_read(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read keys from tertiary metadata.",
-			 function );
+			 "%s: unable to read keys from metadata block: %d.",
+			 function,
+			 metadata_index );
 
 			goto on_error;
 		}
 	}
+	if( ( internal_volume->primary_metadata == NULL )
+	 && ( internal_volume->secondary_metadata == NULL )
+	 && ( internal_volume->tertiary_metadata == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata - no valid metadata block found.",
+		 function );
+
+		goto on_error;
+	}
 	if( result != 0 )
 	{
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -1478,60 +1463,106 @@ int libbde_volume_open_read(
 		{
 			internal_volume->io_handle->volume_size += internal_volume->io_handle->bytes_per_sector;
 		}
-/* TODO clone function ? */
-		if( libfdata_vector_initialize(
-		     &( internal_volume->sectors_vector ),
-		     (size64_t) internal_volume->io_handle->bytes_per_sector,
-		     (intptr_t *) internal_volume->io_handle,
-		     NULL,
-		     NULL,
-		     (int (*)(intptr_t *, intptr_t *, libfdata_vector_t *, libfcache_cache_t *, int, int, off64_t, size64_t, uint32_t, uint8_t, libcerror_error_t **)) &libbde_io_handle_read_sector,
-		     NULL,
-		     LIBFDATA_DATA_HANDLE_FLAG_NON_MANAGED,
-		     error ) != 1 )
+		if( ( internal_volume->io_handle->bytes_per_sector == 0 )
+		 || ( ( internal_volume->io_handle->block_size % internal_volume->io_handle->bytes_per_sector ) != 0 ) )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create sectors vector.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported block size: %" PRIzd " for bytes per sector: %" PRIu16 ".",
+			 function,
+			 internal_volume->io_handle->block_size,
+			 internal_volume->io_handle->bytes_per_sector );
 
 			goto on_error;
 		}
-		if( libfdata_vector_append_segment(
-		     internal_volume->sectors_vector,
-		     &element_index,
-		     0,
-		     0,
-		     internal_volume->io_handle->volume_size,
-		     0,
+		if( libbde_io_handle_initialize_region_table(
+		     internal_volume->io_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append segment to sectors vector.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize region table.",
 			 function );
 
 			goto on_error;
 		}
-		if( libfcache_cache_initialize(
-		     &( internal_volume->sectors_cache ),
-		     LIBBDE_MAXIMUM_CACHE_ENTRIES_SECTORS,
-		     error ) != 1 )
+		if( internal_volume->cache_size > 0 )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create sectors cache.",
-			 function );
+			if( libbde_sector_cache_initialize(
+			     &( internal_volume->sector_cache ),
+			     internal_volume->io_handle->block_size,
+			     internal_volume->cache_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create sector cache.",
+				 function );
 
-			goto on_error;
+				goto on_error;
+			}
 		}
-		internal_volume->is_locked = 0;
+		if( ( internal_volume->access_flags & LIBBDE_ACCESS_FLAG_WRITE ) != 0 )
+		{
+			if( libbde_write_cache_initialize(
+			     &( internal_volume->write_cache ),
+			     internal_volume->io_handle->block_size,
+			     LIBBDE_DEFAULT_WRITE_CACHE_SIZE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create write cache.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( libbde_internal_volume_initialize_read_ahead(
+		     internal_volume,
+		     file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize read-ahead.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		if( ( internal_volume->number_of_decryption_threads > 0 )
+		 && ( internal_volume->write_cache == NULL ) )
+		{
+			if( libbde_read_pool_initialize(
+			     &( internal_volume->read_pool ),
+			     internal_volume->io_handle,
+			     file_io_handle,
+			     internal_volume->number_of_decryption_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create read pool.",
+				 function );
+
+				goto on_error;
+			}
+		}
+#endif
+		internal_volume->is_locked = 0;
 	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -1551,16 +1582,28 @@ int libbde_volume_open_read(
 	return( result );
 
 on_error:
-	if( internal_volume->sectors_cache != NULL )
+	if( internal_volume->read_pool != NULL )
+	{
+		libbde_read_pool_free(
+		 &( internal_volume->read_pool ),
+		 NULL );
+	}
+	if( internal_volume->read_ahead != NULL )
 	{
-		libfcache_cache_free(
-		 &( internal_volume->sectors_cache ),
+		libbde_read_ahead_free(
+		 &( internal_volume->read_ahead ),
 		 NULL );
 	}
-	if( internal_volume->sectors_vector != NULL )
+	if( internal_volume->write_cache != NULL )
 	{
-		libfdata_vector_free(
-		 &( internal_volume->sectors_vector ),
+		libbde_write_cache_free(
+		 &( internal_volume->write_cache ),
+		 NULL );
+	}
+	if( internal_volume->sector_cache != NULL )
+	{
+		libbde_sector_cache_free(
+		 &( internal_volume->sector_cache ),
 		 NULL );
 	}
 	if( internal_volume->tertiary_metadata != NULL )
@@ -1581,6 +1624,8 @@ on_error:
 		 &( internal_volume->primary_metadata ),
 		 NULL );
 	}
+	internal_volume->number_of_metadata_blocks_read = 0;
+
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	libcthreads_read_write_lock_release_for_write(
 	 internal_volume->read_write_lock,
@@ -1589,6 +1634,191 @@ on_error:
 	return( -1 );
 }
 
+/* Reads a metadata block when opening the volume for reading
+ * The metadata index refers to the primary (0), secondary (1) or tertiary (2) metadata block
+ * A metadata block that cannot be read or is invalid is not retained
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the metadata block is not available or -1 on error
+ */
+int libbde_internal_volume_read_metadata_block(
+     libbde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     int metadata_index,
+     libbde_metadata_t **metadata,
+     libcerror_error_t **error )
+{
+	libbde_metadata_t **metadata_block = NULL;
+	uint8_t *startup_key_identifier    = NULL;
+	static char *function              = "libbde_internal_volume_read_metadata_block";
+	const char *metadata_block_name    = NULL;
+	size_t startup_key_identifier_size = 0;
+	off64_t metadata_offset            = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata.",
+		 function );
+
+		return( -1 );
+	}
+	switch( metadata_index )
+	{
+		case 0:
+			metadata_block      = &( internal_volume->primary_metadata );
+			metadata_block_name = "primary";
+			metadata_offset     = internal_volume->io_handle->first_metadata_offset;
+			break;
+
+		case 1:
+			metadata_block      = &( internal_volume->secondary_metadata );
+			metadata_block_name = "secondary";
+			metadata_offset     = internal_volume->io_handle->second_metadata_offset;
+			break;
+
+		case 2:
+			metadata_block      = &( internal_volume->tertiary_metadata );
+			metadata_block_name = "tertiary";
+			metadata_offset     = internal_volume->io_handle->third_metadata_offset;
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid metadata index value out of bounds.",
+			 function );
+
+			return( -1 );
+	}
+	if( *metadata_block != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - %s metadata value already set.",
+		 function,
+		 metadata_block_name );
+
+		return( -1 );
+	}
+	*metadata = NULL;
+
+	if( internal_volume->number_of_metadata_blocks_read <= metadata_index )
+	{
+		internal_volume->number_of_metadata_blocks_read = metadata_index + 1;
+	}
+	/* On Windows Vista the secondary and tertiary metadata offsets
+	 * are only known once the primary metadata block has been read
+	 */
+	if( metadata_offset <= 0 )
+	{
+		return( 0 );
+	}
+	if( ( internal_volume->external_key_metadata != NULL )
+	 && ( internal_volume->external_key_metadata->startup_key_external_key != NULL ) )
+	{
+		startup_key_identifier      = internal_volume->external_key_metadata->startup_key_external_key->identifier;
+		startup_key_identifier_size = 16;
+	}
+	if( libbde_metadata_initialize(
+	     metadata_block,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create %s metadata.",
+		 function,
+		 metadata_block_name );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading BitLocker %s metadata block:\n",
+		 metadata_block_name );
+	}
+#endif
+	if( libbde_metadata_read_block(
+	     *metadata_block,
+	     internal_volume->io_handle,
+	     file_io_handle,
+	     metadata_offset,
+	     startup_key_identifier,
+	     startup_key_identifier_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read %s metadata block.",
+		 function,
+		 metadata_block_name );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( ( error != NULL )
+		 && ( libcnotify_verbose != 0 ) )
+		{
+			libcnotify_print_error_backtrace(
+			 *error );
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		if( libbde_metadata_free(
+		     metadata_block,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free %s metadata.",
+			 function,
+			 metadata_block_name );
+
+			return( -1 );
+		}
+		return( 0 );
+	}
+	*metadata = *metadata_block;
+
+	return( 1 );
+}
+
 /* Reads the keys from the metadata when opening the volume for reading
  * Returns 1 if successful, 0 if not or -1 on error
  */
@@ -1601,14 +1831,15 @@ int libbde_volume_open_read_keys_from_metadata(
 	uint8_t tweak_key[ 32 ];
 	uint8_t volume_master_key[ 32 ];
 
-	uint8_t *external_key          = NULL;
-	static char *function          = "libbde_volume_open_read_keys_from_metadata";
-	off64_t volume_header_offset   = 0;
-	size64_t volume_header_size    = 0;
-	size64_t encrypted_volume_size = 0;
-	size_t external_key_size       = 0;
-	uint16_t encryption_method     = 0;
-	int result                     = 0;
+	libbde_keyring_entry_t *keyring_entry = NULL;
+	uint8_t *external_key                 = NULL;
+	static char *function                 = "libbde_volume_open_read_keys_from_metadata";
+	off64_t volume_header_offset          = 0;
+	size64_t volume_header_size           = 0;
+	size64_t encrypted_volume_size        = 0;
+	size_t external_key_size              = 0;
+	uint16_t encryption_method            = 0;
+	int result                            = 0;
 
 	if( internal_volume == NULL )
 	{
@@ -1697,38 +1928,146 @@ int libbde_volume_open_read_keys_from_metadata(
 	volume_header_size    = metadata->volume_header_size;
 	encryption_method     = metadata->encryption_method;
 
-	result = libbde_metadata_read_volume_master_key(
-	          metadata,
-	          internal_volume->io_handle,
-	          internal_volume->password_keep,
-	          external_key,
-	          external_key_size,
-	          volume_master_key,
-	          32,
-	          error );
+	if( internal_volume->keyring != NULL )
+	{
+		result = libbde_keyring_get_entry_by_volume_identifier(
+		          internal_volume->keyring,
+		          metadata->volume_identifier,
+		          16,
+		          &keyring_entry,
+		          error );
 
-	if( result == -1 )
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve keyring entry.",
+			 function );
+
+			goto on_error;
+		}
+		result = 0;
+	}
+	if( keyring_entry != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to read volume master key from metadata.",
-		 function );
+		if( keyring_entry->type == LIBBDE_KEYRING_ENTRY_TYPE_FULL_VOLUME_ENCRYPTION_KEY )
+		{
+			/* The keys in the keyring are used as-is and no key derivation is done
+			 * hence their sizes must match the encryption method of the volume
+			 */
+			result = libbde_keyring_entry_check_encryption_method(
+			          keyring_entry,
+			          encryption_method,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to determine if keyring entry matches encryption method.",
+				 function );
 
-		goto on_error;
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+				 "%s: keyring entry key sizes do not match encryption method: 0x%04" PRIx16 ".",
+				 function,
+				 encryption_method );
+
+				goto on_error;
+			}
+			if( memory_copy(
+			     full_volume_encryption_key,
+			     keyring_entry->full_volume_encryption_key,
+			     keyring_entry->full_volume_encryption_key_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy full volume encryption key.",
+				 function );
+
+				goto on_error;
+			}
+			if( memory_copy(
+			     tweak_key,
+			     keyring_entry->tweak_key,
+			     keyring_entry->tweak_key_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy tweak key.",
+				 function );
+
+				goto on_error;
+			}
+			result = 1;
+		}
+		else if( keyring_entry->type == LIBBDE_KEYRING_ENTRY_TYPE_VOLUME_MASTER_KEY )
+		{
+			if( memory_copy(
+			     volume_master_key,
+			     keyring_entry->volume_master_key,
+			     32 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy volume master key.",
+				 function );
+
+				goto on_error;
+			}
+			/* If the volume master key in the keyring does not decrypt
+			 * the full volume encryption key, fall back to key derivation
+			 */
+			result = libbde_metadata_read_full_volume_encryption_key(
+			          metadata,
+			          internal_volume->io_handle,
+			          volume_master_key,
+			          32,
+			          full_volume_encryption_key,
+			          64,
+			          tweak_key,
+			          32,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read full volume encryption key from metadata.",
+				 function );
+
+				goto on_error;
+			}
+		}
 	}
-	else if( result != 0 )
+	if( result == 0 )
 	{
-		result = libbde_metadata_read_full_volume_encryption_key(
+		result = libbde_metadata_read_volume_master_key(
 		          metadata,
 		          internal_volume->io_handle,
+		          internal_volume->password_keep,
+		          external_key,
+		          external_key_size,
 		          volume_master_key,
 		          32,
-		          full_volume_encryption_key,
-		          64,
-		          tweak_key,
-		          32,
 		          error );
 
 		if( result == -1 )
@@ -1737,11 +2076,36 @@ int libbde_volume_open_read_keys_from_metadata(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to read full volume encryption key from metadata.",
+			 "%s: unable to read volume master key from metadata.",
 			 function );
 
 			goto on_error;
 		}
+		else if( result != 0 )
+		{
+			result = libbde_metadata_read_full_volume_encryption_key(
+			          metadata,
+			          internal_volume->io_handle,
+			          volume_master_key,
+			          32,
+			          full_volume_encryption_key,
+			          64,
+			          tweak_key,
+			          32,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to read full volume encryption key from metadata.",
+				 function );
+
+				goto on_error;
+			}
+		}
 	}
 	if( result != 0 )
 	{
@@ -1749,20 +2113,6 @@ int libbde_volume_open_read_keys_from_metadata(
 		internal_volume->io_handle->volume_header_offset  = volume_header_offset;
 		internal_volume->io_handle->volume_header_size    = volume_header_size;
 
-		if( libbde_encryption_initialize(
-		     &( internal_volume->io_handle->encryption_context ),
-		     encryption_method,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create encryption context.",
-			 function );
-
-			goto on_error;
-		}
 #if defined( HAVE_DEBUG_OUTPUT )
 		if( libcnotify_verbose != 0 )
 		{
@@ -1791,8 +2141,9 @@ int libbde_volume_open_read_keys_from_metadata(
 			 0 );
 		}
 #endif
-		if( libbde_encryption_set_keys(
-		     internal_volume->io_handle->encryption_context,
+		if( libbde_io_handle_set_encryption_keys(
+		     internal_volume->io_handle,
+		     encryption_method,
 		     full_volume_encryption_key,
 		     64,
 		     tweak_key,
@@ -1803,7 +2154,7 @@ int libbde_volume_open_read_keys_from_metadata(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set keys in encryption context.",
+			 "%s: unable to set encryption keys.",
 			 function );
 
 			goto on_error;
@@ -1933,26 +2284,24 @@ int libbde_volume_is_locked(
 	return( is_locked );
 }
 
-/* Reads (volume) data from the last current into a buffer using a Basic File IO (bfio) handle
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read or -1 on error
+/* Reads the secondary and tertiary metadata blocks
+ * When opening a volume these metadata blocks are only read if the preceding
+ * metadata blocks are invalid or do not provide the keys to unlock the volume
+ * Metadata blocks that were already read are not read again
+ * Returns 1 if all metadata blocks are available, 0 if one or more metadata blocks
+ * are not available or -1 on error
  */
-ssize_t libbde_internal_volume_read_buffer_from_file_io_handle(
-         libbde_internal_volume_t *internal_volume,
-         libbfio_handle_t *file_io_handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libbde_volume_read_metadata_copies(
+     libbde_volume_t *volume,
+     libcerror_error_t **error )
 {
-	libbde_sector_data_t *sector_data = NULL;
-	static char *function             = "libbde_internal_volume_read_buffer_from_file_io_handle";
-	off64_t element_data_offset       = 0;
-	size_t buffer_offset              = 0;
-	size_t read_size                  = 0;
-	size_t sector_data_offset         = 0;
-	ssize_t total_read_count          = 0;
+	libbde_internal_volume_t *internal_volume = NULL;
+	libbde_metadata_t *metadata               = NULL;
+	static char *function                     = "libbde_volume_read_metadata_copies";
+	int metadata_index                        = 0;
+	int result                                = 1;
 
-	if( internal_volume == NULL )
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -1963,184 +2312,205 @@ ssize_t libbde_internal_volume_read_buffer_from_file_io_handle(
 
 		return( -1 );
 	}
-	if( internal_volume->is_locked != 0 )
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - volume is locked.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->io_handle == NULL )
+#endif
+	if( ( internal_volume->number_of_metadata_blocks_read == 0 )
+	 || ( ( internal_volume->number_of_metadata_blocks_read < 3 )
+	  &&  ( internal_volume->file_io_handle == NULL ) ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 "%s: invalid volume - volume not open.",
 		 function );
 
-		return( -1 );
+		result = -1;
 	}
-	if( internal_volume->sectors_vector == NULL )
+	while( ( result != -1 )
+	    && ( internal_volume->number_of_metadata_blocks_read < 3 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing sectors vector.",
-		 function );
+		metadata_index = internal_volume->number_of_metadata_blocks_read;
 
-		return( -1 );
+		if( libbde_internal_volume_read_metadata_block(
+		     internal_volume,
+		     internal_volume->file_io_handle,
+		     metadata_index,
+		     &metadata,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read metadata block: %d.",
+			 function,
+			 metadata_index );
+
+			result = -1;
+		}
+	}
+	if( result != -1 )
+	{
+		if( ( internal_volume->primary_metadata == NULL )
+		 || ( internal_volume->secondary_metadata == NULL )
+		 || ( internal_volume->tertiary_metadata == NULL ) )
+		{
+			result = 0;
+		}
 	}
-	if( internal_volume->sectors_cache == NULL )
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid file - missing sectors cache.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->current_offset < 0 )
+#endif
+	return( result );
+}
+
+/* Initializes the read-ahead of an unlocked volume
+ * The read-ahead is only created if enabled, multi-threading is supported and the sector cache is available
+ * The depth is limited to half of the number of blocks in the sector cache,
+ * so that blocks read ahead do not evict each other before they are read
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_initialize_read_ahead(
+     libbde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_initialize_read_ahead";
+	size64_t depth        = 0;
+
+	if( internal_volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid volume - current offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer == NULL )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	if( internal_volume->read_ahead != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid buffer size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - read-ahead already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( (size64_t) internal_volume->current_offset >= internal_volume->io_handle->volume_size )
+	/* Blocks are not read ahead when the volume is opened for writing
+	 * since the read-ahead workers would fill the sector cache concurrently with the writer
+	 */
+	if( internal_volume->write_cache != NULL )
 	{
-		return( 0 );
+		return( 1 );
 	}
-	if( (size64_t) ( internal_volume->current_offset + buffer_size ) >= internal_volume->io_handle->volume_size )
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( ( internal_volume->sector_cache != NULL )
+	 && ( internal_volume->io_handle->block_size > 0 ) )
 	{
-		buffer_size = (size_t) ( internal_volume->io_handle->volume_size - internal_volume->current_offset );
-	}
-	sector_data_offset = (size_t) ( internal_volume->current_offset % internal_volume->io_handle->bytes_per_sector );
+		depth = internal_volume->cache_size / internal_volume->io_handle->block_size / 2;
 
-	while( buffer_size > 0 )
-	{
-		if( libfdata_vector_get_element_value_at_offset(
-		     internal_volume->sectors_vector,
-		     (intptr_t *) file_io_handle,
-		     internal_volume->sectors_cache,
-		     internal_volume->current_offset,
-		     &element_data_offset,
-		     (intptr_t **) &sector_data,
-		     0,
-		     error ) != 1 )
+		if( depth > (size64_t) internal_volume->read_ahead_depth )
 		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve sector data at offset: %" PRIi64 ".",
-			 function,
-			 internal_volume->current_offset );
-
-			return( -1 );
+			depth = (size64_t) internal_volume->read_ahead_depth;
 		}
-		if( sector_data == NULL )
+	}
+	if( depth > 0 )
+	{
+		if( libbde_read_ahead_initialize(
+		     &( internal_volume->read_ahead ),
+		     internal_volume->io_handle,
+		     file_io_handle,
+		     internal_volume->sector_cache,
+		     (int) depth,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing sector data at offset: %" PRIi64 ".",
-			 function,
-			 internal_volume->current_offset );
-
-			return( -1 );
-		}
-		read_size = sector_data->data_size - sector_data_offset;
-
-		if( read_size > buffer_size )
-		{
-			read_size = buffer_size;
-		}
-		if( read_size == 0 )
-		{
-			break;
-		}
-		if( memory_copy(
-		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-		     &( ( sector_data->data )[ sector_data_offset ] ),
-		     read_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy sector data to buffer.",
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read-ahead.",
 			 function );
 
 			return( -1 );
 		}
-		buffer_offset     += read_size;
-		buffer_size       -= read_size;
-		total_read_count  += (ssize_t) read_size;
-		sector_data_offset = 0;
-
-		internal_volume->current_offset += (off64_t) read_size;
-
-		if( (size64_t) internal_volume->current_offset >= internal_volume->io_handle->volume_size )
-		{
-			break;
-		}
-		if( internal_volume->io_handle->abort != 0 )
-		{
-			break;
-		}
 	}
-	return( total_read_count );
+#endif
+	return( 1 );
 }
 
-/* Reads data at the current offset into a buffer
+/* Reads (volume) data at a specific offset into a buffer using a Basic File IO (bfio) handle
+ * This function does not use or change the current offset and can be called
+ * by multiple threads simultaneously, acquire the read lock before call
  * Returns the number of bytes read or -1 on error
  */
-ssize_t libbde_volume_read_buffer(
-         libbde_volume_t *volume,
+ssize_t libbde_internal_volume_read_buffer_at_offset_from_file_io_handle(
+         libbde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
          void *buffer,
          size_t buffer_size,
+         off64_t offset,
          libcerror_error_t **error )
 {
-	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_read_buffer";
-	ssize_t read_count                        = 0;
+	libbde_encryption_context_t *encryption_context = NULL;
+	libbde_sector_data_t *sector_data               = NULL;
+	static char *function                           = "libbde_internal_volume_read_buffer_at_offset_from_file_io_handle";
+	off64_t block_offset                            = 0;
+	size_t block_data_offset                        = 0;
+	size_t buffer_offset                            = 0;
+	size_t read_size                                = 0;
+	ssize_t total_read_count                        = 0;
+	int context_index                               = -1;
+	int is_direct_read                              = 0;
+	int is_parallel_read                            = 0;
+	int is_read_ahead                               = 0;
+	int number_of_written_blocks                    = 0;
+	int result                                      = 0;
 
-	if( volume == NULL )
+	if( internal_volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2151,116 +2521,504 @@ ssize_t libbde_volume_read_buffer(
 
 		return( -1 );
 	}
-	internal_volume = (libbde_internal_volume_t *) volume;
-
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->is_locked != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - volume is locked.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	read_count = libbde_internal_volume_read_buffer_from_file_io_handle(
-		      internal_volume,
-		      internal_volume->file_io_handle,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
-
-		read_count = -1;
-	}
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( read_count );
-}
-
-/* Reads (volume) data at a specific offset
- * Returns the number of bytes read or -1 on error
- */
-ssize_t libbde_volume_read_buffer_at_offset(
-         libbde_volume_t *volume,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
-{
-	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_read_buffer_at_offset";
-	ssize_t read_count                        = 0;
-
-	if( volume == NULL )
+	if( buffer == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid buffer.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libbde_internal_volume_t *) volume;
-
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( buffer_size > (size_t) SSIZE_MAX )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libbde_internal_volume_seek_offset(
-	     internal_volume,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( offset < 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_volume->io_handle->volume_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) ( offset + buffer_size ) >= internal_volume->io_handle->volume_size )
+	{
+		buffer_size = (size_t) ( internal_volume->io_handle->volume_size - offset );
+	}
+	if( internal_volume->read_ahead != NULL )
+	{
+		/* Schedule the blocks after this read before reading it,
+		 * so that the workers decrypt them while the reader waits for its own data
+		 */
+		is_read_ahead = libbde_read_ahead_notify_read(
+		                 internal_volume->read_ahead,
+		                 offset,
+		                 buffer_size,
+		                 error );
+
+		if( is_read_ahead == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to notify read-ahead of read at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+	}
+	if( internal_volume->write_cache != NULL )
+	{
+		if( libbde_write_cache_get_number_of_entries(
+		     internal_volume->write_cache,
+		     &number_of_written_blocks,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries of write cache.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( buffer_size > 0 )
+	{
+		is_direct_read   = 0;
+		is_parallel_read = 0;
+
+		/* Blocks that were written but not yet flushed are only available
+		 * in the write cache, hence these cannot be read directly
+		 */
+		if( ( number_of_written_blocks == 0 )
+		 && ( buffer_size >= LIBBDE_MINIMUM_DIRECT_READ_SIZE )
+		 && ( ( offset % internal_volume->io_handle->bytes_per_sector ) == 0 ) )
+		{
+			is_direct_read = 1;
+
+			if( ( internal_volume->read_pool != NULL )
+			 && ( buffer_size >= LIBBDE_MINIMUM_PARALLEL_READ_SIZE ) )
+			{
+				is_parallel_read = 1;
+			}
+		}
+		/* The read pool workers grab encryption contexts themselves, hence
+		 * the context is not held while waiting for the read pool otherwise
+		 * the reader and the workers can deadlock when all contexts are in use
+		 */
+		if( is_parallel_read != 0 )
+		{
+			if( encryption_context != NULL )
+			{
+				if( libbde_io_handle_release_encryption_context(
+				     internal_volume->io_handle,
+				     context_index,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release encryption context.",
+					 function );
+
+					goto on_error;
+				}
+				context_index      = -1;
+				encryption_context = NULL;
+			}
+		}
+		else if( encryption_context == NULL )
+		{
+			if( libbde_io_handle_grab_encryption_context(
+			     internal_volume->io_handle,
+			     &context_index,
+			     &encryption_context,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to grab encryption context.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		block_data_offset = (size_t) ( offset % internal_volume->io_handle->block_size );
+		block_offset      = offset - block_data_offset;
+		read_size         = internal_volume->io_handle->block_size - block_data_offset;
+
+		if( read_size > buffer_size )
+		{
+			read_size = buffer_size;
+		}
+		result = 0;
+
+		if( number_of_written_blocks > 0 )
+		{
+			result = libbde_write_cache_get_data(
+			          internal_volume->write_cache,
+			          block_offset,
+			          block_data_offset,
+			          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			          read_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to copy written data at offset: %" PRIi64 " from write cache.",
+				 function,
+				 block_offset );
+
+				goto on_error;
+			}
+		}
+		/* Large reads bypass the sector cache unless blocks are read ahead into it
+		 */
+		if( ( result == 0 )
+		 && ( internal_volume->sector_cache != NULL )
+		 && ( is_parallel_read == 0 )
+		 && ( ( is_direct_read == 0 )
+		  || ( is_read_ahead != 0 ) ) )
+		{
+			result = libbde_sector_cache_get_data(
+			          internal_volume->sector_cache,
+			          block_offset,
+			          block_data_offset,
+			          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			          read_size,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to copy sector data at offset: %" PRIi64 " from cache.",
+				 function,
+				 block_offset );
+
+				goto on_error;
+			}
+		}
+		if( ( result == 0 )
+		 && ( is_direct_read != 0 ) )
+		{
+			read_size = buffer_size - ( buffer_size % internal_volume->io_handle->bytes_per_sector );
+
+			/* Keep the direct read short so that the next blocks are looked up in the sector cache
+			 */
+			if( ( is_parallel_read == 0 )
+			 && ( is_read_ahead != 0 )
+			 && ( read_size > LIBBDE_READ_AHEAD_RUN_SIZE ) )
+			{
+				read_size = LIBBDE_READ_AHEAD_RUN_SIZE;
+			}
+			if( is_parallel_read != 0 )
+			{
+				result = libbde_read_pool_read_buffer(
+				          internal_volume->read_pool,
+				          offset,
+				          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				          read_size,
+				          error );
+			}
+			else
+			{
+				result = libbde_sector_data_read_buffer(
+				          internal_volume->io_handle,
+				          file_io_handle,
+				          offset,
+				          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				          read_size,
+				          encryption_context,
+				          1,
+				          error );
+			}
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sector data at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				goto on_error;
+			}
+		}
+		else if( result == 0 )
+		{
+			/* The block is read and decrypted without holding a lock of the sector cache
+			 * so that concurrent readers only contend on the file IO
+			 */
+			if( libbde_sector_data_read_block(
+			     &sector_data,
+			     internal_volume->io_handle,
+			     file_io_handle,
+			     block_offset,
+			     (size64_t) internal_volume->io_handle->block_size,
+			     encryption_context,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read sector data at offset: %" PRIi64 ".",
+				 function,
+				 block_offset );
+
+				goto on_error;
+			}
+			if( memory_copy(
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     &( ( sector_data->data )[ block_data_offset ] ),
+			     read_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy sector data to buffer.",
+				 function );
+
+				goto on_error;
+			}
+			if( internal_volume->sector_cache != NULL )
+			{
+				if( libbde_sector_cache_set_data(
+				     internal_volume->sector_cache,
+				     block_offset,
+				     sector_data->data,
+				     sector_data->data_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to set sector data at offset: %" PRIi64 " in cache.",
+					 function,
+					 block_offset );
+
+					goto on_error;
+				}
+			}
+			if( libbde_sector_data_free(
+			     &sector_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free sector data.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		buffer_offset    += read_size;
+		buffer_size      -= read_size;
+		total_read_count += (ssize_t) read_size;
+		offset           += (off64_t) read_size;
+
+		if( internal_volume->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	if( encryption_context != NULL )
+	{
+		if( libbde_io_handle_release_encryption_context(
+		     internal_volume->io_handle,
+		     context_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release encryption context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( total_read_count );
+
+on_error:
+	if( sector_data != NULL )
+	{
+		libbde_sector_data_free(
+		 &sector_data,
+		 NULL );
+	}
+	if( context_index != -1 )
+	{
+		libbde_io_handle_release_encryption_context(
+		 internal_volume->io_handle,
+		 context_index,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads (volume) data from the last current into a buffer using a Basic File IO (bfio) handle
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbde_internal_volume_read_buffer_from_file_io_handle(
+         libbde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_read_buffer_from_file_io_handle";
+	ssize_t read_count    = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
 	}
+	read_count = libbde_internal_volume_read_buffer_at_offset_from_file_io_handle(
+	              internal_volume,
+	              file_io_handle,
+	              buffer,
+	              buffer_size,
+	              internal_volume->current_offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 internal_volume->current_offset );
+
+		return( -1 );
+	}
+	internal_volume->current_offset += (off64_t) read_count;
+
+	return( read_count );
+}
+
+/* Reads data at the current offset into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbde_volume_read_buffer(
+         libbde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_read_buffer";
+	ssize_t read_count                        = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
 	read_count = libbde_internal_volume_read_buffer_from_file_io_handle(
 		      internal_volume,
 		      internal_volume->file_io_handle,
@@ -2272,12 +3030,2683 @@ ssize_t libbde_volume_read_buffer_at_offset(
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (volume) data at a specific offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbde_volume_read_buffer_at_offset(
+         libbde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_read_buffer_at_offset";
+	ssize_t read_count                        = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbde_internal_volume_seek_offset(
+	     internal_volume,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbde_internal_volume_read_buffer_from_file_io_handle(
+		      internal_volume,
+		      internal_volume->file_io_handle,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Reads (volume) data at a specific offset without changing the current offset
+ * Unlike libbde_volume_read_buffer_at_offset this function only acquires
+ * the read lock and can be called by multiple threads simultaneously
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libbde_volume_read_buffer_at_offset_concurrent(
+         libbde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_read_buffer_at_offset_concurrent";
+	ssize_t read_count                        = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libbde_internal_volume_read_buffer_at_offset_from_file_io_handle(
+		      internal_volume,
+		      internal_volume->file_io_handle,
+		      buffer,
+		      buffer_size,
+		      offset,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Writes (volume) data at a specific offset from a buffer using a Basic File IO (bfio) handle
+ * The data is retained in the write cache until it is flushed, partially written blocks
+ * are read first so that the data of the block that is not overwritten is retained
+ * Data that overlaps the metadata areas or the stored volume header is rejected
+ * This function does not use or change the current offset and is not multi-thread safe
+ * acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libbde_internal_volume_write_buffer_at_offset_to_file_io_handle(
+         libbde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbde_encryption_context_t *encryption_context = NULL;
+	libbde_sector_data_t *sector_data               = NULL;
+	uint8_t *block_data                             = NULL;
+	static char *function                           = "libbde_internal_volume_write_buffer_at_offset_to_file_io_handle";
+	off64_t block_offset                            = 0;
+	size_t block_data_offset                        = 0;
+	size_t block_data_size                          = 0;
+	size_t buffer_offset                            = 0;
+	size_t write_size                               = 0;
+	ssize_t total_write_count                       = 0;
+	int context_index                               = -1;
+	int result                                      = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->is_locked != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - volume is locked.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->write_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing write cache, volume not opened for writing.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_volume->io_handle->volume_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) ( offset + buffer_size ) >= internal_volume->io_handle->volume_size )
+	{
+		buffer_size = (size_t) ( internal_volume->io_handle->volume_size - offset );
+	}
+	/* The BitLocker metadata areas and the stored volume header are never
+	 * overwritten when the write cache is flushed, hence writes into them
+	 * are rejected before the write and sector caches are changed
+	 */
+	result = libbde_region_table_range_has_sector_type(
+	          &( internal_volume->io_handle->region_table ),
+	          offset,
+	          (size64_t) buffer_size,
+	          LIBBDE_SECTOR_DATA_TYPE_ZERO,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if range overlaps metadata.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds - range overlaps metadata or volume header.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_io_handle_grab_encryption_context(
+	     internal_volume->io_handle,
+	     &context_index,
+	     &encryption_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab encryption context.",
+		 function );
+
+		goto on_error;
+	}
+	while( buffer_size > 0 )
+	{
+		block_data_offset = (size_t) ( offset % internal_volume->io_handle->block_size );
+		block_offset      = offset - block_data_offset;
+		block_data_size   = internal_volume->io_handle->block_size;
+
+		/* The last block can be smaller than the block size
+		 */
+		if( (size64_t) block_data_size > ( internal_volume->io_handle->volume_size - block_offset ) )
+		{
+			block_data_size = (size_t) ( internal_volume->io_handle->volume_size - block_offset );
+		}
+		write_size = block_data_size - block_data_offset;
+
+		if( write_size > buffer_size )
+		{
+			write_size = buffer_size;
+		}
+		result = libbde_write_cache_get_block(
+		          internal_volume->write_cache,
+		          block_offset,
+		          &block_data,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve block at offset: %" PRIi64 " from write cache.",
+			 function,
+			 block_offset );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			/* Read the part of the block that is not overwritten
+			 */
+			if( ( block_data_offset != 0 )
+			 || ( write_size < block_data_size ) )
+			{
+				if( internal_volume->sector_cache != NULL )
+				{
+					if( libbde_sector_data_initialize(
+					     &sector_data,
+					     block_data_size,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+						 "%s: unable to create sector data.",
+						 function );
+
+						goto on_error;
+					}
+					result = libbde_sector_cache_get_data(
+					          internal_volume->sector_cache,
+					          block_offset,
+					          0,
+					          sector_data->data,
+					          block_data_size,
+					          error );
+
+					if( result == -1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+						 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+						 "%s: unable to copy sector data at offset: %" PRIi64 " from cache.",
+						 function,
+						 block_offset );
+
+						goto on_error;
+					}
+					else if( result == 0 )
+					{
+						if( libbde_sector_data_free(
+						     &sector_data,
+						     error ) != 1 )
+						{
+							libcerror_error_set(
+							 error,
+							 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+							 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+							 "%s: unable to free sector data.",
+							 function );
+
+							goto on_error;
+						}
+					}
+				}
+				if( sector_data == NULL )
+				{
+					if( libbde_sector_data_read_block(
+					     &sector_data,
+					     internal_volume->io_handle,
+					     file_io_handle,
+					     block_offset,
+					     (size64_t) internal_volume->io_handle->block_size,
+					     encryption_context,
+					     error ) != 1 )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read sector data at offset: %" PRIi64 ".",
+						 function,
+						 block_offset );
+
+						goto on_error;
+					}
+				}
+			}
+			result = libbde_write_cache_is_full(
+			          internal_volume->write_cache,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if write cache is full.",
+				 function );
+
+				goto on_error;
+			}
+			else if( result != 0 )
+			{
+				if( libbde_write_cache_flush(
+				     internal_volume->write_cache,
+				     internal_volume->io_handle,
+				     file_io_handle,
+				     encryption_context,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to flush write cache.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( libbde_write_cache_insert_block(
+			     internal_volume->write_cache,
+			     block_offset,
+			     &block_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to insert block at offset: %" PRIi64 " into write cache.",
+				 function,
+				 block_offset );
+
+				goto on_error;
+			}
+			if( sector_data != NULL )
+			{
+				if( memory_copy(
+				     block_data,
+				     sector_data->data,
+				     block_data_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy sector data to block.",
+					 function );
+
+					goto on_error;
+				}
+				if( libbde_sector_data_free(
+				     &sector_data,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free sector data.",
+					 function );
+
+					goto on_error;
+				}
+			}
+		}
+		if( memory_copy(
+		     &( block_data[ block_data_offset ] ),
+		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		     write_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy buffer to block.",
+			 function );
+
+			goto on_error;
+		}
+		/* Keep the sector cache consistent with the data that is flushed later
+		 */
+		if( internal_volume->sector_cache != NULL )
+		{
+			if( libbde_sector_cache_set_data(
+			     internal_volume->sector_cache,
+			     block_offset,
+			     block_data,
+			     block_data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set sector data at offset: %" PRIi64 " in cache.",
+				 function,
+				 block_offset );
+
+				goto on_error;
+			}
+		}
+		buffer_offset     += write_size;
+		buffer_size       -= write_size;
+		total_write_count += (ssize_t) write_size;
+		offset            += (off64_t) write_size;
+
+		if( internal_volume->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	if( libbde_io_handle_release_encryption_context(
+	     internal_volume->io_handle,
+	     context_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release encryption context.",
+		 function );
+
+		return( -1 );
+	}
+	return( total_write_count );
+
+on_error:
+	if( sector_data != NULL )
+	{
+		libbde_sector_data_free(
+		 &sector_data,
+		 NULL );
+	}
+	if( context_index != -1 )
+	{
+		libbde_io_handle_release_encryption_context(
+		 internal_volume->io_handle,
+		 context_index,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Writes (volume) data at the current offset from a buffer using a Basic File IO (bfio) handle
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libbde_internal_volume_write_buffer_to_file_io_handle(
+         libbde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_write_buffer_to_file_io_handle";
+	ssize_t write_count   = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid volume - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libbde_internal_volume_write_buffer_at_offset_to_file_io_handle(
+	               internal_volume,
+	               file_io_handle,
+	               buffer,
+	               buffer_size,
+	               internal_volume->current_offset,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer at offset: %" PRIi64 ".",
+		 function,
+		 internal_volume->current_offset );
+
+		return( -1 );
+	}
+	internal_volume->current_offset += (off64_t) write_count;
+
+	return( write_count );
+}
+
+/* Writes (volume) data at the current offset
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libbde_volume_write_buffer(
+         libbde_volume_t *volume,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_write_buffer";
+	ssize_t write_count                       = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libbde_internal_volume_write_buffer_to_file_io_handle(
+		       internal_volume,
+		       internal_volume->file_io_handle,
+		       buffer,
+		       buffer_size,
+		       error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		write_count = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Writes (volume) data at a specific offset
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libbde_volume_write_buffer_at_offset(
+         libbde_volume_t *volume,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_write_buffer_at_offset";
+	ssize_t write_count                       = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbde_internal_volume_seek_offset(
+	     internal_volume,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbde_internal_volume_write_buffer_to_file_io_handle(
+		       internal_volume,
+		       internal_volume->file_io_handle,
+		       buffer,
+		       buffer_size,
+		       error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Flushes the write cache
+ * The modified blocks are encrypted and written to the file IO handle
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_internal_volume_flush_write_cache(
+     libbde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libbde_encryption_context_t *encryption_context = NULL;
+	static char *function                           = "libbde_internal_volume_flush_write_cache";
+	int context_index                               = -1;
+	int number_of_entries                           = 0;
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->write_cache == NULL )
+	{
+		return( 1 );
+	}
+	if( libbde_write_cache_get_number_of_entries(
+	     internal_volume->write_cache,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries of write cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries == 0 )
+	{
+		return( 1 );
+	}
+	if( libbde_io_handle_grab_encryption_context(
+	     internal_volume->io_handle,
+	     &context_index,
+	     &encryption_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab encryption context.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_write_cache_flush(
+	     internal_volume->write_cache,
+	     internal_volume->io_handle,
+	     file_io_handle,
+	     encryption_context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush write cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_io_handle_release_encryption_context(
+	     internal_volume->io_handle,
+	     context_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release encryption context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libbde_io_handle_release_encryption_context(
+	 internal_volume->io_handle,
+	 context_index,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Flushes the (volume) data that was written
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_flush(
+     libbde_volume_t *volume,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_flush";
+	int result                                = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( internal_volume->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbde_internal_volume_flush_write_cache(
+	     internal_volume,
+	     internal_volume->file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush write cache.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Seeks a certain offset of the (volume) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libbde_internal_volume_seek_offset(
+         libbde_internal_volume_t *internal_volume,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libbde_internal_volume_seek_offset";
+
+	if( internal_volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->is_locked != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - volume is locked.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{	
+		offset += internal_volume->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{	
+		offset += (off64_t) internal_volume->io_handle->volume_size;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: seeking volume data offset: %" PRIi64 ".\n",
+		 function,
+		 offset );
+	}
+#endif
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libbde_volume_seek_offset(
+         libbde_volume_t *volume,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_seek_offset";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libbde_internal_volume_seek_offset(
+	          internal_volume,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		offset = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (volume) data
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_get_offset(
+     libbde_volume_t *volume,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_get_offset";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_volume->current_offset;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the size
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_get_size(
+     libbde_volume_t *volume,
+     size64_t *size,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_get_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*size = internal_volume->io_handle->volume_size;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the encryption method
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_get_encryption_method(
+     libbde_volume_t *volume,
+     uint16_t *encryption_method,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_get_encryption_method";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( encryption_method == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encryption method.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*encryption_method = internal_volume->encryption_method;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves the volume identifier
+ * The identifier is a GUID and is 16 bytes of size
+ * Returns 1 if successful, 0 if not or or -1 on error
+ */
+int libbde_volume_get_volume_identifier(
+     libbde_volume_t *volume,
+     uint8_t *volume_identifier,
+     size_t size,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	libbde_metadata_t *metadata               = NULL;
+	static char *function                     = "libbde_volume_get_volume_identifier";
+	int result                                = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	metadata = internal_volume->primary_metadata;
+
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->secondary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->tertiary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		result = 0;
+	}
+	else if( libbde_metadata_get_volume_identifier(
+	          metadata,
+	          volume_identifier,
+	          size,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume identifier from primary metadata.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the creation date and time
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_get_creation_time(
+     libbde_volume_t *volume,
+     uint64_t *filetime,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	libbde_metadata_t *metadata               = NULL;
+	static char *function                     = "libbde_volume_get_creation_time";
+	int result                                = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	metadata = internal_volume->primary_metadata;
+
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->secondary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->tertiary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		result = 0;
+	}
+	else if( libbde_metadata_get_creation_time(
+	          metadata,
+	          filetime,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve creation time from primary metadata.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the UTF-8 string size of the volume description
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libbde_volume_get_utf8_description_size(
+     libbde_volume_t *volume,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	libbde_metadata_t *metadata               = NULL;
+	static char *function                     = "libbde_volume_get_utf8_description_size";
+	int result                                = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	metadata = internal_volume->primary_metadata;
+
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->secondary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->tertiary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		result = 0;
+	}
+	else if( libbde_metadata_get_utf8_description_size(
+	          metadata,
+	          utf8_string_size,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 description size from primary metadata.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the UTF-8 string value of the volume description
+ * The function uses a codepage if necessary, it uses the codepage set for the library
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libbde_volume_get_utf8_description(
+     libbde_volume_t *volume,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	libbde_metadata_t *metadata               = NULL;
+	static char *function                     = "libbde_volume_get_utf8_description";
+	int result                                = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	metadata = internal_volume->primary_metadata;
+
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->secondary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->tertiary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		result = 0;
+	}
+	else if( libbde_metadata_get_utf8_description(
+	          metadata,
+	          utf8_string,
+	          utf8_string_size,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 description from primary metadata.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the UTF-16 string size of the volume description
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libbde_volume_get_utf16_description_size(
+     libbde_volume_t *volume,
+     size_t *utf16_string_size,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	libbde_metadata_t *metadata               = NULL;
+	static char *function                     = "libbde_volume_get_utf16_description_size";
+	int result                                = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	metadata = internal_volume->primary_metadata;
+
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->secondary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->tertiary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		result = 0;
+	}
+	else if( libbde_metadata_get_utf16_description_size(
+	          metadata,
+	          utf16_string_size,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 description size from primary metadata.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the UTF-16 string value of the volume description
+ * The function uses a codepage if necessary, it uses the codepage set for the library
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if not or -1 on error
+ */
+int libbde_volume_get_utf16_description(
+     libbde_volume_t *volume,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	libbde_metadata_t *metadata               = NULL;
+	static char *function                     = "libbde_volume_get_utf16_description";
+	int result                                = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	metadata = internal_volume->primary_metadata;
+
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->secondary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->tertiary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		result = 0;
+	}
+	else if( libbde_metadata_get_utf16_description(
+	          metadata,
+	          utf16_string,
+	          utf16_string_size,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 description from primary metadata.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of volume master key protectors
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_get_number_of_key_protectors(
+     libbde_volume_t *volume,
+     int *number_of_key_protectors,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	libbde_metadata_t *metadata               = NULL;
+	static char *function                     = "libbde_volume_get_number_of_key_protectors";
+	int result                                = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	metadata = internal_volume->primary_metadata;
+
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->secondary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->tertiary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		result = 0;
+	}
+	else if( libbde_metadata_get_number_of_volume_master_keys(
+	          metadata,
+	          number_of_key_protectors,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of volume master key from primary metadata.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific volume master key protector
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_get_key_protector(
+     libbde_volume_t *volume,
+     int key_protector_index,
+     libbde_key_protector_t **key_protector,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume     = NULL;
+	libbde_metadata_t *metadata                   = NULL;
+	libbde_volume_master_key_t *volume_master_key = NULL;
+	static char *function                         = "libbde_volume_get_key_protector";
+	int result                                    = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	metadata = internal_volume->primary_metadata;
+
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->secondary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		metadata = internal_volume->tertiary_metadata;
+	}
+	if( metadata == NULL )
+	{
+		result = 0;
+	}
+	else if( libbde_metadata_get_volume_master_key_by_index(
+	          metadata,
+	          key_protector_index,
+	          &volume_master_key,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve volume master key: %d from primary metadata.",
+		 function,
+		 key_protector_index );
+
+		result = -1;
+	}
+	if( result == 1 )
+	{
+		if( libbde_key_protector_initialize(
+		     key_protector,
+		     volume_master_key,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create key protector.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the number of regions
+ * The regions describe the layout of the volume, such as the parts that are
+ * encrypted, unencrypted or represent the BitLocker metadata
+ * The layout of the volume is known once the volume is unlocked, before that there are no regions
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_get_number_of_regions(
+     libbde_volume_t *volume,
+     int *number_of_regions,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_get_number_of_regions";
+	int result                                = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbde_region_table_get_number_of_regions(
+	     &( internal_volume->io_handle->region_table ),
+	     number_of_regions,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of regions.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific region
+ * The regions are sorted by offset and together cover the entire volume
+ * The flags are a combination of LIBBDE_REGION_FLAGS
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_get_region_by_index(
+     libbde_volume_t *volume,
+     int region_index,
+     off64_t *offset,
+     size64_t *size,
+     uint32_t *flags,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	libbde_region_t *region                   = NULL;
+	static char *function                     = "libbde_volume_get_region_by_index";
+	int result                                = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid size.",
+		 function );
+
+		return( -1 );
+	}
+	if( flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid flags.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libbde_region_table_get_region_by_index(
+	     &( internal_volume->io_handle->region_table ),
+	     region_index,
+	     &region,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve region: %d.",
+		 function,
+		 region_index );
+
+		result = -1;
+	}
+	else if( libbde_region_get_flags(
+	          region,
+	          flags,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve region: %d flags.",
+		 function,
+		 region_index );
+
+		result = -1;
+	}
+	else
+	{
+		*offset = region->offset;
+		*size   = region->size;
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the block size
+ * The block size is the number of bytes that is read and decrypted as a single unit
+ * and must be a multiple of the number of bytes per sector
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_set_block_size(
+     libbde_volume_t *volume,
+     size_t block_size,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_set_block_size";
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size < 512 )
+	 || ( block_size > (size_t) LIBBDE_MAXIMUM_BLOCK_SIZE )
+	 || ( ( block_size % 512 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported block size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->io_handle->block_size = block_size;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the (maximum) size of the sector cache
+ * A cache size of 0 disables the sector cache
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_set_cache_size(
+     libbde_volume_t *volume,
+     size64_t cache_size,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_set_cache_size";
+	int result                                = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( cache_size > (size64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid cache size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		goto on_error;
+		return( -1 );
+	}
+#endif
+	internal_volume->cache_size = cache_size;
+
+	/* Resize the sector cache of an open volume by recreating it,
+	 * the read-ahead stores blocks in the sector cache and is recreated as well
+	 */
+	if( internal_volume->read_ahead != NULL )
+	{
+		if( libbde_read_ahead_free(
+		     &( internal_volume->read_ahead ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( internal_volume->sector_cache != NULL ) )
+	{
+		if( libbde_sector_cache_free(
+		     &( internal_volume->sector_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free sector cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( internal_volume->file_io_handle != NULL )
+	 && ( cache_size > 0 ) )
+	{
+		if( libbde_sector_cache_initialize(
+		     &( internal_volume->sector_cache ),
+		     internal_volume->io_handle->block_size,
+		     cache_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create sector cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( internal_volume->file_io_handle != NULL ) )
+	{
+		if( libbde_internal_volume_initialize_read_ahead(
+		     internal_volume,
+		     internal_volume->file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize read-ahead.",
+			 function );
+
+			result = -1;
+		}
 	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -2294,94 +5723,246 @@ ssize_t libbde_volume_read_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( result );
+}
 
-on_error:
+/* Sets the read-ahead depth
+ * The read-ahead depth is the number of blocks that are read and decrypted ahead
+ * of sequential or strided reads by worker threads, 0 disables read-ahead
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_set_read_ahead_depth(
+     libbde_volume_t *volume,
+     int read_ahead_depth,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_set_read_ahead_depth";
+	int result                                = 1;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( ( read_ahead_depth < 0 )
+	 || ( read_ahead_depth > LIBBDE_MAXIMUM_READ_AHEAD_DEPTH ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid read-ahead depth value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
 #endif
-	return( -1 );
-}
+	internal_volume->read_ahead_depth = read_ahead_depth;
 
-#ifdef TODO_WRITE_SUPPORT
+	if( internal_volume->read_ahead != NULL )
+	{
+		if( libbde_read_ahead_free(
+		     &( internal_volume->read_ahead ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read-ahead.",
+			 function );
 
-/* Writes (volume) data at the current offset
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
- */
-ssize_t libbde_volume_write_buffer(
-         libbde_volume_t *volume,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-	return( -1 );
+			result = -1;
+		}
+	}
+	if( ( result == 1 )
+	 && ( internal_volume->file_io_handle != NULL ) )
+	{
+		if( libbde_internal_volume_initialize_read_ahead(
+		     internal_volume,
+		     internal_volume->file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize read-ahead.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
 }
 
-/* Writes (volume) data at a specific offset,
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+/* Sets the number of decryption threads
+ * Large sector aligned reads are split into chunks that are read and decrypted
+ * concurrently by the decryption threads, 0 disables the decryption threads
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libbde_volume_write_buffer_at_offset(
-         libbde_volume_t *volume,
-         const void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libbde_volume_set_number_of_decryption_threads(
+     libbde_volume_t *volume,
+     int number_of_threads,
+     libcerror_error_t **error )
 {
-	static char *function = "libbde_volume_write_buffer_at_offset";
-	ssize_t write_count   = 0;
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_set_number_of_decryption_threads";
+	int result                                = 1;
 
-	if( libbde_volume_seek_offset(
-	     volume,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
 		 function );
 
 		return( -1 );
 	}
-	write_count = libbde_volume_write_buffer(
-	               volume,
-	               buffer,
-	               buffer_size,
-	               error );
+	internal_volume = (libbde_internal_volume_t *) volume;
 
-	if( write_count < 0 )
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBBDE_MAXIMUM_NUMBER_OF_DECRYPTION_THREADS ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_WRITE_FAILED,
-		 "%s: unable to write buffer.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	return( write_count );
-}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_volume->number_of_decryption_threads = number_of_threads;
 
-#endif /* TODO_WRITE_SUPPORT */
+	if( internal_volume->read_pool != NULL )
+	{
+		if( libbde_read_pool_free(
+		     &( internal_volume->read_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read pool.",
+			 function );
 
-/* Seeks a certain offset of the (volume) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( ( result == 1 )
+	 && ( number_of_threads > 0 )
+	 && ( internal_volume->file_io_handle != NULL )
+	 && ( internal_volume->write_cache == NULL )
+	 && ( internal_volume->is_locked == 0 ) )
+	{
+		if( libbde_read_pool_initialize(
+		     &( internal_volume->read_pool ),
+		     internal_volume->io_handle,
+		     internal_volume->file_io_handle,
+		     number_of_threads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create read pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the keys
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful or -1 on error
  */
-off64_t libbde_internal_volume_seek_offset(
-         libbde_internal_volume_t *internal_volume,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libbde_volume_set_keys(
+     libbde_volume_t *volume,
+     const uint8_t *full_volume_encryption_key,
+     size_t full_volume_encryption_key_size,
+     const uint8_t *tweak_key,
+     size_t tweak_key_size,
+     libcerror_error_t **error )
 {
-	static char *function = "libbde_internal_volume_seek_offset";
+	libbde_internal_volume_t *internal_volume = NULL;
+	static char *function                     = "libbde_volume_set_keys";
 
-	if( internal_volume == NULL )
+	if( volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2392,106 +5973,85 @@ off64_t libbde_internal_volume_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_volume->is_locked != 0 )
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - volume is locked.",
+		 "%s: invalid volume - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->io_handle == NULL )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+	if( full_volume_encryption_key == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid full volume encryption key.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{	
-		offset += internal_volume->current_offset;
-	}
-	else if( whence == SEEK_END )
-	{	
-		offset += (off64_t) internal_volume->io_handle->volume_size;
-	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "%s: seeking volume data offset: %" PRIi64 ".\n",
-		 function,
-		 offset );
-	}
-#endif
-	if( offset < 0 )
+	if( ( full_volume_encryption_key_size != 16 )
+	 && ( full_volume_encryption_key_size != 32 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported full volume encryption key size.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume->current_offset = offset;
-
-	return( offset );
-}
-
-/* Seeks a certain offset of the data
- * Returns the offset if seek is successful or -1 on error
- */
-off64_t libbde_volume_seek_offset(
-         libbde_volume_t *volume,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
-{
-	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_seek_offset";
-
-	if( volume == NULL )
+	if( tweak_key == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid tweak key.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libbde_internal_volume_t *) volume;
+	if( ( tweak_key_size != 0 )
+	 && ( tweak_key_size != 16 )
+	 && ( tweak_key_size != 32 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported tweak key size.",
+		 function );
 
-	if( internal_volume->io_handle == NULL )
+		return( -1 );
+	}
+	if( ( tweak_key_size != 0 )
+	 && ( tweak_key_size != full_volume_encryption_key_size ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: mismatch in full volume encryption key and tweak key size.",
 		 function );
 
 		return( -1 );
@@ -2511,23 +6071,77 @@ off64_t libbde_volume_seek_offset(
 		return( -1 );
 	}
 #endif
-	offset = libbde_internal_volume_seek_offset(
-	          internal_volume,
-	          offset,
-	          whence,
-	          error );
+	if( full_volume_encryption_key_size < 32 )
+	{
+		if( memory_set(
+		     internal_volume->io_handle->full_volume_encryption_key,
+		     0,
+		     32  ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear full volume encryption key.",
+			 function );
 
-	if( offset == -1 )
+			goto on_error;
+		}
+	}
+	if( memory_copy(
+	     internal_volume->io_handle->full_volume_encryption_key,
+	     full_volume_encryption_key,
+	     full_volume_encryption_key_size ) == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy full volume encryption key.",
 		 function );
 
-		offset = -1;
+		goto on_error;
+	}
+	internal_volume->io_handle->full_volume_encryption_key_size = full_volume_encryption_key_size;
+
+	if( tweak_key_size < 32 )
+	{
+		if( memory_set(
+		     internal_volume->io_handle->tweak_key,
+		     0,
+		     32  ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear tweak key.",
+			 function );
+
+			goto on_error;
+		}
 	}
+	if( tweak_key_size != 0 )
+	{
+		if( memory_copy(
+		     internal_volume->io_handle->tweak_key,
+		     tweak_key,
+		     tweak_key_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy tweak key.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	internal_volume->io_handle->tweak_key_size = tweak_key_size;
+
+	internal_volume->io_handle->keys_are_set = 1;
+
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
@@ -2543,19 +6157,39 @@ off64_t libbde_volume_seek_offset(
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( 1 );
+
+on_error:
+	memory_set(
+	 internal_volume->io_handle->tweak_key,
+	 0,
+	 32 );
+
+	memory_set(
+	 internal_volume->io_handle->full_volume_encryption_key,
+	 0,
+	 32 );
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the current offset of the (volume) data
- * Returns 1 if successful or -1 on error
+/* Sets an UTF-8 formatted password
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful, 0 if password is invalid or -1 on error
  */
-int libbde_volume_get_offset(
+int libbde_volume_set_utf8_password(
      libbde_volume_t *volume,
-     off64_t *offset,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
      libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_get_offset";
+	static char *function                     = "libbde_volume_set_utf8_password";
 
 	if( volume == NULL )
 	{
@@ -2570,30 +6204,30 @@ int libbde_volume_get_offset(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
+	if( internal_volume->password_keep == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 "%s: invalid volume - missing password keep.",
 		 function );
 
 		return( -1 );
 	}
-	if( offset == NULL )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2601,16 +6235,33 @@ int libbde_volume_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	*offset = internal_volume->current_offset;
+	if( libbde_utf8_password_calculate_hash(
+	     utf8_string,
+	     utf8_string_length,
+	     internal_volume->password_keep->password_hash,
+	     32,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set password hash.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->password_keep->password_is_set = 1;
+	internal_volume->password_keep->password_key_is_set = 0;
 
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2618,25 +6269,35 @@ int libbde_volume_get_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the size
- * Returns 1 if successful or -1 on error
+/* Sets an UTF-16 formatted password
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful, 0 if password is invalid or -1 on error
  */
-int libbde_volume_get_size(
+int libbde_volume_set_utf16_password(
      libbde_volume_t *volume,
-     size64_t *size,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
      libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_get_size";
+	static char *function                     = "libbde_volume_set_utf16_password";
 
 	if( volume == NULL )
 	{
@@ -2651,30 +6312,30 @@ int libbde_volume_get_size(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
+	if( internal_volume->password_keep == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 "%s: invalid volume - missing password keep.",
 		 function );
 
 		return( -1 );
 	}
-	if( size == NULL )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid size.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2682,16 +6343,33 @@ int libbde_volume_get_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	*size = internal_volume->io_handle->volume_size;
+	if( libbde_utf16_password_calculate_hash(
+	     utf16_string,
+	     utf16_string_length,
+	     internal_volume->password_keep->password_hash,
+	     32,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set password hash.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->password_keep->password_is_set = 1;
+	internal_volume->password_keep->password_key_is_set = 0;
 
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2699,25 +6377,35 @@ int libbde_volume_get_size(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the encryption method
- * Returns 1 if successful or -1 on error
+/* Sets an UTF-8 formatted recovery password
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful, 0 if recovery password is invalid or -1 on error
  */
-int libbde_volume_get_encryption_method(
+int libbde_volume_set_utf8_recovery_password(
      libbde_volume_t *volume,
-     uint16_t *encryption_method,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
      libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_get_encryption_method";
+	static char *function                     = "libbde_volume_set_utf8_recovery_password";
 
 	if( volume == NULL )
 	{
@@ -2732,19 +6420,30 @@ int libbde_volume_get_encryption_method(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-	if( encryption_method == NULL )
+	if( internal_volume->password_keep == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid encryption method.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing password keep.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2752,16 +6451,33 @@ int libbde_volume_get_encryption_method(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	*encryption_method = internal_volume->encryption_method;
+	if( libbde_utf8_recovery_password_calculate_hash(
+	     utf8_string,
+	     utf8_string_length,
+	     internal_volume->password_keep->recovery_password_hash,
+	     32,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set recovery password hash.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume->password_keep->recovery_password_is_set = 1;
+	internal_volume->password_keep->recovery_password_key_is_set = 0;
 
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2769,29 +6485,35 @@ int libbde_volume_get_encryption_method(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the volume identifier
- * The identifier is a GUID and is 16 bytes of size
- * Returns 1 if successful, 0 if not or or -1 on error
+/* Sets an UTF-16 formatted recovery password
+ * This function needs to be used before one of the open functions
+ * Returns 1 if successful, 0 if recovery password is invalid or -1 on error
  */
-int libbde_volume_get_volume_identifier(
+int libbde_volume_set_utf16_recovery_password(
      libbde_volume_t *volume,
-     uint8_t *volume_identifier,
-     size_t size,
+     const uint16_t *utf16_string,
+     size_t utf16_string_length,
      libcerror_error_t **error )
 {
 	libbde_internal_volume_t *internal_volume = NULL;
-	libbde_metadata_t *metadata               = NULL;
-	static char *function                     = "libbde_volume_get_volume_identifier";
-	int result                                = 1;
+	static char *function                     = "libbde_volume_set_utf16_recovery_password";
 
 	if( volume == NULL )
 	{
@@ -2806,52 +6528,30 @@ int libbde_volume_get_volume_identifier(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->password_keep == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing password keep.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	metadata = internal_volume->primary_metadata;
-
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->secondary_metadata;
-	}
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->tertiary_metadata;
-	}
-	if( metadata == NULL )
-	{
-		result = 0;
-	}
-	else if( libbde_metadata_get_volume_identifier(
-	          metadata,
-	          volume_identifier,
-	          size,
-	          error ) != 1 )
+	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve volume identifier from primary metadata.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2859,86 +6559,33 @@ int libbde_volume_get_volume_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( result );
-}
-
-/* Retrieves the creation date and time
- * Returns 1 if successful or -1 on error
- */
-int libbde_volume_get_creation_time(
-     libbde_volume_t *volume,
-     uint64_t *filetime,
-     libcerror_error_t **error )
-{
-	libbde_internal_volume_t *internal_volume = NULL;
-	libbde_metadata_t *metadata               = NULL;
-	static char *function                     = "libbde_volume_get_creation_time";
-	int result                                = 1;
-
-	if( volume == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
-		 function );
-
-		return( -1 );
-	}
-	internal_volume = (libbde_internal_volume_t *) volume;
-
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
+	if( libbde_utf16_recovery_password_calculate_hash(
+	     utf16_string,
+	     utf16_string_length,
+	     internal_volume->password_keep->recovery_password_hash,
+	     32,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to set recovery password hash.",
 		 function );
 
-		return( -1 );
-	}
-#endif
-	metadata = internal_volume->primary_metadata;
-
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->secondary_metadata;
-	}
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->tertiary_metadata;
-	}
-	if( metadata == NULL )
-	{
-		result = 0;
+		goto on_error;
 	}
-	else if( libbde_metadata_get_creation_time(
-	          metadata,
-	          filetime,
-	          error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve creation time from primary metadata.",
-		 function );
+	internal_volume->password_keep->recovery_password_is_set = 1;
+	internal_volume->password_keep->recovery_password_key_is_set = 0;
 
-		result = -1;
-	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -2946,30 +6593,40 @@ int libbde_volume_get_creation_time(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( result );
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_volume->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the UTF-8 string size of the volume description
- * The returned size includes the end of string character
- * Returns 1 if successful, 0 if not or -1 on error
+/* Tests a batch of password hashes against the password or recovery password volume master key
+ * This function is not multi-thread safe acquire read lock before call
+ * Returns 1 if a password decrypts the volume master key, 0 if not or -1 on error
  */
-int libbde_volume_get_utf8_description_size(
-     libbde_volume_t *volume,
-     size_t *utf8_string_size,
+int libbde_internal_volume_test_password_batch(
+     libbde_internal_volume_t *internal_volume,
+     libbde_password_batch_t *password_batch,
+     uint16_t key_protection_type,
+     int *password_index,
      libcerror_error_t **error )
 {
-	libbde_internal_volume_t *internal_volume = NULL;
-	libbde_metadata_t *metadata               = NULL;
-	static char *function                     = "libbde_volume_get_utf8_description_size";
-	int result                                = 1;
+	libbde_metadata_t *metadata                  = NULL;
+	libbde_volume_master_key_t *volume_master_key = NULL;
+	static char *function                        = "libbde_internal_volume_test_password_batch";
+	int result                                   = 0;
 
-	if( volume == NULL )
+	if( internal_volume == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2980,84 +6637,94 @@ int libbde_volume_get_utf8_description_size(
 
 		return( -1 );
 	}
-	internal_volume = (libbde_internal_volume_t *) volume;
-
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->primary_metadata != NULL )
+	{
+		metadata = internal_volume->primary_metadata;
+	}
+	else if( internal_volume->secondary_metadata != NULL )
+	{
+		metadata = internal_volume->secondary_metadata;
+	}
+	else if( internal_volume->tertiary_metadata != NULL )
+	{
+		metadata = internal_volume->tertiary_metadata;
+	}
+	if( metadata == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing metadata.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	metadata = internal_volume->primary_metadata;
-
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->secondary_metadata;
-	}
-	if( metadata == NULL )
+	if( key_protection_type == LIBBDE_KEY_PROTECTION_TYPE_PASSWORD )
 	{
-		metadata = internal_volume->tertiary_metadata;
+		volume_master_key = metadata->password_volume_master_key;
 	}
-	if( metadata == NULL )
+	else if( key_protection_type == LIBBDE_KEY_PROTECTION_TYPE_RECOVERY_PASSWORD )
 	{
-		result = 0;
+		volume_master_key = metadata->recovery_password_volume_master_key;
 	}
-	else if( libbde_metadata_get_utf8_description_size(
-	          metadata,
-	          utf8_string_size,
-	          error ) != 1 )
+	else
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-8 description size from primary metadata.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported key protection type: 0x%04" PRIx16 ".",
+		 function,
+		 key_protection_type );
 
-		result = -1;
+		return( -1 );
 	}
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( volume_master_key == NULL )
+	{
+		return( 0 );
+	}
+	result = libbde_password_batch_test(
+	          password_batch,
+	          volume_master_key,
+	          internal_volume->number_of_decryption_threads,
+	          password_index,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to test password batch.",
 		 function );
 
 		return( -1 );
 	}
-#endif
 	return( result );
 }
 
-/* Retrieves the UTF-8 string value of the volume description
- * The function uses a codepage if necessary, it uses the codepage set for the library
- * The size should include the end of string character
- * Returns 1 if successful, 0 if not or -1 on error
+/* Tests UTF-8 formatted passwords against the password protected volume master key
+ * The volume needs to be opened, the volume is not unlocked by this function
+ * The passwords are stretched concurrently in SIMD lanes and by the decryption threads
+ * Returns 1 if a password decrypts the volume master key, 0 if not or -1 on error
  */
-int libbde_volume_get_utf8_description(
+int libbde_volume_test_utf8_passwords(
      libbde_volume_t *volume,
-     uint8_t *utf8_string,
-     size_t utf8_string_size,
+     const uint8_t **utf8_strings,
+     const size_t *utf8_string_lengths,
+     int number_of_strings,
+     int *password_index,
      libcerror_error_t **error )
 {
+	uint8_t password_hash[ 32 ];
+
 	libbde_internal_volume_t *internal_volume = NULL;
-	libbde_metadata_t *metadata               = NULL;
-	static char *function                     = "libbde_volume_get_utf8_description";
-	int result                                = 1;
+	libbde_password_batch_t *password_batch   = NULL;
+	static char *function                     = "libbde_volume_test_utf8_passwords";
+	int result                                = 0;
+	int string_index                          = 0;
 
 	if( volume == NULL )
 	{
@@ -3072,94 +6739,118 @@ int libbde_volume_get_utf8_description(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	metadata = internal_volume->primary_metadata;
-
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->secondary_metadata;
-	}
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->tertiary_metadata;
-	}
-	if( metadata == NULL )
+	if( utf8_strings == NULL )
 	{
-		result = 0;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 strings.",
+		 function );
+
+		return( -1 );
 	}
-	else if( libbde_metadata_get_utf8_description(
-	          metadata,
-	          utf8_string,
-	          utf8_string_size,
-	          error ) != 1 )
+	if( utf8_string_lengths == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-8 description from primary metadata.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string lengths.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( number_of_strings <= 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of strings value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
-}
-
-/* Retrieves the UTF-16 string size of the volume description
- * The returned size includes the end of string character
- * Returns 1 if successful, 0 if not or -1 on error
- */
-int libbde_volume_get_utf16_description_size(
-     libbde_volume_t *volume,
-     size_t *utf16_string_size,
-     libcerror_error_t **error )
-{
-	libbde_internal_volume_t *internal_volume = NULL;
-	libbde_metadata_t *metadata               = NULL;
-	static char *function                     = "libbde_volume_get_utf16_description_size";
-	int result                                = 1;
-
-	if( volume == NULL )
+	if( password_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid password index.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libbde_internal_volume_t *) volume;
+	if( libbde_password_batch_initialize(
+	     &password_batch,
+	     number_of_strings,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create password batch.",
+		 function );
+
+		goto on_error;
+	}
+	for( string_index = 0;
+	     string_index < number_of_strings;
+	     string_index++ )
+	{
+		if( libbde_utf8_password_calculate_hash(
+		     utf8_strings[ string_index ],
+		     utf8_string_lengths[ string_index ],
+		     password_hash,
+		     32,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate password: %d hash.",
+			 function,
+			 string_index );
+
+			goto on_error;
+		}
+		if( libbde_password_batch_append_password_hash(
+		     password_batch,
+		     string_index,
+		     password_hash,
+		     32,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append password hash: %d to batch.",
+			 function,
+			 string_index );
+
+			goto on_error;
+		}
+	}
+	memory_set(
+	 password_hash,
+	 0,
+	 32 );
 
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
@@ -3173,36 +6864,24 @@ int libbde_volume_get_utf16_description_size(
 		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	metadata = internal_volume->primary_metadata;
+	result = libbde_internal_volume_test_password_batch(
+	          internal_volume,
+	          password_batch,
+	          LIBBDE_KEY_PROTECTION_TYPE_PASSWORD,
+	          password_index,
+	          error );
 
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->secondary_metadata;
-	}
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->tertiary_metadata;
-	}
-	if( metadata == NULL )
-	{
-		result = 0;
-	}
-	else if( libbde_metadata_get_utf16_description_size(
-	          metadata,
-	          utf16_string_size,
-	          error ) != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-16 description size from primary metadata.",
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to test passwords.",
 		 function );
-
-		result = -1;
 	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -3216,27 +6895,63 @@ int libbde_volume_get_utf16_description_size(
 		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	if( libbde_password_batch_free(
+	     &password_batch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free password batch.",
+		 function );
+
+		goto on_error;
+	}
 	return( result );
-}
 
-/* Retrieves the UTF-16 string value of the volume description
- * The function uses a codepage if necessary, it uses the codepage set for the library
- * The size should include the end of string character
- * Returns 1 if successful, 0 if not or -1 on error
+on_error:
+	memory_set(
+	 password_hash,
+	 0,
+	 32 );
+
+	if( password_batch != NULL )
+	{
+		libbde_password_batch_free(
+		 &password_batch,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests UTF-16 formatted passwords against the password protected volume master key
+ * The volume needs to be opened, the volume is not unlocked by this function
+ * The passwords are stretched concurrently in SIMD lanes and by the decryption threads
+ * Returns 1 if a password decrypts the volume master key, 0 if not or -1 on error
  */
-int libbde_volume_get_utf16_description(
+int libbde_volume_test_utf16_passwords(
      libbde_volume_t *volume,
-     uint16_t *utf16_string,
-     size_t utf16_string_size,
+     const uint16_t **utf16_strings,
+     const size_t *utf16_string_lengths,
+     int number_of_strings,
+     int *password_index,
      libcerror_error_t **error )
 {
+	uint8_t password_hash[ 32 ];
+
 	libbde_internal_volume_t *internal_volume = NULL;
-	libbde_metadata_t *metadata               = NULL;
-	static char *function                     = "libbde_volume_get_utf16_description";
-	int result                                = 1;
+	libbde_password_batch_t *password_batch   = NULL;
+	static char *function                     = "libbde_volume_test_utf16_passwords";
+	int result                                = 0;
+	int string_index                          = 0;
 
 	if( volume == NULL )
 	{
@@ -3251,93 +6966,118 @@ int libbde_volume_get_utf16_description(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	metadata = internal_volume->primary_metadata;
-
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->secondary_metadata;
-	}
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->tertiary_metadata;
-	}
-	if( metadata == NULL )
+	if( utf16_strings == NULL )
 	{
-		result = 0;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 strings.",
+		 function );
+
+		return( -1 );
 	}
-	else if( libbde_metadata_get_utf16_description(
-	          metadata,
-	          utf16_string,
-	          utf16_string_size,
-	          error ) != 1 )
+	if( utf16_string_lengths == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-16 description from primary metadata.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 string lengths.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( number_of_strings <= 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of strings value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
-}
-
-/* Retrieves the number of volume master key protectors
- * Returns 1 if successful or -1 on error
- */
-int libbde_volume_get_number_of_key_protectors(
-     libbde_volume_t *volume,
-     int *number_of_key_protectors,
-     libcerror_error_t **error )
-{
-	libbde_internal_volume_t *internal_volume = NULL;
-	libbde_metadata_t *metadata               = NULL;
-	static char *function                     = "libbde_volume_get_number_of_key_protectors";
-	int result                                = 1;
-
-	if( volume == NULL )
+	if( password_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid password index.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libbde_internal_volume_t *) volume;
+	if( libbde_password_batch_initialize(
+	     &password_batch,
+	     number_of_strings,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create password batch.",
+		 function );
+
+		goto on_error;
+	}
+	for( string_index = 0;
+	     string_index < number_of_strings;
+	     string_index++ )
+	{
+		if( libbde_utf16_password_calculate_hash(
+		     utf16_strings[ string_index ],
+		     utf16_string_lengths[ string_index ],
+		     password_hash,
+		     32,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to calculate password: %d hash.",
+			 function,
+			 string_index );
+
+			goto on_error;
+		}
+		if( libbde_password_batch_append_password_hash(
+		     password_batch,
+		     string_index,
+		     password_hash,
+		     32,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append password hash: %d to batch.",
+			 function,
+			 string_index );
+
+			goto on_error;
+		}
+	}
+	memory_set(
+	 password_hash,
+	 0,
+	 32 );
 
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
@@ -3351,36 +7091,24 @@ int libbde_volume_get_number_of_key_protectors(
 		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	metadata = internal_volume->primary_metadata;
+	result = libbde_internal_volume_test_password_batch(
+	          internal_volume,
+	          password_batch,
+	          LIBBDE_KEY_PROTECTION_TYPE_PASSWORD,
+	          password_index,
+	          error );
 
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->secondary_metadata;
-	}
-	if( metadata == NULL )
-	{
-		metadata = internal_volume->tertiary_metadata;
-	}
-	if( metadata == NULL )
-	{
-		result = 0;
-	}
-	else if( libbde_metadata_get_number_of_volume_master_keys(
-	          metadata,
-	          number_of_key_protectors,
-	          error ) != 1 )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of volume master key from primary metadata.",
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to test passwords.",
 		 function );
-
-		result = -1;
 	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -3394,26 +7122,64 @@ int libbde_volume_get_number_of_key_protectors(
 		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	if( libbde_password_batch_free(
+	     &password_batch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free password batch.",
+		 function );
+
+		goto on_error;
+	}
 	return( result );
+
+on_error:
+	memory_set(
+	 password_hash,
+	 0,
+	 32 );
+
+	if( password_batch != NULL )
+	{
+		libbde_password_batch_free(
+		 &password_batch,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Retrieves a specific volume master key protector
- * Returns 1 if successful or -1 on error
+/* Tests UTF-8 formatted recovery passwords against the recovery password protected volume master key
+ * The volume needs to be opened, the volume is not unlocked by this function
+ * The recovery passwords are stretched concurrently in SIMD lanes and by the decryption threads
+ * Recovery passwords that are not validly formatted are skipped
+ * Returns 1 if a recovery password decrypts the volume master key, 0 if not or -1 on error
  */
-int libbde_volume_get_key_protector(
+int libbde_volume_test_utf8_recovery_passwords(
      libbde_volume_t *volume,
-     int key_protector_index,
-     libbde_key_protector_t **key_protector,
+     const uint8_t **utf8_strings,
+     const size_t *utf8_string_lengths,
+     int number_of_strings,
+     int *recovery_password_index,
      libcerror_error_t **error )
 {
-	libbde_internal_volume_t *internal_volume     = NULL;
-	libbde_metadata_t *metadata                   = NULL;
-	libbde_volume_master_key_t *volume_master_key = NULL;
-	static char *function                         = "libbde_volume_get_key_protector";
-	int result                                    = 1;
+	uint8_t password_hash[ 32 ];
+
+	libbde_internal_volume_t *internal_volume = NULL;
+	libbde_password_batch_t *password_batch   = NULL;
+	static char *function                     = "libbde_volume_test_utf8_recovery_passwords";
+	int result                                = 0;
+	int string_index                          = 0;
 
 	if( volume == NULL )
 	{
@@ -3428,68 +7194,158 @@ int libbde_volume_get_key_protector(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( internal_volume->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	metadata = internal_volume->primary_metadata;
+	if( utf8_strings == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 strings.",
+		 function );
 
-	if( metadata == NULL )
+		return( -1 );
+	}
+	if( utf8_string_lengths == NULL )
 	{
-		metadata = internal_volume->secondary_metadata;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string lengths.",
+		 function );
+
+		return( -1 );
 	}
-	if( metadata == NULL )
+	if( number_of_strings <= 0 )
 	{
-		metadata = internal_volume->tertiary_metadata;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of strings value out of bounds.",
+		 function );
+
+		return( -1 );
 	}
-	if( metadata == NULL )
+	if( recovery_password_index == NULL )
 	{
-		result = 0;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid recovery password index.",
+		 function );
+
+		return( -1 );
 	}
-	else if( libbde_metadata_get_volume_master_key_by_index(
-	          metadata,
-	          key_protector_index,
-	          &volume_master_key,
-	          error ) != 1 )
+	if( libbde_password_batch_initialize(
+	     &password_batch,
+	     number_of_strings,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve volume master key: %d from primary metadata.",
-		 function,
-		 key_protector_index );
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create password batch.",
+		 function );
 
-		result = -1;
+		goto on_error;
 	}
-	if( result == 1 )
+	for( string_index = 0;
+	     string_index < number_of_strings;
+	     string_index++ )
 	{
-		if( libbde_key_protector_initialize(
-		     key_protector,
-		     volume_master_key,
+		result = libbde_utf8_recovery_password_calculate_hash(
+		          utf8_strings[ string_index ],
+		          utf8_string_lengths[ string_index ],
+		          password_hash,
+		          32,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate recovery password hash: %d.",
+			 function,
+			 string_index );
+
+			goto on_error;
+		}
+		/* Recovery passwords that are not valid are skipped
+		 */
+		else if( result == 0 )
+		{
+			continue;
+		}
+		if( libbde_password_batch_append_password_hash(
+		     password_batch,
+		     string_index,
+		     password_hash,
+		     32,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create key protector.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append recovery password hash: %d to batch.",
+			 function,
+			 string_index );
 
-			result = -1;
+			goto on_error;
 		}
 	}
+	memory_set(
+	 password_hash,
+	 0,
+	 32 );
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	result = libbde_internal_volume_test_password_batch(
+	          internal_volume,
+	          password_batch,
+	          LIBBDE_KEY_PROTECTION_TYPE_RECOVERY_PASSWORD,
+	          recovery_password_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to test recovery passwords.",
+		 function );
+	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_volume->read_write_lock,
@@ -3502,26 +7358,64 @@ int libbde_volume_get_key_protector(
 		 "%s: unable to release read/write lock for reading.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
+	if( result == -1 )
+	{
+		goto on_error;
+	}
+	if( libbde_password_batch_free(
+	     &password_batch,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free password batch.",
+		 function );
+
+		goto on_error;
+	}
 	return( result );
+
+on_error:
+	memory_set(
+	 password_hash,
+	 0,
+	 32 );
+
+	if( password_batch != NULL )
+	{
+		libbde_password_batch_free(
+		 &password_batch,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Sets the keys
- * This function needs to be used before one of the open functions
- * Returns 1 if successful or -1 on error
+/* Tests UTF-16 formatted recovery passwords against the recovery password protected volume master key
+ * The volume needs to be opened, the volume is not unlocked by this function
+ * The recovery passwords are stretched concurrently in SIMD lanes and by the decryption threads
+ * Recovery passwords that are not validly formatted are skipped
+ * Returns 1 if a recovery password decrypts the volume master key, 0 if not or -1 on error
  */
-int libbde_volume_set_keys(
+int libbde_volume_test_utf16_recovery_passwords(
      libbde_volume_t *volume,
-     const uint8_t *full_volume_encryption_key,
-     size_t full_volume_encryption_key_size,
-     const uint8_t *tweak_key,
-     size_t tweak_key_size,
+     const uint16_t **utf16_strings,
+     const size_t *utf16_string_lengths,
+     int number_of_strings,
+     int *recovery_password_index,
      libcerror_error_t **error )
 {
+	uint8_t password_hash[ 32 ];
+
 	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_set_keys";
+	libbde_password_batch_t *password_batch   = NULL;
+	static char *function                     = "libbde_volume_test_utf16_recovery_passwords";
+	int result                                = 0;
+	int string_index                          = 0;
 
 	if( volume == NULL )
 	{
@@ -3536,89 +7430,129 @@ int libbde_volume_set_keys(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
+	if( internal_volume->file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
+		 "%s: invalid volume - missing file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_volume->file_io_handle != NULL )
+	if( utf16_strings == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - file IO handle already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-16 strings.",
 		 function );
 
 		return( -1 );
 	}
-	if( full_volume_encryption_key == NULL )
+	if( utf16_string_lengths == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid full volume encryption key.",
+		 "%s: invalid UTF-16 string lengths.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( full_volume_encryption_key_size != 16 )
-	 && ( full_volume_encryption_key_size != 32 ) )
+	if( number_of_strings <= 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported full volume encryption key size.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of strings value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	if( tweak_key == NULL )
+	if( recovery_password_index == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid tweak key.",
+		 "%s: invalid recovery password index.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( tweak_key_size != 0 )
-	 && ( tweak_key_size != 16 )
-	 && ( tweak_key_size != 32 ) )
+	if( libbde_password_batch_initialize(
+	     &password_batch,
+	     number_of_strings,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported tweak key size.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create password batch.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( ( tweak_key_size != 0 )
-	 && ( tweak_key_size != full_volume_encryption_key_size ) )
+	for( string_index = 0;
+	     string_index < number_of_strings;
+	     string_index++ )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: mismatch in full volume encryption key and tweak key size.",
-		 function );
+		result = libbde_utf16_recovery_password_calculate_hash(
+		          utf16_strings[ string_index ],
+		          utf16_string_lengths[ string_index ],
+		          password_hash,
+		          32,
+		          error );
 
-		return( -1 );
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to calculate recovery password hash: %d.",
+			 function,
+			 string_index );
+
+			goto on_error;
+		}
+		/* Recovery passwords that are not valid are skipped
+		 */
+		else if( result == 0 )
+		{
+			continue;
+		}
+		if( libbde_password_batch_append_password_hash(
+		     password_batch,
+		     string_index,
+		     password_hash,
+		     32,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append recovery password hash: %d to batch.",
+			 function,
+			 string_index );
+
+			goto on_error;
+		}
 	}
+	memory_set(
+	 password_hash,
+	 0,
+	 32 );
+
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3626,131 +7560,89 @@ int libbde_volume_set_keys(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
 #endif
-	if( full_volume_encryption_key_size < 32 )
-	{
-		if( memory_set(
-		     internal_volume->io_handle->full_volume_encryption_key,
-		     0,
-		     32  ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to clear full volume encryption key.",
-			 function );
+	result = libbde_internal_volume_test_password_batch(
+	          internal_volume,
+	          password_batch,
+	          LIBBDE_KEY_PROTECTION_TYPE_RECOVERY_PASSWORD,
+	          recovery_password_index,
+	          error );
 
-			goto on_error;
-		}
-	}
-	if( memory_copy(
-	     internal_volume->io_handle->full_volume_encryption_key,
-	     full_volume_encryption_key,
-	     full_volume_encryption_key_size ) == NULL )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-		 "%s: unable to copy full volume encryption key.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GENERIC,
+		 "%s: unable to test recovery passwords.",
 		 function );
-
-		goto on_error;
 	}
-	internal_volume->io_handle->full_volume_encryption_key_size = full_volume_encryption_key_size;
-
-	if( tweak_key_size < 32 )
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
-		if( memory_set(
-		     internal_volume->io_handle->tweak_key,
-		     0,
-		     32  ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-			 "%s: unable to clear tweak key.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-			goto on_error;
-		}
+		goto on_error;
 	}
-	if( tweak_key_size != 0 )
+#endif
+	if( result == -1 )
 	{
-		if( memory_copy(
-		     internal_volume->io_handle->tweak_key,
-		     tweak_key,
-		     tweak_key_size ) == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_MEMORY,
-			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-			 "%s: unable to copy tweak key.",
-			 function );
-
-			goto on_error;
-		}
+		goto on_error;
 	}
-	internal_volume->io_handle->tweak_key_size = tweak_key_size;
-
-	internal_volume->io_handle->keys_are_set = 1;
-
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_volume->read_write_lock,
+	if( libbde_password_batch_free(
+	     &password_batch,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free password batch.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( 1 );
+	return( result );
 
 on_error:
 	memory_set(
-	 internal_volume->io_handle->tweak_key,
-	 0,
-	 32 );
-
-	memory_set(
-	 internal_volume->io_handle->full_volume_encryption_key,
+	 password_hash,
 	 0,
 	 32 );
 
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
+	if( password_batch != NULL )
+	{
+		libbde_password_batch_free(
+		 &password_batch,
+		 NULL );
+	}
 	return( -1 );
 }
 
-/* Sets an UTF-8 formatted password
+/* Sets the startup key from a .BEK file
  * This function needs to be used before one of the open functions
- * Returns 1 if successful, 0 if password is invalid or -1 on error
+ * Returns 1 if successful or -1 on error
  */
-int libbde_volume_set_utf8_password(
+int libbde_volume_read_startup_key(
      libbde_volume_t *volume,
-     const uint8_t *utf8_string,
-     size_t utf8_string_length,
+     const char *filename,
      libcerror_error_t **error )
 {
-	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_set_utf8_password";
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libbde_volume_read_startup_key";
+	size_t filename_length           = 0;
 
 	if( volume == NULL )
 	{
@@ -3763,101 +7655,102 @@ int libbde_volume_set_utf8_password(
 
 		return( -1 );
 	}
-	internal_volume = (libbde_internal_volume_t *) volume;
+	filename_length = narrow_string_length(
+	                   filename );
 
-	if( internal_volume->password_keep == NULL )
+	if( filename_length == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing password keep.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_volume->file_io_handle != NULL )
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - file IO handle already set.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length,
 	     error ) != 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
-		 function );
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set filename in file IO handle.",
+                 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	if( libbde_utf8_password_calculate_hash(
-	     utf8_string,
-	     utf8_string_length,
-	     internal_volume->password_keep->password_hash,
-	     32,
+	if( libbde_volume_read_startup_key_file_io_handle(
+	     volume,
+	     file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set password hash.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open startup key file: %s.",
+		 function,
+		 filename );
 
 		goto on_error;
 	}
-	internal_volume->password_keep->password_is_set = 1;
-
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_volume->read_write_lock,
+	if( libbfio_handle_free(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
 	return( 1 );
 
 on_error:
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+        return( -1 );
 }
 
-/* Sets an UTF-16 formatted password
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the startup key from a .BEK file
  * This function needs to be used before one of the open functions
- * Returns 1 if successful, 0 if password is invalid or -1 on error
+ * Returns 1 if successful or -1 on error
  */
-int libbde_volume_set_utf16_password(
+int libbde_volume_read_startup_key_wide(
      libbde_volume_t *volume,
-     const uint16_t *utf16_string,
-     size_t utf16_string_length,
+     const wchar_t *filename,
      libcerror_error_t **error )
 {
-	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_set_utf16_password";
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libbde_volume_read_startup_key_wide";
+	size_t filename_length           = 0;
 
 	if( volume == NULL )
 	{
@@ -3870,243 +7763,351 @@ int libbde_volume_set_utf16_password(
 
 		return( -1 );
 	}
-	internal_volume = (libbde_internal_volume_t *) volume;
+	filename_length = wide_string_length(
+	                   filename );
 
-	if( internal_volume->password_keep == NULL )
+	if( filename_length == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing password keep.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_volume->file_io_handle != NULL )
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - file IO handle already set.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length,
 	     error ) != 1 )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
-		 function );
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set filename in file IO handle.",
+                 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	if( libbde_utf16_password_calculate_hash(
-	     utf16_string,
-	     utf16_string_length,
-	     internal_volume->password_keep->password_hash,
-	     32,
+	if( libbde_volume_read_startup_key_file_io_handle(
+	     volume,
+	     file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set password hash.",
-		 function );
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open startup key file: %ls.",
+		 function,
+		 filename );
 
 		goto on_error;
 	}
-	internal_volume->password_keep->password_is_set = 1;
-
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_volume->read_write_lock,
+	if( libbfio_handle_free(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
 	return( 1 );
 
 on_error:
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+        return( -1 );
 }
 
-/* Sets an UTF-8 formatted recovery password
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Sets the startup key from a .BEK file using a Basic File IO (bfio) handle
  * This function needs to be used before one of the open functions
- * Returns 1 if successful, 0 if recovery password is invalid or -1 on error
+ * Returns 1 if successful or -1 on error
  */
-int libbde_volume_set_utf8_recovery_password(
+int libbde_volume_read_startup_key_file_io_handle(
      libbde_volume_t *volume,
-     const uint8_t *utf8_string,
-     size_t utf8_string_length,
+     libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
+	bde_metadata_header_v1_t file_header;
+
 	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_set_utf8_recovery_password";
+	libbde_metadata_t *external_key_metadata  = NULL;
+	uint8_t *metadata_entries_data            = NULL;
+	static char *function                     = "libbde_volume_read_startup_key_wide";
+	ssize_t read_count                        = 0;
+	uint32_t metadata_size                    = 0;
+	int file_io_handle_is_open                = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume = (libbde_internal_volume_t *) volume;
+
+	if( internal_volume->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid volume - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_volume->external_key_metadata != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume - external key metadata already set.",
+		 function );
 
-	if( volume == NULL )
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 "%s: invalid file IO handle.",
 		 function );
 
 		return( -1 );
 	}
-	internal_volume = (libbde_internal_volume_t *) volume;
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
 
-	if( internal_volume->password_keep == NULL )
+	if( file_io_handle_is_open == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing password keep.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_volume->file_io_handle != NULL )
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - file IO handle already set.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek file header offset: 0.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
+	if( libbde_metadata_initialize(
+	     &external_key_metadata,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create external key metadata.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "Reading BitLocker External Key (BEK) metadata:\n" );
 	}
 #endif
-	if( libbde_utf8_recovery_password_calculate_hash(
-	     utf8_string,
-	     utf8_string_length,
-	     internal_volume->password_keep->recovery_password_hash,
-	     32,
-	     error ) != 1 )
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              (uint8_t *) &file_header,
+	              sizeof( bde_metadata_header_v1_t ),
+	              error );
+
+	if( read_count != sizeof( bde_metadata_header_v1_t ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set recovery password hash.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
 		 function );
 
 		goto on_error;
 	}
-	internal_volume->password_keep->recovery_password_is_set = 1;
+	read_count = libbde_metadata_read_header(
+	              external_key_metadata,
+	              (uint8_t *) &file_header,
+	              sizeof( bde_metadata_header_v1_t ),
+	              &metadata_size,
+	              error );
 
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
+	if( read_count == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read external key metadata header.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( 1 );
+	if( metadata_size < sizeof( bde_metadata_header_v1_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: metadata size value out of bounds.",
+		 function );
 
-on_error:
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
+		goto on_error;
+	}
+	metadata_size -= sizeof( bde_metadata_header_v1_t );
 
-/* Sets an UTF-16 formatted recovery password
- * This function needs to be used before one of the open functions
- * Returns 1 if successful, 0 if recovery password is invalid or -1 on error
- */
-int libbde_volume_set_utf16_recovery_password(
-     libbde_volume_t *volume,
-     const uint16_t *utf16_string,
-     size_t utf16_string_length,
-     libcerror_error_t **error )
-{
-	libbde_internal_volume_t *internal_volume = NULL;
-	static char *function                     = "libbde_volume_set_utf16_recovery_password";
+	metadata_entries_data = (uint8_t *) memory_allocate(
+	                                     sizeof( uint8_t ) * metadata_size );
 
-	if( volume == NULL )
+	if( metadata_entries_data == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to metadata entries data.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	internal_volume = (libbde_internal_volume_t *) volume;
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              metadata_entries_data,
+	              (size_t) metadata_size,
+	              error );
 
-	if( internal_volume->password_keep == NULL )
+	if( read_count != (ssize_t) metadata_size )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing password keep.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata entries data.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( internal_volume->file_io_handle != NULL )
+	read_count = libbde_metadata_read_entries(
+	              external_key_metadata,
+	              metadata_entries_data,
+	              (size_t) metadata_size,
+	              NULL,
+	              0,
+	              error );
+
+	if( read_count == -1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - file IO handle already set.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read external key metadata entries.",
 		 function );
 
-		return( -1 );
+		goto on_error;
+	}
+	memory_free(
+	 metadata_entries_data );
+
+	metadata_entries_data = NULL;
+
+	if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file.",
+			 function );
+
+			goto on_error;
+		}
 	}
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_write(
@@ -4123,23 +8124,7 @@ int libbde_volume_set_utf16_recovery_password(
 		return( -1 );
 	}
 #endif
-	if( libbde_utf16_recovery_password_calculate_hash(
-	     utf16_string,
-	     utf16_string_length,
-	     internal_volume->password_keep->recovery_password_hash,
-	     32,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set recovery password hash.",
-		 function );
-
-		goto on_error;
-	}
-	internal_volume->password_keep->recovery_password_is_set = 1;
+	internal_volume->external_key_metadata = external_key_metadata;
 
 #if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -4159,25 +8144,38 @@ int libbde_volume_set_utf16_recovery_password(
 	return( 1 );
 
 on_error:
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_volume->read_write_lock,
-	 NULL );
-#endif
+	if( metadata_entries_data != NULL )
+	{
+		memory_free(
+		 metadata_entries_data );
+	}
+	if( external_key_metadata != NULL )
+	{
+		libbde_metadata_free(
+		 &external_key_metadata,
+		 NULL );
+	}
+	if( file_io_handle_is_open == 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 error );
+	}
 	return( -1 );
 }
 
-/* Sets the startup key from a .BEK file
+/* Reads the keys from a keyring file
  * This function needs to be used before one of the open functions
+ * It can be called multiple times to read multiple keyring files
  * Returns 1 if successful or -1 on error
  */
-int libbde_volume_read_startup_key(
+int libbde_volume_read_keyring(
      libbde_volume_t *volume,
      const char *filename,
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle = NULL;
-	static char *function            = "libbde_volume_read_startup_key";
+	static char *function            = "libbde_volume_read_keyring";
 	size_t filename_length           = 0;
 
 	if( volume == NULL )
@@ -4233,7 +8231,7 @@ int libbde_volume_read_startup_key(
 
 		goto on_error;
 	}
-	if( libbde_volume_read_startup_key_file_io_handle(
+	if( libbde_volume_read_keyring_file_io_handle(
 	     volume,
 	     file_io_handle,
 	     error ) != 1 )
@@ -4242,7 +8240,7 @@ int libbde_volume_read_startup_key(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open startup key file: %s.",
+		 "%s: unable to read keyring file: %s.",
 		 function,
 		 filename );
 
@@ -4275,17 +8273,18 @@ on_error:
 
 #if defined( HAVE_WIDE_CHARACTER_TYPE )
 
-/* Sets the startup key from a .BEK file
+/* Reads the keys from a keyring file
  * This function needs to be used before one of the open functions
+ * It can be called multiple times to read multiple keyring files
  * Returns 1 if successful or -1 on error
  */
-int libbde_volume_read_startup_key_wide(
+int libbde_volume_read_keyring_wide(
      libbde_volume_t *volume,
      const wchar_t *filename,
      libcerror_error_t **error )
 {
 	libbfio_handle_t *file_io_handle = NULL;
-	static char *function            = "libbde_volume_read_startup_key_wide";
+	static char *function            = "libbde_volume_read_keyring_wide";
 	size_t filename_length           = 0;
 
 	if( volume == NULL )
@@ -4341,7 +8340,7 @@ int libbde_volume_read_startup_key_wide(
 
 		goto on_error;
 	}
-	if( libbde_volume_read_startup_key_file_io_handle(
+	if( libbde_volume_read_keyring_file_io_handle(
 	     volume,
 	     file_io_handle,
 	     error ) != 1 )
@@ -4350,7 +8349,7 @@ int libbde_volume_read_startup_key_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open startup key file: %ls.",
+		 "%s: unable to read keyring file: %ls.",
 		 function,
 		 filename );
 
@@ -4383,24 +8382,19 @@ on_error:
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
-/* Sets the startup key from a .BEK file using a Basic File IO (bfio) handle
+/* Reads the keys from a keyring file using a Basic File IO (bfio) handle
  * This function needs to be used before one of the open functions
+ * It can be called multiple times to read multiple keyring files
  * Returns 1 if successful or -1 on error
  */
-int libbde_volume_read_startup_key_file_io_handle(
+int libbde_volume_read_keyring_file_io_handle(
      libbde_volume_t *volume,
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error )
 {
-	bde_metadata_header_v1_t file_header;
-
 	libbde_internal_volume_t *internal_volume = NULL;
-	libbde_metadata_t *external_key_metadata  = NULL;
-	uint8_t *metadata_entries_data            = NULL;
-	static char *function                     = "libbde_volume_read_startup_key_wide";
-	ssize_t read_count                        = 0;
-	uint32_t metadata_size                    = 0;
-	int file_io_handle_is_open                = 0;
+	libbde_keyring_t *keyring                 = NULL;
+	static char *function                     = "libbde_volume_read_keyring_file_io_handle";
 
 	if( volume == NULL )
 	{
@@ -4415,17 +8409,6 @@ int libbde_volume_read_startup_key_file_io_handle(
 	}
 	internal_volume = (libbde_internal_volume_t *) volume;
 
-	if( internal_volume->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid volume - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
 	if( internal_volume->file_io_handle != NULL )
 	{
 		libcerror_error_set(
@@ -4437,266 +8420,116 @@ int libbde_volume_read_startup_key_file_io_handle(
 
 		return( -1 );
 	}
-	if( internal_volume->external_key_metadata != NULL )
+	if( libbde_keyring_initialize(
+	     &keyring,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid volume - external key metadata already set.",
-		 function );
-
-		return( -1 );
-	}
-	if( file_io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	file_io_handle_is_open = libbfio_handle_is_open(
-	                          file_io_handle,
-	                          error );
-
-	if( file_io_handle_is_open == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open file.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create keyring.",
 		 function );
 
 		goto on_error;
 	}
-	else if( file_io_handle_is_open == 0 )
-	{
-		if( libbfio_handle_open(
-		     file_io_handle,
-		     LIBBFIO_OPEN_READ,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to open file.",
-			 function );
-
-			goto on_error;
-		}
-	}
-	if( libbfio_handle_seek_offset(
+	/* The keyring file is read into a separate keyring so that
+	 * a malformed file does not leave partially read entries behind
+	 */
+	if( libbde_keyring_read_file_io_handle(
+	     keyring,
 	     file_io_handle,
-	     0,
-	     SEEK_SET,
-	     error ) == -1 )
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek file header offset: 0.",
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read keyring.",
 		 function );
 
 		goto on_error;
 	}
-	if( libbde_metadata_initialize(
-	     &external_key_metadata,
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_volume->read_write_lock,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create external key metadata.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		goto on_error;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libcnotify_verbose != 0 )
-	{
-		libcnotify_printf(
-		 "Reading BitLocker External Key (BEK) metadata:\n" );
-	}
 #endif
-	read_count = libbfio_handle_read_buffer(
-	              file_io_handle,
-	              (uint8_t *) &file_header,
-	              sizeof( bde_metadata_header_v1_t ),
-	              error );
-
-	if( read_count != sizeof( bde_metadata_header_v1_t ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read file header.",
-		 function );
-
-		goto on_error;
-	}
-	read_count = libbde_metadata_read_header(
-	              external_key_metadata,
-	              (uint8_t *) &file_header,
-	              sizeof( bde_metadata_header_v1_t ),
-	              &metadata_size,
-	              error );
-
-	if( read_count == -1 )
+	if( internal_volume->keyring == NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read external key metadata header.",
-		 function );
+		internal_volume->keyring = keyring;
 
-		goto on_error;
+		keyring = NULL;
 	}
-	if( metadata_size < sizeof( bde_metadata_header_v1_t ) )
+	else if( libbde_keyring_move_entries(
+	          internal_volume->keyring,
+	          keyring,
+	          error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: metadata size value out of bounds.",
-		 function );
-
-		goto on_error;
-	}
-	metadata_size -= sizeof( bde_metadata_header_v1_t );
-
-	metadata_entries_data = (uint8_t *) memory_allocate(
-	                                     sizeof( uint8_t ) * metadata_size );
-
-	if( metadata_entries_data == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to metadata entries data.",
-		 function );
-
-		goto on_error;
-	}
-	read_count = libbfio_handle_read_buffer(
-	              file_io_handle,
-	              metadata_entries_data,
-	              (size_t) metadata_size,
-	              error );
-
-	if( read_count != (ssize_t) metadata_size )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read metadata entries data.",
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to move keyring entries.",
 		 function );
 
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+		libcthreads_read_write_lock_release_for_write(
+		 internal_volume->read_write_lock,
+		 NULL );
+#endif
 		goto on_error;
 	}
-	read_count = libbde_metadata_read_entries(
-	              external_key_metadata,
-	              metadata_entries_data,
-	              (size_t) metadata_size,
-	              NULL,
-	              0,
-	              error );
-
-	if( read_count == -1 )
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_volume->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read external key metadata entries.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		goto on_error;
 	}
-	memory_free(
-	 metadata_entries_data );
-
-	metadata_entries_data = NULL;
-
-	if( file_io_handle_is_open == 0 )
+#endif
+	if( keyring != NULL )
 	{
-		if( libbfio_handle_close(
-		     file_io_handle,
-		     error ) != 0 )
+		if( libbde_keyring_free(
+		     &keyring,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close file.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free keyring.",
 			 function );
 
 			goto on_error;
 		}
 	}
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
-		 function );
-
-		return( -1 );
-	}
-#endif
-	internal_volume->external_key_metadata = external_key_metadata;
-
-#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_volume->read_write_lock,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
-		 function );
-
-		return( -1 );
-	}
-#endif
 	return( 1 );
 
 on_error:
-	if( metadata_entries_data != NULL )
-	{
-		memory_free(
-		 metadata_entries_data );
-	}
-	if( external_key_metadata != NULL )
+	if( keyring != NULL )
 	{
-		libbde_metadata_free(
-		 &external_key_metadata,
+		libbde_keyring_free(
+		 &keyring,
 		 NULL );
 	}
-	if( file_io_handle_is_open == 0 )
-	{
-		libbfio_handle_close(
-		 file_io_handle,
-		 error );
-	}
 	return( -1 );
 }
 
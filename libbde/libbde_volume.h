@@ -27,14 +27,19 @@
 
 #include "libbde_extern.h"
 #include "libbde_io_handle.h"
+#include "libbde_keyring.h"
 #include "libbde_libbfio.h"
 #include "libbde_libcerror.h"
 #include "libbde_libcthreads.h"
-#include "libbde_libfcache.h"
-#include "libbde_libfdata.h"
 #include "libbde_metadata.h"
+#include "libbde_password_batch.h"
 #include "libbde_password_keep.h"
+#include "libbde_read_ahead.h"
+#include "libbde_read_pool.h"
+#include "libbde_sector_cache.h"
+#include "libbde_sector_data.h"
 #include "libbde_types.h"
+#include "libbde_write_cache.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -64,22 +69,51 @@ struct libbde_internal_volume
 	 */
 	libbde_metadata_t *tertiary_metadata;
 
+	/* The number of metadata blocks that were read, or found to be
+	 * unavailable, in order of primary, secondary and tertiary
+	 */
+	int number_of_metadata_blocks_read;
+
 	/* The metadata volumed in a startup key file
 	 */
 	libbde_metadata_t *external_key_metadata;
 
-	/* The sectors vector
+	/* The sector cache
+	 */
+	libbde_sector_cache_t *sector_cache;
+
+	/* The (maximum) size of the sector cache
+	 */
+	size64_t cache_size;
+
+	/* The read-ahead
+	 */
+	libbde_read_ahead_t *read_ahead;
+
+	/* The read-ahead depth in number of blocks
 	 */
-	libfdata_vector_t *sectors_vector;
+	int read_ahead_depth;
 
-	/* The sectors cache
+	/* The read pool
 	 */
-	libfcache_cache_t *sectors_cache;
+	libbde_read_pool_t *read_pool;
+
+	/* The number of threads of the read pool
+	 */
+	int number_of_decryption_threads;
+
+	/* The write cache
+	 */
+	libbde_write_cache_t *write_cache;
 
 	/* The file IO handle
 	 */
 	libbfio_handle_t *file_io_handle;
 
+	/* The access flags
+	 */
+	int access_flags;
+
 	/* The IO handle
 	 */
 	libbde_io_handle_t *io_handle;
@@ -96,6 +130,10 @@ struct libbde_internal_volume
 	 */
 	libbde_password_keep_t *password_keep;
 
+	/* The keyring
+	 */
+	libbde_keyring_t *keyring;
+
 	/* Value to indicate if the volume is locked
 	 */
 	uint8_t is_locked;
@@ -157,6 +195,13 @@ int libbde_volume_open_read(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+int libbde_internal_volume_read_metadata_block(
+     libbde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     int metadata_index,
+     libbde_metadata_t **metadata,
+     libcerror_error_t **error );
+
 int libbde_volume_open_read_keys_from_metadata(
      libbde_internal_volume_t *internal_volume,
      libbde_metadata_t *metadata,
@@ -167,6 +212,11 @@ int libbde_volume_is_locked(
      libbde_volume_t *volume,
      libcerror_error_t **error );
 
+LIBBDE_EXTERN \
+int libbde_volume_read_metadata_copies(
+     libbde_volume_t *volume,
+     libcerror_error_t **error );
+
 ssize_t libbde_internal_volume_read_buffer_from_file_io_handle(
          libbde_internal_volume_t *internal_volume,
          libbfio_handle_t *file_io_handle,
@@ -174,6 +224,19 @@ ssize_t libbde_internal_volume_read_buffer_from_file_io_handle(
          size_t buffer_size,
          libcerror_error_t **error );
 
+int libbde_internal_volume_initialize_read_ahead(
+     libbde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+ssize_t libbde_internal_volume_read_buffer_at_offset_from_file_io_handle(
+         libbde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
 LIBBDE_EXTERN \
 ssize_t libbde_volume_read_buffer(
          libbde_volume_t *volume,
@@ -189,12 +252,33 @@ ssize_t libbde_volume_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
-#ifdef TODO_WRITE_SUPPORT
+LIBBDE_EXTERN \
+ssize_t libbde_volume_read_buffer_at_offset_concurrent(
+         libbde_volume_t *volume,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t libbde_internal_volume_write_buffer_at_offset_to_file_io_handle(
+         libbde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+ssize_t libbde_internal_volume_write_buffer_to_file_io_handle(
+         libbde_internal_volume_t *internal_volume,
+         libbfio_handle_t *file_io_handle,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
 
 LIBBDE_EXTERN \
 ssize_t libbde_volume_write_buffer(
          libbde_volume_t *volume,
-         void *buffer,
+         const void *buffer,
          size_t buffer_size,
          libcerror_error_t **error );
 
@@ -206,7 +290,15 @@ ssize_t libbde_volume_write_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
-#endif /* TODO_WRITE_SUPPORT */
+int libbde_internal_volume_flush_write_cache(
+     libbde_internal_volume_t *internal_volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_flush(
+     libbde_volume_t *volume,
+     libcerror_error_t **error );
 
 off64_t libbde_internal_volume_seek_offset(
          libbde_internal_volume_t *internal_volume,
@@ -291,6 +383,45 @@ int libbde_volume_get_key_protector(
      libbde_key_protector_t **key_protector,
      libcerror_error_t **error );
 
+LIBBDE_EXTERN \
+int libbde_volume_get_number_of_regions(
+     libbde_volume_t *volume,
+     int *number_of_regions,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_get_region_by_index(
+     libbde_volume_t *volume,
+     int region_index,
+     off64_t *offset,
+     size64_t *size,
+     uint32_t *flags,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_set_block_size(
+     libbde_volume_t *volume,
+     size_t block_size,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_set_cache_size(
+     libbde_volume_t *volume,
+     size64_t cache_size,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_set_read_ahead_depth(
+     libbde_volume_t *volume,
+     int read_ahead_depth,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_set_number_of_decryption_threads(
+     libbde_volume_t *volume,
+     int number_of_threads,
+     libcerror_error_t **error );
+
 LIBBDE_EXTERN \
 int libbde_volume_set_keys(
      libbde_volume_t *volume,
@@ -328,6 +459,49 @@ int libbde_volume_set_utf16_recovery_password(
      size_t utf16_string_length,
      libcerror_error_t **error );
 
+int libbde_internal_volume_test_password_batch(
+     libbde_internal_volume_t *internal_volume,
+     libbde_password_batch_t *password_batch,
+     uint16_t key_protection_type,
+     int *password_index,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_test_utf8_passwords(
+     libbde_volume_t *volume,
+     const uint8_t **utf8_strings,
+     const size_t *utf8_string_lengths,
+     int number_of_strings,
+     int *password_index,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_test_utf16_passwords(
+     libbde_volume_t *volume,
+     const uint16_t **utf16_strings,
+     const size_t *utf16_string_lengths,
+     int number_of_strings,
+     int *password_index,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_test_utf8_recovery_passwords(
+     libbde_volume_t *volume,
+     const uint8_t **utf8_strings,
+     const size_t *utf8_string_lengths,
+     int number_of_strings,
+     int *recovery_password_index,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_test_utf16_recovery_passwords(
+     libbde_volume_t *volume,
+     const uint16_t **utf16_strings,
+     const size_t *utf16_string_lengths,
+     int number_of_strings,
+     int *recovery_password_index,
+     libcerror_error_t **error );
+
 LIBBDE_EXTERN \
 int libbde_volume_read_startup_key(
      libbde_volume_t *volume,
@@ -348,6 +522,26 @@ int libbde_volume_read_startup_key_file_io_handle(
      libbfio_handle_t *file_io_handle,
      libcerror_error_t **error );
 
+LIBBDE_EXTERN \
+int libbde_volume_read_keyring(
+     libbde_volume_t *volume,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+LIBBDE_EXTERN \
+int libbde_volume_read_keyring_wide(
+     libbde_volume_t *volume,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+#endif
+
+LIBBDE_EXTERN \
+int libbde_volume_read_keyring_file_io_handle(
+     libbde_volume_t *volume,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,844 @@
+/*
+ * Volume summary functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_io_handle.h"
+#include "libbde_libbfio.h"
+#include "libbde_libcerror.h"
+#include "libbde_libcnotify.h"
+#include "libbde_metadata.h"
+#include "libbde_types.h"
+#include "libbde_volume_master_key.h"
+#include "libbde_volume_summary.h"
+
+/* Creates a volume summary
+ * Make sure the value volume_summary is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_summary_initialize(
+     libbde_volume_summary_t **volume_summary,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_summary_t *internal_volume_summary = NULL;
+	static char *function                                     = "libbde_volume_summary_initialize";
+
+	if( volume_summary == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume summary.",
+		 function );
+
+		return( -1 );
+	}
+	if( *volume_summary != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid volume summary value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume_summary = memory_allocate_structure(
+	                           libbde_internal_volume_summary_t );
+
+	if( internal_volume_summary == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create volume summary.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_volume_summary,
+	     0,
+	     sizeof( libbde_internal_volume_summary_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear volume summary.",
+		 function );
+
+		memory_free(
+		 internal_volume_summary );
+
+		return( -1 );
+	}
+	*volume_summary = (libbde_volume_summary_t *) internal_volume_summary;
+
+	return( 1 );
+
+on_error:
+	if( internal_volume_summary != NULL )
+	{
+		memory_free(
+		 internal_volume_summary );
+	}
+	return( -1 );
+}
+
+/* Frees a volume summary
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_summary_free(
+     libbde_volume_summary_t **volume_summary,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_summary_t *internal_volume_summary = NULL;
+	static char *function                                     = "libbde_volume_summary_free";
+
+	if( volume_summary == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume summary.",
+		 function );
+
+		return( -1 );
+	}
+	if( *volume_summary != NULL )
+	{
+		internal_volume_summary = (libbde_internal_volume_summary_t *) *volume_summary;
+		*volume_summary         = NULL;
+
+		memory_free(
+		 internal_volume_summary );
+	}
+	return( 1 );
+}
+
+/* Reads a volume summary using a Basic File IO (bfio) handle
+ * Only the volume header and the first valid metadata block are read,
+ * no key material is derived and no volume state is retained
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_summary_read_file_io_handle(
+     libbde_volume_summary_t *volume_summary,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libbde_io_handle_t io_handle;
+
+	libbde_internal_volume_summary_t *internal_volume_summary = NULL;
+	libbde_metadata_t *metadata                               = NULL;
+	libbde_volume_master_key_t *volume_master_key             = NULL;
+	static char *function                                     = "libbde_volume_summary_read_file_io_handle";
+	off64_t metadata_offset                                   = 0;
+	int file_io_handle_is_open                                = 0;
+	int key_protector_index                                   = 0;
+	int metadata_index                                        = 0;
+	int number_of_key_protectors                              = 0;
+	int result                                                = 0;
+
+	if( volume_summary == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume summary.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume_summary = (libbde_internal_volume_summary_t *) volume_summary;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to determine if file IO handle is open.",
+		 function );
+
+		goto on_error;
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_READ,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The volume header values are read into an IO handle on the stack,
+	 * which has no mutexes or encryption contexts
+	 */
+	if( libbde_io_handle_initialize_header_values(
+	     &io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize IO handle header values.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_io_handle_read_volume_header(
+	     &io_handle,
+	     file_io_handle,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read volume header.",
+		 function );
+
+		goto on_error;
+	}
+	/* Only fall back to the secondary and tertiary metadata blocks
+	 * if the preceding metadata block is invalid
+	 */
+	for( metadata_index = 0;
+	     metadata_index < 3;
+	     metadata_index++ )
+	{
+		if( metadata_index == 0 )
+		{
+			metadata_offset = io_handle.first_metadata_offset;
+		}
+		else if( metadata_index == 1 )
+		{
+			metadata_offset = io_handle.second_metadata_offset;
+		}
+		else
+		{
+			metadata_offset = io_handle.third_metadata_offset;
+		}
+		if( metadata_offset <= 0 )
+		{
+			continue;
+		}
+		if( libbde_metadata_initialize(
+		     &metadata,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create metadata.",
+			 function );
+
+			goto on_error;
+		}
+		result = libbde_metadata_read_block(
+		          metadata,
+		          &io_handle,
+		          file_io_handle,
+		          metadata_offset,
+		          NULL,
+		          0,
+		          error );
+
+		if( result == 1 )
+		{
+			break;
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( ( error != NULL )
+		 && ( libcnotify_verbose != 0 ) )
+		{
+			libcnotify_print_error_backtrace(
+			 *error );
+		}
+#endif
+		libcerror_error_free(
+		 error );
+
+		if( libbde_metadata_free(
+		     &metadata,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free metadata.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( metadata == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read metadata - no valid metadata block found.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbde_metadata_get_number_of_volume_master_keys(
+	     metadata,
+	     &number_of_key_protectors,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of volume master keys.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( number_of_key_protectors < 0 )
+	 || ( number_of_key_protectors > LIBBDE_VOLUME_SUMMARY_MAXIMUM_NUMBER_OF_KEY_PROTECTORS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of key protectors: %d.",
+		 function,
+		 number_of_key_protectors );
+
+		goto on_error;
+	}
+	for( key_protector_index = 0;
+	     key_protector_index < number_of_key_protectors;
+	     key_protector_index++ )
+	{
+		if( libbde_metadata_get_volume_master_key_by_index(
+		     metadata,
+		     key_protector_index,
+		     &volume_master_key,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve volume master key: %d.",
+			 function,
+			 key_protector_index );
+
+			goto on_error;
+		}
+		if( libbde_volume_master_key_get_identifier(
+		     volume_master_key,
+		     internal_volume_summary->key_protector_identifiers[ key_protector_index ],
+		     16,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve identifier of volume master key: %d.",
+			 function,
+			 key_protector_index );
+
+			goto on_error;
+		}
+		if( libbde_volume_master_key_get_protection_type(
+		     volume_master_key,
+		     &( internal_volume_summary->key_protector_types[ key_protector_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve protection type of volume master key: %d.",
+			 function,
+			 key_protector_index );
+
+			goto on_error;
+		}
+	}
+	if( memory_copy(
+	     internal_volume_summary->volume_identifier,
+	     metadata->volume_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy volume identifier.",
+		 function );
+
+		goto on_error;
+	}
+	internal_volume_summary->version                  = io_handle.version;
+	internal_volume_summary->encryption_method        = metadata->encryption_method;
+	internal_volume_summary->creation_time            = metadata->creation_time;
+	internal_volume_summary->number_of_key_protectors = number_of_key_protectors;
+
+	if( libbde_metadata_free(
+	     &metadata,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free metadata.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( metadata != NULL )
+	{
+		libbde_metadata_free(
+		 &metadata,
+		 NULL );
+	}
+	if( file_io_handle_is_open == 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+	}
+	memory_set(
+	 internal_volume_summary,
+	 0,
+	 sizeof( libbde_internal_volume_summary_t ) );
+
+	return( -1 );
+}
+
+/* Retrieves the format version
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_summary_get_version(
+     libbde_volume_summary_t *volume_summary,
+     int *version,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_summary_t *internal_volume_summary = NULL;
+	static char *function                                     = "libbde_volume_summary_get_version";
+
+	if( volume_summary == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume summary.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume_summary = (libbde_internal_volume_summary_t *) volume_summary;
+
+	if( version == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid version.",
+		 function );
+
+		return( -1 );
+	}
+	*version = internal_volume_summary->version;
+
+	return( 1 );
+}
+
+/* Retrieves the encryption method
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_summary_get_encryption_method(
+     libbde_volume_summary_t *volume_summary,
+     uint16_t *encryption_method,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_summary_t *internal_volume_summary = NULL;
+	static char *function                                     = "libbde_volume_summary_get_encryption_method";
+
+	if( volume_summary == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume summary.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume_summary = (libbde_internal_volume_summary_t *) volume_summary;
+
+	if( encryption_method == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid encryption method.",
+		 function );
+
+		return( -1 );
+	}
+	*encryption_method = internal_volume_summary->encryption_method;
+
+	return( 1 );
+}
+
+/* Retrieves the volume identifier
+ * The identifier is a GUID and is 16 bytes of size
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_summary_get_volume_identifier(
+     libbde_volume_summary_t *volume_summary,
+     uint8_t *guid_data,
+     size_t guid_data_size,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_summary_t *internal_volume_summary = NULL;
+	static char *function                                     = "libbde_volume_summary_get_volume_identifier";
+
+	if( volume_summary == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume summary.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume_summary = (libbde_internal_volume_summary_t *) volume_summary;
+
+	if( guid_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid GUID data.",
+		 function );
+
+		return( -1 );
+	}
+	if( guid_data_size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid GUID data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     guid_data,
+	     internal_volume_summary->volume_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy volume identifier.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the creation date and time
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_summary_get_creation_time(
+     libbde_volume_summary_t *volume_summary,
+     uint64_t *filetime,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_summary_t *internal_volume_summary = NULL;
+	static char *function                                     = "libbde_volume_summary_get_creation_time";
+
+	if( volume_summary == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume summary.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume_summary = (libbde_internal_volume_summary_t *) volume_summary;
+
+	if( filetime == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filetime.",
+		 function );
+
+		return( -1 );
+	}
+	*filetime = internal_volume_summary->creation_time;
+
+	return( 1 );
+}
+
+/* Retrieves the number of key protectors
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_summary_get_number_of_key_protectors(
+     libbde_volume_summary_t *volume_summary,
+     int *number_of_key_protectors,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_summary_t *internal_volume_summary = NULL;
+	static char *function                                     = "libbde_volume_summary_get_number_of_key_protectors";
+
+	if( volume_summary == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume summary.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume_summary = (libbde_internal_volume_summary_t *) volume_summary;
+
+	if( number_of_key_protectors == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of key protectors.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_key_protectors = internal_volume_summary->number_of_key_protectors;
+
+	return( 1 );
+}
+
+/* Retrieves a specific key protector identifier
+ * The identifier is a GUID and is 16 bytes of size
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_summary_get_key_protector_identifier(
+     libbde_volume_summary_t *volume_summary,
+     int key_protector_index,
+     uint8_t *guid_data,
+     size_t guid_data_size,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_summary_t *internal_volume_summary = NULL;
+	static char *function                                     = "libbde_volume_summary_get_key_protector_identifier";
+
+	if( volume_summary == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume summary.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume_summary = (libbde_internal_volume_summary_t *) volume_summary;
+
+	if( ( key_protector_index < 0 )
+	 || ( key_protector_index >= internal_volume_summary->number_of_key_protectors ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key protector index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( guid_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid GUID data.",
+		 function );
+
+		return( -1 );
+	}
+	if( guid_data_size < 16 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid GUID data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     guid_data,
+	     internal_volume_summary->key_protector_identifiers[ key_protector_index ],
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy key protector identifier.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific key protector type
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_volume_summary_get_key_protector_type(
+     libbde_volume_summary_t *volume_summary,
+     int key_protector_index,
+     uint16_t *type,
+     libcerror_error_t **error )
+{
+	libbde_internal_volume_summary_t *internal_volume_summary = NULL;
+	static char *function                                     = "libbde_volume_summary_get_key_protector_type";
+
+	if( volume_summary == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume summary.",
+		 function );
+
+		return( -1 );
+	}
+	internal_volume_summary = (libbde_internal_volume_summary_t *) volume_summary;
+
+	if( ( key_protector_index < 0 )
+	 || ( key_protector_index >= internal_volume_summary->number_of_key_protectors ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid key protector index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid type.",
+		 function );
+
+		return( -1 );
+	}
+	*type = internal_volume_summary->key_protector_types[ key_protector_index ];
+
+	return( 1 );
+}
+
@@ -0,0 +1,141 @@
+/*
+ * Volume summary functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_INTERNAL_VOLUME_SUMMARY_H )
+#define _LIBBDE_INTERNAL_VOLUME_SUMMARY_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_extern.h"
+#include "libbde_libbfio.h"
+#include "libbde_libcerror.h"
+#include "libbde_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum number of key protectors in a volume summary
+ */
+#define LIBBDE_VOLUME_SUMMARY_MAXIMUM_NUMBER_OF_KEY_PROTECTORS	32
+
+typedef struct libbde_internal_volume_summary libbde_internal_volume_summary_t;
+
+struct libbde_internal_volume_summary
+{
+	/* The format version
+	 */
+	int version;
+
+	/* The encryption method
+	 */
+	uint16_t encryption_method;
+
+	/* The volume identifier
+	 * Contains a GUID
+	 */
+	uint8_t volume_identifier[ 16 ];
+
+	/* The creation date and time
+	 */
+	uint64_t creation_time;
+
+	/* The number of key protectors
+	 */
+	int number_of_key_protectors;
+
+	/* The key protector identifiers
+	 * Contains a GUID per key protector
+	 */
+	uint8_t key_protector_identifiers[ LIBBDE_VOLUME_SUMMARY_MAXIMUM_NUMBER_OF_KEY_PROTECTORS ][ 16 ];
+
+	/* The key protector types
+	 */
+	uint16_t key_protector_types[ LIBBDE_VOLUME_SUMMARY_MAXIMUM_NUMBER_OF_KEY_PROTECTORS ];
+};
+
+int libbde_volume_summary_initialize(
+     libbde_volume_summary_t **volume_summary,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_summary_free(
+     libbde_volume_summary_t **volume_summary,
+     libcerror_error_t **error );
+
+int libbde_volume_summary_read_file_io_handle(
+     libbde_volume_summary_t *volume_summary,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_summary_get_version(
+     libbde_volume_summary_t *volume_summary,
+     int *version,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_summary_get_encryption_method(
+     libbde_volume_summary_t *volume_summary,
+     uint16_t *encryption_method,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_summary_get_volume_identifier(
+     libbde_volume_summary_t *volume_summary,
+     uint8_t *guid_data,
+     size_t guid_data_size,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_summary_get_creation_time(
+     libbde_volume_summary_t *volume_summary,
+     uint64_t *filetime,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_summary_get_number_of_key_protectors(
+     libbde_volume_summary_t *volume_summary,
+     int *number_of_key_protectors,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_summary_get_key_protector_identifier(
+     libbde_volume_summary_t *volume_summary,
+     int key_protector_index,
+     uint8_t *guid_data,
+     size_t guid_data_size,
+     libcerror_error_t **error );
+
+LIBBDE_EXTERN \
+int libbde_volume_summary_get_key_protector_type(
+     libbde_volume_summary_t *volume_summary,
+     int key_protector_index,
+     uint16_t *type,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_INTERNAL_VOLUME_SUMMARY_H ) */
+
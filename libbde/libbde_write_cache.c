@@ -0,0 +1,796 @@
+/*
+ * Write cache functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libbde_definitions.h"
+#include "libbde_encryption.h"
+#include "libbde_io_handle.h"
+#include "libbde_libbfio.h"
+#include "libbde_libcerror.h"
+#include "libbde_libcnotify.h"
+#include "libbde_sector_data.h"
+#include "libbde_write_cache.h"
+
+/* Creates a write cache
+ * The write cache retains the unencrypted data of modified blocks until they are flushed
+ * Make sure the value write_cache is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_write_cache_initialize(
+     libbde_write_cache_t **write_cache,
+     size_t block_size,
+     size64_t cache_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "libbde_write_cache_initialize";
+	size64_t number_of_blocks = 0;
+	size_t run_data_size      = 0;
+
+	if( write_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write cache value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size == 0 )
+	 || ( block_size > (size_t) LIBBDE_MAXIMUM_BLOCK_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_blocks = cache_size / block_size;
+
+	if( number_of_blocks == 0 )
+	{
+		number_of_blocks = 1;
+	}
+	if( number_of_blocks > (size64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid cache size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	/* A run consists of whole blocks
+	 */
+	run_data_size = ( LIBBDE_WRITE_CACHE_MAXIMUM_RUN_SIZE / block_size ) * block_size;
+
+	if( run_data_size == 0 )
+	{
+		run_data_size = block_size;
+	}
+	*write_cache = memory_allocate_structure(
+	                libbde_write_cache_t );
+
+	if( *write_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create write cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *write_cache,
+	     0,
+	     sizeof( libbde_write_cache_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear write cache.",
+		 function );
+
+		memory_free(
+		 *write_cache );
+
+		*write_cache = NULL;
+
+		return( -1 );
+	}
+	( *write_cache )->entries = (libbde_write_cache_entry_t *) memory_allocate(
+	                                                            sizeof( libbde_write_cache_entry_t ) * (size_t) number_of_blocks );
+
+	if( ( *write_cache )->entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entries.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *write_cache )->entries,
+	     0,
+	     sizeof( libbde_write_cache_entry_t ) * (size_t) number_of_blocks ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entries.",
+		 function );
+
+		goto on_error;
+	}
+	( *write_cache )->run_data = (uint8_t *) memory_allocate(
+	                                          sizeof( uint8_t ) * run_data_size );
+
+	if( ( *write_cache )->run_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create run data.",
+		 function );
+
+		goto on_error;
+	}
+	( *write_cache )->encrypted_run_data = (uint8_t *) memory_allocate(
+	                                                    sizeof( uint8_t ) * run_data_size );
+
+	if( ( *write_cache )->encrypted_run_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create encrypted run data.",
+		 function );
+
+		goto on_error;
+	}
+	( *write_cache )->block_size                = block_size;
+	( *write_cache )->maximum_number_of_entries = (int) number_of_blocks;
+	( *write_cache )->run_data_size             = run_data_size;
+
+	return( 1 );
+
+on_error:
+	if( *write_cache != NULL )
+	{
+		libbde_write_cache_free(
+		 write_cache,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a write cache
+ * Data that was not flushed is discarded
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_write_cache_free(
+     libbde_write_cache_t **write_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_write_cache_free";
+	int entry_index       = 0;
+
+	if( write_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_cache != NULL )
+	{
+		if( ( *write_cache )->entries != NULL )
+		{
+			/* Unused entries can retain data of a previous flush
+			 */
+			for( entry_index = 0;
+			     entry_index < ( *write_cache )->maximum_number_of_entries;
+			     entry_index++ )
+			{
+				if( ( *write_cache )->entries[ entry_index ].data != NULL )
+				{
+					memory_free(
+					 ( *write_cache )->entries[ entry_index ].data );
+				}
+			}
+			memory_free(
+			 ( *write_cache )->entries );
+		}
+		if( ( *write_cache )->encrypted_run_data != NULL )
+		{
+			memory_free(
+			 ( *write_cache )->encrypted_run_data );
+		}
+		if( ( *write_cache )->run_data != NULL )
+		{
+			memory_free(
+			 ( *write_cache )->run_data );
+		}
+		memory_free(
+		 *write_cache );
+
+		*write_cache = NULL;
+	}
+	return( 1 );
+}
+
+/* Retrieves the number of (modified) blocks in the write cache
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_write_cache_get_number_of_entries(
+     libbde_write_cache_t *write_cache,
+     int *number_of_entries,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_write_cache_get_number_of_entries";
+
+	if( write_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_entries == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of entries.",
+		 function );
+
+		return( -1 );
+	}
+	*number_of_entries = write_cache->number_of_entries;
+
+	return( 1 );
+}
+
+/* Determines if the write cache is full
+ * Returns 1 if full, 0 if not or -1 on error
+ */
+int libbde_write_cache_is_full(
+     libbde_write_cache_t *write_cache,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_write_cache_is_full";
+
+	if( write_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_cache->number_of_entries >= write_cache->maximum_number_of_entries )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Determines the index of the entry of a specific block
+ * If the block is not in the write cache the entry index is set to the index
+ * at which the block would be inserted
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libbde_write_cache_find_entry_index(
+     libbde_write_cache_t *write_cache,
+     off64_t block_offset,
+     int *entry_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_write_cache_find_entry_index";
+	int lower_index       = 0;
+	int middle_index      = 0;
+	int upper_index       = 0;
+
+	if( write_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( entry_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry index.",
+		 function );
+
+		return( -1 );
+	}
+	upper_index = write_cache->number_of_entries;
+
+	/* Blocks are mostly written sequentially so check the last entry first
+	 */
+	if( ( upper_index > 0 )
+	 && ( write_cache->entries[ upper_index - 1 ].block_offset < block_offset ) )
+	{
+		*entry_index = upper_index;
+
+		return( 0 );
+	}
+	while( lower_index < upper_index )
+	{
+		middle_index = lower_index + ( ( upper_index - lower_index ) / 2 );
+
+		if( write_cache->entries[ middle_index ].block_offset == block_offset )
+		{
+			*entry_index = middle_index;
+
+			return( 1 );
+		}
+		else if( write_cache->entries[ middle_index ].block_offset < block_offset )
+		{
+			lower_index = middle_index + 1;
+		}
+		else
+		{
+			upper_index = middle_index;
+		}
+	}
+	*entry_index = lower_index;
+
+	return( 0 );
+}
+
+/* Retrieves the data of a specific block
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libbde_write_cache_get_block(
+     libbde_write_cache_t *write_cache,
+     off64_t block_offset,
+     uint8_t **data,
+     libcerror_error_t **error )
+{
+	static char *function = "libbde_write_cache_get_block";
+	int entry_index       = 0;
+	int result            = 0;
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbde_write_cache_find_entry_index(
+	          write_cache,
+	          block_offset,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find entry of block at offset: %" PRIi64 ".",
+		 function,
+		 block_offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		*data = write_cache->entries[ entry_index ].data;
+	}
+	return( result );
+}
+
+/* Copies data of a specific block from the write cache into a buffer
+ * Returns 1 if successful, 0 if not available or -1 on error
+ */
+int libbde_write_cache_get_data(
+     libbde_write_cache_t *write_cache,
+     off64_t block_offset,
+     size_t block_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error )
+{
+	uint8_t *data         = NULL;
+	static char *function = "libbde_write_cache_get_data";
+	int result            = 0;
+
+	if( write_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_data_offset > write_cache->block_size )
+	 || ( buffer_size > ( write_cache->block_size - block_data_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbde_write_cache_get_block(
+	          write_cache,
+	          block_offset,
+	          &data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve block at offset: %" PRIi64 ".",
+		 function,
+		 block_offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		if( memory_copy(
+		     buffer,
+		     &( data[ block_data_offset ] ),
+		     buffer_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy block data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( result );
+}
+
+/* Inserts a block into the write cache
+ * The data is set to the block data of the entry, which is not initialized
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_write_cache_insert_block(
+     libbde_write_cache_t *write_cache,
+     off64_t block_offset,
+     uint8_t **data,
+     libcerror_error_t **error )
+{
+	uint8_t *entry_data   = NULL;
+	static char *function = "libbde_write_cache_insert_block";
+	int entry_index       = 0;
+	int move_index        = 0;
+	int result            = 0;
+
+	if( write_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( block_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( write_cache->number_of_entries >= write_cache->maximum_number_of_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid write cache - cache is full.",
+		 function );
+
+		return( -1 );
+	}
+	result = libbde_write_cache_find_entry_index(
+	          write_cache,
+	          block_offset,
+	          &entry_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find entry of block at offset: %" PRIi64 ".",
+		 function,
+		 block_offset );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write cache - block at offset: %" PRIi64 " already set.",
+		 function,
+		 block_offset );
+
+		return( -1 );
+	}
+	/* The first unused entry retains its data from a previous flush
+	 */
+	entry_data = write_cache->entries[ write_cache->number_of_entries ].data;
+
+	if( entry_data == NULL )
+	{
+		entry_data = (uint8_t *) memory_allocate(
+		                          sizeof( uint8_t ) * write_cache->block_size );
+
+		if( entry_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create entry data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	/* Shift the entries after the insertion point, the regions overlap
+	 * so the entries are moved one by one starting at the end
+	 */
+	for( move_index = write_cache->number_of_entries;
+	     move_index > entry_index;
+	     move_index-- )
+	{
+		write_cache->entries[ move_index ] = write_cache->entries[ move_index - 1 ];
+	}
+	write_cache->entries[ entry_index ].block_offset = block_offset;
+	write_cache->entries[ entry_index ].data         = entry_data;
+
+	write_cache->number_of_entries += 1;
+
+	*data = entry_data;
+
+	return( 1 );
+}
+
+/* Flushes the write cache
+ * Consecutive blocks are encrypted and written as runs of at most the run data size
+ * The write cache is empty afterwards
+ * Returns 1 if successful or -1 on error
+ */
+int libbde_write_cache_flush(
+     libbde_write_cache_t *write_cache,
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libbde_encryption_context_t *encryption_context,
+     libcerror_error_t **error )
+{
+	libbde_write_cache_entry_t *entry = NULL;
+	static char *function             = "libbde_write_cache_flush";
+	size_t run_size                   = 0;
+	off64_t run_offset                = 0;
+	int entry_index                   = 0;
+
+	if( write_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	while( entry_index < write_cache->number_of_entries )
+	{
+		entry      = &( write_cache->entries[ entry_index ] );
+		run_offset = entry->block_offset;
+		run_size   = 0;
+
+		/* Assemble a run of consecutive blocks
+		 */
+		while( ( entry_index < write_cache->number_of_entries )
+		    && ( ( run_size + write_cache->block_size ) <= write_cache->run_data_size ) )
+		{
+			entry = &( write_cache->entries[ entry_index ] );
+
+			if( entry->block_offset != ( run_offset + (off64_t) run_size ) )
+			{
+				break;
+			}
+			if( memory_copy(
+			     &( write_cache->run_data[ run_size ] ),
+			     entry->data,
+			     write_cache->block_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy block data.",
+				 function );
+
+				return( -1 );
+			}
+			run_size    += write_cache->block_size;
+			entry_index += 1;
+		}
+		if( (size64_t) run_offset >= io_handle->volume_size )
+		{
+			continue;
+		}
+		/* The last block can extend beyond the end of the volume
+		 */
+		if( (size64_t) run_size > ( io_handle->volume_size - run_offset ) )
+		{
+			run_size = (size_t) ( io_handle->volume_size - run_offset );
+		}
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: flushing %" PRIzd " bytes of data at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+			 function,
+			 run_size,
+			 run_offset,
+			 run_offset );
+		}
+#endif
+		if( libbde_sector_data_write_buffer(
+		     io_handle,
+		     file_io_handle,
+		     run_offset,
+		     write_cache->run_data,
+		     write_cache->encrypted_run_data,
+		     run_size,
+		     encryption_context,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write sector data at offset: %" PRIi64 ".",
+			 function,
+			 run_offset );
+
+			return( -1 );
+		}
+	}
+	write_cache->number_of_entries = 0;
+
+	return( 1 );
+}
+
@@ -0,0 +1,140 @@
+/*
+ * Write cache functions
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBBDE_WRITE_CACHE_H )
+#define _LIBBDE_WRITE_CACHE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libbde_encryption.h"
+#include "libbde_io_handle.h"
+#include "libbde_libbfio.h"
+#include "libbde_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libbde_write_cache_entry libbde_write_cache_entry_t;
+
+struct libbde_write_cache_entry
+{
+	/* The block offset
+	 */
+	off64_t block_offset;
+
+	/* The (unencrypted) data
+	 */
+	uint8_t *data;
+};
+
+typedef struct libbde_write_cache libbde_write_cache_t;
+
+struct libbde_write_cache
+{
+	/* The block size
+	 */
+	size_t block_size;
+
+	/* The entries, the used entries are sorted by block offset
+	 */
+	libbde_write_cache_entry_t *entries;
+
+	/* The number of used entries
+	 */
+	int number_of_entries;
+
+	/* The maximum number of entries
+	 */
+	int maximum_number_of_entries;
+
+	/* The buffer in which a run of consecutive blocks is assembled
+	 */
+	uint8_t *run_data;
+
+	/* The buffer in which a run of consecutive blocks is encrypted
+	 */
+	uint8_t *encrypted_run_data;
+
+	/* The size of the run buffers
+	 */
+	size_t run_data_size;
+};
+
+int libbde_write_cache_initialize(
+     libbde_write_cache_t **write_cache,
+     size_t block_size,
+     size64_t cache_size,
+     libcerror_error_t **error );
+
+int libbde_write_cache_free(
+     libbde_write_cache_t **write_cache,
+     libcerror_error_t **error );
+
+int libbde_write_cache_get_number_of_entries(
+     libbde_write_cache_t *write_cache,
+     int *number_of_entries,
+     libcerror_error_t **error );
+
+int libbde_write_cache_is_full(
+     libbde_write_cache_t *write_cache,
+     libcerror_error_t **error );
+
+int libbde_write_cache_find_entry_index(
+     libbde_write_cache_t *write_cache,
+     off64_t block_offset,
+     int *entry_index,
+     libcerror_error_t **error );
+
+int libbde_write_cache_get_block(
+     libbde_write_cache_t *write_cache,
+     off64_t block_offset,
+     uint8_t **data,
+     libcerror_error_t **error );
+
+int libbde_write_cache_get_data(
+     libbde_write_cache_t *write_cache,
+     off64_t block_offset,
+     size_t block_data_offset,
+     uint8_t *buffer,
+     size_t buffer_size,
+     libcerror_error_t **error );
+
+int libbde_write_cache_insert_block(
+     libbde_write_cache_t *write_cache,
+     off64_t block_offset,
+     uint8_t **data,
+     libcerror_error_t **error );
+
+int libbde_write_cache_flush(
+     libbde_write_cache_t *write_cache,
+     libbde_io_handle_t *io_handle,
+     libbfio_handle_t *file_io_handle,
+     libbde_encryption_context_t *encryption_context,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBBDE_WRITE_CACHE_H ) */
+
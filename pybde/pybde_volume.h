@@ -157,6 +157,11 @@ PyObject *pybde_volume_read_startup_key(
            PyObject *arguments,
            PyObject *keywords );
 
+PyObject *pybde_volume_read_keyring(
+           pybde_volume_t *pybde_volume,
+           PyObject *arguments,
+           PyObject *keywords );
+
 PyObject *pybde_volume_get_number_of_key_protectors(
            pybde_volume_t *pybde_volume,
            PyObject *arguments );
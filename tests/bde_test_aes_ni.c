@@ -0,0 +1,1316 @@
+/*
+ * Library AES-NI functions testing program
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_memory.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_aes_ni.h"
+#include "../libbde/libbde_definitions.h"
+
+#if defined( __GNUC__ ) && defined( HAVE_LIBBDE_AES_NI )
+
+#include <cpuid.h>
+
+/* FIPS-197 appendix C.1
+ */
+uint8_t bde_test_aes_ni_key[ 16 ] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+
+uint8_t bde_test_aes_ni_plaintext[ 16 ] = {
+	0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff };
+
+uint8_t bde_test_aes_ni_ciphertext[ 16 ] = {
+	0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a };
+
+/* Tests the libbde_aes_ni_is_supported function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_ni_is_supported(
+     void )
+{
+	unsigned int eax = 0;
+	unsigned int ebx = 0;
+	unsigned int ecx = 0;
+	unsigned int edx = 0;
+	int expected     = 0;
+	int result       = 0;
+
+	/* ECX bit 25 indicates AES-NI and EDX bit 26 indicates SSE2
+	 */
+	if( __get_cpuid(
+	     1,
+	     &eax,
+	     &ebx,
+	     &ecx,
+	     &edx ) != 0 )
+	{
+		if( ( ( ecx & 0x02000000UL ) != 0 )
+		 && ( ( edx & 0x04000000UL ) != 0 ) )
+		{
+			expected = 1;
+		}
+	}
+	/* Test regular cases
+	 */
+	result = libbde_aes_ni_is_supported();
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 expected );
+
+	/* The result must not change between calls
+	 */
+	result = libbde_aes_ni_is_supported();
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 expected );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libbde_aes_ni_self_test function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_ni_self_test(
+     void )
+{
+	int result = 0;
+
+	/* The AES-NI functions can only be tested on a CPU that supports them
+	 */
+	if( libbde_aes_ni_is_supported() == 0 )
+	{
+		return( 1 );
+	}
+	result = libbde_aes_ni_self_test();
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libbde_aes_ni_context_set_key function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_ni_context_set_key(
+     void )
+{
+	uint8_t key[ 32 ] = {
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+	libbde_aes_ni_context_t context;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* The AES-NI functions can only be tested on a CPU that supports them
+	 */
+	if( libbde_aes_ni_is_supported() == 0 )
+	{
+		return( 1 );
+	}
+	/* Test regular cases
+	 */
+	result = libbde_aes_ni_context_set_key(
+	          &context,
+	          key,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_ni_context_set_key(
+	          &context,
+	          key,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_aes_ni_context_set_key(
+	          NULL,
+	          key,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_context_set_key(
+	          &context,
+	          NULL,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_context_set_key(
+	          &context,
+	          key,
+	          192,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_ni_context_clear function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_ni_context_clear(
+     void )
+{
+	uint8_t empty_context_data[ sizeof( libbde_aes_ni_context_t ) ];
+
+	libbde_aes_ni_context_t context;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 empty_context_data,
+	 0,
+	 sizeof( libbde_aes_ni_context_t ) );
+
+	memory_set(
+	 &context,
+	 0xff,
+	 sizeof( libbde_aes_ni_context_t ) );
+
+	/* The round keys can only be set on a CPU that supports AES-NI
+	 */
+	if( libbde_aes_ni_is_supported() != 0 )
+	{
+		result = libbde_aes_ni_context_set_key(
+		          &context,
+		          bde_test_aes_ni_key,
+		          128,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libbde_aes_ni_context_clear(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "context.number_of_rounds",
+	 context.number_of_rounds,
+	 0 );
+
+	result = memory_compare(
+	          &context,
+	          empty_context_data,
+	          sizeof( libbde_aes_ni_context_t ) );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_aes_ni_context_clear(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_ni_crypt_ecb function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_ni_crypt_ecb(
+     void )
+{
+	uint8_t data[ 16 ];
+
+	libbde_aes_ni_context_t context;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* The AES-NI functions can only be tested on a CPU that supports them
+	 */
+	if( libbde_aes_ni_is_supported() == 0 )
+	{
+		return( 1 );
+	}
+	/* Initialize test
+	 */
+	result = libbde_aes_ni_context_set_key(
+	          &context,
+	          bde_test_aes_ni_key,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbde_aes_ni_crypt_ecb(
+	          &context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          bde_test_aes_ni_plaintext,
+	          16,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          bde_test_aes_ni_ciphertext,
+	          16 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libbde_aes_ni_crypt_ecb(
+	          &context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          data,
+	          16,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          bde_test_aes_ni_plaintext,
+	          16 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_aes_ni_crypt_ecb(
+	          NULL,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          bde_test_aes_ni_plaintext,
+	          16,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_ecb(
+	          &context,
+	          -1,
+	          bde_test_aes_ni_plaintext,
+	          16,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_ecb(
+	          &context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          NULL,
+	          16,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_ecb(
+	          &context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          bde_test_aes_ni_plaintext,
+	          15,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_ecb(
+	          &context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          bde_test_aes_ni_plaintext,
+	          16,
+	          NULL,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_ecb(
+	          &context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          bde_test_aes_ni_plaintext,
+	          16,
+	          data,
+	          8,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_ni_crypt_cbc function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_ni_crypt_cbc(
+     void )
+{
+	uint8_t data[ 16 ];
+	uint8_t initialization_vector[ 16 ] = {
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+	libbde_aes_ni_context_t context;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* The AES-NI functions can only be tested on a CPU that supports them
+	 */
+	if( libbde_aes_ni_is_supported() == 0 )
+	{
+		return( 1 );
+	}
+	/* Initialize test
+	 */
+	result = libbde_aes_ni_context_set_key(
+	          &context,
+	          bde_test_aes_ni_key,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases, with a zero initialization vector a single block
+	 * is equivalent to ECB
+	 */
+	result = libbde_aes_ni_crypt_cbc(
+	          &context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          initialization_vector,
+	          16,
+	          bde_test_aes_ni_plaintext,
+	          16,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          bde_test_aes_ni_ciphertext,
+	          16 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libbde_aes_ni_crypt_cbc(
+	          &context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          initialization_vector,
+	          16,
+	          data,
+	          16,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          bde_test_aes_ni_plaintext,
+	          16 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_aes_ni_crypt_cbc(
+	          NULL,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          initialization_vector,
+	          16,
+	          bde_test_aes_ni_plaintext,
+	          16,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_cbc(
+	          &context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          NULL,
+	          16,
+	          bde_test_aes_ni_plaintext,
+	          16,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_cbc(
+	          &context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          initialization_vector,
+	          8,
+	          bde_test_aes_ni_plaintext,
+	          16,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_cbc(
+	          &context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          initialization_vector,
+	          16,
+	          bde_test_aes_ni_plaintext,
+	          15,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_ni_crypt_xts function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_ni_crypt_xts(
+     void )
+{
+	uint8_t data[ 32 ];
+	uint8_t tweak_value[ 16 ] = {
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+
+	libbde_aes_ni_context_t context;
+	libbde_aes_ni_context_t tweak_context;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* The AES-NI functions can only be tested on a CPU that supports them
+	 */
+	if( libbde_aes_ni_is_supported() == 0 )
+	{
+		return( 1 );
+	}
+	/* Initialize test
+	 */
+	result = libbde_aes_ni_context_set_key(
+	          &context,
+	          bde_test_aes_ni_key,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_ni_context_set_key(
+	          &tweak_context,
+	          bde_test_aes_ni_plaintext,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbde_aes_ni_crypt_xts(
+	          &context,
+	          &tweak_context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          tweak_value,
+	          16,
+	          bde_test_aes_ni_key,
+	          16,
+	          data,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_ni_crypt_xts(
+	          &context,
+	          &tweak_context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          tweak_value,
+	          16,
+	          data,
+	          16,
+	          data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          bde_test_aes_ni_key,
+	          16 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_aes_ni_crypt_xts(
+	          NULL,
+	          &tweak_context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          tweak_value,
+	          16,
+	          bde_test_aes_ni_key,
+	          16,
+	          data,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_xts(
+	          &context,
+	          NULL,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          tweak_value,
+	          16,
+	          bde_test_aes_ni_key,
+	          16,
+	          data,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_xts(
+	          &context,
+	          &tweak_context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          NULL,
+	          16,
+	          bde_test_aes_ni_key,
+	          16,
+	          data,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_xts(
+	          &context,
+	          &tweak_context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          tweak_value,
+	          16,
+	          bde_test_aes_ni_key,
+	          12,
+	          data,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_aes_ni_crypt_xts_sectors function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_aes_ni_crypt_xts_sectors(
+     void )
+{
+	uint8_t data[ 10 * 512 ];
+	uint8_t expected_data[ 10 * 512 ];
+	uint8_t tweak_value[ 16 ];
+
+	libbde_aes_ni_context_t context;
+	libbde_aes_ni_context_t tweak_context;
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	int result               = 0;
+	int sector_index         = 0;
+
+	/* The AES-NI functions can only be tested on a CPU that supports them
+	 */
+	if( libbde_aes_ni_is_supported() == 0 )
+	{
+		return( 1 );
+	}
+	/* Initialize test
+	 */
+	result = libbde_aes_ni_context_set_key(
+	          &context,
+	          bde_test_aes_ni_key,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_aes_ni_context_set_key(
+	          &tweak_context,
+	          bde_test_aes_ni_plaintext,
+	          128,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < 10 * 512;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) data_index;
+	}
+	/* The tweak value of each sector is its sector number
+	 */
+	memory_set(
+	 tweak_value,
+	 0,
+	 16 );
+
+	for( sector_index = 0;
+	     sector_index < 10;
+	     sector_index++ )
+	{
+		tweak_value[ 0 ] = (uint8_t) ( 0x20 + sector_index );
+		tweak_value[ 1 ] = 0x01;
+
+		result = libbde_aes_ni_crypt_xts(
+		          &context,
+		          &tweak_context,
+		          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		          tweak_value,
+		          16,
+		          &( data[ sector_index * 512 ] ),
+		          512,
+		          &( expected_data[ sector_index * 512 ] ),
+		          512,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libbde_aes_ni_crypt_xts_sectors(
+	          &context,
+	          &tweak_context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          0x0120,
+	          512,
+	          data,
+	          10 * 512,
+	          data,
+	          10 * 512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          expected_data,
+	          10 * 512 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libbde_aes_ni_crypt_xts_sectors(
+	          &context,
+	          &tweak_context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          0x0120,
+	          512,
+	          data,
+	          10 * 512,
+	          data,
+	          10 * 512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < 10 * 512;
+	     data_index++ )
+	{
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "data[ data_index ]",
+		 (int) data[ data_index ],
+		 (int) (uint8_t) data_index );
+	}
+	/* Test error cases
+	 */
+	result = libbde_aes_ni_crypt_xts_sectors(
+	          NULL,
+	          &tweak_context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          0x0120,
+	          512,
+	          data,
+	          10 * 512,
+	          data,
+	          10 * 512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_xts_sectors(
+	          &context,
+	          &tweak_context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          0x0120,
+	          500,
+	          data,
+	          10 * 500,
+	          data,
+	          10 * 500,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_aes_ni_crypt_xts_sectors(
+	          &context,
+	          &tweak_context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          0x0120,
+	          512,
+	          data,
+	          10 * 512 - 16,
+	          data,
+	          10 * 512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && defined( HAVE_LIBBDE_AES_NI ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && defined( HAVE_LIBBDE_AES_NI )
+
+	BDE_TEST_RUN(
+	 "libbde_aes_ni_is_supported",
+	 bde_test_aes_ni_is_supported );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_ni_self_test",
+	 bde_test_aes_ni_self_test );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_ni_context_set_key",
+	 bde_test_aes_ni_context_set_key );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_ni_context_clear",
+	 bde_test_aes_ni_context_clear );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_ni_crypt_ecb",
+	 bde_test_aes_ni_crypt_ecb );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_ni_crypt_cbc",
+	 bde_test_aes_ni_crypt_cbc );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_ni_crypt_xts",
+	 bde_test_aes_ni_crypt_xts );
+
+	BDE_TEST_RUN(
+	 "libbde_aes_ni_crypt_xts_sectors",
+	 bde_test_aes_ni_crypt_xts_sectors );
+
+#endif /* defined( __GNUC__ ) && defined( HAVE_LIBBDE_AES_NI ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
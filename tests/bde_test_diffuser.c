@@ -0,0 +1,631 @@
+/*
+ * Library diffuser functions testing program
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_memory.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_definitions.h"
+#include "../libbde/libbde_diffuser.h"
+#include "../libbde/libbde_diffuser_avx2.h"
+
+#if defined( __GNUC__ )
+
+uint8_t bde_test_diffuser_plaintext[ 32 ] = {
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+	0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e, 0x1f };
+
+uint8_t bde_test_diffuser_decrypted[ 32 ] = {
+	0x4b, 0xef, 0x74, 0x5d, 0xfc, 0xb8, 0xf7, 0x20, 0xe8, 0x66, 0x64, 0xbe, 0x28, 0x6b, 0x40, 0x5e,
+	0x3f, 0x73, 0x11, 0xab, 0xd5, 0x1b, 0x36, 0xe8, 0xf6, 0x98, 0xc7, 0xef, 0x86, 0x55, 0xba, 0x90 };
+
+/* Tests the libbde_diffuser_decrypt function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_diffuser_decrypt(
+     void )
+{
+	uint32_t data_32bit[ 9 ];
+	uint8_t sector_key_data[ 32 ];
+
+	libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
+	size_t data_index        = 0;
+	int result               = 0;
+
+	/* Test regular cases with aligned data
+	 */
+	data = (uint8_t *) data_32bit;
+
+	memory_copy(
+	 data,
+	 bde_test_diffuser_plaintext,
+	 32 );
+
+	result = libbde_diffuser_decrypt(
+	          data,
+	          32,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          bde_test_diffuser_decrypted,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test regular cases with unaligned data
+	 */
+	data = &( ( (uint8_t *) data_32bit )[ 1 ] );
+
+	memory_copy(
+	 data,
+	 bde_test_diffuser_plaintext,
+	 32 );
+
+	result = libbde_diffuser_decrypt(
+	          data,
+	          32,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          bde_test_diffuser_decrypted,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test regular cases with a sector key
+	 */
+	for( data_index = 0;
+	     data_index < 32;
+	     data_index++ )
+	{
+		sector_key_data[ data_index ] = (uint8_t) ( 0xa5 ^ data_index );
+	}
+	data = (uint8_t *) data_32bit;
+
+	memory_copy(
+	 data,
+	 bde_test_diffuser_plaintext,
+	 32 );
+
+	result = libbde_diffuser_decrypt(
+	          data,
+	          32,
+	          sector_key_data,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < 32;
+	     data_index++ )
+	{
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "data[ data_index ]",
+		 (int) data[ data_index ],
+		 (int) ( bde_test_diffuser_decrypted[ data_index ] ^ sector_key_data[ data_index ] ) );
+	}
+	result = libbde_diffuser_encrypt(
+	          data,
+	          32,
+	          sector_key_data,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          bde_test_diffuser_plaintext,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_diffuser_decrypt(
+	          NULL,
+	          32,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_diffuser_decrypt(
+	          data,
+	          32,
+	          sector_key_data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_diffuser_encrypt function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_diffuser_encrypt(
+     void )
+{
+	uint32_t data_32bit[ 9 ];
+
+	libcerror_error_t *error = NULL;
+	uint8_t *data            = NULL;
+	int result               = 0;
+
+	/* Test regular cases with aligned data
+	 */
+	data = (uint8_t *) data_32bit;
+
+	memory_copy(
+	 data,
+	 bde_test_diffuser_decrypted,
+	 32 );
+
+	result = libbde_diffuser_encrypt(
+	          data,
+	          32,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          bde_test_diffuser_plaintext,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test regular cases with unaligned data
+	 */
+	data = &( ( (uint8_t *) data_32bit )[ 1 ] );
+
+	memory_copy(
+	 data,
+	 bde_test_diffuser_decrypted,
+	 32 );
+
+	result = libbde_diffuser_encrypt(
+	          data,
+	          32,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          bde_test_diffuser_plaintext,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_diffuser_encrypt(
+	          NULL,
+	          32,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_LIBBDE_DIFFUSER_AVX2 )
+
+/* Tests the libbde_diffuser_avx2_decrypt_sectors and libbde_diffuser_avx2_encrypt_sectors functions
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_diffuser_avx2_crypt_sectors(
+     void )
+{
+	uint8_t data[ 8 * 512 ];
+	uint8_t expected_data[ 8 * 512 ];
+	uint8_t sector_keys[ 8 * 32 ];
+	uint8_t values_buffer[ LIBBDE_DIFFUSER_AVX2_VALUES_BUFFER_SIZE( 512 ) ];
+
+	libcerror_error_t *error = NULL;
+	size_t data_index        = 0;
+	int result               = 0;
+	int sector_index         = 0;
+
+	/* The AVX2 functions can only be tested on a CPU that supports them
+	 */
+	if( libbde_diffuser_avx2_is_supported() == 0 )
+	{
+		return( 1 );
+	}
+	for( data_index = 0;
+	     data_index < 8 * 512;
+	     data_index++ )
+	{
+		data[ data_index ] = (uint8_t) ( data_index * 13 );
+	}
+	for( data_index = 0;
+	     data_index < 8 * 32;
+	     data_index++ )
+	{
+		sector_keys[ data_index ] = (uint8_t) ( data_index * 7 );
+	}
+	memory_copy(
+	 expected_data,
+	 data,
+	 8 * 512 );
+
+	for( sector_index = 0;
+	     sector_index < 8;
+	     sector_index++ )
+	{
+		result = libbde_diffuser_decrypt(
+		          &( expected_data[ sector_index * 512 ] ),
+		          512,
+		          &( sector_keys[ sector_index * 32 ] ),
+		          32,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test regular cases
+	 */
+	result = libbde_diffuser_avx2_decrypt_sectors(
+	          data,
+	          8 * 512,
+	          512,
+	          sector_keys,
+	          8 * 32,
+	          values_buffer,
+	          LIBBDE_DIFFUSER_AVX2_VALUES_BUFFER_SIZE( 512 ),
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          expected_data,
+	          8 * 512 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libbde_diffuser_avx2_encrypt_sectors(
+	          data,
+	          8 * 512,
+	          512,
+	          sector_keys,
+	          8 * 32,
+	          values_buffer,
+	          LIBBDE_DIFFUSER_AVX2_VALUES_BUFFER_SIZE( 512 ),
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < 8 * 512;
+	     data_index++ )
+	{
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "data[ data_index ]",
+		 (int) data[ data_index ],
+		 (int) (uint8_t) ( data_index * 13 ) );
+	}
+	/* Test error cases
+	 */
+	result = libbde_diffuser_avx2_decrypt_sectors(
+	          data,
+	          4 * 512,
+	          512,
+	          sector_keys,
+	          8 * 32,
+	          values_buffer,
+	          LIBBDE_DIFFUSER_AVX2_VALUES_BUFFER_SIZE( 512 ),
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_diffuser_avx2_decrypt_sectors(
+	          data,
+	          8 * 500,
+	          500,
+	          sector_keys,
+	          8 * 32,
+	          values_buffer,
+	          LIBBDE_DIFFUSER_AVX2_VALUES_BUFFER_SIZE( 512 ),
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_diffuser_avx2_decrypt_sectors(
+	          data,
+	          8 * 512,
+	          512,
+	          sector_keys,
+	          8 * 32,
+	          NULL,
+	          LIBBDE_DIFFUSER_AVX2_VALUES_BUFFER_SIZE( 512 ),
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_diffuser_avx2_decrypt_sectors(
+	          data,
+	          8 * 512,
+	          512,
+	          sector_keys,
+	          8 * 32,
+	          values_buffer,
+	          8 * 512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_LIBBDE_DIFFUSER_AVX2 ) */
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_diffuser_decrypt",
+	 bde_test_diffuser_decrypt );
+
+	BDE_TEST_RUN(
+	 "libbde_diffuser_encrypt",
+	 bde_test_diffuser_encrypt );
+
+#if defined( HAVE_LIBBDE_DIFFUSER_AVX2 )
+
+	BDE_TEST_RUN(
+	 "libbde_diffuser_avx2_crypt_sectors",
+	 bde_test_diffuser_avx2_crypt_sectors );
+
+#endif /* defined( HAVE_LIBBDE_DIFFUSER_AVX2 ) */
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
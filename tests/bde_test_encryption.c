@@ -0,0 +1,1998 @@
+/*
+ * Library encryption functions testing program
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_memory.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_definitions.h"
+#include "../libbde/libbde_encryption.h"
+
+#if defined( __GNUC__ )
+
+/* The keys of IEEE 1619-2007 XTS-AES test vector 10, of which the first
+ * 16 bytes are the keys of XTS-AES test vector 4
+ */
+uint8_t bde_test_encryption_key1[ 32 ] = {
+	0x27, 0x18, 0x28, 0x18, 0x28, 0x45, 0x90, 0x45, 0x23, 0x53, 0x60, 0x28, 0x74, 0x71, 0x35, 0x26,
+	0x62, 0x49, 0x77, 0x57, 0x24, 0x70, 0x93, 0x69, 0x99, 0x59, 0x57, 0x49, 0x66, 0x96, 0x76, 0x27 };
+
+uint8_t bde_test_encryption_key2[ 32 ] = {
+	0x31, 0x41, 0x59, 0x26, 0x53, 0x58, 0x97, 0x93, 0x23, 0x84, 0x62, 0x64, 0x33, 0x83, 0x27, 0x95,
+	0x02, 0x88, 0x41, 0x97, 0x16, 0x93, 0x99, 0x37, 0x51, 0x05, 0x82, 0x09, 0x74, 0x94, 0x45, 0x92 };
+
+/* IEEE 1619-2007 XTS-AES-128 test vector 4, data unit sequence number 0
+ */
+uint8_t bde_test_encryption_aes_128_xts_ciphertext[ 512 ] = {
+	0x27, 0xa7, 0x47, 0x9b, 0xef, 0xa1, 0xd4, 0x76, 0x48, 0x9f, 0x30, 0x8c, 0xd4, 0xcf, 0xa6, 0xe2,
+	0xa9, 0x6e, 0x4b, 0xbe, 0x32, 0x08, 0xff, 0x25, 0x28, 0x7d, 0xd3, 0x81, 0x96, 0x16, 0xe8, 0x9c,
+	0xc7, 0x8c, 0xf7, 0xf5, 0xe5, 0x43, 0x44, 0x5f, 0x83, 0x33, 0xd8, 0xfa, 0x7f, 0x56, 0x00, 0x00,
+	0x05, 0x27, 0x9f, 0xa5, 0xd8, 0xb5, 0xe4, 0xad, 0x40, 0xe7, 0x36, 0xdd, 0xb4, 0xd3, 0x54, 0x12,
+	0x32, 0x80, 0x63, 0xfd, 0x2a, 0xab, 0x53, 0xe5, 0xea, 0x1e, 0x0a, 0x9f, 0x33, 0x25, 0x00, 0xa5,
+	0xdf, 0x94, 0x87, 0xd0, 0x7a, 0x5c, 0x92, 0xcc, 0x51, 0x2c, 0x88, 0x66, 0xc7, 0xe8, 0x60, 0xce,
+	0x93, 0xfd, 0xf1, 0x66, 0xa2, 0x49, 0x12, 0xb4, 0x22, 0x97, 0x61, 0x46, 0xae, 0x20, 0xce, 0x84,
+	0x6b, 0xb7, 0xdc, 0x9b, 0xa9, 0x4a, 0x76, 0x7a, 0xae, 0xf2, 0x0c, 0x0d, 0x61, 0xad, 0x02, 0x65,
+	0x5e, 0xa9, 0x2d, 0xc4, 0xc4, 0xe4, 0x1a, 0x89, 0x52, 0xc6, 0x51, 0xd3, 0x31, 0x74, 0xbe, 0x51,
+	0xa1, 0x0c, 0x42, 0x11, 0x10, 0xe6, 0xd8, 0x15, 0x88, 0xed, 0xe8, 0x21, 0x03, 0xa2, 0x52, 0xd8,
+	0xa7, 0x50, 0xe8, 0x76, 0x8d, 0xef, 0xff, 0xed, 0x91, 0x22, 0x81, 0x0a, 0xae, 0xb9, 0x9f, 0x91,
+	0x72, 0xaf, 0x82, 0xb6, 0x04, 0xdc, 0x4b, 0x8e, 0x51, 0xbc, 0xb0, 0x82, 0x35, 0xa6, 0xf4, 0x34,
+	0x13, 0x32, 0xe4, 0xca, 0x60, 0x48, 0x2a, 0x4b, 0xa1, 0xa0, 0x3b, 0x3e, 0x65, 0x00, 0x8f, 0xc5,
+	0xda, 0x76, 0xb7, 0x0b, 0xf1, 0x69, 0x0d, 0xb4, 0xea, 0xe2, 0x9c, 0x5f, 0x1b, 0xad, 0xd0, 0x3c,
+	0x5c, 0xcf, 0x2a, 0x55, 0xd7, 0x05, 0xdd, 0xcd, 0x86, 0xd4, 0x49, 0x51, 0x1c, 0xeb, 0x7e, 0xc3,
+	0x0b, 0xf1, 0x2b, 0x1f, 0xa3, 0x5b, 0x91, 0x3f, 0x9f, 0x74, 0x7a, 0x8a, 0xfd, 0x1b, 0x13, 0x0e,
+	0x94, 0xbf, 0xf9, 0x4e, 0xff, 0xd0, 0x1a, 0x91, 0x73, 0x5c, 0xa1, 0x72, 0x6a, 0xcd, 0x0b, 0x19,
+	0x7c, 0x4e, 0x5b, 0x03, 0x39, 0x36, 0x97, 0xe1, 0x26, 0x82, 0x6f, 0xb6, 0xbb, 0xde, 0x8e, 0xcc,
+	0x1e, 0x08, 0x29, 0x85, 0x16, 0xe2, 0xc9, 0xed, 0x03, 0xff, 0x3c, 0x1b, 0x78, 0x60, 0xf6, 0xde,
+	0x76, 0xd4, 0xce, 0xcd, 0x94, 0xc8, 0x11, 0x98, 0x55, 0xef, 0x52, 0x97, 0xca, 0x67, 0xe9, 0xf3,
+	0xe7, 0xff, 0x72, 0xb1, 0xe9, 0x97, 0x85, 0xca, 0x0a, 0x7e, 0x77, 0x20, 0xc5, 0xb3, 0x6d, 0xc6,
+	0xd7, 0x2c, 0xac, 0x95, 0x74, 0xc8, 0xcb, 0xbc, 0x2f, 0x80, 0x1e, 0x23, 0xe5, 0x6f, 0xd3, 0x44,
+	0xb0, 0x7f, 0x22, 0x15, 0x4b, 0xeb, 0xa0, 0xf0, 0x8c, 0xe8, 0x89, 0x1e, 0x64, 0x3e, 0xd9, 0x95,
+	0xc9, 0x4d, 0x9a, 0x69, 0xc9, 0xf1, 0xb5, 0xf4, 0x99, 0x02, 0x7a, 0x78, 0x57, 0x2a, 0xee, 0xbd,
+	0x74, 0xd2, 0x0c, 0xc3, 0x98, 0x81, 0xc2, 0x13, 0xee, 0x77, 0x0b, 0x10, 0x10, 0xe4, 0xbe, 0xa7,
+	0x18, 0x84, 0x69, 0x77, 0xae, 0x11, 0x9f, 0x7a, 0x02, 0x3a, 0xb5, 0x8c, 0xca, 0x0a, 0xd7, 0x52,
+	0xaf, 0xe6, 0x56, 0xbb, 0x3c, 0x17, 0x25, 0x6a, 0x9f, 0x6e, 0x9b, 0xf1, 0x9f, 0xdd, 0x5a, 0x38,
+	0xfc, 0x82, 0xbb, 0xe8, 0x72, 0xc5, 0x53, 0x9e, 0xdb, 0x60, 0x9e, 0xf4, 0xf7, 0x9c, 0x20, 0x3e,
+	0xbb, 0x14, 0x0f, 0x2e, 0x58, 0x3c, 0xb2, 0xad, 0x15, 0xb4, 0xaa, 0x5b, 0x65, 0x50, 0x16, 0xa8,
+	0x44, 0x92, 0x77, 0xdb, 0xd4, 0x77, 0xef, 0x2c, 0x8d, 0x6c, 0x01, 0x7d, 0xb7, 0x38, 0xb1, 0x8d,
+	0xeb, 0x4a, 0x42, 0x7d, 0x19, 0x23, 0xce, 0x3f, 0xf2, 0x62, 0x73, 0x57, 0x79, 0xa4, 0x18, 0xf2,
+	0x0a, 0x28, 0x2d, 0xf9, 0x20, 0x14, 0x7b, 0xea, 0xbe, 0x42, 0x1e, 0xe5, 0x31, 0x9d, 0x05, 0x68 };
+
+/* IEEE 1619-2007 XTS-AES-256 test vector 10, data unit sequence number 0xff
+ */
+uint8_t bde_test_encryption_aes_256_xts_ciphertext[ 512 ] = {
+	0x1c, 0x3b, 0x3a, 0x10, 0x2f, 0x77, 0x03, 0x86, 0xe4, 0x83, 0x6c, 0x99, 0xe3, 0x70, 0xcf, 0x9b,
+	0xea, 0x00, 0x80, 0x3f, 0x5e, 0x48, 0x23, 0x57, 0xa4, 0xae, 0x12, 0xd4, 0x14, 0xa3, 0xe6, 0x3b,
+	0x5d, 0x31, 0xe2, 0x76, 0xf8, 0xfe, 0x4a, 0x8d, 0x66, 0xb3, 0x17, 0xf9, 0xac, 0x68, 0x3f, 0x44,
+	0x68, 0x0a, 0x86, 0xac, 0x35, 0xad, 0xfc, 0x33, 0x45, 0xbe, 0xfe, 0xcb, 0x4b, 0xb1, 0x88, 0xfd,
+	0x57, 0x76, 0x92, 0x6c, 0x49, 0xa3, 0x09, 0x5e, 0xb1, 0x08, 0xfd, 0x10, 0x98, 0xba, 0xec, 0x70,
+	0xaa, 0xa6, 0x69, 0x99, 0xa7, 0x2a, 0x82, 0xf2, 0x7d, 0x84, 0x8b, 0x21, 0xd4, 0xa7, 0x41, 0xb0,
+	0xc5, 0xcd, 0x4d, 0x5f, 0xff, 0x9d, 0xac, 0x89, 0xae, 0xba, 0x12, 0x29, 0x61, 0xd0, 0x3a, 0x75,
+	0x71, 0x23, 0xe9, 0x87, 0x0f, 0x8a, 0xcf, 0x10, 0x00, 0x02, 0x08, 0x87, 0x89, 0x14, 0x29, 0xca,
+	0x2a, 0x3e, 0x7a, 0x7d, 0x7d, 0xf7, 0xb1, 0x03, 0x55, 0x16, 0x5c, 0x8b, 0x9a, 0x6d, 0x0a, 0x7d,
+	0xe8, 0xb0, 0x62, 0xc4, 0x50, 0x0d, 0xc4, 0xcd, 0x12, 0x0c, 0x0f, 0x74, 0x18, 0xda, 0xe3, 0xd0,
+	0xb5, 0x78, 0x1c, 0x34, 0x80, 0x3f, 0xa7, 0x54, 0x21, 0xc7, 0x90, 0xdf, 0xe1, 0xde, 0x18, 0x34,
+	0xf2, 0x80, 0xd7, 0x66, 0x7b, 0x32, 0x7f, 0x6c, 0x8c, 0xd7, 0x55, 0x7e, 0x12, 0xac, 0x3a, 0x0f,
+	0x93, 0xec, 0x05, 0xc5, 0x2e, 0x04, 0x93, 0xef, 0x31, 0xa1, 0x2d, 0x3d, 0x92, 0x60, 0xf7, 0x9a,
+	0x28, 0x9d, 0x6a, 0x37, 0x9b, 0xc7, 0x0c, 0x50, 0x84, 0x14, 0x73, 0xd1, 0xa8, 0xcc, 0x81, 0xec,
+	0x58, 0x3e, 0x96, 0x45, 0xe0, 0x7b, 0x8d, 0x96, 0x70, 0x65, 0x5b, 0xa5, 0xbb, 0xcf, 0xec, 0xc6,
+	0xdc, 0x39, 0x66, 0x38, 0x0a, 0xd8, 0xfe, 0xcb, 0x17, 0xb6, 0xba, 0x02, 0x46, 0x9a, 0x02, 0x0a,
+	0x84, 0xe1, 0x8e, 0x8f, 0x84, 0x25, 0x20, 0x70, 0xc1, 0x3e, 0x9f, 0x1f, 0x28, 0x9b, 0xe5, 0x4f,
+	0xbc, 0x48, 0x14, 0x57, 0x77, 0x8f, 0x61, 0x60, 0x15, 0xe1, 0x32, 0x7a, 0x02, 0xb1, 0x40, 0xf1,
+	0x50, 0x5e, 0xb3, 0x09, 0x32, 0x6d, 0x68, 0x37, 0x8f, 0x83, 0x74, 0x59, 0x5c, 0x84, 0x9d, 0x84,
+	0xf4, 0xc3, 0x33, 0xec, 0x44, 0x23, 0x88, 0x51, 0x43, 0xcb, 0x47, 0xbd, 0x71, 0xc5, 0xed, 0xae,
+	0x9b, 0xe6, 0x9a, 0x2f, 0xfe, 0xce, 0xb1, 0xbe, 0xc9, 0xde, 0x24, 0x4f, 0xbe, 0x15, 0x99, 0x2b,
+	0x11, 0xb7, 0x7c, 0x04, 0x0f, 0x12, 0xbd, 0x8f, 0x6a, 0x97, 0x5a, 0x44, 0xa0, 0xf9, 0x0c, 0x29,
+	0xa9, 0xab, 0xc3, 0xd4, 0xd8, 0x93, 0x92, 0x72, 0x84, 0xc5, 0x87, 0x54, 0xcc, 0xe2, 0x94, 0x52,
+	0x9f, 0x86, 0x14, 0xdc, 0xd2, 0xab, 0xa9, 0x91, 0x92, 0x5f, 0xed, 0xc4, 0xae, 0x74, 0xff, 0xac,
+	0x6e, 0x33, 0x3b, 0x93, 0xeb, 0x4a, 0xff, 0x04, 0x79, 0xda, 0x9a, 0x41, 0x0e, 0x44, 0x50, 0xe0,
+	0xdd, 0x7a, 0xe4, 0xc6, 0xe2, 0x91, 0x09, 0x00, 0x57, 0x5d, 0xa4, 0x01, 0xfc, 0x07, 0x05, 0x9f,
+	0x64, 0x5e, 0x8b, 0x7e, 0x9b, 0xfd, 0xef, 0x33, 0x94, 0x30, 0x54, 0xff, 0x84, 0x01, 0x14, 0x93,
+	0xc2, 0x7b, 0x34, 0x29, 0xea, 0xed, 0xb4, 0xed, 0x53, 0x76, 0x44, 0x1a, 0x77, 0xed, 0x43, 0x85,
+	0x1a, 0xd7, 0x7f, 0x16, 0xf5, 0x41, 0xdf, 0xd2, 0x69, 0xd5, 0x0d, 0x6a, 0x5f, 0x14, 0xfb, 0x0a,
+	0xab, 0x1c, 0xbb, 0x4c, 0x15, 0x50, 0xbe, 0x97, 0xf7, 0xab, 0x40, 0x66, 0x19, 0x3c, 0x4c, 0xaa,
+	0x77, 0x3d, 0xad, 0x38, 0x01, 0x4b, 0xd2, 0x09, 0x2f, 0xa7, 0x55, 0xc8, 0x24, 0xbb, 0x5e, 0x54,
+	0xc4, 0xf3, 0x6f, 0xfd, 0xa9, 0xfc, 0xea, 0x70, 0xb9, 0xc6, 0xe6, 0x93, 0xe1, 0x48, 0xc1, 0x51 };
+
+/* The AES-CBC and AES-CBC with Elephant diffuser test vectors use key1 as FVEK,
+ * key2 as TWEAK key and block key 0x10000
+ */
+uint8_t bde_test_encryption_aes_128_cbc_ciphertext[ 512 ] = {
+	0xac, 0xf0, 0x1d, 0xa7, 0x59, 0x64, 0x17, 0x4a, 0x71, 0x63, 0xe6, 0x98, 0x6f, 0xd7, 0x77, 0x16,
+	0x17, 0x03, 0x8d, 0x9b, 0x59, 0xa8, 0x99, 0x1d, 0x7f, 0xc1, 0x4e, 0x6c, 0xc7, 0x9b, 0xc8, 0x2c,
+	0x85, 0x9d, 0x18, 0xbb, 0x8e, 0xf8, 0x75, 0xd8, 0x40, 0xde, 0x66, 0x81, 0xb7, 0xba, 0x44, 0xfe,
+	0x13, 0xf0, 0x28, 0x4d, 0xe7, 0xbb, 0x75, 0xfb, 0x61, 0x66, 0xe9, 0xbd, 0x6e, 0xf5, 0x2b, 0xb9,
+	0x16, 0xd4, 0xf6, 0xbd, 0x2e, 0x3a, 0x51, 0x06, 0x3d, 0x31, 0x75, 0x7e, 0x69, 0x11, 0xd1, 0x1b,
+	0xe5, 0xeb, 0x80, 0x52, 0x61, 0x26, 0x79, 0x1a, 0x2c, 0x8a, 0x5c, 0x95, 0x93, 0x39, 0x87, 0x41,
+	0x30, 0x37, 0x7f, 0x1b, 0x66, 0x1e, 0xcc, 0xed, 0x49, 0x27, 0xf5, 0xd2, 0x00, 0x58, 0x77, 0x55,
+	0x31, 0xdc, 0x00, 0x8c, 0x75, 0xb8, 0x23, 0xc6, 0xba, 0x4c, 0x51, 0xde, 0x6c, 0xb9, 0x56, 0x4e,
+	0xe2, 0x0b, 0xd3, 0x39, 0xf5, 0x5c, 0xe6, 0x07, 0xb3, 0xb4, 0x5c, 0x79, 0x1f, 0xae, 0x25, 0xa5,
+	0x37, 0xc7, 0x41, 0x60, 0x07, 0x22, 0xa8, 0xf8, 0x63, 0x45, 0xdb, 0xd1, 0x32, 0x02, 0xcd, 0xa6,
+	0x55, 0x49, 0xeb, 0x1f, 0x5f, 0x33, 0x74, 0xb2, 0x9c, 0x95, 0xe4, 0x31, 0x45, 0xb5, 0x40, 0xd8,
+	0x32, 0xb2, 0x5a, 0x35, 0x79, 0x08, 0x6b, 0xb2, 0xe2, 0x20, 0x32, 0x04, 0x88, 0x61, 0x2b, 0x95,
+	0x3c, 0x4c, 0xc1, 0xdd, 0x6a, 0x16, 0x91, 0x68, 0x69, 0x5d, 0xb5, 0xad, 0xb3, 0xe7, 0xc7, 0x3d,
+	0x5c, 0x94, 0x94, 0x3c, 0x18, 0x1b, 0x85, 0x54, 0x0b, 0x29, 0xdf, 0x7b, 0x70, 0xe5, 0x79, 0x6c,
+	0x34, 0x32, 0x40, 0x3d, 0xec, 0x70, 0x28, 0x3b, 0xb5, 0x8c, 0x93, 0x92, 0xec, 0x9d, 0x46, 0xd1,
+	0x87, 0x2e, 0xe2, 0xc4, 0x4c, 0xc7, 0x4b, 0xb7, 0x11, 0x94, 0x76, 0x75, 0xc8, 0x92, 0x3e, 0x77,
+	0x1f, 0x86, 0xd6, 0x6d, 0xd7, 0x0d, 0xff, 0x30, 0xbc, 0x2b, 0x24, 0xa7, 0x70, 0xc2, 0x4f, 0x43,
+	0xa9, 0x16, 0xb2, 0x68, 0x8e, 0x74, 0x51, 0x40, 0xe8, 0xf5, 0x82, 0x4b, 0xd2, 0x35, 0x4a, 0x6a,
+	0x72, 0x99, 0x01, 0x73, 0xc9, 0xd5, 0x4c, 0xea, 0x0a, 0x3b, 0x27, 0x17, 0x9d, 0x7d, 0x1f, 0x0e,
+	0x81, 0x08, 0x85, 0xd4, 0x26, 0xc5, 0xb5, 0x1c, 0xa8, 0x54, 0xe2, 0x10, 0xa1, 0x08, 0xb0, 0xd9,
+	0x68, 0x76, 0xfd, 0xa5, 0x1b, 0xac, 0x9a, 0x1d, 0x8f, 0x88, 0xa2, 0x46, 0x00, 0xe5, 0x83, 0xa3,
+	0x23, 0xc6, 0x4b, 0x20, 0x19, 0x48, 0x6d, 0x95, 0x57, 0x1d, 0x22, 0x22, 0xdb, 0xe9, 0x64, 0x18,
+	0x68, 0xa7, 0xd3, 0x15, 0x33, 0xe0, 0xb7, 0x08, 0xe6, 0xf9, 0xd4, 0x8c, 0x74, 0xa7, 0x87, 0xc3,
+	0x5c, 0x87, 0xec, 0xf3, 0x7a, 0x7e, 0x51, 0xff, 0xba, 0xcc, 0x31, 0xb7, 0x51, 0x89, 0xd5, 0x95,
+	0x20, 0x46, 0x63, 0xd1, 0x63, 0x82, 0x05, 0xde, 0xc3, 0x95, 0x38, 0x0b, 0xc0, 0xac, 0x32, 0x85,
+	0x98, 0xcd, 0x40, 0x3c, 0x6f, 0x7a, 0xa2, 0x94, 0xa8, 0x35, 0xb5, 0xee, 0xb2, 0xfd, 0xc6, 0x2f,
+	0x2a, 0xc0, 0xfb, 0x87, 0xb4, 0x24, 0x6a, 0xe1, 0x43, 0x5c, 0xe2, 0x25, 0x8f, 0xe3, 0x3b, 0x64,
+	0x3c, 0x4c, 0x43, 0xb5, 0x40, 0x83, 0x8a, 0x92, 0xec, 0x4c, 0x59, 0xf1, 0x6e, 0xef, 0x2f, 0xec,
+	0x7b, 0xac, 0xa7, 0x6d, 0x90, 0x8b, 0x67, 0x5d, 0x48, 0xa3, 0xd0, 0x4e, 0xc4, 0xfa, 0x68, 0xcf,
+	0x8e, 0x09, 0x5a, 0x16, 0xfa, 0x5f, 0x07, 0x5c, 0x2f, 0xc2, 0x16, 0x2d, 0x50, 0x22, 0xca, 0x5e,
+	0xdb, 0x75, 0xa5, 0xdc, 0x41, 0x46, 0x37, 0xad, 0xad, 0x1a, 0x86, 0x10, 0xb1, 0xa1, 0xe9, 0x2a,
+	0xb8, 0xc5, 0xf0, 0x46, 0xf8, 0x23, 0x0b, 0x30, 0x07, 0x51, 0xe9, 0xd0, 0xda, 0xe9, 0xc7, 0x25 };
+
+uint8_t bde_test_encryption_aes_256_cbc_ciphertext[ 512 ] = {
+	0x61, 0x54, 0xad, 0x5f, 0x5c, 0x6b, 0x39, 0x76, 0x37, 0x85, 0x72, 0x52, 0xa4, 0xc9, 0x5d, 0x90,
+	0x70, 0x36, 0xc5, 0x9b, 0xf6, 0x5c, 0x53, 0x9d, 0x87, 0x68, 0x3b, 0x87, 0x2a, 0x5f, 0x27, 0xfd,
+	0x75, 0x48, 0x76, 0x25, 0x9a, 0x15, 0x4f, 0x33, 0x46, 0xd5, 0x57, 0xc4, 0x04, 0x5f, 0xb2, 0x38,
+	0xc1, 0xb0, 0xf5, 0x0a, 0xbb, 0xf7, 0xb1, 0x50, 0xb3, 0xe8, 0x79, 0xc2, 0x5b, 0x4a, 0x8c, 0x91,
+	0x63, 0x8f, 0x5b, 0x89, 0xe1, 0xbc, 0x47, 0x2e, 0xeb, 0xd6, 0x46, 0xce, 0x34, 0xe9, 0x34, 0x59,
+	0xb5, 0x7d, 0x59, 0x12, 0x32, 0x9c, 0xba, 0xf1, 0xc1, 0x59, 0xe7, 0x83, 0x83, 0xa7, 0x48, 0xdc,
+	0x63, 0xaa, 0x0e, 0x4a, 0x20, 0x89, 0x0e, 0x39, 0xe3, 0x45, 0xd5, 0x48, 0xd1, 0xba, 0xa8, 0xc3,
+	0x66, 0x01, 0xe4, 0xe9, 0xe4, 0x73, 0x66, 0x80, 0x3a, 0x2c, 0x20, 0x1d, 0x8a, 0xd1, 0x82, 0x31,
+	0xa8, 0x9e, 0x4b, 0x1c, 0x4c, 0xd9, 0x9c, 0x5a, 0xc1, 0xe5, 0x87, 0x66, 0x3e, 0x38, 0x6c, 0x25,
+	0x70, 0x46, 0x1a, 0x07, 0x8f, 0x77, 0x08, 0x22, 0x52, 0x37, 0x63, 0x8e, 0x67, 0xc1, 0x0e, 0xb2,
+	0x2c, 0x48, 0xbc, 0xc6, 0x51, 0x78, 0x84, 0xaa, 0xe3, 0xba, 0x3f, 0xe4, 0x82, 0x42, 0x54, 0x8c,
+	0x95, 0xc2, 0x0e, 0x49, 0x6c, 0x7a, 0x2b, 0xe3, 0x71, 0xff, 0xcc, 0xa6, 0xad, 0x95, 0x70, 0x63,
+	0x17, 0xad, 0x04, 0x81, 0x09, 0xa6, 0xea, 0x83, 0xf6, 0xc7, 0x12, 0x88, 0xf9, 0x86, 0xb2, 0x9e,
+	0xea, 0x5f, 0xce, 0x99, 0x92, 0xb4, 0x04, 0x9b, 0x20, 0x4f, 0xd6, 0x0e, 0xeb, 0x31, 0xeb, 0xae,
+	0x72, 0x81, 0x1d, 0x8d, 0xa9, 0xda, 0x73, 0xe1, 0xff, 0x86, 0x54, 0x1a, 0xaa, 0xf5, 0xe5, 0x14,
+	0xdd, 0xc9, 0x1f, 0x5f, 0x5c, 0x08, 0xef, 0xfa, 0x2a, 0xe4, 0xe4, 0x6d, 0x42, 0x60, 0x7e, 0x37,
+	0xa3, 0x17, 0x83, 0x76, 0x10, 0x39, 0xf5, 0x13, 0x5a, 0xdd, 0xc7, 0xe4, 0xec, 0x0f, 0x6b, 0xbf,
+	0x4f, 0x5e, 0x00, 0xea, 0x8a, 0x3f, 0x0a, 0x1a, 0x6b, 0x73, 0x77, 0x8b, 0x9e, 0x00, 0xee, 0x66,
+	0x2c, 0x7c, 0xcd, 0x14, 0xb8, 0xe2, 0x50, 0x52, 0xbd, 0xf2, 0x16, 0x6f, 0xe4, 0xa3, 0x13, 0xa0,
+	0x1b, 0x5b, 0x55, 0xcb, 0x0a, 0x02, 0xcc, 0x3b, 0x04, 0x83, 0xdd, 0x2d, 0xad, 0x83, 0x5c, 0xa1,
+	0x9e, 0xef, 0x6b, 0x7b, 0xd0, 0x67, 0xc4, 0x32, 0xce, 0xda, 0x4f, 0x18, 0xc7, 0xd3, 0xc1, 0xd6,
+	0x27, 0x4f, 0x5c, 0x7b, 0xd8, 0xe1, 0x66, 0xb4, 0xa4, 0xa9, 0x90, 0x65, 0xd3, 0x9d, 0xac, 0x4e,
+	0x83, 0xc0, 0x20, 0xa9, 0x25, 0x3d, 0x1b, 0x53, 0x43, 0x76, 0xcb, 0x3f, 0x20, 0x6f, 0x30, 0x2d,
+	0x43, 0xee, 0xa4, 0x24, 0x19, 0xa3, 0xa2, 0xed, 0x6e, 0x8c, 0xaa, 0x78, 0x64, 0x64, 0x75, 0x7d,
+	0x52, 0x0e, 0x39, 0x40, 0xed, 0x66, 0xe4, 0x2b, 0x5d, 0xa0, 0x21, 0x21, 0x8a, 0xbc, 0x78, 0x91,
+	0x81, 0x89, 0x0f, 0xf5, 0x5e, 0x40, 0xc4, 0xe0, 0xe5, 0x8e, 0x96, 0x64, 0xe7, 0xa9, 0x03, 0xfc,
+	0x44, 0xd9, 0x77, 0x74, 0xe2, 0x30, 0xd1, 0x2f, 0x3b, 0x0c, 0xf4, 0x4e, 0xdc, 0xd1, 0x8b, 0x5c,
+	0x5a, 0xf1, 0xfa, 0x7b, 0x77, 0x5d, 0x9c, 0x70, 0x26, 0x94, 0x24, 0x7d, 0x55, 0x7c, 0x55, 0xb7,
+	0x39, 0x2c, 0x8e, 0x7a, 0x53, 0x0f, 0xfe, 0x6b, 0x16, 0x3b, 0x5b, 0xf2, 0xaa, 0x4f, 0x5b, 0xb6,
+	0x93, 0xe5, 0xf1, 0x21, 0x85, 0xc2, 0xf2, 0x7a, 0x93, 0x3c, 0x05, 0xf2, 0xe4, 0x79, 0xd1, 0xfd,
+	0x34, 0xed, 0x3e, 0x26, 0x8e, 0x68, 0xad, 0x0c, 0x27, 0x08, 0xe2, 0x70, 0x18, 0x81, 0x11, 0x2b,
+	0xcf, 0xa3, 0x7e, 0x43, 0xb5, 0x90, 0xb1, 0xd1, 0x70, 0xce, 0x0c, 0x7a, 0x89, 0x3e, 0xc4, 0xfc };
+
+uint8_t bde_test_encryption_aes_128_cbc_diffuser_ciphertext[ 512 ] = {
+	0x57, 0xaa, 0xfe, 0x42, 0x9a, 0x73, 0xeb, 0x6f, 0x05, 0xb5, 0x43, 0xb2, 0x91, 0xaa, 0xd8, 0xb7,
+	0xc6, 0x2b, 0xc5, 0x60, 0xa4, 0xb9, 0xb7, 0x05, 0x48, 0xe5, 0xcd, 0x72, 0x14, 0xe0, 0x4b, 0x0c,
+	0xdd, 0x76, 0x00, 0x3a, 0x6f, 0x55, 0xe3, 0x17, 0x89, 0x53, 0xb6, 0x94, 0xd1, 0x1d, 0x28, 0xc3,
+	0x1e, 0x7f, 0x71, 0xbf, 0xda, 0x2f, 0x83, 0x74, 0x15, 0xeb, 0x03, 0x38, 0x9f, 0xe7, 0xf3, 0x84,
+	0x6d, 0x3c, 0x90, 0xeb, 0x1b, 0x70, 0x04, 0xf1, 0x8d, 0x83, 0x28, 0x91, 0x7b, 0x8c, 0x5e, 0xa3,
+	0x88, 0x00, 0x03, 0xca, 0x7f, 0x68, 0x85, 0xfe, 0xb0, 0x6f, 0x73, 0x48, 0xf0, 0xd7, 0x8d, 0x8b,
+	0xe1, 0x34, 0xbb, 0x0f, 0x0f, 0x4d, 0x6a, 0x86, 0x61, 0x42, 0x59, 0x71, 0x04, 0xf9, 0xd1, 0xbe,
+	0x8f, 0x54, 0xdc, 0x15, 0xd3, 0x0f, 0xff, 0xf1, 0xd1, 0x34, 0x87, 0xb5, 0xe3, 0xff, 0xb8, 0x1a,
+	0xc6, 0x9d, 0x30, 0xd3, 0x56, 0x1a, 0xce, 0x4f, 0xc7, 0x77, 0x1e, 0xd2, 0x41, 0x94, 0xda, 0x5d,
+	0xff, 0xb3, 0xea, 0x0b, 0x1e, 0xe9, 0xb1, 0x38, 0x92, 0xf9, 0x88, 0x6c, 0x09, 0x83, 0x84, 0xf3,
+	0x87, 0x20, 0x03, 0xaf, 0xec, 0x52, 0x42, 0xee, 0xed, 0x13, 0x65, 0x3c, 0x33, 0x99, 0xfd, 0x3a,
+	0xc3, 0x90, 0x7d, 0x25, 0x58, 0x5d, 0x97, 0x2e, 0x43, 0xf5, 0xa6, 0xd7, 0x73, 0x76, 0x72, 0x3b,
+	0xbd, 0xe3, 0x3e, 0x9e, 0x8c, 0xa0, 0x19, 0xc2, 0x8f, 0xf8, 0x0c, 0xb9, 0x15, 0x23, 0x7b, 0x9f,
+	0x83, 0x47, 0x62, 0x2f, 0xdb, 0x7f, 0xe9, 0xec, 0x76, 0xad, 0x64, 0x55, 0x46, 0xc7, 0x84, 0x4b,
+	0x1a, 0x73, 0xd4, 0x06, 0x1b, 0x39, 0xce, 0x9f, 0xa0, 0x87, 0xe1, 0xe6, 0x1a, 0x14, 0xe5, 0x90,
+	0x02, 0xff, 0x1f, 0xf0, 0xc2, 0x19, 0x27, 0x85, 0x39, 0x98, 0xe1, 0xc4, 0xe9, 0x54, 0x55, 0x44,
+	0x28, 0x39, 0xb0, 0x9f, 0x36, 0x08, 0xfd, 0xad, 0xb4, 0xb3, 0x34, 0x62, 0x07, 0x78, 0xb1, 0x57,
+	0x6f, 0xb0, 0xe4, 0x48, 0x5b, 0x6d, 0x63, 0x1c, 0x73, 0xec, 0xa1, 0xae, 0x44, 0x20, 0x01, 0x4b,
+	0xcb, 0x4b, 0x53, 0x26, 0x1d, 0x56, 0xf3, 0x86, 0x09, 0xb7, 0x59, 0x52, 0x02, 0x49, 0xdf, 0xf7,
+	0x40, 0x39, 0xcd, 0x83, 0x2c, 0x5c, 0xbd, 0x45, 0xa9, 0x31, 0xf9, 0x6c, 0xd2, 0x27, 0x07, 0x49,
+	0x41, 0xa2, 0x4e, 0xd0, 0xeb, 0xa1, 0x6b, 0x5a, 0x37, 0x66, 0xe1, 0x84, 0x6f, 0xee, 0x2c, 0xd0,
+	0x90, 0xbe, 0x0d, 0xd8, 0x06, 0x64, 0x3c, 0x70, 0xbb, 0xe7, 0xc6, 0x66, 0x69, 0x71, 0x9b, 0xbc,
+	0x9d, 0x23, 0x8a, 0x7d, 0x60, 0x09, 0x83, 0xa2, 0x39, 0x7e, 0x03, 0x27, 0x55, 0xe4, 0x04, 0xfe,
+	0x79, 0xe6, 0xf6, 0xfb, 0x33, 0x3c, 0x05, 0x4a, 0x46, 0x7e, 0xf4, 0x68, 0x34, 0x3f, 0xcd, 0xd8,
+	0x17, 0x5e, 0xd3, 0xf4, 0xcb, 0xe9, 0x24, 0xd9, 0xb4, 0xad, 0x8b, 0x3f, 0xea, 0x2e, 0x42, 0xe0,
+	0x44, 0xdf, 0x4a, 0x70, 0x1a, 0x26, 0x57, 0xed, 0x3c, 0x0e, 0xbc, 0xd0, 0x48, 0xa5, 0x4a, 0x54,
+	0x20, 0xfc, 0xb3, 0x20, 0xc5, 0xa8, 0xc1, 0x3c, 0x2a, 0x73, 0xbc, 0xf5, 0x80, 0x2b, 0x08, 0x99,
+	0x92, 0x87, 0x62, 0x19, 0x16, 0x97, 0xa1, 0xee, 0x77, 0x91, 0x88, 0x98, 0x23, 0xb2, 0xab, 0xe7,
+	0xb3, 0xc9, 0x19, 0x92, 0x1d, 0x79, 0x20, 0xa7, 0x60, 0xfd, 0xa9, 0x11, 0x16, 0x05, 0xb2, 0xf1,
+	0x39, 0xa7, 0x2f, 0xee, 0x9e, 0x94, 0xf1, 0x36, 0x7e, 0xb2, 0xe8, 0xdf, 0xd6, 0x5f, 0xac, 0xda,
+	0x98, 0x34, 0xfe, 0xc4, 0xbe, 0x1d, 0xf5, 0x7c, 0x1f, 0x5d, 0xad, 0x73, 0xb3, 0x1f, 0xac, 0xd8,
+	0x4d, 0x61, 0x59, 0x9c, 0x26, 0xe7, 0x6e, 0xb8, 0x47, 0x08, 0x59, 0x33, 0x9a, 0x90, 0x4b, 0x8b };
+
+uint8_t bde_test_encryption_aes_256_cbc_diffuser_ciphertext[ 512 ] = {
+	0xbd, 0xd6, 0xb0, 0xf6, 0x2e, 0xab, 0xc8, 0xf7, 0x48, 0x00, 0x69, 0x26, 0x51, 0xd9, 0x26, 0x14,
+	0x02, 0xf5, 0x98, 0x86, 0xdc, 0x11, 0x98, 0xc1, 0x04, 0xdc, 0x68, 0x07, 0x9b, 0x8c, 0xb3, 0x90,
+	0x3f, 0x6d, 0x2a, 0x02, 0xac, 0xee, 0x9c, 0x2d, 0xaa, 0x8a, 0xab, 0x2a, 0xf3, 0xda, 0x05, 0xfe,
+	0x34, 0x6b, 0xc7, 0x16, 0x5d, 0xfc, 0xda, 0xb7, 0xc0, 0x98, 0xe7, 0x0b, 0x60, 0x01, 0xb5, 0xce,
+	0x92, 0x16, 0xb0, 0xac, 0xde, 0x3e, 0x28, 0x0b, 0x8d, 0xbe, 0xe2, 0x4d, 0xd1, 0x4e, 0xf2, 0xd4,
+	0xe5, 0xfa, 0x60, 0xe6, 0x55, 0x74, 0x6a, 0xb1, 0x97, 0xb5, 0x7d, 0x94, 0xaa, 0x2f, 0x5b, 0x95,
+	0x65, 0xf9, 0xce, 0x64, 0xed, 0x9f, 0x91, 0xc5, 0x1e, 0xaa, 0xd3, 0xb5, 0x71, 0x63, 0xf3, 0x59,
+	0x80, 0x75, 0xf6, 0x93, 0x89, 0x17, 0xa9, 0xd1, 0x04, 0x08, 0x3b, 0x8a, 0x6a, 0x85, 0xcc, 0xa7,
+	0xf3, 0x07, 0xad, 0x7e, 0xcc, 0xc6, 0xa7, 0x80, 0x43, 0x12, 0x8f, 0x8c, 0xeb, 0x34, 0x98, 0xcf,
+	0x1c, 0x60, 0x00, 0x75, 0x35, 0x86, 0x41, 0xd4, 0x00, 0x49, 0x45, 0xd2, 0x46, 0xdc, 0xb0, 0xca,
+	0x78, 0x3d, 0x0c, 0x22, 0x30, 0xb3, 0x9f, 0x66, 0xee, 0x67, 0x70, 0x15, 0x8a, 0xae, 0xce, 0x47,
+	0x39, 0xcf, 0xd4, 0x01, 0x5a, 0xb5, 0x8e, 0xde, 0x50, 0x8a, 0x43, 0x75, 0xd1, 0x07, 0xe9, 0xd8,
+	0xc7, 0xf7, 0xec, 0x16, 0xb2, 0xe9, 0xf7, 0xf4, 0x60, 0x27, 0x49, 0x3d, 0x82, 0x88, 0x97, 0x68,
+	0xff, 0xf1, 0x05, 0xc8, 0x16, 0x70, 0x2f, 0xf0, 0x4d, 0x22, 0x94, 0x61, 0xf4, 0x2f, 0xe1, 0xdb,
+	0xab, 0x4b, 0xfa, 0x79, 0xcc, 0xac, 0x45, 0xa4, 0x2a, 0x23, 0x1f, 0xc7, 0xa0, 0xfc, 0xb9, 0xb8,
+	0xe1, 0xea, 0x2e, 0x7a, 0xbf, 0x89, 0x29, 0x2f, 0x22, 0xba, 0xbe, 0x93, 0x0c, 0xb2, 0xc3, 0x60,
+	0xd1, 0x9e, 0x67, 0xfd, 0x98, 0xc6, 0x7c, 0xad, 0x69, 0xa1, 0xd4, 0xa4, 0x18, 0x32, 0xf8, 0xff,
+	0x30, 0xaf, 0x69, 0x37, 0xa8, 0x60, 0x4e, 0xd9, 0xa0, 0xf7, 0xd7, 0xea, 0x89, 0x21, 0x31, 0x05,
+	0xc5, 0x5c, 0x6b, 0x6a, 0x48, 0xdb, 0xe3, 0x2c, 0x70, 0x30, 0xe8, 0xda, 0x3c, 0x99, 0xcf, 0xf6,
+	0x94, 0xcf, 0x2f, 0xdd, 0x25, 0xb5, 0x6f, 0x7a, 0x46, 0x0d, 0x98, 0x88, 0x96, 0x98, 0x3d, 0xa4,
+	0x56, 0x66, 0xae, 0x97, 0xb6, 0xa2, 0x0d, 0x4a, 0xe8, 0xcc, 0x11, 0x9e, 0xb1, 0xc0, 0x23, 0x44,
+	0x49, 0x50, 0xf1, 0x08, 0x48, 0xae, 0xc3, 0x3f, 0x03, 0x9a, 0xbc, 0x1d, 0x55, 0x7d, 0xbe, 0x2d,
+	0x66, 0xae, 0x97, 0xda, 0xf7, 0xd2, 0xd7, 0xd9, 0x1f, 0x29, 0xc3, 0x9a, 0xfb, 0xf7, 0xb6, 0xbb,
+	0xca, 0xdf, 0x21, 0x29, 0xf5, 0xf9, 0x39, 0xdf, 0xa4, 0x96, 0x3f, 0x52, 0x61, 0x50, 0x4d, 0x54,
+	0x72, 0x12, 0x4c, 0x55, 0x12, 0x7b, 0xfb, 0x19, 0x6e, 0xd9, 0x3c, 0xbf, 0x19, 0x67, 0x12, 0xb6,
+	0xa7, 0xc1, 0xc3, 0xe9, 0x84, 0x55, 0x4d, 0x05, 0x14, 0x09, 0x7b, 0x27, 0xa5, 0xaf, 0x06, 0xdf,
+	0x67, 0x4b, 0xb3, 0x7b, 0x41, 0x63, 0xe0, 0x4b, 0x6f, 0x6a, 0xb0, 0x0f, 0xc7, 0x6d, 0xec, 0x98,
+	0x5a, 0xe7, 0xa3, 0x6b, 0xcd, 0x44, 0x4f, 0x9b, 0xf6, 0x04, 0x8b, 0xbd, 0x7d, 0x82, 0x32, 0xfe,
+	0xb3, 0x45, 0x6e, 0x80, 0x65, 0xca, 0x23, 0x52, 0x50, 0x0f, 0x65, 0x19, 0x52, 0x09, 0xfe, 0xd8,
+	0x57, 0xcc, 0x1d, 0x85, 0x54, 0xd0, 0x72, 0xbd, 0xa3, 0xb1, 0x91, 0x7a, 0x45, 0xb2, 0xcf, 0x07,
+	0xc8, 0x1b, 0xd0, 0xeb, 0xc8, 0x13, 0x87, 0x4a, 0x16, 0xb6, 0xb3, 0xd8, 0x2d, 0x83, 0xe5, 0xc5,
+	0xda, 0xc0, 0x13, 0xc2, 0x90, 0x2f, 0x16, 0x08, 0xa7, 0x83, 0x14, 0xe1, 0x12, 0x89, 0x51, 0x0c };
+
+/* The AES-128-CBC initialization vectors and Elephant diffuser sector keys use
+ * key1 as FVEK and key2 as TWEAK key and the block keys 0xfffffc00, 0x100000000
+ * and 0x100001a00, which are the first, third and last sector of a batch that
+ * starts 2 sectors before the block key crosses a 32-bit boundary
+ */
+uint8_t bde_test_encryption_aes_128_cbc_initialization_vectors[ 48 ] = {
+	0x5f, 0x9e, 0x6f, 0x8c, 0x67, 0x34, 0xca, 0x07, 0x7e, 0x87, 0x73, 0xa9, 0xca, 0xed, 0xca, 0xbd,
+	0xa5, 0x1d, 0x10, 0xcd, 0xb1, 0xbd, 0xd1, 0x60, 0x16, 0x29, 0x23, 0xcb, 0xf5, 0x07, 0x75, 0x3c,
+	0xf9, 0xf4, 0x9f, 0x1d, 0x75, 0x35, 0x96, 0x1b, 0xa3, 0x89, 0x53, 0x2a, 0xdf, 0x29, 0x6e, 0xca };
+
+uint8_t bde_test_encryption_aes_128_cbc_diffuser_sector_keys[ 96 ] = {
+	0xbd, 0x76, 0x28, 0x21, 0xb5, 0x2d, 0x68, 0x14, 0xdb, 0x88, 0xbf, 0xb5, 0xc1, 0xac, 0xdf, 0x93,
+	0xdd, 0x10, 0x3f, 0xe1, 0xe1, 0x9a, 0x3a, 0x62, 0x62, 0xde, 0x42, 0xba, 0x6b, 0x63, 0x7e, 0xa1,
+	0x1e, 0x87, 0xc8, 0xa6, 0xaf, 0x30, 0xc8, 0x87, 0xd8, 0x30, 0xb3, 0x39, 0x0d, 0xa6, 0xbb, 0xdc,
+	0xed, 0x39, 0xd7, 0x3b, 0x56, 0xd5, 0x9c, 0x99, 0x83, 0x59, 0x28, 0x32, 0xcd, 0x5b, 0x5c, 0x81,
+	0x1c, 0x7f, 0xab, 0x7f, 0xbc, 0x81, 0xf3, 0x88, 0xc7, 0x05, 0xf6, 0xbc, 0xda, 0x1d, 0x58, 0x5a,
+	0x90, 0xe3, 0x23, 0x55, 0xc6, 0xee, 0x68, 0xf2, 0xdd, 0xe8, 0x99, 0xb4, 0x72, 0x26, 0xa8, 0x95 };
+
+/* Tests the libbde_encryption_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_encryption_initialize(
+     void )
+{
+	libbde_encryption_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	int result                           = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_encryption_initialize(
+	          &context,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_XTS,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_encryption_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_encryption_initialize(
+	          NULL,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_XTS,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	context = (libbde_encryption_context_t *) 0x12345678UL;
+
+	result = libbde_encryption_initialize(
+	          &context,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_XTS,
+	          &error );
+
+	context = NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_initialize(
+	          &context,
+	          0xffff,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_encryption_free function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_encryption_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbde_encryption_free(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_encryption_set_keys function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_encryption_set_keys(
+     void )
+{
+	libbde_encryption_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_encryption_initialize(
+	          &context,
+	          LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbde_encryption_set_keys(
+	          context,
+	          bde_test_encryption_key1,
+	          32,
+	          bde_test_encryption_key2,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_encryption_set_keys(
+	          NULL,
+	          bde_test_encryption_key1,
+	          32,
+	          bde_test_encryption_key2,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_set_keys(
+	          context,
+	          NULL,
+	          32,
+	          bde_test_encryption_key2,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_set_keys(
+	          context,
+	          bde_test_encryption_key1,
+	          16,
+	          bde_test_encryption_key2,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_set_keys(
+	          context,
+	          bde_test_encryption_key1,
+	          32,
+	          NULL,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_set_keys(
+	          context,
+	          bde_test_encryption_key1,
+	          32,
+	          bde_test_encryption_key2,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_encryption_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_encryption_crypt_sectors function with a known answer test vector of a specific method
+ * With XTS the FVEK consists of the first half of key1 and key2 of the key size
+ * otherwise key1 is used as FVEK and key2 as TWEAK key
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_encryption_crypt_sectors_with_method(
+     uint16_t method,
+     size_t key_size,
+     uint64_t block_key,
+     const uint8_t *ciphertext )
+{
+	uint8_t data[ 512 ];
+	uint8_t full_volume_encryption_key[ 64 ];
+	uint8_t plaintext[ 512 ];
+
+	libbde_encryption_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	size_t data_index                    = 0;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	for( data_index = 0;
+	     data_index < 512;
+	     data_index++ )
+	{
+		plaintext[ data_index ] = (uint8_t) data_index;
+	}
+	if( ( method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
+	 || ( method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
+	{
+		memory_copy(
+		 full_volume_encryption_key,
+		 bde_test_encryption_key1,
+		 key_size / 2 );
+
+		memory_copy(
+		 &( full_volume_encryption_key[ key_size / 2 ] ),
+		 bde_test_encryption_key2,
+		 key_size / 2 );
+	}
+	else
+	{
+		memory_copy(
+		 full_volume_encryption_key,
+		 bde_test_encryption_key1,
+		 key_size );
+	}
+	result = libbde_encryption_initialize(
+	          &context,
+	          method,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_encryption_set_keys(
+	          context,
+	          full_volume_encryption_key,
+	          key_size,
+	          bde_test_encryption_key2,
+	          key_size,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test decryption
+	 */
+	result = libbde_encryption_crypt_sectors(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          ciphertext,
+	          512,
+	          data,
+	          512,
+	          block_key,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          plaintext,
+	          512 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test encryption
+	 */
+	result = libbde_encryption_crypt_sectors(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          plaintext,
+	          512,
+	          data,
+	          512,
+	          block_key,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          ciphertext,
+	          512 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test in-place decryption
+	 */
+	result = libbde_encryption_crypt_sectors(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          data,
+	          512,
+	          data,
+	          512,
+	          block_key,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          data,
+	          plaintext,
+	          512 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libbde_encryption_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_encryption_crypt_sectors function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_encryption_crypt_sectors(
+     void )
+{
+	uint8_t data[ 512 ];
+
+	libbde_encryption_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	int result                           = 0;
+
+	/* Test regular cases
+	 */
+	result = bde_test_encryption_crypt_sectors_with_method(
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC,
+	          16,
+	          0x10000,
+	          bde_test_encryption_aes_128_cbc_ciphertext );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = bde_test_encryption_crypt_sectors_with_method(
+	          LIBBDE_ENCRYPTION_METHOD_AES_256_CBC,
+	          32,
+	          0x10000,
+	          bde_test_encryption_aes_256_cbc_ciphertext );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = bde_test_encryption_crypt_sectors_with_method(
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+	          16,
+	          0x10000,
+	          bde_test_encryption_aes_128_cbc_diffuser_ciphertext );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = bde_test_encryption_crypt_sectors_with_method(
+	          LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER,
+	          32,
+	          0x10000,
+	          bde_test_encryption_aes_256_cbc_diffuser_ciphertext );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = bde_test_encryption_crypt_sectors_with_method(
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_XTS,
+	          32,
+	          0,
+	          bde_test_encryption_aes_128_xts_ciphertext );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* With XTS the block key is the offset, which is converted into sector number 0xff
+	 */
+	result = bde_test_encryption_crypt_sectors_with_method(
+	          LIBBDE_ENCRYPTION_METHOD_AES_256_XTS,
+	          64,
+	          0xff * 512,
+	          bde_test_encryption_aes_256_xts_ciphertext );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Initialize test
+	 */
+	result = libbde_encryption_initialize(
+	          &context,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_encryption_crypt_sectors(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          bde_test_encryption_aes_128_cbc_ciphertext,
+	          512,
+	          data,
+	          512,
+	          0x10000,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_set_keys(
+	          context,
+	          bde_test_encryption_key1,
+	          16,
+	          bde_test_encryption_key2,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_encryption_crypt_sectors(
+	          NULL,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          bde_test_encryption_aes_128_cbc_ciphertext,
+	          512,
+	          data,
+	          512,
+	          0x10000,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_crypt_sectors(
+	          context,
+	          -1,
+	          bde_test_encryption_aes_128_cbc_ciphertext,
+	          512,
+	          data,
+	          512,
+	          0x10000,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_crypt_sectors(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          NULL,
+	          512,
+	          data,
+	          512,
+	          0x10000,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_crypt_sectors(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          bde_test_encryption_aes_128_cbc_ciphertext,
+	          512,
+	          NULL,
+	          512,
+	          0x10000,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_crypt_sectors(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          bde_test_encryption_aes_128_cbc_ciphertext,
+	          512,
+	          data,
+	          512,
+	          0x10000,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_crypt_sectors(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          bde_test_encryption_aes_128_cbc_ciphertext,
+	          500,
+	          data,
+	          512,
+	          0x10000,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_crypt_sectors(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          bde_test_encryption_aes_128_cbc_ciphertext,
+	          512,
+	          data,
+	          256,
+	          0x10000,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_encryption_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_encryption_generate_sector_keys function of a specific method
+ * The initialization vectors and sector keys of a batch of sectors are compared
+ * with those generated per sector and with the known answer test vectors
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_encryption_generate_sector_keys_with_method(
+     uint16_t method )
+{
+	uint8_t initialization_vectors[ LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 16 ];
+	uint8_t sector_initialization_vector[ 16 ];
+	uint8_t sector_key[ 32 ];
+	uint8_t sector_keys[ LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 32 ];
+
+	int test_sector_indexes[ 3 ] = {
+		0, 2, LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS - 1 };
+
+	libbde_encryption_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	uint64_t block_key                   = 0xfffffc00UL;
+	int result                           = 0;
+	int sector_index                     = 0;
+	int test_index                       = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_encryption_initialize(
+	          &context,
+	          method,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_encryption_set_keys(
+	          context,
+	          bde_test_encryption_key1,
+	          16,
+	          bde_test_encryption_key2,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a batch of which the block keys cross a 32-bit boundary
+	 */
+	result = libbde_encryption_generate_sector_keys(
+	          context,
+	          block_key,
+	          512,
+	          LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS,
+	          initialization_vectors,
+	          LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 16,
+	          sector_keys,
+	          LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS * 32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( test_index = 0;
+	     test_index < 3;
+	     test_index++ )
+	{
+		sector_index = test_sector_indexes[ test_index ];
+
+		result = memory_compare(
+		          &( initialization_vectors[ sector_index * 16 ] ),
+		          &( bde_test_encryption_aes_128_cbc_initialization_vectors[ test_index * 16 ] ),
+		          16 );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		if( method == LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER )
+		{
+			result = memory_compare(
+			          &( sector_keys[ sector_index * 32 ] ),
+			          &( bde_test_encryption_aes_128_cbc_diffuser_sector_keys[ test_index * 32 ] ),
+			          32 );
+
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+	}
+	/* Test that the batch matches the initialization vectors and sector keys generated per sector
+	 */
+	for( sector_index = 0;
+	     sector_index < LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS;
+	     sector_index++ )
+	{
+		result = libbde_encryption_generate_sector_keys(
+		          context,
+		          block_key + ( (uint64_t) sector_index * 512 ),
+		          512,
+		          1,
+		          sector_initialization_vector,
+		          16,
+		          sector_key,
+		          32,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          &( initialization_vectors[ sector_index * 16 ] ),
+		          sector_initialization_vector,
+		          16 );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		result = memory_compare(
+		          &( sector_keys[ sector_index * 32 ] ),
+		          sector_key,
+		          32 );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Clean up
+	 */
+	result = libbde_encryption_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_encryption_generate_sector_keys function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_encryption_generate_sector_keys(
+     void )
+{
+	uint8_t initialization_vectors[ ( LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS + 1 ) * 16 ];
+	uint8_t sector_keys[ ( LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS + 1 ) * 32 ];
+
+	libbde_encryption_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	int result                           = 0;
+
+	/* Test regular cases
+	 */
+	result = bde_test_encryption_generate_sector_keys_with_method(
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = bde_test_encryption_generate_sector_keys_with_method(
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Initialize test
+	 */
+	result = libbde_encryption_initialize(
+	          &context,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_encryption_generate_sector_keys(
+	          context,
+	          0x10000,
+	          512,
+	          1,
+	          initialization_vectors,
+	          16,
+	          sector_keys,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_set_keys(
+	          context,
+	          bde_test_encryption_key1,
+	          16,
+	          bde_test_encryption_key2,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_encryption_generate_sector_keys(
+	          NULL,
+	          0x10000,
+	          512,
+	          1,
+	          initialization_vectors,
+	          16,
+	          sector_keys,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_generate_sector_keys(
+	          context,
+	          0x10000,
+	          512,
+	          0,
+	          initialization_vectors,
+	          16,
+	          sector_keys,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_generate_sector_keys(
+	          context,
+	          0x10000,
+	          512,
+	          LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS + 1,
+	          initialization_vectors,
+	          ( LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS + 1 ) * 16,
+	          sector_keys,
+	          ( LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS + 1 ) * 32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_generate_sector_keys(
+	          context,
+	          0x10000,
+	          512,
+	          1,
+	          NULL,
+	          16,
+	          sector_keys,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_generate_sector_keys(
+	          context,
+	          0x10000,
+	          512,
+	          2,
+	          initialization_vectors,
+	          16,
+	          sector_keys,
+	          64,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_generate_sector_keys(
+	          context,
+	          0x10000,
+	          512,
+	          1,
+	          initialization_vectors,
+	          16,
+	          NULL,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_encryption_generate_sector_keys(
+	          context,
+	          0x10000,
+	          512,
+	          2,
+	          initialization_vectors,
+	          32,
+	          sector_keys,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_encryption_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_encryption_crypt_sectors function with more sectors than fit in a single batch
+ * With XTS the FVEK consists of the first half of key1 and key2 of the key size
+ * otherwise key1 is used as FVEK and key2 as TWEAK key
+ * The sectors de- or encrypted in a single call are compared with those de- or encrypted per sector
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_encryption_crypt_sectors_batches_with_method(
+     uint16_t method,
+     size_t key_size )
+{
+	uint8_t batch_data[ ( LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS + 2 ) * 512 ];
+	uint8_t full_volume_encryption_key[ 64 ];
+	uint8_t plaintext[ ( LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS + 2 ) * 512 ];
+	uint8_t sector_data[ ( LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS + 2 ) * 512 ];
+
+	libbde_encryption_context_t *context = NULL;
+	libcerror_error_t *error             = NULL;
+	uint64_t block_key                   = 0xfffffc00UL;
+	size_t data_index                    = 0;
+	size_t data_size                     = ( LIBBDE_MAXIMUM_NUMBER_OF_BATCHED_SECTORS + 2 ) * 512;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	for( data_index = 0;
+	     data_index < data_size;
+	     data_index++ )
+	{
+		plaintext[ data_index ] = (uint8_t) ( data_index / 3 );
+	}
+	if( ( method == LIBBDE_ENCRYPTION_METHOD_AES_128_XTS )
+	 || ( method == LIBBDE_ENCRYPTION_METHOD_AES_256_XTS ) )
+	{
+		memory_copy(
+		 full_volume_encryption_key,
+		 bde_test_encryption_key1,
+		 key_size / 2 );
+
+		memory_copy(
+		 &( full_volume_encryption_key[ key_size / 2 ] ),
+		 bde_test_encryption_key2,
+		 key_size / 2 );
+	}
+	else
+	{
+		memory_copy(
+		 full_volume_encryption_key,
+		 bde_test_encryption_key1,
+		 key_size );
+	}
+	result = libbde_encryption_initialize(
+	          &context,
+	          method,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_encryption_set_keys(
+	          context,
+	          full_volume_encryption_key,
+	          key_size,
+	          bde_test_encryption_key2,
+	          key_size,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test encryption
+	 */
+	result = libbde_encryption_crypt_sectors(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+	          plaintext,
+	          data_size,
+	          batch_data,
+	          data_size,
+	          block_key,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( data_index = 0;
+	     data_index < data_size;
+	     data_index += 512 )
+	{
+		result = libbde_encryption_crypt_sectors(
+		          context,
+		          LIBBDE_ENCRYPTION_CRYPT_MODE_ENCRYPT,
+		          &( plaintext[ data_index ] ),
+		          512,
+		          &( sector_data[ data_index ] ),
+		          512,
+		          block_key + (uint64_t) data_index,
+		          512,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = memory_compare(
+	          batch_data,
+	          sector_data,
+	          data_size );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test in-place decryption
+	 */
+	result = libbde_encryption_crypt_sectors(
+	          context,
+	          LIBBDE_ENCRYPTION_CRYPT_MODE_DECRYPT,
+	          batch_data,
+	          data_size,
+	          batch_data,
+	          data_size,
+	          block_key,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          batch_data,
+	          plaintext,
+	          data_size );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libbde_encryption_free(
+	          &context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "context",
+	 context );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( context != NULL )
+	{
+		libbde_encryption_free(
+		 &context,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_encryption_crypt_sectors function with more sectors than fit in a single batch
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_encryption_crypt_sectors_batches(
+     void )
+{
+	int result = 0;
+
+	result = bde_test_encryption_crypt_sectors_batches_with_method(
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC,
+	          16 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = bde_test_encryption_crypt_sectors_batches_with_method(
+	          LIBBDE_ENCRYPTION_METHOD_AES_256_CBC,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = bde_test_encryption_crypt_sectors_batches_with_method(
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+	          16 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = bde_test_encryption_crypt_sectors_batches_with_method(
+	          LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = bde_test_encryption_crypt_sectors_batches_with_method(
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_XTS,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = bde_test_encryption_crypt_sectors_batches_with_method(
+	          LIBBDE_ENCRYPTION_METHOD_AES_256_XTS,
+	          64 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_encryption_initialize",
+	 bde_test_encryption_initialize );
+
+	BDE_TEST_RUN(
+	 "libbde_encryption_free",
+	 bde_test_encryption_free );
+
+	BDE_TEST_RUN(
+	 "libbde_encryption_set_keys",
+	 bde_test_encryption_set_keys );
+
+	BDE_TEST_RUN(
+	 "libbde_encryption_generate_sector_keys",
+	 bde_test_encryption_generate_sector_keys );
+
+	BDE_TEST_RUN(
+	 "libbde_encryption_crypt_sectors",
+	 bde_test_encryption_crypt_sectors );
+
+	BDE_TEST_RUN(
+	 "libbde_encryption_crypt_sectors",
+	 bde_test_encryption_crypt_sectors_batches );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
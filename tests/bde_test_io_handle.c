@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -28,11 +29,13 @@
 #endif
 
 #include "bde_test_libbde.h"
+#include "bde_test_libbfio.h"
 #include "bde_test_libcerror.h"
 #include "bde_test_macros.h"
 #include "bde_test_memory.h"
 #include "bde_test_unused.h"
 
+#include "../libbde/libbde_definitions.h"
 #include "../libbde/libbde_io_handle.h"
 
 #if defined( __GNUC__ )
@@ -232,19 +235,859 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libbde_io_handle_initialize_header_values function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_io_handle_initialize_header_values(
+     void )
+{
+	libbde_io_handle_t io_handle;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 &io_handle,
+	 0xff,
+	 sizeof( libbde_io_handle_t ) );
+
+	/* Test regular cases
+	 */
+	result = libbde_io_handle_initialize_header_values(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "io_handle.version",
+	 io_handle.version,
+	 0 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "io_handle.bytes_per_sector",
+	 (int) io_handle.bytes_per_sector,
+	 512 );
+
+	BDE_TEST_ASSERT_EQUAL_INT64(
+	 "io_handle.first_metadata_offset",
+	 (int64_t) io_handle.first_metadata_offset,
+	 (int64_t) 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+	 "io_handle.encryption_context",
+	 io_handle.encryption_context );
+
+	/* Test error cases
+	 */
+	result = libbde_io_handle_initialize_header_values(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* Tests the libbde_io_handle_free function
  * Returns 1 if successful or 0 if not
  */
-int bde_test_io_handle_free(
+int bde_test_io_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbde_io_handle_free(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_io_handle_set_encryption_keys function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_io_handle_set_encryption_keys(
+     void )
+{
+	uint8_t full_volume_encryption_key[ 32 ] = {
+		0x27, 0x18, 0x28, 0x18, 0x28, 0x45, 0x90, 0x45, 0x23, 0x53, 0x60, 0x28, 0x74, 0x71, 0x35, 0x26,
+		0x31, 0x41, 0x59, 0x26, 0x53, 0x58, 0x97, 0x93, 0x23, 0x84, 0x62, 0x64, 0x33, 0x83, 0x27, 0x95 };
+
+	uint8_t tweak_key[ 32 ] = {
+		0x62, 0x49, 0x77, 0x57, 0x24, 0x70, 0x93, 0x69, 0x99, 0x59, 0x57, 0x49, 0x66, 0x96, 0x76, 0x27,
+		0x02, 0x88, 0x41, 0x97, 0x16, 0x93, 0x99, 0x37, 0x51, 0x05, 0x82, 0x09, 0x74, 0x94, 0x45, 0x92 };
+
+	libbde_encryption_context_t *encryption_context = NULL;
+	libbde_io_handle_t *io_handle                   = NULL;
+	libcerror_error_t *error                        = NULL;
+	int context_index                               = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 * A full volume encryption key that is too small for the encryption method
+	 * must not leave an encryption context behind
+	 */
+	result = libbde_io_handle_set_encryption_keys(
+	          io_handle,
+	          LIBBDE_ENCRYPTION_METHOD_AES_256_XTS,
+	          full_volume_encryption_key,
+	          32,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "io_handle->encryption_context",
+         io_handle->encryption_context );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_io_handle_set_encryption_keys(
+	          io_handle,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+	          full_volume_encryption_key,
+	          16,
+	          tweak_key,
+	          8,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "io_handle->encryption_context",
+         io_handle->encryption_context );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_io_handle_set_encryption_keys(
+	          NULL,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+	          full_volume_encryption_key,
+	          16,
+	          tweak_key,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libbde_io_handle_set_encryption_keys(
+	          io_handle,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+	          full_volume_encryption_key,
+	          16,
+	          tweak_key,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle->encryption_context",
+         io_handle->encryption_context );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_io_handle_grab_encryption_context(
+	          io_handle,
+	          &context_index,
+	          &encryption_context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "encryption_context",
+         encryption_context );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_io_handle_release_encryption_context(
+	          io_handle,
+	          context_index,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 * The encryption keys can only be set once
+	 */
+	result = libbde_io_handle_set_encryption_keys(
+	          io_handle,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+	          full_volume_encryption_key,
+	          16,
+	          tweak_key,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle->encryption_context",
+         io_handle->encryption_context );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_io_handle_grab_encryption_context and libbde_io_handle_release_encryption_context functions
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_io_handle_grab_encryption_context(
+     void )
+{
+	libbde_encryption_context_t *encryption_context = NULL;
+	libbde_io_handle_t *io_handle                   = NULL;
+	libcerror_error_t *error                        = NULL;
+	int context_index                               = 0;
+	int result                                      = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 * Without encryption keys the encryption context of the IO handle is used
+	 */
+	result = libbde_io_handle_grab_encryption_context(
+	          io_handle,
+	          &context_index,
+	          &encryption_context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "context_index",
+	 context_index,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "encryption_context",
+         encryption_context );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_io_handle_release_encryption_context(
+	          io_handle,
+	          context_index,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_io_handle_grab_encryption_context(
+	          NULL,
+	          &context_index,
+	          &encryption_context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_io_handle_grab_encryption_context(
+	          io_handle,
+	          NULL,
+	          &encryption_context,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_io_handle_grab_encryption_context(
+	          io_handle,
+	          &context_index,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_io_handle_release_encryption_context(
+	          NULL,
+	          -1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_io_handle_release_encryption_context(
+	          io_handle,
+	          LIBBDE_NUMBER_OF_CONCURRENT_ENCRYPTION_CONTEXTS,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Reads the volume header from data using a memory range file IO handle
+ * Returns 1 if successful, 0 if the file IO handle could not be opened or -1 on error
+ */
+int bde_test_io_handle_read_volume_header_data(
+     libbde_io_handle_t *io_handle,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	int result                       = 0;
+
+	if( libbfio_memory_range_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_memory_range_set(
+	     file_io_handle,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	result = libbde_io_handle_read_volume_header(
+	          io_handle,
+	          file_io_handle,
+	          0,
+	          error );
+
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     NULL ) != 0 )
+	{
+		result = 0;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     NULL ) != 1 )
+	{
+		result = 0;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_io_handle_read_volume_header function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_io_handle_read_volume_header(
      void )
 {
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	uint8_t volume_header_data[ 512 ];
+
+	uint8_t identifier[ 16 ] = {
+		0x3b, 0xd6, 0x67, 0x49, 0x29, 0x2e, 0xd8, 0x4a, 0x83, 0x99, 0xf6, 0xa3, 0x39, 0xe3, 0xd0, 0x01 };
+
+	libbde_io_handle_t *io_handle = NULL;
+	libcerror_error_t *error      = NULL;
+	void *memcpy_result           = NULL;
+	void *memset_result           = NULL;
+	int result                    = 0;
+
+	/* Initialize test
+	 * A Windows 7 volume header of 65536 sectors of 512 bytes
+	 */
+	memset_result = memory_set(
+	                 volume_header_data,
+	                 0,
+	                 sizeof( uint8_t ) * 512 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "memset_result",
+         memset_result );
+
+	memcpy_result = memory_copy(
+	                 volume_header_data,
+	                 "\xeb\x58\x90-FVE-FS-",
+	                 11 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "memcpy_result",
+         memcpy_result );
+
+	memcpy_result = memory_copy(
+	                 &( volume_header_data[ 160 ] ),
+	                 identifier,
+	                 16 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "memcpy_result",
+         memcpy_result );
+
+	/* The bytes per sector
+	 */
+	volume_header_data[ 12 ] = 0x02;
+
+	/* The sectors per cluster block
+	 */
+	volume_header_data[ 13 ] = 0x08;
+
+	/* The 32-bit total number of sectors
+	 */
+	volume_header_data[ 34 ] = 0x01;
+
+	/* The first, second and third metadata offsets
+	 */
+	volume_header_data[ 178 ] = 0x10;
+	volume_header_data[ 179 ] = 0x02;
+	volume_header_data[ 186 ] = 0x10;
+	volume_header_data[ 187 ] = 0x04;
+	volume_header_data[ 194 ] = 0x10;
+	volume_header_data[ 195 ] = 0x06;
+
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 */
+	result = bde_test_io_handle_read_volume_header_data(
+	          io_handle,
+	          volume_header_data,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "io_handle->version",
+	 io_handle->version,
+	 LIBBDE_VERSION_WINDOWS_7 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "io_handle->bytes_per_sector",
+	 (int) io_handle->bytes_per_sector,
+	 512 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "io_handle->sectors_per_cluster_block",
+	 (int) io_handle->sectors_per_cluster_block,
+	 8 );
+
+	BDE_TEST_ASSERT_EQUAL_INT64(
+	 "io_handle->first_metadata_offset",
+	 (int64_t) io_handle->first_metadata_offset,
+	 (int64_t) 0x02100000L );
+
+	BDE_TEST_ASSERT_EQUAL_INT64(
+	 "io_handle->second_metadata_offset",
+	 (int64_t) io_handle->second_metadata_offset,
+	 (int64_t) 0x04100000L );
+
+	BDE_TEST_ASSERT_EQUAL_INT64(
+	 "io_handle->third_metadata_offset",
+	 (int64_t) io_handle->third_metadata_offset,
+	 (int64_t) 0x06100000L );
+
+	BDE_TEST_ASSERT_EQUAL_INT64(
+	 "io_handle->metadata_size",
+	 (int64_t) io_handle->metadata_size,
+	 (int64_t) 65536 );
+
+	BDE_TEST_ASSERT_EQUAL_INT64(
+	 "io_handle->volume_size",
+	 (int64_t) io_handle->volume_size,
+	 (int64_t) 65536 * 512 );
 
 	/* Test error cases
 	 */
-	result = libbde_io_handle_free(
+	result = libbde_io_handle_read_volume_header(
 	          NULL,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with data too small
+	 */
+	result = bde_test_io_handle_read_volume_header_data(
+	          io_handle,
+	          volume_header_data,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with an invalid signature
+	 */
+	volume_header_data[ 3 ] = (uint8_t) 'X';
+
+	result = bde_test_io_handle_read_volume_header_data(
+	          io_handle,
+	          volume_header_data,
+	          512,
+	          &error );
+
+	volume_header_data[ 3 ] = (uint8_t) '-';
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with an unsupported identifier
+	 */
+	volume_header_data[ 160 ] = 0xff;
+
+	result = bde_test_io_handle_read_volume_header_data(
+	          io_handle,
+	          volume_header_data,
+	          512,
+	          &error );
+
+	volume_header_data[ 160 ] = 0x3b;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with an unsupported volume boot entry point
+	 */
+	volume_header_data[ 1 ] = 0x00;
+
+	result = bde_test_io_handle_read_volume_header_data(
+	          io_handle,
+	          volume_header_data,
+	          512,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -259,6 +1102,25 @@ int bde_test_io_handle_free(
 	libcerror_error_free(
 	 &error );
 
+	/* Clean up
+	 */
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
 	return( 1 );
 
 on_error:
@@ -267,6 +1129,12 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
 	return( 0 );
 }
 
@@ -293,15 +1161,27 @@ int main(
 	 "libbde_io_handle_initialize",
 	 bde_test_io_handle_initialize );
 
+	BDE_TEST_RUN(
+	 "libbde_io_handle_initialize_header_values",
+	 bde_test_io_handle_initialize_header_values );
+
 	BDE_TEST_RUN(
 	 "libbde_io_handle_free",
 	 bde_test_io_handle_free );
 
 	/* TODO: add tests for libbde_io_handle_clear */
 
-	/* TODO: add tests for libbde_io_handle_read_volume_header */
+	BDE_TEST_RUN(
+	 "libbde_io_handle_set_encryption_keys",
+	 bde_test_io_handle_set_encryption_keys );
+
+	BDE_TEST_RUN(
+	 "libbde_io_handle_grab_encryption_context",
+	 bde_test_io_handle_grab_encryption_context );
 
-	/* TODO: add tests for libbde_io_handle_read_sector */
+	BDE_TEST_RUN(
+	 "libbde_io_handle_read_volume_header",
+	 bde_test_io_handle_read_volume_header );
 
 	/* TODO: add tests for libbde_io_handle_read_unencrypted_volume_header */
 
@@ -0,0 +1,1062 @@
+/*
+ * Library keyring type testing program
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_memory.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_definitions.h"
+#include "../libbde/libbde_keyring.h"
+#include "../libbde/libbde_keyring_entry.h"
+
+uint8_t bde_test_keyring_data[ 241 ] = \
+	"# Keyring test data\r\n"
+	"\r\n"
+	"a31a8153-5dc1-4bc3-a5b8-e6d77a17c4c0 fvek 000102030405060708090a0b0c0d0e0f:101112131415161718191a1b1c1d1e1f\r\n"
+	"{E70FAD99-E63F-45C1-92E0-1CADABE08AE9}\tvmk\t202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f\n";
+
+uint8_t bde_test_keyring_volume_identifier1[ 16 ] = {
+	0x53, 0x81, 0x1a, 0xa3, 0xc1, 0x5d, 0xc3, 0x4b, 0xa5, 0xb8, 0xe6, 0xd7, 0x7a, 0x17, 0xc4, 0xc0 };
+
+uint8_t bde_test_keyring_volume_identifier2[ 16 ] = {
+	0x99, 0xad, 0x0f, 0xe7, 0x3f, 0xe6, 0xc1, 0x45, 0x92, 0xe0, 0x1c, 0xad, 0xab, 0xe0, 0x8a, 0xe9 };
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_keyring_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_keyring_initialize(
+     void )
+{
+	libbde_keyring_t *keyring = NULL;
+	libcerror_error_t *error  = NULL;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_keyring_initialize(
+	          &keyring,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "keyring",
+	 keyring );
+
+	result = libbde_keyring_free(
+	          &keyring,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "keyring",
+	 keyring );
+
+	/* Test error cases
+	 */
+	result = libbde_keyring_initialize(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	keyring = (libbde_keyring_t *) 0x12345678UL;
+
+	result = libbde_keyring_initialize(
+	          &keyring,
+	          &error );
+
+	keyring = NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( keyring != NULL )
+	{
+		libbde_keyring_free(
+		 &keyring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_keyring_free function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_keyring_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbde_keyring_free(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_keyring_read_data function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_keyring_read_data(
+     void )
+{
+	libbde_keyring_t *keyring = NULL;
+	libcerror_error_t *error  = NULL;
+	int number_of_entries     = 0;
+	int result                = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_keyring_initialize(
+	          &keyring,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "keyring",
+	 keyring );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbde_keyring_read_data(
+	          keyring,
+	          bde_test_keyring_data,
+	          240,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_keyring_get_number_of_entries(
+	          keyring,
+	          &number_of_entries,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 2 );
+
+	/* Test error cases
+	 */
+	result = libbde_keyring_read_data(
+	          NULL,
+	          bde_test_keyring_data,
+	          240,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_keyring_read_data(
+	          keyring,
+	          NULL,
+	          240,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_keyring_read_data(
+	          keyring,
+	          bde_test_keyring_data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the data is truncated in the middle of a key
+	 */
+	result = libbde_keyring_read_data(
+	          keyring,
+	          bde_test_keyring_data,
+	          100,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_keyring_free(
+	          &keyring,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( keyring != NULL )
+	{
+		libbde_keyring_free(
+		 &keyring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_keyring_get_entry_by_volume_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_keyring_get_entry_by_volume_identifier(
+     void )
+{
+	uint8_t volume_identifier[ 16 ];
+
+	libbde_keyring_t *keyring             = NULL;
+	libbde_keyring_entry_t *keyring_entry = NULL;
+	libcerror_error_t *error              = NULL;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_keyring_initialize(
+	          &keyring,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "keyring",
+	 keyring );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_keyring_read_data(
+	          keyring,
+	          bde_test_keyring_data,
+	          240,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbde_keyring_get_entry_by_volume_identifier(
+	          keyring,
+	          bde_test_keyring_volume_identifier1,
+	          16,
+	          &keyring_entry,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "keyring_entry",
+	 keyring_entry );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "keyring_entry->type",
+	 keyring_entry->type,
+	 LIBBDE_KEYRING_ENTRY_TYPE_FULL_VOLUME_ENCRYPTION_KEY );
+
+	BDE_TEST_ASSERT_EQUAL_SIZE(
+	 "keyring_entry->full_volume_encryption_key_size",
+	 keyring_entry->full_volume_encryption_key_size,
+	 (size_t) 16 );
+
+	BDE_TEST_ASSERT_EQUAL_SIZE(
+	 "keyring_entry->tweak_key_size",
+	 keyring_entry->tweak_key_size,
+	 (size_t) 16 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "keyring_entry->full_volume_encryption_key[ 15 ]",
+	 (int) keyring_entry->full_volume_encryption_key[ 15 ],
+	 0x0f );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "keyring_entry->tweak_key[ 0 ]",
+	 (int) keyring_entry->tweak_key[ 0 ],
+	 0x10 );
+
+	keyring_entry = NULL;
+
+	result = libbde_keyring_get_entry_by_volume_identifier(
+	          keyring,
+	          bde_test_keyring_volume_identifier2,
+	          16,
+	          &keyring_entry,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "keyring_entry",
+	 keyring_entry );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "keyring_entry->type",
+	 keyring_entry->type,
+	 LIBBDE_KEYRING_ENTRY_TYPE_VOLUME_MASTER_KEY );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "keyring_entry->volume_master_key[ 31 ]",
+	 (int) keyring_entry->volume_master_key[ 31 ],
+	 0x3f );
+
+	/* Test regular case where the volume identifier is not in the keyring
+	 */
+	memory_set(
+	 volume_identifier,
+	 0,
+	 16 );
+
+	keyring_entry = NULL;
+
+	result = libbde_keyring_get_entry_by_volume_identifier(
+	          keyring,
+	          volume_identifier,
+	          16,
+	          &keyring_entry,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "keyring_entry",
+	 keyring_entry );
+
+	/* Test error cases
+	 */
+	result = libbde_keyring_get_entry_by_volume_identifier(
+	          NULL,
+	          volume_identifier,
+	          16,
+	          &keyring_entry,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_keyring_get_entry_by_volume_identifier(
+	          keyring,
+	          NULL,
+	          16,
+	          &keyring_entry,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_keyring_get_entry_by_volume_identifier(
+	          keyring,
+	          volume_identifier,
+	          8,
+	          &keyring_entry,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_keyring_get_entry_by_volume_identifier(
+	          keyring,
+	          volume_identifier,
+	          16,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_keyring_free(
+	          &keyring,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( keyring != NULL )
+	{
+		libbde_keyring_free(
+		 &keyring,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_keyring_entry_read_utf8_string function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_keyring_entry_read_utf8_string(
+     void )
+{
+	const char *valid_strings[ 5 ] = {
+		"a31a8153-5dc1-4bc3-a5b8-e6d77a17c4c0 fvek 000102030405060708090a0b0c0d0e0f",
+		"a31a8153-5dc1-4bc3-a5b8-e6d77a17c4c0 fvek 000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f",
+		"a31a8153-5dc1-4bc3-a5b8-e6d77a17c4c0 fvek 000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f",
+		"a31a8153-5dc1-4bc3-a5b8-e6d77a17c4c0 fvek 000102030405060708090a0b0c0d0e0f:101112131415161718191a1b1c1d1e1f",
+		"a31a8153-5dc1-4bc3-a5b8-e6d77a17c4c0 fvek 000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f:202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f" };
+
+	size_t expected_key_sizes[ 5 ]       = { 16, 32, 64, 16, 32 };
+	size_t expected_tweak_key_sizes[ 5 ] = { 0, 0, 0, 16, 32 };
+
+	const char *invalid_strings[ 4 ] = {
+		"a31a8153-5dc1-4bc3-a5b8-e6d77a17c4c0 fvek 000102030405060708090a0b0c0d0e0f1011121314151617",
+		"a31a8153-5dc1-4bc3-a5b8-e6d77a17c4c0 fvek 000102030405060708090a0b0c0d0e0f101112131415161718191a1b1c1d1e1f202122232425262728292a2b2c2d2e2f303132333435363738393a3b3c3d3e3f40",
+		"a31a8153-5dc1-4bc3-a5b8-e6d77a17c4c0 fvek 000102030405060708090a0b0c0d0e0f:1011121314151617",
+		"a31a8153-5dc1-4bc3-a5b8-e6d77a17c4c0 vmk 000102030405060708090a0b0c0d0e0f" };
+
+	libbde_keyring_entry_t *keyring_entry = NULL;
+	libcerror_error_t *error              = NULL;
+	int result                            = 0;
+	int string_index                      = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_keyring_entry_initialize(
+	          &keyring_entry,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "keyring_entry",
+	 keyring_entry );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	for( string_index = 0;
+	     string_index < 5;
+	     string_index++ )
+	{
+		keyring_entry->tweak_key_size = 0;
+
+		result = libbde_keyring_entry_read_utf8_string(
+		          keyring_entry,
+		          (uint8_t *) valid_strings[ string_index ],
+		          narrow_string_length( valid_strings[ string_index ] ),
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "keyring_entry->type",
+		 keyring_entry->type,
+		 LIBBDE_KEYRING_ENTRY_TYPE_FULL_VOLUME_ENCRYPTION_KEY );
+
+		BDE_TEST_ASSERT_EQUAL_SIZE(
+		 "keyring_entry->full_volume_encryption_key_size",
+		 keyring_entry->full_volume_encryption_key_size,
+		 expected_key_sizes[ string_index ] );
+
+		BDE_TEST_ASSERT_EQUAL_SIZE(
+		 "keyring_entry->tweak_key_size",
+		 keyring_entry->tweak_key_size,
+		 expected_tweak_key_sizes[ string_index ] );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "keyring_entry->full_volume_encryption_key[ last ]",
+		 (int) keyring_entry->full_volume_encryption_key[ expected_key_sizes[ string_index ] - 1 ],
+		 (int) expected_key_sizes[ string_index ] - 1 );
+	}
+	/* Test error cases
+	 */
+	for( string_index = 0;
+	     string_index < 4;
+	     string_index++ )
+	{
+		result = libbde_keyring_entry_read_utf8_string(
+		          keyring_entry,
+		          (uint8_t *) invalid_strings[ string_index ],
+		          narrow_string_length( invalid_strings[ string_index ] ),
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		BDE_TEST_ASSERT_EQUAL_SIZE(
+		 "keyring_entry->full_volume_encryption_key_size",
+		 keyring_entry->full_volume_encryption_key_size,
+		 (size_t) 0 );
+	}
+	result = libbde_keyring_entry_read_utf8_string(
+	          NULL,
+	          (uint8_t *) valid_strings[ 0 ],
+	          narrow_string_length( valid_strings[ 0 ] ),
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_keyring_entry_free(
+	          &keyring_entry,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( keyring_entry != NULL )
+	{
+		libbde_keyring_entry_free(
+		 &keyring_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_keyring_entry_check_encryption_method function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_keyring_entry_check_encryption_method(
+     void )
+{
+	uint16_t encryption_methods[ 6 ] = {
+		LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+		LIBBDE_ENCRYPTION_METHOD_AES_256_CBC_DIFFUSER,
+		LIBBDE_ENCRYPTION_METHOD_AES_128_CBC,
+		LIBBDE_ENCRYPTION_METHOD_AES_256_CBC,
+		LIBBDE_ENCRYPTION_METHOD_AES_128_XTS,
+		LIBBDE_ENCRYPTION_METHOD_AES_256_XTS };
+
+	size_t key_sizes[ 6 ]       = { 16, 32, 16, 32, 32, 64 };
+	size_t tweak_key_sizes[ 6 ] = { 16, 32, 0, 0, 0, 0 };
+
+	libbde_keyring_entry_t *keyring_entry = NULL;
+	libcerror_error_t *error              = NULL;
+	int expected_result                   = 0;
+	int key_index                         = 0;
+	int method_index                      = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_keyring_entry_initialize(
+	          &keyring_entry,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "keyring_entry",
+	 keyring_entry );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	keyring_entry->type = LIBBDE_KEYRING_ENTRY_TYPE_FULL_VOLUME_ENCRYPTION_KEY;
+
+	/* Test regular cases
+	 * every key size combination only matches its own encryption method
+	 * except for AES-256-CBC and AES-128-XTS which both use a 32-byte key
+	 */
+	for( key_index = 0;
+	     key_index < 6;
+	     key_index++ )
+	{
+		keyring_entry->full_volume_encryption_key_size = key_sizes[ key_index ];
+		keyring_entry->tweak_key_size                  = tweak_key_sizes[ key_index ];
+
+		for( method_index = 0;
+		     method_index < 6;
+		     method_index++ )
+		{
+			result = libbde_keyring_entry_check_encryption_method(
+			          keyring_entry,
+			          encryption_methods[ method_index ],
+			          &error );
+
+			if( ( key_sizes[ key_index ] == key_sizes[ method_index ] )
+			 && ( tweak_key_sizes[ key_index ] == tweak_key_sizes[ method_index ] ) )
+			{
+				expected_result = 1;
+			}
+			else
+			{
+				expected_result = 0;
+			}
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 expected_result );
+
+			BDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+	}
+	/* Test regular case where an AES-256-XTS volume is given a AES-128-XTS key
+	 */
+	keyring_entry->full_volume_encryption_key_size = 32;
+	keyring_entry->tweak_key_size                  = 0;
+
+	result = libbde_keyring_entry_check_encryption_method(
+	          keyring_entry,
+	          LIBBDE_ENCRYPTION_METHOD_AES_256_XTS,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular case where a diffuser volume is given a key without tweak key
+	 */
+	keyring_entry->full_volume_encryption_key_size = 16;
+	keyring_entry->tweak_key_size                  = 0;
+
+	result = libbde_keyring_entry_check_encryption_method(
+	          keyring_entry,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC_DIFFUSER,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_keyring_entry_check_encryption_method(
+	          NULL,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_keyring_entry_check_encryption_method(
+	          keyring_entry,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	keyring_entry->type = LIBBDE_KEYRING_ENTRY_TYPE_VOLUME_MASTER_KEY;
+
+	result = libbde_keyring_entry_check_encryption_method(
+	          keyring_entry,
+	          LIBBDE_ENCRYPTION_METHOD_AES_128_CBC,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_keyring_entry_free(
+	          &keyring_entry,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( keyring_entry != NULL )
+	{
+		libbde_keyring_entry_free(
+		 &keyring_entry,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_keyring_initialize",
+	 bde_test_keyring_initialize );
+
+	BDE_TEST_RUN(
+	 "libbde_keyring_free",
+	 bde_test_keyring_free );
+
+	BDE_TEST_RUN(
+	 "libbde_keyring_read_data",
+	 bde_test_keyring_read_data );
+
+	BDE_TEST_RUN(
+	 "libbde_keyring_get_entry_by_volume_identifier",
+	 bde_test_keyring_get_entry_by_volume_identifier );
+
+	BDE_TEST_RUN(
+	 "libbde_keyring_entry_read_utf8_string",
+	 bde_test_keyring_entry_read_utf8_string );
+
+	BDE_TEST_RUN(
+	 "libbde_keyring_entry_check_encryption_method",
+	 bde_test_keyring_entry_check_encryption_method );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,579 @@
+/*
+ * Library password_batch type testing program
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_memory.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_password_batch.h"
+#include "../libbde/libbde_volume_master_key.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_password_batch_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_password_batch_initialize(
+     void )
+{
+	libbde_password_batch_t *password_batch = NULL;
+	libcerror_error_t *error                = NULL;
+	int result                              = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_password_batch_initialize(
+	          &password_batch,
+	          9,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "password_batch",
+	 password_batch );
+
+	result = libbde_password_batch_free(
+	          &password_batch,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "password_batch",
+	 password_batch );
+
+	/* Test error cases
+	 */
+	result = libbde_password_batch_initialize(
+	          NULL,
+	          9,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	password_batch = (libbde_password_batch_t *) 0x12345678UL;
+
+	result = libbde_password_batch_initialize(
+	          &password_batch,
+	          9,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	password_batch = NULL;
+
+	result = libbde_password_batch_initialize(
+	          &password_batch,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( password_batch != NULL )
+	{
+		libbde_password_batch_free(
+		 &password_batch,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_password_batch_free function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_password_batch_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbde_password_batch_free(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_password_batch_append_password_hash function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_password_batch_append_password_hash(
+     void )
+{
+	uint8_t password_hash[ 32 ];
+
+	libbde_password_batch_t *password_batch = NULL;
+	libcerror_error_t *error                = NULL;
+	int result                              = 0;
+
+	memory_set(
+	 password_hash,
+	 0xa5,
+	 32 );
+
+	/* Initialize test
+	 */
+	result = libbde_password_batch_initialize(
+	          &password_batch,
+	          1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbde_password_batch_append_password_hash(
+	          password_batch,
+	          3,
+	          password_hash,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "password_batch->number_of_password_hashes",
+	 password_batch->number_of_password_hashes,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "password_batch->password_indexes[ 0 ]",
+	 password_batch->password_indexes[ 0 ],
+	 3 );
+
+	result = memory_compare(
+	          password_batch->password_hashes,
+	          password_hash,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_password_batch_append_password_hash(
+	          password_batch,
+	          4,
+	          password_hash,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	password_batch->number_of_password_hashes = 0;
+
+	result = libbde_password_batch_append_password_hash(
+	          NULL,
+	          4,
+	          password_hash,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_batch_append_password_hash(
+	          password_batch,
+	          4,
+	          NULL,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_batch_append_password_hash(
+	          password_batch,
+	          4,
+	          password_hash,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_password_batch_free(
+	          &password_batch,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( password_batch != NULL )
+	{
+		libbde_password_batch_free(
+		 &password_batch,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_password_batch_test function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_password_batch_test(
+     void )
+{
+	libbde_password_batch_t *password_batch       = NULL;
+	libbde_volume_master_key_t *volume_master_key = NULL;
+	libcerror_error_t *error                      = NULL;
+	int password_index                            = 0;
+	int result                                    = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_password_batch_initialize(
+	          &password_batch,
+	          1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_volume_master_key_initialize(
+	          &volume_master_key,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_password_batch_test(
+	          NULL,
+	          volume_master_key,
+	          0,
+	          &password_index,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_batch_test(
+	          password_batch,
+	          NULL,
+	          0,
+	          &password_index,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test volume master key without a stretch key
+	 */
+	result = libbde_password_batch_test(
+	          password_batch,
+	          volume_master_key,
+	          0,
+	          &password_index,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_volume_master_key_free(
+	          &volume_master_key,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_password_batch_free(
+	          &password_batch,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume_master_key != NULL )
+	{
+		libbde_volume_master_key_free(
+		 &volume_master_key,
+		 NULL );
+	}
+	if( password_batch != NULL )
+	{
+		libbde_password_batch_free(
+		 &password_batch,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_password_batch_initialize",
+	 bde_test_password_batch_initialize );
+
+	BDE_TEST_RUN(
+	 "libbde_password_batch_free",
+	 bde_test_password_batch_free );
+
+	BDE_TEST_RUN(
+	 "libbde_password_batch_append_password_hash",
+	 bde_test_password_batch_append_password_hash );
+
+	BDE_TEST_RUN(
+	 "libbde_password_batch_test",
+	 bde_test_password_batch_test );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,905 @@
+/*
+ * Library password_keep type testing program
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_memory.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_password.h"
+#include "../libbde/libbde_password_keep.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_password_keep_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_password_keep_initialize(
+     void )
+{
+	libbde_password_keep_t *password_keep = NULL;
+	libcerror_error_t *error              = NULL;
+	int result                            = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_password_keep_initialize(
+	          &password_keep,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "password_keep",
+	 password_keep );
+
+	result = libbde_password_keep_free(
+	          &password_keep,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "password_keep",
+	 password_keep );
+
+	/* Test error cases
+	 */
+	result = libbde_password_keep_initialize(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	password_keep = (libbde_password_keep_t *) 0x12345678UL;
+
+	result = libbde_password_keep_initialize(
+	          &password_keep,
+	          &error );
+
+	password_keep = NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( password_keep != NULL )
+	{
+		libbde_password_keep_free(
+		 &password_keep,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_password_keep_free function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_password_keep_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbde_password_keep_free(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_password_keep_get_password_key function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_password_keep_get_password_key(
+     void )
+{
+	uint8_t expected_key[ 32 ];
+	uint8_t key[ 32 ];
+	uint8_t salt[ 16 ];
+
+	libbde_password_keep_t *password_keep = NULL;
+	libcerror_error_t *error              = NULL;
+	size_t byte_index                     = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_password_keep_initialize(
+	          &password_keep,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( byte_index = 0;
+	     byte_index < 32;
+	     byte_index++ )
+	{
+		password_keep->password_hash[ byte_index ] = (uint8_t) ( byte_index * 3 + 1 );
+	}
+	for( byte_index = 0;
+	     byte_index < 16;
+	     byte_index++ )
+	{
+		salt[ byte_index ] = (uint8_t) ( 0xa0 + byte_index );
+	}
+	/* Test error cases
+	 */
+	result = libbde_password_keep_get_password_key(
+	          password_keep,
+	          salt,
+	          16,
+	          key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	password_keep->password_is_set = 1;
+
+	/* Test regular cases
+	 */
+	result = libbde_password_calculate_key(
+	          password_keep->password_hash,
+	          32,
+	          salt,
+	          16,
+	          expected_key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_password_keep_get_password_key(
+	          password_keep,
+	          salt,
+	          16,
+	          key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "password_keep->password_key_is_set",
+	 (int) password_keep->password_key_is_set,
+	 1 );
+
+	result = memory_compare(
+	          key,
+	          expected_key,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test that the stretched key is reused for the same salt
+	 */
+	password_keep->password_key[ 0 ] ^= 0xff;
+	expected_key[ 0 ] ^= 0xff;
+
+	result = libbde_password_keep_get_password_key(
+	          password_keep,
+	          salt,
+	          16,
+	          key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          key,
+	          expected_key,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test that the stretched key is recalculated for another salt
+	 */
+	salt[ 0 ] ^= 0xff;
+
+	result = libbde_password_calculate_key(
+	          password_keep->password_hash,
+	          32,
+	          salt,
+	          16,
+	          expected_key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_password_keep_get_password_key(
+	          password_keep,
+	          salt,
+	          16,
+	          key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          key,
+	          expected_key,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_password_keep_get_password_key(
+	          NULL,
+	          salt,
+	          16,
+	          key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_keep_get_password_key(
+	          password_keep,
+	          NULL,
+	          16,
+	          key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_keep_get_password_key(
+	          password_keep,
+	          salt,
+	          8,
+	          key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_keep_get_password_key(
+	          password_keep,
+	          salt,
+	          16,
+	          NULL,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_keep_get_password_key(
+	          password_keep,
+	          salt,
+	          16,
+	          key,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_password_keep_free(
+	          &password_keep,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( password_keep != NULL )
+	{
+		libbde_password_keep_free(
+		 &password_keep,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_password_keep_start_recovery_password_key and
+ * libbde_password_keep_stop_recovery_password_key functions
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_password_keep_start_recovery_password_key(
+     void )
+{
+	uint8_t expected_recovery_key[ 32 ];
+	uint8_t recovery_key[ 32 ];
+	uint8_t recovery_salt[ 16 ];
+
+	libbde_password_keep_t *password_keep = NULL;
+	libcerror_error_t *error              = NULL;
+	size_t byte_index                     = 0;
+	int result                            = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_password_keep_initialize(
+	          &password_keep,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( byte_index = 0;
+	     byte_index < 32;
+	     byte_index++ )
+	{
+		password_keep->recovery_password_hash[ byte_index ] = (uint8_t) ( byte_index * 5 + 7 );
+	}
+	for( byte_index = 0;
+	     byte_index < 16;
+	     byte_index++ )
+	{
+		recovery_salt[ byte_index ] = (uint8_t) ( 0x30 + byte_index );
+	}
+	/* Test error case where the recovery password is not set
+	 */
+	result = libbde_password_keep_start_recovery_password_key(
+	          password_keep,
+	          recovery_salt,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	password_keep->recovery_password_is_set = 1;
+
+	result = libbde_password_calculate_key(
+	          password_keep->recovery_password_hash,
+	          32,
+	          recovery_salt,
+	          16,
+	          expected_recovery_key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular case where the calculation is aborted
+	 */
+	result = libbde_password_keep_start_recovery_password_key(
+	          password_keep,
+	          recovery_salt,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_password_keep_stop_recovery_password_key(
+	          password_keep,
+	          1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "password_keep->recovery_password_key_is_set",
+	 (int) password_keep->recovery_password_key_is_set,
+	 0 );
+
+	/* The aborted key is calculated when it is retrieved
+	 */
+	result = libbde_password_keep_get_recovery_password_key(
+	          password_keep,
+	          recovery_salt,
+	          16,
+	          recovery_key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          recovery_key,
+	          expected_recovery_key,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test regular case where the calculation is finished
+	 */
+	password_keep->recovery_password_key_is_set = 0;
+
+	result = libbde_password_keep_start_recovery_password_key(
+	          password_keep,
+	          recovery_salt,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_password_keep_stop_recovery_password_key(
+	          password_keep,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_password_keep_get_recovery_password_key(
+	          password_keep,
+	          recovery_salt,
+	          16,
+	          recovery_key,
+	          32,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          recovery_key,
+	          expected_recovery_key,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test regular case where the key was previously calculated for the salt
+	 */
+	result = libbde_password_keep_start_recovery_password_key(
+	          password_keep,
+	          recovery_salt,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_password_keep_stop_recovery_password_key(
+	          password_keep,
+	          1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "password_keep->recovery_password_key_is_set",
+	 (int) password_keep->recovery_password_key_is_set,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libbde_password_keep_start_recovery_password_key(
+	          NULL,
+	          recovery_salt,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_keep_start_recovery_password_key(
+	          password_keep,
+	          NULL,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_keep_start_recovery_password_key(
+	          password_keep,
+	          recovery_salt,
+	          8,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_password_keep_stop_recovery_password_key(
+	          NULL,
+	          1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_password_keep_free(
+	          &password_keep,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( password_keep != NULL )
+	{
+		libbde_password_keep_free(
+		 &password_keep,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_password_keep_initialize",
+	 bde_test_password_keep_initialize );
+
+	BDE_TEST_RUN(
+	 "libbde_password_keep_free",
+	 bde_test_password_keep_free );
+
+	BDE_TEST_RUN(
+	 "libbde_password_keep_get_password_key",
+	 bde_test_password_keep_get_password_key );
+
+	BDE_TEST_RUN(
+	 "libbde_password_keep_start_recovery_password_key",
+	 bde_test_password_keep_start_recovery_password_key );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1511 @@
+/*
+ * Library read_ahead type testing program
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libbfio.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_libcthreads.h"
+#include "bde_test_macros.h"
+#include "bde_test_memory.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_definitions.h"
+#include "../libbde/libbde_io_handle.h"
+#include "../libbde/libbde_read_ahead.h"
+#include "../libbde/libbde_sector_cache.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_read_ahead_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_read_ahead_initialize(
+     void )
+{
+	libbde_io_handle_t *io_handle       = NULL;
+	libbde_read_ahead_t *read_ahead     = NULL;
+	libbde_sector_cache_t *sector_cache = NULL;
+	libcerror_error_t *error            = NULL;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_sector_cache_initialize(
+	          &sector_cache,
+	          io_handle->block_size,
+	          65536,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "sector_cache",
+         sector_cache );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 */
+	result = libbde_read_ahead_initialize(
+	          &read_ahead,
+	          io_handle,
+	          NULL,
+	          sector_cache,
+	          8,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "read_ahead",
+         read_ahead );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_read_ahead_free(
+	          &read_ahead,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "read_ahead",
+         read_ahead );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_read_ahead_initialize(
+	          NULL,
+	          io_handle,
+	          NULL,
+	          sector_cache,
+	          8,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_ahead = (libbde_read_ahead_t *) 0x12345678UL;
+
+	result = libbde_read_ahead_initialize(
+	          &read_ahead,
+	          io_handle,
+	          NULL,
+	          sector_cache,
+	          8,
+	          &error );
+
+	read_ahead = NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_read_ahead_initialize(
+	          &read_ahead,
+	          NULL,
+	          NULL,
+	          sector_cache,
+	          8,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_read_ahead_initialize(
+	          &read_ahead,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          8,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_read_ahead_initialize(
+	          &read_ahead,
+	          io_handle,
+	          NULL,
+	          sector_cache,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_sector_cache_free(
+	          &sector_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_ahead != NULL )
+	{
+		libbde_read_ahead_free(
+		 &read_ahead,
+		 NULL );
+	}
+	if( sector_cache != NULL )
+	{
+		libbde_sector_cache_free(
+		 &sector_cache,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_read_ahead_free function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_read_ahead_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbde_read_ahead_free(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Opens a memory range file IO handle of data
+ * Returns 1 if successful or -1 on error
+ */
+int bde_test_read_ahead_open_file_io_handle(
+     libbfio_handle_t **file_io_handle,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	if( libbfio_memory_range_initialize(
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_memory_range_set(
+	     *file_io_handle,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     *file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the libbde_read_ahead_schedule_run function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_read_ahead_schedule_run(
+     void )
+{
+	uint8_t block_data[ 4096 ];
+
+	libbde_io_handle_t *io_handle       = NULL;
+	libbde_read_ahead_t *read_ahead     = NULL;
+	libbde_sector_cache_t *sector_cache = NULL;
+	libbfio_handle_t *file_io_handle    = NULL;
+	libcerror_error_t *error            = NULL;
+	uint8_t *volume_data                = NULL;
+	size_t data_offset                  = 0;
+	int number_of_pending_runs          = 0;
+	int result                          = 0;
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	off64_t block_offset                = 0;
+#endif
+
+	/* Initialize test
+	 * A volume of 128 KiB of which the data from offset 32 KiB up to 64 KiB is unencrypted
+	 */
+	volume_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * 0x00020000 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "volume_data",
+         volume_data );
+
+	for( data_offset = 0;
+	     data_offset < 0x00020000;
+	     data_offset++ )
+	{
+		volume_data[ data_offset ] = (uint8_t) ( data_offset % 251 );
+	}
+	result = bde_test_read_ahead_open_file_io_handle(
+	          &file_io_handle,
+	          volume_data,
+	          0x00020000,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "file_io_handle",
+         file_io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	io_handle->version                = LIBBDE_VERSION_WINDOWS_7;
+	io_handle->bytes_per_sector       = 512;
+	io_handle->first_metadata_offset  = 0x00010000;
+	io_handle->second_metadata_offset = 0x00010000;
+	io_handle->third_metadata_offset  = 0x00010000;
+	io_handle->metadata_size          = 65536;
+	io_handle->volume_header_offset   = 0x00010000;
+	io_handle->volume_header_size     = 8192;
+	io_handle->encrypted_volume_size  = 0x00008000;
+	io_handle->volume_size            = 0x00020000;
+
+	result = libbde_sector_cache_initialize(
+	          &sector_cache,
+	          io_handle->block_size,
+	          1048576,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_read_ahead_initialize(
+	          &read_ahead,
+	          io_handle,
+	          file_io_handle,
+	          sector_cache,
+	          4,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 */
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	result = libcthreads_mutex_grab(
+	          read_ahead->mutex,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+#endif
+	result = libbde_read_ahead_schedule_run(
+	          read_ahead,
+	          0x00008000,
+	          0x00004000,
+	          &error );
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	libcthreads_mutex_release(
+	 read_ahead->mutex,
+	 NULL );
+
+	/* The run is read into the sector cache by a worker thread
+	 */
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	do
+	{
+		result = libcthreads_mutex_grab(
+		          read_ahead->mutex,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		number_of_pending_runs = read_ahead->number_of_pending_runs;
+
+		libcthreads_mutex_release(
+		 read_ahead->mutex,
+		 NULL );
+	}
+	while( number_of_pending_runs > 0 );
+
+	for( block_offset = 0x00008000;
+	     block_offset < 0x0000c000;
+	     block_offset += 4096 )
+	{
+		result = libbde_sector_cache_get_data(
+		          sector_cache,
+		          block_offset,
+		          0,
+		          block_data,
+		          4096,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        BDE_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+
+		result = memory_compare(
+		          block_data,
+		          &( volume_data[ block_offset ] ),
+		          4096 );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+#else
+	/* Without multi-threading support no runs are scheduled
+	 */
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_sector_cache_get_data(
+	          sector_cache,
+	          0x00008000,
+	          0,
+	          block_data,
+	          4096,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+#endif
+	/* No run is scheduled when the maximum number of pending runs was reached
+	 */
+	number_of_pending_runs             = read_ahead->number_of_pending_runs;
+	read_ahead->number_of_pending_runs = read_ahead->maximum_number_of_pending_runs;
+
+	result = libbde_read_ahead_schedule_run(
+	          read_ahead,
+	          0x0000c000,
+	          0x00004000,
+	          &error );
+
+	read_ahead->number_of_pending_runs = number_of_pending_runs;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_read_ahead_schedule_run(
+	          NULL,
+	          0x00008000,
+	          0x00004000,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_read_ahead_free(
+	          &read_ahead,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_sector_cache_free(
+	          &sector_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	memory_free(
+	 volume_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_ahead != NULL )
+	{
+		libbde_read_ahead_free(
+		 &read_ahead,
+		 NULL );
+	}
+	if( sector_cache != NULL )
+	{
+		libbde_sector_cache_free(
+		 &sector_cache,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( volume_data != NULL )
+	{
+		memory_free(
+		 volume_data );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_read_ahead_notify_read function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_read_ahead_notify_read(
+     void )
+{
+	libbde_io_handle_t *io_handle       = NULL;
+	libbde_read_ahead_t *read_ahead     = NULL;
+	libbde_sector_cache_t *sector_cache = NULL;
+	libcerror_error_t *error            = NULL;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* The blocks read ahead are in the metadata which is zero-ed
+	 * without reading from the file IO handle
+	 */
+	io_handle->version                = LIBBDE_VERSION_WINDOWS_7;
+	io_handle->bytes_per_sector       = 512;
+	io_handle->first_metadata_offset  = 0x00010000;
+	io_handle->second_metadata_offset = 0x00020000;
+	io_handle->third_metadata_offset  = 0x00030000;
+	io_handle->metadata_size          = 65536;
+	io_handle->volume_header_offset   = 0x00040000;
+	io_handle->volume_header_size     = 8192;
+	io_handle->encrypted_volume_size  = 0x00100000;
+	io_handle->volume_size            = 0x00100000;
+
+	result = libbde_sector_cache_initialize(
+	          &sector_cache,
+	          io_handle->block_size,
+	          65536,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_read_ahead_initialize(
+	          &read_ahead,
+	          io_handle,
+	          NULL,
+	          sector_cache,
+	          4,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 */
+	result = libbde_read_ahead_notify_read(
+	          read_ahead,
+	          0x00010000,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_read_ahead_notify_read(
+	          read_ahead,
+	          0x00010200,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* The third sequential read is read ahead
+	 */
+	result = libbde_read_ahead_notify_read(
+	          read_ahead,
+	          0x00010400,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* A random read resets the access pattern
+	 */
+	result = libbde_read_ahead_notify_read(
+	          read_ahead,
+	          0x00018000,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Strided reads are read ahead after the access pattern repeats
+	 */
+	result = libbde_read_ahead_notify_read(
+	          read_ahead,
+	          0x00019000,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_read_ahead_notify_read(
+	          read_ahead,
+	          0x0001a000,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_read_ahead_notify_read(
+	          read_ahead,
+	          0x0001b000,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_read_ahead_notify_read(
+	          NULL,
+	          0x00010000,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_read_ahead_notify_read(
+	          read_ahead,
+	          -1,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_read_ahead_free(
+	          &read_ahead,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_sector_cache_free(
+	          &sector_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_ahead != NULL )
+	{
+		libbde_read_ahead_free(
+		 &read_ahead,
+		 NULL );
+	}
+	if( sector_cache != NULL )
+	{
+		libbde_sector_cache_free(
+		 &sector_cache,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_read_ahead_read_run function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_read_ahead_read_run(
+     void )
+{
+	uint8_t block_data[ 4096 ];
+
+	libbde_io_handle_t *io_handle       = NULL;
+	libbde_read_ahead_run_t *run        = NULL;
+	libbde_read_ahead_t *read_ahead     = NULL;
+	libbde_sector_cache_t *sector_cache = NULL;
+	libbfio_handle_t *file_io_handle    = NULL;
+	libcerror_error_t *error            = NULL;
+	uint8_t *volume_data                = NULL;
+	off64_t block_offset                = 0;
+	size_t data_offset                  = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 * A volume of 128 KiB of which the data from offset 32 KiB up to 64 KiB is unencrypted
+	 */
+	volume_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * 0x00020000 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "volume_data",
+         volume_data );
+
+	for( data_offset = 0;
+	     data_offset < 0x00020000;
+	     data_offset++ )
+	{
+		volume_data[ data_offset ] = (uint8_t) ( data_offset % 251 );
+	}
+	result = bde_test_read_ahead_open_file_io_handle(
+	          &file_io_handle,
+	          volume_data,
+	          0x00020000,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "file_io_handle",
+         file_io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	io_handle->version                = LIBBDE_VERSION_WINDOWS_7;
+	io_handle->bytes_per_sector       = 512;
+	io_handle->first_metadata_offset  = 0x00010000;
+	io_handle->second_metadata_offset = 0x00010000;
+	io_handle->third_metadata_offset  = 0x00010000;
+	io_handle->metadata_size          = 65536;
+	io_handle->volume_header_offset   = 0x00010000;
+	io_handle->volume_header_size     = 8192;
+	io_handle->encrypted_volume_size  = 0x00008000;
+	io_handle->volume_size            = 0x00020000;
+
+	result = libbde_sector_cache_initialize(
+	          &sector_cache,
+	          io_handle->block_size,
+	          1048576,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_read_ahead_initialize(
+	          &read_ahead,
+	          io_handle,
+	          file_io_handle,
+	          sector_cache,
+	          4,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 * The run is owned by the read-ahead once it is pending
+	 */
+	run = memory_allocate_structure(
+	       libbde_read_ahead_run_t );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "run",
+         run );
+
+	run->offset = 0x00008000;
+	run->size   = 0x00004000;
+
+	read_ahead->number_of_pending_runs = 1;
+
+	result = libbde_read_ahead_read_run(
+	          run,
+	          read_ahead );
+
+	run = NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "read_ahead->number_of_pending_runs",
+	 read_ahead->number_of_pending_runs,
+	 0 );
+
+	for( block_offset = 0x00008000;
+	     block_offset < 0x0000c000;
+	     block_offset += 4096 )
+	{
+		result = libbde_sector_cache_get_data(
+		          sector_cache,
+		          block_offset,
+		          0,
+		          block_data,
+		          4096,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        BDE_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+
+		result = memory_compare(
+		          block_data,
+		          &( volume_data[ block_offset ] ),
+		          4096 );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* A run is not read when the read-ahead is stopping
+	 */
+	run = memory_allocate_structure(
+	       libbde_read_ahead_run_t );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "run",
+         run );
+
+	run->offset = 0x0000c000;
+	run->size   = 0x00004000;
+
+	read_ahead->number_of_pending_runs = 1;
+	read_ahead->is_stopping            = 1;
+
+	result = libbde_read_ahead_read_run(
+	          run,
+	          read_ahead );
+
+	run = NULL;
+
+	read_ahead->is_stopping = 0;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "read_ahead->number_of_pending_runs",
+	 read_ahead->number_of_pending_runs,
+	 0 );
+
+	result = libbde_sector_cache_get_data(
+	          sector_cache,
+	          0x0000c000,
+	          0,
+	          block_data,
+	          4096,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 * A run that fails to read is not cached and no longer pending
+	 */
+	run = memory_allocate_structure(
+	       libbde_read_ahead_run_t );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "run",
+         run );
+
+	run->offset = 0x00020000;
+	run->size   = 0x00004000;
+
+	read_ahead->number_of_pending_runs = 1;
+
+	result = libbde_read_ahead_read_run(
+	          run,
+	          read_ahead );
+
+	run = NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "read_ahead->number_of_pending_runs",
+	 read_ahead->number_of_pending_runs,
+	 0 );
+
+	result = libbde_read_ahead_read_run(
+	          NULL,
+	          read_ahead );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	run = memory_allocate_structure(
+	       libbde_read_ahead_run_t );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "run",
+         run );
+
+	run->offset = 0x00008000;
+	run->size   = 0x00004000;
+
+	result = libbde_read_ahead_read_run(
+	          run,
+	          NULL );
+
+	run = NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Clean up
+	 */
+	result = libbde_read_ahead_free(
+	          &read_ahead,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_sector_cache_free(
+	          &sector_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	memory_free(
+	 volume_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( run != NULL )
+	{
+		memory_free(
+		 run );
+	}
+	if( read_ahead != NULL )
+	{
+		libbde_read_ahead_free(
+		 &read_ahead,
+		 NULL );
+	}
+	if( sector_cache != NULL )
+	{
+		libbde_sector_cache_free(
+		 &sector_cache,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( volume_data != NULL )
+	{
+		memory_free(
+		 volume_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_read_ahead_initialize",
+	 bde_test_read_ahead_initialize );
+
+	BDE_TEST_RUN(
+	 "libbde_read_ahead_free",
+	 bde_test_read_ahead_free );
+
+	BDE_TEST_RUN(
+	 "libbde_read_ahead_schedule_run",
+	 bde_test_read_ahead_schedule_run );
+
+	BDE_TEST_RUN(
+	 "libbde_read_ahead_notify_read",
+	 bde_test_read_ahead_notify_read );
+
+	BDE_TEST_RUN(
+	 "libbde_read_ahead_read_run",
+	 bde_test_read_ahead_read_run );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
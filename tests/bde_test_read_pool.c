@@ -0,0 +1,996 @@
+/*
+ * Library read_pool type testing program
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libbfio.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_libcthreads.h"
+#include "bde_test_macros.h"
+#include "bde_test_memory.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_definitions.h"
+#include "../libbde/libbde_io_handle.h"
+#include "../libbde/libbde_read_pool.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_read_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_read_pool_initialize(
+     void )
+{
+	libbde_io_handle_t *io_handle = NULL;
+	libbde_read_pool_t *read_pool = NULL;
+	libcerror_error_t *error      = NULL;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libbde_read_pool_initialize(
+	          &read_pool,
+	          io_handle,
+	          NULL,
+	          2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "read_pool",
+	 read_pool );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_read_pool_free(
+	          &read_pool,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "read_pool",
+	 read_pool );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_read_pool_initialize(
+	          NULL,
+	          io_handle,
+	          NULL,
+	          2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_pool = (libbde_read_pool_t *) 0x12345678UL;
+
+	result = libbde_read_pool_initialize(
+	          &read_pool,
+	          io_handle,
+	          NULL,
+	          2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_pool = NULL;
+
+	result = libbde_read_pool_initialize(
+	          &read_pool,
+	          NULL,
+	          NULL,
+	          2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_read_pool_initialize(
+	          &read_pool,
+	          io_handle,
+	          NULL,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_read_pool_initialize(
+	          &read_pool,
+	          io_handle,
+	          NULL,
+	          LIBBDE_MAXIMUM_NUMBER_OF_DECRYPTION_THREADS + 1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_pool != NULL )
+	{
+		libbde_read_pool_free(
+		 &read_pool,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_read_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_read_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbde_read_pool_free(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_read_pool_read_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_read_pool_read_buffer(
+     void )
+{
+	uint8_t buffer[ 1024 ];
+
+	libbde_io_handle_t *io_handle = NULL;
+	libbde_read_pool_t *read_pool = NULL;
+	libcerror_error_t *error      = NULL;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->bytes_per_sector = 512;
+
+	result = libbde_read_pool_initialize(
+	          &read_pool,
+	          io_handle,
+	          NULL,
+	          2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "read_pool",
+	 read_pool );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_read_pool_read_buffer(
+	          NULL,
+	          0,
+	          buffer,
+	          1024,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_read_pool_read_buffer(
+	          read_pool,
+	          -1,
+	          buffer,
+	          1024,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_read_pool_read_buffer(
+	          read_pool,
+	          100,
+	          buffer,
+	          1024,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_read_pool_read_buffer(
+	          read_pool,
+	          0,
+	          NULL,
+	          1024,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_read_pool_read_buffer(
+	          read_pool,
+	          0,
+	          buffer,
+	          100,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_read_pool_free(
+	          &read_pool,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "read_pool",
+	 read_pool );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( read_pool != NULL )
+	{
+		libbde_read_pool_free(
+		 &read_pool,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Opens a memory range file IO handle of data
+ * Returns 1 if successful or -1 on error
+ */
+int bde_test_read_pool_open_file_io_handle(
+     libbfio_handle_t **file_io_handle,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	if( libbfio_memory_range_initialize(
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_memory_range_set(
+	     *file_io_handle,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     *file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the libbde_read_pool_read_chunk function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_read_pool_read_chunk(
+     void )
+{
+	uint8_t chunk_data[ 4096 ];
+
+	libbde_io_handle_t *io_handle    = NULL;
+	libbde_read_pool_batch_t batch;
+	libbde_read_pool_chunk_t chunk;
+	libbde_read_pool_t *read_pool    = NULL;
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	uint8_t *volume_data             = NULL;
+	size_t data_offset               = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 * A volume of 128 KiB of which the data from offset 32 KiB up to 64 KiB is unencrypted
+	 */
+	memory_set(
+	 &batch,
+	 0,
+	 sizeof( libbde_read_pool_batch_t ) );
+
+	memory_set(
+	 &chunk,
+	 0,
+	 sizeof( libbde_read_pool_chunk_t ) );
+
+	volume_data = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * 0x00020000 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_data",
+	 volume_data );
+
+	for( data_offset = 0;
+	     data_offset < 0x00020000;
+	     data_offset++ )
+	{
+		volume_data[ data_offset ] = (uint8_t) ( data_offset % 251 );
+	}
+	result = bde_test_read_pool_open_file_io_handle(
+	          &file_io_handle,
+	          volume_data,
+	          0x00020000,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "file_io_handle",
+	 file_io_handle );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	io_handle->version                = LIBBDE_VERSION_WINDOWS_7;
+	io_handle->bytes_per_sector       = 512;
+	io_handle->first_metadata_offset  = 0x00010000;
+	io_handle->second_metadata_offset = 0x00010000;
+	io_handle->third_metadata_offset  = 0x00010000;
+	io_handle->metadata_size          = 65536;
+	io_handle->volume_header_offset   = 0x00010000;
+	io_handle->volume_header_size     = 8192;
+	io_handle->encrypted_volume_size  = 0x00008000;
+	io_handle->volume_size            = 0x00020000;
+
+	result = libbde_read_pool_initialize(
+	          &read_pool,
+	          io_handle,
+	          file_io_handle,
+	          2,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	result = libcthreads_mutex_initialize(
+	          &( batch.mutex ),
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_condition_initialize(
+	          &( batch.condition ),
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+#endif
+	chunk.batch     = &batch;
+	chunk.offset    = 0x00008000;
+	chunk.data      = chunk_data;
+	chunk.data_size = 4096;
+
+	/* Test regular cases
+	 */
+	batch.number_of_pending_chunks = 1;
+
+	result = libbde_read_pool_read_chunk(
+	          &chunk,
+	          read_pool );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "batch.number_of_pending_chunks",
+	 batch.number_of_pending_chunks,
+	 0 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "batch.has_failed",
+	 batch.has_failed,
+	 0 );
+
+	result = memory_compare(
+	          chunk_data,
+	          &( volume_data[ 0x00008000 ] ),
+	          4096 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 * A chunk that fails to read marks the batch as failed
+	 */
+	batch.number_of_pending_chunks = 1;
+	chunk.data_size                = 100;
+
+	result = libbde_read_pool_read_chunk(
+	          &chunk,
+	          read_pool );
+
+	chunk.data_size = 4096;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "batch.number_of_pending_chunks",
+	 batch.number_of_pending_chunks,
+	 0 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "batch.has_failed",
+	 batch.has_failed,
+	 1 );
+
+	/* The remaining chunks of a failed batch are skipped
+	 */
+	batch.number_of_pending_chunks = 1;
+
+	result = libbde_read_pool_read_chunk(
+	          &chunk,
+	          read_pool );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "batch.number_of_pending_chunks",
+	 batch.number_of_pending_chunks,
+	 0 );
+
+	/* The chunks are skipped when abort was signalled
+	 */
+	batch.number_of_pending_chunks = 1;
+	batch.has_failed               = 0;
+	io_handle->abort               = 1;
+
+	result = libbde_read_pool_read_chunk(
+	          &chunk,
+	          read_pool );
+
+	io_handle->abort = 0;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "batch.number_of_pending_chunks",
+	 batch.number_of_pending_chunks,
+	 0 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "batch.has_failed",
+	 batch.has_failed,
+	 1 );
+
+	batch.number_of_pending_chunks = 1;
+	batch.has_failed               = 0;
+
+	result = libbde_read_pool_read_chunk(
+	          &chunk,
+	          NULL );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "batch.number_of_pending_chunks",
+	 batch.number_of_pending_chunks,
+	 0 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "batch.has_failed",
+	 batch.has_failed,
+	 1 );
+
+	result = libbde_read_pool_read_chunk(
+	          NULL,
+	          read_pool );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	/* Clean up
+	 */
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	result = libcthreads_condition_free(
+	          &( batch.condition ),
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libcthreads_mutex_free(
+	          &( batch.mutex ),
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+#endif
+	result = libbde_read_pool_free(
+	          &read_pool,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_close(
+	          file_io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 volume_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+#if defined( HAVE_LIBBDE_MULTI_THREAD_SUPPORT )
+	if( batch.condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &( batch.condition ),
+		 NULL );
+	}
+	if( batch.mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( batch.mutex ),
+		 NULL );
+	}
+#endif
+	if( read_pool != NULL )
+	{
+		libbde_read_pool_free(
+		 &read_pool,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( volume_data != NULL )
+	{
+		memory_free(
+		 volume_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_read_pool_initialize",
+	 bde_test_read_pool_initialize );
+
+	BDE_TEST_RUN(
+	 "libbde_read_pool_free",
+	 bde_test_read_pool_free );
+
+	BDE_TEST_RUN(
+	 "libbde_read_pool_read_buffer",
+	 bde_test_read_pool_read_buffer );
+
+	BDE_TEST_RUN(
+	 "libbde_read_pool_read_chunk",
+	 bde_test_read_pool_read_chunk );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,890 @@
+/*
+ * Library region_table type testing program
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_memory.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_definitions.h"
+#include "../libbde/libbde_io_handle.h"
+#include "../libbde/libbde_region_table.h"
+#include "../libbde/libbde_sector_data.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_region_table_append_region function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_region_table_append_region(
+     void )
+{
+	libbde_region_table_t region_table;
+
+	libcerror_error_t *error = NULL;
+	int region_index         = 0;
+	int result               = 0;
+
+	result = libbde_region_table_clear(
+	          &region_table,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 */
+	result = libbde_region_table_append_region(
+	          &region_table,
+	          0,
+	          8192,
+	          0x00040000,
+	          LIBBDE_SECTOR_DATA_TYPE_ENCRYPTED,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test a region of which the data does not follow the data of the last region
+	 */
+	result = libbde_region_table_append_region(
+	          &region_table,
+	          8192,
+	          8192,
+	          8192,
+	          LIBBDE_SECTOR_DATA_TYPE_ENCRYPTED,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test a region that extends the last region
+	 */
+	result = libbde_region_table_append_region(
+	          &region_table,
+	          16384,
+	          4096,
+	          16384,
+	          LIBBDE_SECTOR_DATA_TYPE_ENCRYPTED,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "region_table.number_of_regions",
+	 region_table.number_of_regions,
+	 2 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT64(
+	 "region_table.regions[ 1 ].size",
+	 (uint64_t) region_table.regions[ 1 ].size,
+	 (uint64_t) 12288 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT64(
+	 "region_table.size",
+	 (uint64_t) region_table.size,
+	 (uint64_t) 20480 );
+
+	result = libbde_region_table_find_region_index(
+	          &region_table,
+	          12288,
+	          &region_index,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "region_index",
+	 region_index,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_region_table_find_region_index(
+	          &region_table,
+	          20480,
+	          &region_index,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_region_table_append_region(
+	          NULL,
+	          20480,
+	          4096,
+	          20480,
+	          LIBBDE_SECTOR_DATA_TYPE_ENCRYPTED,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_region_table_append_region(
+	          &region_table,
+	          20480,
+	          0,
+	          20480,
+	          LIBBDE_SECTOR_DATA_TYPE_ENCRYPTED,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test a region that does not follow the last region
+	 */
+	result = libbde_region_table_append_region(
+	          &region_table,
+	          24576,
+	          4096,
+	          24576,
+	          LIBBDE_SECTOR_DATA_TYPE_ENCRYPTED,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_region_table_range_has_sector_type function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_region_table_range_has_sector_type(
+     void )
+{
+	libbde_region_table_t region_table;
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 * Metadata from offset 8192 up to 12288 between encrypted data
+	 */
+	result = libbde_region_table_clear(
+	          &region_table,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_region_table_append_region(
+	          &region_table,
+	          0,
+	          8192,
+	          0,
+	          LIBBDE_SECTOR_DATA_TYPE_ENCRYPTED,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_region_table_append_region(
+	          &region_table,
+	          8192,
+	          4096,
+	          8192,
+	          LIBBDE_SECTOR_DATA_TYPE_ZERO,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_region_table_append_region(
+	          &region_table,
+	          12288,
+	          8192,
+	          12288,
+	          LIBBDE_SECTOR_DATA_TYPE_ENCRYPTED,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 */
+	result = libbde_region_table_range_has_sector_type(
+	          &region_table,
+	          0,
+	          8192,
+	          LIBBDE_SECTOR_DATA_TYPE_ZERO,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test a range that ends in the metadata
+	 */
+	result = libbde_region_table_range_has_sector_type(
+	          &region_table,
+	          7680,
+	          1024,
+	          LIBBDE_SECTOR_DATA_TYPE_ZERO,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test a range that starts in the metadata
+	 */
+	result = libbde_region_table_range_has_sector_type(
+	          &region_table,
+	          11776,
+	          1024,
+	          LIBBDE_SECTOR_DATA_TYPE_ZERO,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test a range that spans the metadata
+	 */
+	result = libbde_region_table_range_has_sector_type(
+	          &region_table,
+	          4096,
+	          12288,
+	          LIBBDE_SECTOR_DATA_TYPE_ZERO,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_region_table_range_has_sector_type(
+	          &region_table,
+	          12288,
+	          8192,
+	          LIBBDE_SECTOR_DATA_TYPE_ZERO,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test an empty range
+	 */
+	result = libbde_region_table_range_has_sector_type(
+	          &region_table,
+	          8192,
+	          0,
+	          LIBBDE_SECTOR_DATA_TYPE_ZERO,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_region_table_range_has_sector_type(
+	          NULL,
+	          0,
+	          8192,
+	          LIBBDE_SECTOR_DATA_TYPE_ZERO,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_region_table_range_has_sector_type(
+	          &region_table,
+	          -1,
+	          8192,
+	          LIBBDE_SECTOR_DATA_TYPE_ZERO,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_region_table_range_has_sector_type(
+	          &region_table,
+	          8192,
+	          (size64_t) INT64_MAX,
+	          LIBBDE_SECTOR_DATA_TYPE_ZERO,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_region_get_flags function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_region_get_flags(
+     void )
+{
+	libbde_region_t region;
+
+	libcerror_error_t *error = NULL;
+	uint32_t flags           = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	region.offset      = 0;
+	region.size        = 8192;
+	region.data_offset = 0x00040000;
+	region.sector_type = LIBBDE_SECTOR_DATA_TYPE_ENCRYPTED;
+
+	result = libbde_region_get_flags(
+	          &region,
+	          &flags,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT32(
+	 "flags",
+	 flags,
+	 (uint32_t) ( LIBBDE_REGION_FLAG_ENCRYPTED | LIBBDE_REGION_FLAG_RELOCATED ) );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	region.offset      = 0x00010000;
+	region.size        = 65536;
+	region.data_offset = 0x00010000;
+	region.sector_type = LIBBDE_SECTOR_DATA_TYPE_ZERO;
+
+	result = libbde_region_get_flags(
+	          &region,
+	          &flags,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_UINT32(
+	 "flags",
+	 flags,
+	 (uint32_t) LIBBDE_REGION_FLAG_METADATA );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	region.sector_type = 0xff;
+
+	result = libbde_region_get_flags(
+	          &region,
+	          &flags,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_region_get_flags(
+	          &region,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_io_handle_get_region_table function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_io_handle_get_region_table(
+     void )
+{
+	libbde_region_table_t region_table;
+
+	libbde_io_handle_t *io_handle = NULL;
+	libbde_region_t *region       = NULL;
+	libcerror_error_t *error      = NULL;
+	off64_t data_offset           = 0;
+	off64_t sector_offset         = 0;
+	uint8_t sector_type           = 0;
+	int region_index              = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	io_handle->version                = LIBBDE_VERSION_WINDOWS_7;
+	io_handle->bytes_per_sector       = 512;
+	io_handle->first_metadata_offset  = 0x00010000;
+	io_handle->second_metadata_offset = 0x00020000;
+	io_handle->third_metadata_offset  = 0x00030000;
+	io_handle->metadata_size          = 65536;
+	io_handle->volume_header_offset   = 0x00040000;
+	io_handle->volume_header_size     = 8192;
+	io_handle->encrypted_volume_size  = 0x00100000;
+	io_handle->volume_size            = 0x00200000;
+
+	/* Test regular cases
+	 */
+	result = libbde_io_handle_get_region_table(
+	          io_handle,
+	          0,
+	          io_handle->volume_size,
+	          1,
+	          &region_table,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	BDE_TEST_ASSERT_EQUAL_UINT64(
+	 "region_table.size",
+	 (uint64_t) region_table.size,
+	 (uint64_t) io_handle->volume_size );
+
+	/* The relocated volume header, the encrypted sectors, the 3 metadata areas
+	 * and the stored volume header, the encrypted sectors and the unencrypted sectors
+	 */
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "region_table.number_of_regions",
+	 region_table.number_of_regions,
+	 5 );
+
+	/* Test if the regions match the sector type of every sector
+	 */
+	for( sector_offset = 0;
+	     sector_offset < (off64_t) io_handle->volume_size;
+	     sector_offset += io_handle->bytes_per_sector )
+	{
+		result = libbde_sector_data_get_sector_type(
+		          io_handle,
+		          sector_offset,
+		          1,
+		          &data_offset,
+		          &sector_type,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		result = libbde_region_table_find_region_index(
+		          &region_table,
+		          sector_offset,
+		          &region_index,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		region = &( region_table.regions[ region_index ] );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "region->sector_type",
+		 (int) region->sector_type,
+		 (int) sector_type );
+
+		BDE_TEST_ASSERT_EQUAL_INT64(
+		 "region->data_offset",
+		 (int64_t) ( region->data_offset + ( sector_offset - region->offset ) ),
+		 (int64_t) data_offset );
+	}
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test a range that does not start at a metadata boundary
+	 */
+	result = libbde_io_handle_get_region_table(
+	          io_handle,
+	          0x0000fe00,
+	          4096,
+	          1,
+	          &region_table,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "region_table.number_of_regions",
+	 region_table.number_of_regions,
+	 2 );
+
+	BDE_TEST_ASSERT_EQUAL_INT64(
+	 "region_table.regions[ 1 ].offset",
+	 (int64_t) region_table.regions[ 1 ].offset,
+	 (int64_t) 0x00010000 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_io_handle_get_region_table(
+	          NULL,
+	          0,
+	          io_handle->volume_size,
+	          1,
+	          &region_table,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_io_handle_get_region_table(
+	          io_handle,
+	          -1,
+	          io_handle->volume_size,
+	          1,
+	          &region_table,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_region_table_append_region",
+	 bde_test_region_table_append_region );
+
+	BDE_TEST_RUN(
+	 "libbde_region_table_range_has_sector_type",
+	 bde_test_region_table_range_has_sector_type );
+
+	BDE_TEST_RUN(
+	 "libbde_region_get_flags",
+	 bde_test_region_get_flags );
+
+	BDE_TEST_RUN(
+	 "libbde_io_handle_get_region_table",
+	 bde_test_io_handle_get_region_table );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,953 @@
+/*
+ * Library sector_cache type testing program
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_memory.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_definitions.h"
+#include "../libbde/libbde_sector_cache.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_sector_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sector_cache_initialize(
+     void )
+{
+	libbde_sector_cache_t *sector_cache = NULL;
+	libcerror_error_t *error            = NULL;
+	int result                          = 0;
+
+#if defined( HAVE_BDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests     = 3;
+	int test_number                     = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libbde_sector_cache_initialize(
+	          &sector_cache,
+	          4096,
+	          65536,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "sector_cache",
+         sector_cache );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_sector_cache_free(
+	          &sector_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "sector_cache",
+         sector_cache );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test a cache size smaller than the block size
+	 */
+	result = libbde_sector_cache_initialize(
+	          &sector_cache,
+	          4096,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "sector_cache",
+         sector_cache );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_sector_cache_free(
+	          &sector_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_sector_cache_initialize(
+	          NULL,
+	          4096,
+	          65536,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	sector_cache = (libbde_sector_cache_t *) 0x12345678UL;
+
+	result = libbde_sector_cache_initialize(
+	          &sector_cache,
+	          4096,
+	          65536,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	sector_cache = NULL;
+
+	result = libbde_sector_cache_initialize(
+	          &sector_cache,
+	          0,
+	          65536,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_BDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libbde_sector_cache_initialize with malloc failing
+		 */
+		bde_test_malloc_attempts_before_fail = test_number;
+
+		result = libbde_sector_cache_initialize(
+		          &sector_cache,
+		          4096,
+		          65536,
+		          &error );
+
+		if( bde_test_malloc_attempts_before_fail != -1 )
+		{
+			bde_test_malloc_attempts_before_fail = -1;
+
+			if( sector_cache != NULL )
+			{
+				libbde_sector_cache_free(
+				 &sector_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			BDE_TEST_ASSERT_IS_NULL(
+			 "sector_cache",
+			 sector_cache );
+
+			BDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_BDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_cache != NULL )
+	{
+		libbde_sector_cache_free(
+		 &sector_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_sector_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sector_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbde_sector_cache_free(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_sector_cache_get_shard function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sector_cache_get_shard(
+     void )
+{
+	int number_of_blocks_per_shard[ LIBBDE_SECTOR_CACHE_NUMBER_OF_SHARDS ];
+
+	libbde_sector_cache_shard_t *other_shard = NULL;
+	libbde_sector_cache_shard_t *shard       = NULL;
+	libbde_sector_cache_shard_t *shards      = NULL;
+	libbde_sector_cache_t *sector_cache      = NULL;
+	libcerror_error_t *error                 = NULL;
+	off64_t block_offset                     = 0;
+	int bucket_index                         = 0;
+	int number_of_used_shards                = 0;
+	int other_bucket_index                   = 0;
+	int result                               = 0;
+	int shard_index                          = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_sector_cache_initialize(
+	          &sector_cache,
+	          4096,
+	          256 * 4096,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "sector_cache",
+         sector_cache );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "sector_cache->number_of_shards",
+	 sector_cache->number_of_shards,
+	 LIBBDE_SECTOR_CACHE_NUMBER_OF_SHARDS );
+
+	for( shard_index = 0;
+	     shard_index < LIBBDE_SECTOR_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		number_of_blocks_per_shard[ shard_index ] = 0;
+	}
+	/* Test regular cases
+	 * Every block must map to a shard and hash bucket within bounds
+	 */
+	for( block_offset = 0;
+	     block_offset < 1024 * 4096;
+	     block_offset += 4096 )
+	{
+		shard        = NULL;
+		bucket_index = -1;
+
+		result = libbde_sector_cache_get_shard(
+		          sector_cache,
+		          block_offset,
+		          &shard,
+		          &bucket_index,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        BDE_TEST_ASSERT_IS_NOT_NULL(
+	         "shard",
+	         shard );
+
+	        BDE_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+
+		shard_index = (int) ( shard - sector_cache->shards );
+
+		BDE_TEST_ASSERT_GREATER_THAN_INT(
+		 "shard_index",
+		 shard_index,
+		 -1 );
+
+		BDE_TEST_ASSERT_LESS_THAN_INT(
+		 "shard_index",
+		 shard_index,
+		 sector_cache->number_of_shards );
+
+		BDE_TEST_ASSERT_GREATER_THAN_INT(
+		 "bucket_index",
+		 bucket_index,
+		 -1 );
+
+		BDE_TEST_ASSERT_LESS_THAN_INT(
+		 "bucket_index",
+		 bucket_index,
+		 shard->number_of_buckets );
+
+		number_of_blocks_per_shard[ shard_index ] += 1;
+	}
+	/* The blocks must be spread over the shards
+	 */
+	for( shard_index = 0;
+	     shard_index < LIBBDE_SECTOR_CACHE_NUMBER_OF_SHARDS;
+	     shard_index++ )
+	{
+		if( number_of_blocks_per_shard[ shard_index ] > 0 )
+		{
+			number_of_used_shards++;
+		}
+	}
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_used_shards",
+	 number_of_used_shards,
+	 LIBBDE_SECTOR_CACHE_NUMBER_OF_SHARDS );
+
+	/* The same block must always map to the same shard and hash bucket
+	 */
+	result = libbde_sector_cache_get_shard(
+	          sector_cache,
+	          (off64_t) 1000 * 4096,
+	          &shard,
+	          &bucket_index,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_sector_cache_get_shard(
+	          sector_cache,
+	          (off64_t) 1000 * 4096,
+	          &other_shard,
+	          &other_bucket_index,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "other_shard_index",
+	 (int) ( other_shard - sector_cache->shards ),
+	 (int) ( shard - sector_cache->shards ) );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "other_bucket_index",
+	 other_bucket_index,
+	 bucket_index );
+
+	/* Test error cases
+	 */
+	result = libbde_sector_cache_get_shard(
+	          NULL,
+	          0,
+	          &shard,
+	          &bucket_index,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_cache_get_shard(
+	          sector_cache,
+	          -4096,
+	          &shard,
+	          &bucket_index,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_cache_get_shard(
+	          sector_cache,
+	          512,
+	          &shard,
+	          &bucket_index,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_cache_get_shard(
+	          sector_cache,
+	          0,
+	          NULL,
+	          &bucket_index,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_cache_get_shard(
+	          sector_cache,
+	          0,
+	          &shard,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	shards               = sector_cache->shards;
+	sector_cache->shards = NULL;
+
+	result = libbde_sector_cache_get_shard(
+	          sector_cache,
+	          0,
+	          &shard,
+	          &bucket_index,
+	          &error );
+
+	sector_cache->shards = shards;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_sector_cache_free(
+	          &sector_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "sector_cache",
+         sector_cache );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_cache != NULL )
+	{
+		libbde_sector_cache_free(
+		 &sector_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_sector_cache_get_data and libbde_sector_cache_set_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sector_cache_get_set_data(
+     void )
+{
+	uint8_t buffer[ 512 ];
+	uint8_t data[ 512 ];
+
+	libbde_sector_cache_t *sector_cache = NULL;
+	libcerror_error_t *error            = NULL;
+	off64_t block_offset                = 0;
+	int number_of_cached_blocks         = 0;
+	int result                          = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_sector_cache_initialize(
+	          &sector_cache,
+	          512,
+	          4 * 512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "sector_cache",
+         sector_cache );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 */
+	result = libbde_sector_cache_get_data(
+	          sector_cache,
+	          0,
+	          0,
+	          buffer,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	memory_set(
+	 data,
+	 0x5a,
+	 512 );
+
+	result = libbde_sector_cache_set_data(
+	          sector_cache,
+	          0,
+	          data,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	memory_set(
+	 buffer,
+	 0,
+	 512 );
+
+	result = libbde_sector_cache_get_data(
+	          sector_cache,
+	          0,
+	          256,
+	          buffer,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = memory_compare(
+	          buffer,
+	          &( data[ 256 ] ),
+	          256 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Fill the cache beyond its capacity, which should evict blocks
+	 */
+	for( block_offset = 512;
+	     block_offset < 16 * 512;
+	     block_offset += 512 )
+	{
+		result = libbde_sector_cache_set_data(
+		          sector_cache,
+		          block_offset,
+		          data,
+		          512,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        BDE_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+	}
+	for( block_offset = 0;
+	     block_offset < 16 * 512;
+	     block_offset += 512 )
+	{
+		result = libbde_sector_cache_get_data(
+		          sector_cache,
+		          block_offset,
+		          0,
+		          buffer,
+		          512,
+		          &error );
+
+		BDE_TEST_ASSERT_NOT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+	        BDE_TEST_ASSERT_IS_NULL(
+	         "error",
+	         error );
+
+		if( result == 1 )
+		{
+			number_of_cached_blocks++;
+		}
+	}
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_cached_blocks",
+	 number_of_cached_blocks,
+	 4 );
+
+	/* Test error cases
+	 */
+	result = libbde_sector_cache_get_data(
+	          NULL,
+	          0,
+	          0,
+	          buffer,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_cache_get_data(
+	          sector_cache,
+	          0,
+	          0,
+	          NULL,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_cache_set_data(
+	          NULL,
+	          0,
+	          data,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_cache_set_data(
+	          sector_cache,
+	          0,
+	          NULL,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_cache_set_data(
+	          sector_cache,
+	          0,
+	          data,
+	          1024,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_sector_cache_free(
+	          &sector_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "sector_cache",
+         sector_cache );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( sector_cache != NULL )
+	{
+		libbde_sector_cache_free(
+		 &sector_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_sector_cache_initialize",
+	 bde_test_sector_cache_initialize );
+
+	BDE_TEST_RUN(
+	 "libbde_sector_cache_free",
+	 bde_test_sector_cache_free );
+
+	BDE_TEST_RUN(
+	 "libbde_sector_cache_get_shard",
+	 bde_test_sector_cache_get_shard );
+
+	BDE_TEST_RUN(
+	 "libbde_sector_cache_get_data",
+	 bde_test_sector_cache_get_set_data );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -33,6 +33,8 @@
 #include "bde_test_memory.h"
 #include "bde_test_unused.h"
 
+#include "../libbde/libbde_definitions.h"
+#include "../libbde/libbde_io_handle.h"
 #include "../libbde/libbde_sector_data.h"
 
 #if defined( __GNUC__ )
@@ -75,6 +77,721 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libbde_sector_data_get_sector_type function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sector_data_get_sector_type(
+     void )
+{
+	libbde_io_handle_t *io_handle = NULL;
+	libcerror_error_t *error      = NULL;
+	off64_t data_offset           = 0;
+	uint8_t sector_type           = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	io_handle->version                = LIBBDE_VERSION_WINDOWS_7;
+	io_handle->first_metadata_offset  = 0x00010000;
+	io_handle->second_metadata_offset = 0x00020000;
+	io_handle->third_metadata_offset  = 0x00030000;
+	io_handle->metadata_size          = 65536;
+	io_handle->volume_header_offset   = 0x00040000;
+	io_handle->volume_header_size     = 8192;
+	io_handle->encrypted_volume_size  = 0x00100000;
+
+	/* Test regular cases
+	 */
+	result = libbde_sector_data_get_sector_type(
+	          io_handle,
+	          0,
+	          1,
+	          &data_offset,
+	          &sector_type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT64(
+	 "data_offset",
+	 (int64_t) data_offset,
+	 (int64_t) 0x00040000 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "sector_type",
+	 (int) sector_type,
+	 LIBBDE_SECTOR_DATA_TYPE_ENCRYPTED );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_sector_data_get_sector_type(
+	          io_handle,
+	          0x00020200,
+	          1,
+	          &data_offset,
+	          &sector_type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "sector_type",
+	 (int) sector_type,
+	 LIBBDE_SECTOR_DATA_TYPE_ZERO );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_sector_data_get_sector_type(
+	          io_handle,
+	          0x00020200,
+	          0,
+	          &data_offset,
+	          &sector_type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT64(
+	 "data_offset",
+	 (int64_t) data_offset,
+	 (int64_t) 0x00020200 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "sector_type",
+	 (int) sector_type,
+	 LIBBDE_SECTOR_DATA_TYPE_ENCRYPTED );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_sector_data_get_sector_type(
+	          io_handle,
+	          0x00200000,
+	          1,
+	          &data_offset,
+	          &sector_type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "sector_type",
+	 (int) sector_type,
+	 LIBBDE_SECTOR_DATA_TYPE_UNENCRYPTED );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_sector_data_get_sector_type(
+	          NULL,
+	          0,
+	          1,
+	          &data_offset,
+	          &sector_type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_data_get_sector_type(
+	          io_handle,
+	          0,
+	          1,
+	          NULL,
+	          &sector_type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_data_get_sector_type(
+	          io_handle,
+	          0,
+	          1,
+	          &data_offset,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_sector_data_read_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sector_data_read_buffer(
+     void )
+{
+	uint8_t data[ 1024 ];
+
+	libbde_io_handle_t *io_handle = NULL;
+	libcerror_error_t *error      = NULL;
+	size_t data_offset            = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	io_handle->version                = LIBBDE_VERSION_WINDOWS_7;
+	io_handle->bytes_per_sector       = 512;
+	io_handle->first_metadata_offset  = 0x00010000;
+	io_handle->second_metadata_offset = 0x00020000;
+	io_handle->third_metadata_offset  = 0x00030000;
+	io_handle->metadata_size          = 65536;
+	io_handle->volume_header_offset   = 0x00040000;
+	io_handle->volume_header_size     = 8192;
+	io_handle->encrypted_volume_size  = 0x00100000;
+
+	/* Test regular cases
+	 */
+	for( data_offset = 0;
+	     data_offset < 1024;
+	     data_offset++ )
+	{
+		data[ data_offset ] = 0xff;
+	}
+	/* Metadata sectors are zero-ed without reading from the file IO handle
+	 * and the data can be read in-place
+	 */
+	result = libbde_sector_data_read_buffer(
+	          io_handle,
+	          NULL,
+	          0x00010000,
+	          data,
+	          data,
+	          1024,
+	          NULL,
+	          1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	for( data_offset = 0;
+	     data_offset < 1024;
+	     data_offset++ )
+	{
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "data[ data_offset ]",
+		 (int) data[ data_offset ],
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libbde_sector_data_read_buffer(
+	          NULL,
+	          NULL,
+	          0x00010000,
+	          data,
+	          data,
+	          1024,
+	          NULL,
+	          1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_data_read_buffer(
+	          io_handle,
+	          NULL,
+	          0x00010000,
+	          NULL,
+	          data,
+	          1024,
+	          NULL,
+	          1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_data_read_buffer(
+	          io_handle,
+	          NULL,
+	          0x00010000,
+	          data,
+	          NULL,
+	          1024,
+	          NULL,
+	          1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_data_read_buffer(
+	          io_handle,
+	          NULL,
+	          0x00010000,
+	          data,
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          NULL,
+	          1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_data_read_buffer(
+	          io_handle,
+	          NULL,
+	          0x00010000,
+	          data,
+	          data,
+	          1000,
+	          NULL,
+	          1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_sector_data_write_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sector_data_write_buffer(
+     void )
+{
+	uint8_t data[ 1024 ];
+	uint8_t encrypted_data[ 1024 ];
+
+	libbde_io_handle_t *io_handle = NULL;
+	libcerror_error_t *error      = NULL;
+	size_t data_offset            = 0;
+	int result                    = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	io_handle->version                = LIBBDE_VERSION_WINDOWS_7;
+	io_handle->bytes_per_sector       = 512;
+	io_handle->first_metadata_offset  = 0x00010000;
+	io_handle->second_metadata_offset = 0x00020000;
+	io_handle->third_metadata_offset  = 0x00030000;
+	io_handle->metadata_size          = 65536;
+	io_handle->volume_header_offset   = 0x00040000;
+	io_handle->volume_header_size     = 8192;
+	io_handle->encrypted_volume_size  = 0x00100000;
+
+	/* Test regular cases
+	 */
+	for( data_offset = 0;
+	     data_offset < 1024;
+	     data_offset++ )
+	{
+		data[ data_offset ] = 0xff;
+	}
+	/* Metadata sectors are never written hence the file IO handle is not used
+	 */
+	result = libbde_sector_data_write_buffer(
+	          io_handle,
+	          NULL,
+	          0x00010000,
+	          data,
+	          encrypted_data,
+	          1024,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_sector_data_write_buffer(
+	          NULL,
+	          NULL,
+	          0x00010000,
+	          data,
+	          encrypted_data,
+	          1024,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_data_write_buffer(
+	          io_handle,
+	          NULL,
+	          0x00010000,
+	          NULL,
+	          encrypted_data,
+	          1024,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_data_write_buffer(
+	          io_handle,
+	          NULL,
+	          0x00010000,
+	          data,
+	          NULL,
+	          1024,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_data_write_buffer(
+	          io_handle,
+	          NULL,
+	          0x00010000,
+	          data,
+	          data,
+	          1024,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_data_write_buffer(
+	          io_handle,
+	          NULL,
+	          0x00010000,
+	          data,
+	          encrypted_data,
+	          (size_t) SSIZE_MAX + 1,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sector_data_write_buffer(
+	          io_handle,
+	          NULL,
+	          0x00010000,
+	          data,
+	          encrypted_data,
+	          1000,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) */
 
 /* The main program
@@ -100,8 +817,20 @@ int main(
 	 "libbde_sector_data_free",
 	 bde_test_sector_data_free );
 
+	BDE_TEST_RUN(
+	 "libbde_sector_data_get_sector_type",
+	 bde_test_sector_data_get_sector_type );
+
 	/* TODO: add tests for libbde_sector_data_read */
 
+	BDE_TEST_RUN(
+	 "libbde_sector_data_read_buffer",
+	 bde_test_sector_data_read_buffer );
+
+	BDE_TEST_RUN(
+	 "libbde_sector_data_write_buffer",
+	 bde_test_sector_data_write_buffer );
+
 #endif /* defined( __GNUC__ ) */
 
 	return( EXIT_SUCCESS );
@@ -0,0 +1,477 @@
+/*
+ * Library SHA-256 key stretching functions testing program
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_memory.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_sha256_stretch.h"
+
+#if defined( __GNUC__ )
+
+uint8_t bde_test_sha256_stretch_password_hash[ 32 ] = {
+	0x01, 0x04, 0x07, 0x0a, 0x0d, 0x10, 0x13, 0x16, 0x19, 0x1c, 0x1f, 0x22, 0x25, 0x28, 0x2b, 0x2e,
+	0x31, 0x34, 0x37, 0x3a, 0x3d, 0x40, 0x43, 0x46, 0x49, 0x4c, 0x4f, 0x52, 0x55, 0x58, 0x5b, 0x5e };
+
+uint8_t bde_test_sha256_stretch_salt[ 16 ] = {
+	0xa0, 0xa1, 0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf };
+
+/* The key after 3 iterations
+ */
+uint8_t bde_test_sha256_stretch_key3[ 32 ] = {
+	0x39, 0xbd, 0x05, 0x06, 0x07, 0x08, 0x08, 0x6d, 0x75, 0x97, 0xc1, 0xf7, 0xfa, 0x40, 0x87, 0x53,
+	0xdd, 0x1b, 0x5e, 0x3b, 0xc7, 0xa0, 0xea, 0x0e, 0x39, 0xb7, 0x4a, 0x19, 0x03, 0x2c, 0x39, 0xc6 };
+
+/* The key after 0x100000 iterations
+ */
+uint8_t bde_test_sha256_stretch_key[ 32 ] = {
+	0x7a, 0x8d, 0xcb, 0x1f, 0x30, 0xe1, 0x3f, 0xaa, 0x0e, 0x3f, 0xea, 0x3c, 0xcb, 0x27, 0xd7, 0x1d,
+	0x60, 0xb4, 0xd3, 0xda, 0x8b, 0x55, 0xe6, 0xd4, 0x6b, 0x25, 0x28, 0x79, 0x27, 0x9f, 0x48, 0xa0 };
+
+/* Tests the libbde_sha256_stretch_calculate function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sha256_stretch_calculate(
+     void )
+{
+	uint8_t key[ 32 ];
+
+	libcerror_error_t *error  = NULL;
+	volatile int abort_signal = 0;
+	int result                = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_sha256_stretch_calculate(
+	          bde_test_sha256_stretch_password_hash,
+	          32,
+	          bde_test_sha256_stretch_salt,
+	          16,
+	          3,
+	          key,
+	          32,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          key,
+	          bde_test_sha256_stretch_key3,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libbde_sha256_stretch_calculate(
+	          bde_test_sha256_stretch_password_hash,
+	          32,
+	          bde_test_sha256_stretch_salt,
+	          16,
+	          LIBBDE_SHA256_STRETCH_NUMBER_OF_ITERATIONS,
+	          key,
+	          32,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          key,
+	          bde_test_sha256_stretch_key,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test regular case where the abort signal is not set
+	 */
+	abort_signal = 0;
+
+	result = libbde_sha256_stretch_calculate(
+	          bde_test_sha256_stretch_password_hash,
+	          32,
+	          bde_test_sha256_stretch_salt,
+	          16,
+	          3,
+	          key,
+	          32,
+	          &abort_signal,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          key,
+	          bde_test_sha256_stretch_key3,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test regular case where the calculation is aborted
+	 */
+	abort_signal = 1;
+
+	result = libbde_sha256_stretch_calculate(
+	          bde_test_sha256_stretch_password_hash,
+	          32,
+	          bde_test_sha256_stretch_salt,
+	          16,
+	          LIBBDE_SHA256_STRETCH_NUMBER_OF_ITERATIONS,
+	          key,
+	          32,
+	          &abort_signal,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_sha256_stretch_calculate(
+	          NULL,
+	          32,
+	          bde_test_sha256_stretch_salt,
+	          16,
+	          3,
+	          key,
+	          32,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sha256_stretch_calculate(
+	          bde_test_sha256_stretch_password_hash,
+	          32,
+	          bde_test_sha256_stretch_salt,
+	          8,
+	          3,
+	          key,
+	          32,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sha256_stretch_calculate(
+	          bde_test_sha256_stretch_password_hash,
+	          32,
+	          bde_test_sha256_stretch_salt,
+	          16,
+	          3,
+	          NULL,
+	          32,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_sha256_stretch_calculate_multiple function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_sha256_stretch_calculate_multiple(
+     void )
+{
+	uint8_t keys[ 11 * 32 ];
+	uint8_t password_hashes[ 11 * 32 ];
+	uint8_t key[ 32 ];
+
+	libcerror_error_t *error = NULL;
+	size_t byte_index        = 0;
+	int key_index            = 0;
+	int result               = 0;
+
+	for( byte_index = 0;
+	     byte_index < 11 * 32;
+	     byte_index++ )
+	{
+		password_hashes[ byte_index ] = bde_test_sha256_stretch_password_hash[ byte_index % 32 ] ^ (uint8_t) ( byte_index / 32 );
+	}
+	/* Test regular cases
+	 */
+	result = libbde_sha256_stretch_calculate_multiple(
+	          password_hashes,
+	          11 * 32,
+	          bde_test_sha256_stretch_salt,
+	          16,
+	          3,
+	          keys,
+	          11 * 32,
+	          11,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          keys,
+	          bde_test_sha256_stretch_key3,
+	          32 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	for( key_index = 1;
+	     key_index < 11;
+	     key_index++ )
+	{
+		result = libbde_sha256_stretch_calculate(
+		          &( password_hashes[ key_index * 32 ] ),
+		          32,
+		          bde_test_sha256_stretch_salt,
+		          16,
+		          3,
+		          key,
+		          32,
+		          NULL,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = memory_compare(
+		          &( keys[ key_index * 32 ] ),
+		          key,
+		          32 );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libbde_sha256_stretch_calculate_multiple(
+	          NULL,
+	          11 * 32,
+	          bde_test_sha256_stretch_salt,
+	          16,
+	          3,
+	          keys,
+	          11 * 32,
+	          11,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sha256_stretch_calculate_multiple(
+	          password_hashes,
+	          11 * 32,
+	          bde_test_sha256_stretch_salt,
+	          16,
+	          3,
+	          keys,
+	          10 * 32,
+	          11,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_sha256_stretch_calculate_multiple(
+	          password_hashes,
+	          11 * 32,
+	          bde_test_sha256_stretch_salt,
+	          16,
+	          3,
+	          keys,
+	          11 * 32,
+	          -1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_sha256_stretch_calculate",
+	 bde_test_sha256_stretch_calculate );
+
+	BDE_TEST_RUN(
+	 "libbde_sha256_stretch_calculate_multiple",
+	 bde_test_sha256_stretch_calculate_multiple );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -1003,6 +1004,300 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libbde_check_utf8_recovery_password function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_check_utf8_recovery_password(
+     void )
+{
+	uint8_t utf8_string[ 56 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	memory_copy(
+	 utf8_string,
+	 "471207-278498-422125-177177-561902-537405-468006-693451",
+	 56 );
+
+	result = libbde_check_utf8_recovery_password(
+	          utf8_string,
+	          55,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a group that is not divisible by 11
+	 */
+	utf8_string[ 5 ] = (uint8_t) '8';
+
+	result = libbde_check_utf8_recovery_password(
+	          utf8_string,
+	          55,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a group that exceeds 65535 after the division by 11
+	 */
+	utf8_string[ 0 ] = (uint8_t) '7';
+	utf8_string[ 1 ] = (uint8_t) '2';
+	utf8_string[ 2 ] = (uint8_t) '0';
+	utf8_string[ 3 ] = (uint8_t) '8';
+	utf8_string[ 4 ] = (uint8_t) '9';
+	utf8_string[ 5 ] = (uint8_t) '6';
+
+	result = libbde_check_utf8_recovery_password(
+	          utf8_string,
+	          55,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	utf8_string[ 0 ] = (uint8_t) '4';
+	utf8_string[ 1 ] = (uint8_t) '7';
+	utf8_string[ 2 ] = (uint8_t) '1';
+	utf8_string[ 3 ] = (uint8_t) '2';
+	utf8_string[ 4 ] = (uint8_t) '0';
+	utf8_string[ 5 ] = (uint8_t) '7';
+
+	/* Test an invalid group separator
+	 */
+	utf8_string[ 6 ] = (uint8_t) '+';
+
+	result = libbde_check_utf8_recovery_password(
+	          utf8_string,
+	          55,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a recovery password with a missing group
+	 */
+	utf8_string[ 6 ] = (uint8_t) '-';
+
+	result = libbde_check_utf8_recovery_password(
+	          utf8_string,
+	          48,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_check_utf8_recovery_password(
+	          NULL,
+	          55,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_check_utf16_recovery_password function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_check_utf16_recovery_password(
+     void )
+{
+	uint16_t utf16_string[ 56 ];
+
+	libcerror_error_t *error = NULL;
+	size_t string_index      = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	for( string_index = 0;
+	     string_index < 56;
+	     string_index++ )
+	{
+		utf16_string[ string_index ] = (uint16_t) "471207-278498-422125-177177-561902-537405-468006-693451"[ string_index ];
+	}
+	result = libbde_check_utf16_recovery_password(
+	          utf16_string,
+	          55,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a group that is not divisible by 11
+	 */
+	utf16_string[ 5 ] = (uint16_t) '8';
+
+	result = libbde_check_utf16_recovery_password(
+	          utf16_string,
+	          55,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a group that exceeds 65535 after the division by 11
+	 */
+	utf16_string[ 0 ] = (uint16_t) '7';
+	utf16_string[ 1 ] = (uint16_t) '2';
+	utf16_string[ 2 ] = (uint16_t) '0';
+	utf16_string[ 3 ] = (uint16_t) '8';
+	utf16_string[ 4 ] = (uint16_t) '9';
+	utf16_string[ 5 ] = (uint16_t) '6';
+
+	result = libbde_check_utf16_recovery_password(
+	          utf16_string,
+	          55,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	utf16_string[ 0 ] = (uint16_t) '4';
+	utf16_string[ 1 ] = (uint16_t) '7';
+	utf16_string[ 2 ] = (uint16_t) '1';
+	utf16_string[ 3 ] = (uint16_t) '2';
+	utf16_string[ 4 ] = (uint16_t) '0';
+	utf16_string[ 5 ] = (uint16_t) '7';
+
+	/* Test an invalid group separator
+	 */
+	utf16_string[ 6 ] = (uint16_t) '+';
+
+	result = libbde_check_utf16_recovery_password(
+	          utf16_string,
+	          55,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a recovery password with a missing group
+	 */
+	utf16_string[ 6 ] = (uint16_t) '-';
+
+	result = libbde_check_utf16_recovery_password(
+	          utf16_string,
+	          48,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_check_utf16_recovery_password(
+	          NULL,
+	          55,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -1060,6 +1355,14 @@ int main(
 	 "libbde_set_codepage",
 	 bde_test_set_codepage );
 
+	BDE_TEST_RUN(
+	 "libbde_check_utf8_recovery_password",
+	 bde_test_check_utf8_recovery_password );
+
+	BDE_TEST_RUN(
+	 "libbde_check_utf16_recovery_password",
+	 bde_test_check_utf16_recovery_password );
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
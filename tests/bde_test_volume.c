@@ -31,9 +31,11 @@
 #endif
 
 #include "bde_test_libbde.h"
+#include "bde_test_libbfio.h"
 #include "bde_test_libcerror.h"
 #include "bde_test_libclocale.h"
 #include "bde_test_libcsystem.h"
+#include "bde_test_libcthreads.h"
 #include "bde_test_libuna.h"
 #include "bde_test_macros.h"
 #include "bde_test_memory.h"
@@ -42,6 +44,38 @@
 #error Unsupported size of wchar_t
 #endif
 
+#define BDE_TEST_VOLUME_CONCURRENT_READ_SIZE		4096
+#define BDE_TEST_VOLUME_CONCURRENT_REFERENCE_SIZE	65536
+#define BDE_TEST_VOLUME_NUMBER_OF_CONCURRENT_READERS	4
+#define BDE_TEST_VOLUME_NUMBER_OF_CONCURRENT_READS	32
+#define BDE_TEST_VOLUME_MAXIMUM_WRITE_SOURCE_SIZE	( 64 * 1024 * 1024 )
+#define BDE_TEST_VOLUME_WRITE_SIZE			512
+
+typedef struct bde_test_volume_concurrent_reader bde_test_volume_concurrent_reader_t;
+
+struct bde_test_volume_concurrent_reader
+{
+	/* The volume
+	 */
+	libbde_volume_t *volume;
+
+	/* The reference data, read serially
+	 */
+	const uint8_t *reference_data;
+
+	/* The reference data size
+	 */
+	size_t reference_data_size;
+
+	/* The reader index
+	 */
+	int reader_index;
+
+	/* The result
+	 */
+	int result;
+};
+
 /* Define to make bde_test_volume generate verbose output
 #define BDE_TEST_VOLUME_VERBOSE
  */
@@ -447,55 +481,19 @@ int bde_test_volume_get_wide_source(
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
-/* Creates and opens a source volume
+/* Sets the password and recovery password of a source volume
  * Returns 1 if successful or -1 on error
  */
-int bde_test_volume_open_source(
-     libbde_volume_t **volume,
-     const system_character_t *source,
+int bde_test_volume_set_source_passwords(
+     libbde_volume_t *volume,
      const system_character_t *password,
      const system_character_t *recovery_password,
      libcerror_error_t **error )
 {
-	static char *function = "bde_test_volume_open_source";
+	static char *function = "bde_test_volume_set_source_passwords";
 	size_t string_length  = 0;
 	int result            = 0;
 
-	if( volume == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid volume.",
-		 function );
-
-		return( -1 );
-	}
-	if( source == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid source.",
-		 function );
-
-		return( -1 );
-	}
-	if( libbde_volume_initialize(
-	     volume,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize volume.",
-		 function );
-
-		goto on_error;
-	}
 	if( password != NULL )
 	{
 		string_length = system_string_length(
@@ -503,13 +501,13 @@ int bde_test_volume_open_source(
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 		result = libbde_volume_set_utf16_password(
-		          *volume,
+		          volume,
 		          (uint16_t *) password,
 		          string_length,
 		          error );
 #else
 		result = libbde_volume_set_utf8_password(
-		          *volume,
+		          volume,
 		          (uint8_t *) password,
 		          string_length,
 		          error );
@@ -523,7 +521,7 @@ int bde_test_volume_open_source(
 			 "%s: unable to set password.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
 	if( recovery_password != NULL )
@@ -533,13 +531,13 @@ int bde_test_volume_open_source(
 
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 		result = libbde_volume_set_utf16_recovery_password(
-		          *volume,
+		          volume,
 		          (uint16_t *) recovery_password,
 		          string_length,
 		          error );
 #else
 		result = libbde_volume_set_utf8_recovery_password(
-		          *volume,
+		          volume,
 		          (uint8_t *) recovery_password,
 		          string_length,
 		          error );
@@ -553,9 +551,75 @@ int bde_test_volume_open_source(
 			 "%s: unable to set recovery password.",
 			 function );
 
-			goto on_error;
+			return( -1 );
 		}
 	}
+	return( 1 );
+}
+
+/* Creates and opens a source volume
+ * Returns 1 if successful or -1 on error
+ */
+int bde_test_volume_open_source(
+     libbde_volume_t **volume,
+     const system_character_t *source,
+     const system_character_t *password,
+     const system_character_t *recovery_password,
+     libcerror_error_t **error )
+{
+	static char *function = "bde_test_volume_open_source";
+	int result            = 0;
+
+	if( volume == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid volume.",
+		 function );
+
+		return( -1 );
+	}
+	if( source == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbde_volume_initialize(
+	     volume,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize volume.",
+		 function );
+
+		goto on_error;
+	}
+	if( bde_test_volume_set_source_passwords(
+	     *volume,
+	     password,
+	     recovery_password,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set passwords.",
+		 function );
+
+		goto on_error;
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	result = libbde_volume_open_wide(
 	          *volume,
@@ -875,27 +939,20 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libbde_volume_open function
+/* Tests the libbde_volume_set_block_size function
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_open(
-     const system_character_t *source,
-     const system_character_t *password,
-     const system_character_t *recovery_password )
+int bde_test_volume_set_block_size(
+     void )
 {
-	char narrow_source[ 256 ];
-
 	libbde_volume_t *volume  = NULL;
 	libcerror_error_t *error = NULL;
-	size_t string_length     = 0;
 	int result               = 0;
 
 	/* Initialize test
 	 */
-	result = bde_test_volume_get_narrow_source(
-	          source,
-	          narrow_source,
-	          256,
+	result = libbde_volume_initialize(
+	          &volume,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -903,12 +960,19 @@ int bde_test_volume_open(
 	 result,
 	 1 );
 
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "volume",
+         volume );
+
         BDE_TEST_ASSERT_IS_NULL(
          "error",
          error );
 
-	result = libbde_volume_initialize(
-	          &volume,
+	/* Test regular cases
+	 */
+	result = libbde_volume_set_block_size(
+	          volume,
+	          65536,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -916,91 +980,66 @@ int bde_test_volume_open(
 	 result,
 	 1 );
 
-        BDE_TEST_ASSERT_IS_NOT_NULL(
-         "volume",
-         volume );
-
         BDE_TEST_ASSERT_IS_NULL(
          "error",
          error );
 
-	if( password != NULL )
-	{
-		string_length = system_string_length(
-		                 password );
+	/* Test error cases
+	 */
+	result = libbde_volume_set_block_size(
+	          NULL,
+	          65536,
+	          &error );
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libbde_volume_set_utf16_password(
-		          volume,
-		          (uint16_t *) password,
-		          string_length,
-		          &error );
-#else
-		result = libbde_volume_set_utf8_password(
-		          volume,
-		          (uint8_t *) password,
-		          string_length,
-		          &error );
-#endif
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
-	        BDE_TEST_ASSERT_IS_NULL(
-	         "error",
-        	 error );
-	}
-	if( recovery_password != NULL )
-	{
-		string_length = system_string_length(
-		                 recovery_password );
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libbde_volume_set_utf16_recovery_password(
-		          volume,
-		          (uint16_t *) recovery_password,
-		          string_length,
-		          &error );
-#else
-		result = libbde_volume_set_utf8_recovery_password(
-		          volume,
-		          (uint8_t *) recovery_password,
-		          string_length,
-		          &error );
-#endif
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
+	libcerror_error_free(
+	 &error );
 
-	        BDE_TEST_ASSERT_IS_NULL(
-	         "error",
-        	 error );
-	}
-	/* Test open
-	 */
-	result = libbde_volume_open(
+	result = libbde_volume_set_block_size(
 	          volume,
-	          narrow_source,
-	          LIBBDE_OPEN_READ,
+	          0,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-        BDE_TEST_ASSERT_IS_NULL(
+        BDE_TEST_ASSERT_IS_NOT_NULL(
          "error",
          error );
 
-	/* Test error cases
-	 */
-	result = libbde_volume_open(
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_set_block_size(
 	          volume,
-	          narrow_source,
-	          LIBBDE_OPEN_READ,
+	          1000,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_set_block_size(
+	          volume,
+	          (size_t) SSIZE_MAX,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -1051,29 +1090,20 @@ on_error:
 	return( 0 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Tests the libbde_volume_open_wide function
+/* Tests the libbde_volume_set_cache_size function
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_open_wide(
-     const system_character_t *source,
-     const system_character_t *password,
-     const system_character_t *recovery_password )
+int bde_test_volume_set_cache_size(
+     void )
 {
-	wchar_t wide_source[ 256 ];
-
 	libbde_volume_t *volume  = NULL;
 	libcerror_error_t *error = NULL;
-	size_t string_length     = 0;
 	int result               = 0;
 
 	/* Initialize test
 	 */
-	result = bde_test_volume_get_wide_source(
-	          source,
-	          wide_source,
-	          256,
+	result = libbde_volume_initialize(
+	          &volume,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -1081,12 +1111,19 @@ int bde_test_volume_open_wide(
 	 result,
 	 1 );
 
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "volume",
+         volume );
+
         BDE_TEST_ASSERT_IS_NULL(
          "error",
          error );
 
-	result = libbde_volume_initialize(
-	          &volume,
+	/* Test regular cases
+	 */
+	result = libbde_volume_set_cache_size(
+	          volume,
+	          1048576,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -1094,74 +1131,15 @@ int bde_test_volume_open_wide(
 	 result,
 	 1 );
 
-        BDE_TEST_ASSERT_IS_NOT_NULL(
-         "volume",
-         volume );
-
         BDE_TEST_ASSERT_IS_NULL(
          "error",
          error );
 
-	if( password != NULL )
-	{
-		string_length = system_string_length(
-		                 password );
-
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libbde_volume_set_utf16_password(
-		          volume,
-		          (uint16_t *) password,
-		          string_length,
-		          &error );
-#else
-		result = libbde_volume_set_utf8_password(
-		          volume,
-		          (uint8_t *) password,
-		          string_length,
-		          &error );
-#endif
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
-
-	        BDE_TEST_ASSERT_IS_NULL(
-	         "error",
-        	 error );
-	}
-	if( recovery_password != NULL )
-	{
-		string_length = system_string_length(
-		                 recovery_password );
-
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libbde_volume_set_utf16_recovery_password(
-		          volume,
-		          (uint16_t *) recovery_password,
-		          string_length,
-		          &error );
-#else
-		result = libbde_volume_set_utf8_recovery_password(
-		          volume,
-		          (uint8_t *) recovery_password,
-		          string_length,
-		          &error );
-#endif
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
-
-	        BDE_TEST_ASSERT_IS_NULL(
-	         "error",
-        	 error );
-	}
-	/* Test open
+	/* A cache size of 0 disables the sector cache
 	 */
-	result = libbde_volume_open_wide(
+	result = libbde_volume_set_cache_size(
 	          volume,
-	          wide_source,
-	          LIBBDE_OPEN_READ,
+	          0,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -1175,10 +1153,26 @@ int bde_test_volume_open_wide(
 
 	/* Test error cases
 	 */
-	result = libbde_volume_open_wide(
+	result = libbde_volume_set_cache_size(
+	          NULL,
+	          1048576,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_set_cache_size(
 	          volume,
-	          wide_source,
-	          LIBBDE_OPEN_READ,
+	          (size64_t) SSIZE_MAX + 1,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -1229,57 +1223,14 @@ on_error:
 	return( 0 );
 }
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
-
-/* Tests the libbde_volume_close function
+/* Tests the libbde_volume_set_read_ahead_depth function
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_close(
+int bde_test_volume_set_read_ahead_depth(
      void )
-{
-	libcerror_error_t *error = NULL;
-	int result               = 0;
-
-	/* Test error cases
-	 */
-	result = libbde_volume_close(
-	          NULL,
-	          &error );
-
-	BDE_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
-
-        BDE_TEST_ASSERT_IS_NOT_NULL(
-         "error",
-         error );
-
-	libcerror_error_free(
-	 &error );
-
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
-
-/* Tests the libbde_volume_open and libbde_volume_close functions
- * Returns 1 if successful or 0 if not
- */
-int bde_test_volume_open_close(
-     const system_character_t *source,
-     const system_character_t *password,
-     const system_character_t *recovery_password )
 {
 	libbde_volume_t *volume  = NULL;
 	libcerror_error_t *error = NULL;
-	size_t string_length     = 0;
 	int result               = 0;
 
 	/* Initialize test
@@ -1301,75 +1252,12 @@ int bde_test_volume_open_close(
          "error",
          error );
 
-	if( password != NULL )
-	{
-		string_length = system_string_length(
-		                 password );
-
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libbde_volume_set_utf16_password(
-		          volume,
-		          (uint16_t *) password,
-		          string_length,
-		          &error );
-#else
-		result = libbde_volume_set_utf8_password(
-		          volume,
-		          (uint8_t *) password,
-		          string_length,
-		          &error );
-#endif
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
-
-	        BDE_TEST_ASSERT_IS_NULL(
-	         "error",
-        	 error );
-	}
-	if( recovery_password != NULL )
-	{
-		string_length = system_string_length(
-		                 recovery_password );
-
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		result = libbde_volume_set_utf16_recovery_password(
-		          volume,
-		          (uint16_t *) recovery_password,
-		          string_length,
-		          &error );
-#else
-		result = libbde_volume_set_utf8_recovery_password(
-		          volume,
-		          (uint8_t *) recovery_password,
-		          string_length,
-		          &error );
-#endif
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 1 );
-
-	        BDE_TEST_ASSERT_IS_NULL(
-	         "error",
-        	 error );
-	}
-	/* Test open and close
+	/* Test regular cases
 	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libbde_volume_open_wide(
-	          volume,
-	          source,
-	          LIBBDE_OPEN_READ,
-	          &error );
-#else
-	result = libbde_volume_open(
+	result = libbde_volume_set_read_ahead_depth(
 	          volume,
-	          source,
-	          LIBBDE_OPEN_READ,
+	          16,
 	          &error );
-#endif
 
 	BDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
@@ -1380,57 +1268,77 @@ int bde_test_volume_open_close(
          "error",
          error );
 
-	result = libbde_volume_close(
+	/* A read-ahead depth of 0 disables read-ahead
+	 */
+	result = libbde_volume_set_read_ahead_depth(
 	          volume,
+	          0,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 1 );
 
         BDE_TEST_ASSERT_IS_NULL(
          "error",
          error );
 
-	/* Test open and close a second time to validate clean up on close
+	/* Test error cases
 	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libbde_volume_open_wide(
-	          volume,
-	          source,
-	          LIBBDE_OPEN_READ,
+	result = libbde_volume_set_read_ahead_depth(
+	          NULL,
+	          16,
 	          &error );
-#else
-	result = libbde_volume_open(
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_set_read_ahead_depth(
 	          volume,
-	          source,
-	          LIBBDE_OPEN_READ,
+	          -1,
 	          &error );
-#endif
 
 	BDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-        BDE_TEST_ASSERT_IS_NULL(
+        BDE_TEST_ASSERT_IS_NOT_NULL(
          "error",
          error );
 
-	result = libbde_volume_close(
+	libcerror_error_free(
+	 &error );
+
+	/* The maximum read-ahead depth is 4096
+	 */
+	result = libbde_volume_set_read_ahead_depth(
 	          volume,
+	          4097,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 0 );
+	 -1 );
 
-        BDE_TEST_ASSERT_IS_NULL(
+        BDE_TEST_ASSERT_IS_NOT_NULL(
          "error",
          error );
 
+	libcerror_error_free(
+	 &error );
+
 	/* Clean up
 	 */
 	result = libbde_volume_free(
@@ -1467,34 +1375,2250 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libbde_volume_signal_abort function
+/* Tests the libbde_volume_set_number_of_decryption_threads function
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_signal_abort(
-     libbde_volume_t *volume )
+int bde_test_volume_set_number_of_decryption_threads(
+     void )
 {
+	libbde_volume_t *volume  = NULL;
 	libcerror_error_t *error = NULL;
 	int result               = 0;
 
-	/* Test regular cases
+	/* Initialize test
+	 */
+	result = libbde_volume_initialize(
+	          &volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "volume",
+         volume );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_set_number_of_decryption_threads(
+	          volume,
+	          4,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* A number of decryption threads of 0 disables the decryption threads
+	 */
+	result = libbde_volume_set_number_of_decryption_threads(
+	          volume,
+	          0,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_volume_set_number_of_decryption_threads(
+	          NULL,
+	          4,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_set_number_of_decryption_threads(
+	          volume,
+	          -1,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* The maximum number of decryption threads is 32
+	 */
+	result = libbde_volume_set_number_of_decryption_threads(
+	          volume,
+	          33,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_volume_free(
+	          &volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "volume",
+         volume );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libbde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_open function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_open(
+     const system_character_t *source,
+     const system_character_t *password,
+     const system_character_t *recovery_password )
+{
+	char narrow_source[ 256 ];
+
+	libbde_volume_t *volume  = NULL;
+	libcerror_error_t *error = NULL;
+	size_t string_length     = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = bde_test_volume_get_narrow_source(
+	          source,
+	          narrow_source,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_volume_initialize(
+	          &volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "volume",
+         volume );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	if( password != NULL )
+	{
+		string_length = system_string_length(
+		                 password );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libbde_volume_set_utf16_password(
+		          volume,
+		          (uint16_t *) password,
+		          string_length,
+		          &error );
+#else
+		result = libbde_volume_set_utf8_password(
+		          volume,
+		          (uint8_t *) password,
+		          string_length,
+		          &error );
+#endif
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        BDE_TEST_ASSERT_IS_NULL(
+	         "error",
+        	 error );
+	}
+	if( recovery_password != NULL )
+	{
+		string_length = system_string_length(
+		                 recovery_password );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libbde_volume_set_utf16_recovery_password(
+		          volume,
+		          (uint16_t *) recovery_password,
+		          string_length,
+		          &error );
+#else
+		result = libbde_volume_set_utf8_recovery_password(
+		          volume,
+		          (uint8_t *) recovery_password,
+		          string_length,
+		          &error );
+#endif
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        BDE_TEST_ASSERT_IS_NULL(
+	         "error",
+        	 error );
+	}
+	/* Test open
+	 */
+	result = libbde_volume_open(
+	          volume,
+	          narrow_source,
+	          LIBBDE_OPEN_READ,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_volume_open(
+	          volume,
+	          narrow_source,
+	          LIBBDE_OPEN_READ,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_volume_free(
+	          &volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "volume",
+         volume );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libbde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Tests the libbde_volume_open_wide function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_open_wide(
+     const system_character_t *source,
+     const system_character_t *password,
+     const system_character_t *recovery_password )
+{
+	wchar_t wide_source[ 256 ];
+
+	libbde_volume_t *volume  = NULL;
+	libcerror_error_t *error = NULL;
+	size_t string_length     = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = bde_test_volume_get_wide_source(
+	          source,
+	          wide_source,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_volume_initialize(
+	          &volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "volume",
+         volume );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	if( password != NULL )
+	{
+		string_length = system_string_length(
+		                 password );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libbde_volume_set_utf16_password(
+		          volume,
+		          (uint16_t *) password,
+		          string_length,
+		          &error );
+#else
+		result = libbde_volume_set_utf8_password(
+		          volume,
+		          (uint8_t *) password,
+		          string_length,
+		          &error );
+#endif
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        BDE_TEST_ASSERT_IS_NULL(
+	         "error",
+        	 error );
+	}
+	if( recovery_password != NULL )
+	{
+		string_length = system_string_length(
+		                 recovery_password );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libbde_volume_set_utf16_recovery_password(
+		          volume,
+		          (uint16_t *) recovery_password,
+		          string_length,
+		          &error );
+#else
+		result = libbde_volume_set_utf8_recovery_password(
+		          volume,
+		          (uint8_t *) recovery_password,
+		          string_length,
+		          &error );
+#endif
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        BDE_TEST_ASSERT_IS_NULL(
+	         "error",
+        	 error );
+	}
+	/* Test open
+	 */
+	result = libbde_volume_open_wide(
+	          volume,
+	          wide_source,
+	          LIBBDE_OPEN_READ,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_volume_open_wide(
+	          volume,
+	          wide_source,
+	          LIBBDE_OPEN_READ,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_volume_free(
+	          &volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "volume",
+         volume );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libbde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Tests the libbde_volume_close function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_close(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbde_volume_close(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_open and libbde_volume_close functions
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_open_close(
+     const system_character_t *source,
+     const system_character_t *password,
+     const system_character_t *recovery_password )
+{
+	libbde_volume_t *volume  = NULL;
+	libcerror_error_t *error = NULL;
+	size_t string_length     = 0;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_volume_initialize(
+	          &volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "volume",
+         volume );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	if( password != NULL )
+	{
+		string_length = system_string_length(
+		                 password );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libbde_volume_set_utf16_password(
+		          volume,
+		          (uint16_t *) password,
+		          string_length,
+		          &error );
+#else
+		result = libbde_volume_set_utf8_password(
+		          volume,
+		          (uint8_t *) password,
+		          string_length,
+		          &error );
+#endif
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        BDE_TEST_ASSERT_IS_NULL(
+	         "error",
+        	 error );
+	}
+	if( recovery_password != NULL )
+	{
+		string_length = system_string_length(
+		                 recovery_password );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libbde_volume_set_utf16_recovery_password(
+		          volume,
+		          (uint16_t *) recovery_password,
+		          string_length,
+		          &error );
+#else
+		result = libbde_volume_set_utf8_recovery_password(
+		          volume,
+		          (uint8_t *) recovery_password,
+		          string_length,
+		          &error );
+#endif
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+	        BDE_TEST_ASSERT_IS_NULL(
+	         "error",
+        	 error );
+	}
+	/* Test open and close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbde_volume_open_wide(
+	          volume,
+	          source,
+	          LIBBDE_OPEN_READ,
+	          &error );
+#else
+	result = libbde_volume_open(
+	          volume,
+	          source,
+	          LIBBDE_OPEN_READ,
+	          &error );
+#endif
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_volume_close(
+	          volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test open and close a second time to validate clean up on close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbde_volume_open_wide(
+	          volume,
+	          source,
+	          LIBBDE_OPEN_READ,
+	          &error );
+#else
+	result = libbde_volume_open(
+	          volume,
+	          source,
+	          LIBBDE_OPEN_READ,
+	          &error );
+#endif
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_volume_close(
+	          volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Clean up
+	 */
+	result = libbde_volume_free(
+	          &volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "volume",
+         volume );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libbde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_signal_abort function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_signal_abort(
+     libbde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_signal_abort(
+	          volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
 	 */
 	result = libbde_volume_signal_abort(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_read_metadata_copies function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_read_metadata_copies(
+     libbde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_read_metadata_copies(
+	          volume,
+	          &error );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that reading the metadata copies a second time is consistent
+	 */
+	result = libbde_volume_read_metadata_copies(
+	          volume,
+	          &error );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_volume_read_metadata_copies(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Reads overlapping ranges with libbde_volume_read_buffer_at_offset_concurrent
+ * and compares them with the reference data
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_concurrent_reader_read(
+     bde_test_volume_concurrent_reader_t *concurrent_reader )
+{
+	uint8_t buffer[ BDE_TEST_VOLUME_CONCURRENT_READ_SIZE ];
+
+	size_t maximum_offset = 0;
+	size_t read_offset    = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	int read_index        = 0;
+
+	if( concurrent_reader == NULL )
+	{
+		return( 0 );
+	}
+	concurrent_reader->result = 0;
+
+	read_size = BDE_TEST_VOLUME_CONCURRENT_READ_SIZE;
+
+	if( read_size > concurrent_reader->reference_data_size )
+	{
+		read_size = concurrent_reader->reference_data_size;
+	}
+	maximum_offset = concurrent_reader->reference_data_size - read_size;
+
+	for( read_index = 0;
+	     read_index < BDE_TEST_VOLUME_NUMBER_OF_CONCURRENT_READS;
+	     read_index++ )
+	{
+		/* The offsets of the readers overlap and are not sector aligned
+		 */
+		read_offset = ( (size_t) concurrent_reader->reader_index * 1000 )
+		            + ( (size_t) read_index * 1536 );
+
+		if( maximum_offset == 0 )
+		{
+			read_offset = 0;
+		}
+		else
+		{
+			read_offset %= maximum_offset + 1;
+		}
+		read_count = libbde_volume_read_buffer_at_offset_concurrent(
+		              concurrent_reader->volume,
+		              buffer,
+		              read_size,
+		              (off64_t) read_offset,
+		              NULL );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			return( 0 );
+		}
+		if( memory_compare(
+		     buffer,
+		     &( concurrent_reader->reference_data[ read_offset ] ),
+		     read_size ) != 0 )
+		{
+			return( 0 );
+		}
+	}
+	concurrent_reader->result = 1;
+
+	return( 1 );
+}
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+
+/* The concurrent reader thread callback function
+ * Returns 1 if successful or -1 on error
+ */
+int bde_test_volume_concurrent_reader_callback_function(
+     bde_test_volume_concurrent_reader_t *concurrent_reader )
+{
+	if( bde_test_volume_concurrent_reader_read(
+	     concurrent_reader ) != 1 )
+	{
+		return( -1 );
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+/* Tests the libbde_volume_read_buffer_at_offset_concurrent function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_read_buffer_at_offset_concurrent(
+     libbde_volume_t *volume )
+{
+	bde_test_volume_concurrent_reader_t concurrent_readers[ BDE_TEST_VOLUME_NUMBER_OF_CONCURRENT_READERS ];
+	uint8_t buffer[ 16 ];
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	libcthreads_thread_t *threads[ BDE_TEST_VOLUME_NUMBER_OF_CONCURRENT_READERS ];
+#endif
+
+	libcerror_error_t *error = NULL;
+	uint8_t *reference_data  = NULL;
+	size64_t volume_size     = 0;
+	size_t reference_size    = 0;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+	off64_t current_offset   = 0;
+	int reader_index         = 0;
+	int result               = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	int number_of_threads    = 0;
+#endif
+
+	/* Determine if the volume can be read
+	 */
+	result = libbde_volume_is_locked(
+	          volume,
+	          &error );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result == 0 )
+	{
+		result = libbde_volume_get_size(
+		          volume,
+		          &volume_size,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		reference_size = BDE_TEST_VOLUME_CONCURRENT_REFERENCE_SIZE;
+
+		if( (size64_t) reference_size > volume_size )
+		{
+			reference_size = (size_t) volume_size;
+		}
+	}
+	if( reference_size > 0 )
+	{
+		/* Read the reference data serially
+		 */
+		reference_data = (uint8_t *) memory_allocate(
+		                              sizeof( uint8_t ) * reference_size );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "reference_data",
+		 reference_data );
+
+		read_count = libbde_volume_read_buffer_at_offset(
+		              volume,
+		              reference_data,
+		              reference_size,
+		              0,
+		              &error );
+
+		BDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) reference_size );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libbde_volume_get_offset(
+		          volume,
+		          &current_offset,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test regular cases
+		 */
+		for( reader_index = 0;
+		     reader_index < BDE_TEST_VOLUME_NUMBER_OF_CONCURRENT_READERS;
+		     reader_index++ )
+		{
+			concurrent_readers[ reader_index ].volume              = volume;
+			concurrent_readers[ reader_index ].reference_data      = reference_data;
+			concurrent_readers[ reader_index ].reference_data_size = reference_size;
+			concurrent_readers[ reader_index ].reader_index        = reader_index;
+			concurrent_readers[ reader_index ].result              = 0;
+		}
+		result = bde_test_volume_concurrent_reader_read(
+		          &( concurrent_readers[ 0 ] ) );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+		/* Test that readers in multiple threads read the same data as the serial read
+		 */
+		for( number_of_threads = 0;
+		     number_of_threads < BDE_TEST_VOLUME_NUMBER_OF_CONCURRENT_READERS;
+		     number_of_threads++ )
+		{
+			threads[ number_of_threads ] = NULL;
+
+			result = libcthreads_thread_create(
+			          &( threads[ number_of_threads ] ),
+			          NULL,
+			          (int (*)(void *)) &bde_test_volume_concurrent_reader_callback_function,
+			          (void *) &( concurrent_readers[ number_of_threads ] ),
+			          &error );
+
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			BDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		while( number_of_threads > 0 )
+		{
+			number_of_threads--;
+
+			result = libcthreads_thread_join(
+			          &( threads[ number_of_threads ] ),
+			          &error );
+
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			BDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+		}
+		for( reader_index = 0;
+		     reader_index < BDE_TEST_VOLUME_NUMBER_OF_CONCURRENT_READERS;
+		     reader_index++ )
+		{
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "concurrent_readers[ reader_index ].result",
+			 concurrent_readers[ reader_index ].result,
+			 1 );
+		}
+#endif /* defined( HAVE_MULTI_THREAD_SUPPORT ) */
+
+		/* Test that the concurrent reads did not change the current offset
+		 */
+		result = libbde_volume_get_offset(
+		          volume,
+		          &offset,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		BDE_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 (int64_t) offset,
+		 (int64_t) current_offset );
+
+		memory_free(
+		 reference_data );
+
+		reference_data = NULL;
+	}
+	/* Test error cases
+	 */
+	read_count = libbde_volume_read_buffer_at_offset_concurrent(
+	              NULL,
+	              buffer,
+	              16,
+	              0,
+	              &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libbde_volume_read_buffer_at_offset_concurrent(
+	              volume,
+	              NULL,
+	              16,
+	              0,
+	              &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libbde_volume_read_buffer_at_offset_concurrent(
+	              volume,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libbde_volume_read_buffer_at_offset_concurrent(
+	              volume,
+	              buffer,
+	              16,
+	              -1,
+	              &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	while( number_of_threads > 0 )
+	{
+		number_of_threads--;
+
+		if( threads[ number_of_threads ] != NULL )
+		{
+			libcthreads_thread_join(
+			 &( threads[ number_of_threads ] ),
+			 NULL );
+		}
+	}
+#endif
+	if( reference_data != NULL )
+	{
+		memory_free(
+		 reference_data );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_write_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_write_buffer(
+     libbde_volume_t *volume )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	ssize_t write_count      = 0;
+
+	/* Test error cases
+	 */
+	write_count = libbde_volume_write_buffer(
+	               NULL,
+	               buffer,
+	               16,
+	               &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test write on a volume that was opened for reading
+	 */
+	write_count = libbde_volume_write_buffer(
+	               volume,
+	               buffer,
+	               16,
+	               &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( LIBBDE_HAVE_BFIO )
+
+/* Reads the data of a source into a buffer
+ * Returns 1 if successful, 0 if the source is too large or -1 on error
+ */
+int bde_test_volume_read_source_data(
+     const system_character_t *source,
+     uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "bde_test_volume_read_source_data";
+	size64_t source_size             = 0;
+	size_t source_length             = 0;
+	ssize_t read_count               = 0;
+
+	if( source == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid source.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	source_length = system_string_length(
+	                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     source,
+	     source_length,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     source,
+	     source_length,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_get_size(
+	     file_io_handle,
+	     &source_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve source size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( source_size == 0 )
+	 || ( source_size > (size64_t) BDE_TEST_VOLUME_MAXIMUM_WRITE_SOURCE_SIZE ) )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+
+		return( 0 );
+	}
+	*data = (uint8_t *) memory_allocate(
+	                     sizeof( uint8_t ) * (size_t) source_size );
+
+	if( *data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              *data,
+	              (size_t) source_size,
+	              error );
+
+	if( read_count != (ssize_t) source_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read source data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	*data_size = (size_t) source_size;
+
+	return( 1 );
+
+on_error:
+	if( *data != NULL )
+	{
+		memory_free(
+		 *data );
+
+		*data = NULL;
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the libbde_volume_write_buffer_at_offset function
+ * The data written is flushed and read back after reopening a copy of the source
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_write_buffer_at_offset(
+     const system_character_t *source,
+     const system_character_t *password,
+     const system_character_t *recovery_password )
+{
+	uint8_t buffer[ BDE_TEST_VOLUME_WRITE_SIZE ];
+	uint8_t read_buffer[ BDE_TEST_VOLUME_WRITE_SIZE ];
+
+	libbde_volume_t *volume          = NULL;
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	uint8_t *source_data             = NULL;
+	off64_t data_offset              = 0;
+	off64_t metadata_offset          = 0;
+	off64_t region_offset            = 0;
+	size64_t region_size             = 0;
+	size_t buffer_index              = 0;
+	size_t source_data_size          = 0;
+	ssize_t read_count               = 0;
+	ssize_t write_count              = 0;
+	uint32_t region_flags            = 0;
+	int data_region_index            = -1;
+	int metadata_region_index        = -1;
+	int number_of_regions            = 0;
+	int region_index                 = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 * The volume is written to a copy of the source in memory
+	 */
+	result = bde_test_volume_read_source_data(
+	          source,
+	          &source_data,
+	          &source_data_size,
+	          &error );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result == 0 )
+	{
+		/* Skip sources that are too large to copy
+		 */
+		return( 1 );
+	}
+	result = libbfio_memory_range_initialize(
+	          &file_io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_memory_range_set(
+	          file_io_handle,
+	          source_data,
+	          source_data_size,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_volume_initialize(
+	          &volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = bde_test_volume_set_source_passwords(
+	          volume,
+	          password,
+	          recovery_password,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_volume_open_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          LIBBDE_OPEN_READ_WRITE,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Determine an offset of volume data and of the metadata
+	 */
+	result = libbde_volume_get_number_of_regions(
+	          volume,
+	          &number_of_regions,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	for( region_index = 0;
+	     region_index < number_of_regions;
+	     region_index++ )
+	{
+		result = libbde_volume_get_region_by_index(
+		          volume,
+		          region_index,
+		          &region_offset,
+		          &region_size,
+		          &region_flags,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		if( ( region_flags & LIBBDE_REGION_FLAG_METADATA ) != 0 )
+		{
+			if( metadata_region_index == -1 )
+			{
+				metadata_region_index = region_index;
+				metadata_offset       = region_offset;
+			}
+		}
+		else if( ( ( region_flags & LIBBDE_REGION_FLAG_RELOCATED ) == 0 )
+		      && ( region_size >= BDE_TEST_VOLUME_WRITE_SIZE ) )
+		{
+			if( data_region_index == -1 )
+			{
+				data_region_index = region_index;
+				data_offset       = region_offset;
+			}
+		}
+	}
+	BDE_TEST_ASSERT_GREATER_THAN_INT(
+	 "data_region_index",
+	 data_region_index,
+	 -1 );
+
+	for( buffer_index = 0;
+	     buffer_index < BDE_TEST_VOLUME_WRITE_SIZE;
+	     buffer_index++ )
+	{
+		buffer[ buffer_index ] = (uint8_t) ( buffer_index ^ 0x5a );
+	}
+	/* Test regular cases
+	 */
+	write_count = libbde_volume_write_buffer_at_offset(
+	               volume,
+	               buffer,
+	               BDE_TEST_VOLUME_WRITE_SIZE,
+	               data_offset,
+	               &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) BDE_TEST_VOLUME_WRITE_SIZE );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	if( metadata_region_index != -1 )
+	{
+		write_count = libbde_volume_write_buffer_at_offset(
+		               volume,
+		               buffer,
+		               BDE_TEST_VOLUME_WRITE_SIZE,
+		               metadata_offset,
+		               &error );
+
+		BDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "write_count",
+		 write_count,
+		 (ssize_t) -1 );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	result = libbde_volume_flush(
+	          volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_volume_close(
+	          volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the data is retained after reopening the volume
+	 */
+	result = libbde_volume_open_file_io_handle(
+	          volume,
+	          file_io_handle,
+	          LIBBDE_OPEN_READ,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libbde_volume_read_buffer_at_offset(
+	              volume,
+	              read_buffer,
+	              BDE_TEST_VOLUME_WRITE_SIZE,
+	              data_offset,
+	              &error );
+
+	BDE_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) BDE_TEST_VOLUME_WRITE_SIZE );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          read_buffer,
+	          buffer,
+	          BDE_TEST_VOLUME_WRITE_SIZE );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Clean up
+	 */
+	result = libbde_volume_close(
+	          volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbde_volume_free(
+	          &volume,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "volume",
+	 volume );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 source_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume != NULL )
+	{
+		libbde_volume_free(
+		 &volume,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( source_data != NULL )
+	{
+		memory_free(
+		 source_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( LIBBDE_HAVE_BFIO ) */
+
+/* Tests the libbde_volume_get_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_get_offset(
+     libbde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	off64_t offset           = 0;
+	int offset_is_set        = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_get_offset(
+	          volume,
+	          &offset,
+	          &error );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	offset_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libbde_volume_get_offset(
+	          NULL,
+	          &offset,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( offset_is_set != 0 )
+	{
+		result = libbde_volume_get_offset(
+		          volume,
+		          NULL,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_get_size function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_get_size(
+     libbde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	size64_t size            = 0;
+	int result               = 0;
+	int size_is_set          = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_get_size(
+	          volume,
+	          &size,
+	          &error );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	size_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libbde_volume_get_size(
+	          NULL,
+	          &size,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( size_is_set != 0 )
+	{
+		result = libbde_volume_get_size(
+		          volume,
+		          NULL,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_get_encryption_method function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_get_encryption_method(
+     libbde_volume_t *volume )
+{
+	libcerror_error_t *error     = NULL;
+	uint16_t encryption_method   = 0;
+	int encryption_method_is_set = 0;
+	int result                   = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_get_encryption_method(
+	          volume,
+	          &encryption_method,
+	          &error );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	encryption_method_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libbde_volume_get_encryption_method(
+	          NULL,
+	          &encryption_method,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( encryption_method_is_set != 0 )
+	{
+		result = libbde_volume_get_encryption_method(
+		          volume,
+		          NULL,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_get_creation_time function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_get_creation_time(
+     libbde_volume_t *volume )
+{
+	libcerror_error_t *error = NULL;
+	uint64_t creation_time   = 0;
+	int creation_time_is_set = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_get_creation_time(
 	          volume,
+	          &creation_time,
+	          &error );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	creation_time_is_set = result;
+
+	/* Test error cases
+	 */
+	result = libbde_volume_get_creation_time(
+	          NULL,
+	          &creation_time,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 -1 );
 
-        BDE_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( creation_time_is_set != 0 )
+	{
+		result = libbde_volume_get_creation_time(
+		          volume,
+		          NULL,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_get_utf8_description_size function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_get_utf8_description_size(
+     libbde_volume_t *volume )
+{
+	libcerror_error_t *error         = NULL;
+	size_t utf8_description_size     = 0;
+	int result                       = 0;
+	int utf8_description_size_is_set = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_get_utf8_description_size(
+	          volume,
+	          &utf8_description_size,
+	          &error );
+
+	BDE_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	utf8_description_size_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libbde_volume_signal_abort(
+	result = libbde_volume_get_utf8_description_size(
 	          NULL,
+	          &utf8_description_size,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -1502,13 +3626,32 @@ int bde_test_volume_signal_abort(
 	 result,
 	 -1 );
 
-        BDE_TEST_ASSERT_IS_NOT_NULL(
-         "error",
-         error );
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
 
 	libcerror_error_free(
 	 &error );
 
+	if( utf8_description_size_is_set != 0 )
+	{
+		result = libbde_volume_get_utf8_description_size(
+		          volume,
+		          NULL,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
 	return( 1 );
 
 on_error:
@@ -1520,22 +3663,24 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libbde_volume_get_offset function
+/* Tests the libbde_volume_get_utf8_description function
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_get_offset(
+int bde_test_volume_get_utf8_description(
      libbde_volume_t *volume )
 {
-	libcerror_error_t *error = NULL;
-	off64_t offset           = 0;
-	int offset_is_set        = 0;
-	int result               = 0;
+	uint8_t utf8_description[ 512 ];
+
+	libcerror_error_t *error    = NULL;
+	int result                  = 0;
+	int utf8_description_is_set = 0;
 
 	/* Test regular cases
 	 */
-	result = libbde_volume_get_offset(
+	result = libbde_volume_get_utf8_description(
 	          volume,
-	          &offset,
+	          utf8_description,
+	          512,
 	          &error );
 
 	BDE_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1547,13 +3692,14 @@ int bde_test_volume_get_offset(
 	 "error",
 	 error );
 
-	offset_is_set = result;
+	utf8_description_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libbde_volume_get_offset(
+	result = libbde_volume_get_utf8_description(
 	          NULL,
-	          &offset,
+	          utf8_description,
+	          512,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -1568,11 +3714,48 @@ int bde_test_volume_get_offset(
 	libcerror_error_free(
 	 &error );
 
-	if( offset_is_set != 0 )
+	if( utf8_description_is_set != 0 )
 	{
-		result = libbde_volume_get_offset(
+		result = libbde_volume_get_utf8_description(
 		          volume,
 		          NULL,
+		          512,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libbde_volume_get_utf8_description(
+		          volume,
+		          utf8_description,
+		          0,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+	        BDE_TEST_ASSERT_IS_NOT_NULL(
+	         "error",
+	         error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libbde_volume_get_utf8_description(
+		          volume,
+		          utf8_description,
+		          (size_t) SSIZE_MAX + 1,
 		          &error );
 
 		BDE_TEST_ASSERT_EQUAL_INT(
@@ -1598,22 +3781,22 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libbde_volume_get_size function
+/* Tests the libbde_volume_get_utf16_description_size function
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_get_size(
+int bde_test_volume_get_utf16_description_size(
      libbde_volume_t *volume )
 {
-	libcerror_error_t *error = NULL;
-	size64_t size            = 0;
-	int result               = 0;
-	int size_is_set          = 0;
+	libcerror_error_t *error          = NULL;
+	size_t utf16_description_size     = 0;
+	int result                        = 0;
+	int utf16_description_size_is_set = 0;
 
 	/* Test regular cases
 	 */
-	result = libbde_volume_get_size(
+	result = libbde_volume_get_utf16_description_size(
 	          volume,
-	          &size,
+	          &utf16_description_size,
 	          &error );
 
 	BDE_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1625,13 +3808,13 @@ int bde_test_volume_get_size(
 	 "error",
 	 error );
 
-	size_is_set = result;
+	utf16_description_size_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libbde_volume_get_size(
+	result = libbde_volume_get_utf16_description_size(
 	          NULL,
-	          &size,
+	          &utf16_description_size,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -1646,9 +3829,9 @@ int bde_test_volume_get_size(
 	libcerror_error_free(
 	 &error );
 
-	if( size_is_set != 0 )
+	if( utf16_description_size_is_set != 0 )
 	{
-		result = libbde_volume_get_size(
+		result = libbde_volume_get_utf16_description_size(
 		          volume,
 		          NULL,
 		          &error );
@@ -1676,22 +3859,24 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libbde_volume_get_encryption_method function
+/* Tests the libbde_volume_get_utf16_description function
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_get_encryption_method(
+int bde_test_volume_get_utf16_description(
      libbde_volume_t *volume )
 {
+	uint16_t utf16_description[ 512 ];
+
 	libcerror_error_t *error     = NULL;
-	uint16_t encryption_method   = 0;
-	int encryption_method_is_set = 0;
 	int result                   = 0;
+	int utf16_description_is_set = 0;
 
 	/* Test regular cases
 	 */
-	result = libbde_volume_get_encryption_method(
+	result = libbde_volume_get_utf16_description(
 	          volume,
-	          &encryption_method,
+	          utf16_description,
+	          512,
 	          &error );
 
 	BDE_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1703,13 +3888,14 @@ int bde_test_volume_get_encryption_method(
 	 "error",
 	 error );
 
-	encryption_method_is_set = result;
+	utf16_description_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libbde_volume_get_encryption_method(
+	result = libbde_volume_get_utf16_description(
 	          NULL,
-	          &encryption_method,
+	          utf16_description,
+	          512,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -1717,18 +3903,55 @@ int bde_test_volume_get_encryption_method(
 	 result,
 	 -1 );
 
-	BDE_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	if( utf16_description_is_set != 0 )
+	{
+		result = libbde_volume_get_utf16_description(
+		          volume,
+		          NULL,
+		          512,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libbde_volume_get_utf16_description(
+		          volume,
+		          utf16_description,
+		          0,
+		          &error );
+
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
 
-	libcerror_error_free(
-	 &error );
+	        BDE_TEST_ASSERT_IS_NOT_NULL(
+	         "error",
+	         error );
 
-	if( encryption_method_is_set != 0 )
-	{
-		result = libbde_volume_get_encryption_method(
+		libcerror_error_free(
+		 &error );
+
+		result = libbde_volume_get_utf16_description(
 		          volume,
-		          NULL,
+		          utf16_description,
+		          (size_t) SSIZE_MAX + 1,
 		          &error );
 
 		BDE_TEST_ASSERT_EQUAL_INT(
@@ -1754,22 +3977,22 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libbde_volume_get_creation_time function
+/* Tests the libbde_volume_get_number_of_key_protectors function
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_get_creation_time(
+int bde_test_volume_get_number_of_key_protectors(
      libbde_volume_t *volume )
 {
-	libcerror_error_t *error = NULL;
-	uint64_t creation_time   = 0;
-	int creation_time_is_set = 0;
-	int result               = 0;
+	libcerror_error_t *error            = NULL;
+	int number_of_key_protectors        = 0;
+	int number_of_key_protectors_is_set = 0;
+	int result                          = 0;
 
 	/* Test regular cases
 	 */
-	result = libbde_volume_get_creation_time(
+	result = libbde_volume_get_number_of_key_protectors(
 	          volume,
-	          &creation_time,
+	          &number_of_key_protectors,
 	          &error );
 
 	BDE_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1781,13 +4004,13 @@ int bde_test_volume_get_creation_time(
 	 "error",
 	 error );
 
-	creation_time_is_set = result;
+	number_of_key_protectors_is_set = result;
 
 	/* Test error cases
 	 */
-	result = libbde_volume_get_creation_time(
+	result = libbde_volume_get_number_of_key_protectors(
 	          NULL,
-	          &creation_time,
+	          &number_of_key_protectors,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -1802,9 +4025,9 @@ int bde_test_volume_get_creation_time(
 	libcerror_error_free(
 	 &error );
 
-	if( creation_time_is_set != 0 )
+	if( number_of_key_protectors_is_set != 0 )
 	{
-		result = libbde_volume_get_creation_time(
+		result = libbde_volume_get_number_of_key_protectors(
 		          volume,
 		          NULL,
 		          &error );
@@ -1832,22 +4055,27 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libbde_volume_get_utf8_description_size function
+/* Tests the libbde_volume_set_cache_size function on an open volume
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_get_utf8_description_size(
+int bde_test_volume_set_cache_size_open(
      libbde_volume_t *volume )
 {
-	libcerror_error_t *error         = NULL;
-	size_t utf8_description_size     = 0;
-	int result                       = 0;
-	int utf8_description_size_is_set = 0;
+	size64_t cache_sizes[ 3 ] = { 0, 65536, 16777216 };
+
+	libcerror_error_t *error  = NULL;
+	uint8_t *buffer           = NULL;
+	uint8_t *reference_data   = NULL;
+	size64_t volume_size      = 0;
+	size_t reference_size     = 0;
+	ssize_t read_count        = 0;
+	int cache_size_index      = 0;
+	int result                = 0;
 
-	/* Test regular cases
+	/* Determine if the volume can be read
 	 */
-	result = libbde_volume_get_utf8_description_size(
+	result = libbde_volume_is_locked(
 	          volume,
-	          &utf8_description_size,
 	          &error );
 
 	BDE_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1859,13 +4087,126 @@ int bde_test_volume_get_utf8_description_size(
 	 "error",
 	 error );
 
-	utf8_description_size_is_set = result;
+	if( result == 0 )
+	{
+		result = libbde_volume_get_size(
+		          volume,
+		          &volume_size,
+		          &error );
 
+		BDE_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		reference_size = BDE_TEST_VOLUME_CONCURRENT_REFERENCE_SIZE * 4;
+
+		if( (size64_t) reference_size > volume_size )
+		{
+			reference_size = (size_t) volume_size;
+		}
+	}
+	if( reference_size > 0 )
+	{
+		/* Read the reference data with the current sector cache
+		 */
+		reference_data = (uint8_t *) memory_allocate(
+		                              sizeof( uint8_t ) * reference_size );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "reference_data",
+		 reference_data );
+
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * reference_size );
+
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "buffer",
+		 buffer );
+
+		read_count = libbde_volume_read_buffer_at_offset(
+		              volume,
+		              reference_data,
+		              reference_size,
+		              0,
+		              &error );
+
+		BDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) reference_size );
+
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Test regular cases
+		 * Resizing the sector cache of an open volume, including disabling it
+		 * and making it smaller than the data read, must not change the data read
+		 */
+		for( cache_size_index = 0;
+		     cache_size_index < 3;
+		     cache_size_index++ )
+		{
+			result = libbde_volume_set_cache_size(
+			          volume,
+			          cache_sizes[ cache_size_index ],
+			          &error );
+
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
+
+			BDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			read_count = libbde_volume_read_buffer_at_offset(
+			              volume,
+			              buffer,
+			              reference_size,
+			              0,
+			              &error );
+
+			BDE_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) reference_size );
+
+			BDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          buffer,
+			          reference_data,
+			          reference_size );
+
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+		memory_free(
+		 buffer );
+
+		buffer = NULL;
+
+		memory_free(
+		 reference_data );
+
+		reference_data = NULL;
+	}
 	/* Test error cases
 	 */
-	result = libbde_volume_get_utf8_description_size(
-	          NULL,
-	          &utf8_description_size,
+	result = libbde_volume_set_cache_size(
+	          volume,
+	          (size64_t) SSIZE_MAX + 1,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -1873,32 +4214,13 @@ int bde_test_volume_get_utf8_description_size(
 	 result,
 	 -1 );
 
-	BDE_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
 
 	libcerror_error_free(
 	 &error );
 
-	if( utf8_description_size_is_set != 0 )
-	{
-		result = libbde_volume_get_utf8_description_size(
-		          volume,
-		          NULL,
-		          &error );
-
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		BDE_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -1907,27 +4229,42 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( reference_data != NULL )
+	{
+		memory_free(
+		 reference_data );
+	}
 	return( 0 );
 }
 
-/* Tests the libbde_volume_get_utf8_description function
+/* Tests the libbde_volume_set_read_ahead_depth function on an open volume
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_get_utf8_description(
+int bde_test_volume_set_read_ahead_depth_open(
      libbde_volume_t *volume )
 {
-	uint8_t utf8_description[ 512 ];
-
-	libcerror_error_t *error    = NULL;
-	int result                  = 0;
-	int utf8_description_is_set = 0;
-
-	/* Test regular cases
+	int read_ahead_depths[ 3 ] = { 0, 4, 128 };
+
+	libcerror_error_t *error   = NULL;
+	uint8_t *buffer            = NULL;
+	uint8_t *reference_data    = NULL;
+	size64_t volume_size       = 0;
+	size_t read_size           = 0;
+	size_t reference_size      = 0;
+	ssize_t read_count         = 0;
+	off64_t offset             = 0;
+	int read_ahead_depth_index = 0;
+	int result                 = 0;
+
+	/* Determine if the volume can be read
 	 */
-	result = libbde_volume_get_utf8_description(
+	result = libbde_volume_is_locked(
 	          volume,
-	          utf8_description,
-	          512,
 	          &error );
 
 	BDE_TEST_ASSERT_NOT_EQUAL_INT(
@@ -1939,129 +4276,136 @@ int bde_test_volume_get_utf8_description(
 	 "error",
 	 error );
 
-	utf8_description_is_set = result;
-
-	/* Test error cases
-	 */
-	result = libbde_volume_get_utf8_description(
-	          NULL,
-	          utf8_description,
-	          512,
-	          &error );
-
-	BDE_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
-
-	BDE_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	libcerror_error_free(
-	 &error );
-
-	if( utf8_description_is_set != 0 )
+	if( result == 0 )
 	{
-		result = libbde_volume_get_utf8_description(
+		result = libbde_volume_get_size(
 		          volume,
-		          NULL,
-		          512,
+		          &volume_size,
 		          &error );
 
 		BDE_TEST_ASSERT_EQUAL_INT(
 		 "result",
 		 result,
-		 -1 );
+		 1 );
 
-		BDE_TEST_ASSERT_IS_NOT_NULL(
+		BDE_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
 
-		libcerror_error_free(
-		 &error );
+		reference_size = BDE_TEST_VOLUME_CONCURRENT_REFERENCE_SIZE * 4;
 
-		result = libbde_volume_get_utf8_description(
-		          volume,
-		          utf8_description,
-		          0,
-		          &error );
+		if( (size64_t) reference_size > volume_size )
+		{
+			reference_size = (size_t) volume_size;
+		}
+	}
+	if( reference_size > 0 )
+	{
+		/* Read the reference data with a single read
+		 */
+		reference_data = (uint8_t *) memory_allocate(
+		                              sizeof( uint8_t ) * reference_size );
 
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "reference_data",
+		 reference_data );
 
-	        BDE_TEST_ASSERT_IS_NOT_NULL(
-	         "error",
-	         error );
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * reference_size );
 
-		libcerror_error_free(
-		 &error );
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "buffer",
+		 buffer );
 
-		result = libbde_volume_get_utf8_description(
-		          volume,
-		          utf8_description,
-		          (size_t) SSIZE_MAX + 1,
-		          &error );
+		read_count = libbde_volume_read_buffer_at_offset(
+		              volume,
+		              reference_data,
+		              reference_size,
+		              0,
+		              &error );
 
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+		BDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) reference_size );
 
-		BDE_TEST_ASSERT_IS_NOT_NULL(
+		BDE_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
 
-		libcerror_error_free(
-		 &error );
-	}
-	return( 1 );
+		/* Test regular cases
+		 * Sequential reads, which are read ahead, must read the same data
+		 * as the single read for every read-ahead depth
+		 */
+		for( read_ahead_depth_index = 0;
+		     read_ahead_depth_index < 3;
+		     read_ahead_depth_index++ )
+		{
+			result = libbde_volume_set_read_ahead_depth(
+			          volume,
+			          read_ahead_depths[ read_ahead_depth_index ],
+			          &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
 
-/* Tests the libbde_volume_get_utf16_description_size function
- * Returns 1 if successful or 0 if not
- */
-int bde_test_volume_get_utf16_description_size(
-     libbde_volume_t *volume )
-{
-	libcerror_error_t *error          = NULL;
-	size_t utf16_description_size     = 0;
-	int result                        = 0;
-	int utf16_description_size_is_set = 0;
+			BDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
 
-	/* Test regular cases
-	 */
-	result = libbde_volume_get_utf16_description_size(
-	          volume,
-	          &utf16_description_size,
-	          &error );
+			for( offset = 0;
+			     offset < (off64_t) reference_size;
+			     offset += (off64_t) read_size )
+			{
+				read_size = reference_size - (size_t) offset;
+
+				if( read_size > BDE_TEST_VOLUME_CONCURRENT_READ_SIZE )
+				{
+					read_size = BDE_TEST_VOLUME_CONCURRENT_READ_SIZE;
+				}
+				read_count = libbde_volume_read_buffer_at_offset(
+				              volume,
+				              &( buffer[ offset ] ),
+				              read_size,
+				              offset,
+				              &error );
+
+				BDE_TEST_ASSERT_EQUAL_SSIZE(
+				 "read_count",
+				 read_count,
+				 (ssize_t) read_size );
+
+				BDE_TEST_ASSERT_IS_NULL(
+				 "error",
+				 error );
+			}
+			result = memory_compare(
+			          buffer,
+			          reference_data,
+			          reference_size );
 
-	BDE_TEST_ASSERT_NOT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+		memory_free(
+		 buffer );
 
-	BDE_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+		buffer = NULL;
 
-	utf16_description_size_is_set = result;
+		memory_free(
+		 reference_data );
 
+		reference_data = NULL;
+	}
 	/* Test error cases
 	 */
-	result = libbde_volume_get_utf16_description_size(
-	          NULL,
-	          &utf16_description_size,
+	result = libbde_volume_set_read_ahead_depth(
+	          volume,
+	          -1,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -2069,32 +4413,13 @@ int bde_test_volume_get_utf16_description_size(
 	 result,
 	 -1 );
 
-	BDE_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
 
 	libcerror_error_free(
 	 &error );
 
-	if( utf16_description_size_is_set != 0 )
-	{
-		result = libbde_volume_get_utf16_description_size(
-		          volume,
-		          NULL,
-		          &error );
-
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		BDE_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -2103,27 +4428,40 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( reference_data != NULL )
+	{
+		memory_free(
+		 reference_data );
+	}
 	return( 0 );
 }
 
-/* Tests the libbde_volume_get_utf16_description function
+/* Tests the libbde_volume_set_number_of_decryption_threads function on an open volume
  * Returns 1 if successful or 0 if not
  */
-int bde_test_volume_get_utf16_description(
+int bde_test_volume_set_number_of_decryption_threads_open(
      libbde_volume_t *volume )
 {
-	uint16_t utf16_description[ 512 ];
+	int numbers_of_threads[ 3 ] = { 2, 4, 0 };
 
-	libcerror_error_t *error     = NULL;
-	int result                   = 0;
-	int utf16_description_is_set = 0;
+	libcerror_error_t *error    = NULL;
+	uint8_t *buffer             = NULL;
+	uint8_t *reference_data     = NULL;
+	size64_t volume_size        = 0;
+	size_t reference_size       = 0;
+	ssize_t read_count          = 0;
+	int number_of_threads_index = 0;
+	int result                  = 0;
 
-	/* Test regular cases
+	/* Determine if the volume can be read
 	 */
-	result = libbde_volume_get_utf16_description(
+	result = libbde_volume_is_locked(
 	          volume,
-	          utf16_description,
-	          512,
 	          &error );
 
 	BDE_TEST_ASSERT_NOT_EQUAL_INT(
@@ -2135,129 +4473,140 @@ int bde_test_volume_get_utf16_description(
 	 "error",
 	 error );
 
-	utf16_description_is_set = result;
-
-	/* Test error cases
-	 */
-	result = libbde_volume_get_utf16_description(
-	          NULL,
-	          utf16_description,
-	          512,
-	          &error );
-
-	BDE_TEST_ASSERT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
-
-	BDE_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
-
-	libcerror_error_free(
-	 &error );
-
-	if( utf16_description_is_set != 0 )
+	if( result == 0 )
 	{
-		result = libbde_volume_get_utf16_description(
+		result = libbde_volume_get_size(
 		          volume,
-		          NULL,
-		          512,
+		          &volume_size,
 		          &error );
 
 		BDE_TEST_ASSERT_EQUAL_INT(
 		 "result",
 		 result,
-		 -1 );
+		 1 );
 
-		BDE_TEST_ASSERT_IS_NOT_NULL(
+		BDE_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
 
-		libcerror_error_free(
-		 &error );
+		reference_size = BDE_TEST_VOLUME_CONCURRENT_REFERENCE_SIZE * 4;
 
-		result = libbde_volume_get_utf16_description(
-		          volume,
-		          utf16_description,
-		          0,
-		          &error );
+		if( (size64_t) reference_size > volume_size )
+		{
+			reference_size = (size_t) volume_size;
+		}
+	}
+	if( reference_size > 0 )
+	{
+		/* Read the reference data without decryption threads
+		 */
+		reference_data = (uint8_t *) memory_allocate(
+		                              sizeof( uint8_t ) * reference_size );
 
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "reference_data",
+		 reference_data );
 
-	        BDE_TEST_ASSERT_IS_NOT_NULL(
-	         "error",
-	         error );
+		buffer = (uint8_t *) memory_allocate(
+		                      sizeof( uint8_t ) * reference_size );
 
-		libcerror_error_free(
-		 &error );
+		BDE_TEST_ASSERT_IS_NOT_NULL(
+		 "buffer",
+		 buffer );
 
-		result = libbde_volume_get_utf16_description(
+		result = libbde_volume_set_number_of_decryption_threads(
 		          volume,
-		          utf16_description,
-		          (size_t) SSIZE_MAX + 1,
+		          0,
 		          &error );
 
 		BDE_TEST_ASSERT_EQUAL_INT(
 		 "result",
 		 result,
-		 -1 );
+		 1 );
 
-		BDE_TEST_ASSERT_IS_NOT_NULL(
+		BDE_TEST_ASSERT_IS_NULL(
 		 "error",
 		 error );
 
-		libcerror_error_free(
-		 &error );
-	}
-	return( 1 );
+		read_count = libbde_volume_read_buffer_at_offset(
+		              volume,
+		              reference_data,
+		              reference_size,
+		              0,
+		              &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+		BDE_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) reference_size );
 
-/* Tests the libbde_volume_get_number_of_key_protectors function
- * Returns 1 if successful or 0 if not
- */
-int bde_test_volume_get_number_of_key_protectors(
-     libbde_volume_t *volume )
-{
-	libcerror_error_t *error            = NULL;
-	int number_of_key_protectors        = 0;
-	int number_of_key_protectors_is_set = 0;
-	int result                          = 0;
+		BDE_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
 
-	/* Test regular cases
-	 */
-	result = libbde_volume_get_number_of_key_protectors(
-	          volume,
-	          &number_of_key_protectors,
-	          &error );
+		/* Test regular cases
+		 * Large reads that are split into chunks over the decryption threads
+		 * must read the same data as a read without decryption threads
+		 */
+		for( number_of_threads_index = 0;
+		     number_of_threads_index < 3;
+		     number_of_threads_index++ )
+		{
+			result = libbde_volume_set_number_of_decryption_threads(
+			          volume,
+			          numbers_of_threads[ number_of_threads_index ],
+			          &error );
 
-	BDE_TEST_ASSERT_NOT_EQUAL_INT(
-	 "result",
-	 result,
-	 -1 );
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 1 );
 
-	BDE_TEST_ASSERT_IS_NULL(
-	 "error",
-	 error );
+			BDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
 
-	number_of_key_protectors_is_set = result;
+			read_count = libbde_volume_read_buffer_at_offset(
+			              volume,
+			              buffer,
+			              reference_size,
+			              0,
+			              &error );
 
+			BDE_TEST_ASSERT_EQUAL_SSIZE(
+			 "read_count",
+			 read_count,
+			 (ssize_t) reference_size );
+
+			BDE_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			result = memory_compare(
+			          buffer,
+			          reference_data,
+			          reference_size );
+
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 0 );
+		}
+		memory_free(
+		 buffer );
+
+		buffer = NULL;
+
+		memory_free(
+		 reference_data );
+
+		reference_data = NULL;
+	}
 	/* Test error cases
 	 */
-	result = libbde_volume_get_number_of_key_protectors(
-	          NULL,
-	          &number_of_key_protectors,
+	result = libbde_volume_set_number_of_decryption_threads(
+	          volume,
+	          -1,
 	          &error );
 
 	BDE_TEST_ASSERT_EQUAL_INT(
@@ -2265,32 +4614,13 @@ int bde_test_volume_get_number_of_key_protectors(
 	 result,
 	 -1 );
 
-	BDE_TEST_ASSERT_IS_NOT_NULL(
-	 "error",
-	 error );
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
 
 	libcerror_error_free(
 	 &error );
 
-	if( number_of_key_protectors_is_set != 0 )
-	{
-		result = libbde_volume_get_number_of_key_protectors(
-		          volume,
-		          NULL,
-		          &error );
-
-		BDE_TEST_ASSERT_EQUAL_INT(
-		 "result",
-		 result,
-		 -1 );
-
-		BDE_TEST_ASSERT_IS_NOT_NULL(
-		 "error",
-		 error );
-
-		libcerror_error_free(
-		 &error );
-	}
 	return( 1 );
 
 on_error:
@@ -2299,6 +4629,16 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	if( reference_data != NULL )
+	{
+		memory_free(
+		 reference_data );
+	}
 	return( 0 );
 }
 
@@ -2369,6 +4709,22 @@ int main(
 	 "libbde_volume_free",
 	 bde_test_volume_free );
 
+	BDE_TEST_RUN(
+	 "libbde_volume_set_block_size",
+	 bde_test_volume_set_block_size );
+
+	BDE_TEST_RUN(
+	 "libbde_volume_set_cache_size",
+	 bde_test_volume_set_cache_size );
+
+	BDE_TEST_RUN(
+	 "libbde_volume_set_read_ahead_depth",
+	 bde_test_volume_set_read_ahead_depth );
+
+	BDE_TEST_RUN(
+	 "libbde_volume_set_number_of_decryption_threads",
+	 bde_test_volume_set_number_of_decryption_threads );
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -2444,13 +4800,35 @@ int main(
 
 		/* TODO: add tests for libbde_volume_is_locked */
 
+		BDE_TEST_RUN_WITH_ARGS(
+		 "libbde_volume_read_metadata_copies",
+		 bde_test_volume_read_metadata_copies,
+		 volume );
+
 		/* TODO: add tests for libbde_volume_read_buffer */
 
 		/* TODO: add tests for libbde_volume_read_buffer_at_offset */
 
-		/* TODO: add tests for libbde_volume_write_buffer */
+		BDE_TEST_RUN_WITH_ARGS(
+		 "libbde_volume_read_buffer_at_offset_concurrent",
+		 bde_test_volume_read_buffer_at_offset_concurrent,
+		 volume );
+
+		BDE_TEST_RUN_WITH_ARGS(
+		 "libbde_volume_write_buffer",
+		 bde_test_volume_write_buffer,
+		 volume );
+
+#if defined( LIBBDE_HAVE_BFIO )
+
+		BDE_TEST_RUN_WITH_ARGS(
+		 "libbde_volume_write_buffer_at_offset",
+		 bde_test_volume_write_buffer_at_offset,
+		 source,
+		 option_password,
+		 option_recovery_password );
 
-		/* TODO: add tests for libbde_volume_write_buffer_at_offset */
+#endif /* defined( LIBBDE_HAVE_BFIO ) */
 
 		/* TODO: add tests for libbde_volume_seek_offset */
 
@@ -2503,6 +4881,21 @@ int main(
 
 		/* TODO: add tests for libbde_volume_get_key_protector */
 
+		BDE_TEST_RUN_WITH_ARGS(
+		 "libbde_volume_set_cache_size",
+		 bde_test_volume_set_cache_size_open,
+		 volume );
+
+		BDE_TEST_RUN_WITH_ARGS(
+		 "libbde_volume_set_read_ahead_depth",
+		 bde_test_volume_set_read_ahead_depth_open,
+		 volume );
+
+		BDE_TEST_RUN_WITH_ARGS(
+		 "libbde_volume_set_number_of_decryption_threads",
+		 bde_test_volume_set_number_of_decryption_threads_open,
+		 volume );
+
 		/* TODO: add tests for libbde_volume_set_keys */
 
 		/* TODO: add tests for libbde_volume_set_utf8_password */
@@ -0,0 +1,756 @@
+/*
+ * Library volume_summary type testing program
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_memory.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_definitions.h"
+#include "../libbde/libbde_volume_summary.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_volume_summary_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_summary_initialize(
+     void )
+{
+	libbde_volume_summary_t *volume_summary = NULL;
+	libcerror_error_t *error                = NULL;
+	int result                              = 0;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_summary_initialize(
+	          &volume_summary,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "volume_summary",
+	 volume_summary );
+
+	result = libbde_volume_summary_free(
+	          &volume_summary,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "volume_summary",
+	 volume_summary );
+
+	/* Test error cases
+	 */
+	result = libbde_volume_summary_initialize(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	volume_summary = (libbde_volume_summary_t *) 0x12345678UL;
+
+	result = libbde_volume_summary_initialize(
+	          &volume_summary,
+	          &error );
+
+	volume_summary = NULL;
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume_summary != NULL )
+	{
+		libbde_volume_summary_free(
+		 &volume_summary,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* Tests the libbde_volume_summary_free function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_summary_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbde_volume_summary_free(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_volume_summary_read_file_io_handle function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_summary_read_file_io_handle(
+     void )
+{
+	libbde_volume_summary_t *volume_summary = NULL;
+	libcerror_error_t *error                = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_volume_summary_initialize(
+	          &volume_summary,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libbde_volume_summary_read_file_io_handle(
+	          NULL,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_summary_read_file_io_handle(
+	          volume_summary,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_volume_summary_free(
+	          &volume_summary,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume_summary != NULL )
+	{
+		libbde_volume_summary_free(
+		 &volume_summary,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_summary_get_version function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_summary_get_version(
+     void )
+{
+	libbde_volume_summary_t *volume_summary = NULL;
+	libcerror_error_t *error                = NULL;
+	int result                              = 0;
+	int version                             = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_volume_summary_initialize(
+	          &volume_summary,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	( (libbde_internal_volume_summary_t *) volume_summary )->version = LIBBDE_VERSION_WINDOWS_7;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_summary_get_version(
+	          volume_summary,
+	          &version,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "version",
+	 version,
+	 LIBBDE_VERSION_WINDOWS_7 );
+
+	/* Test error cases
+	 */
+	result = libbde_volume_summary_get_version(
+	          NULL,
+	          &version,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_summary_get_version(
+	          volume_summary,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_volume_summary_free(
+	          &volume_summary,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume_summary != NULL )
+	{
+		libbde_volume_summary_free(
+		 &volume_summary,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_summary_get_volume_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_summary_get_volume_identifier(
+     void )
+{
+	uint8_t expected_guid_data[ 16 ] = {
+		0x53, 0x81, 0x1a, 0xa3, 0xc1, 0x5d, 0xc3, 0x4b, 0xa5, 0xb8, 0xe6, 0xd7, 0x7a, 0x17, 0xc4, 0xc0 };
+	uint8_t guid_data[ 16 ];
+
+	libbde_volume_summary_t *volume_summary = NULL;
+	libcerror_error_t *error                = NULL;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_volume_summary_initialize(
+	          &volume_summary,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_copy(
+	 ( (libbde_internal_volume_summary_t *) volume_summary )->volume_identifier,
+	 expected_guid_data,
+	 16 );
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_summary_get_volume_identifier(
+	          volume_summary,
+	          guid_data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          guid_data,
+	          expected_guid_data,
+	          16 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libbde_volume_summary_get_volume_identifier(
+	          NULL,
+	          guid_data,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_summary_get_volume_identifier(
+	          volume_summary,
+	          NULL,
+	          16,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_summary_get_volume_identifier(
+	          volume_summary,
+	          guid_data,
+	          8,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_volume_summary_free(
+	          &volume_summary,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume_summary != NULL )
+	{
+		libbde_volume_summary_free(
+		 &volume_summary,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_volume_summary_get_key_protector_type function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_volume_summary_get_key_protector_type(
+     void )
+{
+	libbde_volume_summary_t *volume_summary = NULL;
+	libcerror_error_t *error                = NULL;
+	uint16_t type                           = 0;
+	int result                              = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_volume_summary_initialize(
+	          &volume_summary,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	( (libbde_internal_volume_summary_t *) volume_summary )->number_of_key_protectors  = 2;
+	( (libbde_internal_volume_summary_t *) volume_summary )->key_protector_types[ 0 ] = LIBBDE_KEY_PROTECTION_TYPE_TPM;
+	( (libbde_internal_volume_summary_t *) volume_summary )->key_protector_types[ 1 ] = LIBBDE_KEY_PROTECTION_TYPE_RECOVERY_PASSWORD;
+
+	/* Test regular cases
+	 */
+	result = libbde_volume_summary_get_key_protector_type(
+	          volume_summary,
+	          1,
+	          &type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "type",
+	 (int) type,
+	 LIBBDE_KEY_PROTECTION_TYPE_RECOVERY_PASSWORD );
+
+	/* Test error cases
+	 */
+	result = libbde_volume_summary_get_key_protector_type(
+	          NULL,
+	          0,
+	          &type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_summary_get_key_protector_type(
+	          volume_summary,
+	          -1,
+	          &type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_summary_get_key_protector_type(
+	          volume_summary,
+	          2,
+	          &type,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_volume_summary_get_key_protector_type(
+	          volume_summary,
+	          0,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	BDE_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_volume_summary_free(
+	          &volume_summary,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( volume_summary != NULL )
+	{
+		libbde_volume_summary_free(
+		 &volume_summary,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_volume_summary_initialize",
+	 bde_test_volume_summary_initialize );
+
+#endif /* defined( __GNUC__ ) */
+
+	BDE_TEST_RUN(
+	 "libbde_volume_summary_free",
+	 bde_test_volume_summary_free );
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_volume_summary_read_file_io_handle",
+	 bde_test_volume_summary_read_file_io_handle );
+
+	BDE_TEST_RUN(
+	 "libbde_volume_summary_get_version",
+	 bde_test_volume_summary_get_version );
+
+	BDE_TEST_RUN(
+	 "libbde_volume_summary_get_volume_identifier",
+	 bde_test_volume_summary_get_volume_identifier );
+
+	BDE_TEST_RUN(
+	 "libbde_volume_summary_get_key_protector_type",
+	 bde_test_volume_summary_get_key_protector_type );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
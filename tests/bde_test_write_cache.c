@@ -0,0 +1,950 @@
+/*
+ * Library write_cache type testing program
+ *
+ * Copyright (C) 2011-2016, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bde_test_libbde.h"
+#include "bde_test_libcerror.h"
+#include "bde_test_macros.h"
+#include "bde_test_memory.h"
+#include "bde_test_unused.h"
+
+#include "../libbde/libbde_definitions.h"
+#include "../libbde/libbde_io_handle.h"
+#include "../libbde/libbde_write_cache.h"
+
+#if defined( __GNUC__ )
+
+/* Tests the libbde_write_cache_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_write_cache_initialize(
+     void )
+{
+	libbde_write_cache_t *write_cache = NULL;
+	libcerror_error_t *error          = NULL;
+	int result                        = 0;
+
+#if defined( HAVE_BDE_TEST_MEMORY )
+	int number_of_malloc_fail_tests   = 4;
+	int test_number                   = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libbde_write_cache_initialize(
+	          &write_cache,
+	          4096,
+	          65536,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "write_cache",
+         write_cache );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "write_cache->maximum_number_of_entries",
+	 write_cache->maximum_number_of_entries,
+	 16 );
+
+	BDE_TEST_ASSERT_EQUAL_SIZE(
+	 "write_cache->run_data_size",
+	 write_cache->run_data_size,
+	 (size_t) LIBBDE_WRITE_CACHE_MAXIMUM_RUN_SIZE );
+
+	result = libbde_write_cache_free(
+	          &write_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "write_cache",
+         write_cache );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test a cache size smaller than the block size
+	 */
+	result = libbde_write_cache_initialize(
+	          &write_cache,
+	          4096,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "write_cache",
+         write_cache );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "write_cache->maximum_number_of_entries",
+	 write_cache->maximum_number_of_entries,
+	 1 );
+
+	result = libbde_write_cache_free(
+	          &write_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_write_cache_initialize(
+	          NULL,
+	          4096,
+	          65536,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_cache = (libbde_write_cache_t *) 0x12345678UL;
+
+	result = libbde_write_cache_initialize(
+	          &write_cache,
+	          4096,
+	          65536,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	write_cache = NULL;
+
+	result = libbde_write_cache_initialize(
+	          &write_cache,
+	          0,
+	          65536,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_BDE_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libbde_write_cache_initialize with malloc failing
+		 */
+		bde_test_malloc_attempts_before_fail = test_number;
+
+		result = libbde_write_cache_initialize(
+		          &write_cache,
+		          4096,
+		          65536,
+		          &error );
+
+		if( bde_test_malloc_attempts_before_fail != -1 )
+		{
+			bde_test_malloc_attempts_before_fail = -1;
+
+			if( write_cache != NULL )
+			{
+				libbde_write_cache_free(
+				 &write_cache,
+				 NULL );
+			}
+		}
+		else
+		{
+			BDE_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			BDE_TEST_ASSERT_IS_NULL(
+			 "write_cache",
+			 write_cache );
+
+			BDE_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_BDE_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_cache != NULL )
+	{
+		libbde_write_cache_free(
+		 &write_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_write_cache_free function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_write_cache_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libbde_write_cache_free(
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_write_cache_insert_block and libbde_write_cache_get_data functions
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_write_cache_insert_block(
+     void )
+{
+	uint8_t buffer[ 512 ];
+
+	libbde_write_cache_t *write_cache = NULL;
+	libcerror_error_t *error          = NULL;
+	uint8_t *data                     = NULL;
+	int entry_index                   = 0;
+	int number_of_entries             = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_write_cache_initialize(
+	          &write_cache,
+	          512,
+	          1536,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "write_cache",
+         write_cache );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 */
+	result = libbde_write_cache_get_data(
+	          write_cache,
+	          1024,
+	          0,
+	          buffer,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Insert the blocks out of order
+	 */
+	result = libbde_write_cache_insert_block(
+	          write_cache,
+	          1024,
+	          &data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "data",
+         data );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	if( memory_set(
+	     data,
+	     'C',
+	     512 ) == NULL )
+	{
+		goto on_error;
+	}
+	result = libbde_write_cache_insert_block(
+	          write_cache,
+	          0,
+	          &data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	if( memory_set(
+	     data,
+	     'A',
+	     512 ) == NULL )
+	{
+		goto on_error;
+	}
+	result = libbde_write_cache_is_full(
+	          write_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_write_cache_insert_block(
+	          write_cache,
+	          512,
+	          &data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	if( memory_set(
+	     data,
+	     'B',
+	     512 ) == NULL )
+	{
+		goto on_error;
+	}
+	result = libbde_write_cache_is_full(
+	          write_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_write_cache_get_number_of_entries(
+	          write_cache,
+	          &number_of_entries,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 3 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* The entries are sorted by block offset
+	 */
+	result = libbde_write_cache_find_entry_index(
+	          write_cache,
+	          512,
+	          &entry_index,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "entry_index",
+	 entry_index,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_write_cache_get_data(
+	          write_cache,
+	          512,
+	          256,
+	          buffer,
+	          256,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "buffer[ 0 ]",
+	 (int) buffer[ 0 ],
+	 (int) 'B' );
+
+	result = libbde_write_cache_get_data(
+	          write_cache,
+	          1024,
+	          0,
+	          buffer,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "buffer[ 511 ]",
+	 (int) buffer[ 511 ],
+	 (int) 'C' );
+
+	/* Test error cases
+	 */
+	result = libbde_write_cache_insert_block(
+	          NULL,
+	          1536,
+	          &data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test insert with the write cache full
+	 */
+	result = libbde_write_cache_insert_block(
+	          write_cache,
+	          1536,
+	          &data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_write_cache_get_data(
+	          write_cache,
+	          512,
+	          256,
+	          buffer,
+	          512,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_write_cache_free(
+	          &write_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "write_cache",
+         write_cache );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_cache != NULL )
+	{
+		libbde_write_cache_free(
+		 &write_cache,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libbde_write_cache_flush function
+ * Returns 1 if successful or 0 if not
+ */
+int bde_test_write_cache_flush(
+     void )
+{
+	libbde_io_handle_t *io_handle     = NULL;
+	libbde_write_cache_t *write_cache = NULL;
+	libcerror_error_t *error          = NULL;
+	uint8_t *data                     = NULL;
+	int number_of_entries             = 0;
+	int result                        = 0;
+
+	/* Initialize test
+	 */
+	result = libbde_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	io_handle->version                = LIBBDE_VERSION_WINDOWS_7;
+	io_handle->bytes_per_sector       = 512;
+	io_handle->first_metadata_offset  = 0x00010000;
+	io_handle->second_metadata_offset = 0x00020000;
+	io_handle->third_metadata_offset  = 0x00030000;
+	io_handle->metadata_size          = 65536;
+	io_handle->volume_header_offset   = 0x00040000;
+	io_handle->volume_header_size     = 8192;
+	io_handle->encrypted_volume_size  = 0x00100000;
+	io_handle->volume_size            = 0x00100000;
+
+	result = libbde_write_cache_initialize(
+	          &write_cache,
+	          4096,
+	          65536,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "write_cache",
+         write_cache );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test regular cases
+	 */
+	/* Blocks in the metadata areas are never written hence the file IO handle is not used
+	 */
+	result = libbde_write_cache_insert_block(
+	          write_cache,
+	          0x00011000,
+	          &data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_write_cache_insert_block(
+	          write_cache,
+	          0x00010000,
+	          &data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_write_cache_insert_block(
+	          write_cache,
+	          0x00020000,
+	          &data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_write_cache_flush(
+	          write_cache,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_write_cache_get_number_of_entries(
+	          write_cache,
+	          &number_of_entries,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "number_of_entries",
+	 number_of_entries,
+	 0 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* The data of the entries is reused after a flush
+	 */
+	result = libbde_write_cache_insert_block(
+	          write_cache,
+	          0x00030000,
+	          &data,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "data",
+         data );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	/* Test error cases
+	 */
+	result = libbde_write_cache_flush(
+	          NULL,
+	          io_handle,
+	          NULL,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libbde_write_cache_flush(
+	          write_cache,
+	          NULL,
+	          NULL,
+	          NULL,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+        BDE_TEST_ASSERT_IS_NOT_NULL(
+         "error",
+         error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libbde_write_cache_free(
+	          &write_cache,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "write_cache",
+         write_cache );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libbde_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	BDE_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "io_handle",
+         io_handle );
+
+        BDE_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( write_cache != NULL )
+	{
+		libbde_write_cache_free(
+		 &write_cache,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libbde_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc BDE_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] BDE_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	BDE_TEST_UNREFERENCED_PARAMETER( argc )
+	BDE_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ )
+
+	BDE_TEST_RUN(
+	 "libbde_write_cache_initialize",
+	 bde_test_write_cache_initialize );
+
+	BDE_TEST_RUN(
+	 "libbde_write_cache_free",
+	 bde_test_write_cache_free );
+
+	BDE_TEST_RUN(
+	 "libbde_write_cache_insert_block",
+	 bde_test_write_cache_insert_block );
+
+	BDE_TEST_RUN(
+	 "libbde_write_cache_flush",
+	 bde_test_write_cache_flush );
+
+#endif /* defined( __GNUC__ ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
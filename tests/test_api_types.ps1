@@ -10,7 +10,7 @@ $TestPrefix = Split-Path -path ${Pwd}.Path -parent
 $TestPrefix = Split-Path -path ${TestPrefix} -leaf
 $TestPrefix = ${TestPrefix}.Substring(3)
 
-$TestTypes = "aes_ccm_encrypted_key io_handle key key_protector metadata metadata_entry sector_data stretch_key volume_master_key"
+$TestTypes = "aes_ccm_encrypted_key aes_ni diffuser encryption io_handle key key_protector keyring metadata metadata_entry password_batch password_keep read_ahead read_pool region_table sector_cache sector_data sha256_stretch stretch_key volume_master_key volume_summary write_cache"
 $TestTypesWithInput = "volume"
 
 $TestToolDirectory = "..\msvscpp\Release"
@@ -11,7 +11,7 @@ TEST_PREFIX=`dirname ${PWD}`;
 TEST_PREFIX=`basename ${TEST_PREFIX} | sed 's/^lib\([^-]*\).*$/\1/'`;
 
 TEST_PROFILE="lib${TEST_PREFIX}";
-TEST_TYPES="aes_ccm_encrypted_key io_handle key key_protector metadata metadata_entry sector_data stretch_key volume_master_key";
+TEST_TYPES="aes_ccm_encrypted_key aes_ni diffuser encryption io_handle key key_protector keyring metadata metadata_entry password_batch password_keep read_ahead read_pool region_table sector_cache sector_data sha256_stretch stretch_key volume_master_key volume_summary write_cache";
 TEST_TYPES_WITH_INPUT="volume";
 OPTION_SETS="password recovery_password";
 